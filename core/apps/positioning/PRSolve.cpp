@@ -44,8 +44,13 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
 
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 // GPSTK
 #include "Exception.hpp"
 #include "MathBase.hpp"
@@ -135,6 +140,10 @@ public:
    // update weather in the trop model using the Met store
    void setWeather(const CommonTime& ttag) throw(Exception);
 
+   // find the weather in the Met store for this time, without changing the trop
+   // model; return true if defaultTemp,defaultPress,defaultHumid were changed
+   bool findWeather(const CommonTime& ttag) throw(Exception);
+
 private:
 
    // Define default values
@@ -191,6 +200,8 @@ public:
    int maxReject;             // Max number of sats to reject [-1 for no limit]
    int nIter;                 // Maximum iteration count in linearized LS
    double convLimit;          // Minimum convergence criterion in estimation (meters)
+   bool screenRAIM;           // screen the RAIM subsets before iterating them
+   int nThreads;              // number of threads computing solutions
 
    string TropStr;            // temp used to parse --trop
 
@@ -457,6 +468,7 @@ public:
    // check validity of input descriptor, set default values
    void Initialize(const string& desc) throw()
    {
+      pStats = 0;
       if(!ValidateDescriptor(desc, Descriptor)) {
          isValid = false;
          return;
@@ -478,6 +490,7 @@ public:
       prs.NSatsReject = C.maxReject;
       prs.MaxNIterations = C.nIter;
       prs.ConvergenceLimit = C.convLimit;
+      prs.ScreenRAIM = C.screenRAIM;
 
       // specify systems in PRSolution
       // sysChars ~ vec<1-char string> ~ G,R,E,C,S; must have at least one member
@@ -519,13 +532,36 @@ public:
                     const double& elev, const double& ER,
                     const vector<RinexDatum>& v) throw();
 
-   // Compute a solution for the given epoch; call after CollectData()
-   // same return value as RAIMCompute()
-   int ComputeSolution(const CommonTime& t) throw(Exception);
+   // Compute a solution for the given epoch using trop model pTrop; call after
+   // CollectData(); same return value as RAIMCompute()
+   int ComputeSolution(const CommonTime& t, TropModel *pTrop) throw(Exception);
 
-   // Write out ORDs - call after ComputeSolution
+   // Write out ORDs to ordstrm - call after ComputeSolution
    // pass it iret from ComputeSolution
-   int WriteORDs(const CommonTime& t, const int iret) throw(Exception);
+   int WriteORDs(const CommonTime& t, const int iret, ostream& ordstrm)
+      throw(Exception);
+
+   // Statistics of one epoch's RAIM solution, saved by ComputeSolution() instead of
+   // being accumulated when epochs are processed in several threads (pStats is
+   // not null); AddStats() accumulates them later, in time order, so that the
+   // final output is the same as with one thread.
+   class EpochStats {
+   public:
+      EpochStats() : good(false), hasResid(false), logpos(0) { }
+      bool good;                          // a RAIM solution was found
+      bool hasResid;                      // residuals w.r.t. known position
+      size_t logpos;                      // where the PFR record goes in the log
+      Vector<double> PFR;                 // pre-fit residuals
+      vector<PRSMemory::AddArgs> adds;    // deferred PRSMemory::add()
+      Vector<double> XYZ,NEU;             // residuals, and their covariance
+      Matrix<double> CovXYZ,CovNEU;
+   };
+
+   // Accumulate statistics saved by ComputeSolution(), writing the PFR record
+   void AddStats(const EpochStats& stats, const CommonTime& t) throw(Exception);
+
+   // Write the PFR (pre-fit residuals) record
+   void WritePFR(const CommonTime& t, const Vector<double>& PFR) throw();
 
    // Output final results
    void FinalOutput(void) throw(Exception);
@@ -562,6 +598,9 @@ public:
    // the PRS itself
    PRSolution prs;
 
+   // if not null, ComputeSolution() saves the statistics here
+   EpochStats *pStats;
+
    // statistics on the solution residuals
    int nepochs;
    WtdAveStats statsXYZresid;                // RPF (XYZ) minus reference position
@@ -1211,6 +1250,474 @@ try {
 catch(Exception& e) { GPSTK_RETHROW(e); }
 }  // end Initialize()
 
+//------------------------------------------------------------------------------------
+// One epoch of data, read by the main thread and processed in a batch of epochs by
+// ProcessBatch(). Everything the processing writes is saved here, and written out
+// in time order once the batch is done.
+class EpochJob {
+public:
+   Rinex3ObsData Rdata;             // input data, not changed by the threads
+   Rinex3ObsData outData;           // data corrected for DCB, for output RINEX
+   string prelog;                   // log written while reading this epoch
+   string metlog;                   // log written by findWeather()
+   double Temp,Press,Humid;         // weather at this epoch
+   string log;                      // log written while processing
+   string ords;                     // ORDs
+   Rinex3ObsData auxData;           // solutions, for output RINEX
+   vector<SolutionObject::EpochStats> stats;    // parallel to C.SolObjs
+};
+
+// number of epochs given to each thread in a batch
+static const size_t EpochsPerThread(240);
+
+// least number of epochs processed, without output, before each chunk of a batch
+// but the first, so that it starts from the same apriori solution as in sequence
+static const size_t NWarmUpEpochs(2);
+
+//------------------------------------------------------------------------------------
+// Process one epoch: collect data for, and compute, all the solutions in SolObjs;
+// write ORDs to ordstrm and, if there is output RINEX, the solutions to auxData.
+// If pJob is not null, the epoch is being processed in a batch; pTrop is a copy of
+// the trop model, and pJob holds the weather found by the main thread.
+void ProcessEpoch(Rinex3ObsData& Rdata, Rinex3ObsHeader& Rhead,
+                  const map<string,int>& mapDCBindex, const Position& PrevPos,
+                  vector<SolutionObject>& SolObjs, TropModel *pTrop,
+                  const EpochJob *pJob, ostream& ordstrm, Rinex3ObsData& auxData)
+   throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+   int k;
+   size_t i,j;
+
+   // reset solution objects for this epoch
+   for(i=0; i<SolObjs.size(); ++i)
+      SolObjs[i].EpochReset();
+
+   // loop over satellites -----------------------------
+   RinexSatID sat;
+   Rinex3ObsData::DataMap::iterator it;
+   for(it=Rdata.obs.begin(); it!=Rdata.obs.end(); ++it) {
+      sat = it->first;
+      vector<RinexDatum>& vrdata(it->second);
+      string sys(asString(sat.systemChar()));
+
+      // is this system excluded?
+      if(find(C.allSystemChars.begin(),C.allSystemChars.end(),sys)
+            == C.allSystemChars.end())
+      {
+         LOG(DEBUG) << " Sat " << sat << " : system " << sys
+            << " is not needed.";
+         continue;
+      }
+
+      // has user excluded this satellite?
+      if(find(C.exclSat.begin(),C.exclSat.end(),sat) != C.exclSat.end()) {
+         LOG(DEBUG) << " Sat " << sat << " is excluded.";
+         continue;
+      }
+
+      // correct for DCB
+      map<string,int>::const_iterator dit(mapDCBindex.find(sys));
+      if(dit != mapDCBindex.end()) {
+         i = dit->second;
+         map<RinexSatID,double>::const_iterator bit(C.P1C1bias.find(sat));
+         if(bit != C.P1C1bias.end()) {
+            LOG(DEBUG) << "Correct data " << asString(Rhead.mapObsTypes[sys][i])
+               << " = " << fixed << setprecision(2) << vrdata[i].data
+               << " for DCB with " << bit->second;
+            vrdata[i].data += bit->second;
+         }
+      }
+
+      // elevation mask, azimuth and ephemeris range corrected with trop
+      // - pass elev to CollectData for m-cov matrix and ORDs
+      double elev(0), ER(0), tcorr;
+      if((C.elevLimit > 0 || C.weight || C.ORDout)
+                        && PrevPos.getCoordinateSystem() != Position::Unknown) {
+         CorrectedEphemerisRange CER;
+         try {
+            CER.ComputeAtReceiveTime(Rdata.time, PrevPos, sat, *C.pEph);
+            elev = CER.elevation;
+            // const double azim = CER.azimuth;
+            if(C.ORDout) {
+               tcorr = pTrop->correction(PrevPos,CER.svPosVel.x,Rdata.time);
+               ER = CER.rawrange - CER.svclkbias - CER.relativity + tcorr;
+            }
+            if(elev < C.elevLimit) {         // TD add elev mask [azim]
+               LOG(VERBOSE) << " Reject sat " << sat << " for elevation "
+                  << fixed << setprecision(2) << elev << " at time "
+                  << printTime(Rdata.time,C.longfmt);
+               continue;
+            }
+         }
+         catch(Exception& e) {
+            LOG(WARNING) << "WARNING : Failed to get elevation for sat "
+               << sat << " at time " << printTime(Rdata.time,C.longfmt);
+            continue;
+         }
+      }
+
+      // pick out data for each solution object
+      for(i=0; i<SolObjs.size(); ++i)
+         SolObjs[i].CollectData(sat,elev,ER,vrdata);
+
+   }  // end loop over satellites
+
+   // debug: dump the RINEX data object
+   if(C.debug > -1) Rdata.dump(LOGstrm,Rhead);
+
+   // update the trop model's weather ------------------
+   if(C.MetStore.size() > 0) {
+      if(!pJob) C.setWeather(Rdata.time);
+      else {
+         LOGstrm << pJob->metlog;
+         pTrop->setWeather(pJob->Temp,pJob->Press,pJob->Humid);
+      }
+   }
+
+   // put a blank line here for readability
+   LOG(INFO) << "";
+
+   // compute the solution(s) --------------------------
+   // tag for DAT - required for PRSplot
+   string DATtag(printTime(Rdata.time,"DAT "+C.gpsfmt));
+
+   // compute and print the solution(s) ----------------
+   for(i=0; i<SolObjs.size(); ++i) {
+      // skip invalid descriptors
+      if(!SolObjs[i].isValid) continue;
+
+      // dump the "DAT" record
+      LOG(INFO) << SolObjs[i].dump((C.debug > -1 ? 2:1), "RPF", DATtag);
+
+      // compute the solution
+      j = SolObjs[i].ComputeSolution(Rdata.time,pTrop);
+
+      // write ORDs, even if solution is not good
+      if(C.ORDout) SolObjs[i].WriteORDs(Rdata.time,j,ordstrm);
+   }
+
+   // build the aux header for output RINEX ------------
+   if(!C.OutputObsFile.empty()) {
+      auxData = Rinex3ObsData();
+      auxData.time = Rdata.time;
+      auxData.clockOffset = Rdata.clockOffset;
+      auxData.epochFlag = 4;
+      ostringstream oss;
+      // loop over valid descriptors
+      for(k=0,i=0; i<SolObjs.size(); ++i) if(SolObjs[i].isValid) {
+         oss.str("");
+         oss << "XYZ" << fixed << setprecision(3)
+            << " " << setw(12) << SolObjs[i].prs.Solution(0)
+            << " " << setw(12) << SolObjs[i].prs.Solution(1)
+            << " " << setw(12) << SolObjs[i].prs.Solution(2);
+         oss << " " << SolObjs[i].Descriptor;     // may get truncated
+         auxData.auxHeader.commentList.push_back(oss.str());
+         k++;
+         oss.str("");
+         oss << "CLK" << fixed << setprecision(3);
+
+         for(j=0; j<SolObjs[i].prs.SystemIDs.size(); j++) {
+            RinexSatID sat(1,SolObjs[i].prs.SystemIDs[j]);
+            oss << " " << sat.systemString3()
+               << " " << setw(11) << SolObjs[i].prs.Solution(3+j);
+         }
+         oss << " " << SolObjs[i].Descriptor;     // may get truncated
+         auxData.auxHeader.commentList.push_back(oss.str());
+         k++;
+         oss.str("");
+         oss << "DIA" << setw(2) << SolObjs[i].prs.Nsvs
+            << fixed << setprecision(2)
+            << " " << setw(4) << SolObjs[i].prs.PDOP
+            << " " << setw(4) << SolObjs[i].prs.GDOP
+            << " " << setw(8) << SolObjs[i].prs.RMSResidual
+            << " " << SolObjs[i].Descriptor;     // may get truncated
+         auxData.auxHeader.commentList.push_back(oss.str());
+         k++;
+      }
+      auxData.numSVs = k;            // number of lines to write
+      auxData.auxHeader.valid |= Rinex3ObsHeader::validComment;
+   }
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end ProcessEpoch()
+
+//------------------------------------------------------------------------------------
+// Return a new copy of the trop model of type C.TropType
+TropModel *CopyTropModel(const TropModel *pTrop) throw()
+{
+   Configuration& C(Configuration::Instance());
+
+   if(C.TropType == "Zero")
+      return new ZeroTropModel(*dynamic_cast<const ZeroTropModel *>(pTrop));
+   if(C.TropType == "Black")
+      return new SimpleTropModel(*dynamic_cast<const SimpleTropModel *>(pTrop));
+   if(C.TropType == "Saas")
+      return new SaasTropModel(*dynamic_cast<const SaasTropModel *>(pTrop));
+   if(C.TropType == "GG")
+      return new GGTropModel(*dynamic_cast<const GGTropModel *>(pTrop));
+   if(C.TropType == "GGht")
+      return new GGHeightTropModel(*dynamic_cast<const GGHeightTropModel *>(pTrop));
+   if(C.TropType == "Neill")
+      return new NeillTropModel(*dynamic_cast<const NeillTropModel *>(pTrop));
+   return new NBTropModel(*dynamic_cast<const NBTropModel *>(pTrop));
+}
+
+//------------------------------------------------------------------------------------
+// A batch of epochs, cut into consecutive chunks; each thread processes the next
+// chunk that nobody has taken yet, with its own copy of the solution objects and
+// the trop model.
+class Batch {
+public:
+   vector<EpochJob> *pJobs;
+   Rinex3ObsHeader *pRhead;
+   const map<string,int> *pDCBindex;
+   const Position *pPrevPos;
+   size_t chunkSize;
+   vector<vector<SolutionObject> > SolObjs;     // for each chunk, at its end
+   size_t next;
+   bool failed;
+   Exception error;
+#ifdef GPSTK_HAVE_PTHREAD
+   pthread_mutex_t mutex;
+#endif
+};
+
+// Take the next chunk, or return false when none is left or another thread has
+// already failed
+bool TakeChunk(Batch& b, size_t& n)
+{
+#ifdef GPSTK_HAVE_PTHREAD
+   pthread_mutex_lock(&b.mutex);
+#endif
+   bool ok(!b.failed && b.next < b.SolObjs.size());
+   if(ok) n = b.next++;
+#ifdef GPSTK_HAVE_PTHREAD
+   pthread_mutex_unlock(&b.mutex);
+#endif
+   return ok;
+}
+
+// Keep the first error, it is thrown again once all the threads have finished
+void ReportError(Batch& b, const Exception& e)
+{
+#ifdef GPSTK_HAVE_PTHREAD
+   pthread_mutex_lock(&b.mutex);
+#endif
+   if(!b.failed) {
+      b.failed = true;
+      b.error = e;
+   }
+#ifdef GPSTK_HAVE_PTHREAD
+   pthread_mutex_unlock(&b.mutex);
+#endif
+}
+
+// Process the epochs [first,end) of the batch, using SolObjs and pTrop; the log,
+// ORDs and statistics of those not before 'begin' are saved in the EpochJobs.
+// Set found[i] if SolObjs[i] has found a RAIM solution.
+void ProcessEpochs(Batch& b, size_t first, size_t begin, size_t end,
+                   vector<SolutionObject>& SolObjs, TropModel *pTrop,
+                   vector<bool>& found) throw(Exception)
+{
+   Configuration& C(Configuration::Instance());
+   vector<EpochJob>& jobs(*b.pJobs);
+   Rinex3ObsHeader Rhead(*b.pRhead);
+   size_t i,k;
+
+   for(k=first; k<end; k++) {
+      EpochJob& job(jobs[k]);
+      bool warm(k < begin);
+      ostringstream oss,ords;
+      Rinex3ObsData Rdata(job.Rdata), auxData;
+      vector<SolutionObject::EpochStats> stats(SolObjs.size());
+
+      ConfigureLOG::ThreadStream(&oss);
+      for(i=0; i<SolObjs.size(); i++)
+         SolObjs[i].pStats = (warm ? &stats[i] : &job.stats[i]);
+
+      ProcessEpoch(Rdata, Rhead, *b.pDCBindex, *b.pPrevPos, SolObjs, pTrop,
+                   &job, ords, (warm ? auxData : job.auxData));
+
+      for(i=0; i<SolObjs.size(); i++)
+         if(SolObjs[i].pStats->good) found[i] = true;
+
+      if(!warm) {
+         job.log = oss.str();
+         job.ords = ords.str();
+         if(!C.OutputObsFile.empty()) job.outData = Rdata;
+      }
+   }
+
+   ConfigureLOG::ThreadStream(0);
+   for(i=0; i<SolObjs.size(); i++)
+      SolObjs[i].pStats = 0;
+}
+
+// Process chunk n of the batch. The chunk starts with the same solution objects as
+// the main thread; all but the first chunk then warm up on the epochs before them,
+// going back until every solution has been found once (which sets the apriori
+// solution), or else to the start of the batch.
+void ProcessChunk(Batch& b, const size_t n) throw(Exception)
+{
+   Configuration& C(Configuration::Instance());
+   vector<EpochJob>& jobs(*b.pJobs);
+   size_t i;
+   size_t begin(n*b.chunkSize), end(min(begin+b.chunkSize, jobs.size()));
+   size_t nwarm(n == 0 ? 0 : NWarmUpEpochs);
+   vector<SolutionObject>& SolObjs(b.SolObjs[n]);
+   vector<bool> found;
+   TropModel *pTrop(0);
+
+   try {
+      while(1) {
+         size_t first(begin > nwarm ? begin-nwarm : 0);
+
+         SolObjs = C.SolObjs;
+         for(i=0; i<SolObjs.size(); i++)
+            SolObjs[i].prs.memory.deferAdd = true;
+
+         // the trop model, with the weather before the first epoch
+         delete pTrop;
+         pTrop = CopyTropModel(C.pTrop);
+         if(C.MetStore.size() > 0 && first > 0) {
+            const EpochJob& prev(jobs[first-1]);
+            pTrop->setWeather(prev.Temp,prev.Press,prev.Humid);
+         }
+
+         found.assign(SolObjs.size(), false);
+         for(i=0; i<SolObjs.size(); i++)
+            found[i] = !SolObjs[i].isValid;
+         ProcessEpochs(b, first, begin, begin, SolObjs, pTrop, found);
+
+         if(first == 0 || find(found.begin(),found.end(),false) == found.end())
+            break;
+         nwarm *= 4;
+      }
+
+      ProcessEpochs(b, begin, begin, end, SolObjs, pTrop, found);
+   }
+   catch(Exception& e) {
+      ConfigureLOG::ThreadStream(0);
+      delete pTrop;
+      GPSTK_RETHROW(e);
+   }
+
+   delete pTrop;
+}
+
+void RunBatch(Batch& b)
+{
+   size_t n(0);
+   while(TakeChunk(b, n)) {
+      try { ProcessChunk(b, n); }
+      catch(Exception& e) { ReportError(b, e); }
+      catch(std::exception& e) { ReportError(b, Exception(e.what())); }
+      catch(...) { ReportError(b, Exception("Unknown exception")); }
+   }
+}
+
+#ifdef GPSTK_HAVE_PTHREAD
+// C-style function to be called with pthreads
+extern "C"
+{
+   static void *BatchThread(void *pBatch)
+   {
+      RunBatch(*static_cast<Batch *>(pBatch));
+      return 0;
+   }
+}
+#endif
+
+//------------------------------------------------------------------------------------
+// Process a batch of epochs in C.nThreads threads, then write out everything, in
+// time order, and accumulate the statistics of the solutions in C.SolObjs in time
+// order, exactly as if the epochs had been processed in sequence. The solution
+// objects then carry on from the state of the last epoch.
+void ProcessBatch(vector<EpochJob>& jobs, Rinex3ObsHeader& Rhead,
+                  const map<string,int>& mapDCBindex, const Position& PrevPos,
+                  Rinex3ObsStream& ostrm) throw(Exception)
+{
+try {
+   Configuration& C(Configuration::Instance());
+   size_t i,k,n;
+
+   if(jobs.empty()) return;
+
+   Batch b;
+   b.pJobs = &jobs;
+   b.pRhead = &Rhead;
+   b.pDCBindex = &mapDCBindex;
+   b.pPrevPos = &PrevPos;
+   b.chunkSize = (jobs.size() + C.nThreads - 1) / C.nThreads;
+   n = (jobs.size() + b.chunkSize - 1) / b.chunkSize;
+   b.SolObjs.resize(n);
+   b.next = 0;
+   b.failed = false;
+
+#ifdef GPSTK_HAVE_PTHREAD
+   pthread_mutex_init(&b.mutex, NULL);
+
+   // the calling thread does its share of the work too
+   vector<pthread_t> threads(n-1);
+   size_t started(0);
+   for(i=0; i<threads.size(); i++) {
+      if(pthread_create(&threads[i], NULL, BatchThread, &b) != 0) break;
+      ++started;
+   }
+#endif
+
+   RunBatch(b);
+
+#ifdef GPSTK_HAVE_PTHREAD
+   for(i=0; i<started; i++)
+      pthread_join(threads[i], NULL);
+
+   pthread_mutex_destroy(&b.mutex);
+#endif
+
+   if(b.failed) GPSTK_THROW(b.error);
+
+   // write out, and accumulate statistics, in time order
+   for(k=0; k<jobs.size(); k++) {
+      EpochJob& job(jobs[k]);
+      LOGstrm << job.prelog;
+
+      // PFR records go into the log, in order, as the statistics are added
+      size_t pos(0);
+      for(i=0; i<C.SolObjs.size(); i++) {
+         if(!job.stats[i].good) continue;
+         LOGstrm << job.log.substr(pos, job.stats[i].logpos-pos);
+         pos = job.stats[i].logpos;
+         C.SolObjs[i].AddStats(job.stats[i],job.Rdata.time);
+      }
+      LOGstrm << job.log.substr(pos);
+
+      if(C.ORDout) C.ordstrm << job.ords;
+
+      if(!C.OutputObsFile.empty()) {
+         ostrm << job.auxData;
+         ostrm << job.outData;
+      }
+   }
+
+   // carry on from the last chunk, keeping the accumulated statistics
+   vector<SolutionObject>& last(b.SolObjs[n-1]);
+   for(i=0; i<C.SolObjs.size(); i++) {
+      PRSMemory memory(C.SolObjs[i].prs.memory);
+      memory.APSolution = last[i].prs.memory.APSolution;
+      C.SolObjs[i].prs = last[i].prs;
+      C.SolObjs[i].prs.memory = memory;
+   }
+   if(C.MetStore.size() > 0)
+      C.pTrop->setWeather(C.defaultTemp,C.defaultPress,C.defaultHumid);
+
+   jobs.clear();
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+}  // end ProcessBatch()
+
 //------------------------------------------------------------------------------------
 // Return 0 ok, >0 number of files successfully read, <0 fatal error
 int ProcessFiles(void) throw(Exception)
@@ -1218,10 +1725,12 @@ int ProcessFiles(void) throw(Exception)
 try {
    Configuration& C(Configuration::Instance());
    bool firstepoch(true);
-   int k,iret,nfiles;
+   int iret,nfiles;
    size_t i,j,nfile;
    Position PrevPos(C.knownPos);
    Rinex3ObsStream ostrm;
+   vector<EpochJob> jobs;        // batch of epochs, if using several threads
+   ostringstream pending;        // log written while reading the batch
 
    for(nfiles=0,nfile=0; nfile<C.InputObsFiles.size(); nfile++) {
       Rinex3ObsStream istrm;
@@ -1266,7 +1775,6 @@ try {
       }
 
       // does header include C1C (for DCB correction)?
-      bool DCBcorr(false);
       map<string,int> mapDCBindex;
       for(;;) {
          map<string,vector<RinexObsID> >::const_iterator sit;
@@ -1274,7 +1782,6 @@ try {
          for( ; sit != Rhead.mapObsTypes.end(); ++sit) {
             for(i=0; i<sit->second.size(); i++) {
                if(asString(sit->second[i]) == string("C1C")) {
-                  DCBcorr = true;
                   mapDCBindex.insert(map<string,int>::value_type(sit->first,i));
                   LOG(DEBUG) << "Correct for DCB: found " << asString(sit->second[i])
                      << " for system " << sit->first << " at index " << i;
@@ -1350,6 +1857,7 @@ try {
       }
 
       // loop over epochs ---------------------------------------------
+      if(C.nThreads > 1) ConfigureLOG::ThreadStream(&pending);
       while(1) {
          try { istrm >> Rdata; }
          catch(Exception& e) {
@@ -1404,153 +1912,65 @@ try {
             }
          }
 
-         // reset solution objects for this epoch
-         for(i=0; i<C.SolObjs.size(); ++i)
-            C.SolObjs[i].EpochReset();
-
-         // loop over satellites -----------------------------
-         RinexSatID sat;
-         Rinex3ObsData::DataMap::iterator it;
-         for(it=Rdata.obs.begin(); it!=Rdata.obs.end(); ++it) {
-            sat = it->first;
-            vector<RinexDatum>& vrdata(it->second);
-            string sys(asString(sat.systemChar()));
-
-            // is this system excluded?
-            if(find(C.allSystemChars.begin(),C.allSystemChars.end(),sys)
-                  == C.allSystemChars.end())
-            {
-               LOG(DEBUG) << " Sat " << sat << " : system " << sys
-                  << " is not needed.";
-               continue;
-            }
-
-            // has user excluded this satellite?
-            if(find(C.exclSat.begin(),C.exclSat.end(),sat) != C.exclSat.end()) {
-               LOG(DEBUG) << " Sat " << sat << " is excluded.";
-               continue;
+         // save the epoch for a batch to be processed in several threads; the
+         // first epochs are processed at once, until the trop model is set up
+         if(C.nThreads > 1 && C.TropPos && C.TropTime) {
+            jobs.push_back(EpochJob());
+            EpochJob& job(jobs.back());
+            job.Rdata = Rdata;
+            job.stats.resize(C.SolObjs.size());
+            job.prelog = pending.str();
+            pending.str("");
+
+            // weather, from the Met store searched in time order
+            if(C.MetStore.size() > 0) {
+               ostringstream oss;
+               ConfigureLOG::ThreadStream(&oss);
+               C.findWeather(Rdata.time);
+               ConfigureLOG::ThreadStream(&pending);
+               job.metlog = oss.str();
             }
-
-            // correct for DCB
-            if(DCBcorr && mapDCBindex.find(sys) != mapDCBindex.end()) {
-               i = mapDCBindex[sys];
-               if(C.P1C1bias.find(sat) != C.P1C1bias.end()) {
-                  LOG(DEBUG) << "Correct data " << asString(Rhead.mapObsTypes[sys][i])
-                     << " = " << fixed << setprecision(2) << vrdata[i].data
-                     << " for DCB with " << C.P1C1bias[sat];
-                  vrdata[i].data += C.P1C1bias[sat];
-               }
+            job.Temp = C.defaultTemp;
+            job.Press = C.defaultPress;
+            job.Humid = C.defaultHumid;
+
+            if(jobs.size() >= C.nThreads * EpochsPerThread) {
+               ConfigureLOG::ThreadStream(0);
+               ProcessBatch(jobs, Rhead, mapDCBindex, PrevPos, ostrm);
+               ConfigureLOG::ThreadStream(&pending);
             }
+            continue;
+         }
 
-            // elevation mask, azimuth and ephemeris range corrected with trop
-            // - pass elev to CollectData for m-cov matrix and ORDs
-            double elev(0), ER(0), tcorr;
-            if((C.elevLimit > 0 || C.weight || C.ORDout)
-                              && PrevPos.getCoordinateSystem() != Position::Unknown) {
-               CorrectedEphemerisRange CER;
-               try {
-                  CER.ComputeAtReceiveTime(Rdata.time, PrevPos, sat, *C.pEph);
-                  elev = CER.elevation;
-                  // const double azim = CER.azimuth;
-                  if(C.ORDout) {
-                     tcorr = C.pTrop->correction(PrevPos,CER.svPosVel.x,Rdata.time);
-                     ER = CER.rawrange - CER.svclkbias - CER.relativity + tcorr;
-                  }
-                  if(elev < C.elevLimit) {         // TD add elev mask [azim]
-                     LOG(VERBOSE) << " Reject sat " << sat << " for elevation "
-                        << fixed << setprecision(2) << elev << " at time "
-                        << printTime(Rdata.time,C.longfmt);
-                     continue;
-                  }
-               }
-               catch(Exception& e) {
-                  LOG(WARNING) << "WARNING : Failed to get elevation for sat "
-                     << sat << " at time " << printTime(Rdata.time,C.longfmt);
-                  continue;
-               }
-            }
-
-            // pick out data for each solution object
-            for(i=0; i<C.SolObjs.size(); ++i)
-               C.SolObjs[i].CollectData(sat,elev,ER,vrdata);
-
-         }  // end loop over satellites
-
-         // debug: dump the RINEX data object
-         if(C.debug > -1) Rdata.dump(LOGstrm,Rhead);
-
-         // update the trop model's weather ------------------
-         if(C.MetStore.size() > 0) C.setWeather(Rdata.time);
-
-         // put a blank line here for readability
-         LOG(INFO) << "";
-
-         // compute the solution(s) --------------------------
-         // tag for DAT - required for PRSplot
-         C.msg = printTime(Rdata.time,"DAT "+C.gpsfmt);
-
-         // compute and print the solution(s) ----------------
-         for(i=0; i<C.SolObjs.size(); ++i) {
-            // skip invalid descriptors
-            if(!C.SolObjs[i].isValid) continue;
-
-            // dump the "DAT" record
-            LOG(INFO) << C.SolObjs[i].dump((C.debug > -1 ? 2:1), "RPF", C.msg);
-
-            // compute the solution
-            j = C.SolObjs[i].ComputeSolution(Rdata.time);
-
-            // write ORDs, even if solution is not good
-            if(C.ORDout) C.SolObjs[i].WriteORDs(Rdata.time,j);
+         if(C.nThreads > 1) {
+            ConfigureLOG::ThreadStream(0);
+            LOGstrm << pending.str();
+            pending.str("");
          }
 
+         // process this epoch
+         Rinex3ObsData auxData;
+         ProcessEpoch(Rdata, Rhead, mapDCBindex, PrevPos,
+                      C.SolObjs, C.pTrop, 0, C.ordstrm, auxData);
+
          // write to output RINEX ----------------------------
          if(!C.OutputObsFile.empty()) {
-            Rinex3ObsData auxData;
-            auxData.time = Rdata.time;
-            auxData.clockOffset = Rdata.clockOffset;
-            auxData.epochFlag = 4;
-            ostringstream oss;
-            // loop over valid descriptors
-            for(k=0,i=0; i<C.SolObjs.size(); ++i) if(C.SolObjs[i].isValid) {
-               oss.str("");
-               oss << "XYZ" << fixed << setprecision(3)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(0)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(1)
-                  << " " << setw(12) << C.SolObjs[i].prs.Solution(2);
-               oss << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-               oss.str("");
-               oss << "CLK" << fixed << setprecision(3);
-
-               for(j=0; j<C.SolObjs[i].prs.SystemIDs.size(); j++) {
-                  RinexSatID sat(1,C.SolObjs[i].prs.SystemIDs[j]);
-                  oss << " " << sat.systemString3()
-                     << " " << setw(11) << C.SolObjs[i].prs.Solution(3+j);
-               }
-               oss << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-               oss.str("");
-               oss << "DIA" << setw(2) << C.SolObjs[i].prs.Nsvs
-                  << fixed << setprecision(2)
-                  << " " << setw(4) << C.SolObjs[i].prs.PDOP
-                  << " " << setw(4) << C.SolObjs[i].prs.GDOP
-                  << " " << setw(8) << C.SolObjs[i].prs.RMSResidual
-                  << " " << C.SolObjs[i].Descriptor;     // may get truncated
-               auxData.auxHeader.commentList.push_back(oss.str());
-               k++;
-            }
-            auxData.numSVs = k;            // number of lines to write
-            auxData.auxHeader.valid |= Rinex3ObsHeader::validComment;
             ostrm << auxData;
-
             ostrm << Rdata;
          }
 
+         if(C.nThreads > 1) ConfigureLOG::ThreadStream(&pending);
+
       }  // end while loop over epochs
 
+      // process the rest of the batch, then write what was logged while reading
+      if(C.nThreads > 1) {
+         ConfigureLOG::ThreadStream(0);
+         ProcessBatch(jobs, Rhead, mapDCBindex, PrevPos, ostrm);
+         LOGstrm << pending.str();
+         pending.str("");
+      }
+
       istrm.close();
 
       // failure due to critical error
@@ -1566,7 +1986,7 @@ try {
 
    return nfiles;
 }
-catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(Exception& e) { ConfigureLOG::ThreadStream(0); GPSTK_RETHROW(e); }
 }  // end ProcessFiles()
 
 //------------------------------------------------------------------------------------
@@ -1615,7 +2035,9 @@ void Configuration::SetDefaults(void) throw()
       maxReject = dummy.NSatsReject;
       nIter = dummy.MaxNIterations;
       convLimit = dummy.ConvergenceLimit;
+      screenRAIM = dummy.ScreenRAIM;
    }
+   nThreads = 1;
 
    userfmt = gpsfmt;
    help = verbose = false;
@@ -1897,9 +2319,14 @@ string Configuration::BuildCommandLine(void) throw()
             "Maximum iteration count in linearized LS");
    opts.Add(0, "conv", "lim", false, false, &convLimit, "",
             "Maximum convergence criterion in estimation in meters");
+   opts.Add(0, "screen", "", false, false, &screenRAIM, "",
+            "Screen RAIM subsets with the linearized solution; faster, but\n"
+            "                      may rarely miss the best subset");
    opts.Add(0, "Trop", "m,T,P,H", false, false, &TropStr, "",
             "Trop model <m> [one of Zero,Black,Saas,NewB,Neill,GG,GGHt\n             "
             "         with optional weather T(C),P(mb),RH(%)]");
+   opts.Add(0, "threads", "n", false, false, &nThreads, "",
+            "Compute solutions in <n> threads, on batches of epochs");
 
    opts.Add(0, "log", "fn", false, false, &LogFile, "# Output [for formats see "
             "GPSTK::Position (--ref) and GPSTK::Epoch (--timefmt)] :",
@@ -2079,6 +2506,16 @@ int Configuration::ExtraProcessing(string& errors, string& extras) throw()
    if(!OutputORDFile.empty() && knownPos.getCoordinateSystem() == Position::Unknown)
       oss << "Error : --ORDs requires --ref\n";
 
+   // threads
+   if(nThreads < 1)
+      oss << "Error : --threads requires a positive number\n";
+#ifndef GPSTK_HAVE_PTHREAD
+   if(nThreads > 1) {
+      ossx << "   Warning - built without POSIX threads; --threads is ignored\n";
+      nThreads = 1;
+   }
+#endif
+
    // add new errors to the list
    msg = oss.str();
    //if(!msg.empty()) cmdlineErrors += msg;
@@ -2094,6 +2531,18 @@ int Configuration::ExtraProcessing(string& errors, string& extras) throw()
 //------------------------------------------------------------------------------------
 // update weather in the trop model using the Met store
 void Configuration::setWeather(const CommonTime& ttag) throw(Exception)
+{
+   try {
+      if(findWeather(ttag))
+         pTrop->setWeather(defaultTemp,defaultPress,defaultHumid);
+   }
+   catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// find the weather in the Met store, for the next time tag; the Met store must be
+// searched in time order
+bool Configuration::findWeather(const CommonTime& ttag) throw(Exception)
 {
    try {
       Configuration& C(Configuration::Instance());
@@ -2111,7 +2560,7 @@ void Configuration::setWeather(const CommonTime& ttag) throw(Exception)
              (nextit == MetStore.end() && (dt=ttag-it->time) >= 0.0 && dt < 900.0))
          {
             // skip if its already done
-            if(it->time == currentTime) break;
+            if(it->time == currentTime) return false;
             currentTime = it->time;
 
             if(it->data.count(RinexMetHeader::TD) > 0)
@@ -2127,9 +2576,7 @@ void Configuration::setWeather(const CommonTime& ttag) throw(Exception)
                << " " << defaultPress
                << " " << defaultHumid;
 
-            pTrop->setWeather(defaultTemp,defaultPress,defaultHumid);
-
-            break;
+            return true;
          }
 
          // time is beyond next epoch
@@ -2139,6 +2586,8 @@ void Configuration::setWeather(const CommonTime& ttag) throw(Exception)
          // do nothing, because ttag is before the next epoch
          else break;
       }
+
+      return false;
    }
    catch(Exception& e) { GPSTK_RETHROW(e); }
 }
@@ -2349,7 +2798,8 @@ void SolutionObject::CollectData(const RinexSatID& sat,
 
 //------------------------------------------------------------------------------------
 // return 0 good, negative failure - same as RAIMCompute
-int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
+int SolutionObject::ComputeSolution(const CommonTime& ttag, TropModel *pTrop)
+   throw(Exception)
 {
    try {
       int i,n,iret;
@@ -2390,7 +2840,7 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
             Vector<double> Resid,Slopes;
             //if(prs.hasMemory) APSol = prs.memory.getAprioriSolution(satSyss);
             iret = prs.SimplePRSolution(ttag, Satellites, SVP,
-                                        invMCov, C.pTrop,
+                                        invMCov, pTrop,
                                         prs.MaxNIterations, prs.ConvergenceLimit,
                                         satSyss, Resid, Slopes);
          }
@@ -2446,7 +2896,7 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
 
       // get the RAIM solution ------------------------------------------
       iret = prs.RAIMCompute(ttag, Satellites, satSyss, PRanges, invMCov, C.pEph,
-                              C.pTrop);
+                              pTrop);
 
       if(iret < 0) {
          LOG(VERBOSE) << "RAIMCompute failed "
@@ -2472,14 +2922,15 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
             << (prs.SlopeFlag ? " large slope":"")       // in PRSplot.pl
             << (prs.TropFlag ? " missed trop. corr.":"");
 
-      // dump pre-fit residuals
-      if(prs.hasMemory && ++nepochs > 1)
-         LOG(VERBOSE) << "RPF " << Descriptor << " PFR"
-            << " " << printTime(ttag,C.gpsfmt)              // time
-            << fixed << setprecision(3)
-            << " " << ::sqrt(prs.memory.getAPV())           // sig(APV)
-            << " " << setw(2) << prs.PreFitResidual.size()  // n resids
-            << " " << prs.PreFitResidual;                   // pre-fit residuals
+      // dump pre-fit residuals, or save them for AddStats()
+      if(pStats) {
+         pStats->good = true;
+         pStats->logpos = size_t(pLOGstrm->tellp());
+         pStats->PFR = prs.PreFitResidual;
+         pStats->adds.swap(prs.memory.Deferred);
+      }
+      else if(prs.hasMemory && ++nepochs > 1)
+         WritePFR(ttag, prs.PreFitResidual);
 
       // compute residuals using known position, and output XYZ resids, NEU resids
       if(C.knownPos.getCoordinateSystem() != Position::Unknown && iret >= 0) {
@@ -2495,7 +2946,13 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
          V(0) = res.X(); V(1) = res.Y(); V(2) = res.Z();
          LOG(INFO) << prs.outputPOSString(string("RPR ")+Descriptor,iret,V);
          // and accumulate statistics on XYZ residuals
-         statsXYZresid.add(V,Cov);
+         if(pStats) {
+            pStats->hasResid = true;
+            pStats->XYZ = V;
+            pStats->CovXYZ = Cov;
+         }
+         else
+            statsXYZresid.add(V,Cov);
 
          // convert to NEU
          V = C.Rot * V;
@@ -2504,7 +2961,12 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
          LOG(INFO) << prs.outputPOSString(string("RNE ")+Descriptor,iret,V);
          // and accumulate statistics on NEU residuals
          //if(iret == 0)        //   TD ? but not if RMS/Slope/TropFlag?
-         statsNEUresid.add(V,Cov);
+         if(pStats) {
+            pStats->NEU = V;
+            pStats->CovNEU = Cov;
+         }
+         else
+            statsNEUresid.add(V,Cov);
       }
 
       // prepare for next epoch
@@ -2512,12 +2974,12 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
       // if trop model has not been initialized, do so
       if(!C.TropPos) {
          Position pos(prs.Solution(0), prs.Solution(1), prs.Solution(2));
-         C.pTrop->setReceiverLatitude(pos.getGeodeticLatitude());
-         C.pTrop->setReceiverHeight(pos.getHeight());
+         pTrop->setReceiverLatitude(pos.getGeodeticLatitude());
+         pTrop->setReceiverHeight(pos.getHeight());
          C.TropPos = true;
       }
       if(!C.TropTime) {
-         C.pTrop->setDayOfYear(static_cast<YDSTime>(ttag).doy);
+         pTrop->setDayOfYear(static_cast<YDSTime>(ttag).doy);
          C.TropTime = true;
       }
 
@@ -2530,7 +2992,8 @@ int SolutionObject::ComputeSolution(const CommonTime& ttag) throw(Exception)
 }
 
 //------------------------------------------------------------------------------------
-int SolutionObject::WriteORDs(const CommonTime& time, const int iret) throw(Exception)
+int SolutionObject::WriteORDs(const CommonTime& time, const int iret,
+                              ostream& ordstrm) throw(Exception)
 {
    try {
       Configuration& C(Configuration::Instance());
@@ -2548,7 +3011,7 @@ int SolutionObject::WriteORDs(const CommonTime& time, const int iret) throw(Exce
          j = jt - prs.SystemIDs.begin();              // index
          clk = prs.Solution(3+j);
 
-         C.ordstrm << "ORD " << RinexSatID(Satellites[i]).toString()
+         ordstrm << "ORD " << RinexSatID(Satellites[i]).toString()
             << " " << printTime(time,C.userfmt) << fixed << setprecision(3)
             << " " << setw(6) << Elevations[i]
             << " " << setw(6) << RIono[i]
@@ -2568,6 +3031,39 @@ int SolutionObject::WriteORDs(const CommonTime& time, const int iret) throw(Exce
    catch(Exception& e) { GPSTK_RETHROW(e); }
 }
 
+//------------------------------------------------------------------------------------
+void SolutionObject::AddStats(const EpochStats& stats, const CommonTime& ttag)
+   throw(Exception)
+{
+   try {
+      for(size_t i=0; i<stats.adds.size(); i++)
+         prs.memory.add(stats.adds[i]);
+
+      if(prs.hasMemory && ++nepochs > 1)
+         WritePFR(ttag, stats.PFR);
+
+      if(stats.hasResid) {
+         statsXYZresid.add(stats.XYZ,stats.CovXYZ);
+         statsNEUresid.add(stats.NEU,stats.CovNEU);
+      }
+   }
+   catch(Exception& e) { GPSTK_RETHROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+void SolutionObject::WritePFR(const CommonTime& ttag, const Vector<double>& PFR)
+   throw()
+{
+   Configuration& C(Configuration::Instance());
+
+   LOG(VERBOSE) << "RPF " << Descriptor << " PFR"
+      << " " << printTime(ttag,C.gpsfmt)              // time
+      << fixed << setprecision(3)
+      << " " << ::sqrt(prs.memory.getAPV())           // sig(APV)
+      << " " << setw(2) << PFR.size()                 // n resids
+      << " " << PFR;                                  // pre-fit residuals
+}
+
 //------------------------------------------------------------------------------------
 void SolutionObject::FinalOutput(void) throw(Exception)
 {
@@ -92,6 +92,54 @@ namespace gpstk
          GPSTK_THROW(e);
       }
 
+      double phi_u = rxgeo.getGeodeticLatitude() / 180.0;
+      double lambda_u = rxgeo.getLongitude() / 180.0;
+
+      return klobuchar(phi_u, lambda_u, YDSTime(time).sod, svel, svaz, freq);
+   }
+
+
+   void IonoModel::getCorrections(const CommonTime& time,
+                                  const Position& rxgeo,
+                                  const std::vector<double>& svel,
+                                  const std::vector<double>& svaz,
+                                  std::vector<double>& corrections,
+                                  Frequency freq) const
+      throw(IonoModel::InvalidIonoModel)
+   {
+
+      if (!valid)
+      {
+         InvalidIonoModel e("Alpha and beta parameters invalid.");
+         GPSTK_THROW(e);
+      }
+
+      if (svaz.size() != svel.size())
+      {
+         InvalidIonoModel e("One azimuth per elevation is needed.");
+         GPSTK_THROW(e);
+      }
+
+         // the receiver and the time are the same for every satellite
+      double phi_u = rxgeo.getGeodeticLatitude() / 180.0;
+      double lambda_u = rxgeo.getLongitude() / 180.0;
+      double sod = YDSTime(time).sod;
+
+      corrections.resize(svel.size());
+      for (size_t i = 0; i < svel.size(); i++)
+         corrections[i] = klobuchar(phi_u, lambda_u, sod, svel[i], svaz[i], freq);
+   }
+
+
+   double IonoModel::klobuchar(double phi_u,
+                               double lambda_u,
+                               double sod,
+                               double svel,
+                               double svaz,
+                               Frequency freq) const
+      throw()
+   {
+
          // all angle units are in semi-circles (radians / TWO_PI)
          // Note: math functions (cos, sin, etc.) require arguments in
          // radians so all semi-circles must be multiplied by TWO_PI
@@ -99,9 +147,6 @@ namespace gpstk
       double azRad = svaz * DEG_TO_RAD;
       double svE = svel / 180.0;
 
-      double phi_u = rxgeo.getGeodeticLatitude() / 180.0;
-      double lambda_u = rxgeo.getLongitude() / 180.0;
-
       double psi = (0.0137 / (svE + 0.11)) - 0.022;
 
       double phi_i = phi_u + psi * std::cos(azRad);
@@ -124,7 +169,7 @@ namespace gpstk
       if (iPER < 72000.0)
          iPER = 72000.0;
 
-      double t = 43200.0 * lambda_i + YDSTime(time).sod;
+      double t = 43200.0 * lambda_i + sod;
       if (t >= 86400.0)
          t -= 86400.0;
       if (t < 0)
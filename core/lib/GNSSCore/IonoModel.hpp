@@ -42,6 +42,8 @@
 #ifndef GPSTK_IONOMODEL_HPP
 #define GPSTK_IONOMODEL_HPP
 
+#include <vector>
+
 #include "CommonTime.hpp"
 #include "EngAlmanac.hpp"
 #include "Position.hpp"
@@ -133,6 +135,26 @@ namespace gpstk
                            Frequency freq = L1) const
          throw(InvalidIonoModel);
 
+         /**
+          * get the ionospheric correction values of several satellites
+          * seen by the same receiver at the same time. The receiver
+          * position and the time of day are converted only once.
+          * \param time the time of the observations
+          * \param rxgeo the WGS84 geodetic position of the receiver
+          * \param svel the elevation angles between the rx and SVs (degrees)
+          * \param svaz the azimuth angles between the rx and SVs (degrees)
+          * \param corrections the ionospheric corrections (meters), one
+          *        per elevation
+          * \param freq the GPS frequency the observations were made from
+          */
+      void getCorrections(const CommonTime& time,
+                          const Position& rxgeo,
+                          const std::vector<double>& svel,
+                          const std::vector<double>& svaz,
+                          std::vector<double>& corrections,
+                          Frequency freq = L1) const
+         throw(InvalidIonoModel);
+
          /// equality operator
       bool operator==(const IonoModel& right) const throw();
 
@@ -141,6 +163,15 @@ namespace gpstk
 
    private:
 
+         /// the correction of one satellite, given the receiver latitude
+         /// and longitude (semi-circles) and the GPS second of day
+      double klobuchar(double phi_u,
+                       double lambda_u,
+                       double sod,
+                       double svel,
+                       double svaz,
+                       Frequency freq) const throw();
+
       double alpha[4];
       double beta[4];
 
@@ -78,6 +78,41 @@ namespace gpstk
    }  // End of method 'IonoModelStore::getCorrection()'
 
 
+
+      /* Get the ionospheric correction values of several satellites seen
+       * by the same receiver at the same time.
+       *
+       * \param time the time of the observations
+       * \param rxgeo the WGS84 geodetic position of the receiver
+       * \param svel the elevation angles between the rx and SVs (degrees)
+       * \param svaz the azimuth angles between the rx and SVs (degrees)
+       * \param corrections the ionospheric corrections (meters)
+       * \param freq the GPS frequency the observations were made from
+       */
+   void IonoModelStore::getCorrections(const CommonTime& time,
+                                       const Position& rxgeo,
+                                       const std::vector<double>& svel,
+                                       const std::vector<double>& svaz,
+                                       std::vector<double>& corrections,
+                                       IonoModel::Frequency freq) const
+      throw(IonoModelStore::NoIonoModelFound)
+   {
+
+      IonoModelMap::const_iterator i = ims.upper_bound(time);
+      if (!ims.empty() && i != ims.begin())
+      {
+         i--;
+         i->second.getCorrections(time, rxgeo, svel, svaz, corrections, freq);
+      }
+      else
+      {
+         NoIonoModelFound e;
+         GPSTK_THROW(e);
+      }
+
+   }  // End of method 'IonoModelStore::getCorrections()'
+
+
       /* Add an IonoModel to this collection
        *
        * \param mt the time the model is valid from
@@ -94,6 +94,26 @@ namespace gpstk
          throw(NoIonoModelFound);
 
 
+         /** Get the ionospheric correction values of several satellites
+          *  seen by the same receiver at the same time.
+          *
+          * \param time the time of the observations
+          * \param rxgeo the WGS84 geodetic position of the receiver
+          * \param svel the elevation angles between the rx and SVs (degrees)
+          * \param svaz the azimuth angles between the rx and SVs (degrees)
+          * \param corrections the ionospheric corrections (meters), one
+          *        per elevation
+          * \param freq the GPS frequency the observations were made from
+          */
+      void getCorrections(const CommonTime& time,
+                          const Position& rxgeo,
+                          const std::vector<double>& svel,
+                          const std::vector<double>& svaz,
+                          std::vector<double>& corrections,
+                          IonoModel::Frequency freq = IonoModel::L1) const
+         throw(NoIonoModelFound);
+
+
          /** Add an IonoModel to this collection
           *
           * \param mt the time the model is valid from
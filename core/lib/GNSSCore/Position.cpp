@@ -1296,12 +1296,18 @@ namespace gpstk
          GPSTK_THROW(ge);
       }
 
-         Position L(A),R(B);
-         L.transformTo(Position::Cartesian);
-         R.transformTo(Position::Cartesian);
-         double dif = RSS(L.X()-R.X(),L.Y()-R.Y(),L.Z()-R.Z());
-         return dif;
-      }
+         // both Cartesian: no need to copy and transform
+      if(A.system == Position::Cartesian && B.system == Position::Cartesian)
+         return RSS(A.theArray[0]-B.theArray[0],
+                    A.theArray[1]-B.theArray[1],
+                    A.theArray[2]-B.theArray[2]);
+
+      Position L(A),R(B);
+      L.transformTo(Position::Cartesian);
+      R.transformTo(Position::Cartesian);
+      double dif = RSS(L.X()-R.X(),L.Y()-R.Y(),L.Z()-R.Z());
+      return dif;
+   }
 
      // Compute the radius of the ellipsoidal Earth, given the geodetic latitude.
      // @param geolat geodetic latitude in degrees
@@ -1325,6 +1331,10 @@ namespace gpstk
    double Position::elevation(const Position& Target) const
       throw(GeometryException)
    {
+         // both Cartesian: go straight to the Triple routine
+      if(system == Cartesian && Target.system == Cartesian)
+         return elvAngle(Target);
+
       Position R(*this),S(Target);
       R.transformTo(Cartesian);
       S.transformTo(Cartesian);
@@ -1384,6 +1394,10 @@ namespace gpstk
    double Position::azimuth(const Position& Target) const
       throw(GeometryException)
    {
+         // both Cartesian: go straight to the Triple routine
+      if(system == Cartesian && Target.system == Cartesian)
+         return azAngle(Target);
+
       Position R(*this),S(Target);
       R.transformTo(Cartesian);
       S.transformTo(Cartesian);
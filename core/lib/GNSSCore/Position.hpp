@@ -78,8 +78,8 @@ namespace gpstk
        * flag of type 'enum CoordinateSystem' giving the coordinate
        * system, and a tolerance for use in comparing Positions. Class
        * Position inherits from class Triple, which is how the
-       * coordinate values are stored (Triple actually uses
-       * std::valarray<double> of length 3). It is important to note
+       * coordinate values are stored (Triple actually uses a
+       * Vec3<double>, held inside the object). It is important to note
        * that Triple:: routines are properly used by Positions ONLY in
        * the Cartesian coordinate system.
        *
@@ -968,7 +968,7 @@ namespace gpstk
           *                    toward y axis (same as longitude)
           *                 radius (meters?) - distance from origin
           */
-         // use std::valarray<double> theArray;  -- inherit from Triple
+         // use Vec3<double> theArray;  -- inherit from Triple
 
          /// semi-major axis of Earth (meters)
       double AEarth;
@@ -99,6 +99,124 @@ namespace gpstk
       return c;
    }  // end TropModel::correction(RX,SV,TT)
 
+      // Compute and return the full tropospheric delays of several satellites
+      // seen by the same receiver at the same time.
+      // @param elevations Elevations of the satellites, in degrees
+      // @param delays     Tropospheric delays in meters, one per elevation
+   void TropModel::corrections(const std::vector<double>& elevations,
+                               std::vector<double>& delays) const
+      throw(InvalidTropModel)
+   {
+      delays.resize(elevations.size());
+      if(elevations.empty())
+         return;
+
+         // leave an invalid model to correction(), which tells what is missing
+      if(!valid)
+         TropModel::batchCorrection(&elevations[0], &delays[0],
+                                    elevations.size());
+      else
+         batchCorrection(&elevations[0], &delays[0], elevations.size());
+
+   }  // end TropModel::corrections(elevations)
+
+      // Compute and return the full tropospheric delays of a batch of
+      // observations spanning several epochs, one day of year at a time.
+      // @param elevations Elevations of the satellites, in degrees
+      // @param times      Time tag of each elevation
+      // @param delays     Tropospheric delays in meters, one per elevation
+   void TropModel::corrections(const std::vector<double>& elevations,
+                               const std::vector<CommonTime>& times,
+                               std::vector<double>& delays)
+      throw(InvalidTropModel, InvalidParameter)
+   {
+      if(times.size() != elevations.size())
+         GPSTK_THROW(InvalidParameter("One time tag per elevation is needed"));
+
+      delays.resize(elevations.size());
+
+      size_t i(0);
+      while(i < elevations.size())
+      {
+            // the run goes on while the (internal) day does not change
+         long day, msod, runDay;
+         double fsod;
+         times[i].getInternal(runDay, msod, fsod);
+         size_t j(i+1);
+         for( ; j < elevations.size(); j++)
+         {
+            times[j].getInternal(day, msod, fsod);
+            if(day != runDay)
+               break;
+         }
+
+         setDayOfYear(int((static_cast<YDSTime>(times[i])).doy));
+         if(!valid)
+            TropModel::batchCorrection(&elevations[i], &delays[i], j-i);
+         else
+            batchCorrection(&elevations[i], &delays[i], j-i);
+
+         i = j;
+      }
+
+   }  // end TropModel::corrections(elevations,times)
+
+      // Compute the delays of n elevations, one by one.
+   void TropModel::batchCorrection(const double *elevation,
+                                   double *delay,
+                                   size_t n) const
+      throw(InvalidTropModel)
+   {
+      for(size_t i=0; i<n; i++)
+         delay[i] = correction(elevation[i]);
+   }
+
+   namespace
+   {
+         // Parameters of a model whose mapping functions have the continued
+         // fraction form of Marini (NB, Saastamoinen and Neill models), with
+         // the height correction of Niell on the dry mapping function.
+      struct MariniParameters
+      {
+         double cutoff;          // delays below this elevation (deg) are zero
+         double dryZenith;       // zenith delays (m)
+         double wetZenith;
+         double ad, bd, cd;      // dry mapping function coefficients
+         double aw, bw, cw;      // wet mapping function coefficients
+         double heightKm;        // receiver height (km) for the height term
+         double floorElev;       // up to this elevation (deg), the height term
+                                 // uses 0.001 for sin(elevation)
+      };
+
+         // Evaluate the delays of a batch of elevations. The sines go through
+         // the output array first, so that the second loop has no call nor
+         // branch and may be vectorized by the compiler.
+      void MariniBatch(const MariniParameters& m,
+                       const double *elevation,
+                       double *delay,
+                       size_t n)
+      {
+         const double ha(2.53e-5), hb(5.49e-3), hc(1.14e-3);
+         const double dryTop(1.0+m.ad/(1.0+m.bd/(1.0+m.cd)));
+         const double wetTop(1.0+m.aw/(1.0+m.bw/(1.0+m.cw)));
+         const double hTop(1.0+ha/(1.0+hb/(1.0+hc)));
+
+         for(size_t i=0; i<n; i++)
+            delay[i] = std::sin(elevation[i]*DEG_TO_RAD);
+
+         for(size_t i=0; i<n; i++)
+         {
+            double se(delay[i]);
+            double sh(elevation[i] <= m.floorElev ? 0.001 : se);
+            double dry(dryTop/(se+m.ad/(se+m.bd/(se+m.cd)))
+                     + m.heightKm*(1.0/sh-hTop/(sh+ha/(sh+hb/(sh+hc)))));
+            double wet(wetTop/(se+m.aw/(se+m.bw/(se+m.cw))));
+            delay[i] = (elevation[i] < m.cutoff ? 0.0
+                        : m.dryZenith*dry + m.wetZenith*wet);
+         }
+      }
+   }
+
       // Re-define the tropospheric model with explicit weather data.
       // Typically called just before correction().
       // @param T temperature in degrees Celsius
@@ -935,6 +1053,7 @@ namespace gpstk
       // Default constructor
    NBTropModel::NBTropModel(void)
    {
+      valid = false;
       validWeather = false;
       validRxLatitude = false;
       validDOY = false;
@@ -1202,6 +1321,30 @@ namespace gpstk
 
    }  // end NBTropModel::wet_mapping_function()
 
+      // Compute the delays of a batch of elevations; the zenith delays and
+      // the mapping coefficients are interpolated only once.
+   void NBTropModel::batchCorrection(const double *elevation,
+                                     double *delay,
+                                     size_t n) const
+      throw(InvalidTropModel)
+   {
+      MariniParameters m;
+      m.cutoff = 0.0;
+      m.dryZenith = dry_zenith_delay();
+      m.wetZenith = wet_zenith_delay();
+      m.ad = NB_Interpolate(latitude,doy,Mad);
+      m.bd = NB_Interpolate(latitude,doy,Mbd);
+      m.cd = NB_Interpolate(latitude,doy,Mcd);
+      m.aw = NB_Interpolate(latitude,doy,Maw);
+      m.bw = NB_Interpolate(latitude,doy,Mbw);
+      m.cw = NB_Interpolate(latitude,doy,Mcw);
+      m.heightKm = height/1000.0;
+      m.floorElev = 0.001;
+
+      MariniBatch(m, elevation, delay, n);
+
+   }  // end NBTropModel::batchCorrection()
+
       // Re-define the weather data.
       // If called, typically called before any calls to correction().
       // @param T temperature in degrees Celsius
@@ -1563,6 +1706,27 @@ namespace gpstk
       }
       if(elevation < 0.0) return 0.0;
 
+      double a,b,c;
+      dryMappingCoefficients(a,b,c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+
+      a = 0.0000253;
+      b = 0.00549;
+      c = 0.00114;
+      map += (height/1000.0)*(1./se-(1+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c))));
+
+      return map;
+
+   }  // end SaasTropModel::dry_mapping_function()
+
+      // Compute the coefficients of the dry mapping function for the
+      // receiver latitude and the day of year
+   void SaasTropModel::dryMappingCoefficients(double& a,
+                                              double& b,
+                                              double& c) const
+   {
       double lat,t,ct;
       lat = fabs(latitude);         // degrees
       t = doy - 28.;                // mid-winter
@@ -1571,7 +1735,6 @@ namespace gpstk
       t *= 360.0/365.25;            // convert to degrees
       ct = ::cos(t*DEG_TO_RAD);
 
-      double a,b,c;
       if(lat < 15.) {
          a = SaasDryA[0];
          b = SaasDryB[0];
@@ -1594,17 +1757,7 @@ namespace gpstk
          c = SaasDryC[4] - ct * SaasDryC1[4];
       }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
-
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += (height/1000.0)*(1./se-(1+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c))));
-
-      return map;
-
-   }  // end SaasTropModel::dry_mapping_function()
+   }  // end SaasTropModel::dryMappingCoefficients()
 
       // Compute and return the mapping function for wet component of the troposphere
       // @param elevation Elevation of satellite as seen at receiver, in degrees.
@@ -1625,8 +1778,23 @@ namespace gpstk
       }
       if(elevation < 0.0) return 0.0;
 
-      double a,b,c,lat;
-      lat = fabs(latitude);         // degrees
+      double a,b,c;
+      wetMappingCoefficients(a,b,c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+
+      return map;
+
+   }  // end SaasTropModel::wet_mapping_function()
+
+      // Compute the coefficients of the wet mapping function for the
+      // receiver latitude
+   void SaasTropModel::wetMappingCoefficients(double& a,
+                                              double& b,
+                                              double& c) const
+   {
+      double lat = fabs(latitude);  // degrees
       if(lat < 15.) {
          a = SaasWetA[0];
          b = SaasWetB[0];
@@ -1645,12 +1813,27 @@ namespace gpstk
          c = SaasWetC[4];
       }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+   }  // end SaasTropModel::wetMappingCoefficients()
 
-      return map;
+      // Compute the delays of a batch of elevations; the zenith delays and
+      // the mapping coefficients are computed only once.
+   void SaasTropModel::batchCorrection(const double *elevation,
+                                       double *delay,
+                                       size_t n) const
+      throw(InvalidTropModel)
+   {
+      MariniParameters m;
+      m.cutoff = 0.0;
+      m.dryZenith = dry_zenith_delay();
+      m.wetZenith = wet_zenith_delay();
+      dryMappingCoefficients(m.ad, m.bd, m.cd);
+      wetMappingCoefficients(m.aw, m.bw, m.cw);
+      m.heightKm = height/1000.0;
+      m.floorElev = -1.0;
 
-   }  // end SaasTropModel::wet_mapping_function()
+      MariniBatch(m, elevation, delay, n);
+
+   }  // end SaasTropModel::batchCorrection()
 
       // Re-define the weather data.
       // If called, typically called before any calls to correction().
@@ -1886,6 +2069,32 @@ namespace gpstk
    }  // end GCATTropModel::mapping_function(elevation)
 
 
+      /* Compute the delays of a batch of elevations; the zenith delays are
+       * computed only once.
+       */
+   void GCATTropModel::batchCorrection( const double *elevation,
+                                        double *delay,
+                                        size_t n ) const
+      throw(InvalidTropModel)
+   {
+      const double zenith(dry_zenith_delay() + wet_zenith_delay());
+
+         // The sines go through the output array first, so that the second
+         // loop has no call nor branch and may be vectorized by the compiler
+      for(size_t i=0; i<n; i++)
+      {
+         delay[i] = std::sin(elevation[i]*DEG_TO_RAD);
+      }
+
+      for(size_t i=0; i<n; i++)
+      {
+         double map( 1.001/SQRT(0.002001+(delay[i]*delay[i])) );
+         delay[i] = (elevation[i] < 5.0 ? 0.0 : zenith*map);
+      }
+
+   }  // end GCATTropModel::batchCorrection()
+
+
       /* Define the receiver height; this is required before calling
        * correction() or any of the zenith_delay or mapping_function routines.
        * @param ht Height of the receiver above mean sea level, in meters.
@@ -2877,6 +3086,29 @@ namespace gpstk
          return 0.0;
       }
 
+      double a, b, c;
+      dryMappingCoefficients(a, b, c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
+
+      a = 0.0000253;
+      b = 0.00549;
+      c = 0.00114;
+      map += ( NeillHeight/1000.0 ) *
+             ( 1./se - ( (1.+a/(1.+b/(1.+c))) / (se+a/(se+b/(se+c))) ) );
+
+      return map;
+
+   }  // end NeillTropModel::dry_mapping_function()
+
+
+      // Compute the coefficients of the dry mapping function for the
+      // receiver latitude and the day of year.
+   void NeillTropModel::dryMappingCoefficients( double& a,
+                                                double& b,
+                                                double& c ) const
+   {
       double lat, t, ct;
       lat = fabs(NeillLat);         // degrees
       t = static_cast<double>(NeillDOY) - 28.0;  // mid-winter
@@ -2889,7 +3121,6 @@ namespace gpstk
       t *= 360.0/365.25;            // convert to degrees
       ct = ::cos(t*DEG_TO_RAD);
 
-      double a, b, c;
       if(lat < 15.0)
       {
          a = NeillDryA[0];
@@ -2915,18 +3146,7 @@ namespace gpstk
          c = NeillDryC[4] - ct * NeillDryC1[4];
       }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = (1.+a/(1.+b/(1.+c)))/(se+a/(se+b/(se+c)));
-
-      a = 0.0000253;
-      b = 0.00549;
-      c = 0.00114;
-      map += ( NeillHeight/1000.0 ) *
-             ( 1./se - ( (1.+a/(1.+b/(1.+c))) / (se+a/(se+b/(se+c))) ) );
-
-      return map;
-
-   }  // end NeillTropModel::dry_mapping_function()
+   }  // end NeillTropModel::dryMappingCoefficients()
 
 
       // Compute and return the mapping function for wet component of the
@@ -2964,8 +3184,24 @@ namespace gpstk
          return 0.0;
       }
 
-      double a,b,c,lat;
-      lat = fabs(NeillLat);         // degrees
+      double a,b,c;
+      wetMappingCoefficients(a,b,c);
+
+      double se = ::sin(elevation*DEG_TO_RAD);
+      double map = ( 1.+ a/ (1.+ b/(1.+c) ) ) / (se + a/(se + b/(se+c) ) );
+
+      return map;
+
+   }  // end NeillTropModel::wet_mapping_function()
+
+
+      // Compute the coefficients of the wet mapping function for the
+      // receiver latitude.
+   void NeillTropModel::wetMappingCoefficients( double& a,
+                                                double& b,
+                                                double& c ) const
+   {
+      double lat = fabs(NeillLat);  // degrees
       if(lat < 15.0)
       {
          a = NeillWetA[0];
@@ -2987,12 +3223,29 @@ namespace gpstk
          c = NeillWetC[4];
       }
 
-      double se = ::sin(elevation*DEG_TO_RAD);
-      double map = ( 1.+ a/ (1.+ b/(1.+c) ) ) / (se + a/(se + b/(se+c) ) );
+   }  // end NeillTropModel::wetMappingCoefficients()
 
-      return map;
 
-   }  // end NeillTropModel::wet_mapping_function()
+      // Compute the delays of a batch of elevations; the zenith delays and
+      // the mapping coefficients are computed only once.
+   void NeillTropModel::batchCorrection( const double *elevation,
+                                         double *delay,
+                                         size_t n ) const
+      throw(InvalidTropModel)
+   {
+
+      MariniParameters m;
+      m.cutoff = 3.0;
+      m.dryZenith = NeillTropModel::dry_zenith_delay();
+      m.wetZenith = NeillTropModel::wet_zenith_delay();
+      dryMappingCoefficients(m.ad, m.bd, m.cd);
+      wetMappingCoefficients(m.aw, m.bw, m.cw);
+      m.heightKm = NeillHeight/1000.0;
+      m.floorElev = -1.0;
+
+      MariniBatch(m, elevation, delay, n);
+
+   }  // end NeillTropModel::batchCorrection()
 
 
       // This method configure the model to estimate the weather using height,
@@ -43,6 +43,8 @@
 #ifndef TROPOSPHERIC_MODELS_GPSTK
 #define TROPOSPHERIC_MODELS_GPSTK
 
+#include <vector>
+
 #include "Exception.hpp"
 #include "ObsEpochMap.hpp"
 #include "WxObsMap.hpp"
@@ -142,6 +144,36 @@ namespace gpstk
          throw(InvalidTropModel)
       { Position R(RX),S(SV);  return TropModel::correction(R,S,tt); }
 
+         /**
+          * Compute and return the full tropospheric delays of several
+          * satellites seen by the same receiver at the same time. The terms
+          * that depend only on the receiver, the day and the weather are
+          * computed once for the whole batch; each delay is the one
+          * correction(elevation) returns for that satellite.
+          * @param elevations Elevations of the satellites as seen at the
+          *                   receiver, in degrees
+          * @param delays     Tropospheric delays in meters, one per elevation
+          */
+      void corrections(const std::vector<double>& elevations,
+                       std::vector<double>& delays) const
+         throw(InvalidTropModel);
+
+         /**
+          * Compute and return the full tropospheric delays of a batch of
+          * observations of one receiver spanning several epochs. The
+          * observations are processed in runs sharing the same day of year,
+          * calling setDayOfYear() before each run, so the model is left set
+          * to the day of the last epoch.
+          * @param elevations Elevations of the satellites as seen at the
+          *                   receiver, in degrees
+          * @param times      Time tag of each elevation
+          * @param delays     Tropospheric delays in meters, one per elevation
+          */
+      void corrections(const std::vector<double>& elevations,
+                       const std::vector<CommonTime>& times,
+                       std::vector<double>& delays)
+         throw(InvalidTropModel, InvalidParameter);
+
          /// Compute and return the zenith delay for dry component of the troposphere
       virtual double dry_zenith_delay(void) const
          throw(InvalidTropModel) = 0;
@@ -203,6 +235,15 @@ namespace gpstk
       static void weatherByStandardAtmosphereModel(const double& ht, double& T, double& P, double& H);
 
    protected:
+         /// Compute the delays of n elevations (degrees) for a valid model.
+         /// This version calls correction(elevation) for each of them;
+         /// models redefine it to hoist the terms that do not depend on the
+         /// elevation out of the loop.
+      virtual void batchCorrection(const double *elevation,
+                                   double *delay,
+                                   size_t n) const
+         throw(InvalidTropModel);
+
       bool valid;                 // true only if current model parameters are valid
       double temp;                // latest value of temperature (kelvin or celsius)
       double press;               // latest value of pressure (millibars)
@@ -759,6 +800,14 @@ namespace gpstk
          /// @param d Day of year.
       void setDayOfYear(const int& d);
 
+   protected:
+         /// Compute the delays of a batch of elevations, interpolating the
+         /// zenith delays and mapping coefficients only once.
+      virtual void batchCorrection(const double *elevation,
+                                   double *delay,
+                                   size_t n) const
+         throw(InvalidTropModel);
+
    private:
       bool interpolateWeather;      // if true, compute T,P,H from latitude,doy
       double height;                // height (m) of the receiver
@@ -920,7 +969,19 @@ namespace gpstk
          /// @param d Day of year.
       void setDayOfYear(const int& d);
 
+   protected:
+         /// Compute the delays of a batch of elevations, computing the
+         /// zenith delays and mapping coefficients only once.
+      virtual void batchCorrection(const double *elevation,
+                                   double *delay,
+                                   size_t n) const
+         throw(InvalidTropModel);
+
    private:
+         /// Mapping function coefficients for the receiver latitude and day
+      void dryMappingCoefficients(double& a, double& b, double& c) const;
+      void wetMappingCoefficients(double& a, double& b, double& c) const;
+
       double height;                /// height (m) of the receiver above the geoid
       double latitude;              /// latitude (deg) of receiver
       int doy;                      /// day of year
@@ -1125,6 +1186,16 @@ namespace gpstk
       virtual void setReceiverHeight(const double& ht);
 
 
+   protected:
+
+         /// Compute the delays of a batch of elevations, computing the
+         /// zenith delays only once.
+      virtual void batchCorrection(const double *elevation,
+                                   double *delay,
+                                   size_t n) const
+         throw(InvalidTropModel);
+
+
    private:
 
          /// Receiver height
@@ -1730,9 +1801,25 @@ namespace gpstk
                                      const Position& rxPos );
 
 
+   protected:
+
+
+         /// Compute the delays of a batch of elevations, computing the
+         /// zenith delays and mapping coefficients only once.
+      virtual void batchCorrection(const double *elevation,
+                                   double *delay,
+                                   size_t n) const
+         throw(InvalidTropModel);
+
+
    private:
 
 
+         /// Mapping function coefficients for the receiver latitude and day
+      void dryMappingCoefficients(double& a, double& b, double& c) const;
+      void wetMappingCoefficients(double& a, double& b, double& c) const;
+
+
       double NeillHeight;
       double NeillLat;
       int NeillDOY;
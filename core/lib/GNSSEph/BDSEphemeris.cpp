@@ -47,7 +47,7 @@
 #include "GPSWeekSecond.hpp"
 #include "WGS84Ellipsoid.hpp"   
 #include "TimeString.hpp"
-#include "Matrix.hpp"
+#include "Mat3.hpp"
 
 using namespace std;
 
@@ -278,47 +278,21 @@ namespace gpstk
       double angleZ = ell.angVelocity() * elapte;
       double cosZ = ::cos(angleZ);
       double sinZ = ::sin(angleZ); 
-
-         // Initiailize 3X3 with all 0.0
-      gpstk::Matrix<double> matZ(3,3); 
-      // Row,Col
-      matZ(0,0) =  cosZ;
-      matZ(0,1) =  sinZ;
-      matZ(0,2) =   0.0;
-      matZ(1,0) = -sinZ;
-      matZ(1,1) =  cosZ; 
-      matZ(1,2) =   0.0;
-      matZ(2,0) =   0.0;
-      matZ(2,1) =   0.0;
-      matZ(2,2) =   1.0; 
+      gpstk::Mat3<double> matZ = gpstk::Mat3<double>::R3(angleZ);
 
       // Rx matrix
       double angleX = -5.0 * PI/180.0;    /// This is a constant.  Should set it once
-      double cosX = ::cos(angleX);
-      double sinX = ::sin(angleX); 
-      gpstk::Matrix<double> matX(3,3);
-      matX(0,0) =   1.0;
-      matX(0,1) =   0.0;
-      matX(0,2) =   0.0;
-      matX(1,0) =   0.0;
-      matX(1,1) =  cosX;
-      matX(1,2) =  sinX;
-      matX(2,0) =   0.0;
-      matX(2,1) = -sinX;
-      matX(2,2) =  cosX;
-
-      // Matrix (single column) of xGK, yGK, zGK
-      gpstk::Matrix<double> inertialPos(3,1);
-      inertialPos(0,0) = xGK;
-      inertialPos(1,0) = yGK;
-      inertialPos(2,0) = zGK;
-
-      gpstk::Matrix<double> result(3,1);
-      result = matZ * matX * inertialPos;
-
-      sv.x[0] = result(0,0);
-      sv.x[1] = result(1,0);
-      sv.x[2] = result(2,0);
+      gpstk::Mat3<double> matX = gpstk::Mat3<double>::R1(angleX);
+
+      // xGK, yGK, zGK
+      gpstk::Vec3<double> inertialPos(xGK, yGK, zGK);
+
+      gpstk::Mat3<double> matZX = matZ * matX;
+      gpstk::Vec3<double> result = matZX * inertialPos;
+
+      sv.x[0] = result[0];
+      sv.x[1] = result[1];
+      sv.x[2] = result[2];
 
       // derivatives of true anamoly and arg of latitude
       dek = amm / G; 
@@ -334,72 +308,31 @@ namespace gpstk
       dyp = drv*sinu + R*cosu*duv;
 
       // Time-derivative of Rz matrix
-      gpstk::Matrix<double> dmatZ(3,3);
-      // Row,Col
-      dmatZ(0,0) =  sinZ * -ell.angVelocity();
-      dmatZ(0,1) = -cosZ * -ell.angVelocity();
-      dmatZ(0,2) =   0.0;
-      dmatZ(1,0) =  cosZ * -ell.angVelocity();
-      dmatZ(1,1) =  sinZ * -ell.angVelocity();
-      dmatZ(1,2) =   0.0;
-      dmatZ(2,0) =   0.0;
-      dmatZ(2,1) =   0.0;
-      dmatZ(2,2) =   0.0;
+      double w = -ell.angVelocity();
+      gpstk::Mat3<double> dmatZ( sinZ * w, -cosZ * w, 0.0,
+                                 cosZ * w,  sinZ * w, 0.0,
+                                      0.0,       0.0, 0.0 );
 
       // Time-derivative of X,Y,Z in interial form
-      gpstk::Matrix<double> dIntPos(3,1);
-      dIntPos(0,0) = - xip * san * OMEGAdot
-                     + dxp * can
-                     - yip * (cinc * can * OMEGAdot
-                             -sinc * san * div )
-                     - dyp * cinc * san;
-      dIntPos(1,0) =   xip * can * OMEGAdot
-                     + dxp * san
-                     - yip * (cinc * san * OMEGAdot
-                             +sinc * can * div )
-                     + dyp * cinc * can;
-      dIntPos(2,0) = yip * cinc * div + dyp * sinc;
-
-      /*
-      cout << "dIntPos : " << dIntPos(0,0) 
-                           << ", " << dIntPos(1,0)
-                           << ", " << dIntPos(2,0) << endl;
-      double vMag = ::sqrt(dIntPos(0,0)*dIntPos(0,0) + 
-                           dIntPos(1,0)*dIntPos(1,0) +                    
-                           dIntPos(2,0)*dIntPos(2,0) );
-      cout << " dIntPos Mag: " << vMag << endl;     
-      cout << "dmatZ : " << dmatZ(0,0) 
-                   << ", " << dmatZ(0,1)
-                   << ", " << dmatZ(0,2) << endl; 
-      cout << "dmatZ : " << dmatZ(1,0) 
-                   << ", " << dmatZ(1,1)
-                   << ", " << dmatZ(1,2) << endl; 
-      cout << "dmatZ : " << dmatZ(2,0) 
-                   << ", " << dmatZ(2,1)
-                   << ", " << dmatZ(2,2) << endl; 
-      */
-      gpstk::Matrix<double> vresult(3,1);
-      vresult =  matZ * matX * dIntPos + 
-                dmatZ * matX * inertialPos;
-
-      /* debug
-      gpstk::Matrix<double> firstHalf(3,1);
-      firstHalf = matZ * matX * dIntPos;
-      gpstk::Matrix<double> secondHalf(3,1);
-      secondHalf = dmatZ * matX * inertialPos;
-
-      cout << "firstHalf: " << firstHalf(0,0)
-                    << ", " << firstHalf(1,0)
-                    << ", " << firstHalf(2,0) << endl;
-      cout << "secondHalf: " << secondHalf(0,0)
-                    << ", " << secondHalf(1,0)
-                    << ", " << secondHalf(2,0) << endl;
-      end debug */
-     
+      gpstk::Vec3<double> dIntPos( - xip * san * OMEGAdot
+                                   + dxp * can
+                                   - yip * (cinc * can * OMEGAdot
+                                           -sinc * san * div )
+                                   - dyp * cinc * san,
+                                     xip * can * OMEGAdot
+                                   + dxp * san
+                                   - yip * (cinc * san * OMEGAdot
+                                           +sinc * can * div )
+                                   + dyp * cinc * can,
+                                   yip * cinc * div + dyp * sinc );
+
+      gpstk::Vec3<double> vresult = matZX * dIntPos +
+                                    dmatZ * (matX * inertialPos);
+
       // Move results into output variables
-      sv.v[0] = vresult(0,0);
-      sv.v[1] = vresult(1,0);
-      sv.v[2] = vresult(2,0);
+      sv.v[0] = vresult[0];
+      sv.v[1] = vresult[1];
+      sv.v[2] = vresult[2];
       
       return sv;
    }
@@ -58,6 +58,8 @@ namespace gpstk
    {
       short startBit;
       short numBits;
+      short word;        ///< Subframe word holding the bits, set in EngNav()
+      short shift;       ///< Right shift of the bits in word, set in EngNav()
    };
 
       /** DecodeQuant contains the information necessary to decode
@@ -72,6 +74,7 @@ namespace gpstk
       short signq;       ///< 0 = unsigned, 1 = signed
       DecodeBits fmt[2]; ///< start bit, #bits for up to 2 sections
       DecodeQuant *nxtq; ///< Pointer to next structure in list
+      double factor;     ///< Product of the three scale factors, set in EngNav()
    };
 
       /** Pointers to list of subframe conversions.  There are ten
@@ -354,6 +357,25 @@ namespace gpstk
          PItab[2-i] = PItab[3-i] / PI;
       }
 
+         // Locate each section within its 30-bit word (no section
+         // crosses a word), and combine the scale factors.  No
+         // quantity has both a scalar and a PI scale factor, so the
+         // product gives the same result as applying them in turn.
+      for (i=0; i<n; i++)
+      {
+         for (short j=0; j<2; j++)
+         {
+            DecodeBits& fmt = formats[i].fmt[j];
+            if (fmt.startBit == 0)
+               continue;
+            fmt.word = (fmt.startBit-1) / 30;
+            fmt.shift = 30 - ((fmt.startBit-1) % 30) - fmt.numBits;
+         }
+         formats[i].factor = LDEXP(formats[i].scale *
+                                   PItab[ formats[i].powPI+3 ],
+                                   formats[i].pow2);
+      }
+
       initialized = 1;
    }
 
@@ -625,34 +647,62 @@ namespace gpstk
    }
 
 
+      /*
+        There is one element in bmask for each of the six parity bits.
+        Each element is a bit mask with bits set corresponding to the
+        bits which are to be exclusive-OR'd together to form the
+        parity check bit.  The following bit maps define the bmask
+        array.  They were drawn from table 20-XIV of ICD-GPS-200C
+        (10 OCT 1993).
+
+        Bit in navigation message
+              bit1                             bit 30
+        bit    12 3456 789. 1234 5678 9.12 3456 789.
+        ---    -------------------------------------
+        D25    11 1011 0001 1111 0011 0100 1000 0000
+        D26    01 1101 1000 1111 1001 1010 0100 0000
+        D27    10 1110 1100 0111 1100 1101 0000 0000
+        D28    01 0111 0110 0011 1110 0110 1000 0000
+        D29    10 1011 1011 0001 1111 0011 0100 0000
+        D30    00 1011 0111 1010 1000 1001 1100 0000
+      */
+   static const uint32_t bmask[6] = { 0x3B1F3480L, 0x1D8F9A40L, 0x2EC7CD00L,
+                                      0x1763E680L, 0x2BB1F340L, 0x0B7A89C0L };
+
+      /** Table of the parity contributed by each byte of a subframe
+       * word.  byteParity[k][b] holds the six parity bits (D25 in
+       * bit 5 through D30 in bit 0) of a word whose k-th least
+       * significant byte is b and whose other bits are zero, so that
+       * the parity of a word is the exclusive-OR of four look-ups. */
+   struct ParityTable
+   {
+      ParityTable()
+      {
+         for (int k=0; k<4; k++)
+         {
+            for (uint32_t b=0; b<256; b++)
+            {
+               uint32_t d = b << (8*k);
+               uint8_t D = 0;
+               for (int j=0; j<6; j++)
+               {
+                  D <<= 1;
+                  D |= BinUtils::countBits(bmask[j] & d) % 2;
+               }
+               byteParity[k][b] = D;
+            }
+         }
+      }
+      uint8_t byteParity[4][256];
+   };
+
+   static const ParityTable parityTable;
+
+
    uint32_t EngNav :: computeParity(uint32_t sfword,
                                     uint32_t psfword,
                                     bool knownUpright)
    {
-         /*
-           This function is somewhat table-driven.  There is one
-           element in bmask for each of the six parity bits.  Each
-           element is a bit mask with bits set corresponding to the
-           bits which are to be exclusive-OR'd together to form the
-           parity check bit.  The following bit maps define the bmask
-           array.  They were drawn from table 20-XIV of ICD-GPS-200C
-           (10 OCT 1993).
-
-           Bit in navigation message
-                 bit1                             bit 30
-           bit    12 3456 789. 1234 5678 9.12 3456 789.
-           ---    -------------------------------------
-           D25    11 1011 0001 1111 0011 0100 1000 0000
-           D26    01 1101 1000 1111 1001 1010 0100 0000
-           D27    10 1110 1100 0111 1100 1101 0000 0000
-           D28    01 0111 0110 0011 1110 0110 1000 0000
-           D29    10 1011 1011 0001 1111 0011 0100 0000
-           D30    00 1011 0111 1010 1000 1001 1100 0000
-         */
-      uint32_t bmask[6] = { 0x3B1F3480L, 0x1D8F9A40L, 0x2EC7CD00L,
-                            0x1763E680L, 0x2BB1F340L, 0x0B7A89C0L };
-
-      uint32_t D = 0;
       uint32_t d = sfword;
       uint32_t D29 = getd29(psfword);
       uint32_t D30 = getd30(psfword);
@@ -663,12 +713,19 @@ namespace gpstk
          // new.
       if (D30 && !knownUpright)
          d = ~d;
-      D |= ((D29 + BinUtils::countBits(bmask[0] & d)) % 2) << 5;
-      D |= ((D30 + BinUtils::countBits(bmask[1] & d)) % 2) << 4;
-      D |= ((D29 + BinUtils::countBits(bmask[2] & d)) % 2) << 3;
-      D |= ((D30 + BinUtils::countBits(bmask[3] & d)) % 2) << 2;
-      D |= ((D30 + BinUtils::countBits(bmask[4] & d)) % 2) << 1;
-      D |= ((D29 + BinUtils::countBits(bmask[5] & d)) % 2);
+      d &= 0x3FFFFFC0L;
+
+      uint32_t D = parityTable.byteParity[0][ d        & 0xff] ^
+                   parityTable.byteParity[1][(d >>  8) & 0xff] ^
+                   parityTable.byteParity[2][(d >> 16) & 0xff] ^
+                   parityTable.byteParity[3][ d >> 24        ];
+
+         // D29 of the previous word enters D25, D27 and D30, and D30
+         // of the previous word enters D26, D28 and D29.
+      if (D29)
+         D ^= 0x29;
+      if (D30)
+         D ^= 0x16;
 
       return D;
    }
@@ -678,9 +735,6 @@ namespace gpstk
                                 bool nib,
                                 bool knownUpright)
    {
-      uint32_t bmask[6] = { 0x3B1F3480L, 0x1D8F9A40L, 0x2EC7CD00L,
-                                 0x1763E680L, 0x2BB1F340L, 0x0B7A89C0L };
-
       uint32_t D = 0;
       uint32_t d = sfword;
       uint32_t D29 = getd29(psfword);
@@ -717,17 +771,14 @@ namespace gpstk
 
    bool EngNav :: checkParity(const uint32_t sf[10], bool knownUpright)
    {
-      return
-         ((sf[0] & 0x0000003f) == computeParity(sf[0],     0, knownUpright)) &&
-         ((sf[1] & 0x0000003f) == computeParity(sf[1], sf[0], knownUpright)) &&
-         ((sf[2] & 0x0000003f) == computeParity(sf[2], sf[1], knownUpright)) &&
-         ((sf[3] & 0x0000003f) == computeParity(sf[3], sf[2], knownUpright)) &&
-         ((sf[4] & 0x0000003f) == computeParity(sf[4], sf[3], knownUpright)) &&
-         ((sf[5] & 0x0000003f) == computeParity(sf[5], sf[4], knownUpright)) &&
-         ((sf[6] & 0x0000003f) == computeParity(sf[6], sf[5], knownUpright)) &&
-         ((sf[7] & 0x0000003f) == computeParity(sf[7], sf[6], knownUpright)) &&
-         ((sf[8] & 0x0000003f) == computeParity(sf[8], sf[7], knownUpright)) &&
-         ((sf[9] & 0x0000003f) == computeParity(sf[9], sf[8], knownUpright));
+      uint32_t prev = 0;
+      for (int n=0; n<10; n++)
+      {
+         if ((sf[n] & 0x0000003f) != computeParity(sf[n], prev, knownUpright))
+            return false;
+         prev = sf[n];
+      }
+      return true;
    }
 
    void EngNav :: convertQuant(const uint32_t input[10],
@@ -735,57 +786,37 @@ namespace gpstk
                                DecodeQuant *p)
       throw()
    {
-      double dval;
-      short i, n, bit1, nword, nbit;
       union equ
       {
          uint32_t u;
          int32_t s;
       } temp;
-      uint32_t *b;
-      uint32_t mask;
+      short n, nbit;
 
-         // Convert starting bit number to word/bit pair
-      temp.u = 0x0L;
-      for (n=0; n<=1; n++)
+         // Extract each section from its word
+      temp.u = input[p->fmt[0].word] >> p->fmt[0].shift;
+      temp.u &= (0x1L << p->fmt[0].numBits) - 1;
+      n = p->fmt[0].numBits;
+      if (p->fmt[1].startBit != 0)
       {
-         if (p->fmt[n].startBit == 0)
-            break;
-         bit1 = p->fmt[n].startBit;
-         nword = (bit1-1) / 30;
-         nbit  = (bit1 % 30) + 1;
-
-         b = const_cast<uint32_t *>( input ) + nword;
-         for (i=0;i<p->fmt[n].numBits;i++)
-         {
-            temp.u <<= 1;
-            mask = 0x80000000L >> nbit++;
-            if (*b & mask)
-               temp.u++;
-            if (nbit>=32)
-            {
-               b++;
-               nbit = 0;
-            }
-         }
+         temp.u <<= p->fmt[1].numBits;
+         temp.u |= (input[p->fmt[1].word] >> p->fmt[1].shift) &
+                   ((0x1L << p->fmt[1].numBits) - 1);
+         n += p->fmt[1].numBits;
       }
 
          // Convert to double and scale
       if (p->signq)
       {
-         nbit = 32 - (p->fmt[0].numBits + p->fmt[1].numBits);
+         nbit = 32 - n;
          temp.u <<= nbit; // Move sign bit to msb
          temp.s >>= nbit; // Move lsb back to right spot with sign extend
-         dval = temp.s;
+         output[p->outIndex] = temp.s * p->factor;
       }
       else
       {
-         dval = temp.u; // msb = 0
+         output[p->outIndex] = temp.u * p->factor; // msb = 0
       }
-      dval = dval * p->scale;             // Scale by scalar
-      dval = dval * PItab[ p->powPI+3 ];  // Scale by power of PI
-      dval = LDEXP(dval,p->pow2);         // Scale by power of 2
-      output[p->outIndex] = dval;         // Store result in output array
    }
  
    void EngNav :: dump(std::ostream& s)
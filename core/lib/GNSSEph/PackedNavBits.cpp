@@ -54,7 +54,8 @@ namespace gpstk
    using namespace std;
    PackedNavBits::PackedNavBits()
                  : transmitTime(CommonTime::BEGINNING_OF_TIME),
-                   bits(900),
+                   bits((900+63)/64),
+                   bits_size(900),
                    bits_used(0),
                    rxID(""),
                    xMitCoerced(false)
@@ -64,7 +65,8 @@ namespace gpstk
    PackedNavBits::PackedNavBits(const SatID& satSysArg, 
                                 const ObsID& obsIDArg,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits((900+63)/64),
+                                  bits_size(900),
                                   bits_used(0),
                                   rxID(""),
                                   xMitCoerced(false)
@@ -79,7 +81,8 @@ namespace gpstk
                                 const ObsID& obsIDArg,
                                 const std::string rxString,
                                 const CommonTime& transmitTimeArg)
-                                : bits(900),
+                                : bits((900+63)/64),
+                                  bits_size(900),
                                   bits_used(0),
                                   rxID(""),
                                   xMitCoerced(false)
@@ -99,11 +102,9 @@ namespace gpstk
       rxID   = right.rxID;
       transmitTime = right.transmitTime;
       bits_used = right.bits_used;
-      bits.resize(bits_used);
-      for (int i=0;i<bits_used;i++)
-      {
-         bits[i] = right.bits[i];
-      }
+      bits = right.bits;
+      bits_size = right.bits_size;
+      resizeBits(bits_used);
       xMitCoerced = right.xMitCoerced;
    }
  
@@ -156,6 +157,7 @@ namespace gpstk
    void PackedNavBits::clearBits()
    {
       bits.clear();
+      bits_size = 0;
       bits_used = 0;
    }
 
@@ -189,20 +191,36 @@ namespace gpstk
                                       const int numBits ) const
       throw(InvalidParameter)                                    
    {
-      uint64_t temp = 0L;       // Set up a temporary variable with a known size
-                                // It needs to be AT LEAST 33 bits.
       size_t stop = startBit + numBits;
-      if (stop>bits.size())
+      if (stop>bits_size)
       {
          InvalidParameter exc("Requested bits not present.");
          GPSTK_THROW(exc);
       }
-      for (size_t i=startBit; i<stop; ++i)
+      if (numBits<=0) return 0;
+
+         // The field spans at most two words.  Left justify it in
+         // temp, then shift it down into place.
+      size_t ndx = startBit >> 6;
+      int offset = startBit & 63;
+      uint64_t temp = bits[ndx] << offset;
+      if (offset+numBits>64)
+         temp |= bits[ndx+1] >> (64-offset);
+      return( temp >> (64-numBits) ); 
+   }
+
+   uint64_t PackedNavBits::asUint64_t(const unsigned startBits[],
+                                      const unsigned numBits[],
+                                      const unsigned len ) const
+      throw(InvalidParameter)
+   {
+      uint64_t temp = 0;
+      for (unsigned i=0; i<len; i++)
       {
-         temp <<= 1;
-         if (bits[i]) temp++;
+         temp <<= numBits[i];
+         temp |= asUint64_t(startBits[i], numBits[i]);
       }
-      return( temp ); 
+      return( temp );
    }
 
    unsigned long PackedNavBits::asUnsignedLong(const int startBit, 
@@ -314,21 +332,7 @@ namespace gpstk
                                                const unsigned len,
                                                const int scale ) const
    {
-      
-      unsigned long ulong = (unsigned long) asUint64_t(startBits[0], numBits[0]);
-      uint64_t temp;
-      for(unsigned int i = 1; i < len; i++){
-         temp = asUint64_t(startBits[i], numBits[i]);
-         ulong <<= numBits[i];
-         ulong |= temp;
-      }
-      
-      //uint64_t temp1 = asUint64_t( startBit1, numBits1 );
-      //uint64_t temp2 = asUint64_t( startBit2, numBits2 );
-      //unsigned long ulong = (unsigned long) temp1;
-      //ulong <<= numBits2;
-      //ulong |= temp2;
-      
+      unsigned long ulong = (unsigned long) asUint64_t(startBits, numBits, len);
       ulong *= scale; 
       return( ulong ); 
    }
@@ -339,20 +343,7 @@ namespace gpstk
                               const unsigned len,
                               const int scale ) const
    {
-      
-      int64_t s = SignExtend(startBits[0], numBits[0]);
-      uint64_t temp;
-      for(unsigned int i = 1; i < len; i++){
-         temp = asUint64_t(startBits[i], numBits[i]);
-         s <<= numBits[i];
-         s |= temp;
-      }
-      
-      //int64_t s = SignExtend( startBit1, numBits1);
-      //uint64_t temp2 = asUint64_t( startBit2, numBits2 );
-      //s <<= numBits2;
-      //s |= temp2;
-      
+      int64_t s = SignExtend(startBits, numBits, len);
       return( (long) (s * scale ) );
    }
 
@@ -362,24 +353,10 @@ namespace gpstk
                                           const unsigned len,
                                           const int power2) const
    {
-      
-      unsigned long ulong = (unsigned long) asUint64_t(startBits[0], numBits[0]);
-      int64_t temp;
-      for(unsigned int i = 1; i < len; i++){
-         temp = asUint64_t(startBits[i], numBits[i]);
-         ulong <<= numBits[i];
-         ulong |= temp;
-      }
-      
-      
-      //uint64_t temp1 = asUint64_t( startBit1, numBits1 );
-      //uint64_t temp2 = asUint64_t( startBit2, numBits2 );
-      //unsigned long ulong = (unsigned long) temp1;
-      //ulong <<= numBits2;
-      //ulong |= temp2;
-      
+      uint64_t uint = asUint64_t(startBits, numBits, len);
+
          // Convert to double and scale
-      double dval = (double) ulong;
+      double dval = (double) uint;
       dval *= pow(static_cast<double>(2), power2);
       return( dval );
    }
@@ -390,18 +367,7 @@ namespace gpstk
                                         const unsigned len,
                                         const int power2) const
    {
-      int64_t s = SignExtend(startBits[0], numBits[0]);
-      uint64_t temp;
-      for(unsigned int i = 1; i < len; i++){
-         temp = asUint64_t(startBits[i], numBits[i]);
-         s <<= numBits[i];
-         s |= temp;
-      }
-      
-      //int64_t s = SignExtend( startBit1, numBits1);
-      //uint64_t temp2 = asUint64_t( startBit2, numBits2 );
-      //s <<= numBits2;
-      //s |= temp2;
+      int64_t s = SignExtend(startBits, numBits, len);
 
          // Convert to double and scale
       double dval = (double) s;
@@ -556,44 +522,57 @@ namespace gpstk
    void PackedNavBits::addPackedNavBits(const PackedNavBits& right)
       throw(InvalidParameter)
    {
-      int old_bits_used = bits_used;
-      bits_used += right.bits_used;
-      bits.resize(bits_used);
-      
-      for (int i=0;i<right.bits_used;i++)
+      resizeBits(bits_used + right.bits_used);
+
+         // Copy a word at a time.  The source bits all lie before
+         // the ones being written, so this works for right==*this.
+      int numToCopy = right.bits_used;
+      for (int i=0;i<numToCopy;i+=64)
       {
-         bits[i+old_bits_used] = right.bits[i];
+         int numBits = numToCopy - i;
+         if (numBits>64) numBits = 64;
+         addUint64_t(right.asUint64_t(i, numBits), numBits);
       }
    }
 
    void PackedNavBits::addUint64_t( const uint64_t value, const int numBits )
    {
-      size_t ndx = bits_used;
-      uint64_t mask = 0x0000000000000001L;
-      mask <<= (numBits-1);
-      for (int i=0; i<numBits; ++i)
+      if (numBits<=0) return;
+      size_t stop = bits_used + numBits;
+      if (stop>bits_size) resizeBits(stop);
+
+         // Left justify the value and a mask of the field, then
+         // write them over the (at most two) words the field spans.
+      uint64_t mask = ~((uint64_t) 0) << (64-numBits);
+      uint64_t temp = (value << (64-numBits)) & mask;
+      size_t ndx = bits_used >> 6;
+      int offset = bits_used & 63;
+      bits[ndx] = (bits[ndx] & ~(mask >> offset)) | (temp >> offset);
+      if (offset+numBits>64)
       {
-         bits[ndx] = false;
-         if (value & mask) 
-         {
-             //set the bits to true
-            bits[ndx] = true;
-         }
-         mask>>= 1;
-         ndx++;
+         bits[ndx+1] = (bits[ndx+1] & ~(mask << (64-offset))) |
+                       (temp << (64-offset));
       }
       bits_used += numBits;
    }
 
+   void PackedNavBits::resizeBits( const size_t numBits )
+   {
+      bits.resize((numBits+63)/64, 0);
+      if (numBits<bits_size && (numBits & 63)!=0)
+         bits.back() &= ~((uint64_t) 0) << (64-(numBits & 63));
+      bits_size = numBits;
+   }
+
    //--------------------------------------------------------------------------
    // Used in NavFilter implementations.   This method ASSUMES the meta-date
    // matches have already been done.  It is simply comparing contents of the
-   // bit array bit-for-bit and returning "less than" if it finds an occasion
-   // in which left has a '0' whereas right has a '1'.
+   // bit array and returning "less than" if, at the first bit that differs, 
+   // left has a '0' whereas right has a '1'.
    //
-   // NOTE: This is one of the cases in which the PackedNavBits implementation 
-   // is probably not the fastest.  Since we are scanning a bit array rather 
-   // than testing a series of unsigned ints.
+   // Since the first bit is held in the most significant bit of the first
+   // word and the unused bits of the last word are zero, this is the same
+   // as comparing the words as unsigned integers.
    bool PackedNavBits::operator<(const PackedNavBits& right) const
    {
          // If the two objects don't have the same number of bits,
@@ -601,17 +580,17 @@ namespace gpstk
          // happen.  In the context of NavFilter, data SHOULD be
          // from the same system, therefore, the same length should 
          // always be true.
-      if (bits.size()!=right.bits.size())
+      if (bits_size!=right.bits_size)
       {
-         if (bits.size()<right.bits.size()) return true;
+         if (bits_size<right.bits_size) return true;
          return false;
       }
 
-      for (int i=0;i<bits.size();i++)
+      for (size_t i=0;i<bits.size();i++)
       {
-         if (bits[i]<right.bits[i])
+         if (bits[i]!=right.bits[i])
          {
-            return true;
+            return (bits[i]<right.bits[i]);
          }
       }
       return false;
@@ -621,7 +600,7 @@ namespace gpstk
    //--------------------------------------------------------------------------
    void PackedNavBits::trimsize()
    {
-      bits.resize(bits_used);
+      resizeBits(bits_used);
    }
 
    //--------------------------------------------------------------------------
@@ -638,6 +617,24 @@ namespace gpstk
       return (s);
    }
 
+   int64_t PackedNavBits::SignExtend( const unsigned startBits[],
+                                      const unsigned numBits[],
+                                      const unsigned len ) const
+   {
+      union
+      {
+         uint64_t u;
+         int64_t s;
+      };
+      int totalBits = 0;
+      for (unsigned i=0; i<len; i++)
+         totalBits += numBits[i];
+      u = asUint64_t( startBits, numBits, len);
+      s <<= 64 - totalBits; // Move sign bit to msb.
+      s >>= 64 - totalBits; // Shift result back to correct location sign bit extended.
+      return (s);
+   }
+
    double PackedNavBits::ScaleValue( const double value, const int power2) const
    {
       double temp = value;
@@ -680,26 +677,23 @@ namespace gpstk
       s << endl;     
 
       s << endl << "Packed Bits, Left Justified, 32 Bits Long:\n";
-      int numBitInWord = 0;
       int word_count   = 0;
-      uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      size_t i;
+      for(i = 0; i+32 <= bits_size; i += 32)
       {
-         word <<= 1;
-         if (bits[i]) word++;
-       
-         numBitInWord++;
-         if (numBitInWord >= 32)
-         {
-            s << "  0x" << setw(8) << setfill('0') << hex << word;
-            numBitInWord = 0;
-            word_count++;
-            //Print four words per line 
-            if (word_count %5 == 0) s << endl;        
-         }
+         uint32_t word = (uint32_t) asUint64_t(i, 32);
+         s << "  0x" << setw(8) << setfill('0') << hex << word;
+         word_count++;
+         //Print four words per line 
+         if (word_count %5 == 0) s << endl;        
+      }
+      int numBitInWord = bits_size - i;
+      if (numBitInWord > 0 )
+      {
+         uint32_t word = (uint32_t) asUint64_t(i, numBitInWord);
+         word <<= 32 - numBitInWord;
+         s << "  0x" << setw(8) << setfill('0') << hex << word;
       }
-      word <<= 32 - numBitInWord;
-      if (numBitInWord > 0 ) s << "  0x" << setw(8) << setfill('0') << hex << word;
       s.setf(ios::fixed, ios::floatfield);
       s.precision(3);
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
@@ -718,38 +712,30 @@ namespace gpstk
       s.setf(ios::uppercase); 
       int rollover = numPerLine;
       
-      int numBitInWord = 0;
-      int bit_count    = 0; 
       int word_count   = 0;
-      uint32_t word    = 0;
-      for(size_t i = 0; i < bits.size(); ++i)
+      size_t i;
+      for(i = 0; i+numBitsPerWord <= bits_size; i += numBitsPerWord)
       {
-         word <<= 1;
-         if (bits[i]) word++;
-       
-         numBitInWord++;
-         if (numBitInWord >= numBitsPerWord)
-         {
-            s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word;
-            word = 0;
-            numBitInWord = 0;
-            word_count++;
+         uint32_t word = (uint32_t) asUint64_t(i, numBitsPerWord);
+         s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word;
+         word_count++;
             
             //Print "numPerLine" words per line,
             //but ONLY if there are more bits left to put on the next line.
-            if (word_count>0 && 
-                word_count % rollover == 0 &&
-                (i+1) < bits.size()) s << endl;        
-         }
+         if (word_count>0 && 
+             word_count % rollover == 0 &&
+             (i+numBitsPerWord) < bits_size) s << endl;        
       }
-         // Need to check if there is a partial word in the buffer
-      word <<= 32 - numBitInWord;
+         // Need to check if there is a partial word left
+      int numBitInWord = bits_size - i;
       if (numBitInWord>0)
       {
+         uint32_t word = (uint32_t) asUint64_t(i, numBitInWord);
+         word <<= 32 - numBitInWord;
          s << delimiter << " 0x" << setw(8) << setfill('0') << hex << word;
       }
       s.flags(oldFlags);      // Reset whatever conditions pertained on entry
-      return(bits.size()); 
+      return(bits_size); 
    }
 
    bool PackedNavBits::operator==(const PackedNavBits& right) const
@@ -800,19 +786,25 @@ namespace gpstk
    {
          // If the two objects don't have the same number of bits,
          // don't even try to compare them. 
-      if (bits.size()!=right.bits.size()) return false; 
+      if (bits_size!=right.bits_size) return false; 
+      if (bits_size==0) return true;
 
       short startBit = startBitA;
       short endBit = endBitA; 
          // Check for nonsense arguments
       if (endBit==-1 ||
-          endBit>=int(bits.size())) endBit = bits.size()-1;
+          endBit>=int(bits_size)) endBit = bits_size-1;
       if (startBit<0) startBit=0;
-      if (startBit>=int(bits.size())) startBit = bits.size()-1;
+      if (startBit>=int(bits_size)) startBit = bits_size-1;
 
-      for (int i=startBit;i<=endBit;i++)
+         // Compare whole words, masking off the bits outside
+         // of [startBit, endBit] in the first and last words.
+      for (int i=startBit>>6;i<=endBit>>6;i++)
       {
-         if (bits[i]!=right.bits[i])
+         uint64_t mask = ~((uint64_t) 0);
+         if (i==(startBit>>6)) mask &= mask >> (startBit & 63);
+         if (i==(endBit>>6)) mask &= ~((uint64_t) 0) << (63 - (endBit & 63));
+         if ((bits[i]^right.bits[i]) & mask)
          {
             return false;
          }
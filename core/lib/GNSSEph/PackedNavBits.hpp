@@ -358,7 +358,12 @@ namespace gpstk
       ObsID obsID;             /**< Defines carrier and code tracked */
       std::string rxID;        /**< Defines the receiver that collected the data */
       CommonTime transmitTime; /**< Time nav message is transmitted */
-      std::vector<bool> bits;  /**< Holds the packed data */
+         /** Holds the packed data, 64 bits per word, the first bit in
+             the most significant bit of the first word.  Bits beyond
+             bits_size are always zero, so that words may be compared
+             directly. */
+      std::vector<uint64_t> bits;
+      size_t bits_size;        /**< Number of bits held in 'bits' */
       int bits_used;
       
       bool xMitCoerced;        /**< Used to indicate that the transmit
@@ -369,11 +374,28 @@ namespace gpstk
       uint64_t asUint64_t(const int startBit, const int numBits ) const 
          throw(InvalidParameter);
 
+         /** Unpack a field split over 'len' disjoint sections as a
+             single value, the first section being the most significant */
+      uint64_t asUint64_t(const unsigned startBits[],
+                          const unsigned numBits[],
+                          const unsigned len ) const
+         throw(InvalidParameter);
+
          /** Pack the bits */
       void addUint64_t( const uint64_t value, const int numBits );
 
+         /** Change the number of bits held, clearing any bits
+             that are dropped */
+      void resizeBits( const size_t numBits );
+
          /** Extend the sign bit for signed values */
       int64_t SignExtend( const int startBit, const int numBits ) const;
+
+         /** Extend the sign bit for signed values split over 'len'
+             disjoint sections */
+      int64_t SignExtend( const unsigned startBits[],
+                          const unsigned numBits[],
+                          const unsigned len ) const;
    
          /** Scales doubles by their corresponding scale factor */
       double ScaleValue( const double value, const int power2) const;
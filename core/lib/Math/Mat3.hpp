@@ -0,0 +1,235 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file Mat3.hpp
+ * Fixed size 3x3 matrix, for rotations in the inner loops
+ */
+
+#ifndef GPSTK_MAT3_HPP
+#define GPSTK_MAT3_HPP
+
+#include "Vec3.hpp"
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A 3x3 matrix whose size is fixed at compile time, stored by
+       * rows inside the object.  Like Vec3, it never allocates and
+       * all of its loops are unrolled; it is meant for the rotations
+       * between coordinate frames, where a gpstk::Matrix is
+       * unnecessarily heavy.  With C++11 the constructors, accessors
+       * and products are constexpr.
+       *
+       * The elementary rotations R1, R2 and R3 follow the convention
+       * of Triple::R1() etc.: they rotate the coordinate frame by the
+       * given angle (in radians here), so R3(a)*v gives the
+       * coordinates of v in a frame rotated by a about Z.
+       */
+   template <class T>
+   class Mat3
+   {
+   public:
+#if __cplusplus >= 201103L
+         /// Default constructor, all elements zero.
+      constexpr Mat3()
+            : m{T(0), T(0), T(0), T(0), T(0), T(0), T(0), T(0), T(0)}
+      {}
+         /// Construct from the elements, given by rows.
+      constexpr Mat3(T a00, T a01, T a02,
+                     T a10, T a11, T a12,
+                     T a20, T a21, T a22)
+            : m{a00, a01, a02, a10, a11, a12, a20, a21, a22}
+      {}
+#else
+         /// Default constructor, all elements zero.
+      Mat3()
+      { for (size_t i = 0; i < 9; i++) m[i] = T(0); }
+         /// Construct from the elements, given by rows.
+      Mat3(T a00, T a01, T a02,
+           T a10, T a11, T a12,
+           T a20, T a21, T a22)
+      {
+         m[0] = a00; m[1] = a01; m[2] = a02;
+         m[3] = a10; m[4] = a11; m[5] = a12;
+         m[6] = a20; m[7] = a21; m[8] = a22;
+      }
+#endif
+
+         /// Construct from three rows.
+      GPSTK_CONSTEXPR Mat3(const Vec3<T>& r0, const Vec3<T>& r1,
+                           const Vec3<T>& r2)
+#if __cplusplus >= 201103L
+            : m{r0[0], r0[1], r0[2], r1[0], r1[1], r1[2], r2[0], r2[1], r2[2]}
+      {}
+#else
+      {
+         for (size_t j = 0; j < 3; j++)
+         {
+            m[j] = r0[j]; m[3+j] = r1[j]; m[6+j] = r2[j];
+         }
+      }
+#endif
+
+         /// The identity matrix.
+      static GPSTK_CONSTEXPR Mat3 identity()
+      { return Mat3(T(1), T(0), T(0), T(0), T(1), T(0), T(0), T(0), T(1)); }
+
+         /// Rotation of the frame by angle (radians) about X.
+      static Mat3 R1(T angle)
+      {
+         T c(std::cos(angle)), s(std::sin(angle));
+         return Mat3(T(1), T(0), T(0), T(0), c, s, T(0), -s, c);
+      }
+         /// Rotation of the frame by angle (radians) about Y.
+      static Mat3 R2(T angle)
+      {
+         T c(std::cos(angle)), s(std::sin(angle));
+         return Mat3(c, T(0), -s, T(0), T(1), T(0), s, T(0), c);
+      }
+         /// Rotation of the frame by angle (radians) about Z.
+      static Mat3 R3(T angle)
+      {
+         T c(std::cos(angle)), s(std::sin(angle));
+         return Mat3(c, s, T(0), -s, c, T(0), T(0), T(0), T(1));
+      }
+
+      static GPSTK_CONSTEXPR size_t rows() { return 3; }
+      static GPSTK_CONSTEXPR size_t cols() { return 3; }
+
+         /// Returns the element at row i, column j (not range checked).
+      GPSTK_CONSTEXPR T operator()(size_t i, size_t j) const
+      { return m[3*i+j]; }
+         /// Returns a modifiable element at row i, column j.
+      T& operator()(size_t i, size_t j)
+      { return m[3*i+j]; }
+
+         /// Returns row i.
+      GPSTK_CONSTEXPR Vec3<T> row(size_t i) const
+      { return Vec3<T>(m[3*i], m[3*i+1], m[3*i+2]); }
+         /// Returns column j.
+      GPSTK_CONSTEXPR Vec3<T> col(size_t j) const
+      { return Vec3<T>(m[j], m[3+j], m[6+j]); }
+
+         /// Pointer to the nine contiguous elements, by rows.
+      T* data() { return m; }
+         /// Pointer to the nine contiguous elements, by rows.
+      const T* data() const { return m; }
+
+         /// Returns the transpose.
+      GPSTK_CONSTEXPR Mat3 transpose() const
+      { return Mat3(m[0], m[3], m[6], m[1], m[4], m[7], m[2], m[5], m[8]); }
+
+         /// Matrix-vector product.
+      GPSTK_CONSTEXPR Vec3<T> operator*(const Vec3<T>& x) const
+      {
+         return Vec3<T>(m[0]*x[0] + m[1]*x[1] + m[2]*x[2],
+                        m[3]*x[0] + m[4]*x[1] + m[5]*x[2],
+                        m[6]*x[0] + m[7]*x[1] + m[8]*x[2]);
+      }
+
+         /// Product of transpose(*this) and x, without forming the
+         /// transpose; for a rotation this is the inverse rotation.
+      GPSTK_CONSTEXPR Vec3<T> transposeTimes(const Vec3<T>& x) const
+      {
+         return Vec3<T>(m[0]*x[0] + m[3]*x[1] + m[6]*x[2],
+                        m[1]*x[0] + m[4]*x[1] + m[7]*x[2],
+                        m[2]*x[0] + m[5]*x[1] + m[8]*x[2]);
+      }
+
+         /// Matrix-matrix product.
+      GPSTK_CONSTEXPR Mat3 operator*(const Mat3& b) const
+      {
+         return Mat3(rc(b,0,0), rc(b,0,1), rc(b,0,2),
+                     rc(b,1,0), rc(b,1,1), rc(b,1,2),
+                     rc(b,2,0), rc(b,2,1), rc(b,2,2));
+      }
+
+      GPSTK_CONSTEXPR Mat3 operator+(const Mat3& b) const
+      {
+         return Mat3(m[0]+b.m[0], m[1]+b.m[1], m[2]+b.m[2],
+                     m[3]+b.m[3], m[4]+b.m[4], m[5]+b.m[5],
+                     m[6]+b.m[6], m[7]+b.m[7], m[8]+b.m[8]);
+      }
+      GPSTK_CONSTEXPR Mat3 operator-(const Mat3& b) const
+      {
+         return Mat3(m[0]-b.m[0], m[1]-b.m[1], m[2]-b.m[2],
+                     m[3]-b.m[3], m[4]-b.m[4], m[5]-b.m[5],
+                     m[6]-b.m[6], m[7]-b.m[7], m[8]-b.m[8]);
+      }
+      GPSTK_CONSTEXPR Mat3 operator*(T s) const
+      {
+         return Mat3(m[0]*s, m[1]*s, m[2]*s, m[3]*s, m[4]*s, m[5]*s,
+                     m[6]*s, m[7]*s, m[8]*s);
+      }
+
+         /// Element by element equality.
+      GPSTK_CONSTEXPR bool operator==(const Mat3& b) const
+      {
+         return row(0) == b.row(0) && row(1) == b.row(1) &&
+                row(2) == b.row(2);
+      }
+
+   private:
+         /// row i of *this times column j of b
+      GPSTK_CONSTEXPR T rc(const Mat3& b, size_t i, size_t j) const
+      { return m[3*i]*b.m[j] + m[3*i+1]*b.m[3+j] + m[3*i+2]*b.m[6+j]; }
+
+      T m[9];
+   };
+
+      /// scalar * matrix
+   template <class T>
+   inline GPSTK_CONSTEXPR Mat3<T> operator*(T s, const Mat3<T>& a)
+   { return a * s; }
+
+      /// Writes a by rows, one per line.
+   template <class T>
+   std::ostream& operator<<(std::ostream& s, const Mat3<T>& a)
+   {
+      for (size_t i = 0; i < 3; i++)
+         s << a(i,0) << " " << a(i,1) << " " << a(i,2) << std::endl;
+      return s;
+   }
+
+      //@}
+
+}  // namespace gpstk
+
+#endif
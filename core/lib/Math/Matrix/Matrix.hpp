@@ -59,10 +59,15 @@ namespace gpstk
 
 
       /**
-       * An implementation of a matrix class using Vector<T> as its
-       * internal basis.  This class is STL compliant with the
+       * An implementation of a matrix class stored in column major
+       * order.  This class is STL compliant with the
        * iterator proceeding in row major order.  Operators +=, -=, *=
        * and /= are implemented in RefMatrixBase.
+       *
+       * Matrices of built-in types with up to MATRIX_INLINE_SIZE
+       * elements (3x3 rotations) are kept inside the object rather than
+       * on the heap; when compiled as C++11 or later, larger ones are
+       * moved rather than copied out of temporaries.
        * 
        * @sa matvectest.cpp for examples
        */
@@ -81,6 +86,9 @@ namespace gpstk
          /// STL const iterator type
       typedef typename Vector<T>::const_iterator const_iterator;  
 
+         /// Number of elements stored inside the object, not on the heap.
+      enum { MATRIX_INLINE_SIZE = InlineStorageSize<T>::MATRIX_SIZE };
+
          /// default constructor
       Matrix();
          /// constructor given an initial size
@@ -92,14 +100,18 @@ namespace gpstk
          /// copies out the contents of vec to initialize the matrix
       template <class BaseClass>
       Matrix(size_t rows, size_t cols, const ConstVectorBase<T, BaseClass>& vec)
-            : v(rows*cols), r(rows), c(cols), s(rows * cols)
-      { this->assignFrom(vec); }
+            : r(rows), c(cols), s(rows * cols),
+              cap(MATRIX_INLINE_SIZE)
+      { v = local.get(); allocate(s); this->assignFrom(vec); }
 
          /// constructor for a ConstMatrixBase object
       template <class BaseClass>
       Matrix(const ConstMatrixBase<T, BaseClass>& mat) 
-            : v(mat.size()), r(mat.rows()), c(mat.cols()), s(mat.size())
+            : r(mat.rows()), c(mat.cols()), s(mat.size()),
+              cap(MATRIX_INLINE_SIZE)
       {
+         v = local.get();
+         allocate(s);
          size_t i,j;
          for(i = 0; i < r; i++)
             for(j = 0; j < c; j++)
@@ -110,8 +122,9 @@ namespace gpstk
       template <class BaseClass>
       Matrix(const ConstMatrixBase<T, BaseClass>& mat, size_t topRow, 
              size_t topCol, size_t numRows, size_t numCols) 
-            : v((size_t)0), r(0), c(0), s(0)
+            : r(0), c(0), s(0), cap(MATRIX_INLINE_SIZE)
       {
+         v = local.get();
             // sanity checks...
          if ( (topCol > mat.cols()) || 
               (topRow > mat.rows()) ||
@@ -126,25 +139,64 @@ namespace gpstk
          r = numRows;
          c = numCols;
          s = r * c;
-         v.resize(r * c);
+         allocate(s);
          size_t i, j;
          for(i = 0; i < r; i++)
             for(j = 0; j < c; j++)
                (*this)(i,j) = mat(topRow + i, topCol + j);
       }
 
+         /// copy constructor
+      Matrix(const Matrix& mat)
+            : r(mat.r), c(mat.c), s(mat.s),
+              cap(MATRIX_INLINE_SIZE)
+      {
+         v = local.get();
+         allocate(s);
+         for (size_t i = 0; i < s; i++)
+            v[i] = mat.v[i];
+      }
+
+#if __cplusplus >= 201103L
+         /// move constructor; takes over the heap storage of mat, if any,
+         /// leaving mat empty.
+      Matrix(Matrix&& mat)
+            : r(mat.r), c(mat.c), s(mat.s),
+              cap(MATRIX_INLINE_SIZE)
+      {
+         v = local.get();
+         if (mat.v != mat.local.get())
+         {
+            v = mat.v;
+            cap = mat.cap;
+            mat.v = mat.local.get();
+            mat.cap = MATRIX_INLINE_SIZE;
+         }
+         else
+         {
+            for (size_t i = 0; i < s; i++)
+               v[i] = mat.v[i];
+         }
+         mat.r = mat.c = mat.s = 0;
+      }
+#endif
+
+         /// destructor
+      ~Matrix()
+      { if (v != local.get()) delete [] v; }
+
          /// STL begin
-      iterator begin() { return v.begin(); }
+      iterator begin() { return v; }
          /// STL const begin
-      const_iterator begin() const { return v.begin(); }
+      const_iterator begin() const { return v; }
          /// STL end
-      iterator end() { return v.end(); }
+      iterator end() { return v + s; }
          /// STL const end
-      const_iterator end() const { return v.end(); }
+      const_iterator end() const { return v + s; }
          /// STL front
-      value_type front() { return v.front(); }
+      value_type front() { return v[s-1]; }
          /// STL const front
-      const_reference front() const { return v.front();}
+      const_reference front() const { return v[s-1];}
          /// STL empty
       bool empty() const { return s == 0; }
          /// STL size
@@ -176,10 +228,10 @@ namespace gpstk
 
          /// Non-const matrix operator(row,col)
       inline T& operator() (size_t rowNum, size_t colNum)
-      { return v(rowNum + colNum * r); }
+      { return v[rowNum + colNum * r]; }
          /// Const matrix operator(row,col)
       inline T operator() (size_t rowNum, size_t colNum) const
-      { return v(rowNum + colNum * r); }
+      { return v[rowNum + colNum * r]; }
          /// operator[] that returns a row slice
       inline MatrixRowSlice<T> operator[] (size_t row)
       { return rowRef(row); }
@@ -209,12 +261,45 @@ namespace gpstk
       { return this->assignFrom(t); }
          /// Copies the other matrix.
       inline Matrix& operator=(const Matrix& mat)
-      { v = mat.v; r = mat.r; c = mat.c; s = mat.s; return *this; }
+      {
+         if (this == &mat)
+            return *this;
+         allocate(mat.s);
+         r = mat.r; c = mat.c; s = mat.s;
+         for (size_t i = 0; i < s; i++)
+            v[i] = mat.v[i];
+         return *this;
+      }
+#if __cplusplus >= 201103L
+         /// Takes over the heap storage of mat, if any, leaving mat empty.
+      inline Matrix& operator=(Matrix&& mat)
+      {
+         if (this == &mat)
+            return *this;
+         if (mat.v != mat.local.get())
+         {
+            if (v != local.get()) delete [] v;
+            v = mat.v;
+            cap = mat.cap;
+            mat.v = mat.local.get();
+            mat.cap = MATRIX_INLINE_SIZE;
+         }
+         else
+         {
+            allocate(mat.s);
+            for (size_t i = 0; i < mat.s; i++)
+               v[i] = mat.v[i];
+         }
+         r = mat.r; c = mat.c; s = mat.s;
+         mat.r = mat.c = mat.s = 0;
+         return *this;
+      }
+#endif
          /// Copies from any matrix.
       template <class BaseClass>
       inline Matrix& operator=(const ConstMatrixBase<T, BaseClass>& mat)
       { 
-         v.resize(mat.size()); 
+         allocate(mat.size()); 
          r=mat.rows(); 
          c=mat.cols(); 
          s=mat.size();
@@ -225,12 +310,32 @@ namespace gpstk
       inline Matrix& operator=(const ConstVectorBase<T, BaseClass>& mat)
       { return this->assignFrom(mat); }
 
+         /// The number of elements the matrix can hold without allocating.
+      size_t capacity() const { return cap; }
+
    private:
-         /// the matrix stored in column major order
-      Vector<T> v;
+         /// Makes room for n elements, reallocating only if there is not
+         /// enough room already. Contents are not kept.
+      void allocate(size_t n)
+      {
+         if (n > cap)
+         {
+            T* p = new T[n];
+            if (v != local.get()) delete [] v;
+            v = p;
+            cap = n;
+         }
+      }
+
+         /// the matrix stored in column major order, either local or on
+         /// the heap
+      T* v;
       size_t r,  ///< the number of rows
          c,  ///< the number of columns
-         s;  ///< the overall size
+         s,  ///< the overall size
+         cap;  ///< the number of elements v can hold
+         /// storage for small matrices
+      InlineBuffer<T, MATRIX_INLINE_SIZE> local;
    };
 
       /**
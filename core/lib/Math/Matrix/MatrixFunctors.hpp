@@ -718,6 +718,327 @@ namespace gpstk
    }; // end class CholeskyCrout
 
 
+      /// In-place Cholesky decomposition of a symmetric positive definite
+      /// matrix, A = L*transpose(L). Only the lower triangle of A is used.
+      /// Unlike Cholesky and CholeskyCrout, the factor is computed within the
+      /// single Matrix L, which is kept between calls, so that repeated
+      /// decompositions of matrices of the same size do not allocate memory.
+      /// Use backSub() to solve A*x=b rather than forming inverse(A); call
+      /// inverse() only when the inverse (e.g. a covariance) is really needed.
+      ///
+      /// @code
+      /// LLTDecomp<double> LLT;
+      /// LLT(N);              // N = AT*W*A, say
+      /// LLT.backSub(b);      // b is now inverse(N)*b
+      /// LLT.inverse(Cov);    // only if the covariance is wanted
+      /// @endcode
+   template <class T>
+   class LLTDecomp
+   {
+   public:
+      LLTDecomp() {}
+
+         /// Does the decomposition; throws if m is not positive definite.
+      template <class BaseClass>
+      void operator() (const ConstMatrixBase<T, BaseClass>& m)
+         throw (MatrixException)
+      {
+         if(!m.isSquare() || m.rows()==0) {
+            MatrixException e("LLTDecomp requires a square, non-trivial matrix");
+            GPSTK_THROW(e);
+         }
+
+         size_t N=m.rows(),i,j,k;
+         T d,t;
+
+         L = m;
+         for(j=0; j<N; j++) {
+            if(L(j,j) <= T(0)) {
+               MatrixException e("LLTDecomp fails - eigenvalue <= 0");
+               GPSTK_THROW(e);
+            }
+            L(j,j) = SQRT(L(j,j));
+            d = T(1)/L(j,j);
+            for(i=j+1; i<N; i++) L(i,j) *= d;
+               // update the trailing lower triangle, one column at a time
+            for(k=j+1; k<N; k++) {
+               t = L(k,j);
+               if(t == T(0)) continue;
+               for(i=k; i<N; i++) L(i,k) -= L(i,j)*t;
+            }
+            for(i=0; i<j; i++) L(i,j) = T(0);
+         }
+      }  // end LLTDecomp::operator()
+
+         /// Solve A*x=b in place, where *this is LLTDecomp(A): first L*y=b,
+         /// then transpose(L)*x=y. x is returned as b.
+      template <class BaseClass2>
+      void backSub(RefVectorBase<T, BaseClass2>& b) const
+         throw (MatrixException)
+      {
+         if(L.rows() != b.size()) {
+            MatrixException e("Vector size does not match dimension of LLTDecomp");
+            GPSTK_THROW(e);
+         }
+
+         size_t N=L.rows(),i,j;
+         T t;
+
+         for(j=0; j<N; j++) {
+            b(j) /= L(j,j);
+            t = b(j);
+            for(i=j+1; i<N; i++) b(i) -= L(i,j)*t;
+         }
+         for(i=N-1; ; i--) {
+            t = b(i);
+            for(j=i+1; j<N; j++) t -= L(j,i)*b(j);
+            b(i) = t / L(i,i);
+            if(i == 0) break;       // b/c i is unsigned
+         }
+      }  // end LLTDecomp::backSub
+
+         /// Compute inverse(A) into inv, where *this is LLTDecomp(A), as
+         /// transpose(inverse(L))*inverse(L); L itself is not changed.
+      void inverse(Matrix<T>& inv) const
+         throw (MatrixException)
+      {
+         size_t N=L.rows(),i,j,k;
+         T t;
+
+         inv.resize(N,N);
+            // inverse(L) into the lower triangle of inv
+         for(j=0; j<N; j++) {
+            inv(j,j) = T(1)/L(j,j);
+            for(i=j+1; i<N; i++) {
+               t = T(0);
+               for(k=j; k<i; k++) t -= L(i,k)*inv(k,j);
+               inv(i,j) = t / L(i,i);
+            }
+         }
+            // transpose(inverse(L))*inverse(L), in place; element (i,j)
+            // needs only rows >= i of columns i and j
+         for(j=0; j<N; j++) {
+            for(i=j; i<N; i++) {
+               t = T(0);
+               for(k=i; k<N; k++) t += inv(k,i)*inv(k,j);
+               inv(i,j) = t;
+            }
+         }
+         for(j=1; j<N; j++)
+            for(i=0; i<j; i++) inv(i,j) = inv(j,i);
+
+      }  // end LLTDecomp::inverse
+
+         /// Rank one update (alpha > 0) or downdate (alpha < 0) of the
+         /// factorization: on return *this is LLTDecomp(A + alpha*x*xT), at a
+         /// cost of O(N*N) instead of the O(N*N*N) of a new decomposition.
+         /// Throws if a downdate leaves the matrix not positive definite.
+      template <class BaseClass2>
+      void rankUpdate(const ConstVectorBase<T, BaseClass2>& x, const T alpha=T(1))
+         throw (MatrixException)
+      {
+         if(L.rows() != x.size()) {
+            MatrixException e("Vector size does not match dimension of LLTDecomp");
+            GPSTK_THROW(e);
+         }
+
+         size_t N=L.rows(),i,k;
+         T r,c,s,sigma(alpha < T(0) ? T(-1) : T(1));
+
+         work = x;
+         work *= SQRT(ABS(alpha));
+         for(k=0; k<N; k++) {
+            r = L(k,k)*L(k,k) + sigma*work(k)*work(k);
+            if(r <= T(0)) {
+               MatrixException e("LLTDecomp::rankUpdate fails - eigenvalue <= 0");
+               GPSTK_THROW(e);
+            }
+            r = SQRT(r);
+            c = r/L(k,k);
+            s = work(k)/L(k,k);
+            L(k,k) = r;
+            for(i=k+1; i<N; i++) {
+               L(i,k) = (L(i,k) + sigma*s*work(i))/c;
+               work(i) = c*work(i) - s*L(i,k);
+            }
+         }
+      }  // end LLTDecomp::rankUpdate
+
+         /// compute determinant from the decomposition
+      inline T det(void)
+         throw(MatrixException)
+      {
+         T d(1);
+         for(size_t i=0; i<L.rows(); i++) d *= L(i,i)*L(i,i);
+         return d;
+      }
+
+         /// Lower triangular factor; the upper triangle is zero.
+      Matrix<T> L;
+
+   private:
+         /// work space for rankUpdate()
+      Vector<T> work;
+
+   }; // end class LLTDecomp
+
+
+      /// In-place decomposition A = L*D*transpose(L) of a symmetric matrix,
+      /// where L is unit lower triangular and D is diagonal. Only the lower
+      /// triangle of A is used. The decomposition needs no square roots and
+      /// succeeds for any symmetric matrix having non-zero leading minors,
+      /// including indefinite ones, so it also serves to detect the loss of
+      /// positive definiteness (a D(i) <= 0). As with LLTDecomp, the work
+      /// Matrix LD is reused between calls.
+   template <class T>
+   class LDLTDecomp
+   {
+   public:
+      LDLTDecomp() {}
+
+         /// Does the decomposition; throws if a zero pivot is found.
+      template <class BaseClass>
+      void operator() (const ConstMatrixBase<T, BaseClass>& m)
+         throw (MatrixException)
+      {
+         if(!m.isSquare() || m.rows()==0) {
+            MatrixException e("LDLTDecomp requires a square, non-trivial matrix");
+            GPSTK_THROW(e);
+         }
+
+         size_t N=m.rows(),i,j,k;
+         T d,t;
+
+         LD = m;
+         for(j=0; j<N; j++) {
+            d = LD(j,j);
+            if(d == T(0)) {
+               SingularMatrixException e("singular matrix!");
+               GPSTK_THROW(e);
+            }
+            for(i=j+1; i<N; i++) LD(i,j) /= d;
+               // update the trailing lower triangle, one column at a time
+            for(k=j+1; k<N; k++) {
+               t = LD(k,j)*d;
+               if(t == T(0)) continue;
+               for(i=k; i<N; i++) LD(i,k) -= LD(i,j)*t;
+            }
+            for(i=0; i<j; i++) LD(i,j) = T(0);
+         }
+      }  // end LDLTDecomp::operator()
+
+         /// Solve A*x=b in place, where *this is LDLTDecomp(A).
+         /// x is returned as b.
+      template <class BaseClass2>
+      void backSub(RefVectorBase<T, BaseClass2>& b) const
+         throw (MatrixException)
+      {
+         if(LD.rows() != b.size()) {
+            MatrixException e("Vector size does not match dimension of LDLTDecomp");
+            GPSTK_THROW(e);
+         }
+
+         size_t N=LD.rows(),i,j;
+         T t;
+
+         for(j=0; j<N; j++) {
+            t = b(j);
+            for(i=j+1; i<N; i++) b(i) -= LD(i,j)*t;
+         }
+         for(i=0; i<N; i++) b(i) /= LD(i,i);
+         for(i=N-1; ; i--) {
+            t = b(i);
+            for(j=i+1; j<N; j++) t -= LD(j,i)*b(j);
+            b(i) = t;
+            if(i == 0) break;       // b/c i is unsigned
+         }
+      }  // end LDLTDecomp::backSub
+
+         /// Compute inverse(A) into inv, where *this is LDLTDecomp(A), as
+         /// transpose(inverse(L))*inverse(D)*inverse(L).
+      void inverse(Matrix<T>& inv) const
+         throw (MatrixException)
+      {
+         size_t N=LD.rows(),i,j,k;
+         T t;
+
+         inv.resize(N,N);
+            // unit lower triangular inverse(L) into the lower triangle of inv
+         for(j=0; j<N; j++) {
+            inv(j,j) = T(1);
+            for(i=j+1; i<N; i++) {
+               t = -LD(i,j);
+               for(k=j+1; k<i; k++) t -= LD(i,k)*inv(k,j);
+               inv(i,j) = t;
+            }
+         }
+            // in place, as in LLTDecomp::inverse()
+         for(j=0; j<N; j++) {
+            for(i=j; i<N; i++) {
+               t = T(0);
+               for(k=i; k<N; k++) t += inv(k,i)*inv(k,j)/LD(k,k);
+               inv(i,j) = t;
+            }
+         }
+         for(j=1; j<N; j++)
+            for(i=0; i<j; i++) inv(i,j) = inv(j,i);
+
+      }  // end LDLTDecomp::inverse
+
+         /// Rank one update of the decomposition: on return *this is
+         /// LDLTDecomp(A + alpha*x*xT); alpha may be negative. This is
+         /// algorithm C1 of Gill, Golub, Murray and Saunders, "Methods for
+         /// Modifying Matrix Factorizations," Math. Comp. 28 (1974).
+      template <class BaseClass2>
+      void rankUpdate(const ConstVectorBase<T, BaseClass2>& x, const T alpha=T(1))
+         throw (MatrixException)
+      {
+         if(LD.rows() != x.size()) {
+            MatrixException e("Vector size does not match dimension of LDLTDecomp");
+            GPSTK_THROW(e);
+         }
+
+         size_t N=LD.rows(),i,j;
+         T a(alpha),p,d,beta;
+
+         work = x;
+         for(j=0; j<N; j++) {
+            p = work(j);
+            d = LD(j,j) + a*p*p;
+            if(d == T(0)) {
+               SingularMatrixException e("singular matrix!");
+               GPSTK_THROW(e);
+            }
+            beta = p*a/d;
+            a *= LD(j,j)/d;
+            LD(j,j) = d;
+            for(i=j+1; i<N; i++) {
+               work(i) -= p*LD(i,j);
+               LD(i,j) += beta*work(i);
+            }
+         }
+      }  // end LDLTDecomp::rankUpdate
+
+         /// compute determinant from the decomposition
+      inline T det(void)
+         throw(MatrixException)
+      {
+         T d(1);
+         for(size_t i=0; i<LD.rows(); i++) d *= LD(i,i);
+         return d;
+      }
+
+         /// L (strictly lower triangle, unit diagonal implied) and D
+         /// (the diagonal) together; the upper triangle is zero.
+      Matrix<T> LD;
+
+   private:
+         /// work space for rankUpdate()
+      Vector<T> work;
+
+   }; // end class LDLTDecomp
+
+
       // The Householder transformation is simply an orthogonal transformation
       // designed to make the elements below the diagonal zero. It applies to any
       // matrix.
@@ -50,26 +50,38 @@ namespace gpstk
 
    template <class T>
    Matrix<T>::Matrix()
-         : v((size_t)0), r(0), c(0), s(0)
-   {}
+         : r(0), c(0), s(0), cap(MATRIX_INLINE_SIZE)
+   { v = local.get(); }
 
 
    template <class T>
    Matrix<T>::Matrix(size_t rows, size_t cols)
-         : v(rows * cols), r(rows), c(cols), s(rows * cols)
-   {}
+         : r(rows), c(cols), s(rows * cols),
+           cap(MATRIX_INLINE_SIZE)
+   {
+      v = local.get();
+      allocate(s);
+   }
 
    template <class T>
    Matrix<T>::Matrix(size_t rows, size_t cols,
                      T initialValue)
-         : v(rows * cols, initialValue), r(rows), c(cols), s(rows * cols)
-   {}
+         : r(rows), c(cols), s(rows * cols),
+           cap(MATRIX_INLINE_SIZE)
+   {
+      v = local.get();
+      allocate(s);
+      this->assignFrom(initialValue);
+   }
 
    template <class T>
    Matrix<T>::Matrix(size_t rows, size_t cols,
                      const T* vec)
-         : v(rows * cols), r(rows), c(cols), s(rows * cols)
+         : r(rows), c(cols), s(rows * cols),
+           cap(MATRIX_INLINE_SIZE)
    {
+      v = local.get();
+      allocate(s);
       this->assignFrom(vec);
    }
 
@@ -132,7 +144,7 @@ namespace gpstk
    template <class T>
    Matrix<T>& Matrix<T>::resize(size_t rows, size_t cols)
    {
-      v.resize(rows * cols);
+      allocate(rows * cols);
       c = cols;
       r = rows;
       s = rows * cols;
@@ -143,11 +155,11 @@ namespace gpstk
    Matrix<T>& Matrix<T>::resize(size_t rows, size_t cols,
                                 const T initialValue)
    {
-      v.resize(rows * cols, initialValue);
+      allocate(rows * cols);
       c = cols;
       r = rows;
       s = rows * cols;
-      return *this;
+      return this->assignFrom(initialValue);
    }
 
       //@}
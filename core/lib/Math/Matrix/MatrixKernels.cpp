@@ -0,0 +1,752 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file MatrixKernels.cpp
+/// Blocked, vectorized matrix product kernels.
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "MatrixKernels.hpp"
+
+#ifdef GPSTK_USE_BLAS
+   // Fortran BLAS interface, which every BLAS implementation provides
+extern "C"
+{
+   void dgemm_(const char *transa, const char *transb,
+               const int *m, const int *n, const int *k,
+               const double *alpha, const double *A, const int *lda,
+               const double *B, const int *ldb,
+               const double *beta, double *C, const int *ldc);
+   void dgemv_(const char *trans, const int *m, const int *n,
+               const double *alpha, const double *A, const int *lda,
+               const double *x, const int *incx,
+               const double *beta, double *y, const int *incy);
+   void dsyrk_(const char *uplo, const char *trans, const int *n, const int *k,
+               const double *alpha, const double *A, const int *lda,
+               const double *beta, double *C, const int *ldc);
+}
+#endif
+
+namespace gpstk
+{
+   namespace
+   {
+         // Size of the register block (micro tile) of C.
+      const std::size_t MR = 4, NR = 4;
+
+         // Cache blocks: a packed [MC,KC] block of A is meant to stay in L2
+         // while [KC,NR] slivers of the packed [KC,NC] panel of B stream
+         // through L1.
+      const std::size_t MC = 96, KC = 256, NC = 2048;
+
+         // Size (in doubles) of the packing buffers kept on the stack.
+      const std::size_t STACK_BUF = 4096;
+
+         // Below this number of multiply-adds, packing doesn't pay.
+      const std::size_t SMALL_GEMM = 16*16*16;
+
+         // Block size (columns of C) used by syrk().
+      const std::size_t SYRK_NB = 64;
+
+#ifdef GPSTK_USE_BLAS
+         // From this number of multiply-adds on, BLAS is used if available.
+      const std::size_t BLAS_GEMM = 64*64*64;
+      const std::size_t BLAS_GEMV = 128*128;
+#endif
+
+         // Element (i,j) of op(X), where op(X) is X or transpose(X).
+      inline double elem(bool trans, const double *X, std::size_t ld,
+                         std::size_t i, std::size_t j)
+      { return trans ? X[j + i*ld] : X[i + j*ld]; }
+
+
+         // C = beta*C, for a [m,n] C; if beta is zero, C may hold garbage.
+      void scaleMatrix(std::size_t m, std::size_t n, double beta,
+                       double *C, std::size_t ldc)
+      {
+         if(beta == 1.0) return;
+         for(std::size_t j=0; j<n; j++) {
+            double *c = C + j*ldc;
+            if(beta == 0.0)
+               for(std::size_t i=0; i<m; i++) c[i] = 0.0;
+            else
+               for(std::size_t i=0; i<m; i++) c[i] *= beta;
+         }
+      }
+
+
+         // C += alpha*op(A)*op(B), unblocked, for small matrices. Each
+         // element of C is a dot product accumulated in a register, which
+         // for these sizes beats any reordering of the loops.
+      void smallGemm(bool transA, bool transB,
+                     std::size_t m, std::size_t n, std::size_t k,
+                     double alpha, const double *A, std::size_t lda,
+                     const double *B, std::size_t ldb,
+                     double *C, std::size_t ldc)
+      {
+         std::size_t i,j,p;
+         std::size_t as(transA ? 1 : lda), ai(transA ? lda : 1),
+                     bs(transB ? ldb : 1), bj(transB ? 1 : ldb);
+         for(j=0; j<n; j++) {
+            double *c = C + j*ldc;
+            const double *b = B + j*bj;
+            for(i=0; i<m; i++) {
+               const double *a = A + i*ai;
+               double sum(0.0);
+               for(p=0; p<k; p++) sum += a[p*as]*b[p*bs];
+               c[i] += alpha*sum;
+            }
+         }
+      }
+
+
+         // Pack op(A)[i0:i0+mc, p0:p0+kc] into row panels of height MR,
+         // each stored as kc consecutive columns of MR elements; the last
+         // panel is padded with zeros.
+      void packA(bool trans, const double *A, std::size_t lda,
+                 std::size_t i0, std::size_t p0,
+                 std::size_t mc, std::size_t kc, double *buf)
+      {
+         for(std::size_t ip=0; ip<mc; ip+=MR) {
+            std::size_t mr = std::min(MR, mc-ip);
+            for(std::size_t p=0; p<kc; p++) {
+               std::size_t r;
+               for(r=0; r<mr; r++) buf[r] = elem(trans,A,lda,i0+ip+r,p0+p);
+               for( ; r<MR; r++) buf[r] = 0.0;
+               buf += MR;
+            }
+         }
+      }
+
+
+         // Pack op(B)[p0:p0+kc, j0:j0+nc] into column panels of width NR,
+         // each stored as kc consecutive rows of NR elements; the last
+         // panel is padded with zeros.
+      void packB(bool trans, const double *B, std::size_t ldb,
+                 std::size_t p0, std::size_t j0,
+                 std::size_t kc, std::size_t nc, double *buf)
+      {
+         for(std::size_t jp=0; jp<nc; jp+=NR) {
+            std::size_t nr = std::min(NR, nc-jp);
+            for(std::size_t p=0; p<kc; p++) {
+               std::size_t c;
+               for(c=0; c<nr; c++) buf[c] = elem(trans,B,ldb,p0+p,j0+jp+c);
+               for( ; c<NR; c++) buf[c] = 0.0;
+               buf += NR;
+            }
+         }
+      }
+
+
+         // The micro kernel: the [MR,NR] tile ab (column major) is set to the
+         // product of a packed [MR,kc] panel of A and a packed [kc,NR] panel
+         // of B, keeping the whole tile in vector registers.
+      inline void microKernel(std::size_t kc, const double *a,
+                              const double *b, double *ab)
+      {
+#if defined(__AVX__)
+         __m256d c0 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd(),
+                 c2 = _mm256_setzero_pd(), c3 = _mm256_setzero_pd();
+         for(std::size_t p=0; p<kc; p++) {
+            __m256d av = _mm256_loadu_pd(a);
+#if defined(__FMA__)
+            c0 = _mm256_fmadd_pd(av, _mm256_broadcast_sd(b  ), c0);
+            c1 = _mm256_fmadd_pd(av, _mm256_broadcast_sd(b+1), c1);
+            c2 = _mm256_fmadd_pd(av, _mm256_broadcast_sd(b+2), c2);
+            c3 = _mm256_fmadd_pd(av, _mm256_broadcast_sd(b+3), c3);
+#else
+            c0 = _mm256_add_pd(c0, _mm256_mul_pd(av, _mm256_broadcast_sd(b  )));
+            c1 = _mm256_add_pd(c1, _mm256_mul_pd(av, _mm256_broadcast_sd(b+1)));
+            c2 = _mm256_add_pd(c2, _mm256_mul_pd(av, _mm256_broadcast_sd(b+2)));
+            c3 = _mm256_add_pd(c3, _mm256_mul_pd(av, _mm256_broadcast_sd(b+3)));
+#endif
+            a += MR;
+            b += NR;
+         }
+         _mm256_storeu_pd(ab,    c0);
+         _mm256_storeu_pd(ab+4,  c1);
+         _mm256_storeu_pd(ab+8,  c2);
+         _mm256_storeu_pd(ab+12, c3);
+#elif defined(__SSE2__)
+         __m128d c00 = _mm_setzero_pd(), c20 = _mm_setzero_pd(),
+                 c01 = _mm_setzero_pd(), c21 = _mm_setzero_pd(),
+                 c02 = _mm_setzero_pd(), c22 = _mm_setzero_pd(),
+                 c03 = _mm_setzero_pd(), c23 = _mm_setzero_pd();
+         for(std::size_t p=0; p<kc; p++) {
+            __m128d a0 = _mm_loadu_pd(a), a2 = _mm_loadu_pd(a+2), bv;
+            bv = _mm_set1_pd(b[0]);
+            c00 = _mm_add_pd(c00, _mm_mul_pd(a0, bv));
+            c20 = _mm_add_pd(c20, _mm_mul_pd(a2, bv));
+            bv = _mm_set1_pd(b[1]);
+            c01 = _mm_add_pd(c01, _mm_mul_pd(a0, bv));
+            c21 = _mm_add_pd(c21, _mm_mul_pd(a2, bv));
+            bv = _mm_set1_pd(b[2]);
+            c02 = _mm_add_pd(c02, _mm_mul_pd(a0, bv));
+            c22 = _mm_add_pd(c22, _mm_mul_pd(a2, bv));
+            bv = _mm_set1_pd(b[3]);
+            c03 = _mm_add_pd(c03, _mm_mul_pd(a0, bv));
+            c23 = _mm_add_pd(c23, _mm_mul_pd(a2, bv));
+            a += MR;
+            b += NR;
+         }
+         _mm_storeu_pd(ab,    c00);
+         _mm_storeu_pd(ab+2,  c20);
+         _mm_storeu_pd(ab+4,  c01);
+         _mm_storeu_pd(ab+6,  c21);
+         _mm_storeu_pd(ab+8,  c02);
+         _mm_storeu_pd(ab+10, c22);
+         _mm_storeu_pd(ab+12, c03);
+         _mm_storeu_pd(ab+14, c23);
+#else
+         std::size_t i,j;
+         for(i=0; i<MR*NR; i++) ab[i] = 0.0;
+         for(std::size_t p=0; p<kc; p++) {
+            for(j=0; j<NR; j++)
+               for(i=0; i<MR; i++) ab[i+j*MR] += a[i]*b[j];
+            a += MR;
+            b += NR;
+         }
+#endif
+      }
+
+
+         // C += alpha*op(A)*op(B), blocked for the caches and registers.
+      void blockedGemm(bool transA, bool transB,
+                       std::size_t m, std::size_t n, std::size_t k,
+                       double alpha, const double *A, std::size_t lda,
+                       const double *B, std::size_t ldb,
+                       double *C, std::size_t ldc)
+      {
+         std::size_t ncMax = std::min(NC, ((n+NR-1)/NR)*NR),
+                     kcMax = std::min(KC, k),
+                     mcMax = std::min(MC, ((m+MR-1)/MR)*MR);
+            // the packing buffers of moderate products live on the stack
+         double stackBuf[STACK_BUF];
+         std::vector<double> heapBuf;
+         double *bufA(stackBuf), *bufB;
+         if(mcMax*kcMax + kcMax*ncMax > STACK_BUF) {
+            heapBuf.resize(mcMax*kcMax + kcMax*ncMax);
+            bufA = &heapBuf[0];
+         }
+         bufB = bufA + mcMax*kcMax;
+         double ab[MR*NR];
+
+         for(std::size_t jc=0; jc<n; jc+=NC) {
+            std::size_t nc = std::min(NC, n-jc);
+            for(std::size_t pc=0; pc<k; pc+=KC) {
+               std::size_t kc = std::min(KC, k-pc);
+               packB(transB, B, ldb, pc, jc, kc, nc, bufB);
+               for(std::size_t ic=0; ic<m; ic+=MC) {
+                  std::size_t mc = std::min(MC, m-ic);
+                  packA(transA, A, lda, ic, pc, mc, kc, bufA);
+                  for(std::size_t jr=0; jr<nc; jr+=NR) {
+                     std::size_t nr = std::min(NR, nc-jr);
+                     for(std::size_t ir=0; ir<mc; ir+=MR) {
+                        std::size_t mr = std::min(MR, mc-ir);
+                        microKernel(kc, bufA + ir*kc, bufB + jr*kc, ab);
+                        double *c = C + (ic+ir) + (jc+jr)*ldc;
+                        for(std::size_t j=0; j<nr; j++)
+                           for(std::size_t i=0; i<mr; i++)
+                              c[i + j*ldc] += alpha*ab[i + j*MR];
+                     }
+                  }
+               }
+            }
+         }
+      }
+
+
+         // Number of reflections in a panel of householder(), and number of
+         // columns to which a panel is applied at once.
+      const std::size_t HH_NB = 8, HH_NW = 8;
+
+         // Apply one Householder reflection (delta, beta, and vector u in row
+         // j and rows i0 to m-1) to the column a.
+      inline void reflect(std::size_t j, std::size_t i0, std::size_t m,
+                          double delta, double beta, const double *u,
+                          double *a)
+      {
+         double sum(delta*a[j]);
+         for(std::size_t i=i0; i<m; i++) sum += u[i]*a[i];
+         if(sum == 0.0) return;
+         sum *= beta;
+         a[j] += sum*delta;
+         for(std::size_t i=i0; i<m; i++) a[i] += sum*u[i];
+      }
+
+         // s[c] = delta*blk(j,c) + sum(u(i)*blk(i,c)), i=i0..m-1, for the
+         // HH_NW columns of blk, which is stored by rows: element (i,c) is
+         // blk[i*HH_NW+c]. The sums of the columns are independent and are
+         // accumulated side by side, in vector registers; each one is still
+         // added up in the order of the rows.
+      inline void blockDots(std::size_t j, std::size_t i0, std::size_t m,
+                            double delta, const double *u, const double *blk,
+                            double *s)
+      {
+         std::size_t i;
+         const double *bj = blk + j*HH_NW;
+#if defined(__AVX__)
+         __m256d dv = _mm256_set1_pd(delta);
+         __m256d s0 = _mm256_mul_pd(dv, _mm256_loadu_pd(bj)),
+                 s1 = _mm256_mul_pd(dv, _mm256_loadu_pd(bj+4));
+         for(i=i0; i<m; i++) {
+            const double *bi = blk + i*HH_NW;
+            __m256d uv = _mm256_broadcast_sd(u+i);
+            s0 = _mm256_add_pd(s0, _mm256_mul_pd(uv, _mm256_loadu_pd(bi)));
+            s1 = _mm256_add_pd(s1, _mm256_mul_pd(uv, _mm256_loadu_pd(bi+4)));
+         }
+         _mm256_storeu_pd(s, s0);
+         _mm256_storeu_pd(s+4, s1);
+#elif defined(__SSE2__)
+         __m128d dv = _mm_set1_pd(delta);
+         __m128d s0 = _mm_mul_pd(dv, _mm_loadu_pd(bj)),
+                 s1 = _mm_mul_pd(dv, _mm_loadu_pd(bj+2)),
+                 s2 = _mm_mul_pd(dv, _mm_loadu_pd(bj+4)),
+                 s3 = _mm_mul_pd(dv, _mm_loadu_pd(bj+6));
+         for(i=i0; i<m; i++) {
+            const double *bi = blk + i*HH_NW;
+            __m128d uv = _mm_set1_pd(u[i]);
+            s0 = _mm_add_pd(s0, _mm_mul_pd(uv, _mm_loadu_pd(bi)));
+            s1 = _mm_add_pd(s1, _mm_mul_pd(uv, _mm_loadu_pd(bi+2)));
+            s2 = _mm_add_pd(s2, _mm_mul_pd(uv, _mm_loadu_pd(bi+4)));
+            s3 = _mm_add_pd(s3, _mm_mul_pd(uv, _mm_loadu_pd(bi+6)));
+         }
+         _mm_storeu_pd(s, s0);
+         _mm_storeu_pd(s+2, s1);
+         _mm_storeu_pd(s+4, s2);
+         _mm_storeu_pd(s+6, s3);
+#else
+         std::size_t c;
+         for(c=0; c<HH_NW; c++) s[c] = delta*bj[c];
+         for(i=i0; i<m; i++) {
+            const double ui(u[i]), *bi = blk + i*HH_NW;
+            for(c=0; c<HH_NW; c++) s[c] += ui*bi[c];
+         }
+#endif
+      }
+
+         // blk(i,c) += s[c]*u(i), i=i0..m-1, for the HH_NW columns of blk.
+         // If un is not null, the sums blockDots() would then give for the
+         // next reflection (pivot jn, vector un in rows i1 to m-1, where
+         // i1>=i0) are returned in sn, accumulated on the same pass.
+      inline void blockUpdate(std::size_t i0, std::size_t i1, std::size_t m,
+                              const double *s, const double *u, double *blk,
+                              std::size_t jn, double dn, const double *un,
+                              double *sn)
+      {
+         std::size_t i;
+         if(!un) i1 = m;
+#if defined(__AVX__)
+         __m256d s0 = _mm256_loadu_pd(s), s1 = _mm256_loadu_pd(s+4);
+         for(i=i0; i<i1; i++) {
+            double *bi = blk + i*HH_NW;
+            __m256d uv = _mm256_broadcast_sd(u+i);
+            _mm256_storeu_pd(bi, _mm256_add_pd(_mm256_loadu_pd(bi),
+                                               _mm256_mul_pd(s0, uv)));
+            _mm256_storeu_pd(bi+4, _mm256_add_pd(_mm256_loadu_pd(bi+4),
+                                                 _mm256_mul_pd(s1, uv)));
+         }
+         if(!un) return;
+
+         const double *bj = blk + jn*HH_NW;
+         __m256d dv = _mm256_set1_pd(dn);
+         __m256d t0 = _mm256_mul_pd(dv, _mm256_loadu_pd(bj)),
+                 t1 = _mm256_mul_pd(dv, _mm256_loadu_pd(bj+4));
+         for(i=i1; i<m; i++) {
+            double *bi = blk + i*HH_NW;
+            __m256d uv = _mm256_broadcast_sd(u+i), wv = _mm256_broadcast_sd(un+i);
+            __m256d b0 = _mm256_add_pd(_mm256_loadu_pd(bi), _mm256_mul_pd(s0, uv)),
+                    b1 = _mm256_add_pd(_mm256_loadu_pd(bi+4),
+                                       _mm256_mul_pd(s1, uv));
+            _mm256_storeu_pd(bi, b0);
+            _mm256_storeu_pd(bi+4, b1);
+            t0 = _mm256_add_pd(t0, _mm256_mul_pd(wv, b0));
+            t1 = _mm256_add_pd(t1, _mm256_mul_pd(wv, b1));
+         }
+         _mm256_storeu_pd(sn, t0);
+         _mm256_storeu_pd(sn+4, t1);
+#elif defined(__SSE2__)
+         __m128d s0 = _mm_loadu_pd(s), s1 = _mm_loadu_pd(s+2),
+                 s2 = _mm_loadu_pd(s+4), s3 = _mm_loadu_pd(s+6);
+         for(i=i0; i<i1; i++) {
+            double *bi = blk + i*HH_NW;
+            __m128d uv = _mm_set1_pd(u[i]);
+            _mm_storeu_pd(bi, _mm_add_pd(_mm_loadu_pd(bi), _mm_mul_pd(s0, uv)));
+            _mm_storeu_pd(bi+2, _mm_add_pd(_mm_loadu_pd(bi+2),
+                                           _mm_mul_pd(s1, uv)));
+            _mm_storeu_pd(bi+4, _mm_add_pd(_mm_loadu_pd(bi+4),
+                                           _mm_mul_pd(s2, uv)));
+            _mm_storeu_pd(bi+6, _mm_add_pd(_mm_loadu_pd(bi+6),
+                                           _mm_mul_pd(s3, uv)));
+         }
+         if(!un) return;
+
+         const double *bj = blk + jn*HH_NW;
+         __m128d dv = _mm_set1_pd(dn);
+         __m128d t0 = _mm_mul_pd(dv, _mm_loadu_pd(bj)),
+                 t1 = _mm_mul_pd(dv, _mm_loadu_pd(bj+2)),
+                 t2 = _mm_mul_pd(dv, _mm_loadu_pd(bj+4)),
+                 t3 = _mm_mul_pd(dv, _mm_loadu_pd(bj+6));
+         for(i=i1; i<m; i++) {
+            double *bi = blk + i*HH_NW;
+            __m128d uv = _mm_set1_pd(u[i]), wv = _mm_set1_pd(un[i]);
+            __m128d b0 = _mm_add_pd(_mm_loadu_pd(bi), _mm_mul_pd(s0, uv)),
+                    b1 = _mm_add_pd(_mm_loadu_pd(bi+2), _mm_mul_pd(s1, uv)),
+                    b2 = _mm_add_pd(_mm_loadu_pd(bi+4), _mm_mul_pd(s2, uv)),
+                    b3 = _mm_add_pd(_mm_loadu_pd(bi+6), _mm_mul_pd(s3, uv));
+            _mm_storeu_pd(bi, b0);
+            _mm_storeu_pd(bi+2, b1);
+            _mm_storeu_pd(bi+4, b2);
+            _mm_storeu_pd(bi+6, b3);
+            t0 = _mm_add_pd(t0, _mm_mul_pd(wv, b0));
+            t1 = _mm_add_pd(t1, _mm_mul_pd(wv, b1));
+            t2 = _mm_add_pd(t2, _mm_mul_pd(wv, b2));
+            t3 = _mm_add_pd(t3, _mm_mul_pd(wv, b3));
+         }
+         _mm_storeu_pd(sn, t0);
+         _mm_storeu_pd(sn+2, t1);
+         _mm_storeu_pd(sn+4, t2);
+         _mm_storeu_pd(sn+6, t3);
+#else
+         std::size_t c;
+         for(i=i0; i<i1; i++) {
+            double *bi = blk + i*HH_NW;
+            for(c=0; c<HH_NW; c++) bi[c] += s[c]*u[i];
+         }
+         if(!un) return;
+
+         const double *bj = blk + jn*HH_NW;
+         for(c=0; c<HH_NW; c++) sn[c] = dn*bj[c];
+         for(i=i1; i<m; i++) {
+            double *bi = blk + i*HH_NW;
+            for(c=0; c<HH_NW; c++) {
+               bi[c] += s[c]*u[i];
+               sn[c] += un[i]*bi[c];
+            }
+         }
+#endif
+      }
+
+         // Apply the reflections of a panel (see reflect()) to the HH_NW
+         // columns of blk (see blockDots()). Reflection j of the panel, if
+         // apply[j] is set, has its pivot in row j, its vector in u + j*np
+         // with rows i0[j] to np-1, and the given delta[j] and beta[j]. The
+         // update of the columns by one reflection and their dot products
+         // with the next one are done on the same pass.
+      void applyPanel(std::size_t nb, std::size_t np, const bool *apply,
+                      const std::size_t *i0, const double *delta,
+                      const double *beta, const double *u, double *blk)
+      {
+         std::size_t i, j, jn, c;
+         double s[HH_NW], sn[HH_NW];
+
+         for(j=0; j<nb && !apply[j]; j++) ;
+         if(j < nb) blockDots(j, i0[j], np, delta[j], u + j*np, blk, s);
+
+         while(j < nb) {
+            for(jn=j+1; jn<nb && !apply[jn]; jn++) ;
+            const double *uj = u + j*np, *un = (jn < nb ? u + jn*np : 0);
+            double *bj = blk + j*HH_NW;
+
+            bool all(true);
+            for(c=0; c<HH_NW; c++)
+               if(s[c] == 0.0) all = false;
+
+            if(all) {
+               for(c=0; c<HH_NW; c++) {
+                  s[c] *= beta[j];
+                  bj[c] += s[c]*delta[j];
+               }
+               blockUpdate(i0[j], (un ? i0[jn] : np), np, s, uj, blk,
+                           jn, (un ? delta[jn] : 0.0), un, sn);
+            }
+            else {
+                  // some column is not changed at all
+               for(c=0; c<HH_NW; c++) {
+                  if(s[c] == 0.0) continue;
+                  double sum(s[c]*beta[j]);
+                  bj[c] += sum*delta[j];
+                  for(i=i0[j]; i<np; i++) blk[i*HH_NW + c] += sum*uj[i];
+               }
+               if(un) blockDots(jn, i0[jn], np, delta[jn], un, blk, sn);
+            }
+
+            for(c=0; c<HH_NW; c++) s[c] = sn[c];
+            j = jn;
+         }
+      }
+
+   }  // anonymous namespace
+
+
+   void gemm(bool transA, bool transB,
+             std::size_t m, std::size_t n, std::size_t k,
+             double alpha, const double *A, std::size_t lda,
+             const double *B, std::size_t ldb,
+             double beta, double *C, std::size_t ldc)
+   {
+      if(m == 0 || n == 0) return;
+
+#ifdef GPSTK_USE_BLAS
+      if(m*n*k >= BLAS_GEMM) {
+         int im(m), in(n), ik(k), ilda(lda), ildb(ldb), ildc(ldc);
+         char ta(transA ? 'T' : 'N'), tb(transB ? 'T' : 'N');
+         if(beta == 0.0) scaleMatrix(m, n, beta, C, ldc);   // no NaN garbage
+         dgemm_(&ta, &tb, &im, &in, &ik, &alpha, A, &ilda, B, &ildb,
+                &beta, C, &ildc);
+         return;
+      }
+#endif
+
+      scaleMatrix(m, n, beta, C, ldc);
+      if(k == 0 || alpha == 0.0) return;
+
+      if(m*n*k < SMALL_GEMM)
+         smallGemm(transA, transB, m, n, k, alpha, A, lda, B, ldb, C, ldc);
+      else
+         blockedGemm(transA, transB, m, n, k, alpha, A, lda, B, ldb, C, ldc);
+   }
+
+
+   void gemv(bool transA, std::size_t m, std::size_t n,
+             double alpha, const double *A, std::size_t lda,
+             const double *x, double beta, double *y)
+   {
+      std::size_t i, j, ny(transA ? n : m);
+      if(ny == 0) return;
+
+#ifdef GPSTK_USE_BLAS
+      if(m*n >= BLAS_GEMV) {
+         int im(m), in(n), ilda(lda), one(1);
+         char ta(transA ? 'T' : 'N');
+         if(beta == 0.0) scaleMatrix(ny, 1, beta, y, ny);
+         dgemv_(&ta, &im, &in, &alpha, A, &ilda, x, &one, &beta, y, &one);
+         return;
+      }
+#endif
+
+      scaleMatrix(ny, 1, beta, y, ny);
+      if(m == 0 || n == 0 || alpha == 0.0) return;
+
+      if(!transA) {
+            // y += A*x, four columns of A at a time
+         for(j=0; j+4<=n; j+=4) {
+            const double *a0 = A + j*lda, *a1 = a0 + lda,
+                         *a2 = a1 + lda, *a3 = a2 + lda;
+            double x0(alpha*x[j]), x1(alpha*x[j+1]),
+                   x2(alpha*x[j+2]), x3(alpha*x[j+3]);
+            for(i=0; i<m; i++)
+               y[i] += a0[i]*x0 + a1[i]*x1 + a2[i]*x2 + a3[i]*x3;
+         }
+         for( ; j<n; j++) {
+            const double *a = A + j*lda;
+            double xj(alpha*x[j]);
+            for(i=0; i<m; i++) y[i] += a[i]*xj;
+         }
+      }
+      else {
+            // y(j) += dot(column j of A, x), with independent partial sums
+         for(j=0; j<n; j++) {
+            const double *a = A + j*lda;
+            double s0(0.0), s1(0.0), s2(0.0), s3(0.0);
+            for(i=0; i+4<=m; i+=4) {
+               s0 += a[i]*x[i];
+               s1 += a[i+1]*x[i+1];
+               s2 += a[i+2]*x[i+2];
+               s3 += a[i+3]*x[i+3];
+            }
+            for( ; i<m; i++) s0 += a[i]*x[i];
+            y[j] += alpha*((s0+s1)+(s2+s3));
+         }
+      }
+   }
+
+
+   void syrk(bool trans, std::size_t n, std::size_t k,
+             double alpha, const double *A, std::size_t lda,
+             double beta, double *C, std::size_t ldc)
+   {
+      std::size_t i, j;
+      if(n == 0) return;
+
+#ifdef GPSTK_USE_BLAS
+      if(n*n*k >= BLAS_GEMM) {
+         int in(n), ik(k), ilda(lda), ildc(ldc);
+         char uplo('L'), ta(trans ? 'T' : 'N');
+         if(beta == 0.0) scaleMatrix(n, n, beta, C, ldc);
+         dsyrk_(&uplo, &ta, &in, &ik, &alpha, A, &ilda, &beta, C, &ildc);
+      }
+      else
+#endif
+      {
+            // beta*C, lower triangle only
+         for(j=0; j<n; j++) {
+            double *c = C + j*ldc;
+            if(beta == 0.0)
+               for(i=j; i<n; i++) c[i] = 0.0;
+            else if(beta != 1.0)
+               for(i=j; i<n; i++) c[i] *= beta;
+         }
+
+            // block columns of the lower triangle, rows jb:n, each one a
+            // product done by gemm(); the upper part of the diagonal blocks
+            // is computed too, but overwritten below
+         if(k > 0 && alpha != 0.0) {
+            for(std::size_t jb=0; jb<n; jb+=SYRK_NB) {
+               std::size_t nb = std::min(SYRK_NB, n-jb);
+               double *c = C + jb + jb*ldc;
+               if(trans)
+                  gemm(true, false, n-jb, nb, k, alpha, A + jb*lda, lda,
+                       A + jb*lda, lda, 1.0, c, ldc);
+               else
+                  gemm(false, true, n-jb, nb, k, alpha, A + jb, lda,
+                       A + jb, lda, 1.0, c, ldc);
+            }
+         }
+      }
+
+         // copy the lower triangle to the upper one
+      for(j=1; j<n; j++)
+         for(i=0; i<j; i++) C[i + j*ldc] = C[j + i*ldc];
+   }
+
+
+   void householder(std::size_t m, std::size_t n, std::size_t p,
+                    std::size_t t, double *A, std::size_t lda, bool skipZero)
+   {
+      const double EPS(-1.e-200);
+      std::size_t i, j, k, c, q;
+      double delta[HH_NB], beta[HH_NB];
+      std::size_t tail[HH_NB];
+      bool apply[HH_NB];
+
+         // packed reflection vectors and block of columns, on the stack
+         // unless the columns are very long
+      double stackBuf[STACK_BUF];
+      std::vector<double> heapBuf;
+      double *ubuf(stackBuf), *blk;
+      if((HH_NB+HH_NW)*m > STACK_BUF) {
+         heapBuf.resize((HH_NB+HH_NW)*m);
+         ubuf = &heapBuf[0];
+      }
+      blk = ubuf + HH_NB*m;
+
+      p = std::min(p, std::min(m, n));
+
+      for(std::size_t j0=0; j0<p; j0+=HH_NB) {
+         std::size_t j1 = std::min(p, j0+HH_NB);
+
+            // factor the panel, columns j0 to j1-1
+         for(j=j0; j<j1; j++) {
+            double *u = A + j*lda;
+            std::size_t i0 = std::max(j+1, t);
+
+            apply[j-j0] = false;
+            double sum(0.0);
+            for(i=i0; i<m; i++) sum += u[i]*u[i];
+            if(skipZero && sum <= 0.0) continue;
+
+            double diag(u[j]);
+            sum += diag*diag;
+            sum = (diag > 0.0 ? -1.0 : 1.0) * std::sqrt(sum);
+            double d(diag - sum);
+            u[j] = sum;
+
+            double b(sum*d);
+            if(b > EPS) continue;
+            b = 1.0/b;
+
+            apply[j-j0] = true;
+            delta[j-j0] = d;
+            beta[j-j0] = b;
+            for(k=j+1; k<j1; k++)
+               reflect(j, i0, m, d, b, u, A + k*lda);
+         }
+         if(j1 >= n) continue;
+
+            // The panel changes rows j0 to j1-1 and r2 to m-1 only; these
+            // are packed, in this order, for the reflection vectors and for
+            // each block of HH_NW columns on the right of the panel.
+         const std::size_t nb(j1-j0), r2(std::max(j1, t)), np(nb + m-r2);
+         if(n-j1 >= HH_NW) {
+            for(j=j0; j<j1; j++) {
+               i = std::max(j+1, t);
+               tail[j-j0] = (i < j1 ? i-j0 : nb);
+            }
+            for(j=j0; j<j1; j++) {
+               const double *u = A + j*lda;
+               double *ub = ubuf + (j-j0)*np;
+               for(q=0; q<nb; q++) ub[q] = u[j0+q];
+               for(i=r2; i<m; i++) ub[nb+i-r2] = u[i];
+            }
+         }
+
+         for(k=j1; k+HH_NW<=n; k+=HH_NW) {
+            for(c=0; c<HH_NW; c++) {
+               const double *a = A + (k+c)*lda;
+               double *b = blk + c;
+               for(q=0; q<nb; q++) b[q*HH_NW] = a[j0+q];
+               for(i=r2; i<m; i++) b[(nb+i-r2)*HH_NW] = a[i];
+            }
+
+            applyPanel(nb, np, apply, tail, delta, beta, ubuf, blk);
+
+            for(c=0; c<HH_NW; c++) {
+               double *a = A + (k+c)*lda;
+               const double *b = blk + c;
+               for(q=0; q<nb; q++) a[j0+q] = b[q*HH_NW];
+               for(i=r2; i<m; i++) a[i] = b[(nb+i-r2)*HH_NW];
+            }
+         }
+
+            // the last few columns
+         for( ; k<n; k++)
+            for(j=j0; j<j1; j++)
+               if(apply[j-j0])
+                  reflect(j, std::max(j+1, t), m, delta[j-j0], beta[j-j0],
+                          A + j*lda, A + k*lda);
+      }
+   }
+
+}  // namespace
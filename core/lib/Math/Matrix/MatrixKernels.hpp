@@ -0,0 +1,109 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file MatrixKernels.hpp
+/// Blocked, vectorized kernels for products of double precision matrices
+/// (GEMM, GEMV and SYRK in BLAS terms), working on column major storage as
+/// used by Matrix<double>. When GPSTk is configured with USE_BLAS and a BLAS
+/// library is found, large products are handed to that library instead.
+
+#ifndef GPSTK_MATRIX_KERNELS_HPP
+#define GPSTK_MATRIX_KERNELS_HPP
+
+#include <cstddef>
+
+namespace gpstk
+{
+
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * Matrix-matrix product, C = alpha*op(A)*op(B) + beta*C, where op(X)
+       * is X or transpose(X) according to transA and transB. op(A) is
+       * [m,k], op(B) is [k,n] and C is [m,n]; all are column major with the
+       * given leading dimensions (number of rows as stored). When beta is
+       * zero, C need not be initialized.
+       */
+   void gemm(bool transA, bool transB,
+             std::size_t m, std::size_t n, std::size_t k,
+             double alpha, const double *A, std::size_t lda,
+             const double *B, std::size_t ldb,
+             double beta, double *C, std::size_t ldc);
+
+      /**
+       * Matrix-vector product, y = alpha*op(A)*x + beta*y, where A is [m,n]
+       * column major with leading dimension lda, and op(A) is A or
+       * transpose(A) according to transA. When beta is zero, y need not be
+       * initialized.
+       */
+   void gemv(bool transA, std::size_t m, std::size_t n,
+             double alpha, const double *A, std::size_t lda,
+             const double *x, double beta, double *y);
+
+      /**
+       * Symmetric rank-k update, C = alpha*op(A)*transpose(op(A)) + beta*C,
+       * where op(A) is [n,k]: with trans false, A is [n,k] and the product
+       * is A*AT; with trans true, A is [k,n] and the product is AT*A (a
+       * normal matrix). Only the lower triangle is computed, and it is then
+       * copied to the upper one, so C is returned full and symmetric.
+       */
+   void syrk(bool trans, std::size_t n, std::size_t k,
+             double alpha, const double *A, std::size_t lda,
+             double beta, double *C, std::size_t ldc);
+
+      /**
+       * Householder triangularization in place, as used by the square root
+       * information filter. A is [m,n], column major with leading dimension
+       * lda, and its first p columns are reduced in turn: reflection j
+       * zeroes column j below row j, from row max(j+1,t) down, into A(j,j),
+       * and is applied to all the columns to its right. The first t rows
+       * are taken to be upper triangular: reflection j<t acts on row j and
+       * on rows t to m-1 only. When skipZero is true a column that is
+       * already zero below the diagonal is left alone; otherwise row j
+       * simply changes sign.
+       * Every element goes through the same operations, in the same order,
+       * as in Bierman's element-wise algorithm; the reflections are grouped
+       * in panels which are then applied to several columns at a time.
+       */
+   void householder(std::size_t m, std::size_t n, std::size_t p,
+                    std::size_t t, double *A, std::size_t lda, bool skipZero);
+
+      //@}
+
+}  // namespace
+
+#endif
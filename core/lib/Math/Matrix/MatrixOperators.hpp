@@ -43,8 +43,10 @@
 #define GPSTK_MATRIX_OPERATORS_HPP
 
 #include <limits>
+#include <utility>
 #include "MiscMath.hpp"
 #include "MatrixFunctors.hpp"
+#include "MatrixKernels.hpp"
 
 namespace gpstk
 {
@@ -870,6 +872,238 @@ namespace gpstk
       return toReturn;
    }
 
+      /**
+       * Matrix * Matrix for plain Matrix objects. The products of the
+       * plain Matrix and Vector classes are templates (specialized for
+       * doubles below) rather than overloads for doubles only, so that
+       * no argument is ever converted to a Matrix or a Vector (e.g. a
+       * MatrixSlice through the Matrix constructor, or a scalar through
+       * Vector(size_t)) just to reach them, which made the overload
+       * resolution ambiguous.
+       */
+   template <class T>
+   inline Matrix<T> operator* (const Matrix<T>& l, const Matrix<T>& r)
+      throw (MatrixException)
+   {
+      const ConstMatrixBase<T, Matrix<T> >& lb = l;
+      const ConstMatrixBase<T, Matrix<T> >& rb = r;
+      return lb * rb;
+   }
+
+      /**
+       * Matrix * Matrix for double precision Matrix objects, using the
+       * cache blocked kernel gemm() (or BLAS, if so configured).
+       */
+   template <>
+   inline Matrix<double> operator* (const Matrix<double>& l,
+                                    const Matrix<double>& r)
+      throw (MatrixException)
+   {
+      if (l.cols() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      Matrix<double> toReturn(l.rows(), r.cols());
+      if (toReturn.size() > 0)
+         gemm(false, false, l.rows(), r.cols(), l.cols(),
+              1.0, l.begin(), l.rows(), r.begin(), r.rows(),
+              0.0, toReturn.begin(), toReturn.rows());
+      return toReturn;
+   }
+
+      /**
+       * Matrix times vector multiplication of plain Matrix and Vector
+       * objects; see the Matrix * Matrix case above.
+       */
+   template <class T>
+   inline Vector<T> operator* (const Matrix<T>& m, const Vector<T>& v)
+      throw (MatrixException)
+   {
+      const ConstMatrixBase<T, Matrix<T> >& mb = m;
+      const ConstVectorBase<T, Vector<T> >& vb = v;
+      return mb * vb;
+   }
+
+      /**
+       * Matrix times vector multiplication for double precision objects,
+       * using the kernel gemv().
+       */
+   template <>
+   inline Vector<double> operator* (const Matrix<double>& m,
+                                    const Vector<double>& v)
+      throw (MatrixException)
+   {
+      if (v.size() != m.cols())
+      {
+         gpstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      Vector<double> toReturn(m.rows());
+      if (toReturn.size() > 0)
+         gemv(false, m.rows(), m.cols(), 1.0, m.begin(), m.rows(),
+              v.begin(), 0.0, toReturn.begin());
+      return toReturn;
+   }
+
+      /**
+       * Vector times matrix multiplication of plain Vector and Matrix
+       * objects; see the Matrix * Matrix case above.
+       */
+   template <class T>
+   inline Vector<T> operator* (const Vector<T>& v, const Matrix<T>& m)
+      throw (MatrixException)
+   {
+      const ConstVectorBase<T, Vector<T> >& vb = v;
+      const ConstMatrixBase<T, Matrix<T> >& mb = m;
+      return vb * mb;
+   }
+
+      /**
+       * Vector times matrix multiplication for double precision objects,
+       * using the kernel gemv().
+       */
+   template <>
+   inline Vector<double> operator* (const Vector<double>& v,
+                                    const Matrix<double>& m)
+      throw (gpstk::MatrixException)
+   {
+      if (v.size() != m.rows())
+      {
+         gpstk::MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GPSTK_THROW(e);
+      }
+
+      Vector<double> toReturn(m.cols());
+      if (toReturn.size() > 0)
+         gemv(true, m.rows(), m.cols(), 1.0, m.begin(), m.rows(),
+              v.begin(), 0.0, toReturn.begin());
+      return toReturn;
+   }
+
+      /**
+       * Matrix multiply-accumulate in place: C = alpha*op(A)*op(B) + beta*C,
+       * where op(X) is X, or transpose(X) if the corresponding flag is set.
+       * No temporaries are created. If beta is zero, C is resized as
+       * needed (reusing its storage when it is large enough) and its
+       * previous contents are ignored. C may not be A or B.
+       * @return a reference to C
+       */
+   inline Matrix<double>& gemm(Matrix<double>& C,
+                               const Matrix<double>& A,
+                               const Matrix<double>& B,
+                               double alpha = 1.0, double beta = 0.0,
+                               bool transA = false, bool transB = false)
+      throw (MatrixException)
+   {
+      size_t m(transA ? A.cols() : A.rows()), k(transA ? A.rows() : A.cols()),
+             n(transB ? B.rows() : B.cols());
+      if ((transB ? B.cols() : B.rows()) != k)
+      {
+         MatrixException e("Incompatible dimensions for Matrix * Matrix");
+         GPSTK_THROW(e);
+      }
+      if (&C == &A || &C == &B)
+      {
+         MatrixException e("Output of gemm() aliases one of its inputs");
+         GPSTK_THROW(e);
+      }
+      if (C.rows() != m || C.cols() != n)
+      {
+         if (beta != 0.0)
+         {
+            MatrixException e("Incompatible dimensions for Matrix accumulate");
+            GPSTK_THROW(e);
+         }
+         C.resize(m, n);
+      }
+
+      if (C.size() > 0)
+         gemm(transA, transB, m, n, k, alpha, A.begin(), A.rows(),
+              B.begin(), B.rows(), beta, C.begin(), C.rows());
+      return C;
+   }
+
+      /**
+       * Matrix times vector multiply-accumulate in place:
+       * y = alpha*op(A)*x + beta*y, where op(A) is A, or transpose(A) if
+       * trans is set. If beta is zero, y is resized as needed and its
+       * previous contents are ignored. y may not be x.
+       * @return a reference to y
+       */
+   inline Vector<double>& gemv(Vector<double>& y,
+                               const Matrix<double>& A,
+                               const Vector<double>& x,
+                               double alpha = 1.0, double beta = 0.0,
+                               bool trans = false)
+      throw (MatrixException)
+   {
+      size_t m(trans ? A.cols() : A.rows());
+      if ((trans ? A.rows() : A.cols()) != x.size())
+      {
+         MatrixException e("Incompatible dimensions for Vector * Matrix");
+         GPSTK_THROW(e);
+      }
+      if (&y == &x)
+      {
+         MatrixException e("Output of gemv() aliases its input");
+         GPSTK_THROW(e);
+      }
+      if (y.size() != m)
+      {
+         if (beta != 0.0)
+         {
+            MatrixException e("Incompatible dimensions for Vector accumulate");
+            GPSTK_THROW(e);
+         }
+         y.resize(m);
+      }
+
+      if (m > 0)
+         gemv(trans, A.rows(), A.cols(), alpha, A.begin(), A.rows(),
+              x.begin(), beta, y.begin());
+      return y;
+   }
+
+      /**
+       * Symmetric rank-k update in place: C = alpha*op(A)*transpose(op(A))
+       * + beta*C, where op(A) is A, or transpose(A) if trans is set; so
+       * syrk(N, A, 1.0, 0.0, true) forms the normal matrix transpose(A)*A.
+       * Only half the products are computed. If beta is zero, C is
+       * resized as needed and its previous contents are ignored; otherwise
+       * C must be symmetric. C may not be A.
+       * @return a reference to C
+       */
+   inline Matrix<double>& syrk(Matrix<double>& C,
+                               const Matrix<double>& A,
+                               double alpha = 1.0, double beta = 0.0,
+                               bool trans = false)
+      throw (MatrixException)
+   {
+      size_t n(trans ? A.cols() : A.rows()), k(trans ? A.rows() : A.cols());
+      if (&C == &A)
+      {
+         MatrixException e("Output of syrk() aliases its input");
+         GPSTK_THROW(e);
+      }
+      if (C.rows() != n || C.cols() != n)
+      {
+         if (beta != 0.0)
+         {
+            MatrixException e("Incompatible dimensions for Matrix accumulate");
+            GPSTK_THROW(e);
+         }
+         C.resize(n, n);
+      }
+
+      if (n > 0)
+         syrk(trans, n, k, alpha, A.begin(), A.rows(), beta,
+              C.begin(), C.rows());
+      return C;
+   }
+
       /**
        * Compute sum of two matricies.
        */
@@ -961,7 +1195,8 @@ namespace gpstk
    inline Matrix<T> operator* (const ConstMatrixBase<T, BaseClass>& m, const T d)
    {
       Matrix<T> temp(m);
-      return temp *= d;
+      temp *= d;
+      return temp;
    }
 
       /// Multiplies all the elements of m by d.
@@ -969,7 +1204,8 @@ namespace gpstk
    inline Matrix<T> operator* (const T d, const ConstMatrixBase<T, BaseClass>& m)
    {
       Matrix<T> temp(m);
-      return temp *= d;
+      temp *= d;
+      return temp;
    }
 
       /// Divides all the elements of m by d.
@@ -977,7 +1213,8 @@ namespace gpstk
    inline Matrix<T> operator/ (const ConstMatrixBase<T, BaseClass>& m, const T d)
    {
       Matrix<T> temp(m);
-      return temp /= d;
+      temp /= d;
+      return temp;
    }
 
       /// Divides all the elements of m by d.
@@ -985,7 +1222,8 @@ namespace gpstk
    inline Matrix<T> operator/ (const T d, const ConstMatrixBase<T, BaseClass>& m)
    {
       Matrix<T> temp(m);
-      return temp /= d;
+      temp /= d;
+      return temp;
    }
 
       /// Adds all the elements of m by d.
@@ -993,7 +1231,8 @@ namespace gpstk
    inline Matrix<T> operator+ (const ConstMatrixBase<T, BaseClass>& m, const T d)
    {
       Matrix<T> temp(m);
-      return temp += d;
+      temp += d;
+      return temp;
    }
 
       /// Adds all the elements of m by d.
@@ -1001,7 +1240,8 @@ namespace gpstk
    inline Matrix<T> operator+ (const T d, const ConstMatrixBase<T, BaseClass>& m)
    {
       Matrix<T> temp(m);
-      return temp += d;
+      temp += d;
+      return temp;
    }
 
       /// Subtracts all the elements of m by d.
@@ -1009,7 +1249,8 @@ namespace gpstk
    inline Matrix<T> operator- (const ConstMatrixBase<T, BaseClass>& m, const T d)
    {
       Matrix<T> temp(m);
-      return temp -= d;
+      temp -= d;
+      return temp;
    }
 
       /// Subtracts all the elements of m by d.
@@ -1017,9 +1258,111 @@ namespace gpstk
    inline Matrix<T> operator- (const T d, const ConstMatrixBase<T, BaseClass>& m)
    {
       Matrix<T> temp(m);
-      return temp -= d;
+      temp -= d;
+      return temp;
+   }
+
+#if __cplusplus >= 201103L
+      // When the matrix operand is a temporary, as in A*B + C or 2.0*(A-B),
+      // its storage is reused for the result instead of allocating a new
+      // Matrix.
+
+      /// Compute sum of two matricies in the storage of the temporary l.
+   template <class T, class BaseClass>
+   inline Matrix<T> operator+ (Matrix<T>&& l,
+                               const ConstMatrixBase<T, BaseClass>& r)
+   {
+      if (l.cols() != r.cols() || l.rows() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix + Matrix");
+         GPSTK_THROW(e);
+      }
+      l += r;
+      return std::move(l);
+   }
+
+      /// Compute sum of two matricies in the storage of the temporary r.
+   template <class T, class BaseClass>
+   inline Matrix<T> operator+ (const ConstMatrixBase<T, BaseClass>& l,
+                               Matrix<T>&& r)
+   {
+      if (l.cols() != r.cols() || l.rows() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix + Matrix");
+         GPSTK_THROW(e);
+      }
+      r += l;
+      return std::move(r);
+   }
+
+      /// Compute sum of two temporary matricies, in the storage of l.
+   template <class T>
+   inline Matrix<T> operator+ (Matrix<T>&& l, Matrix<T>&& r)
+   { return std::move(l) + static_cast<const Matrix<T>&>(r); }
+
+      /// Compute difference of two matricies in the storage of the
+      /// temporary l.
+   template <class T, class BaseClass>
+   inline Matrix<T> operator- (Matrix<T>&& l,
+                               const ConstMatrixBase<T, BaseClass>& r)
+   {
+      if (l.cols() != r.cols() || l.rows() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix - Matrix");
+         GPSTK_THROW(e);
+      }
+      l -= r;
+      return std::move(l);
    }
 
+      /// Compute difference of two matricies in the storage of the
+      /// temporary r.
+   template <class T, class BaseClass>
+   inline Matrix<T> operator- (const ConstMatrixBase<T, BaseClass>& l,
+                               Matrix<T>&& r)
+   {
+      if (l.cols() != r.cols() || l.rows() != r.rows())
+      {
+         MatrixException e("Incompatible dimensions for Matrix - Matrix");
+         GPSTK_THROW(e);
+      }
+      size_t i, j;
+      for (i = 0; i < r.rows(); i++)
+         for (j = 0; j < r.cols(); j++)
+            r(i,j) = l(i,j) - r(i,j);
+      return std::move(r);
+   }
+
+      /// Compute difference of two temporary matricies, in the storage of l.
+   template <class T>
+   inline Matrix<T> operator- (Matrix<T>&& l, Matrix<T>&& r)
+   { return std::move(l) - static_cast<const Matrix<T>&>(r); }
+
+      /// Multiplies all the elements of the temporary m by d.
+   template <class T>
+   inline Matrix<T> operator* (Matrix<T>&& m, const T d)
+   {
+      m *= d;
+      return std::move(m);
+   }
+
+      /// Multiplies all the elements of the temporary m by d.
+   template <class T>
+   inline Matrix<T> operator* (const T d, Matrix<T>&& m)
+   {
+      m *= d;
+      return std::move(m);
+   }
+
+      /// Divides all the elements of the temporary m by d.
+   template <class T>
+   inline Matrix<T> operator/ (Matrix<T>&& m, const T d)
+   {
+      m /= d;
+      return std::move(m);
+   }
+#endif
+
       //@}
  
 }  // namespace
@@ -94,46 +94,32 @@ void RACRotation::compute( const gpstk::Triple& SVPositionVector,
    (*this) (2,2) = unitC[2];
 }
 
-gpstk::Vector<double> RACRotation::convertToRAC( const gpstk::Vector<double>& inV )
+gpstk::Mat3<double> RACRotation::asMat3() const
 {
-   gpstk::Vector<double> outV(3);
+   const RACRotation& m = *this;
+   return gpstk::Mat3<double>( m(0,0), m(0,1), m(0,2),
+                               m(1,0), m(1,1), m(1,2),
+                               m(2,0), m(2,1), m(2,2) );
+}
 
-   /*
-      My goal was to use the following statement.
-   outV =  this * inV;
-      However, for some reason, gcc refuses to recognize RACRotation as a
-      Matrix subclass.  Therefore, I've incorporated the matrix multiply
-      as a temporary kludge.
-   */
+gpstk::Vector<double> RACRotation::convertToRAC( const gpstk::Vector<double>& inV )
+{
    if (inV.size()!=3)
    {
       gpstk::Exception e("Incompatible dimensions for Vector");
       GPSTK_THROW(e);
    }
-   size_t i, j;
-   for (i = 0; i < 3; i++)
-   {
-      outV[i] = 0;
-      for (j = 0; j < 3; j++)
-      {
-         double temp =  (*this)(i,j) * inV[j];
-         outV[i] += temp;
-      }
-   }
-   /* end kludge */
+   gpstk::Vec3<double> out = asMat3() * gpstk::Vec3<double>(inV[0], inV[1], inV[2]);
+   gpstk::Vector<double> outV(3);
+   outV[0] = out[0];
+   outV[1] = out[1];
+   outV[2] = out[2];
    return(outV);
 }
 
 gpstk::Triple RACRotation::convertToRAC( const gpstk::Triple& inVec )
 {
-   gpstk::Vector<double> v(3);
-   v[0] = inVec[0];
-   v[1] = inVec[1];
-   v[2] = inVec[2];
-
-   gpstk::Vector<double> vOut = convertToRAC( v );
-   gpstk::Triple outVec( vOut[0], vOut[1], vOut[2] );
-   return(outVec);
+   return gpstk::Triple( asMat3() * inVec.theArray );
 }
 
 gpstk::Xvt RACRotation::convertToRAC( const gpstk::Xvt& in )
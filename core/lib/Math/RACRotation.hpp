@@ -44,6 +44,7 @@
 #include "Matrix.hpp"
 #include "Vector.hpp"
 #include "Xvt.hpp"
+#include "Mat3.hpp"
 
 namespace gpstk
 {
@@ -67,6 +68,9 @@ namespace gpstk
       protected:
          void compute( const gpstk::Triple& SVPositionVector,
                        const gpstk::Triple& SVVelocityVector);
+
+            /// Returns *this as a Mat3, for the products in convertToRAC()
+         gpstk::Mat3<double> asMat3() const;
    };
 
       //@}
@@ -41,6 +41,7 @@
 
 #include "GNSSconstants.hpp"
 #include "Triple.hpp"
+#include "Mat3.hpp"
 #include <cmath>
 
 namespace gpstk
@@ -48,7 +49,6 @@ namespace gpstk
    using namespace std;
 
    Triple :: Triple()
-         : theArray(0., 3)
    {
    }
 
@@ -60,11 +60,8 @@ namespace gpstk
    Triple :: Triple(double a, 
                     double b,
                     double c)
-      : theArray(3)
+      : theArray(a, b, c)
    {
-      theArray[0] = a;
-      theArray[1] = b;
-      theArray[2] = c;
    }
 
    Triple& Triple :: operator=(const Triple& right)
@@ -81,7 +78,7 @@ namespace gpstk
          GPSTK_THROW(GeometryException("Incorrect vector size"));
       }
 
-      theArray = right;
+      theArray = Vec3<double>(right[0], right[1], right[2]);
       return *this;
    }
 
@@ -106,10 +103,7 @@ namespace gpstk
    double Triple :: dot(const Triple& right) const
       throw()
    {
-      Triple z;
-      z = (this->theArray)*(right.theArray);
-      double a = z.theArray.sum();
-      return a;
+      return theArray.dot(right.theArray);
    }
 
 
@@ -117,11 +111,7 @@ namespace gpstk
    Triple Triple :: cross(const Triple& right) const
       throw()
    {
-      Triple cp;
-      cp[0] = (*this)[1] * right[2] - (*this)[2] * right[1];
-      cp[1] = (*this)[2] * right[0] - (*this)[0] * right[2];
-      cp[2] = (*this)[0] * right[1] - (*this)[1] * right[0];
-      return cp;
+      return Triple(theArray.cross(right.theArray));
    }
 
 
@@ -138,11 +128,7 @@ namespace gpstk
       if (mag <= 1e-14)
       	GPSTK_THROW(GeometryException("Divide by Zero Error"));
       
-      Triple retArg;
-      retArg[0] = (*this)[0] / mag;
-      retArg[1] = (*this)[1] / mag;
-      retArg[2] = (*this)[2] / mag;
-      return(retArg);
+      return Triple(theArray / mag);
    }
 
       // function that returns the cosine of angle between this and right
@@ -174,10 +160,7 @@ namespace gpstk
    double Triple :: slantRange(const Triple& right) const
       throw()
    {
-      Triple z;
-      z = right.theArray - this->theArray;
-      double r = z.mag();
-      return r;
+      return (right.theArray - theArray).norm();
    }
 
 
@@ -186,8 +169,7 @@ namespace gpstk
    double Triple :: elvAngle(const Triple& right) const
       throw(GeometryException)
    {
-      Triple z;
-      z = right.theArray - this->theArray;
+      Triple z(right.theArray - theArray);
       double c = z.cosVector(*this);
       return 90.0 - ::acos(c) * RAD_TO_DEG;
    }
@@ -252,14 +234,7 @@ namespace gpstk
    Triple Triple::R1(const double& angle) const
       throw()
    {
-      double ang(angle*DEG_TO_RAD);
-      double sinangle(std::sin(ang));
-      double cosangle(std::cos(ang));
-      Triple rot;
-      rot[0] = (*this)[0];
-      rot[1] = cosangle*(*this)[1] + sinangle*(*this)[2];
-      rot[2] = -sinangle*(*this)[1] + cosangle*(*this)[2];
-      return rot;
+      return Triple(Mat3<double>::R1(angle*DEG_TO_RAD) * theArray);
    }
 
 
@@ -270,14 +245,7 @@ namespace gpstk
    Triple Triple::R2(const double& angle) const
       throw()
    {
-      double ang(angle*DEG_TO_RAD);
-      double sinangle(std::sin(ang));
-      double cosangle(std::cos(ang));
-      Triple rot;
-      rot[0] = cosangle*(*this)[0] - sinangle*(*this)[2];
-      rot[1] = (*this)[1];
-      rot[2] = sinangle*(*this)[0] + cosangle*(*this)[2];
-      return rot;
+      return Triple(Mat3<double>::R2(angle*DEG_TO_RAD) * theArray);
    }
 
 
@@ -288,41 +256,28 @@ namespace gpstk
    Triple Triple::R3(const double& angle) const
       throw()
    {
-      double ang(angle*DEG_TO_RAD);
-      double sinangle(std::sin(ang));
-      double cosangle(std::cos(ang));
-      Triple rot;
-      rot[0] = cosangle*(*this)[0] + sinangle*(*this)[1];
-      rot[1] = -sinangle*(*this)[0] + cosangle*(*this)[1];
-      rot[2] = (*this)[2];
-      return rot;
+      return Triple(Mat3<double>::R3(angle*DEG_TO_RAD) * theArray);
    }
 
 
    bool Triple :: operator== (const Triple& right) const
    {
-     return (*this)[0]==right[0] && (*this)[1]==right[1] && (*this)[2]==right[2];
+     return theArray == right.theArray;
    }
      
    Triple Triple :: operator-(const Triple& right) const
    { 
-      Triple tmp;
-      tmp.theArray = this->theArray - right.theArray;
-      return tmp;
+      return Triple(theArray - right.theArray);
    }
 
    Triple Triple :: operator+(const Triple& right) const
    { 
-      Triple tmp; 
-      tmp.theArray = this->theArray + right.theArray; 
-      return tmp;
+      return Triple(theArray + right.theArray);
    }
 
    Triple operator*(double scale, const Triple& rhs)
    {
-      Triple tmp; 
-      tmp.theArray = rhs.theArray * scale; 
-      return tmp;
+      return Triple(rhs.theArray * scale);
    }
 
    std::ostream& operator<<(std::ostream& s, 
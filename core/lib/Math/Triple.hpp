@@ -46,6 +46,7 @@
 #include <vector>
 #include "Exception.hpp"
 #include "Vector.hpp"
+#include "Vec3.hpp"
 
 namespace gpstk
 {
@@ -61,7 +62,9 @@ namespace gpstk
       /**
        * Three-dimensional vectors.  This class provides mathematical
        * functions for 3D vectors, including some functions specific
-       * to orbital tracking.
+       * to orbital tracking.  The elements are kept in a Vec3, inside
+       * the object, so creating or copying a Triple (and so a Position
+       * or an Xvt) does not allocate memory.
        */
    class Triple
    {
@@ -77,6 +80,11 @@ namespace gpstk
              double b, 
              double c);
 
+         /// Construct from a Vec3.
+      explicit Triple(const Vec3<double>& right)
+            : theArray(right)
+      {}
+
          /// Destructor
       virtual ~Triple() {}
 
@@ -89,6 +97,10 @@ namespace gpstk
       Triple& operator=(const std::valarray<double>& right)
          throw(GeometryException);
 
+         /// Assign from a Vec3.
+      Triple& operator=(const Vec3<double>& right)
+      { theArray = right; return *this; }
+
          
          /// Return the data as a Vector<double> object
       Vector<double> toVector();
@@ -230,7 +242,7 @@ namespace gpstk
 
          /// Return the size of this object.
       size_t size(void) const
-      { return theArray.size(); }
+      { return 3; }
 
          /**
           * Output operator for dvec
@@ -240,7 +252,7 @@ namespace gpstk
       friend std::ostream& operator<<(std::ostream& s, 
                                       const gpstk::Triple& v);
       
-      std::valarray<double> theArray;
+      Vec3<double> theArray;
 
    }; // class Triple
 
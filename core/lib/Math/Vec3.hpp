@@ -0,0 +1,191 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file Vec3.hpp
+ * Fixed size 3-vector, for geometry in the inner loops
+ */
+
+#ifndef GPSTK_VEC3_HPP
+#define GPSTK_VEC3_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+
+   /// Marks the functions that can be evaluated at compile time when
+   /// the compiler supports it (C++11 and later).
+#ifndef GPSTK_CONSTEXPR
+#if __cplusplus >= 201103L
+#define GPSTK_CONSTEXPR constexpr
+#else
+#define GPSTK_CONSTEXPR
+#endif
+#endif
+
+namespace gpstk
+{
+      /// @ingroup MathGroup
+      //@{
+
+      /**
+       * A three element vector whose size is fixed at compile time.
+       * The elements are kept inside the object, so a Vec3 never
+       * allocates memory, copies with a plain memberwise copy, and
+       * the loops over its elements are fully unrolled by the
+       * compiler.  It is intended for positions, velocities and other
+       * 3D quantities in the geometry code (see Triple, Mat3), where
+       * the general gpstk::Vector is unnecessarily heavy.
+       *
+       * With C++11 the constructors, accessors and arithmetic are
+       * constexpr, so constant vectors can be built at compile time.
+       */
+   template <class T>
+   class Vec3
+   {
+   public:
+#if __cplusplus >= 201103L
+         /// Default constructor, all elements zero.
+      constexpr Vec3() : v{T(0), T(0), T(0)} {}
+         /// Construct from three elements.
+      constexpr Vec3(T a, T b, T c) : v{a, b, c} {}
+#else
+         /// Default constructor, all elements zero.
+      Vec3() { v[0] = v[1] = v[2] = T(0); }
+         /// Construct from three elements.
+      Vec3(T a, T b, T c) { v[0] = a; v[1] = b; v[2] = c; }
+#endif
+
+         /// Number of elements, always 3.
+      static GPSTK_CONSTEXPR size_t size() { return 3; }
+
+         /// Returns the element at index i (not range checked).
+      GPSTK_CONSTEXPR T operator[](size_t i) const { return v[i]; }
+         /// Returns a modifiable element at index i (not range checked).
+      T& operator[](size_t i) { return v[i]; }
+         /// Returns the element at index i (not range checked).
+      GPSTK_CONSTEXPR T operator()(size_t i) const { return v[i]; }
+         /// Returns a modifiable element at index i (not range checked).
+      T& operator()(size_t i) { return v[i]; }
+
+         /// Pointer to the three contiguous elements.
+      T* data() { return v; }
+         /// Pointer to the three contiguous elements.
+      const T* data() const { return v; }
+
+      GPSTK_CONSTEXPR Vec3 operator-() const
+      { return Vec3(-v[0], -v[1], -v[2]); }
+      GPSTK_CONSTEXPR Vec3 operator+(const Vec3& r) const
+      { return Vec3(v[0]+r.v[0], v[1]+r.v[1], v[2]+r.v[2]); }
+      GPSTK_CONSTEXPR Vec3 operator-(const Vec3& r) const
+      { return Vec3(v[0]-r.v[0], v[1]-r.v[1], v[2]-r.v[2]); }
+      GPSTK_CONSTEXPR Vec3 operator*(T s) const
+      { return Vec3(v[0]*s, v[1]*s, v[2]*s); }
+      GPSTK_CONSTEXPR Vec3 operator/(T s) const
+      { return Vec3(v[0]/s, v[1]/s, v[2]/s); }
+
+      Vec3& operator+=(const Vec3& r)
+      { v[0] += r.v[0]; v[1] += r.v[1]; v[2] += r.v[2]; return *this; }
+      Vec3& operator-=(const Vec3& r)
+      { v[0] -= r.v[0]; v[1] -= r.v[1]; v[2] -= r.v[2]; return *this; }
+      Vec3& operator*=(T s)
+      { v[0] *= s; v[1] *= s; v[2] *= s; return *this; }
+      Vec3& operator/=(T s)
+      { v[0] /= s; v[1] /= s; v[2] /= s; return *this; }
+
+         /// Element by element equality.
+      GPSTK_CONSTEXPR bool operator==(const Vec3& r) const
+      { return v[0]==r.v[0] && v[1]==r.v[1] && v[2]==r.v[2]; }
+      GPSTK_CONSTEXPR bool operator!=(const Vec3& r) const
+      { return !(*this == r); }
+
+         /// Dot product with r.
+      GPSTK_CONSTEXPR T dot(const Vec3& r) const
+      { return v[0]*r.v[0] + v[1]*r.v[1] + v[2]*r.v[2]; }
+
+         /// Cross product, (*this) x r.
+      GPSTK_CONSTEXPR Vec3 cross(const Vec3& r) const
+      {
+         return Vec3(v[1]*r.v[2] - v[2]*r.v[1],
+                     v[2]*r.v[0] - v[0]*r.v[2],
+                     v[0]*r.v[1] - v[1]*r.v[0]);
+      }
+
+         /// Square of the Euclidean norm.
+      GPSTK_CONSTEXPR T normSq() const
+      { return dot(*this); }
+
+         /// Euclidean norm.
+      T norm() const
+      { return std::sqrt(normSq()); }
+
+   private:
+      T v[3];
+   };
+
+      /// scalar * vector
+   template <class T>
+   inline GPSTK_CONSTEXPR Vec3<T> operator*(T s, const Vec3<T>& r)
+   { return r * s; }
+
+      /// Dot product of l and r.
+   template <class T>
+   inline GPSTK_CONSTEXPR T dot(const Vec3<T>& l, const Vec3<T>& r)
+   { return l.dot(r); }
+
+      /// Cross product l x r.
+   template <class T>
+   inline GPSTK_CONSTEXPR Vec3<T> cross(const Vec3<T>& l, const Vec3<T>& r)
+   { return l.cross(r); }
+
+      /// Euclidean norm of v.
+   template <class T>
+   inline T norm(const Vec3<T>& v)
+   { return v.norm(); }
+
+      /// Writes v as (x, y, z).
+   template <class T>
+   std::ostream& operator<<(std::ostream& s, const Vec3<T>& v)
+   {
+      s << "(" << v[0] << ", " << v[1] << ", " << v[2] << ")";
+      return s;
+   }
+
+      //@}
+
+}  // namespace gpstk
+
+#endif
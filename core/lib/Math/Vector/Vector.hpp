@@ -54,10 +54,70 @@ namespace gpstk
       // forward declaration
    template <class T> class VectorSlice;
 
+      /**
+       * The number of elements of a Vector<T> (VECTOR_SIZE) and of a
+       * Matrix<T> (MATRIX_SIZE) kept inside the object rather than on
+       * the heap.  Only the built-in arithmetic types, which need no
+       * constructor, are kept inside; other types are always allocated.
+       */
+   template <class T>
+   struct InlineStorageSize
+   { enum { VECTOR_SIZE = 0, MATRIX_SIZE = 0 }; };
+
+#define GPSTK_INLINE_STORAGE_SIZE(type)                                 \
+   template <>                                                          \
+   struct InlineStorageSize<type>                                       \
+   { enum { VECTOR_SIZE = 6, MATRIX_SIZE = 9 }; };
+
+   GPSTK_INLINE_STORAGE_SIZE(bool)
+   GPSTK_INLINE_STORAGE_SIZE(char)
+   GPSTK_INLINE_STORAGE_SIZE(short)
+   GPSTK_INLINE_STORAGE_SIZE(unsigned short)
+   GPSTK_INLINE_STORAGE_SIZE(int)
+   GPSTK_INLINE_STORAGE_SIZE(unsigned int)
+   GPSTK_INLINE_STORAGE_SIZE(long)
+   GPSTK_INLINE_STORAGE_SIZE(unsigned long)
+   GPSTK_INLINE_STORAGE_SIZE(float)
+   GPSTK_INLINE_STORAGE_SIZE(double)
+   GPSTK_INLINE_STORAGE_SIZE(long double)
+
+#undef GPSTK_INLINE_STORAGE_SIZE
+
+      /**
+       * Storage for up to N objects of a built-in type T, which need no
+       * constructor.  Other types have N = 0 and no storage at all.
+       */
+   template <class T, size_t N>
+   class InlineBuffer
+   {
+   public:
+         /// The start of the storage.
+      T* get()
+      { return elements; }
+   private:
+      T elements[N];
+   };
+
+   template <class T>
+   class InlineBuffer<T, 0>
+   {
+   public:
+         /// Never used, since nothing fits.
+      T* get()
+      { return reinterpret_cast<T*>(this); }
+   };
+
       /**
        * This class pretty much duplicates std::valarray<T> except it's fully
        * STL container compliant.  Remember that operators +=, -=, *= and /=
        * are provided by RefVectorBase.
+       *
+       * Vectors of built-in types with up to VECTOR_INLINE_SIZE elements
+       * (e.g. positions, velocities and 6-element states) are kept inside
+       * the object, so creating them doesn't touch the heap.  Larger
+       * vectors are allocated on the heap; when compiled as
+       * C++11 or later such vectors are moved rather than copied out of
+       * temporaries.
        * 
        * @sa matvectest.cpp for examples
        */
@@ -76,90 +136,141 @@ namespace gpstk
          /// STL const iterator type
       typedef const T* const_iterator;
 
+         /// Number of elements stored inside the object, not on the heap.
+      enum { VECTOR_INLINE_SIZE = InlineStorageSize<T>::VECTOR_SIZE };
+
          /// Default constructor
-      Vector() : v(NULL), s(0)
-      {}
-         /// Constructor given an initial size.
-      Vector(size_t siz) : v(NULL), s(siz)
+      Vector() : s(0), cap(VECTOR_INLINE_SIZE)
+      { v = local.get(); }
+         /// Constructor given an initial size.  The elements of a
+         /// vector kept inside the object are zero, so that copying or
+         /// moving it never reads uninitialized storage; those of a
+         /// larger vector are left uninitialized.
+      Vector(size_t siz)
+            : s(siz), cap(VECTOR_INLINE_SIZE)
       {
-         if (siz>0)
+         v = local.get();
+         if (siz>VECTOR_INLINE_SIZE)
          {
             v = new T[siz];
             if(!v) {
                VectorException e("Vector(size_t) failed to allocate");
                GPSTK_THROW(e);
             }
+            cap = siz;
+         }
+         else
+         {
+            for (size_t i = 0; i < siz; i++)
+               v[i] = T();
          }
       }
          /**
           * Constructor given an initial size and default value for
           * all elements.
           */
-      Vector(size_t siz, const T defaultValue) : v(NULL), s(siz)
+      Vector(size_t siz, const T defaultValue)
+            : s(siz), cap(VECTOR_INLINE_SIZE)
       {
-         if (siz>0)
+         v = local.get();
+         if (siz>VECTOR_INLINE_SIZE)
          {
             v = new T[siz];
             if(!v) {
                VectorException e("Vector<T>(size_t, const T) failed to allocate");
                GPSTK_THROW(e);
             }
-            this->assignFrom(defaultValue);
+            cap = siz;
          }
+         this->assignFrom(defaultValue);
       }
          /**
           * Copy constructor from a ConstVectorBase type.
           */
       template <class E>
-      Vector(const ConstVectorBase<T, E>& r) : v(NULL), s(r.size())
+      Vector(const ConstVectorBase<T, E>& r)
+            : s(r.size()), cap(VECTOR_INLINE_SIZE)
       {
-         if (r.size()>0)
+         v = local.get();
+         if (r.size()>VECTOR_INLINE_SIZE)
          {
             v = new T[r.size()];
             if(!v) {
                VectorException e("Vector<T>(ConstVectorBase) failed to allocate");
                GPSTK_THROW(e);
             }
-            this->assignFrom(r);
+            cap = r.size();
          }
+         this->assignFrom(r);
       }
          /**
           * Copy constructor.
           */
-      Vector(const Vector& r) : v(NULL), s(r.s)
+      Vector(const Vector& r)
+            : s(r.s), cap(VECTOR_INLINE_SIZE)
       {
-         if (r.s>0)
+         v = local.get();
+         if (r.s>VECTOR_INLINE_SIZE)
          {
             v = new T[r.s];
             if(!v) {
                VectorException e("Vector(Vector) failed to allocate");
                GPSTK_THROW(e);
             }
-            this->assignFrom(r);
+            cap = r.s;
          }
+         this->assignFrom(r);
       }
+#if __cplusplus >= 201103L
+         /**
+          * Move constructor: takes over the heap storage of r, if any,
+          * leaving r empty.
+          */
+      Vector(Vector&& r)
+            : s(r.s), cap(VECTOR_INLINE_SIZE)
+      {
+         v = local.get();
+         if (r.v != r.local.get())
+         {
+            v = r.v;
+            cap = r.cap;
+            r.v = r.local.get();
+            r.cap = VECTOR_INLINE_SIZE;
+         }
+         else
+         {
+            for (size_t i = 0; i < s; i++)
+               v[i] = r.v[i];
+         }
+         r.s = 0;
+      }
+#endif
          /**
           * Valarray constructor
           */
-      Vector(const std::valarray<T>& r) : v(NULL), s(r.size())
+      Vector(const std::valarray<T>& r)
+            : s(r.size()), cap(VECTOR_INLINE_SIZE)
       {
-         if (r.size())
+         v = local.get();
+         if (r.size()>VECTOR_INLINE_SIZE)
          {
             v = new T[r.size()];
             if(!v) {
                VectorException e("Vector(valarray) failed to allocate");
                GPSTK_THROW(e);
             }
-            this->assignFrom(r);
+            cap = r.size();
          }
+         this->assignFrom(r);
       }
 
          /// subvector constructor
       template <class E>
       Vector(const ConstVectorBase<T, E>& vec,
              size_t top,
-             size_t num) : v(NULL), s(0)
+             size_t num) : s(0), cap(VECTOR_INLINE_SIZE)
       {
+         v = local.get();
             // sanity checks...
          if ( top >= vec.size() || 
               top + num > vec.size())
@@ -169,11 +280,7 @@ namespace gpstk
          }
          if (num>0)
          {
-            v = new T[num];
-            if(!v) {
-               VectorException e("Vector(subvector) failed to allocate");
-               GPSTK_THROW(e);
-            }
+            resize(num);
             size_t i;
             for(i = 0; i < num; i++)
                v[i] = vec(top+i);
@@ -184,7 +291,7 @@ namespace gpstk
          /// Destructor
       ~Vector()
       {
-         if (v) delete [] v;
+         if (v != local.get()) delete [] v;
       }
 
          /// STL iterator begin
@@ -227,6 +334,31 @@ namespace gpstk
       Vector& operator=(const Vector& x)
       { resize(x.s); return this->assignFrom(x); }
 
+#if __cplusplus >= 201103L
+         /// Takes over the heap storage of x, if any, leaving x empty.
+      Vector& operator=(Vector&& x)
+      {
+         if (this == &x)
+            return *this;
+         if (x.v != x.local.get())
+         {
+            if (v != local.get()) delete [] v;
+            v = x.v;
+            cap = x.cap;
+            s = x.s;
+            x.v = x.local.get();
+            x.cap = VECTOR_INLINE_SIZE;
+         }
+         else
+         {
+            resize(x.s);
+            this->assignFrom(x);
+         }
+         x.s = 0;
+         return *this;
+      }
+#endif
+
          /// *this will be resized if it isn't as large as x.
       template <class E>
       Vector& operator=(const ConstVectorBase<T, E>& x)
@@ -255,24 +387,29 @@ namespace gpstk
          return (*this); 
       }
 
-         /// Resizes the vector.  if index > size, the vector will be
+         /// Resizes the vector.  if index > capacity(), the vector will be
          /// erased and the contents destroyed.
       Vector& resize(const size_t index)
       { 
-         if (index > s)
+         if (index > cap)
          {
-            if (v)
-               delete [] v;
-            v = new T[index];
-            if(!v) {
+            T* p = new T[index];
+            if(!p) {
                VectorException e("Vector.resize(size_t) failed to allocate");
                GPSTK_THROW(e);
             }
+            if (v != local.get())
+               delete [] v;
+            v = p;
+            cap = index;
          }
          s = index;
          return *this;
       }
 
+         /// The number of elements the vector can hold without allocating.
+      size_t capacity() const { return cap; }
+
          /// resize with new default value
       Vector& resize(const size_t index, const T defaultValue)
       {
@@ -364,10 +501,14 @@ namespace gpstk
 #endif
       }
    
-         /// The vector
+         /// The vector, either in local or on the heap
       T* v;
          /// The size of the vector.
       size_t s;
+         /// The number of elements v can hold.
+      size_t cap;
+         /// Storage for small vectors
+      InlineBuffer<T, VECTOR_INLINE_SIZE> local;
    };
       // end class Vector<T>
 
@@ -53,7 +53,7 @@ namespace gpstk
    template <class T, class BaseClass>                                  \
    Vector<T> func(const ConstVectorBase<T, BaseClass>& x)               \
    {                                                                    \
-      BaseClass toReturn(x.size());                                     \
+      Vector<T> toReturn(x.size());                                     \
       size_t i; for (i=0; i < x.size(); i++) toReturn[i] = func(x[i]);  \
       return toReturn;                                                  \
    }
@@ -118,6 +118,177 @@ namespace gpstk
    VecBaseNewBinaryOperator(&, Vector<T>)
    VecBaseNewBinaryOperator(|, Vector<T>)
 
+      /*
+       * Lazy vector expressions.  The operators above return a new
+       * Vector for every operation, so y + h*(a*k1 + b*k2) creates four
+       * temporary vectors.  When the vector operands are wrapped with
+       * lazy(), +, -, * and / return small expression objects instead.
+       * These nest without creating any Vector, and their elements are
+       * computed in a single pass when the expression is assigned to
+       * (or used to construct) a Vector or VectorSlice:
+       *
+       *    ytemp = lazy(y) + h*(a*lazy(k1) + b*lazy(k2));
+       *
+       * It is enough for one operand of each operation to be lazy.  An
+       * expression holds references to its vectors, so it must be used
+       * in the statement that creates it.  Since the elements are
+       * computed one index at a time, the target of the assignment may
+       * appear in the expression (v = lazy(v) + w), but it must not
+       * overlap it at a different index, as in assigning to one slice of
+       * a vector an expression using a shifted slice of the same vector.
+       */
+
+      /// The elementwise operations used by the vector expressions.
+   struct VectorExprAdd
+   { template <class T> static T apply(T l, T r) { return l + r; } };
+   struct VectorExprSub
+   { template <class T> static T apply(T l, T r) { return l - r; } };
+   struct VectorExprMul
+   { template <class T> static T apply(T l, T r) { return l * r; } };
+   struct VectorExprDiv
+   { template <class T> static T apply(T l, T r) { return l / r; } };
+
+      /// An unevaluated vector expression, as returned by lazy() and by
+      /// the arithmetic operators on lazy expressions.
+   template <class T, class E>
+   class VectorExpr : public ConstVectorBase<T, VectorExpr<T, E> >
+   {
+   public:
+      explicit VectorExpr(const E& e) : expr(e) {}
+         /// the size of the expression
+      size_t size() const { return expr.size(); }
+         /// computes the element at index i
+      T operator[] (size_t i) const { return expr[i]; }
+         /// computes the element at index i
+      T operator() (size_t i) const { return expr[i]; }
+   private:
+      E expr;
+   };
+
+      /// A vector or slice in an expression, held by reference.
+   template <class T, class V>
+   class VectorExprLeaf
+   {
+   public:
+      explicit VectorExprLeaf(const V& v) : vec(v) {}
+      size_t size() const { return vec.size(); }
+      T operator[] (size_t i) const { return vec[i]; }
+   private:
+      const V& vec;
+   };
+
+      /// An unevaluated l[i] Op r[i]
+   template <class T, class L, class R, class Op>
+   class VectorBinaryExpr
+   {
+   public:
+      VectorBinaryExpr(const L& l, const R& r) : lhs(l), rhs(r) {}
+      size_t size() const { return lhs.size(); }
+      T operator[] (size_t i) const
+      { return Op::template apply<T>(lhs[i], rhs[i]); }
+   private:
+      L lhs;
+      R rhs;
+   };
+
+      /// An unevaluated l[i] Op (scalar)r
+   template <class T, class L, class Op>
+   class VectorScalarExpr
+   {
+   public:
+      VectorScalarExpr(const L& l, const T r) : lhs(l), rhs(r) {}
+      size_t size() const { return lhs.size(); }
+      T operator[] (size_t i) const
+      { return Op::template apply<T>(lhs[i], rhs); }
+   private:
+      L lhs;
+      T rhs;
+   };
+
+      /// An unevaluated (scalar)l Op r[i]
+   template <class T, class R, class Op>
+   class ScalarVectorExpr
+   {
+   public:
+      ScalarVectorExpr(const T l, const R& r) : lhs(l), rhs(r) {}
+      size_t size() const { return rhs.size(); }
+      T operator[] (size_t i) const
+      { return Op::template apply<T>(lhs, rhs[i]); }
+   private:
+      T lhs;
+      R rhs;
+   };
+
+      /** returns x as a lazy expression, so that the arithmetic
+       * operators using it don't create temporary vectors */
+   template <class T, class BaseClass>
+   VectorExpr<T, VectorExprLeaf<T, BaseClass> >
+   lazy(const ConstVectorBase<T, BaseClass>& x)
+   {
+      return VectorExpr<T, VectorExprLeaf<T, BaseClass> >(
+         VectorExprLeaf<T, BaseClass>(static_cast<const BaseClass&>(x)));
+   }
+
+      /** returns the lazy expression l[i] Op r[i], after checking the
+       * lengths of l and r */
+   template <class Op, class T, class E, class E2>
+   VectorExpr<T, VectorBinaryExpr<T, VectorExpr<T, E>, VectorExpr<T, E2>, Op> >
+   makeVectorBinaryExpr(const VectorExpr<T, E>& l, const VectorExpr<T, E2>& r)
+   {
+      if (l.size() != r.size())
+      {
+         VectorException e("Unequal lengths vectors");
+         GPSTK_THROW(e);
+      }
+      return VectorExpr<T, VectorBinaryExpr<T, VectorExpr<T, E>,
+         VectorExpr<T, E2>, Op> >(VectorBinaryExpr<T, VectorExpr<T, E>,
+                                  VectorExpr<T, E2>, Op>(l, r));
+   }
+
+#define VecExprBinaryOperator(func, op)                                 \
+   /** returns a lazy expression for l[i] func r[i] */                  \
+   template <class T, class E, class E2>                                \
+   VectorExpr<T, VectorBinaryExpr<T, VectorExpr<T, E>,                  \
+                                  VectorExpr<T, E2>, op> >              \
+   operator func(const VectorExpr<T, E>& l, const VectorExpr<T, E2>& r) \
+   { return makeVectorBinaryExpr<op>(l, r); }                           \
+   /** returns a lazy expression for l[i] func r[i] */                  \
+   template <class T, class E, class BaseClass>                         \
+   VectorExpr<T, VectorBinaryExpr<T, VectorExpr<T, E>,                  \
+      VectorExpr<T, VectorExprLeaf<T, BaseClass> >, op> >               \
+   operator func(const VectorExpr<T, E>& l,                             \
+                 const ConstVectorBase<T, BaseClass>& r)                \
+   { return makeVectorBinaryExpr<op>(l, lazy(r)); }                     \
+   /** returns a lazy expression for l[i] func r[i] */                  \
+   template <class T, class BaseClass, class E>                         \
+   VectorExpr<T, VectorBinaryExpr<T,                                    \
+      VectorExpr<T, VectorExprLeaf<T, BaseClass> >,                     \
+      VectorExpr<T, E>, op> >                                           \
+   operator func(const ConstVectorBase<T, BaseClass>& l,                \
+                 const VectorExpr<T, E>& r)                             \
+   { return makeVectorBinaryExpr<op>(lazy(l), r); }                     \
+   /** returns a lazy expression for l[i] func (scalar)r */             \
+   template <class T, class E>                                          \
+   VectorExpr<T, VectorScalarExpr<T, VectorExpr<T, E>, op> >            \
+   operator func(const VectorExpr<T, E>& l, const T r)                  \
+   {                                                                    \
+      return VectorExpr<T, VectorScalarExpr<T, VectorExpr<T, E>, op> >( \
+         VectorScalarExpr<T, VectorExpr<T, E>, op>(l, r));              \
+   }                                                                    \
+   /** returns a lazy expression for (scalar)l func r[i] */             \
+   template <class T, class E>                                          \
+   VectorExpr<T, ScalarVectorExpr<T, VectorExpr<T, E>, op> >            \
+   operator func(const T l, const VectorExpr<T, E>& r)                  \
+   {                                                                    \
+      return VectorExpr<T, ScalarVectorExpr<T, VectorExpr<T, E>, op> >( \
+         ScalarVectorExpr<T, VectorExpr<T, E>, op>(l, r));              \
+   }
+
+   VecExprBinaryOperator(*, VectorExprMul)
+   VecExprBinaryOperator(/, VectorExprDiv)
+   VecExprBinaryOperator(+, VectorExprAdd)
+   VecExprBinaryOperator(-, VectorExprSub)
+
    VecBaseNewBinaryOperator(==, Vector<bool>)
    VecBaseNewBinaryOperator(<, Vector<bool>)
    VecBaseNewBinaryOperator(>, Vector<bool>)
@@ -168,7 +339,7 @@ namespace gpstk
          VectorException e("Cross product requires vectors of size 3");
          GPSTK_THROW(e);
       }
-      BaseClass toReturn(3);
+      Vector<T> toReturn(3);
       toReturn[0] = l[1] * r[2] - l[2] * r[1];
       toReturn[1] = l[2] * r[0] - l[0] * r[2];
       toReturn[2] = l[0] * r[1] - l[1] * r[0];
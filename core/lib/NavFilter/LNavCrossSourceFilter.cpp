@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "LNavCrossSourceFilter.hpp"
 
 namespace gpstk
@@ -5,6 +6,7 @@ namespace gpstk
    LNavCrossSourceFilter ::
    LNavCrossSourceFilter()
    {
+      resizeTable(0);
    }
 
    void LNavCrossSourceFilter ::
@@ -18,11 +20,11 @@ namespace gpstk
          {
                // different time, so check out what we have
             examineSubframes(msgBitsOut);
-            groupedNav.clear();
+            clearEpoch();
             currentTime = fd->timeStamp;
          }
             // add the subframe to our collection
-         groupedNav[fd->prn][fd].push_back(*nmli);
+         addMessage(*nmli, fd);
       }
    }
 
@@ -30,50 +32,165 @@ namespace gpstk
    finalize(NavMsgList& msgBitsOut)
    {
       examineSubframes(msgBitsOut);
-      groupedNav.clear();
+      clearEpoch();
       currentTime.reset();
    }
 
    void LNavCrossSourceFilter ::
    examineSubframes(NavMsgList& msgBitsOut)
    {
-      NavMap::const_iterator nmi;
-      SubframeMap::const_iterator smi;
+         // Visit the groups by PRN and by subframe bits, which
+         // decides the winner of a tie and the order of the output.
+      std::vector<int> order(groups.size());
+      for (size_t i = 0; i < order.size(); i++)
+         order[i] = i;
+      std::sort(order.begin(), order.end(), GroupSort(groups));
+
+      size_t begin, end, i;
          // loop over each PRN/SV
-      for (nmi = groupedNav.begin(); nmi != groupedNav.end(); nmi++)
+      for (begin = 0; begin < order.size(); begin = end)
       {
-            // count of unique messages
-         size_t uniqueBits = nmi->second.size();
+         uint32_t prn = groups[order[begin]].fd->prn;
+         for (end = begin+1; end < order.size(); end++)
+         {
+            if (groups[order[end]].fd->prn != prn)
+               break;
+         }
             // count of total messages
          size_t msgCount = 0;
             // store the vote winner here
-         LNavFilterData *winner = NULL;
+         int winner = -1;
             // store the largest number of "votes" for a subframe here
          size_t voteCount = 0;
-         for (smi = nmi->second.begin(); smi != nmi->second.end(); smi++)
+         for (i = begin; i < end; i++)
          {
-            size_t msgs = smi->second.size();
+            size_t msgs = groups[order[i]].count;
             msgCount += msgs;
                // minimum # of useful votes
             if ((msgs > voteCount) && (msgs >= 2))
             {
                voteCount = msgs;
-               winner = smi->first;
+               winner = order[i];
             }
          }
          if (msgCount < 3)
-            winner = NULL; // not enough messages to have a useful vote
+            winner = -1; // not enough messages to have a useful vote
 
-            // If winner is NULL, i.e. there is no winner, all
-            // messages will be rejected below.  Otherwise only the
-            // winners will be accepted.
-         for (smi = nmi->second.begin(); smi != nmi->second.end(); smi++)
+            // If there is no winner, all messages will be rejected
+            // below.  Otherwise only the winners will be accepted.
+         for (i = begin; i < end; i++)
          {
-            if (smi->first == winner)
-               accept(smi->second, msgBitsOut);
-            else
-               reject(smi->second);
+            for (int l = groups[order[i]].first; l >= 0; l = links[l].next)
+            {
+               if (order[i] == winner)
+                  accept(links[l].msg, msgBitsOut);
+               else
+                  reject(links[l].msg);
+            }
          }
       }
    }
+
+   void LNavCrossSourceFilter ::
+   addMessage(NavFilterKey *msg, LNavFilterData *fd)
+   {
+      uint32_t hash = hashSubframe(fd);
+      size_t mask = table.size() - 1;
+      size_t slot = hash & mask;
+      int g;
+         // linear probing for a group with the same PRN and bits
+      while ((g = table[slot]) >= 0)
+      {
+         const Group& group = groups[g];
+         if ((group.hash == hash) && (group.fd->prn == fd->prn) &&
+             std::equal(fd->sf, fd->sf+10, group.fd->sf))
+         {
+            break;
+         }
+         slot = (slot + 1) & mask;
+      }
+
+      Link link = { msg, -1 };
+      links.push_back(link);
+      int l = links.size() - 1;
+      if (g >= 0)
+      {
+         Group& group = groups[g];
+         links[group.last].next = l;
+         group.last = l;
+         group.count++;
+         return;
+      }
+
+      Group group = { fd, hash, 1, l, l };
+      groups.push_back(group);
+      table[slot] = groups.size() - 1;
+         // keep the table at most half full
+      if (2*groups.size() > table.size())
+         resizeTable(groups.size());
+   }
+
+   void LNavCrossSourceFilter ::
+   clearEpoch()
+   {
+      size_t numLinks = links.size(), numGroups = groups.size();
+      links.clear();
+      groups.clear();
+         // Give back the storage if the epoch just processed needed
+         // less than a fourth of it, otherwise keep it for the next.
+      if ((links.capacity() > 1024) && (4*numLinks < links.capacity()))
+      {
+         std::vector<Link>().swap(links);
+         links.reserve(2*numLinks);
+         std::vector<Group>().swap(groups);
+         groups.reserve(2*numGroups);
+      }
+      if (table.size() > 8*(numGroups+1) && table.size() > 64)
+         resizeTable(numGroups);
+      else
+         std::fill(table.begin(), table.end(), -1);
+   }
+
+   void LNavCrossSourceFilter ::
+   resizeTable(size_t numGroups)
+   {
+      size_t size = 64;
+      while (size < 2*numGroups + 2)
+         size *= 2;
+      table.assign(size, -1);
+         // put back the groups already there
+      for (size_t g = 0; g < groups.size(); g++)
+      {
+         size_t slot = groups[g].hash & (size-1);
+         while (table[slot] >= 0)
+            slot = (slot + 1) & (size-1);
+         table[slot] = g;
+      }
+   }
+
+   uint32_t LNavCrossSourceFilter ::
+   hashSubframe(const LNavFilterData *fd)
+   {
+         // FNV-1a, a word at a time, over the PRN and the ten words,
+         // with a final mix so that the low bits used for the slot
+         // depend on all the bits.
+      uint32_t hash = 2166136261U ^ fd->prn;
+      hash *= 16777619U;
+      for (unsigned sfword = 0; sfword < 10; sfword++)
+      {
+         hash ^= fd->sf[sfword];
+         hash *= 16777619U;
+      }
+      hash ^= hash >> 15;
+      return hash;
+   }
+
+   bool LNavCrossSourceFilter::GroupSort ::
+   operator()(int l, int r) const
+   {
+      const LNavFilterData *lfd = groups[l].fd, *rfd = groups[r].fd;
+      if (lfd->prn != rfd->prn)
+         return (lfd->prn < rfd->prn);
+      return LNavMsgSort()(lfd, rfd);
+   }
 }
@@ -1,6 +1,7 @@
 #ifndef LNAVCROSSOURCEFILTER_HPP
 #define LNAVCROSSOURCEFILTER_HPP
 
+#include <vector>
 #include <NavFilterMgr.hpp>
 #include <NavFilter.hpp>
 #include <LNavFilterData.hpp>
@@ -15,18 +16,30 @@ namespace gpstk
        * multiple codes can be compared against each other, or across
        * multiple receivers (with or without multiple codes).
        *
+       * The subframes of an epoch are grouped by PRN and contents in
+       * a hash table, so that adding a subframe takes constant time
+       * however many sources there are.  The groups and the messages
+       * are kept in arrays that are reused from one epoch to the
+       * next, and trimmed when an epoch needs much less than what has
+       * been allocated, so that no memory is allocated per message
+       * and the memory held stays proportional to the size of the
+       * recent epochs.  The data of an epoch is released as soon as
+       * a subframe with a different time stamp is seen.
+       *
        * @attention Processing depth = 2 epochs. */
    class LNavCrossSourceFilter : public NavFilter
    {
    public:
       LNavCrossSourceFilter();
 
-         /** Add LNAV messages to the voting collection (groupedNav).
+         /** Add LNAV messages to the voting collection (groups).
           * @pre NavFilterKey::timeStamp is set to either the HOW time
           *   of the subframe, or the time of transmission of the
           *   subframe.
           * @pre NavFilterKey::prn is set
           * @pre LNavFilterData::sf is set
+          * @pre Subframes of the same epoch are given together (in
+          *   one or several calls).
           * @param[in,out] msgBitsIn A list of LNavFilterData* objects
           *   containing GPS legacy navigation messages (id 2).
           * @param[out] msgBitsOut The messages successfully passing
@@ -35,27 +48,67 @@ namespace gpstk
           *   but not current calls to validate will be here). */
       virtual void validate(NavMsgList& msgBitsIn, NavMsgList& msgBitsOut);
 
-         /** Flush the remaining contents of groupedNav.
+         /** Flush the remaining contents of groups.
           * @param[out] msgBitsOut Any remaining valid (by vote) nav
           *   messages are stored here on return. */
       virtual void finalize(NavMsgList& msgBitsOut);
 
    protected:
-         /// Map from subframe data to source list
-      typedef std::map<LNavFilterData*, NavMsgList, LNavMsgSort> SubframeMap;
-         /// Map from PRN to SubframeMap
-      typedef std::map<uint32_t, SubframeMap> NavMap;
+         /// The messages of one PRN having identical subframe bits.
+      struct Group
+      {
+         LNavFilterData *fd; ///< First message of the group
+         uint32_t hash;      ///< Hash of the PRN and subframe bits
+         size_t count;       ///< Number of messages ("votes")
+         int first;          ///< Index in links of the first message
+         int last;           ///< Index in links of the last message
+      };
+
+         /// One message in the list of a Group.
+      struct Link
+      {
+         NavFilterKey *msg;  ///< The message
+         int next;           ///< Index of the next message, or -1
+      };
 
-         /// Nav subframes grouped by prn and unique nav bits
-      NavMap groupedNav;
+         /// Sort indices of groups by PRN, then by subframe bits.
+      struct GroupSort
+      {
+         GroupSort(const std::vector<Group>& g) : groups(g) {}
+         bool operator()(int l, int r) const;
+         const std::vector<Group>& groups;
+      };
+
+         /// Nav subframes of the current epoch grouped by prn and
+         /// unique nav bits, in order of first appearance.
+      std::vector<Group> groups;
+         /// Storage for the lists of messages of the groups.
+      std::vector<Link> links;
+         /// Open-addressing hash table of indices in groups (-1 =
+         /// empty slot).  Its size is a power of 2.
+      std::vector<int> table;
          /// Most recent time
       gpstk::CommonTime currentTime;
 
 
+         /// Add a message to the group matching its PRN and bits.
+      void addMessage(NavFilterKey *msg, LNavFilterData *fd);
+
+         /** Remove the data of the current epoch, keeping the storage
+          * unless it is much larger than what the epoch needed. */
+      void clearEpoch();
+
+         /** Make a new hash table large enough for 'numGroups'
+          * groups, holding those already in groups. */
+      void resizeTable(size_t numGroups);
+
+         /// Hash of the PRN and subframe bits of fd.
+      static uint32_t hashSubframe(const LNavFilterData *fd);
+
          /** Filter by vote.
           * @note Bare minimum for producing output is 2 out of 3
           *   matching subframes.  If there are no matching subframes,
-          *   or fewer than 3 subframes are present in groupedNav, no
+          *   or fewer than 3 subframes are present in groups, no
           *   output will be produced.
           * @param[out] msgBitsOut Nav messages passing the voting
           *   algorithm are stored here. */
@@ -18,8 +18,26 @@ namespace gpstk
    NavFilter::NavMsgList NavFilterMgr ::
    validate(NavFilterKey* msgBits)
    {
-      NavFilter::NavMsgList rv, newrv;
+      NavFilter::NavMsgList rv;
       rv.push_back(msgBits);
+      validateList(rv);
+      return rv;
+   }
+
+
+   NavFilter::NavMsgList NavFilterMgr ::
+   validate(const std::vector<NavFilterKey*>& msgBits)
+   {
+      NavFilter::NavMsgList rv(msgBits.begin(), msgBits.end());
+      validateList(rv);
+      return rv;
+   }
+
+
+   void NavFilterMgr ::
+   validateList(NavFilter::NavMsgList& rv)
+   {
+      NavFilter::NavMsgList newrv;
       rejected.clear();
       for (FilterList::iterator i = filters.begin(); i != filters.end(); i++)
       {
@@ -30,9 +48,8 @@ namespace gpstk
          (*i)->validate(rv, newrv);
          if (!(*i)->rejected.empty())
             rejected.insert(*i);
-         rv = newrv;
+         rv.swap(newrv);
       }
-      return rv;
    }
 
 
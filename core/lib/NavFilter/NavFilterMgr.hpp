@@ -3,6 +3,7 @@
 
 #include <list>
 #include <set>
+#include <vector>
 #include <NavFilter.hpp>
 
 namespace gpstk
@@ -148,6 +149,19 @@ namespace gpstk
           *   configured filters. */
       NavFilter::NavMsgList validate(NavFilterKey* msgBits);
 
+         /** Validate a batch of navigation messages, typically all
+          * those of one epoch from every source.  Each filter is
+          * called once for the whole batch, rather than once per
+          * message, which gives the same messages for the filters
+          * in this library and is cheaper when there are many
+          * sources.
+          * @param[in] msgBits The navigation messages to
+          *   validate/filter, in the order they would be given to
+          *   validate(NavFilterKey*).
+          * @return Any messages that have successfully passed all
+          *   configured filters. */
+      NavFilter::NavMsgList validate(const std::vector<NavFilterKey*>& msgBits);
+
          /** Flush the stored data for all known filters.  This method
           * should be called by the user after all data has been added
           * to the filter manager via validate().
@@ -166,6 +180,10 @@ namespace gpstk
    private:
          /// The collection of navigation message filters to apply.
       FilterList filters;
+
+         /** Run the messages in rv through all the filters, leaving
+          * in rv those that passed. */
+      void validateList(NavFilter::NavMsgList& rv);
    };
 
       //@}
@@ -38,6 +38,7 @@
 /// Pseudorange navigation solution, either a simple solution using all the
 /// given data, or a solution including editing via a RAIM algorithm.
 
+#include <algorithm>
 #include "MathBase.hpp"
 #include "PRSolution.hpp"
 #include "GPSEllipsoid.hpp"
@@ -488,6 +489,175 @@ namespace gpstk
    } // end PRSolution::SimplePRSolution
 
 
+   // -------------------------------------------------------------------------
+   // Screening of the RAIM subsets, using the linearized solution with all the
+   // satellites. For a subset S (the rows R rejected), the normal equations are
+   // downdated, N_S = N - sum(R) w*p*pT and b_S = b - sum(R) w*p*r, and solved
+   // for the change in state dX_S; the RMS of the residuals r - P*dX_S over S is
+   // then close to the RMS residual of the iterated solution for S. The
+   // difference comes from the terms left out of the partials (trop model,
+   // earth rotation) and from the curvature of the ranges; it is bounded by
+   // a margin that grows with the size of dX_S, and that is scaled by the
+   // condition of the weights. Subsets whose state moves too far, or whose
+   // normal equations are singular, get a bound of zero and are always iterated.
+   class RAIMScreen
+   {
+   public:
+      RAIMScreen() : Valid(false) {}
+
+      // Set up with the partials P, (pre-fit) residuals R and inverse
+      // measurement covariance iMC (dimension 0 or diagonal) of a solution.
+      // Clk[i] is the column of the clock of row i; the satellites must all be
+      // above (or all be below) the horizon by a margin, see RAIMCompute().
+      void init(const Matrix<double>& P, const Vector<double>& R,
+                const Matrix<double>& iMC, const vector<int>& Clk,
+                const double& convLimit)
+      {
+         size_t i,j,k;
+         Valid = false;
+         n = P.rows();
+         dim = P.cols();
+         Part = P;
+         Res = R;
+         Wt = Vector<double>(n,1.0);
+         ClkCol = Clk;
+         if(iMC.rows() > 0) {
+            for(i=0; i<n; i++) for(j=0; j<n; j++)
+               if(i != j && iMC(i,j) != 0.0) return;
+            for(i=0; i<n; i++) {
+               if(!(iMC(i,i) > 0.0)) return;
+               Wt(i) = iMC(i,i);
+            }
+         }
+
+         // the weighted least squares projection may stretch the (unweighted)
+         // residuals by as much as the square root of the condition of W
+         double wmin(Wt(0)),wmax(Wt(0));
+         for(i=1; i<n; i++) {
+            if(Wt(i) < wmin) wmin = Wt(i);
+            if(Wt(i) > wmax) wmax = Wt(i);
+         }
+         Stretch = ::sqrt(wmax/wmin);
+         Margin = 1.e-3 + 10.0*convLimit;
+
+         // full normal equations, and number of satellites for each clock
+         NFull = Matrix<double>(dim,dim,0.0);
+         bFull = Vector<double>(dim,0.0);
+         for(i=0; i<n; i++) {
+            for(j=0; j<dim; j++) {
+               bFull(j) += Part(i,j)*Wt(i)*Res(i);
+               for(k=0; k<dim; k++) NFull(j,k) += Part(i,j)*Wt(i)*Part(i,k);
+            }
+         }
+         NClk = vector<int>(dim,0);
+         for(i=0; i<n; i++) NClk[ClkCol[i]]++;
+
+         Valid = true;
+      }
+
+      bool isValid(void) const { return Valid; }
+
+      // True if the subset without the k rows in Rej has fewer satellites than
+      // unknowns, i.e. SimplePRSolution() would return -3.
+      bool tooFew(const int *Rej, int k) const
+      {
+         vector<int> cnt(NClk);
+         for(int i=0; i<k; i++) cnt[ClkCol[Rej[i]]]--;
+         size_t nsys(0);
+         for(size_t j=3; j<dim; j++) if(cnt[j] > 0) nsys++;
+         return (n - k < 3 + nsys);
+      }
+
+      // Lower bound on the RMS residual of the subset without the k rows in Rej.
+      double lowerBound(const int *Rej, int k) const
+      {
+         int i;
+         size_t j,l;
+         double N[MaxDim][MaxDim],b[MaxDim],dX[MaxDim];
+         if(dim > MaxDim) return 0.0;
+
+         // downdate
+         vector<int> cnt(NClk);
+         for(j=0; j<dim; j++) {
+            b[j] = bFull(j);
+            for(l=0; l<dim; l++) N[j][l] = NFull(j,l);
+         }
+         for(i=0; i<k; i++) {
+            const int r(Rej[i]);
+            cnt[ClkCol[r]]--;
+            for(j=0; j<dim; j++) {
+               const double wp(Wt(r)*Part(r,j));
+               b[j] -= wp*Res(r);
+               for(l=0; l<dim; l++) N[j][l] -= wp*Part(r,l);
+            }
+         }
+
+         // a clock with no satellites left drops out of the problem
+         for(j=3; j<dim; j++) {
+            if(cnt[j] > 0) continue;
+            for(l=0; l<dim; l++) N[j][l] = N[l][j] = 0.0;
+            N[j][j] = 1.0;
+            b[j] = 0.0;
+         }
+
+         // solve by Cholesky; N = L*LT with L in the lower triangle
+         for(j=0; j<dim; j++) {
+            double d(N[j][j]);
+            for(l=0; l<j; l++) d -= N[j][l]*N[j][l];
+            if(!(d > 1.e-12*N[j][j])) return 0.0;
+            N[j][j] = ::sqrt(d);
+            for(size_t m=j+1; m<dim; m++) {
+               double x(N[m][j]);
+               for(l=0; l<j; l++) x -= N[m][l]*N[j][l];
+               N[m][j] = x/N[j][j];
+            }
+         }
+         for(j=0; j<dim; j++) {
+            dX[j] = b[j];
+            for(l=0; l<j; l++) dX[j] -= N[j][l]*dX[l];
+            dX[j] /= N[j][j];
+         }
+         for(j=dim; j-- > 0; ) {
+            for(l=j+1; l<dim; l++) dX[j] -= N[l][j]*dX[l];
+            dX[j] /= N[j][j];
+         }
+
+         // how far the position moves from the linearization point
+         const double D(RSS(dX[0],dX[1],dX[2]) + 1.0);
+         if(D > MaxShift) return 0.0;
+
+         // RMS of the post-fit residuals of the subset
+         vector<bool> rejected(n,false);
+         for(i=0; i<k; i++) rejected[Rej[i]] = true;
+         double sum(0.0);
+         for(size_t m=0; m<n; m++) {
+            if(rejected[m]) continue;
+            double e(Res(m));
+            for(j=0; j<dim; j++) e -= Part(m,j)*dX[j];
+            sum += e*e;
+         }
+         const double rms(::sqrt(sum/double(n-k)));
+
+         return (rms - Stretch*(Margin + 1.e-2*D + 1.e-6*D*D));
+      }
+
+      // Largest change in position (m) for which the bound is used.
+      static const double MaxShift;
+
+   private:
+      static const size_t MaxDim = 16;
+
+      bool Valid;
+      size_t n,dim;
+      Matrix<double> Part,NFull;
+      Vector<double> Res,Wt,bFull;
+      vector<int> ClkCol,NClk;
+      double Stretch,Margin;
+
+   }; // end class RAIMScreen
+
+   const double RAIMScreen::MaxShift = 500.0;
+
    // -------------------------------------------------------------------------
    // Compute a solution using RAIM.
    int PRSolution::RAIMCompute(const CommonTime& Tr,
@@ -518,6 +688,7 @@ namespace gpstk
          // initialize
          Valid = false;
          currTime = Tr;
+         NRAIMSolutions = 0;
          TropFlag = SlopeFlag = RMSFlag = false;
 
          // ----------------------------------------------------------------
@@ -579,17 +750,71 @@ namespace gpstk
          // stage is the number of satellites to reject.
          int stage(0);
 
+         // linearized solution with all the satellites, to screen the subsets
+         RAIMScreen Screen;
+
+         // the combination (within the stage) that gave the best solution
+         int BestStage(-1),BestCombo(-1);
+
          do {
-            // compute all the combinations of N satellites taken stage at a time
+            // compute all the combinations of N satellites taken stage at a time,
+            // storing the indexes (in GoodIndexes) of the rejected satellites
             Combinations Combo(N,stage);
+            vector<int> Rejects;
+            do {
+               for(j=0; j<size_t(stage); j++)
+                  Rejects.push_back(Combo.Selection(j));
+            } while(Combo.Next() != -1);
+            const int NCombo(stage > 0 ? Rejects.size()/stage : 1);
+
+            // Order in which the combinations are computed. Without screening,
+            // it is that of Combo. With screening, the combinations come in
+            // order of their lower bound on the RMS residual, and the loop may
+            // skip to the last one once the bound exceeds the best RMS; the last
+            // one is always computed, so that the output (e.g. when no solution
+            // is good) is the same as that of the exhaustive search. The last
+            // is the first that has too few satellites, if there is one.
+            vector<int> Order;
+            vector<double> Bound;
+            const bool screened(ScreenRAIM && stage > 0 && Screen.isValid());
+            int Last(NCombo-1);
+            if(screened) {
+               for(int c=0; c<NCombo; c++)
+                  if(Screen.tooFew(&Rejects[c*stage],stage)) { Last = c; break; }
+
+               vector< pair<double,int> > sorted;
+               for(int c=0; c<Last; c++)
+                  sorted.push_back(pair<double,int>(
+                                 Screen.lowerBound(&Rejects[c*stage],stage), c));
+               sort(sorted.begin(),sorted.end());
+
+               Bound = vector<double>(NCombo,0.0);
+               for(i=0; i<sorted.size(); i++) {
+                  Order.push_back(sorted[i].second);
+                  Bound[sorted[i].second] = sorted[i].first;
+               }
+               Order.push_back(Last);
+            }
+            else for(int c=0; c<NCombo; c++) Order.push_back(c);
 
             // compute a solution for each combination of marked satellites
-            do {
+            for(size_t k=0; k<Order.size(); k++) {
+               const int c(Order[k]);
+
+               // no other subset can do better than the best: go to the last
+               if(screened && c != Last && BestRMS >= 0.0 && Bound[c] > BestRMS) {
+                  LOG(DEBUG) << " RAIM: screening skips "
+                     << Order.size()-1-k << " combinations";
+                  k = Order.size()-2;
+                  continue;
+               }
+
                // Mark the satellites for this combination
                Sats = SaveSats;
-               for(i=0; i<GoodIndexes.size(); i++)
-                  if(Combo.isSelected(i))
-                     Sats[GoodIndexes[i]].id = -::abs(Sats[GoodIndexes[i]].id);
+               for(j=0; j<size_t(stage); j++) {
+                  i = GoodIndexes[Rejects[c*stage+j]];
+                  Sats[i].id = -::abs(Sats[i].id);
+               }
 
                if(LOGlevel >= ConfigureLOG::Level("DEBUG")) {
                   ostringstream oss;
@@ -612,6 +837,7 @@ namespace gpstk
                //       -4  no ephemeris
                iret = SimplePRSolution(Tr, Sats, SVP, invMC, pTropModel,
                        MaxNIterations, ConvergenceLimit, Syss, Resids, Slopes);
+               NRAIMSolutions++;
 
                LOG(DEBUG) << " RAIM: SimplePRS returns " << iret;
                if(iret <= 0 && iret > BestIret) BestIret = iret;
@@ -648,7 +874,10 @@ namespace gpstk
 
                // deal with the results of SimplePRSolution()
                // save 'best' solution for later
-               if(BestRMS < 0.0 || RMSResidual < BestRMS) {
+               // (when screening, combinations within a stage come out of
+               // order; ties go to the earlier one, as in the exhaustive search)
+               if(BestRMS < 0.0 || RMSResidual < BestRMS ||
+                  (RMSResidual == BestRMS && stage == BestStage && c < BestCombo)) {
                   BestRMS = RMSResidual;
                   BestSol = Solution;
                   BestSats = SatelliteIDs;
@@ -662,12 +891,33 @@ namespace gpstk
                   BestPFR = PreFitResidual;
                   BestTropFlag = TropFlag;
                   BestIret = iret;
+                  BestStage = stage;
+                  BestCombo = c;
+               }
+
+               // set up the screening with the solution using all satellites;
+               // not where the trop correction might be switched on or off
+               // (near the horizon or the height limits) in another subset
+               if(stage == 0 && ScreenRAIM && !TropFlag) {
+                  Position R,S;
+                  R.setECEF(Solution(0),Solution(1),Solution(2));
+                  bool ok(R.getHeight() > -1000.0+RAIMScreen::MaxShift &&
+                          R.getHeight() < 100000.0-RAIMScreen::MaxShift);
+                  vector<int> Clk;
+                  for(i=0; ok && i<GoodIndexes.size(); i++) {
+                     const int n(GoodIndexes[i]);
+                     S.setECEF(SVP(n,0),SVP(n,1),SVP(n,2));
+                     if(R.elevation(S) < 0.01) ok = false;
+                     Clk.push_back(3 + vectorindex(SystemIDs, Sats[n].system));
+                  }
+                  if(ok)
+                     Screen.init(Partials,Resids,invMeasCov,Clk,ConvergenceLimit);
                }
 
                if(stage==0 && RMSResidual < RMSLimit)
                   break;
 
-            } while(Combo.Next() != -1);  // get the next combinations and repeat
+            }  // end loop over combinations
 
             // end of the stage
             if(BestRMS > 0.0 && BestRMS < RMSLimit) {          // success
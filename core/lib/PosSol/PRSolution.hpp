@@ -182,6 +182,19 @@ namespace gpstk
       /// after that SimplePRSolution() and RAIMCompute() will update it.
       Vector<double> APSolution;
 
+      /// arguments of one call to add()
+      struct AddArgs {
+         Vector<double> Sol, PreFitResid;
+         Matrix<double> Cov, Partials, invMeasCov;
+      };
+
+      /// if true, add() does not accumulate anything, but saves its arguments in
+      /// Deferred, to be passed later to add(const AddArgs&) in the same order.
+      /// This lets solutions computed in several threads be combined exactly as
+      /// if they had been computed in sequence.
+      bool deferAdd;
+      std::vector<AddArgs> Deferred;
+
       /// constructor
       PRSMemory() throw() { reset(); }
 
@@ -192,6 +205,8 @@ namespace gpstk
       void reset(void) throw()
       {
          fixedAPriori = false;
+         deferAdd = false;
+         Deferred.clear();
          nsol = ndata = 0;
          APV = 0.0;
          was.reset();
@@ -263,6 +278,17 @@ namespace gpstk
                const Matrix<double>& invMeasCov)
          throw(Exception)
       {
+         if(deferAdd) {
+            AddArgs args;
+            args.Sol = Sol;
+            args.Cov = Cov;
+            args.PreFitResid = PreFitResid;
+            args.Partials = Partials;
+            args.invMeasCov = invMeasCov;
+            Deferred.push_back(args);
+            return;
+         }
+
          was.add(Sol, Cov);
 
          // first solution: apriori solution has no clock, so PFR bad
@@ -289,6 +315,10 @@ namespace gpstk
          }
       }
 
+      /// add a solution saved while deferAdd was set
+      void add(const AddArgs& args) throw(Exception)
+      { add(args.Sol, args.Cov, args.PreFitResid, args.Partials, args.invMeasCov); }
+
       // dump statistics and weighted average
       void dump(std::ostream& os, std::string msg="PRS") throw(Exception)
       {
@@ -361,7 +391,9 @@ namespace gpstk
                              NSatsReject(-1),
                              MaxNIterations(10),
                              ConvergenceLimit(3.e-7),
+                             ScreenRAIM(false),
                              hasMemory(true),
+                             NRAIMSolutions(0),
                              Valid(false)
          {}
       /// Return the status of solution
@@ -379,6 +411,10 @@ namespace gpstk
       /// if this = -1, as many as possible will be rejected (RAIM requires at least 5
       /// satellites). A (single) non-RAIM solution can be obtained by setting this
       /// to 0 before calling RAIMCompute().
+      /// RAIMCompute() has no time limit: with N satellites it may iterate a
+      /// solution for every subset with up to NSatsReject of them rejected, i.e.
+      /// C(N,0)+C(N,1)+...+C(N,NSatsReject) solutions, which grows quickly with
+      /// N when this is -1. Set it to bound the time taken at each epoch.
       int NSatsReject;
 
       /// Maximum number of iterations allowed in the linearized least squares
@@ -389,6 +425,22 @@ namespace gpstk
       /// solution exceeds this.
       double ConvergenceLimit;
 
+      /// If true, RAIMCompute() screens the subsets of satellites after the first
+      /// stage: the RMS residual of each subset is bounded from below using the
+      /// linearized solution with all the satellites (downdating its normal
+      /// equations), and only the subsets that could beat the best solution found
+      /// so far are iterated, the most promising first. Screening is not done
+      /// when the measurement covariance is not diagonal, or when a satellite is
+      /// near the horizon; it then falls back to the exhaustive search (false),
+      /// which iterates every subset.
+      /// The margin that turns the linearized RMS into a lower bound is chosen
+      /// from the size of the neglected terms (trop model, earth rotation,
+      /// curvature of the ranges), not proven, so a subset that would have been
+      /// the best may rarely be skipped; the result is then not that of the
+      /// exhaustive search. The worst case time is that of the exhaustive
+      /// search (see NSatsReject). Default false.
+      bool ScreenRAIM;
+
       /// vector<SatID> containing the satellite systems included in the solution. 
       /// It should be defined before the first solution call; if it is empty at that
       /// time it will be determined by the input SatelliteIDs. It is used to
@@ -465,6 +517,10 @@ namespace gpstk
       /// the number of good satellites used in the final computation
       int Nsvs;
 
+      /// the number of (iterated) solutions computed in the last call to
+      /// RAIMCompute()
+      int NRAIMSolutions;
+
       /// if true, the solution was constructed from a mixed dataset, including
       /// both GPS and Glonass satellites. This means the Solution vector will have
       /// length 5, with the last element being the estimated GPS-GLO time offset.
@@ -0,0 +1,93 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file logstream.cpp
+/// The streams of class ConfigureLOGstream; the stream of each thread is kept
+/// here, so that logstream.hpp does not depend on POSIX threads.
+
+#include "logstream.hpp"
+
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+
+   // C-style destructor of the stream pointer of a thread
+extern "C"
+{
+   static void DeleteThreadStream(void *p)
+   { delete static_cast<std::ostream **>(p); }
+}
+
+namespace
+{
+   /// key of the stream pointer of each thread that has called ThreadStream()
+   pthread_key_t ThreadKey()
+   {
+      static pthread_key_t key;
+      static bool created(pthread_key_create(&key, DeleteThreadStream) == 0);
+      (void)created;
+      return key;
+   }
+}
+#endif
+
+std::ostream*& ConfigureLOGstream::Stream()
+{
+   static std::ostream *pStream = &(std::cout);
+#ifdef GPSTK_HAVE_PTHREAD
+   std::ostream **pThread =
+      static_cast<std::ostream **>(pthread_getspecific(ThreadKey()));
+   if(pThread) return *pThread;
+#endif
+   return pStream;
+}
+
+void ConfigureLOGstream::ThreadStream(std::ostream *pstrm)
+{
+#ifdef GPSTK_HAVE_PTHREAD
+   std::ostream **pThread =
+      static_cast<std::ostream **>(pthread_getspecific(ThreadKey()));
+   if(!pstrm) {
+      pthread_setspecific(ThreadKey(), 0);
+      delete pThread;
+      return;
+   }
+   if(!pThread) {
+      pThread = new std::ostream*;
+      pthread_setspecific(ThreadKey(), pThread);
+   }
+   *pThread = pstrm;
+#endif
+}
@@ -266,6 +266,16 @@ template <class T> inline std::string Log<T>::NowTime()
 ///    // ...
 /// @endcode
 ///
+/// How to use: 6. A thread may send its own output to another stream, leaving the
+///    Stream() of all other threads unchanged; for example to keep the output of
+///    each piece of work apart and write it out later, in order.
+/// @code
+///    std::ostringstream oss;
+///    ConfigureLOG::ThreadStream(&oss);   // LOG in this thread now writes to oss
+///    //...
+///    ConfigureLOG::ThreadStream(0);      // back to Stream()
+/// @endcode
+///
 class ConfigureLOGstream
 {
 public:
@@ -276,15 +286,17 @@ public:
    /// @endcode
    static std::ostream*& Stream();
 
+   /// direct the log stream output of the calling thread only to pstrm; a null
+   /// pointer returns it to the stream shared by all threads. Without POSIX
+   /// threads there is only the shared stream, and this does nothing.
+   static void ThreadStream(std::ostream *pstrm);
+
    /// used internally
    static void Output(const std::string& msg);
 };
 
-inline std::ostream*& ConfigureLOGstream::Stream()
-{
-   static std::ostream *pStream = &(std::cout);
-   return pStream;
-}
+// Stream() and ThreadStream() are defined in logstream.cpp, so that the
+// code using this header does not depend on how the library was built.
 
 inline void ConfigureLOGstream::Output(const std::string& msg)
 {   
@@ -300,6 +312,8 @@ class ConfigureLOG : public Log<ConfigureLOGstream> {
 public:
    static std::ostream*& Stream()
    { return ConfigureLOGstream::Stream(); }
+   static void ThreadStream(std::ostream *pstrm)
+   { ConfigureLOGstream::ThreadStream(pstrm); }
    static LogLevel Level(const std::string& str)
    { return FromString(str); }
 };
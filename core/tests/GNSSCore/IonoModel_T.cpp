@@ -36,6 +36,8 @@
 
 #include "TestUtil.hpp"
 #include "IonoModel.hpp"
+#include "CivilTime.hpp"
+#include <ctime>
 
 using namespace gpstk;
 using namespace std;
@@ -49,6 +51,7 @@ class IonoModel_T
         int nonEqualityTest( void );
         int validTest( void );
         int exceptionTest( void );
+        int batchTest( void );
     protected:
     private:
 };
@@ -302,6 +305,70 @@ int IonoModel_T :: exceptionTest( void )
 
 }
 
+//------------------------------------------------------------
+// Assert that getCorrections() gives the corrections of getCorrection(),
+// for every satellite of a receiver given in cartesian coordinates
+//------------------------------------------------------------
+int IonoModel_T :: batchTest( void )
+{
+    TestUtil test5( "IonoModel", "getCorrections", __FILE__, __LINE__ );
+    std::string assert_message = "";
+
+    double a[4] = {1.1176e-08, 7.4506e-09, -5.9605e-08, -5.9605e-08};
+    double b[4] = {9.0112e+04, 0.0, -1.9661e+05, -6.5536e+04};
+    gpstk::IonoModel Model(a,b);
+
+    gpstk::CommonTime commonTime =
+        gpstk::CivilTime(2012,3,1,13,25,7.0).convertToCommonTime();
+    gpstk::Position rxgeo(-740289.9, -5457071.7, 3207245.6,
+                          gpstk::Position::Cartesian);
+
+    std::vector<double> svel, svaz, corrections;
+    for (int i = 0; i < 360; i++)
+    {
+        svel.push_back( 5.0 + (i % 85) );
+        svaz.push_back( i );
+    }
+
+    clock_t ticks = clock();
+    for (int k = 0; k < 100; k++)
+        Model.getCorrections( commonTime, rxgeo, svel, svaz, corrections,
+                              Model.L2 );
+    double batch = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+    int differences = 0;
+    ticks = clock();
+    for (int k = 0; k < 100; k++)
+        for (size_t i = 0; i < svel.size(); i++)
+            differences += ( Model.getCorrection( commonTime, rxgeo, svel[i],
+                                                  svaz[i], Model.L2 )
+                             != corrections[i] );
+    double single = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+    assert_message = "getCorrections() differs from getCorrection()";
+    test5.assert( corrections.size() == svel.size() && differences == 0,
+                  assert_message, __LINE__ );
+
+    std::cout << "Klobuchar: " << 1.0e7*single/svel.size()
+              << " ns one by one, " << 1.0e7*batch/svel.size()
+              << " ns in batch" << std::endl;
+
+    svaz.pop_back();
+    try
+    {
+        Model.getCorrections( commonTime, rxgeo, svel, svaz, corrections );
+        assert_message = "getCorrections() accepted fewer azimuths than elevations";
+        test5.assert( false, assert_message, __LINE__ );
+    }
+    catch( gpstk::IonoModel::InvalidIonoModel& e )
+    {
+        assert_message = "getCorrections() threw an InvalidIonoModel exception as expected";
+        test5.assert( true, assert_message, __LINE__ );
+    }
+
+    return( test5.countFails() );
+}
+
 //------------------------------------------------------------
 // main()
 //------------------------------------------------------------
@@ -322,6 +389,9 @@ int main( void )
     check = testClass.exceptionTest();
     errorCounter += check;
 
+    check = testClass.batchTest();
+    errorCounter += check;
+
     std::cout << "Total Failures for " << __FILE__ << ": " << errorCounter << std::endl;
 
     return( errorCounter );
@@ -38,6 +38,7 @@
 #include "TestUtil.hpp"
 #include <iostream>
 #include <iomanip>
+#include <ctime>
 
 using namespace std;
 using namespace gpstk;
@@ -438,6 +439,77 @@ class Position_T
 		}
 		return 4 - testFramework.countTests() + testFramework.countFails(); // Sets all unrun tests as failed and adds previous errors
 	}
+
+	/*	The range, elevation and azimuth between two Cartesian
+		Positions go straight to the Triple routines. They must
+		match the results of the general path, which transforms
+		copies of the Positions. The rates of a few common
+		operations are printed. */
+	int speedTest()
+	{
+		TestUtil testFramework( "Position", "speed", __FILE__, __LINE__ );
+		std::string failMesg;
+		try
+		{
+			Position c,s,g;
+			c.setECEF(-1575232.0141,-4707872.2332, 3993198.4383);
+			s.setECEF(15600.0e3, 7540.0e3, 20140.0e3);
+			g = c;
+			g.transformTo(Position::Geodetic);
+
+			failMesg = "Does the Cartesian range match the general one?";
+			testFramework.assert(fabs(range(c,s) - range(g,s)) < eps, failMesg, __LINE__);
+			failMesg = "Does the Cartesian elevation match the general one?";
+			testFramework.assert(fabs(c.elevation(s) - g.elevation(s)) < 1e-6, failMesg, __LINE__);
+			failMesg = "Does the Cartesian azimuth match the general one?";
+			testFramework.assert(fabs(c.azimuth(s) - g.azimuth(s)) < 1e-6, failMesg, __LINE__);
+
+			const int n = 200000;
+			double sum = 0.0;
+			clock_t ticks = clock();
+			for (int i = 0; i < n; i++)
+			{
+				Position t;
+				t.setECEF(-1575232.0141 + i*1.0e-3, -4707872.2332, 3993198.4383);
+				t.transformTo(Position::Geodetic);
+				t.transformTo(Position::Cartesian);
+				sum += t.X();
+			}
+			double roundTrips = n / (double(clock()-ticks)/CLOCKS_PER_SEC);
+
+			ticks = clock();
+			for (int i = 0; i < n; i++)
+			{
+				s.setECEF(15600.0e3 + i, 7540.0e3, 20140.0e3);
+				sum += range(c,s) + c.elevation(s) + c.azimuth(s);
+			}
+			double positionGeometry = n / (double(clock()-ticks)/CLOCKS_PER_SEC);
+
+			Triple a(-1575232.0141,-4707872.2332, 3993198.4383);
+			ticks = clock();
+			for (int i = 0; i < n; i++)
+			{
+				Triple b(15600.0e3 + i, 7540.0e3, 20140.0e3);
+				sum += (b - a).mag() + a.elvAngle(b);
+			}
+			double tripleGeometry = n / (double(clock()-ticks)/CLOCKS_PER_SEC);
+
+			cout << fixed << setprecision(0)
+			     << "Per second: ECEF-geodetic-ECEF round trips " << roundTrips
+			     << ", Position range+elevation+azimuth " << positionGeometry
+			     << ", Triple range+elevation " << tripleGeometry << endl;
+
+			failMesg = "Are the sums finite?";
+			testFramework.assert(sum == sum, failMesg, __LINE__);
+			return testFramework.countFails();
+		}
+		catch(...)
+		{
+			std::cout << "Exception encountered at: " << testFramework.countTests() << std::endl;
+			std::cout << "Test method failed" << std::endl;
+		}
+		return 4 - testFramework.countTests() + testFramework.countFails(); // Sets all unrun tests as failed and adds previous errors
+	}
 };
 
 int main() //Main function to initialize and run all tests above
@@ -463,6 +535,9 @@ int main() //Main function to initialize and run all tests above
 	check = testClass.poleTransformTest();
 	errorCounter += check;
 
+	check = testClass.speedTest();
+	errorCounter += check;
+
 	std::cout << "Total Failures for " << __FILE__ << ": " << errorCounter << std::endl;
 
 	return errorCounter; //Return the total number of errors
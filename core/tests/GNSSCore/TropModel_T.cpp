@@ -1,15 +1,254 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
 #include "TestUtil.hpp"
+#include "TropModel.hpp"
+#include "CivilTime.hpp"
+
 #include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <ctime>
+
+using namespace gpstk;
+using namespace std;
 
 class TropModel_T
 {
-        public: 
-		TropModel_T(){}// Default Constructor, set the precision value
-		~TropModel_T() {} // Default Desructor
+public:
+   TropModel_T()
+   {
+         // elevations below, at and around the cutoffs of every model
+      for (double el = -5.0; el <= 90.0; el += 0.37)
+         elevations.push_back(el);
+      elevations.push_back(0.0);
+      elevations.push_back(0.0005);
+      elevations.push_back(3.0);
+      elevations.push_back(5.0);
+
+      names.push_back("Simple");
+      models.push_back(new SimpleTropModel(15.0, 1013.0, 50.0));
+      names.push_back("GG");
+      models.push_back(new GGTropModel(15.0, 1013.0, 50.0));
+      names.push_back("GGHeight");
+      models.push_back(new GGHeightTropModel(15.0, 1013.0, 50.0,
+                                             100.0, 100.0, 100.0));
+      models.back()->setReceiverHeight(250.0);
+      names.push_back("NB");
+      models.push_back(new NBTropModel(250.0, 37.5, 200));
+      names.push_back("Saas");
+      models.push_back(new SaasTropModel(-37.5, 200, 15.0, 1013.0, 50.0));
+      models.back()->setReceiverHeight(250.0);
+      names.push_back("GCAT");
+      models.push_back(new GCATTropModel(250.0));
+      names.push_back("MOPS");
+      models.push_back(new MOPSTropModel(250.0, 37.5, 200));
+      names.push_back("Neill");
+      models.push_back(new NeillTropModel(250.0, 37.5, 200));
+   }
+
+   ~TropModel_T()
+   {
+      for (size_t m = 0; m < models.size(); m++)
+         delete models[m];
+   }
+
+   int batchTest(void);
+   int epochsTest(void);
+   int invalidTest(void);
+   void timeBatch(void);
+
+   vector<double> elevations;
+   vector<string> names;
+   vector<TropModel*> models;
 };
 
 
+//------------------------------------------------------------
+// The batch of elevations gives the delays of correction(elevation)
+//------------------------------------------------------------
+int TropModel_T::batchTest(void)
+{
+   TUDEF("TropModel", "corrections");
+
+   for (size_t m = 0; m < models.size(); m++)
+   {
+      vector<double> delays;
+      models[m]->corrections(elevations, delays);
+      TUASSERTE(size_t, elevations.size(), delays.size());
+
+         // below the cutoff the delay must be exactly zero
+      double maxDiff(0.0);
+      int zeroMismatches(0);
+      for (size_t i = 0; i < elevations.size(); i++)
+      {
+         double expected(models[m]->correction(elevations[i]));
+         if (expected == 0.0)
+            zeroMismatches += (delays[i] != 0.0);
+         else
+            maxDiff = std::max(maxDiff, std::fabs(delays[i] - expected));
+      }
+      TUASSERTE(int, 0, zeroMismatches);
+      TUASSERT(maxDiff < 1.0e-12);
+   }
+
+   vector<double> none, delays(3, 1.0);
+   models[0]->corrections(none, delays);
+   TUASSERT(delays.empty());
+
+   TURETURN();
+}
+
+
+//------------------------------------------------------------
+// Epochs spanning several days are split by day of year
+//------------------------------------------------------------
+int TropModel_T::epochsTest(void)
+{
+   TUDEF("TropModel", "corrections");
+
+   NeillTropModel batch(250.0, 37.5, 1), single(250.0, 37.5, 1);
+   vector<double> elev;
+   vector<CommonTime> times;
+   CommonTime t0 = CivilTime(2012, 3, 1, 22, 0, 0.0).convertToCommonTime();
+   for (int k = 0; k < 120; k++)
+   {
+      elev.push_back(10.0 + 0.6*k);
+      times.push_back(t0 + 1800.0*k);
+   }
+
+   vector<double> delays;
+   batch.corrections(elev, times, delays);
+
+   double maxDiff(0.0);
+   for (size_t i = 0; i < elev.size(); i++)
+   {
+      single.setDayOfYear(times[i]);
+      maxDiff = std::max(maxDiff,
+                         std::fabs(delays[i] - single.correction(elev[i])));
+   }
+   TUASSERTFE(0.0, maxDiff);
+
+      // Day 61 of 2012 is 1 March; the last epoch is 2.5 days later
+   TUASSERTFE(single.correction(45.0), batch.correction(45.0));
+
+   try
+   {
+      times.pop_back();
+      batch.corrections(elev, times, delays);
+      TUFAIL("Accepted fewer time tags than elevations");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("corrections");
+   }
+
+   TURETURN();
+}
+
+
+//------------------------------------------------------------
+// An invalid model throws as correction() does
+//------------------------------------------------------------
+int TropModel_T::invalidTest(void)
+{
+   TUDEF("TropModel", "corrections");
+
+   NBTropModel nb;
+   vector<double> delays;
+   try
+   {
+      nb.corrections(elevations, delays);
+      TUFAIL("An invalid model computed delays");
+   }
+   catch (InvalidTropModel& e)
+   {
+      TUPASS("corrections");
+   }
+
+   TURETURN();
+}
+
+
+//------------------------------------------------------------
+// Time the satellites of one epoch one by one and together
+//------------------------------------------------------------
+void TropModel_T::timeBatch(void)
+{
+   const int numEpochs = 20000;
+   vector<double> elev, delays;
+   for (int k = 0; k < 12; k++)
+      elev.push_back(7.0 + 7.0*k);
+
+   for (size_t m = 0; m < models.size(); m++)
+   {
+      double sum(0.0);
+      clock_t ticks = clock();
+      for (int e = 0; e < numEpochs; e++)
+         for (size_t i = 0; i < elev.size(); i++)
+            sum += models[m]->correction(elev[i]);
+      double single = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      ticks = clock();
+      for (int e = 0; e < numEpochs; e++)
+      {
+         models[m]->corrections(elev, delays);
+         sum -= delays[0];
+      }
+      double batch = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      cout << setw(10) << names[m] << ": " << fixed << setprecision(3)
+           << 1.0e9*single/(numEpochs*elev.size()) << " ns one by one, "
+           << 1.0e9*batch/(numEpochs*elev.size()) << " ns in batch"
+           << (sum == 0.12345 ? " " : "") << endl;
+   }
+}
+
+
 int main() //Main function to initialize and run all tests above
 {
-	return 0; //Return the total number of errors
+   int errorTotal = 0;
+   TropModel_T testClass;
+
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.epochsTest();
+   errorTotal += testClass.invalidTest();
+   testClass.timeBatch();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal; //Return the total number of errors
 }
@@ -38,6 +38,7 @@
 #include "TimeString.hpp"
 #include "GPSWeekSecond.hpp"
 #include <math.h>
+#include <stdlib.h>
 #include <iostream>
 
 using namespace std;
@@ -113,6 +114,50 @@ public:
       TURETURN();
    }
 
+      /** Compare computeParity with the parity equations of
+       * IS-GPS-200 Table 20-XIV, evaluated one bit at a time, for
+       * random words. */
+   unsigned parityEquationsTest(void)
+   {
+      TUDEF("EngNav", "computeParity");
+
+         // data bits d1-d24 of each parity equation, as in the ICD
+      static const int eqns[6][15] =
+         { {  1, 2, 3, 5, 6,10,11,12,13,14,17,18,20,23, 0 },
+           {  2, 3, 4, 6, 7,11,12,13,14,15,18,19,21,24, 0 },
+           {  1, 3, 4, 5, 7, 8,12,13,14,15,16,19,20,22, 0 },
+           {  2, 4, 5, 6, 8, 9,13,14,15,16,17,20,21,23, 0 },
+           {  1, 3, 5, 6, 7, 9,10,14,15,16,17,18,21,22,24 },
+           {  3, 5, 6, 8, 9,10,11,13,15,19,22,23,24, 0, 0 } };
+         // which of D29* and D30* of the previous word enters each
+      static const int prevBit[6] = { 29, 30, 29, 30, 30, 29 };
+
+      srand(20170301);
+      unsigned wrong = 0;
+      for (int trial = 0; trial < 100000; trial++)
+      {
+         uint32_t word = ((rand() & 0x7fff) << 15) | (rand() & 0x7fff);
+         uint32_t prev = rand() & 0x3;
+         bool upright = (trial % 2) == 0;
+         uint32_t d = word;
+         if ((prev & 0x1) && !upright)
+            d = ~d;
+         uint32_t expected = 0;
+         for (int j = 0; j < 6; j++)
+         {
+            unsigned p = (prevBit[j] == 29) ? ((prev >> 1) & 1) : (prev & 1);
+            for (int k = 0; k < 15 && eqns[j][k]; k++)
+               p ^= (d >> (30 - eqns[j][k])) & 1;
+            expected = (expected << 1) | p;
+         }
+         if (gpstk::EngNav::computeParity(word, prev, upright) != expected)
+            wrong++;
+      }
+      TUASSERTE(unsigned, 0, wrong);
+
+      TURETURN();
+   }
+
    unsigned fixParityTest(void)
    {
       TUDEF("EngNav", "Fix Parity");
@@ -447,6 +492,7 @@ int main() //Main function to initialize and run all tests above
    unsigned errorTotal = 0;
 
    errorTotal += testClass.computeParityTest();
+   errorTotal += testClass.parityEquationsTest();
    errorTotal += testClass.fixParityTest();
    errorTotal += testClass.getHOWTimeTest();
    errorTotal += testClass.getSFIDTest();
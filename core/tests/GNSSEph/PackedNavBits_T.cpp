@@ -48,6 +48,9 @@
 #include "TimeString.hpp"
 #include "TimeSystem.hpp"
 
+#include <cstdlib>
+#include <ctime>
+
 using namespace std;
 using namespace gpstk;
 
@@ -61,6 +64,8 @@ public:
    unsigned abstractTest();
    unsigned realDataTest();
    unsigned equalityTest();
+   unsigned wordTest();
+   unsigned decodeTimingTest();
 
    double eps; 
 };
@@ -693,6 +698,169 @@ equalityTest()
    TURETURN();
 }
 
+   // Fields of random lengths are packed across the 64-bit word
+   // boundaries of the storage and checked against a plain bit string.
+unsigned PackedNavBits_T ::
+wordTest()
+{
+   TUDEF("PackedNavBits", "asUint64_t");
+
+   srand(12345);
+   PackedNavBits pnb;
+   std::string ref;
+   std::vector<int> starts, lengths;
+   while (ref.size() < 1200)
+   {
+      int numBits = 1 + rand() % 40;
+      unsigned long value = 0;
+      for (int i=0; i<numBits; i++)
+      {
+         int b = rand() % 2;
+         value = (value << 1) | b;
+         ref += (b ? '1' : '0');
+      }
+      starts.push_back(pnb.getNumBits());
+      lengths.push_back(numBits);
+      pnb.addUnsignedLong(value, numBits, 1);
+   }
+   pnb.trimsize();
+   TUASSERTE(size_t, ref.size(), pnb.getNumBits());
+
+   int unsignedErrors = 0, signedErrors = 0;
+   for (size_t i=0; i<starts.size(); i++)
+   {
+      unsigned long u = 0;
+      for (int k=0; k<lengths[i]; k++)
+         u = (u << 1) | (ref[starts[i]+k]=='1');
+      long l = (long) u;
+      if (ref[starts[i]]=='1')
+         l -= (long) (1UL << lengths[i]);
+      unsignedErrors += (pnb.asUnsignedLong(starts[i], lengths[i], 1) != u);
+      signedErrors += (pnb.asLong(starts[i], lengths[i], 1) != l);
+   }
+   TUASSERTE(int, 0, unsignedErrors);
+   TUASSERTE(int, 0, signedErrors);
+
+   TUCSM("asLong");
+      // A field split over three sections, two of them straddling
+      // a word boundary.
+   const unsigned startBits[] = { 60, 130, 250 };
+   const unsigned numBits[] = { 8, 3, 20 };
+   unsigned long u = 0;
+   for (int i=0; i<3; i++)
+      for (unsigned k=0; k<numBits[i]; k++)
+         u = (u << 1) | (ref[startBits[i]+k]=='1');
+   long l = (long) u;
+   if (ref[startBits[0]]=='1')
+      l -= (long) (1UL << 31);
+   TUASSERTE(unsigned long, u, pnb.asUnsignedLong(startBits, numBits, 3, 1));
+   TUASSERTE(long, l, pnb.asLong(startBits, numBits, 3, 1));
+   TUASSERTFE(l * pow(2.0,-30), pnb.asSignedDouble(startBits, numBits, 3, -30));
+
+   TUCSM("addPackedNavBits");
+   PackedNavBits joined(pnb);
+   joined.addPackedNavBits(pnb);
+   TUASSERTE(size_t, 2*ref.size(), joined.getNumBits());
+   int joinErrors = 0;
+   for (size_t i=0; i<starts.size(); i++)
+   {
+      joinErrors += ( joined.asUnsignedLong(ref.size()+starts[i], lengths[i], 1) !=
+                      pnb.asUnsignedLong(starts[i], lengths[i], 1) );
+   }
+   TUASSERTE(int, 0, joinErrors);
+
+   TUCSM("matchBits");
+   PackedNavBits changed(pnb);
+   changed.clearBits();
+   changed.addPackedNavBits(pnb);
+      // Flip bit 700 by rebuilding the object around it.
+   PackedNavBits flipped;
+   flipped.clearBits();
+   for (size_t i=0; i<ref.size(); i++)
+      flipped.addUnsignedLong((ref[i]=='1') ^ (i==700), 1, 1);
+   TUASSERT(pnb.matchBits(changed));
+   TUASSERT(!pnb.matchBits(flipped));
+   TUASSERT(pnb.matchBits(flipped, 0, 699));
+   TUASSERT(pnb.matchBits(flipped, 701, -1));
+   TUASSERT(!pnb.matchBits(flipped, 640, 767));
+   TUASSERT(!pnb.matchBits(flipped, 700, 700));
+
+   TUCSM("operator<");
+      // The ordering is strict, as needed to sort the messages
+   TUASSERT((pnb < flipped) != (flipped < pnb));
+   TUASSERT(!(pnb < changed) && !(changed < pnb));
+   TUASSERTE(bool, ref[700]=='0', pnb < flipped);
+
+   TURETURN();
+}
+
+
+   // Times the decoding of a day of CNAV message type 10 from 32 SVs
+   // (one message every 12 seconds).
+unsigned PackedNavBits_T ::
+decodeTimingTest()
+{
+   TUDEF("PackedNavBits", "decode");
+
+   SatID satID(1, SatID::systemGPS);
+   ObsID obsID(ObsID::otNavMsg, ObsID::cbL2, ObsID::tcC2LM);
+   CommonTime ct = CivilTime(2011, 6, 2, 0, 0, 0.0, TimeSystem::GPS);
+   PackedNavBits pnb(satID, obsID, ct);
+   pnb.addUnsignedLong(0x8B, 8, 1);        // Preamble
+   pnb.addUnsignedLong(1, 6, 1);           // PRN
+   pnb.addUnsignedLong(10, 6, 1);          // Message type
+   pnb.addUnsignedLong(388800, 17, 6);     // TOW count
+   pnb.addUnsignedLong(0, 1, 1);           // Alert
+   pnb.addUnsignedLong(1638, 13, 1);       // Week
+   pnb.addUnsignedLong(0, 3, 1);           // Health
+   pnb.addLong(-1, 5, 1);                  // Top
+   pnb.addLong(0, 5, 1);                   // URAoe
+   pnb.addUnsignedLong(388800, 11, 300);   // Toe
+   pnb.addSignedDouble(-1.4, 26, -9);      // deltaA
+   pnb.addSignedDouble(2.0E-5, 25, -21);   // Adot
+   pnb.addDoubleSemiCircles(4.9E-9, 17, -44);  // deltan0
+   pnb.addDoubleSemiCircles(1.0E-13, 23, -57); // deltan0dot
+   pnb.addDoubleSemiCircles(1.05, 33, -32);    // M0
+   pnb.addUnsignedDouble(1.4E-2, 33, -34);     // ecc
+   pnb.addDoubleSemiCircles(1.09, 33, -32);    // w
+   pnb.addUnsignedLong(0, 3, 1);           // Integrity, L2C phasing, reserved
+   pnb.addUnsignedLong(0, 32, 1);          // CRC, padding
+   pnb.addUnsignedLong(0, 32, 1);
+   pnb.addUnsignedLong(0, 11, 1);
+   pnb.trimsize();
+
+   const int numMessages = 32 * 7200;
+   double sum = 0.0;
+   clock_t ticks = clock();
+   for (int i=0; i<numMessages; i++)
+   {
+      sum += pnb.asUnsignedLong(14, 6, 1);
+      sum += pnb.asUnsignedLong(20, 17, 6);
+      sum += pnb.asUnsignedLong(38, 13, 1);
+      sum += pnb.asLong(54, 5, 1);
+      sum += pnb.asLong(59, 5, 1);
+      sum += pnb.asUnsignedLong(64, 11, 300);
+      sum += pnb.asSignedDouble(75, 26, -9);
+      sum += pnb.asSignedDouble(101, 25, -21);
+      sum += pnb.asDoubleSemiCircles(126, 17, -44);
+      sum += pnb.asDoubleSemiCircles(143, 23, -57);
+      sum += pnb.asDoubleSemiCircles(166, 33, -32);
+      sum += pnb.asUnsignedDouble(199, 33, -34);
+      sum += pnb.asDoubleSemiCircles(232, 33, -32);
+   }
+   double seconds = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+   TUASSERTE(unsigned long, 388800, pnb.asUnsignedLong(20, 17, 6));
+   TUASSERTE(long, -1, pnb.asLong(54, 5, 1));
+   TUASSERTFEPS(1.05, pnb.asDoubleSemiCircles(166, 33, -32), 1.0E-9);
+   TUASSERT(sum != 0.0);
+
+   cout << "decode of " << numMessages << " CNAV messages: "
+        << seconds << " s" << endl;
+
+   TURETURN();
+}
+
 int main()
 {
    unsigned errorTotal = 0;
@@ -702,6 +870,8 @@ int main()
    errorTotal += testClass.abstractTest();
    errorTotal += testClass.realDataTest();
    errorTotal += testClass.equalityTest();
+   errorTotal += testClass.wordTest();
+   errorTotal += testClass.decodeTimingTest();
 
    cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
 
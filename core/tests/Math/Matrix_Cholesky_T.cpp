@@ -86,6 +86,82 @@ void choleskyCroutTest(size_t r, size_t c,
 }
 
 
+void lltDecompTest(size_t r, size_t c,
+                   double xA[], double xB[], double xBSref[],
+                   gpstk::TestUtil& testFramework, const std::string& str)
+{
+   testFramework.changeSourceMethod(str);
+   double eps=50*DBL_EPSILON;
+   gpstk::Matrix<double> A(r,c);
+   A = xA;
+   gpstk::LLTDecomp<double> C;
+   C(A);
+
+   TUASSERTFEPS( A, C.L * transpose(C.L), eps);
+
+   gpstk::Vector<double> B(r), BSref(r);
+   B = xB;
+   BSref = xBSref;
+   C.backSub(B);
+   TUASSERTFEPS( B, BSref, eps);
+
+   gpstk::Matrix<double> Ainv;
+   C.inverse(Ainv);
+   TUASSERTFEPS( Ainv, inverse(A), eps);
+   TUASSERTFEPS( C.det(), det(A), eps*det(A));
+
+      // update, then downdate back to the original
+   gpstk::Vector<double> x(r);
+   for(size_t i=0; i<r; i++) x(i) = 1.0 + 0.5*i;
+   C.rankUpdate(x, 2.0);
+   TUASSERTFEPS( A + 2.0*outer(x,x), C.L * transpose(C.L), eps*10);
+   C.rankUpdate(x, -2.0);
+   TUASSERTFEPS( A, C.L * transpose(C.L), eps*10);
+}
+
+
+void ldltDecompTest(size_t r, size_t c,
+                    double xA[], double xB[], double xBSref[],
+                    gpstk::TestUtil& testFramework, const std::string& str)
+{
+   testFramework.changeSourceMethod(str);
+   double eps=50*DBL_EPSILON;
+   gpstk::Matrix<double> A(r,c);
+   A = xA;
+   gpstk::LDLTDecomp<double> C;
+   C(A);
+
+   gpstk::Matrix<double> L(r,c,0.0), D(r,c,0.0);
+   for(size_t j=0; j<c; j++) {
+      L(j,j) = 1.0;
+      D(j,j) = C.LD(j,j);
+      for(size_t i=j+1; i<r; i++) L(i,j) = C.LD(i,j);
+   }
+   TUASSERTFEPS( A, L * D * transpose(L), eps);
+
+   gpstk::Vector<double> B(r), BSref(r);
+   B = xB;
+   BSref = xBSref;
+   C.backSub(B);
+   TUASSERTFEPS( B, BSref, eps);
+
+   gpstk::Matrix<double> Ainv;
+   C.inverse(Ainv);
+   TUASSERTFEPS( Ainv, inverse(A), eps);
+
+      // a downdate that leaves the matrix indefinite is still factored
+   gpstk::Vector<double> x(r, 0.0);
+   x(0) = 1.0;
+   C.rankUpdate(x, -4.0);
+   for(size_t j=0; j<c; j++) {
+      D(j,j) = C.LD(j,j);
+      for(size_t i=j+1; i<r; i++) L(i,j) = C.LD(i,j);
+   }
+   TUASSERTFEPS( A - 4.0*outer(x,x), L * D * transpose(L), eps*10);
+   TUASSERT( C.LD(0,0) < 0.0 );
+}
+
+
 int main()
 {
    double a22[4] = {2,1,1,2};
@@ -110,7 +186,18 @@ int main()
    choleskyCroutTest(3, 3, a33, b3, bs3, testFramework2, "3x3");
    choleskyCroutTest(4, 4, a44, b4, bs4, testFramework2, "4x4");
 
-   unsigned tf = testFramework.countFails() + testFramework2.countFails();
+   gpstk::TestUtil testFramework3("Matrix LLTDecomp", "--", __FILE__, __LINE__);
+   lltDecompTest(2, 2, a22, b2, bs2, testFramework3, "2x2");
+   lltDecompTest(3, 3, a33, b3, bs3, testFramework3, "3x3");
+   lltDecompTest(4, 4, a44, b4, bs4, testFramework3, "4x4");
+
+   gpstk::TestUtil testFramework4("Matrix LDLTDecomp", "--", __FILE__, __LINE__);
+   ldltDecompTest(2, 2, a22, b2, bs2, testFramework4, "2x2");
+   ldltDecompTest(3, 3, a33, b3, bs3, testFramework4, "3x3");
+   ldltDecompTest(4, 4, a44, b4, bs4, testFramework4, "4x4");
+
+   unsigned tf = testFramework.countFails() + testFramework2.countFails()
+      + testFramework3.countFails() + testFramework4.countFails();
    std::cout << "Total Failures for " << __FILE__ << ": " << tf << std::endl;
 
    return tf;
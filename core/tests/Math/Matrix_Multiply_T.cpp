@@ -0,0 +1,329 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for the double precision Matrix products in
+*  gpstk/core/lib/Math/Matrix/MatrixKernels.hpp and the Matrix<double>
+*  operators built on them. The results are checked against a naive
+*  triple loop, and a timing table of the blocked product against the
+*  generic template one is printed. The largest size timed is 256 by
+*  default, or may be given as the first argument (e.g. 2000).
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+
+#include "Matrix.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   // Fill a matrix with random numbers in [-1,1].
+void randomFill(Matrix<double>& M)
+{
+   for (size_t j = 0; j < M.cols(); j++)
+      for (size_t i = 0; i < M.rows(); i++)
+         M(i,j) = 2.0*rand()/RAND_MAX - 1.0;
+}
+
+   // Element (i,j) of X, or of transpose(X).
+double elem(const Matrix<double>& X, bool trans, size_t i, size_t j)
+{ return trans ? X(j,i) : X(i,j); }
+
+   // Reference alpha*op(A)*op(B) + beta*C, with a plain triple loop.
+Matrix<double> naiveGemm(const Matrix<double>& A, const Matrix<double>& B,
+                         const Matrix<double>& C, double alpha, double beta,
+                         bool transA, bool transB)
+{
+   size_t m(transA ? A.cols() : A.rows()), k(transA ? A.rows() : A.cols()),
+          n(transB ? B.rows() : B.cols());
+   Matrix<double> R(m, n);
+   for (size_t i = 0; i < m; i++)
+      for (size_t j = 0; j < n; j++)
+      {
+         long double sum(0.0);
+         for (size_t p = 0; p < k; p++)
+            sum += elem(A,transA,i,p) * elem(B,transB,p,j);
+         R(i,j) = alpha*sum + beta*C(i,j);
+      }
+   return R;
+}
+
+
+class Matrix_Multiply_T
+{
+public:
+   Matrix_Multiply_T(size_t max) : maxSize(max), eps(1.e-12)
+   { srand(27182); }
+
+   unsigned gemmTest();
+   unsigned gemvTest();
+   unsigned syrkTest();
+   unsigned operatorTest();
+   void timing();
+
+   size_t maxSize;
+   double eps;
+};
+
+
+unsigned Matrix_Multiply_T::gemmTest()
+{
+   TUDEF("MatrixKernels", "gemm");
+
+      // shapes chosen to cover the unblocked path, partial micro tiles,
+      // and more than one cache block along each dimension
+   size_t shapes[][3] = { {1,1,1}, {3,3,3}, {4,5,6}, {7,3,9}, {33,17,29},
+                          {100,101,99}, {130,61,300} };
+   size_t numShapes = sizeof(shapes)/sizeof(shapes[0]);
+
+   for (size_t s = 0; s < numShapes; s++)
+   {
+      size_t m(shapes[s][0]), n(shapes[s][1]), k(shapes[s][2]);
+      for (int t = 0; t < 4; t++)
+      {
+         bool transA(t & 1), transB(t & 2);
+         Matrix<double> A(transA ? k : m, transA ? m : k),
+                        B(transB ? n : k, transB ? k : n), C(m, n);
+         randomFill(A);
+         randomFill(B);
+         randomFill(C);
+
+            // accumulate into an existing C
+         Matrix<double> ref(naiveGemm(A, B, C, 1.5, -0.5, transA, transB));
+         gemm(C, A, B, 1.5, -0.5, transA, transB);
+         TUASSERTFEPS(ref, C, eps);
+
+            // overwrite a C of the wrong size
+         Matrix<double> D(2, 2, 99.0);
+         ref = naiveGemm(A, B, C, 1.0, 0.0, transA, transB);
+         gemm(D, A, B, 1.0, 0.0, transA, transB);
+         TUASSERTFEPS(ref, D, eps);
+      }
+   }
+
+      // an empty inner dimension gives beta*C
+   Matrix<double> A(3, 0), B(0, 4), C(3, 4, 2.0), ref(3, 4, 1.0);
+   gemm(C, A, B, 1.0, 0.5);
+   TUASSERTFEPS(ref, C, eps);
+
+      // dimension errors and aliasing are rejected
+   Matrix<double> E(3, 3, 1.0), F(4, 4, 1.0);
+   try { gemm(E, E, F); TUFAIL("Incompatible dimensions were accepted"); }
+   catch (MatrixException& e) { TUPASS("Incompatible dimensions"); }
+   try { gemm(E, E, E); TUFAIL("Aliased output was accepted"); }
+   catch (MatrixException& e) { TUPASS("Aliased output"); }
+   try { gemm(F, E, E, 1.0, 1.0); TUFAIL("Wrong size C was accumulated"); }
+   catch (MatrixException& e) { TUPASS("Wrong size accumulate"); }
+
+   TURETURN();
+}
+
+
+unsigned Matrix_Multiply_T::gemvTest()
+{
+   TUDEF("MatrixKernels", "gemv");
+
+   size_t shapes[][2] = { {1,1}, {3,4}, {9,2}, {12,5}, {77,130} };
+   size_t numShapes = sizeof(shapes)/sizeof(shapes[0]);
+
+   for (size_t s = 0; s < numShapes; s++)
+   {
+      for (int trans = 0; trans < 2; trans++)
+      {
+         size_t m(shapes[s][0]), n(shapes[s][1]);
+         Matrix<double> A(m, n), X(trans ? m : n, 1), Y(trans ? n : m, 1);
+         randomFill(A);
+         randomFill(X);
+         randomFill(Y);
+         Vector<double> x(X.colCopy(0)), y(Y.colCopy(0));
+
+         Vector<double> ref(naiveGemm(A, X, Y, 2.0, 0.25, trans, false)
+                            .colCopy(0));
+         gemv(y, A, x, 2.0, 0.25, trans);
+         TUASSERTFEPS(ref, y, eps);
+
+         Vector<double> z;
+         ref = naiveGemm(A, X, Y, 1.0, 0.0, trans, false).colCopy(0);
+         gemv(z, A, x, 1.0, 0.0, trans);
+         TUASSERTFEPS(ref, z, eps);
+      }
+   }
+
+   Matrix<double> A(3, 4, 1.0);
+   Vector<double> x(3, 1.0), y;
+   try { gemv(y, A, x); TUFAIL("Incompatible dimensions were accepted"); }
+   catch (MatrixException& e) { TUPASS("Incompatible dimensions"); }
+
+   TURETURN();
+}
+
+
+unsigned Matrix_Multiply_T::syrkTest()
+{
+   TUDEF("MatrixKernels", "syrk");
+
+   size_t shapes[][2] = { {1,1}, {4,12}, {5,3}, {70,40}, {150,90} };
+   size_t numShapes = sizeof(shapes)/sizeof(shapes[0]);
+
+   for (size_t s = 0; s < numShapes; s++)
+   {
+      for (int trans = 0; trans < 2; trans++)
+      {
+         size_t n(shapes[s][0]), k(shapes[s][1]);
+         Matrix<double> A(trans ? k : n, trans ? n : k), C(n, n);
+         randomFill(A);
+         randomFill(C);
+         C = C + transpose(C);
+
+         Matrix<double> ref(naiveGemm(A, A, C, 0.5, 2.0, trans, !trans));
+         syrk(C, A, 0.5, 2.0, trans);
+         TUASSERTFEPS(ref, C, eps);
+
+            // the result must be exactly symmetric
+         bool symmetric(true);
+         for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < i; j++)
+               symmetric = symmetric && (C(i,j) == C(j,i));
+         TUASSERT(symmetric);
+
+         Matrix<double> N;
+         ref = naiveGemm(A, A, C, 1.0, 0.0, trans, !trans);
+         syrk(N, A, 1.0, 0.0, trans);
+         TUASSERTFEPS(ref, N, eps);
+      }
+   }
+
+   TURETURN();
+}
+
+
+unsigned Matrix_Multiply_T::operatorTest()
+{
+   TUDEF("Matrix", "operator*");
+
+   Matrix<double> A(37, 41), B(41, 29), X(41, 1), Y(37, 1), Z(37, 29);
+   randomFill(A);
+   randomFill(B);
+   randomFill(X);
+   randomFill(Y);
+
+   TUASSERTFEPS(naiveGemm(A, B, Z, 1.0, 0.0, false, false), A * B, eps);
+
+   Vector<double> x(X.colCopy(0)), y(Y.colCopy(0));
+   TUASSERTFEPS(naiveGemm(A, X, Y, 1.0, 0.0, false, false).colCopy(0),
+                A * x, eps);
+   TUASSERTFEPS(naiveGemm(A, Y, X, 1.0, 0.0, true, false).colCopy(0),
+                y * A, eps);
+
+      // the double precision operators agree with the generic ones
+   TUASSERTFEPS(A * B, MatrixSlice<double>(A, 0, 0, 37, 41) * B, eps);
+   TUASSERTFEPS(A * x, MatrixSlice<double>(A, 0, 0, 37, 41) * x, eps);
+
+   try { B * A; TUFAIL("Incompatible dimensions were accepted"); }
+   catch (MatrixException& e) { TUPASS("Incompatible dimensions"); }
+
+   TURETURN();
+}
+
+
+void Matrix_Multiply_T::timing()
+{
+   size_t sizes[] = { 3, 4, 6, 8, 12, 16, 32, 64, 128, 256, 512, 1000, 2000 };
+   size_t numSizes = sizeof(sizes)/sizeof(sizes[0]);
+
+   cout << "Matrix<double> product, n x n times n x n" << endl
+        << setw(6) << "n" << setw(16) << "generic us" << setw(16)
+        << "blocked us" << setw(12) << "GFLOP/s" << setw(10) << "speedup"
+        << endl;
+
+   for (size_t s = 0; s < numSizes && sizes[s] <= maxSize; s++)
+   {
+      size_t n(sizes[s]);
+      double flops(2.0*n*n*n);
+      int reps = int(2.e8/flops) + 1;
+
+      Matrix<double> A(n, n), B(n, n), C(n, n);
+      randomFill(A);
+      randomFill(B);
+
+      clock_t start = clock();
+      for (int r = 0; r < reps; r++)
+         gemm(C, A, B);
+      double blocked = double(clock() - start)/CLOCKS_PER_SEC/reps;
+
+         // the generic template is very slow for large sizes
+      double generic(0.0);
+      if (n <= 512)
+      {
+         MatrixSlice<double> As(A, 0, 0, n, n);
+         start = clock();
+         for (int r = 0; r < reps; r++)
+            C = As * B;
+         generic = double(clock() - start)/CLOCKS_PER_SEC/reps;
+      }
+
+      cout << setw(6) << n << fixed << setprecision(3)
+           << setw(16) << 1.e6*generic << setw(16) << 1.e6*blocked
+           << setw(12) << setprecision(2)
+           << (blocked > 0.0 ? 1.e-9*flops/blocked : 0.0)
+           << setw(10) << setprecision(1)
+           << (blocked > 0.0 && generic > 0.0 ? generic/blocked : 0.0)
+           << endl;
+   }
+}
+
+
+int main(int argc, char *argv[])
+{
+   unsigned errorTotal = 0;
+   Matrix_Multiply_T testClass(argc > 1 ? atoi(argv[1]) : 256);
+
+   errorTotal += testClass.gemmTest();
+   errorTotal += testClass.gemvTest();
+   errorTotal += testClass.syrkTest();
+   errorTotal += testClass.operatorTest();
+   testClass.timing();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,330 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for the storage of gpstk::Vector and gpstk::Matrix:
+*  small objects kept inside the object, copies, moves, and reuse of
+*  temporaries by the arithmetic operators, and the lazy vector
+*  expressions. Allocations are counted by replacing the global
+*  operator new, and the objects of a type with a constructor by the
+*  type itself.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+
+#include "Matrix.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+static unsigned long allocCount = 0;
+
+   /// A type with a constructor, counting its objects
+class Counted
+{
+public:
+   Counted() : x(0.0) { ++count; }
+   Counted(const Counted& c) : x(c.x) { ++count; }
+   ~Counted() { --count; }
+   Counted& operator=(const Counted& c) { x = c.x; return *this; }
+   double x;
+   static long count;
+};
+
+long Counted::count = 0;
+
+   /// Only takes a Vector, so the operators must return one
+template <class T>
+T firstElement(const Vector<T>& v)
+{ return v[0]; }
+
+void* operator new(size_t size)
+{
+   ++allocCount;
+   void *p = malloc(size ? size : 1);
+   if (!p) throw std::bad_alloc();
+   return p;
+}
+
+void* operator new[](size_t size)
+{
+   ++allocCount;
+   void *p = malloc(size ? size : 1);
+   if (!p) throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) throw()
+{ free(p); }
+
+void operator delete[](void* p) throw()
+{ free(p); }
+
+
+class Matrix_Storage_T
+{
+public:
+   unsigned vectorTest();
+   unsigned matrixTest();
+   unsigned temporaryTest();
+};
+
+
+unsigned Matrix_Storage_T::vectorTest()
+{
+   TUDEF("Vector", "storage");
+
+      // small vectors don't allocate
+   unsigned long before = allocCount;
+   Vector<double> a(3, 1.0), b(3), c(6, 2.0);
+   b[0] = 1.0; b[1] = 2.0; b[2] = 3.0;
+   Vector<double> d(b), e;
+   e = a;
+   Vector<double> f = a + b * 2.0 - d;
+   unsigned long allocs = allocCount - before;
+   TUASSERTE(unsigned long, 0, allocs);
+   TUASSERTFE(2.0, f[0]);
+   TUASSERTFE(3.0, f[1]);
+   TUASSERTFE(4.0, f[2]);
+   TUASSERTFE(2.0, firstElement(a + b * 2.0 - d));
+   TUASSERTE(size_t, 3, e.size());
+   TUASSERTFE(1.0, e[2]);
+
+      // large vectors do, and grow as before
+   before = allocCount;
+   Vector<double> g(100, 3.0);
+   g.resize(4);
+   size_t cap = g.capacity();
+   g.resize(50, 1.0);
+   allocs = allocCount - before;
+   TUASSERTE(unsigned long, 1, allocs);
+   TUASSERTE(size_t, 100, cap);
+   TUASSERTFE(1.0, g[49]);
+
+      // copies of large and small vectors are independent
+   Vector<double> h(g);
+   h[0] = 7.0;
+   TUASSERTFE(1.0, g[0]);
+   a = g;
+   TUASSERTE(size_t, 50, a.size());
+   a = b;
+   TUASSERTE(size_t, 3, a.size());
+   TUASSERTFE(3.0, a[2]);
+   a = a;
+   TUASSERTFE(3.0, a[2]);
+
+      // subvectors, in and out of the local storage
+   Vector<double> sub(g, 45, 5), sub2(g, 0, 40);
+   TUASSERTE(size_t, 5, sub.size());
+   TUASSERTE(size_t, 40, sub2.size());
+   TUASSERTFE(1.0, sub2[39]);
+
+#if __cplusplus >= 201103L
+      // moves take over the heap storage
+   before = allocCount;
+   Vector<double> m(std::move(g));
+   size_t moved = g.size();
+   g = std::move(m);
+      // ... or copy the local one
+   Vector<double> n(std::move(b));
+   m = std::move(n);
+   allocs = allocCount - before;
+   TUASSERTE(unsigned long, 0, allocs);
+   TUASSERTE(size_t, 0, moved);
+   TUASSERTE(size_t, 50, g.size());
+   TUASSERTFE(1.0, g[10]);
+   TUASSERTE(size_t, 3, m.size());
+   TUASSERTFE(2.0, m[1]);
+#endif
+
+   TURETURN();
+}
+
+
+unsigned Matrix_Storage_T::matrixTest()
+{
+   TUDEF("Matrix", "storage");
+
+      // 3x3 matrices don't allocate
+   unsigned long before = allocCount;
+   Matrix<double> R(3, 3, 0.0);
+   R(0,1) = 1.0; R(1,0) = -1.0; R(2,2) = 1.0;
+   Matrix<double> RT(transpose(R)), S(R);
+   S = R * RT;
+   Vector<double> x(3, 1.0), y(R * x);
+   unsigned long allocs = allocCount - before;
+   TUASSERTE(unsigned long, 0, allocs);
+   TUASSERTE(int, 9, Matrix<double>::MATRIX_INLINE_SIZE);
+   TUASSERTFE(1.0, S(0,0));
+   TUASSERTFE(0.0, S(0,1));
+   TUASSERTFE(1.0, y[0]);
+   TUASSERTFE(-1.0, y[1]);
+
+      // larger ones allocate once, and reuse their storage when shrunk
+   before = allocCount;
+   Matrix<double> Phi(6, 6, 0.0);
+   for (size_t i = 0; i < 6; i++)
+      Phi(i,i) = 2.0;
+   Matrix<double> P2(Phi * Phi);
+   allocs = allocCount - before;
+#if __cplusplus >= 201103L
+   TUASSERTE(unsigned long, 2, allocs);
+#endif
+   TUASSERTFE(4.0, P2(5,5));
+   before = allocCount;
+   Matrix<double> L(10, 10, 1.0);
+   L.resize(2, 20);
+   L.resize(7, 7, 2.0);
+   allocs = allocCount - before;
+   TUASSERTE(unsigned long, 1, allocs);
+   TUASSERTE(size_t, 100, L.capacity());
+   TUASSERTFE(2.0, L(6,6));
+
+      // copies are independent
+   Matrix<double> C(L);
+   C(0,0) = 5.0;
+   TUASSERTFE(2.0, L(0,0));
+   R = L;
+   TUASSERTE(size_t, 7, R.rows());
+   TUASSERTFE(2.0, R(6,6));
+   R = S;
+   TUASSERTE(size_t, 3, R.cols());
+   R = R;
+   TUASSERTFE(1.0, R(2,2));
+
+#if __cplusplus >= 201103L
+   before = allocCount;
+   Matrix<double> M(std::move(L));
+   size_t moved = L.size();
+   L = std::move(M);
+   Matrix<double> N(std::move(Phi));
+   allocs = allocCount - before;
+   TUASSERTE(unsigned long, 0, allocs);
+   TUASSERTE(size_t, 0, moved);
+   TUASSERTE(size_t, 7, L.rows());
+   TUASSERTFE(2.0, L(3,3));
+   TUASSERTFE(2.0, N(5,5));
+#endif
+
+      // types with a constructor are never kept inside, so only the
+      // elements in use are constructed
+   {
+      Vector<Counted> vc(2);
+      Matrix<Counted> mc(2, 2);
+      Vector<Counted> vc2(vc);
+      TUASSERTE(long, 8, Counted::count);
+      TUASSERTE(int, 0, Matrix<Counted>::MATRIX_INLINE_SIZE);
+   }
+   TUASSERTE(long, 0, Counted::count);
+
+   TURETURN();
+}
+
+
+unsigned Matrix_Storage_T::temporaryTest()
+{
+   TUDEF("Vector", "operators");
+
+   size_t n(40);
+   Vector<double> a(n, 1.0), b(n, 2.0), c(n, 3.0);
+   Matrix<double> A(n, n, 1.0), B(n, n, 2.0);
+
+      // lazy vector expressions are computed in one pass into the result
+   unsigned long before = allocCount;
+   Vector<double> v = lazy(a) * 2.0 + b - lazy(c) / 3.0;
+   unsigned long allocs = allocCount - before;
+   TUASSERTE(unsigned long, 1, allocs);
+   TUASSERTFE(3.0, v[n-1]);
+   Vector<double> u = a * 2.0 + b - c / 3.0;
+   TUASSERTFE(0.0, norm(u - v));
+   before = allocCount;
+   v = 0.5 * (lazy(v) + lazy(a) * (lazy(b) - 1.0)) / 2.0;
+   v += lazy(a) * b;
+   allocs = allocCount - before;
+   TUASSERTE(unsigned long, 0, allocs);
+   TUASSERTFE(3.0, v[0]);
+   TUASSERTFE(2.0, norm(v - a) / SQRT(double(n)));
+
+   before = allocCount;
+   Matrix<double> M = 2.0 * (A * B) + A - B;
+   allocs = allocCount - before;
+#if __cplusplus >= 201103L
+      // only A*B allocates; the rest of the operations reuse it
+   TUASSERTE(unsigned long, 1, allocs);
+#endif
+   TUASSERTFE(2.0*2.0*n - 1.0, M(n-1,0));
+
+      // both operands are temporaries
+   Vector<double> w = (a + b) - (b * 2.0);
+   Matrix<double> D = (A + B) - (B * 2.0);
+   TUASSERTFE(-1.0, w[0]);
+   TUASSERTFE(-1.0, D(1,2));
+
+      // the temporary is the right hand operand
+   w = a - (b * 3.0);
+   D = A - (B * 3.0);
+   TUASSERTFE(-5.0, w[3]);
+   TUASSERTFE(-5.0, D(3,3));
+
+      // dimension errors are still caught
+   try { w = (a + a) + Vector<double>(n+1, 0.0); TUFAIL("No exception"); }
+   catch (VectorException& e) { TUPASS("Unequal lengths"); }
+   try { w = lazy(a) + Vector<double>(n+1, 0.0); TUFAIL("No exception"); }
+   catch (VectorException& e) { TUPASS("Unequal lengths"); }
+   try { D = (A + A) - Matrix<double>(n, n+1, 0.0); TUFAIL("No exception"); }
+   catch (MatrixException& e) { TUPASS("Incompatible dimensions"); }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Matrix_Storage_T testClass;
+
+   errorTotal += testClass.vectorTest();
+   errorTotal += testClass.matrixTest();
+   errorTotal += testClass.temporaryTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,184 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for the fixed size gpstk::Vec3 and gpstk::Mat3.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <cmath>
+
+#include "Mat3.hpp"
+#include "Triple.hpp"
+#include "GNSSconstants.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+class Vec3_T
+{
+public:
+   unsigned vec3Test();
+   unsigned mat3Test();
+   unsigned constexprTest();
+};
+
+
+unsigned Vec3_T::vec3Test()
+{
+   TUDEF("Vec3", "operators");
+
+   Vec3<double> zero, a(1.0, 2.0, 3.0), b(2.0, 2.0, 2.0);
+   TUASSERTE(size_t, 3, zero.size());
+   TUASSERTFE(0.0, zero[2]);
+   TUASSERTFE(12.0, a.dot(b));
+   TUASSERTFE(12.0, dot(b, a));
+   Vec3<double> c = cross(a, b);
+   TUASSERTFE(-2.0, c[0]);
+   TUASSERTFE(4.0, c[1]);
+   TUASSERTFE(-2.0, c[2]);
+   TUASSERTFE(5.0, Vec3<double>(3.0, 0.0, -4.0).norm());
+
+   Vec3<double> d = 2.0 * a - b / 2.0 + (-a);
+   TUASSERT(d == Vec3<double>(0.0, 1.0, 2.0));
+   d += a;
+   d -= b;
+   d *= 2.0;
+   d /= 4.0;
+   TUASSERT(d == Vec3<double>(-0.5, 0.5, 1.5));
+   TUASSERT(d != a);
+   d(1) = 7.0;
+   TUASSERTFE(7.0, d.data()[1]);
+
+      // agrees with Triple
+   Triple t(a[0], a[1], a[2]), u(b[0], b[1], b[2]);
+   TUASSERTFE(t.cross(u)[0], c[0]);
+   TUASSERTFE(t.slantRange(u), (b - a).norm());
+
+   TURETURN();
+}
+
+
+unsigned Vec3_T::mat3Test()
+{
+   TUDEF("Mat3", "operators");
+
+   double eps = 1e-14;
+   Mat3<double> I = Mat3<double>::identity();
+   Mat3<double> A(1.0, 2.0, 3.0,
+                  4.0, 5.0, 6.0,
+                  7.0, 8.0, 10.0);
+   Vec3<double> x(1.0, -1.0, 2.0);
+
+   TUASSERTFE(6.0, A(1,2));
+   TUASSERT(A.row(2) == Vec3<double>(7.0, 8.0, 10.0));
+   TUASSERT(A.col(1) == Vec3<double>(2.0, 5.0, 8.0));
+   TUASSERT(A * I == A);
+   TUASSERT(I * A == A);
+   TUASSERT(A.transpose().transpose() == A);
+   TUASSERT(A * x == Vec3<double>(5.0, 11.0, 19.0));
+   TUASSERT(A.transposeTimes(x) == A.transpose() * x);
+
+   Mat3<double> AA = A * A;
+   TUASSERTFE(1.0*1.0 + 2.0*4.0 + 3.0*7.0, AA(0,0));
+   TUASSERTFE(1.0*3.0 + 2.0*6.0 + 3.0*10.0, AA(0,2));
+   TUASSERTFE(7.0*1.0 + 8.0*4.0 + 10.0*7.0, AA(2,0));
+   TUASSERT((A + A) - A == A);
+   TUASSERT(2.0 * A == A + A);
+
+      // The elementary rotations agree with those of Triple, and are
+      // orthonormal
+   double angle(37.0);
+   Triple t(x[0], x[1], x[2]);
+   Mat3<double> R1 = Mat3<double>::R1(angle*DEG_TO_RAD);
+   Mat3<double> R2 = Mat3<double>::R2(angle*DEG_TO_RAD);
+   Mat3<double> R3 = Mat3<double>::R3(angle*DEG_TO_RAD);
+   for (size_t i = 0; i < 3; i++)
+   {
+      TUASSERTFEPS(t.R1(angle)[i], (R1*x)[i], eps);
+      TUASSERTFEPS(t.R2(angle)[i], (R2*x)[i], eps);
+      TUASSERTFEPS(t.R3(angle)[i], (R3*x)[i], eps);
+   }
+   Mat3<double> R = R3 * R2 * R1, RRT = R * R.transpose();
+   Vec3<double> back = R.transposeTimes(R * x);
+   for (size_t i = 0; i < 3; i++)
+   {
+      TUASSERTFEPS(x[i], back[i], eps);
+      for (size_t j = 0; j < 3; j++)
+         TUASSERTFEPS(I(i,j), RRT(i,j), eps);
+   }
+
+   TURETURN();
+}
+
+
+unsigned Vec3_T::constexprTest()
+{
+   TUDEF("Vec3", "constexpr");
+
+#if __cplusplus >= 201103L
+   constexpr Vec3<double> a(1.0, 2.0, 3.0), b(4.0, 5.0, 6.0);
+   constexpr Vec3<double> c = cross(a, b);
+   constexpr Mat3<double> I = Mat3<double>::identity();
+   constexpr Vec3<double> d = I * (2.0 * a) - b;
+   static_assert(a.dot(b) == 32.0, "Vec3 dot");
+   static_assert(c[0] == -3.0 && c[1] == 6.0 && c[2] == -3.0, "Vec3 cross");
+   static_assert(d == Vec3<double>(-2.0, -1.0, 0.0), "Mat3 product");
+   static_assert(I.transpose() * I == I, "Mat3 transpose");
+   TUPASS("compile time evaluation");
+#else
+   TUPASS("constexpr requires C++11");
+#endif
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Vec3_T testClass;
+
+   errorTotal += testClass.vec3Test();
+   errorTotal += testClass.mat3Test();
+   errorTotal += testClass.constexprTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -42,8 +42,10 @@
 #include "LNavEmptyFilter.hpp"
 #include "LNavTLMHOWFilter.hpp"
 #include "LNavEphMaker.hpp"
+#include "LNavCrossSourceFilter.hpp"
 #include "CommonTime.hpp"
 #include "TimeString.hpp"
+#include <ctime>
 
 using namespace std;
 using namespace gpstk;
@@ -64,6 +66,68 @@ unsigned long expLNavCombined = 1488;
 // /usr/bin/tail +109 test_input_NavFilterMgr.txt | head -27513 | grep ':[03]0.0, ' | wc -l
 unsigned long expLNavEphs = 5210;
 
+// The voting of LNavCrossSourceFilter as it was first written, with a
+// map of subframes for each PRN, used as a reference.
+class MapCrossSourceFilter : public NavFilter
+{
+public:
+   typedef std::map<LNavFilterData*, NavMsgList, LNavMsgSort> SubframeMap;
+   typedef std::map<uint32_t, SubframeMap> NavMap;
+
+   virtual void validate(NavMsgList& msgBitsIn, NavMsgList& msgBitsOut)
+   {
+      NavMsgList::const_iterator nmli;
+      for (nmli = msgBitsIn.begin(); nmli != msgBitsIn.end(); nmli++)
+      {
+         LNavFilterData *fd = dynamic_cast<LNavFilterData*>(*nmli);
+         if (fd->timeStamp != currentTime)
+         {
+            examineSubframes(msgBitsOut);
+            groupedNav.clear();
+            currentTime = fd->timeStamp;
+         }
+         groupedNav[fd->prn][fd].push_back(*nmli);
+      }
+   }
+   virtual void finalize(NavMsgList& msgBitsOut)
+   {
+      examineSubframes(msgBitsOut);
+      groupedNav.clear();
+      currentTime.reset();
+   }
+   void examineSubframes(NavMsgList& msgBitsOut)
+   {
+      NavMap::const_iterator nmi;
+      SubframeMap::const_iterator smi;
+      for (nmi = groupedNav.begin(); nmi != groupedNav.end(); nmi++)
+      {
+         size_t msgCount = 0, voteCount = 0;
+         LNavFilterData *winner = NULL;
+         for (smi = nmi->second.begin(); smi != nmi->second.end(); smi++)
+         {
+            size_t msgs = smi->second.size();
+            msgCount += msgs;
+            if ((msgs > voteCount) && (msgs >= 2))
+            {
+               voteCount = msgs;
+               winner = smi->first;
+            }
+         }
+         if (msgCount < 3)
+            winner = NULL;
+         for (smi = nmi->second.begin(); smi != nmi->second.end(); smi++)
+         {
+            if (smi->first == winner)
+               accept(smi->second, msgBitsOut);
+            else
+               reject(smi->second);
+         }
+      }
+   }
+   NavMap groupedNav;
+   CommonTime currentTime;
+};
+
 // define some classes for exercising NavFilterMgr
 class BunkFilterData : public NavFilterKey
 {
@@ -140,6 +204,10 @@ public:
    unsigned testLNavEphMaker();
       /// Test the combination of parity, empty and TLM/HOW filters
    unsigned testLNavCombined();
+      /// Time the combination of parity, empty and TLM/HOW filters
+   unsigned timeLNavCombined();
+      /// Test and time the cross-source filter with many receivers
+   unsigned testLNavCrossSource();
 
       /// test a simple bit pattern filter
    unsigned testBunk1();
@@ -231,6 +299,7 @@ loadData()
          wordStr = gpstk::StringUtils::word(line, strWord, ',');
          subframesLNAV[subframeIdx++] = gpstk::StringUtils::x2uint(wordStr);
       }
+      tmp.timeStamp = recTime;
       tmp.prn = gpstk::StringUtils::asUnsigned(
          gpstk::StringUtils::word(line, 2, ','));
          // note that the test file contents use enums that probably
@@ -529,6 +598,123 @@ testLNavCombined()
 }
 
 
+unsigned NavFilterMgr_T ::
+timeLNavCombined()
+{
+   TUDEF("NavFilterMgr", "validate");
+
+   NavFilterMgr mgr;
+   unsigned long rejectCount = 0;
+   LNavParityFilter filtParity;
+   LNavEmptyFilter filtEmpty;
+   LNavTLMHOWFilter filtTLMHOW;
+
+   mgr.addFilter(&filtParity);
+   mgr.addFilter(&filtEmpty);
+   mgr.addFilter(&filtTLMHOW);
+
+   const unsigned numPasses = 20;
+   clock_t ticks = clock();
+   for (unsigned pass = 0; pass < numPasses; pass++)
+   {
+      for (unsigned i = 0; i < dataIdxLNAV; i++)
+      {
+         gpstk::NavFilter::NavMsgList l = mgr.validate(&dataLNAV[i]);
+         rejectCount += l.empty();
+      }
+   }
+   double seconds = double(clock()-ticks)/CLOCKS_PER_SEC;
+   TUASSERTE(unsigned long, numPasses*expLNavCombined, rejectCount);
+
+   cout << "parity, empty and TLM/HOW filters: " << fixed
+        << setprecision(0) << (numPasses*dataIdxLNAV/seconds)
+        << " subframes/s" << endl;
+
+   return testFramework.countFails();
+}
+
+
+// Each subframe of the input file is received by numRx receivers, of
+// which a few get one bit wrong, and the epochs are given to the
+// cross-source filter in batches.  The output is compared with the
+// reference (map based) version of the filter.
+unsigned NavFilterMgr_T ::
+testLNavCrossSource()
+{
+   TUDEF("LNavCrossSourceFilter", "validate");
+
+   const unsigned numRx = 64;
+   NavFilterMgr mgr, refMgr;
+   LNavCrossSourceFilter filtVote;
+   MapCrossSourceFilter refVote;
+   mgr.addFilter(&filtVote);
+   refMgr.addFilter(&refVote);
+
+      // messages and subframe words for two epochs, as the filter
+      // holds on to the previous epoch
+   vector<LNavFilterData> msgs[2];
+   vector<uint32_t> words[2];
+   vector<NavFilterKey*> batch;
+   gpstk::NavFilter::NavMsgList l, refl;
+   unsigned long numMsgs = 0, numAccepted = 0, differences = 0;
+   double seconds = 0, refSeconds = 0;
+   clock_t ticks;
+   unsigned epoch = 0;
+
+   for (unsigned begin = 0, end; begin < dataIdxLNAV; begin = end, epoch++)
+   {
+      for (end = begin+1; end < dataIdxLNAV; end++)
+      {
+         if (dataLNAV[end].timeStamp != dataLNAV[begin].timeStamp)
+            break;
+      }
+      vector<LNavFilterData>& m(msgs[epoch % 2]);
+      vector<uint32_t>& w(words[epoch % 2]);
+      m.resize((end-begin)*numRx);
+      w.resize((end-begin)*numRx*10);
+      batch.clear();
+      for (unsigned i = begin; i < end; i++)
+      {
+         for (unsigned rx = 0; rx < numRx; rx++)
+         {
+            unsigned k = (i-begin)*numRx + rx;
+            m[k] = dataLNAV[i];
+            m[k].sf = &w[k*10];
+            std::copy(dataLNAV[i].sf, dataLNAV[i].sf+10, m[k].sf);
+            if ((i + 7*rx) % 13 == 0)
+               m[k].sf[3 + rx%5] ^= 0x100 << (rx%16);
+            batch.push_back(&m[k]);
+         }
+      }
+      numMsgs += batch.size();
+
+      ticks = clock();
+      l = mgr.validate(batch);
+      seconds += double(clock()-ticks)/CLOCKS_PER_SEC;
+      ticks = clock();
+      refl = refMgr.validate(batch);
+      refSeconds += double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      numAccepted += l.size();
+      differences += (l != refl) || (filtVote.rejected != refVote.rejected);
+   }
+   l = mgr.finalize();
+   refl = refMgr.finalize();
+   numAccepted += l.size();
+   differences += (l != refl) || (filtVote.rejected != refVote.rejected);
+
+   TUASSERTE(unsigned long, 0, differences);
+   TUASSERT(numAccepted > numMsgs*8/10);
+   TUASSERT(numAccepted < numMsgs);
+
+   cout << "cross-source vote over " << numRx << " receivers, "
+        << numMsgs << " subframes: " << setprecision(3) << seconds
+        << " s (map version " << refSeconds << " s)" << endl;
+
+   return testFramework.countFails();
+}
+
+
 unsigned NavFilterMgr_T ::
 testBunk1()
 {
@@ -662,6 +848,8 @@ int main()
    errorTotal += testClass.testLNavTLMHOW();
    errorTotal += testClass.testLNavEphMaker();
    errorTotal += testClass.testLNavCombined();
+   errorTotal += testClass.timeLNavCombined();
+   errorTotal += testClass.testLNavCrossSource();
    errorTotal += testClass.testBunk1();
    errorTotal += testClass.testBunk2();
 
@@ -0,0 +1,217 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+
+/*********************************************************************
+*
+*  Test program for gpstk/core/lib/PosSol/PRSolution. RAIM solutions
+*  computed with the screening of the satellite subsets are compared
+*  with those of the exhaustive search, on real data with ranges
+*  biased to force rejections.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <ctime>
+
+#include "PRSolution.hpp"
+#include "Rinex3EphemerisStore.hpp"
+#include "Rinex3ObsStream.hpp"
+#include "Rinex3ObsHeader.hpp"
+#include "Rinex3ObsData.hpp"
+#include "TropModel.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+class PRSolution_T
+{
+public:
+
+      /// One epoch of GPS C1 pseudoranges.
+   struct Epoch
+   {
+      CommonTime time;
+      vector<SatID> sats;
+      vector<double> ranges;
+   };
+
+   PRSolution_T()
+   {
+      string path(getPathData() + "/");
+      eph.loadFile(path + "arlm200a.15n");
+
+      Rinex3ObsStream strm((path + "arlm200a.15o").c_str());
+      Rinex3ObsHeader head;
+      Rinex3ObsData data;
+      strm >> head;
+      size_t index(head.getObsIndex("C1C"));
+
+      while (strm >> data)
+      {
+         Epoch e;
+         e.time = data.time;
+         Rinex3ObsData::DataMap::const_iterator it;
+         for (it = data.obs.begin(); it != data.obs.end(); ++it)
+         {
+            double pr(it->second[index].data);
+            if (it->first.system != SatID::systemGPS || pr == 0.0)
+               continue;
+            e.sats.push_back(it->first);
+            e.ranges.push_back(pr);
+         }
+         epochs.push_back(e);
+      }
+   }
+
+      /** Computes the RAIM solutions of all epochs with and without the
+       *  screening, with two or three ranges of each epoch biased, and
+       *  returns the number of epochs where the results are not the same.
+       */
+   int compare(double rmsLimit, int nReject, int& nsScreened, int& nsFull,
+               double& tScreened, double& tFull)
+   {
+      PRSolution screened, full;
+      screened.RMSLimit = full.RMSLimit = rmsLimit;
+      screened.NSatsReject = full.NSatsReject = nReject;
+      screened.hasMemory = full.hasMemory = false;
+      screened.ScreenRAIM = true;
+      GGTropModel trop;
+
+      int differences(0);
+      nsScreened = nsFull = 0;
+      tScreened = tFull = 0.0;
+      for (size_t k = 0; k < epochs.size(); k++)
+      {
+         Epoch e(epochs[k]);
+         size_t n(e.sats.size());
+         e.ranges[k%n] += 40.0;
+         e.ranges[(k+3)%n] -= 25.0;
+         if (k%3 == 0)
+            e.ranges[(k+5)%n] += 15.0;
+
+         vector<SatID> s1(e.sats), s2(e.sats);
+         vector<SatID::SatelliteSystem> y1, y2;
+         Matrix<double> invMC;
+
+         clock_t t0(clock());
+         int i1 = screened.RAIMCompute(e.time, s1, y1, e.ranges, invMC,
+                                       &eph, &trop);
+         clock_t t1(clock());
+         int i2 = full.RAIMCompute(e.time, s2, y2, e.ranges, invMC,
+                                   &eph, &trop);
+         clock_t t2(clock());
+         tScreened += double(t1-t0)/CLOCKS_PER_SEC;
+         tFull += double(t2-t1)/CLOCKS_PER_SEC;
+         nsScreened += screened.NRAIMSolutions;
+         nsFull += full.NRAIMSolutions;
+
+            // without ephemeris (the first epochs), there is no solution
+         bool same( i1 == i2 && s1 == s2 );
+         if (i1 == -4)
+         {
+            differences += !same;
+            continue;
+         }
+
+         same = ( same &&
+                  screened.isValid() == full.isValid() &&
+                  screened.Nsvs == full.Nsvs &&
+                  screened.RMSResidual == full.RMSResidual &&
+                  screened.MaxSlope == full.MaxSlope &&
+                  screened.NIterations == full.NIterations &&
+                  screened.Solution.size() == full.Solution.size() );
+         for (size_t j = 0; same && j < full.Solution.size(); j++)
+            same = (screened.Solution(j) == full.Solution(j));
+         differences += !same;
+      }
+
+      return differences;
+   }
+
+   unsigned screenTest();
+
+   Rinex3EphemerisStore eph;
+   vector<Epoch> epochs;
+};
+
+
+unsigned PRSolution_T::screenTest()
+{
+   TUDEF("PRSolution", "RAIMCompute");
+
+   TUASSERT(epochs.size() > 100);
+   TUASSERT(!PRSolution().ScreenRAIM);
+
+   int nsScreened, nsFull;
+   double tScreened, tFull;
+
+      // up to three rejections, as in real time use
+   TUASSERTE(int, 0, compare(3.0, 3, nsScreened, nsFull, tScreened, tFull));
+   TUASSERT(2*nsScreened < nsFull);
+   cout << fixed << setprecision(1)
+        << "rms limit 3, 3 rejections: " << nsFull << " solutions in "
+        << 1.e6*tFull/epochs.size() << " us/epoch; screened "
+        << nsScreened << " solutions in "
+        << 1.e6*tScreened/epochs.size() << " us/epoch" << endl;
+
+      // the limit is never met: every stage, down to too few satellites
+   TUASSERTE(int, 0, compare(0.01, -1, nsScreened, nsFull, tScreened, tFull));
+   TUASSERT(nsScreened < nsFull);
+   cout << "rms limit 0.01, no rejection limit: " << nsFull
+        << " solutions in " << 1.e6*tFull/epochs.size()
+        << " us/epoch; screened " << nsScreened << " solutions in "
+        << 1.e6*tScreened/epochs.size() << " us/epoch" << endl;
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   PRSolution_T testClass;
+
+   errorTotal += testClass.screenTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,141 @@
+#pragma ident "$Id$"
+/**********************************************
+/ GPSTk: Clock Tools
+/ clockStability.hpp
+/
+/ Reads time tag & phase data from the standard
+/ input and writes a stability curve, for the
+/ deviation tools
+/
+**********************************************/
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2009, The University of Texas at Austin
+//
+//============================================================================
+
+#ifndef CLOCKSTABILITY_HPP
+#define CLOCKSTABILITY_HPP
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <limits>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FrequencyStability.hpp"
+
+// Runs one of the deviation tools: reads the time tags and the phase from
+// the standard input, computes 'stat' and writes "tau deviation" lines to
+// the standard output (with the confidence interval when asked to).
+// The first time tags give Tau0. A phase of exactly zero, other than the
+// first one, is a missing measurement. Every measurement is used; before
+// the tools shared FrequencyStability, the last one was left out.
+inline int clockStabilityMain(int argc, char **argv,
+                              gpstk::FrequencyStability::Statistic stat,
+                              const std::string& name,
+                              const std::string& description)
+{
+    using namespace std;
+    using gpstk::FrequencyStability;
+
+    FrequencyStability::TauSpacing spacing = FrequencyStability::AllTau;
+    bool errors = false;
+    int threads = 0;
+
+    for(int i = 1; i < argc; i++)
+    {
+        string str = argv[i];
+        if((str == "-h") || (str == "--help"))
+        {
+            cout << name << ": " << description << endl
+                 << "options:" << endl
+                 << "  -o, --octave     only tau = 1, 2, 4, 8, ... Tau0" << endl
+                 << "  -d, --decade     only tau = 1, 2, 5, 10, ... Tau0" << endl
+                 << "  -e, --errors     add the limits of the 68.3% confidence interval" << endl
+                 << "  -j, --threads n  number of threads (default: one per processor)" << endl;
+            return 1;
+        }
+        else if((str == "-o") || (str == "--octave"))
+            spacing = FrequencyStability::OctaveTau;
+        else if((str == "-d") || (str == "--decade"))
+            spacing = FrequencyStability::DecadeTau;
+        else if((str == "-e") || (str == "--errors"))
+            errors = true;
+        else if(((str == "-j") || (str == "--threads")) && (i+1 < argc))
+            threads = atoi(argv[++i]);
+        else
+        {
+            cerr << name << ": unknown option " << str << endl;
+            return 1;
+        }
+    }
+
+    // Structures used to store time and clock phase information
+    vector <double> timeArray;
+    vector <double> phaseArray;
+    long double time, phase;
+
+    // All of the time and clock phase data is read in from the standard input
+    while(cin >> time >> phase)
+    {
+        if(phase == 0 && !phaseArray.empty())
+            phaseArray.push_back(numeric_limits<double>::quiet_NaN());
+        else
+            phaseArray.push_back(phase);
+        timeArray.push_back(time);
+    }
+
+    // Ensures there are at least the minimum number of points required to do calculations
+    if(timeArray.size() < 3)
+    {
+        cout << "Not Enough Points to Calculate Tau0" << endl;
+        return 1;
+    }
+    double Tau0 = timeArray[1] - timeArray[0];
+
+    try
+    {
+        FrequencyStability stab(phaseArray, Tau0);
+        stab.setNumThreads(threads);
+
+        vector<FrequencyStability::Point> curve = stab.compute(stat, spacing);
+        for(size_t i = 0; i < curve.size(); i++)
+        {
+            if(errors)
+                fprintf(stdout, "%.1f %.4e %.4e %.4e \n", curve[i].tau,
+                        curve[i].deviation, curve[i].lower, curve[i].upper);
+            else
+                fprintf(stdout, "%.1f %.4e \n", curve[i].tau,
+                        curve[i].deviation);
+        }
+    }
+    catch(gpstk::Exception& e)
+    {
+        cerr << name << ": " << e.getText() << endl;
+        return 1;
+    }
+
+    return(0);
+}
+
+#endif
@@ -0,0 +1,44 @@
+#pragma ident "$Id$"
+/**********************************************
+/ GPSTk: Clock Tools
+/ timedev.cpp
+/
+/ Computes the time deviation
+/ (reference)
+**********************************************/
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 2.1 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2009, The University of Texas at Austin
+//
+//============================================================================
+
+#include "clockStability.hpp"
+
+// The Time Deviation is calculated from the Modified Allan Deviation as follows
+//  TSigma(Tau) = Tau / sqrt(3) * MSigma(Tau)
+//  Where Tau is the averaging time, Tau = m*Tau0, and Tau0 is the basic
+//  measurement interval
+
+int main(int argc, char **argv)
+{
+    return clockStabilityMain(argc, argv, gpstk::FrequencyStability::Time,
+                              "timedev",
+                              "Computes the time deviation from the standard input.");
+}
@@ -52,6 +52,7 @@ EMLTracker::EMLTracker(CCReplica& localReplica, double codeSpacing) :
    pllError(0), dllError(0),
    dllMode(dmFar), pllMode(pmUnlocked),
    nav(false), prevNav(true),
+   fast(NULL),
    inSumSq(0), lrSumSq(0),
    iadCount(0),
    iadThreshold(0.02),
@@ -78,6 +79,12 @@ EMLTracker::EMLTracker(CCReplica& localReplica, double codeSpacing) :
    iadCountDefault = iadCountMax;
 };
 
+EMLTracker::~EMLTracker()
+{
+   delete fast;
+}
+
+
 bool EMLTracker::process(complex<double> in)
 {
       //if(periodCount%10 == 0)
@@ -89,6 +96,9 @@ bool EMLTracker::process(complex<double> in)
 
    if (++iadCount == iadCountMax)
    {
+      eSum = early();
+      pSum = prompt();
+      lSum = late();
       updateLoop();
       // and dump our accumulators
       early.dump();
@@ -107,6 +117,34 @@ bool EMLTracker::process(complex<double> in)
 }
 
 
+bool EMLTracker::process(const complex<short>* in, size_t& count)
+{
+   if (!fast)
+      fast = new FastCorrelator(localReplica, eplSpacing);
+
+   if (count > iadCountMax - iadCount)
+      count = iadCountMax - iadCount;
+   fast->process(in, count);
+   iadCount += count;
+
+   if (iadCount < iadCountMax)
+      return false;
+
+   // Scale the sums as integrate() does
+   eSum = fast->early() * baseGain;
+   pSum = fast->prompt() * baseGain;
+   lSum = fast->late() * baseGain;
+   inSumSq = fast->inputPower() * baseGain * baseGain;
+   lrSumSq = fast->replicaPower();
+   updateLoop();
+   fast->dump();
+   inSumSq = 0;
+   lrSumSq = 0;
+   iadCount = 0;
+   return true;
+}
+
+
 void EMLTracker::integrate(complex<double> in)
 {
    localReplica.tick();
@@ -138,19 +176,19 @@ void EMLTracker::updateLoop()
 {
    sqrtSumSq = sqrt(inSumSq*lrSumSq);
 
-   emag = abs(early()) / sqrtSumSq;
-   pmag = abs(prompt()) / sqrtSumSq;
-   lmag = abs(late()) / sqrtSumSq;
+   emag = abs(eSum) / sqrtSumSq;
+   pmag = abs(pSum) / sqrtSumSq;
+   lmag = abs(lSum) / sqrtSumSq;
 
-   pI = prompt().real();
-   pQ = prompt().imag();
+   pI = pSum.real();
+   pQ = pSum.imag();
 
    snr= 10*log10(pmag*pmag/localReplica.tickSize);
 
    dllError = lmag - emag;
-   pllError = atan(prompt().imag() / prompt().real()) / PI;
+   pllError = atan(pSum.imag() / pSum.real()) / PI;
 
-   promptPhase =atan2(prompt().imag(), prompt().real()) / PI;
+   promptPhase =atan2(pSum.imag(), pSum.real()) / PI;
 
    DllMode oldDllMode=dllMode;
    // Do we have any idea where the peak may lie?
@@ -170,7 +208,7 @@ void EMLTracker::updateLoop()
 
    // At this point all that is left on the inphase is the nav data
    prevNav = nav;
-   nav = prompt().real() > 0;
+   nav = pSum.real() > 0;
    if(prevNav != nav)
    {
      navChange = true;
@@ -46,6 +46,7 @@
 
 #include "CCReplica.hpp"
 #include "SimpleCorrelator.hpp"
+#include "FastCorrelator.hpp"
 #include "complex_math.h"
 
 
@@ -84,8 +85,17 @@ public:
    /// of ticks.
    EMLTracker(CCReplica& localReplica, double codeSpacing);
 
+   virtual ~EMLTracker();
+
    virtual bool process(std::complex<double> in);
 
+   // Processes a block of samples with a FastCorrelator, stopping at the
+   // end of the integration. count is the number of samples in the block
+   // and is set to the number used. It returns true when a dump was
+   // performed. A tracker should be given either blocks or single samples,
+   // not both.
+   virtual bool process(const std::complex<short>* in, size_t& count);
+
    void dump(std::ostream& s, int detail=0) const;
 
    double pllAlpha, pllBeta, dllAlpha, dllBeta;
@@ -113,6 +123,9 @@ public:
    unsigned getIntegrateCount() const {return iadCount;}
 
 private:
+   EMLTracker(const EMLTracker&);
+   EMLTracker& operator=(const EMLTracker&);
+
    void integrate(std::complex<double> in);
    void updateLoop();
 
@@ -126,6 +139,12 @@ private:
 
 
    SimpleCorrelator<double> early, prompt, late;
+
+   // Only made when blocks of samples are given
+   FastCorrelator* fast;
+
+   // The early, prompt and late sums used by updateLoop()
+   std::complex<double> eSum, pSum, lSum;
    double emag, pmag, lmag, pI, pQ;
 
    // These are used to normalize the correlator counts
@@ -0,0 +1,302 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include "FFTAcquisition.hpp"
+
+#include <cmath>
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+#include "GNSSconstants.hpp"
+#include "CACodeGenerator.hpp"
+
+using namespace gpstk;
+using namespace std;
+
+
+#ifdef GPSTK_HAVE_PTHREAD
+struct FFTAcquisition::Work
+{
+   const FFTAcquisition* acq;
+   const vector<int>* prns;
+   vector<Result>* results;
+   size_t next;
+   pthread_mutex_t mutex;
+};
+#endif
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+FFTAcquisition::FFTAcquisition(double sampleRate, double interFreq,
+                               unsigned periods, double searchWidth,
+                               double binWidth, unsigned planFlags)
+   : sampleRate(sampleRate), interFreq(interFreq),
+     searchWidth(searchWidth), binWidth(binWidth),
+     numSamples(static_cast<size_t>(sampleRate * 1e-3 * periods)),
+     numBins(static_cast<unsigned>(searchWidth / binWidth) + 1),
+     threads(1)
+{
+   binSpectra = static_cast<fftw_complex*>(
+      fftw_malloc(sizeof(fftw_complex) * numSamples * numBins));
+   buf1 = static_cast<fftw_complex*>(
+      fftw_malloc(sizeof(fftw_complex) * numSamples));
+   buf2 = static_cast<fftw_complex*>(
+      fftw_malloc(sizeof(fftw_complex) * numSamples));
+
+   // The planner isn't thread safe, so all plans are made here
+   int n = numSamples;
+   binPlan = fftw_plan_many_dft(1, &n, numBins,
+                                binSpectra, NULL, 1, n,
+                                binSpectra, NULL, 1, n,
+                                FFTW_FORWARD, planFlags);
+   forwardPlan = fftw_plan_dft_1d(n, buf1, buf2, FFTW_FORWARD, planFlags);
+   inversePlan = fftw_plan_dft_1d(n, buf1, buf2, FFTW_BACKWARD, planFlags);
+}
+
+
+FFTAcquisition::~FFTAcquisition()
+{
+   fftw_destroy_plan(binPlan);
+   fftw_destroy_plan(forwardPlan);
+   fftw_destroy_plan(inversePlan);
+   map<int, fftw_complex*>::iterator i;
+   for (i = codeSpectra.begin(); i != codeSpectra.end(); i++)
+      fftw_free(i->second);
+   fftw_free(binSpectra);
+   fftw_free(buf1);
+   fftw_free(buf2);
+}
+
+
+void FFTAcquisition::setInput(const complex<float>* samples)
+{
+   for (unsigned b = 0; b < numBins; b++)
+   {
+      double freq = interFreq - searchWidth/2 + b * binWidth;
+      double w = -2.0 * PI * freq / sampleRate;
+      complex<double> step(cos(w), sin(w)), carrier;
+      fftw_complex* out = binSpectra + b * numSamples;
+      for (size_t k = 0; k < numSamples; k++)
+      {
+         // start the rotation afresh now and then to keep it accurate
+         if (k % 1024 == 0)
+            carrier = complex<double>(cos(w*k), sin(w*k));
+         complex<double> v = complex<double>(samples[k]) * carrier;
+         out[k][0] = v.real();
+         out[k][1] = v.imag();
+         carrier *= step;
+      }
+   }
+   fftw_execute(binPlan);
+}
+
+
+void FFTAcquisition::precompute(const vector<int>& prns)
+{
+   for (size_t i = 0; i < prns.size(); i++)
+   {
+      if (codeSpectra.count(prns[i]))
+         continue;
+
+      CACodeGenerator gen(prns[i]);
+      vector<double> chips(gen.getSyncIndex());
+      for (size_t c = 0; c < chips.size(); c++, ++gen)
+         chips[c] = *gen ? 1 : -1;
+
+      double chipsPerSample = CA_CHIP_FREQ_GPS / sampleRate;
+      for (size_t k = 0; k < numSamples; k++)
+      {
+         size_t c = static_cast<size_t>(k * chipsPerSample) % chips.size();
+         buf1[k][0] = chips[c];
+         buf1[k][1] = 0;
+      }
+      fftw_execute(forwardPlan);
+
+      fftw_complex* spectrum = static_cast<fftw_complex*>(
+         fftw_malloc(sizeof(fftw_complex) * numSamples));
+      for (size_t k = 0; k < numSamples; k++)
+      {
+         spectrum[k][0] = buf2[k][0];
+         spectrum[k][1] = -buf2[k][1];
+      }
+      codeSpectra[prns[i]] = spectrum;
+   }
+}
+
+
+FFTAcquisition::Result FFTAcquisition::search(int prn)
+{
+   return search(vector<int>(1, prn)).front();
+}
+
+
+vector<FFTAcquisition::Result> FFTAcquisition::search(const vector<int>& prns)
+{
+   precompute(prns);
+
+   vector<Result> results(prns.size());
+#ifdef GPSTK_HAVE_PTHREAD
+   unsigned n = min(threads, static_cast<unsigned>(prns.size()));
+#else
+   unsigned n = 1;
+#endif
+   if (n <= 1)
+   {
+      for (size_t i = 0; i < prns.size(); i++)
+         results[i] = searchPRN(prns[i], buf1, buf2);
+      return results;
+   }
+
+#ifdef GPSTK_HAVE_PTHREAD
+
+   Work work;
+   work.acq = this;
+   work.prns = &prns;
+   work.results = &results;
+   work.next = 0;
+   pthread_mutex_init(&work.mutex, NULL);
+
+   vector<pthread_t> ids(n);
+   for (unsigned t = 0; t < n; t++)
+   {
+      int rc = pthread_create(&ids[t], NULL, worker, &work);
+      if (rc)
+      {
+         // carry on with the threads we have
+         ids.resize(t);
+         break;
+      }
+   }
+   if (ids.empty())
+      worker(&work);
+   for (size_t t = 0; t < ids.size(); t++)
+      pthread_join(ids[t], NULL);
+
+   pthread_mutex_destroy(&work.mutex);
+#endif
+   return results;
+}
+
+
+#ifdef GPSTK_HAVE_PTHREAD
+void* FFTAcquisition::worker(void* arg)
+{
+   Work* work = static_cast<Work*>(arg);
+   const FFTAcquisition* acq = work->acq;
+   fftw_complex* product = static_cast<fftw_complex*>(
+      fftw_malloc(sizeof(fftw_complex) * acq->numSamples));
+   fftw_complex* corr = static_cast<fftw_complex*>(
+      fftw_malloc(sizeof(fftw_complex) * acq->numSamples));
+
+   while (true)
+   {
+      pthread_mutex_lock(&work->mutex);
+      size_t i = work->next++;
+      pthread_mutex_unlock(&work->mutex);
+      if (i >= work->prns->size())
+         break;
+      (*work->results)[i] = acq->searchPRN((*work->prns)[i], product, corr);
+   }
+
+   fftw_free(product);
+   fftw_free(corr);
+   return NULL;
+}
+#endif
+
+
+FFTAcquisition::Result FFTAcquisition::searchPRN(int prn,
+                                                 fftw_complex* product,
+                                                 fftw_complex* corr) const
+{
+   // precompute() has added every PRN searched; the map is not changed
+   // while the threads read it
+   const fftw_complex* code = codeSpectra.find(prn)->second;
+   double peak = -1, sum = 0;
+   unsigned peakBin = 0;
+   size_t peakShift = 0;
+
+   for (unsigned b = 0; b < numBins; b++)
+   {
+      const fftw_complex* in = binSpectra + b * numSamples;
+      for (size_t k = 0; k < numSamples; k++)
+      {
+         product[k][0] = in[k][0] * code[k][0] - in[k][1] * code[k][1];
+         product[k][1] = in[k][0] * code[k][1] + in[k][1] * code[k][0];
+      }
+      fftw_execute_dft(inversePlan, product, corr);
+
+      // corr[n] is numSamples times the correlation of the input
+      // with the code delayed by n samples
+      for (size_t k = 0; k < numSamples; k++)
+      {
+         double p = corr[k][0] * corr[k][0] + corr[k][1] * corr[k][1];
+         sum += p;
+         if (p > peak)
+         {
+            peak = p;
+            peakBin = b;
+            peakShift = k;
+         }
+      }
+   }
+
+   Result r;
+   r.prn = prn;
+   r.doppler = -searchWidth/2 + peakBin * binWidth;
+   // A peak at n means the code starts numSamples-n samples into the
+   // input, which is the offset gpsSim and the trackers take.
+   double samplesPerPeriod = sampleRate * 1e-3;
+   size_t start = (numSamples - peakShift) % numSamples;
+   r.codeOffset = fmod(start, samplesPerPeriod) / sampleRate * 1e6;
+   r.height = sqrt(peak) / pow(static_cast<double>(numSamples), 1.5);
+   r.ratio = peak / (sum / (numSamples * numBins));
+   return r;
+}
+
+
+bool FFTAcquisition::importWisdom(const string& filename)
+{
+   return fftw_import_wisdom_from_filename(filename.c_str()) != 0;
+}
+
+
+bool FFTAcquisition::exportWisdom(const string& filename)
+{
+   return fftw_export_wisdom_to_filename(filename.c_str()) != 0;
+}
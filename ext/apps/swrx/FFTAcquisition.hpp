@@ -0,0 +1,156 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#ifndef FFTACQUISITION_HPP
+#define FFTACQUISITION_HPP
+
+#include <complex>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fftw3.h>
+
+//-----------------------------------------------------------------------------
+// Parallel code phase search for the GPS C/A code, using FFTW.
+//
+// The input is wiped off by the carrier of every Doppler bin, and all the
+// bins are transformed by one batched FFTW plan. The spectrum of the code
+// of each PRN is computed once and kept, so that each PRN and bin then
+// takes one multiply and one inverse transform. The PRNs are shared out
+// to a number of worker threads, which use the same plans on buffers of
+// their own.
+//
+// The plans are made when the object is created. Planning with
+// FFTW_MEASURE gives faster plans but takes a while, so it is best used
+// with importWisdom() and exportWisdom() to keep the FFTW wisdom from one
+// run to the next.
+//
+// A typical way to use this class follows:
+//
+//   FFTAcquisition acq(16.368e6, 4.092e6);
+//   acq.setInput(&samples[0]);    // acq.getNumSamples() samples
+//   std::vector<FFTAcquisition::Result> r = acq.search(prns);
+//-----------------------------------------------------------------------------
+class FFTAcquisition
+{
+public:
+   // The correlation peak found for one PRN
+   struct Result
+   {
+      int prn;
+      double doppler;     // units: Hz
+      double codeOffset;  // units: us, within one C/A period
+      double height;      // height of the correlation peak
+      double ratio;       // peak over the mean of all correlations
+   };
+
+   // param sampleRate the sample rate, in Hz
+   // param interFreq the intermediate frequency, in Hz
+   // param periods the number of C/A periods (ms) of samples to use
+   // param searchWidth the width of the Doppler search, in Hz
+   // param binWidth the width of the Doppler bins, in Hz
+   // param planFlags the FFTW planner flags
+   FFTAcquisition(double sampleRate, double interFreq, unsigned periods=1,
+                  double searchWidth=20000, double binWidth=200,
+                  unsigned planFlags=FFTW_ESTIMATE);
+   ~FFTAcquisition();
+
+   // The number of samples given to setInput()
+   size_t getNumSamples() const {return numSamples;}
+
+   // The number of Doppler bins
+   unsigned getNumBins() const {return numBins;}
+
+   // The number of threads used by search(). The default is one.
+   void setThreads(unsigned n) {threads = n ? n : 1;}
+   unsigned getThreads() const {return threads;}
+
+   // Takes getNumSamples() samples to search, and wipes the carrier of
+   // each Doppler bin off them.
+   void setInput(const std::complex<float>* samples);
+
+   // Computes the code spectra of the given PRNs, if not done yet.
+   // search() calls this.
+   void precompute(const std::vector<int>& prns);
+
+   // Searches the input for the given PRNs, returning one Result for each
+   std::vector<Result> search(const std::vector<int>& prns);
+   Result search(int prn);
+
+   // Loads/saves the FFTW wisdom, returning false if that failed.
+   static bool importWisdom(const std::string& filename);
+   static bool exportWisdom(const std::string& filename);
+
+   const double sampleRate;   // units: Hz
+   const double interFreq;    // units: Hz
+   const double searchWidth;  // units: Hz
+   const double binWidth;     // units: Hz
+
+private:
+   FFTAcquisition(const FFTAcquisition&);
+   FFTAcquisition& operator=(const FFTAcquisition&);
+
+   // Searches one PRN using the given buffers of numSamples values
+   Result searchPRN(int prn, fftw_complex* product, fftw_complex* corr) const;
+
+   // Runs the searches of a worker thread
+   static void* worker(void* arg);
+
+   const size_t numSamples;
+   const unsigned numBins;
+   unsigned threads;
+
+   // The input, times the conjugate of the carrier of each bin, and
+   // then its spectrum. Bin b starts at b*numSamples.
+   fftw_complex* binSpectra;
+
+   // Conjugate of the spectrum of the code of each PRN
+   std::map<int, fftw_complex*> codeSpectra;
+
+   // Buffers used for planning and by the calling thread
+   fftw_complex *buf1, *buf2;
+
+   // Forward transform of all the bins, in place; forward and inverse
+   // transforms of numSamples values, out of place.
+   fftw_plan binPlan, forwardPlan, inversePlan;
+
+   // Shared by the worker threads of a search
+   struct Work;
+};
+
+#endif
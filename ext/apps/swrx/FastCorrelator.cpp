@@ -0,0 +1,421 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+#include "FastCorrelator.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "Exception.hpp"
+#include "CACodeGenerator.hpp"
+#include "PCodeGenerator.hpp"
+
+using namespace gpstk;
+using namespace std;
+
+namespace
+{
+   // Cosine and sine of 256 carrier phases, for the top byte of the NCO,
+   // as (cos, sin, -sin, cos), the pairs that wipe the carrier off a
+   // sample (I, Q) with two multiply-adds.
+   struct CarrierTable
+   {
+      CarrierTable()
+      {
+         for (int i=0; i<256; i++)
+         {
+            double a = 2.0*PI*i/256;
+            int16_t c = static_cast<int16_t>(
+               floor(FastCorrelator::carrierAmp * cos(a) + 0.5));
+            int16_t s = static_cast<int16_t>(
+               floor(FastCorrelator::carrierAmp * sin(a) + 0.5));
+            entry[i][0] = c;
+            entry[i][1] = s;
+            entry[i][2] = -s;
+            entry[i][3] = c;
+         }
+      }
+      int16_t entry[256][4];
+   };
+   const CarrierTable carrierTable;
+
+   // Fraction of a cycle, as a 32 bit phase
+   inline uint32_t toPhase32(double cycles)
+   {
+      cycles -= floor(cycles);
+      return static_cast<uint32_t>(static_cast<uint64_t>(cycles * 4294967296.0));
+   }
+
+   // Sets wI[k] + j*wQ[k] to iq[k] * conj(carrier[k]), where iq holds
+   // (I, Q) pairs and carrier the CarrierTable entries, and returns the sum
+   // of the squares of iq. n must be at most 65536.
+   int64_t wipeCarrier(const int16_t* iq, const int16_t* carrier, size_t n,
+                       int16_t* wI, int16_t* wQ)
+   {
+      int32_t power = 0;
+      size_t k = 0;
+#ifdef __SSE2__
+      __m128i p = _mm_setzero_si128();
+      for (; k+8 <= n; k += 8)
+      {
+         const __m128i* x = reinterpret_cast<const __m128i*>(iq + 2*k);
+         const __m128i* c = reinterpret_cast<const __m128i*>(carrier + 4*k);
+         __m128i x0 = _mm_loadu_si128(x), x1 = _mm_loadu_si128(x+1);
+            // gather the (cos, sin) and (-sin, cos) pairs of 4 samples
+         __m128i c0 = _mm_loadu_si128(c), c1 = _mm_loadu_si128(c+1);
+         __m128i c2 = _mm_loadu_si128(c+2), c3 = _mm_loadu_si128(c+3);
+         __m128i lo = _mm_unpacklo_epi32(c0, c1);
+         __m128i hi = _mm_unpackhi_epi32(c0, c1);
+         __m128i a0 = _mm_unpacklo_epi32(lo, hi);
+         __m128i b0 = _mm_unpackhi_epi32(lo, hi);
+         lo = _mm_unpacklo_epi32(c2, c3);
+         hi = _mm_unpackhi_epi32(c2, c3);
+         __m128i a1 = _mm_unpacklo_epi32(lo, hi);
+         __m128i b1 = _mm_unpackhi_epi32(lo, hi);
+         __m128i i0 = _mm_madd_epi16(x0, a0);
+         __m128i i1 = _mm_madd_epi16(x1, a1);
+         __m128i q0 = _mm_madd_epi16(x0, b0);
+         __m128i q1 = _mm_madd_epi16(x1, b1);
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(wI + k),
+                          _mm_packs_epi32(i0, i1));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(wQ + k),
+                          _mm_packs_epi32(q0, q1));
+         p = _mm_add_epi32(p, _mm_add_epi32(_mm_madd_epi16(x0, x0),
+                                            _mm_madd_epi16(x1, x1)));
+      }
+      int32_t lanes[4];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), p);
+      power = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+      for (; k<n; k++)
+      {
+         int re = iq[2*k], im = iq[2*k+1];
+         wI[k] = re*carrier[4*k] + im*carrier[4*k+1];
+         wQ[k] = re*carrier[4*k+2] + im*carrier[4*k+3];
+         power += re*re + im*im;
+      }
+      return power;
+   }
+
+   // Sums x[k]*code[k], x[k]*code[k+spacing] and x[k]*code[k+2*spacing]
+   // for k from 0 to n-1. n must be at most 65536 to keep the 32 bit
+   // sums from overflowing.
+   void correlate3(const int16_t* x, const int16_t* code, size_t spacing,
+                   size_t n, int64_t sums[3])
+   {
+      const int16_t* c0 = code;
+      const int16_t* c1 = code + spacing;
+      const int16_t* c2 = code + 2*spacing;
+      int32_t s0 = 0, s1 = 0, s2 = 0;
+      size_t k = 0;
+#ifdef __SSE2__
+      __m128i a0 = _mm_setzero_si128();
+      __m128i a1 = _mm_setzero_si128();
+      __m128i a2 = _mm_setzero_si128();
+      for (; k+8 <= n; k += 8)
+      {
+         __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x+k));
+         a0 = _mm_add_epi32(a0, _mm_madd_epi16(v,
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(c0+k))));
+         a1 = _mm_add_epi32(a1, _mm_madd_epi16(v,
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(c1+k))));
+         a2 = _mm_add_epi32(a2, _mm_madd_epi16(v,
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(c2+k))));
+      }
+      int32_t lanes[4];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), a0);
+      s0 = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), a1);
+      s1 = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), a2);
+      s2 = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+      for (; k<n; k++)
+      {
+         s0 += x[k] * c0[k];
+         s1 += x[k] * c1[k];
+         s2 += x[k] * c2[k];
+      }
+      sums[0] += s0;
+      sums[1] += s1;
+      sums[2] += s2;
+   }
+}
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+CodeTable::CodeTable(const CodeGenerator& g)
+   : gen(NULL), period(0), base(0)
+{
+   switch (g.code)
+   {
+      case ObsID::tcCA:
+         gen = new CACodeGenerator(g.sv.id);
+         period = g.getSyncIndex();
+         break;
+      case ObsID::tcP:
+         gen = new PCodeGenerator(g.sv.id);
+         break;
+      default:
+         GPSTK_THROW(InvalidParameter("CodeTable: unsupported code "
+                                      + ObsID::tcDesc[g.code]));
+   }
+   if (period)
+   {
+      table.resize(2*period);
+      fill(0, table.size());
+   }
+}
+
+
+CodeTable::~CodeTable()
+{
+   delete gen;
+}
+
+
+void CodeTable::fill(size_t begin, size_t end)
+{
+   for (size_t i=begin; i<end; i++)
+   {
+      if (period && i >= (size_t)period)
+         table[i] = table[i - period];
+      else if (base + (long)i < 0)
+         table[i] = 0;
+      else
+      {
+         table[i] = **gen ? 1 : -1;
+         ++(*gen);
+      }
+   }
+}
+
+
+const int16_t* CodeTable::chips(long first, size_t count)
+{
+   if (period)
+   {
+         // add periods to the table until it covers the chips asked for
+      first %= period;
+      if (first < 0)
+         first += period;
+      size_t size = table.size();
+      if (first + count > size)
+      {
+         table.resize(first + count + period);
+         fill(size, table.size());
+      }
+      return &table[first];
+   }
+
+   long end = base + (long)table.size();
+   if (first >= base && first + (long)count <= end)
+      return &table[first - base];
+
+      // Slide the window forward, keeping a few chips before the first
+      // one asked for to allow for the code being moved back a bit.
+   const long margin = 64;
+   size_t size = max(count + margin, (size_t)65536);
+   long newBase = first - margin;
+   if (newBase >= base && newBase < end)
+   {
+      size_t keep = end - newBase;
+      copy(table.begin() + (newBase - base), table.end(), table.begin());
+      table.resize(size);
+      base = newBase;
+      fill(keep, size);
+   }
+   else
+   {
+      table.resize(size);
+      base = newBase;
+      gen->setIndex(max(base, 0L));
+      fill(0, size);
+   }
+   return &table[first - base];
+}
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+FastCorrelator::FastCorrelator(CCReplica& replica, unsigned spacing)
+   : replica(replica), spacing(spacing), codeTable(*replica.codeGenPtr),
+     carrier(4*blockSize),
+     wipedI(blockSize), wipedQ(blockSize),
+     code(blockSize + 2*spacing + 8)
+{
+   dump();
+}
+
+
+void FastCorrelator::dump() throw()
+{
+   for (int i=0; i<3; i++)
+      sumI[i] = sumQ[i] = 0;
+   inSumSq = 0;
+   lrSumSq = 0;
+}
+
+
+complex<double> FastCorrelator::early() const throw()
+{
+   return complex<double>(sumI[0], sumQ[0]) * (1.0/carrierAmp);
+}
+
+
+complex<double> FastCorrelator::prompt() const throw()
+{
+   return complex<double>(sumI[1], sumQ[1]) * (1.0/carrierAmp);
+}
+
+
+complex<double> FastCorrelator::late() const throw()
+{
+   return complex<double>(sumI[2], sumQ[2]) * (1.0/carrierAmp);
+}
+
+
+void FastCorrelator::process(const complex<short>* in, size_t n) throw()
+{
+   while (n)
+   {
+      size_t m = min(n, blockSize);
+      correlate(in, m);
+      in += m;
+      n -= m;
+   }
+}
+
+
+void FastCorrelator::correlate(const complex<short>* in, size_t n) throw()
+{
+   CCReplica& r = replica;
+   double chipsPerSample = r.chipsPerTick + r.codeFreqOffset;
+   double cyclesPerSample = r.cyclesPerTick + r.carrierFreqOffset;
+
+   // As in CCReplica, the replica is ticked before each sample is used.
+   uint32_t carrierPhase = toPhase32(r.carrierPhase + cyclesPerSample);
+   uint32_t carrierStep = toPhase32(cyclesPerSample);
+   for (size_t k=0; k<n; k++)
+   {
+      unsigned i = carrierPhase >> 24;
+      carrierPhase += carrierStep;
+      memcpy(&carrier[4*k], carrierTable.entry[i], 4*sizeof(int16_t));
+   }
+   // std::complex<short> holds the real part then the imaginary part
+   int64_t power = wipeCarrier(reinterpret_cast<const int16_t*>(in),
+                               &carrier[0], n, &wipedI[0], &wipedQ[0]);
+
+   // The code starts 2*spacing samples before the first one, for the
+   // early code, and one more since the delay line of SimpleCorrelator
+   // gives the code of the previous sample to the late correlator.
+   double start = r.codePhase - 2.0*spacing * chipsPerSample;
+   double startChip = floor(start);
+   long first = r.codeGenPtr->getIndex() + static_cast<long>(startChip);
+   size_t codeLen = n + 2*spacing;
+   size_t count = static_cast<size_t>(
+      (start - startChip) + codeLen*chipsPerSample) + 2;
+   const int16_t* chips = codeTable.chips(first, count);
+   uint64_t codePhase = static_cast<uint64_t>(
+      (start - startChip) * 4294967296.0);
+   uint64_t codeStep = static_cast<uint64_t>(chipsPerSample * 4294967296.0);
+   if (chipsPerSample > 0.25)
+   {
+      for (size_t j=0; j<codeLen; j++)
+      {
+         code[j] = chips[codePhase >> 32];
+         codePhase += codeStep;
+      }
+   }
+   else
+   {
+         // With several samples per chip, fill in a chip at a time
+      double samplesPerPhase = 1.0 / codeStep;
+      for (size_t j=0; j<codeLen; )
+      {
+         uint64_t chip = codePhase >> 32;
+         uint64_t next = (chip + 1) << 32;
+         size_t m = static_cast<size_t>((next - codePhase) * samplesPerPhase);
+         while (codePhase + m*codeStep < next)
+            m++;
+         while (m > 1 && codePhase + (m-1)*codeStep >= next)
+            m--;
+         m = min(m, codeLen - j);
+#ifdef __SSE2__
+            // code has room for the 8 samples past the end
+         __m128i v = _mm_set1_epi16(chips[chip]);
+         for (size_t t=0; t<m; t+=8)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&code[j+t]), v);
+#else
+         fill(&code[j], &code[j] + m, chips[chip]);
+#endif
+         j += m;
+         codePhase += m*codeStep;
+      }
+   }
+
+   correlate3(&wipedI[0], &code[0], spacing, n, sumI);
+   correlate3(&wipedQ[0], &code[0], spacing, n, sumQ);
+   inSumSq += power;
+   lrSumSq += n;
+
+   // Move the replica forward, as n calls to tick() would
+   r.localTime += n * r.tickSize;
+   r.codePhase += n * chipsPerSample;
+   r.codePhaseOffset += n * r.codeFreqOffset;
+   long dc = static_cast<long>(floor(r.codePhase));
+   r.codePhase -= dc;
+   if (codeTable.isPeriodic())
+   {
+         // setIndex() would restart the chip count of the C/A code,
+         // which NavFramer uses
+      for (; dc > 0; dc--)
+         ++(*r.codeGenPtr);
+   }
+   else if (dc > 0)
+      r.codeGenPtr->setIndex(r.codeGenPtr->getIndex() + dc);
+   r.carrierPhase += n * cyclesPerSample;
+   r.carrierPhaseOffset += n * r.carrierFreqOffset;
+   double cycles = floor(r.carrierPhase);
+   r.carrierPhase -= cycles;
+   r.carrierAccum += static_cast<long>(cycles);
+}
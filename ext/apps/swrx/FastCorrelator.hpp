@@ -0,0 +1,147 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+
+#ifndef FASTCORRELATOR_HPP
+#define FASTCORRELATOR_HPP
+
+#include <complex>
+#include <vector>
+
+#include "gpstkplatform.h"
+
+#include "CCReplica.hpp"
+#include "CodeGenerator.hpp"
+
+//-----------------------------------------------------------------------------
+// The chips of a code as +1/-1, taken from a code generator of its own
+// so that the one in the replica is left alone. A C/A code is kept as a
+// whole number of periods. Longer codes, such as P, are kept as a window
+// that slides forward as the code is used.
+//-----------------------------------------------------------------------------
+class CodeTable
+{
+public:
+   // A generator for the same code and PRN as gen is made. Only the C/A
+   // and P codes are supported.
+   CodeTable(const gpstk::CodeGenerator& gen);
+   ~CodeTable();
+
+   // Returns the chips from index first to first+count-1. The pointer is
+   // good until the next call. Chips before the start of the code are 0.
+   const int16_t* chips(long first, size_t count);
+
+   // True when the whole code is kept
+   bool isPeriodic() const {return period > 0;}
+
+private:
+   CodeTable(const CodeTable&);
+   CodeTable& operator=(const CodeTable&);
+
+   void fill(size_t begin, size_t end);
+
+   gpstk::CodeGenerator* gen;
+
+   // Length of the code for a periodic code, zero otherwise
+   long period;
+
+   // Code index of table[0]
+   long base;
+
+   std::vector<int16_t> table;
+};
+
+
+//-----------------------------------------------------------------------------
+// An early/prompt/late correlator that works on blocks of integer IQ
+// samples, in place of the sample by sample CCReplica::getCarrier() /
+// getCode() and SimpleCorrelator. The carrier is generated from a 32 bit
+// NCO and a sine/cosine table, and the code from a table of chips and a
+// 32.32 fixed point NCO. The carrier is wiped off into 16 bit samples and
+// the three correlations are 16 bit multiply-adds, with SSE2 when the
+// compiler has it.
+//
+// The replica is read at the start of each block and moved forward by the
+// number of samples, so the tracking loops work on it as they do for the
+// sample by sample correlators. The samples must fit in 8 bits, as those
+// of 1, 2 or 8 bit front ends do.
+//-----------------------------------------------------------------------------
+class FastCorrelator
+{
+public:
+   // param spacing the number of samples between the early, prompt and
+   // late codes. As in EMLTracker, the late code is the one of the
+   // replica (one sample late) and the others are delayed.
+   FastCorrelator(CCReplica& replica, unsigned spacing);
+
+   // Correlates n samples, moving the replica forward n ticks
+   void process(const std::complex<short>* in, size_t n) throw();
+
+   // Clears the sums
+   void dump() throw();
+
+   // The sums, scaled as if the carrier had an amplitude of one
+   std::complex<double> early() const throw();
+   std::complex<double> prompt() const throw();
+   std::complex<double> late() const throw();
+
+   // Sum of the squares of the input, and of the replica
+   double inputPower() const throw() {return inSumSq;}
+   double replicaPower() const throw() {return lrSumSq;}
+
+   CCReplica& replica;
+
+   // Amplitude of the carrier table
+   static const int carrierAmp = 127;
+
+private:
+   void correlate(const std::complex<short>* in, size_t n) throw();
+
+   const unsigned spacing;
+   CodeTable codeTable;
+
+   // The carrier, carrier wiped off samples and the code, for one block
+   std::vector<int16_t> carrier, wipedI, wipedQ, code;
+
+   // early, prompt and late sums for I and Q
+   int64_t sumI[3], sumQ[3];
+   double inSumSq, lrSumSq;
+
+   // number of samples in each block
+   static const size_t blockSize = 2048;
+};
+
+#endif
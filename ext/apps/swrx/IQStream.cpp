@@ -99,12 +99,31 @@ namespace gpstk
          gpstk::StringUtils::hexDumpData(
             cout, string(frameBuffer, frameLength));
             
-      write(frameBuffer, frameLength);
+      if (queueWrites)
+         writeQueue.insert(writeQueue.end(),
+                           frameBuffer, frameBuffer + frameLength);
+      else
+         write(frameBuffer, frameLength);
       writePtr = 0;
       frameCounter++;
    }
 
 
+   void IQStream::writeBlock(const complex<float>* v, size_t n)
+   {
+      queueWrites = true;
+      for (size_t i=0; i<n; i++)
+         writeComplex(v[i]);
+      queueWrites = false;
+
+      if (!writeQueue.empty())
+      {
+         write(&writeQueue[0], writeQueue.size());
+         writeQueue.clear();
+      }
+   }
+
+
    //-----------------------------------------------------------------------------
    //-----------------------------------------------------------------------------
    void IQ1Stream::readComplex(complex<short>& v)
@@ -58,7 +58,8 @@ namespace gpstk
               frameBuffer(NULL),
               sampleCounter(0),
               debugLevel(0),
-              bands(1)
+              bands(1),
+              queueWrites(false)
       { init(); }
 
 
@@ -69,7 +70,8 @@ namespace gpstk
               frameBuffer(NULL),
               sampleCounter(0),
               debugLevel(0),
-              bands(1)
+              bands(1),
+              queueWrites(false)
       { init(); }
 
          /// destructor per the coding standards
@@ -127,7 +129,16 @@ namespace gpstk
       virtual void writeComplex(const std::complex<short>& v) = 0;
       virtual void writeComplex(const std::complex<float>& v) = 0;
 
+         /// Writes n complex samples. The frames they fill are written
+         /// out together, with a single call to write().
+      void writeBlock(const std::complex<float>* v, size_t n);
+
    protected:
+         /// While set, writeBuffer() adds the frames to writeQueue
+         /// instead of writing them.
+      bool queueWrites;
+      std::vector<char> writeQueue;
+
          /** @warning This is used by FFBinaryStream's getData and
           * writeData methods to determine how to write binary encoded
           * data.  Current implementation does not use these methods
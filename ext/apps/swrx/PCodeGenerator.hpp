@@ -59,6 +59,7 @@ namespace gpstk
            cb(prn), svp(int(prn), GPSWeekZcount(0,0).convertToCommonTime()), index(0)
       {
          svp.getCurrentSixSeconds(cb);
+         updateZCount();
       }
 
       bool operator*() const { return cb.getBit(index) & 0x1; }
@@ -69,21 +70,19 @@ namespace gpstk
       {
          unsigned long z = new_index / (15345000*4);
          z *= 4;
-         if (static_cast<Epoch>(svp.getCurrentZCount()).GPSzcount32Floor() != z)
+         if (zCount != z)
          {
             std::cerr << "Regen cb" << std::endl;
             svp.setCurrentZCount(z);
             svp.getCurrentSixSeconds(cb);
+            updateZCount();
          }
          index = new_index % (15345000*4);
          return getIndex();
       }
 
       CodeIndex getIndex() const
-      {
-         unsigned long z = static_cast<Epoch>(svp.getCurrentZCount()).GPSzcount32Floor();
-         return index + z * 15345000;
-      }
+      { return index + zCount * 15345000; }
 
       bool isLastChipofX1Sequence() const
       { return (index%15345000)==15344999; }
@@ -104,9 +103,17 @@ namespace gpstk
             index-=15345000*4;
             svp.increment4ZCounts();
             svp.getCurrentSixSeconds(cb);
+            updateZCount();
          }
       }
 
+      // The Z-count of the start of cb, kept here since getting it from
+      // svp is much slower than generating a chip.
+      inline void updateZCount()
+      {
+         zCount = static_cast<Epoch>(svp.getCurrentZCount()).GPSzcount32Floor();
+      }
+
       inline static void initXSeq() __attribute__ ((constructor))
       {
          try
@@ -121,6 +128,7 @@ namespace gpstk
       CodeBuffer cb;
       SVPCodeGen svp;
       CodeIndex index;
+      unsigned long zCount;
    };
 }
 #endif
@@ -44,6 +44,7 @@
 #include <math.h>
 #include <complex>
 #include <iostream>
+#include <vector>
 
 #include "complex_math.h"
 
@@ -75,7 +76,8 @@ public:
       ca_codegen(SVPRNID),
       band(bandArg),
       prn(SVPRNID),
-      zchip_counter(0)
+      zchip_counter(0),
+      ca_epoch_counter(0)
    {
       switch(band)
       {
@@ -89,14 +91,7 @@ public:
       double phase = zchip_fraction_accum*carrier_multiplier*2.0*gpstk::PI;
       std::complex<double> carrier = sincos(phase);
 
-      bool nav_bit=(*nav_codegen);
-      int p_bit=p_modulation?((*p_codegen)^(p_nav?nav_bit:0)):0;
-      int ca_bit=ca_modulation?((*ca_codegen)^(ca_nav?nav_bit:0)):0;
-
-      // Must follow guidelines in Table 3-IV of IS-GPS-200D
-      std::complex<double> sample(
-         ca_bit?(ca_amplitude):(-ca_amplitude),
-         p_bit ?(p_amplitude):(-p_amplitude));
+      std::complex<double> sample = getCode();
       
       if (!code_only)
          sample *= carrier_amplitude * carrier;
@@ -104,6 +99,46 @@ public:
       return sample;
    }
 
+   // Adds the next n samples to out and moves the state past them. This
+   // is the same as n calls to getSample() and incrementState(), except
+   // that the code of each chip of the block is looked up once, and the
+   // carrier is rotated from sample to sample (see rotateAdd()).
+   void addBlock(std::complex<float>* out, size_t n)
+   {
+      const double step = zchips_per_sample + doppler;
+      const double start = zchip_fraction_accum;
+      const double phase = start*carrier_multiplier*2.0*gpstk::PI;
+
+      // The chip of sample k is the number of times the state would have
+      // wrapped by then.
+      const long end = chipsBefore(start + n*step);
+      const long used = chipsBefore(start + (n-1)*step) + 1;
+      chipBlock.resize(used);
+      float ca = getCALevel();
+      for (long i=0; i<used; i++)
+      {
+         if (i && nextChip())
+            ca = getCALevel();
+         chipBlock[i] = std::complex<float>(ca, getPLevel());
+      }
+      for (long i=used; i<=end; i++)
+         nextChip();
+      zchip_fraction_accum = start + n*step - end;
+
+      if (code_only)
+      {
+         for (size_t k=0; k<n; k++)
+            out[k] += chipBlock[chipsBefore(start + k*step)];
+         return;
+      }
+
+      codeBlock.resize(n);
+      for (size_t k=0; k<n; k++)
+         codeBlock[k] = chipBlock[chipsBefore(start + k*step)];
+      rotateAdd(&codeBlock[0], out, n, carrier_amplitude, phase,
+                step*carrier_multiplier*2.0*gpstk::PI);
+   }
+
    void incrementState()
    {
       /* Increment internal state to prepare for the next call */
@@ -136,31 +171,69 @@ public:
 
 private:
 
+   // The code (and nav) part of the sample
+   std::complex<double> getCode() const
+   {
+      // Must follow guidelines in Table 3-IV of IS-GPS-200D
+      return std::complex<double>(getCALevel(), getPLevel());
+   }
+
+   double getCALevel() const
+   {
+      int ca_bit=ca_modulation?((*ca_codegen)^(ca_nav?*nav_codegen:0)):0;
+      return (2*ca_bit-1)*ca_amplitude;
+   }
+
+   double getPLevel() const
+   {
+      int p_bit=p_modulation?((*p_codegen)^(p_nav?*nav_codegen:0)):0;
+      // without a branch, since the P code bits are as good as random
+      return (2*p_bit-1)*p_amplitude;
+   }
+
    void handleWrap()
    {
       while (zchip_fraction_accum>1.0)
       {
-         if(zchip_counter==9)
-         {
-            if(ca_codegen.isLastInSequence())
-            {
-               if(ca_epoch_counter==19)
-               {
-                  ++nav_codegen;
-                  ca_epoch_counter=0;            
-               } else ++ca_epoch_counter;
-            }
-            ++ca_codegen;
-            zchip_counter=0;
-         } 
-         else
-            ++zchip_counter;
-
-         ++p_codegen; 
+         nextChip();
          zchip_fraction_accum-=1.0;
       }
    }
 
+   // The number of chips moved by the time zchip_fraction_accum, starting
+   // below one, gets up to accum
+   static long chipsBefore(double accum)
+   {
+      const long chips = static_cast<long>(accum);
+      return (chips > 0) ? chips : 0;
+   }
+
+   // Moves to the next P chip, and to the next C/A chip and nav bit when
+   // it is time to. Returns true if the C/A chip changed.
+   bool nextChip()
+   {
+      bool ca_changed = false;
+      if(zchip_counter==9)
+      {
+         if(ca_codegen.isLastInSequence())
+         {
+            if(ca_epoch_counter==19)
+            {
+               ++nav_codegen;
+               ca_epoch_counter=0;            
+            } else ++ca_epoch_counter;
+         }
+         ++ca_codegen;
+         zchip_counter=0;
+         ca_changed = true;
+      } 
+      else
+         ++zchip_counter;
+
+      ++p_codegen; 
+      return ca_changed;
+   }
+
 public:
    // yea, this is klunky to expose all these but we aren't checking
    // for an invariants so...
@@ -188,6 +261,10 @@ public:
    int prn;
    int zchip_counter;     // Counts 0-9 to tell us when to move to the next C/A chip
    int ca_epoch_counter;  // Counts 0-19 to tell us when to move to the next NAV data bit
+
+private:
+   // scratch for addBlock()
+   std::vector< std::complex<float> > chipBlock, codeBlock;
 };
 
 #endif
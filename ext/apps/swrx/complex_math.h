@@ -40,6 +40,12 @@
 #define COMPLEXMATH_H
 
 #include <complex>
+#include <cmath>
+#include <cstddef>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #ifndef round
    #define round(x)   floor(x+.5)
@@ -53,6 +59,90 @@ static inline std::complex<double> sincos(double radians)
    return std::complex<double>(real,imag);
 }
 
+//-----------------------------------------------------------------------------
+// Adds in[k] * amplitude * exp(j(phase + k*step)) to out[k], for k < n.
+// The carrier is rotated from one sample to the next instead of computed
+// for each, on four interleaved lanes so that the multiplies of one sample
+// don't wait on those of the previous one, two to an SSE2 register where
+// available.
+//-----------------------------------------------------------------------------
+static inline void rotateAdd(const std::complex<float>* in,
+                             std::complex<float>* out, size_t n,
+                             double amplitude, double phase, double step)
+{
+   double cr[4], ci[4];
+   for (int j=0; j<4; j++)
+   {
+      cr[j] = amplitude * cos(phase + j*step);
+      ci[j] = amplitude * sin(phase + j*step);
+   }
+   const double rr = cos(4*step), ri = sin(4*step);
+
+   const float* x = reinterpret_cast<const float*>(in);
+   float* y = reinterpret_cast<float*>(out);
+   size_t k=0;
+
+#ifdef __SSE2__
+   __m128d cr01 = _mm_loadu_pd(cr), cr23 = _mm_loadu_pd(cr+2);
+   __m128d ci01 = _mm_loadu_pd(ci), ci23 = _mm_loadu_pd(ci+2);
+   const __m128d vrr = _mm_set1_pd(rr), vri = _mm_set1_pd(ri);
+   for (; k+4<=n; k+=4)
+   {
+      // split four samples into their real and imaginary parts
+      const __m128 a = _mm_loadu_ps(x+2*k), b = _mm_loadu_ps(x+2*k+4);
+      const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2,0,2,0));
+      const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3,1,3,1));
+      const __m128d xr01 = _mm_cvtps_pd(re);
+      const __m128d xr23 = _mm_cvtps_pd(_mm_movehl_ps(re, re));
+      const __m128d xi01 = _mm_cvtps_pd(im);
+      const __m128d xi23 = _mm_cvtps_pd(_mm_movehl_ps(im, im));
+
+      const __m128 yr = _mm_movelh_ps(
+         _mm_cvtpd_ps(_mm_sub_pd(_mm_mul_pd(xr01, cr01),
+                                 _mm_mul_pd(xi01, ci01))),
+         _mm_cvtpd_ps(_mm_sub_pd(_mm_mul_pd(xr23, cr23),
+                                 _mm_mul_pd(xi23, ci23))));
+      const __m128 yi = _mm_movelh_ps(
+         _mm_cvtpd_ps(_mm_add_pd(_mm_mul_pd(xr01, ci01),
+                                 _mm_mul_pd(xi01, cr01))),
+         _mm_cvtpd_ps(_mm_add_pd(_mm_mul_pd(xr23, ci23),
+                                 _mm_mul_pd(xi23, cr23))));
+      _mm_storeu_ps(y+2*k, _mm_add_ps(_mm_loadu_ps(y+2*k),
+                                      _mm_unpacklo_ps(yr, yi)));
+      _mm_storeu_ps(y+2*k+4, _mm_add_ps(_mm_loadu_ps(y+2*k+4),
+                                        _mm_unpackhi_ps(yr, yi)));
+
+      __m128d t = _mm_sub_pd(_mm_mul_pd(cr01, vrr), _mm_mul_pd(ci01, vri));
+      ci01 = _mm_add_pd(_mm_mul_pd(cr01, vri), _mm_mul_pd(ci01, vrr));
+      cr01 = t;
+      t = _mm_sub_pd(_mm_mul_pd(cr23, vrr), _mm_mul_pd(ci23, vri));
+      ci23 = _mm_add_pd(_mm_mul_pd(cr23, vri), _mm_mul_pd(ci23, vrr));
+      cr23 = t;
+   }
+   _mm_storeu_pd(cr, cr01);
+   _mm_storeu_pd(cr+2, cr23);
+   _mm_storeu_pd(ci, ci01);
+   _mm_storeu_pd(ci+2, ci23);
+#endif
+
+   for (; k<n; k+=4)
+   {
+      const int lanes = (n-k < 4) ? n-k : 4;
+      for (int j=0; j<lanes; j++)
+      {
+         const double xr = x[2*(k+j)], xi = x[2*(k+j)+1];
+         y[2*(k+j)]   += xr*cr[j] - xi*ci[j];
+         y[2*(k+j)+1] += xr*ci[j] + xi*cr[j];
+      }
+      for (int j=0; j<4; j++)
+      {
+         const double t = cr[j]*rr - ci[j]*ri;
+         ci[j] = cr[j]*ri + ci[j]*rr;
+         cr[j] = t;
+      }
+   }
+}
+
 static inline std::complex<int> quantize(const std::complex<double> x)
 {
    return std::complex<int>(
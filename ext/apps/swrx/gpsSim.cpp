@@ -55,6 +55,8 @@
 #include <complex>
 #include <iostream>
 #include <list>
+#include <vector>
+#include <pthread.h>
 
 #include "BasicFramework.hpp"
 #include "CommandOption.hpp"
@@ -119,11 +121,35 @@ public:
 
    IQStream *output;
 
+   // Number of threads generating the samples
+   unsigned threads;
+
+   // The samples are made this many at a time
+   static const size_t blockSize = 16384;
+
+   // The current block: the samples of each SV, the sum of them for each
+   // band, and the output, with the bands interleaved.
+   vector< vector< complex<float> > > svBlock;
+   vector< vector< complex<float> > > bandBlock;
+   vector< complex<float> > outBlock;
+
+   // The noise of each band
+   vector<NormalGenerator> noiseGen;
+
+   // Makes n samples, starting at sample, of the SVs/bands whose index
+   // modulo threads is thread.
+   void addSVs(unsigned thread, size_t n);
+   void finishBands(unsigned thread, size_t n, unsigned long sample);
 
 protected:
    virtual void process();
+
+   // Runs one step of a block on all the threads
+   void runThreads(void* (*function)(void*), size_t n, unsigned long sample);
 };
 
+const size_t GpsSim::blockSize;
+
 GpsSim::GpsSim() throw() :
    BasicFramework("gpsSim", "A simple simulation of a the GPS signal."),
    samples_per_period(20.0),
@@ -138,7 +164,8 @@ GpsSim::GpsSim() throw() :
    time_step(1.0/20e6),
    interFreq(0.42e6),
    periods_to_generate(4096),
-   codeOnly(false)
+   codeOnly(false),
+   threads(1)
 {}
 
 bool GpsSim::initialize(int argc, char *argv[]) throw()
@@ -194,6 +221,11 @@ bool GpsSim::initialize(int argc, char *argv[]) throw()
       outputOpt('o', "output",
                  "Where to write the output. The default is stdout");
 
+   CommandOptionWithAnyArg
+      threadsOpt('j', "threads",
+                 "The number of threads making the samples. The SVs are "
+                 "shared out to them. The default is 1.");
+
    if (!BasicFramework::initialize(argc,argv))
       return false;
 
@@ -255,6 +287,9 @@ bool GpsSim::initialize(int argc, char *argv[]) throw()
    if (codeOnlyOpt.getCount())
       codeOnly = true;
 
+   if (threadsOpt.getCount())
+      threads = std::max(1L, asInt(threadsOpt.getValue()[0]));
+
    if (freqErrOpt.getCount())
       freqErr = StringUtils::asDouble(freqErrOpt.getValue()[0]) * 1e-6;
    else
@@ -356,56 +391,133 @@ bool GpsSim::initialize(int argc, char *argv[]) throw()
 
 }
 
-void GpsSim::process()
+// The arguments given to the threads for one step of a block
+struct SimJob
+{
+   GpsSim* sim;
+   unsigned thread;
+   size_t n;
+   unsigned long sample;
+};
+
+static void* addSVsJob(void* arg)
+{
+   SimJob* job = static_cast<SimJob*>(arg);
+   job->sim->addSVs(job->thread, job->n);
+   return NULL;
+}
+
+static void* finishBandsJob(void* arg)
 {
-   // Used to accumulate up the samples
-   vector< complex<float> > accum(LO_COUNT);
+   SimJob* job = static_cast<SimJob*>(arg);
+   job->sim->finishBands(job->thread, job->n, job->sample);
+   return NULL;
+}
 
-   // simulation time, in seconds
-   double rx_time = 0;
-   int max_samples = periods_to_generate*static_cast<int>(samples_per_period);
 
-   for(int sample=0; sample < max_samples; ++sample)
+void GpsSim::addSVs(unsigned thread, size_t n)
+{
+   list<SVSource*>::iterator i = sv_sources.begin();
+   for (size_t s=0; s < svBlock.size(); s++, i++)
    {
-      rx_time += time_step;
+      if (s % threads != thread)
+         continue;
+      fill(svBlock[s].begin(), svBlock[s].begin() + n, complex<float>(0));
+      (*i)->addBlock(&svBlock[s][0], n);
+   }
+}
 
-      // Clear out our accumulators
-      for (int i=0; i < LO_COUNT; i++)
-         accum[i] = (0.0);
 
-      // Sum the signals from each SV
-      list<SVSource*>::iterator i;
-      for(i = sv_sources.begin(); i != sv_sources.end(); i++)
+void GpsSim::finishBands(unsigned thread, size_t n, unsigned long sample)
+{
+   for (int b=thread; b < LO_COUNT; b += threads)
+   {
+      // Sum the signals from each SV, always in the same order so that
+      // the output doesn't depend on the number of threads
+      vector< complex<float> >& accum = bandBlock[b];
+      fill(accum.begin(), accum.begin() + n, complex<float>(0));
+      list<SVSource*>::iterator i = sv_sources.begin();
+      for (size_t s=0; s < svBlock.size(); s++, i++)
       {
-         SVSource* src = *i;
-         int band=src->band-1;
-         accum[band] += src->getSample();
-         src->incrementState();
+         if ((*i)->band-1 != b)
+            continue;
+         for (size_t k=0; k<n; k++)
+            accum[k] += svBlock[s][k];
       }
 
-      // For each local oscilator frequency...
-      for (int i=0; i<LO_COUNT; i++)
-      {
-         // Compute the local oscilator and the sample noise
-         complex<double> lo = sincos(omega_lo[i] * sample);
-         complex<double> noise(generate_normal_rv()*noise_amplitude,
-                                  generate_normal_rv()*noise_amplitude);
-
-         // Heterodyne the signals
-         if (!codeOnly)
-         accum[i] *= conj(lo);
+      // Heterodyne the signals
+      vector< complex<float> > mixed(n);
+      if (codeOnly)
+         mixed.assign(accum.begin(), accum.begin() + n);
+      else
+         rotateAdd(&accum[0], &mixed[0], n, 1.0,
+                   -omega_lo[b] * sample, -omega_lo[b]);
+
+      // and add the noise
+      noiseGen[b].addTo(reinterpret_cast<float*>(&mixed[0]), 2*n,
+                        noise_amplitude);
+
+      // Apply receiver gain, with the bands one after the other
+      for (size_t k=0; k<n; k++)
+         outBlock[k*LO_COUNT + b] = mixed[k] * static_cast<float>(gain);
+   }
+}
 
-         // and add the noise
-         accum[i] += noise;
 
-         // Apply receiver gain
-         accum[i] *= gain;
+void GpsSim::runThreads(void* (*function)(void*), size_t n,
+                        unsigned long sample)
+{
+   vector<SimJob> jobs(threads);
+   for (unsigned t=0; t < threads; t++)
+   {
+      jobs[t].sim = this;
+      jobs[t].thread = t;
+      jobs[t].n = n;
+      jobs[t].sample = sample;
+   }
+   if (threads == 1)
+   {
+      function(&jobs[0]);
+      return;
+   }
 
-         // And output the samples
-         *output << accum[i];
+   vector<pthread_t> thread_id(threads);
+   for (unsigned t=0; t < threads; t++)
+   {
+      int rc = pthread_create(&thread_id[t], NULL, function, &jobs[t]);
+      if (rc)
+      {
+         cerr << "ERROR; return code from pthread_create() is " << rc << endl;
+         exit(-1);
       }
    }
+   for (unsigned t=0; t < threads; t++)
+      pthread_join(thread_id[t], NULL);
+}
+
+
+void GpsSim::process()
+{
+   svBlock.assign(sv_sources.size(), vector< complex<float> >(blockSize));
+   bandBlock.assign(LO_COUNT, vector< complex<float> >(blockSize));
+   outBlock.resize(blockSize * LO_COUNT);
+   for (int i=0; i < LO_COUNT; i++)
+      noiseGen.push_back(NormalGenerator(i+1));
 
+   unsigned long max_samples = static_cast<unsigned long>(
+      periods_to_generate * samples_per_period);
+
+   for (unsigned long sample=0; sample < max_samples; sample += blockSize)
+   {
+      size_t n = std::min<unsigned long>(blockSize, max_samples - sample);
+
+      runThreads(addSVsJob, n, sample);
+      runThreads(finishBandsJob, n, sample);
+
+      // And output the samples
+      output->writeBlock(&outBlock[0], n * LO_COUNT);
+   }
+   output->flush();
 }
 
 int main(int argc, char *argv[])
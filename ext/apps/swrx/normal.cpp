@@ -37,6 +37,10 @@
 #include <stdlib.h>
 #include <math.h>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "normal.hpp"
 
 const int log_two_of_sum_count=4;  // Higher number means better approximation
@@ -54,6 +58,85 @@ generate_normal_rv(void) {
 }
 
 
+
+NormalGenerator::NormalGenerator(uint64_t seed)
+{
+  /* Spread the seed over the state with splitmix64, which never gives
+     an all zero state */
+  uint64_t* words[4] = {&s0[0], &s0[1], &s1[0], &s1[1]};
+  for (int i=0; i<4; i++) {
+    uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    *words[i] = z ^ (z >> 31);
+  }
+}
+
+
+void
+NormalGenerator::addTo(float* out, size_t n, double sigma) {
+  /* Each RV is the sum of eight uniform RVs in [-32768, 32767], which has
+     a mean of -4 and a variance of 8*(65536^2-1)/12 */
+  const float scale = sigma / sqrt(8.0*(65536.0*65536.0-1.0)/12.0);
+  size_t i=0;
+
+#ifdef __SSE2__
+  __m128i a = _mm_loadu_si128(reinterpret_cast<__m128i*>(s0));
+  __m128i b = _mm_loadu_si128(reinterpret_cast<__m128i*>(s1));
+  const __m128i bias = _mm_set1_epi16(-32768);
+  const __m128i ones = _mm_set1_epi16(1);
+  const __m128i four = _mm_set1_epi32(4);
+  const __m128 vscale = _mm_set1_ps(scale);
+  for (; i+4<=n; i+=4) {
+    __m128i sum = four;
+    for (int j=0; j<4; j++) {
+      /* one step of both xorshift128+ generators */
+      __m128i x = a, y = b;
+      a = y;
+      x = _mm_xor_si128(x, _mm_slli_epi64(x, 23));
+      b = _mm_xor_si128(_mm_xor_si128(x, y),
+                        _mm_xor_si128(_mm_srli_epi64(x, 17),
+                                      _mm_srli_epi64(y, 26)));
+      __m128i r = _mm_xor_si128(_mm_add_epi64(b, y), bias);
+      /* adds the pairs of 16 bit words into 32 bit ones */
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(r, ones));
+    }
+    __m128 v = _mm_mul_ps(_mm_cvtepi32_ps(sum), vscale);
+    _mm_storeu_ps(out+i, _mm_add_ps(_mm_loadu_ps(out+i), v));
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(s0), a);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(s1), b);
+#else
+  for (; i+4<=n; i+=4) {
+    int32_t sum[4] = {4, 4, 4, 4};
+    for (int j=0; j<4; j++) {
+      for (int k=0; k<2; k++) {
+        uint64_t x = s0[k], y = s1[k];
+        s0[k] = y;
+        x ^= x << 23;
+        s1[k] = x ^ y ^ (x >> 17) ^ (y >> 26);
+        uint64_t r = s1[k] + y;
+        for (int h=0; h<2; h++) {
+          sum[2*k+h] += static_cast<int32_t>(r & 0xffff) - 32768;
+          sum[2*k+h] += static_cast<int32_t>((r >> 16) & 0xffff) - 32768;
+          r >>= 32;
+        }
+      }
+    }
+    for (int k=0; k<4; k++)
+      out[i+k] += sum[k] * scale;
+  }
+#endif
+
+  if (i<n) {
+    float last[4] = {0, 0, 0, 0};
+    addTo(last, 4, sigma);
+    for (int k=0; i+k<n; k++)
+      out[i+k] += last[k];
+  }
+}
+
+
 #ifdef UNIT_TEST
 #include <stdlib.h>
 #include <stdio.h>
@@ -73,6 +156,18 @@ main(int argc, char *argv[]) {
  printf("1st moment: %lf (should be near 0.0)\n",moment_1/100000.0);
  printf("2nd moment: %lf (should be near 1.0)\n",moment_2/100000.0);
 
+ float block[100000] = {0};
+ NormalGenerator gen;
+ gen.addTo(block, 100000, 1.0);
+ moment_1=moment_2=0.0;
+ for(i=0;i<100000;i++) {
+   moment_1+=block[i];
+   moment_2+=block[i]*block[i];
+ }
+
+ printf("block 1st moment: %lf (should be near 0.0)\n",moment_1/100000.0);
+ printf("block 2nd moment: %lf (should be near 1.0)\n",moment_2/100000.0);
+
  return 0;
 }
 #endif
@@ -37,6 +37,29 @@
 #ifndef NORMAL_HPP
 #define NORMAL_HPP
 
+#include <stddef.h>
+#include <gpstkplatform.h>
+
 extern double generate_normal_rv();
 
+// Generates (mean=0, var=1) Gaussian RV approximations a block at a time.
+// Like generate_normal_rv() this sums uniform RVs, eight 16 bit ones per
+// RV, but these come from a pair of xorshift128+ generators that are
+// stepped together (with SSE2 where available) instead of from rand().
+// Each object has its own state, so one may be used by each thread.
+class NormalGenerator
+{
+public:
+   NormalGenerator(uint64_t seed=1);
+
+   // Adds sigma times the next n RVs to out. The RVs are made four at a
+   // time; when n is not a multiple of four the rest of the last four
+   // are dropped.
+   void addTo(float* out, size_t n, double sigma);
+
+private:
+   // The state of the two generators
+   uint64_t s0[2], s1[2];
+};
+
 #endif
@@ -48,6 +48,7 @@ g++ -o trackerMT trackerMT.o /.../gpstk/dev/apps/swrx/simlib.a /.../gpstk/dev/sr
 #include <complex>
 #include <iostream>
 #include <list>
+#include <ctime>
 #include <pthread.h>
 
 #include "BasicFramework.hpp"
@@ -75,6 +76,7 @@ using namespace std;
 struct Buffer // input buffer
 {
    vector< complex<float> > arr;
+   vector< complex<short> > sarr; // used with --fast
 };
 
 struct Par // Parameters to pass to Pthread function.
@@ -86,6 +88,7 @@ struct Par // Parameters to pass to Pthread function.
    int *count;
    NavFramer *nf;
    bool v;
+   bool fast;
 };
 
 extern "C" void *Cfunction(void*); // C-style function to be called with pthreads
@@ -121,6 +124,7 @@ private:
    IQStream *input;
    unsigned iadMax;
    int numTrackers;
+   bool fast;
 };
 
 //-----------------------------------------------------------------------------
@@ -128,7 +132,7 @@ RxSim::RxSim() throw() :
    BasicFramework("rxSim", "A simulation of a gps receiver."),
    cc(NULL), tr(0), band(1), gain(1), fakeL2(false),
    timeStep(50e-9), interFreq(0.42e6),
-   timeLimit(9e99), input(NULL), iadMax(20460)
+   timeLimit(9e99), input(NULL), iadMax(20460), fast(false)
 {}
 
 bool RxSim::initialize(int argc, char *argv[]) throw()
@@ -188,6 +192,12 @@ bool RxSim::initialize(int argc, char *argv[]) throw()
       bandsOpt('b', "bands",
                "The number of complex samples per epoch. The default is 2.");
 
+   CommandOptionNoArg
+      fastOpt('\0', "fast",
+              "Correlate blocks of integer samples with the FastCorrelator "
+              "instead of one sample at a time. The samples must fit in 8 "
+              "bits, as they do with quantization 1 or 2.");
+
    if (!BasicFramework::initialize(argc,argv))
       return false;
 
@@ -205,6 +215,8 @@ bool RxSim::initialize(int argc, char *argv[]) throw()
    if (interFreqOpt.getCount())
       interFreq = asDouble(interFreqOpt.getValue().front()) * 1e6;
 
+   fast = fastOpt.getCount() > 0;
+
    numTrackers = codeOpt.getCount();
    for (int i=0; i < (int)codeOpt.getCount(); i++)
    {
@@ -254,7 +266,7 @@ bool RxSim::initialize(int argc, char *argv[]) throw()
       if (spacing < timeStep)
          spacing = timeStep;
 
-      tr[i] = new EMLTracker(*cc, spacing);
+      tr.push_back(new EMLTracker(*cc, spacing));
 
       if (dllAlphaOpt.getCount())
          tr[i]->dllAlpha = asDouble(dllAlphaOpt.getValue()[0]);
@@ -314,6 +326,8 @@ bool RxSim::initialize(int argc, char *argv[]) throw()
       cout << "# Taking input from " << input->filename
            << " (" << input->bands << " samples/epoch)" << endl
            << "# Rx gain level: " << gain << endl;
+      if (fast)
+         cout << "# Using the FastCorrelator" << endl;
    }
 
    return true;
@@ -344,30 +358,52 @@ void RxSim::process()
       count[i]=0;
    }
 
-   complex<float> s;
-   while (*input >> s)
+   clock_t ticks = clock();
+   double dataTime = 0;
+   int b = 0;
+   while (*input)
    {
-      Buffer b;
-      b.arr.push_back(s);
-      dataPoint++;
-      int index = 0;
-      int bufferSize = 40*16367;
-      while(index < bufferSize) // Fill input buffer
+      // Fill the input buffer with the samples of our band
+      Buffer buf;
+      const int bufferSize = 40*16367;
+      if (fast)
+      {
+         buf.sarr.reserve(bufferSize);
+         complex<short> s;
+         while ((int)buf.sarr.size() < bufferSize && *input >> s)
+         {
+            if (b == band-1 || input->bands==1)
+               buf.sarr.push_back(s);
+            b = (b+1) % input->bands;
+         }
+      }
+      else
       {
-         *input >> s;
-         b.arr.push_back(s);
-         index++;
-         dataPoint++;
+         buf.arr.reserve(bufferSize);
+         complex<float> s;
+         while ((int)buf.arr.size() < bufferSize && *input >> s)
+         {
+            if (b == band-1 || input->bands==1)
+               buf.arr.push_back(s);
+            b = (b+1) % input->bands;
+         }
       }
+      int samples = fast ? buf.sarr.size() : buf.arr.size();
+      if (samples == 0)
+         break;
+      dataPoint += samples;
+      dataTime += samples * timeStep;
+
       for(int i = 0; i < numTrackers; i++)
       {
          p[i].dp = dataPoint; // Set parameters for each tracker.
-         p[i].bufferSize = bufferSize;
-         p[i].s = &b;
+         p[i].bufferSize = samples;
+         p[i].s = &buf;
          p[i].count = &count[i];
          p[i].tr = tr[i];
          p[i].nf = &nf[i];
          p[i].v = (verboseLevel);
+         p[i].fast = fast;
 
    // Split
          rc = pthread_create( &thread_id[i], &attr, Cfunction, &p[i] ) ;
@@ -391,7 +427,12 @@ void RxSim::process()
       if (cc->localTime > timeLimit)
          break;
    }
-   delete thread_id;
+   if (verboseLevel)
+      cout << "# Tracked " << numTrackers << " signal(s) over "
+           << fixed << setprecision(1) << dataTime * 1e3 << " ms of data in "
+           << double(clock() - ticks) / CLOCKS_PER_SEC * 1e3
+           << " ms of CPU time" << endl;
+   delete[] thread_id;
    pthread_attr_destroy(&attr);
 }
 
@@ -414,43 +455,63 @@ int main(int argc, char *argv[])
    { cerr << "Caught unknown exception" << endl; }
 }
 
+// Hands the nav bit of a tracker that was just dumped to its framer
+static void navBit(Par *par, int dp)
+{
+   EMLTracker *tr = par->tr;
+   int *count = par->count;
+   NavFramer *nf = par->nf;
+
+   if(par->v)
+      tr->dump(cout);
+
+   if(tr->navChange)
+   {
+      nf->process(*tr, dp,
+                  (float)tr->localReplica.getCodePhaseOffsetSec()*1e6);
+      *count = 0;
+   }
+   if(*count == 20)
+   // The *20* depends on the tracker updating every C/A period.
+   {
+      *count = 0;
+      nf->process(*tr, dp,
+                  (float)tr->localReplica.getCodePhaseOffsetSec()*1e6);
+   }
+
+   *count = *count + 1;
+}
+
 void *Cfunction(void* p)
 {
    Par *par = (Par*)p;
 
    EMLTracker *tr = par->tr;
-   int *count = par->count;
-   NavFramer *nf = par->nf;
    int bufferSize = par->bufferSize;
    int dp = par->dp - bufferSize;
    Buffer *b = par->s;
-   bool v = par->v;
 
    int index = 0;
 
-   while(index < bufferSize + 1) // number of data points to track before join.
+   if (par->fast)
    {
-      if (tr->process(b->arr[index]))
+      while (index < bufferSize)
       {
-         if(v)
-            tr->dump(cout);
-
-         if(tr->navChange)
-         {
-            nf->process(*tr, dp,
-                     (float)tr->localReplica.getCodePhaseOffsetSec()*1e6);
-            *count = 0;
-         }
-         if(*count == 20)
-         // The *20* depends on the tracker updating every C/A period.
-         {
-            *count = 0;
-            nf->process(*tr, dp,
-                     (float)tr->localReplica.getCodePhaseOffsetSec()*1e6);
-         }
-
-         *count = *count + 1;
+         size_t n = bufferSize - index;
+         bool dumped = tr->process(&b->sarr[index], n);
+         index += n;
+         dp += n;
+         if (dumped)
+            navBit(par, dp);
       }
+      pthread_exit(NULL);
+      return NULL;
+   }
+
+   while(index < bufferSize) // number of data points to track before join.
+   {
+      if (tr->process(b->arr[index]))
+         navBit(par, dp);
       index++;
       dp++;
    }
@@ -39,6 +39,11 @@
 #include "SVPCodeGen.hpp"
 #include "GPSWeekZcount.hpp"
 
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 namespace gpstk
 {
@@ -100,12 +105,99 @@ namespace gpstk
    
          // Starting at the beginning of the interval, step through
          // the six second period loading the code buffer as we go.
-      for ( long i=0;i<NUM_6SEC_WORDS;++i )
+      X2Seq.xorWords( &X1Seq[0], &pcb[0], NUM_6SEC_WORDS, X2count );
+   }
+
+   namespace
+   {
+         // Satellites shared by the threads of getCurrentSixSeconds()
+      struct SixSecondsJob
+      {
+         const std::vector<SVPCodeGen*>* pGens;
+         const std::vector<CodeBuffer*>* pBufs;
+         size_t next;
+#ifdef GPSTK_HAVE_PTHREAD
+         pthread_mutex_t mutex;
+#endif
+      };
+
+      void runSixSecondsJob(SixSecondsJob& job)
+      {
+         while (true)
+         {
+#ifdef GPSTK_HAVE_PTHREAD
+            pthread_mutex_lock(&job.mutex);
+#endif
+            size_t index = job.next++;
+#ifdef GPSTK_HAVE_PTHREAD
+            pthread_mutex_unlock(&job.mutex);
+#endif
+            if (index >= job.pGens->size()) break;
+            (*job.pGens)[index]->getCurrentSixSeconds( *(*job.pBufs)[index] );
+         }
+      }
+   }
+}     // end of namespace
+
+#ifdef GPSTK_HAVE_PTHREAD
+   // C-style function to be called with pthreads
+extern "C"
+{
+   static void* sixSecondsThread(void* pJob)
+   {
+      gpstk::runSixSecondsJob( *static_cast<gpstk::SixSecondsJob*>(pJob) );
+      return NULL;
+   }
+}
+#endif
+
+namespace gpstk
+{
+   void SVPCodeGen::getCurrentSixSeconds( const std::vector<SVPCodeGen*>& gens,
+                                          const std::vector<CodeBuffer*>& pcbs,
+                                          int numThreads )
+   {
+      if (gens.size() != pcbs.size())
+      {
+         gpstk::Exception e("Must provide one CodeBuffer per SVPCodeGen");
+         GPSTK_THROW(e);
+      }
+
+      SixSecondsJob job;
+      job.pGens = &gens;
+      job.pBufs = &pcbs;
+      job.next = 0;
+
+#ifdef GPSTK_HAVE_PTHREAD
+      if (numThreads <= 0)
       {
-         pcb[i] = X1Seq[i] ^ X2Seq[X2count];
-         X2count += MAX_BIT;
-         if (X2count>=MAX_X2_TEST) X2count -= MAX_X2_TEST;
+         long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+         numThreads = (ncpu > 0) ? static_cast<int>(ncpu) : 1;
       }
+      if (static_cast<size_t>(numThreads) > gens.size())
+         numThreads = static_cast<int>(gens.size());
+
+      pthread_mutex_init(&job.mutex, NULL);
+
+         // The calling thread does its share of the work too
+      std::vector<pthread_t> threads(numThreads > 1 ? numThreads - 1 : 0);
+      size_t started = 0;
+      for (size_t i=0; i<threads.size(); ++i)
+      {
+         if (pthread_create(&threads[i], NULL, sixSecondsThread, &job) != 0)
+            break;
+         ++started;
+      }
+#endif
+
+      runSixSecondsJob(job);
+
+#ifdef GPSTK_HAVE_PTHREAD
+      for (size_t i=0; i<started; ++i)
+         pthread_join(threads[i], NULL);
+
+      pthread_mutex_destroy(&job.mutex);
+#endif
    }
 
    void SVPCodeGen::increment4ZCounts( )
@@ -38,6 +38,7 @@
 #ifndef SVPCODEGEN_HPP
 #define SVPCODEGEN_HPP
 
+#include <vector>
 #include "CommonTime.hpp"
 #include "PCodeConst.hpp"
 #include "CodeBuffer.hpp"
@@ -115,6 +116,17 @@ namespace gpstk
        *  the sequence.
        */
       void getCurrentSixSeconds( CodeBuffer& pcb );
+
+      /**
+       *  Fill pcbs[i] with the current six seconds of code of gens[i],
+       *  as getCurrentSixSeconds( CodeBuffer& ) does, for all the
+       *  satellites at once.  The satellites are shared out between
+       *  'numThreads' threads (0 means one per processor) that take
+       *  the next satellite as they finish the previous one.
+       */
+      static void getCurrentSixSeconds( const std::vector<SVPCodeGen*>& gens,
+                                        const std::vector<CodeBuffer*>& pcbs,
+                                        int numThreads = 0 );
          
       /**
        * Generally, the only action is to increment the Z-count by 
@@ -45,6 +45,9 @@
 #include <cstring>
 #include <stdio.h>
 #include <string>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
    // Project headers
 #include "Exception.hpp"
@@ -227,6 +230,72 @@ namespace gpstk
       isInit = false;
    }
    
+   long X2Sequence::xorWords( const uint32_t* x1, unsigned long* out,
+                              long n, long i )
+   {
+      while (n>0)
+      {
+         long adjustedCount = i + X2A_EPOCH_DELAY;
+
+            // The words that take bits from both ends of the sequence
+            // are rare, leave them to operator[].
+         if ( (adjustedCount+MAX_BIT) > MAX_X2_COUNT )
+         {
+            *out++ = *x1++ ^ (*this)[i];
+            --n;
+            i += MAX_BIT;
+            if (i>=MAX_X2_TEST) i -= MAX_X2_TEST;
+            continue;
+         }
+
+            // Number of words before the next one that wraps
+         long m = (MAX_X2_COUNT - adjustedCount - MAX_BIT) / MAX_BIT + 1;
+         if (m>n) m = n;
+
+         const uint32_t* w = &bitsP[adjustedCount / MAX_BIT];
+         int offset = adjustedCount % MAX_BIT;
+         long k = 0;
+
+#ifdef __SSE2__
+            // Four words at a time.  A shift by 32 gives zero, so an
+            // offset of zero needs no special case.
+         const __m128i left = _mm_cvtsi32_si128(offset);
+         const __m128i right = _mm_cvtsi32_si128(MAX_BIT - offset);
+         const __m128i zero = _mm_setzero_si128();
+         for (; k+4<=m; k+=4)
+         {
+            __m128i lo = _mm_loadu_si128((const __m128i*) (w+k));
+            __m128i hi = _mm_loadu_si128((const __m128i*) (w+k+1));
+            __m128i r = _mm_or_si128( _mm_sll_epi32(lo, left),
+                                      _mm_srl_epi32(hi, right) );
+            r = _mm_xor_si128( r, _mm_loadu_si128((const __m128i*) (x1+k)) );
+            if (sizeof(unsigned long)==8)
+            {
+               _mm_storeu_si128((__m128i*) (out+k), _mm_unpacklo_epi32(r, zero));
+               _mm_storeu_si128((__m128i*) (out+k+2), _mm_unpackhi_epi32(r, zero));
+            }
+            else
+               _mm_storeu_si128((__m128i*) (out+k), r);
+         }
+#endif
+
+            // Two adjacent words as one 64-bit word, so that no
+            // special case is needed for an offset of zero either.
+         for (; k<m; ++k)
+         {
+            uint64_t pair = ((uint64_t) w[k] << MAX_BIT) | w[k+1];
+            out[k] = x1[k] ^ (uint32_t) ((pair << offset) >> MAX_BIT);
+         }
+
+         out += m;
+         x1 += m;
+         n -= m;
+         i += m * MAX_BIT;
+         if (i>=MAX_X2_TEST) i -= MAX_X2_TEST;
+      }
+      return i;
+   }
+
    void X2Sequence::setEOWX2Epoch( const bool tf )
    {
       if (tf) bitsP = X2BitsEOW;
@@ -175,6 +175,18 @@ namespace gpstk
              */
          uint32_t operator[]( long i );
 
+            /** Exclusive-or 'n' consecutive words of the X2 sequence with
+             *  the words 'x1' and store the results in 'out'.  The first X2
+             *  word starts at bit 'i' (as for operator[]) and each following
+             *  one MAX_BIT bits later, wrapping at MAX_X2_TEST.  This gives
+             *  the same words as a loop over operator[], but the runs of
+             *  words between wraps are merged with a fixed shift, several
+             *  words at a time.  Returns the bit number that follows the
+             *  last word.
+             */
+         long xorWords( const uint32_t* x1, unsigned long* out,
+                        long n, long i );
+
             /**  Controls whether the X2 Epoch is set to EOW condition
              *   or normal condition.  Should only be set true for the final
              *   X2 epoch of the week.
@@ -601,9 +601,33 @@ namespace gpstk
       throw(InvalidRequest,FFStreamError)
    {
 
+      int e[4];
+      double w[4];
+      getCell(p, e, w);
+
+      return getValue(e, w);
+
+   }  // End of method 'IonexData::getValue()'
+
+
+
+      /* Get the grid cell holding a position: the indexes within the
+       * data of its four corners and their weights in the 4-point
+       * interpolation formula.
+       *
+       * @param pos             input position (Position object, in
+       *                        GEOCENTRIC coordinates).
+       * @param index           indexes of the corners E00, E10, E01, E11.
+       * @param weight          weights of these corners.
+       */
+   void IonexData::getCell( const Position& p,
+                            int index[4],
+                            double weight[4] ) const
+      throw(InvalidRequest)
+   {
+
          // this never should happen but just in case
-      Position pos(p);
-      if ( pos.getSystemName() != "Geocentric" )
+      if ( p.getCoordinateSystem() != Position::Geocentric )
       {
 
          InvalidRequest e( "Position object is not in GEOCENTRIC coordinates");
@@ -614,8 +638,6 @@ namespace gpstk
 
          // some useful declarations
       Triple ABC[4], inarg;
-      int e[4];
-      double xsum = 0.0;
 
          // the object is required for AEarth to be consistent with 
          // Position::getIonosphericPiercePoint()
@@ -636,7 +658,7 @@ namespace gpstk
 
          // get position of lower left hand grid point E00
       inarg = Triple( beta, lambda, height);
-      e[0] = getIndex( inarg, 2, ABC[0] );
+      index[0] = getIndex( inarg, 2, ABC[0] );
 
 
          // compute factors P and Q
@@ -647,28 +669,52 @@ namespace gpstk
       if ( (xp < 0) || (xp > 1) || (xq < 0) || (xq > 1) )
       {
 
-         throw(Exception("IonexData::getValue(): Wrong xp and xq factors!!!"));
+         InvalidRequest e("IonexData::getCell(): Wrong xp and xq factors!!!");
+         GPSTK_THROW(e);
 
       }
 
          // get E10's position index
       inarg = Triple( ABC[0][0], ABC[0][1]+lon[2], ABC[0][2] );
-      e[1] = getIndex( inarg, 1, ABC[1] );
+      index[1] = getIndex( inarg, 1, ABC[1] );
 
          // get E01's position index
       inarg = Triple( ABC[0][0]+lat[2], ABC[0][1], ABC[0][2] );
-      e[2] = getIndex( inarg, 1, ABC[2] );
+      index[2] = getIndex( inarg, 1, ABC[2] );
 
          // get E11's position index
       inarg = Triple( ABC[0][0]+lat[2], ABC[0][1]+lon[2], ABC[0][2] );
-      e[3] = getIndex( inarg, 1, ABC[3] );
+      index[3] = getIndex( inarg, 1, ABC[3] );
+
+         // weights of the bivariate interpolation (pag.3, IONEX manual)
+      weight[0] = (1.0-xp) * (1.0-xq);
+      weight[1] =      xp  * (1.0-xq);
+      weight[2] = (1.0-xp) *      xq;
+      weight[3] =      xp  *      xq;
+
+   }  // End of method 'IonexData::getCell()'
+
+
+
+      /* Get IONEX TEC or RMS value in a grid cell previously found
+       * with getCell().
+       *
+       * @param index           indexes of the corners of the cell.
+       * @param weight          weights of these corners.
+       *
+       * @return                Computed TEC or RMS value.
+       */
+   double IonexData::getValue( const int index[4],
+                               const double weight[4] ) const
+      throw(FFStreamError)
+   {
 
          // let's fetch the values
       double pntval[4];
       for (int i = 0; i < 4; i++)
       {
 
-         double xval( data[e[i]] );
+         double xval( data[index[i]] );
 
          if (xval != 999.9)
          {
@@ -682,18 +728,33 @@ namespace gpstk
 
       }  // End of 'for (int i = 0; i < 4; i++)...'
 
-         // bivariate interpolation (pag.3, IONEX manual)
-      xsum = (1.0-xp) * (1.0-xq) * pntval[0] +
-                  xp  * (1.0-xq) * pntval[1] +
-             (1.0-xp) *      xq  * pntval[2] +
-                  xp  *      xq  * pntval[3];
-
-      return xsum;
+      return ( weight[0] * pntval[0] + weight[1] * pntval[1] +
+               weight[2] * pntval[2] + weight[3] * pntval[3] );
 
    }  // End of method 'IonexData::getValue()'
 
 
 
+      // Return true if the other map is defined on the same grid.
+   bool IonexData::hasSameGrid(const IonexData& other) const
+      throw()
+   {
+
+      for (int i = 0; i < 3; i++)
+      {
+         if ( dim[i] != other.dim[i] || lat[i] != other.lat[i] ||
+              lon[i] != other.lon[i] || hgt[i] != other.hgt[i] )
+         {
+            return false;
+         }
+      }
+
+      return true;
+
+   }  // End of method 'IonexData::hasSameGrid()'
+
+
+
       /** This function constructs a CommonTime object from the given
        * parameters.
        *
@@ -200,6 +200,42 @@ namespace gpstk
          throw(InvalidRequest,FFStreamError);
 
 
+         /** Get the grid cell holding a position: the indexes within the
+          *  data of its four corners and their weights in the 4-point
+          *  interpolation formula.
+          *
+          * The cell only depends on the grid, so it may be used with every
+          * map sharing this grid (see hasSameGrid()).
+          *
+          * @param pos             input position (Position object, in
+          *                        GEOCENTRIC coordinates).
+          * @param index           indexes of the corners E00, E10, E01, E11.
+          * @param weight          weights of these corners.
+          */
+      void getCell( const Position& pos,
+                    int index[4],
+                    double weight[4] ) const
+         throw(InvalidRequest);
+
+
+         /** Get IONEX TEC or RMS value in a grid cell previously found
+          *  with getCell().
+          *
+          * @param index           indexes of the corners of the cell.
+          * @param weight          weights of these corners.
+          *
+          * @return                Computed TEC or RMS value.
+          */
+      double getValue( const int index[4],
+                       const double weight[4] ) const
+         throw(FFStreamError);
+
+
+         /// Return true if the other map is defined on the same grid.
+      bool hasSameGrid(const IonexData& other) const
+         throw();
+
+
    protected:
 
          /** Writes a correctly formatted record from this data to stream \a s.
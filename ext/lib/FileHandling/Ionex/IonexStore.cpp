@@ -285,28 +285,190 @@ namespace gpstk
          // (i.e, TEC, RMS, ionosphere height)
       Triple tecval(0.0,0.0,0.0);
 
-         // current time check
-      if (t < getInitialTime())
+         // let's look for valid Ionex maps
+      const IonexValTypeMap* maps[2];
+      double f[2], rot[2];
+      int nmap( findMaps(t, strategy, maps, f, rot) );
+
+         // this never should happen but just in case
+      if ( RX.getCoordinateSystem() != Position::Geocentric )
       {
-         InvalidRequest e("Inadequate data before requested time");
+
+         InvalidRequest e("Position object is not in GEOCENTRIC coordinates");
+
          GPSTK_THROW(e);
+
       }
 
-      if (t > getFinalTime() )
+         // loop over the number of maps considered
+      for(int imap = 0; imap < nmap; imap++)
       {
-         InvalidRequest e("Inadequate data after requested time");
-         GPSTK_THROW(e);
-      }
 
-         // this never should happen but just in case
-      Position pos(RX);
-      if ( pos.getSystemName() != "Geocentric" )
+            // now let's take into account the rotation around the Sun,
+            // if any
+         Position pos(RX);
+         pos.theArray[1] = pos.theArray[1] + rot[imap];
+
+            // Compute TEC value
+         IonexValTypeMap::const_iterator itt = maps[imap]->find(IonexData::TEC);
+         if ( itt != maps[imap]->end() )
+         {
+            tecval[0] = tecval[0] + f[imap]*itt->second.getValue(pos);
+         }
+
+            // Compute RMS value
+         itt = maps[imap]->find(IonexData::RMS);
+         if ( itt != maps[imap]->end() )
+         {
+            tecval[1] = tecval[1] + f[imap]*itt->second.getValue(pos);
+         }
+
+      }  // End of 'for(int imap = 0; imap < nmap; imap++)...'
+
+
+         // ionosphere height in meters
+      tecval[2] = RX.theArray[2];
+
+      return tecval;
+
+   }  // End of method 'IonexStore::getIonexValue()'
+
+
+
+      /* Get IONEX TEC, RMS and ionosphere height values of many positions
+       * at the same epoch.
+       *
+       * @param t          Time tag of signal (CommonTime object)
+       * @param IPP        Positions in GEOCENTRIC coordinates.
+       * @param values     TEC, RMS and ionosphere height values, one per
+       *                   position (zero TEC and RMS if not found).
+       * @param found      For each position, false if it is outside
+       *                   the grid or on undefined values.
+       * @param strategy   Interpolation strategy, as in getIonexValue().
+       */
+   void IonexStore::getIonexValues( const CommonTime& t,
+                                    const std::vector<Position>& IPP,
+                                    std::vector<Triple>& values,
+                                    std::vector<bool>& found,
+                                    int strategy ) const
+      throw(InvalidRequest)
+   {
+
+         // the maps are looked up once for all the positions
+      const IonexValTypeMap* maps[2];
+      double f[2], rot[2];
+      int nmap( findMaps(t, strategy, maps, f, rot) );
+
+      values.assign(IPP.size(), Triple(0.0,0.0,0.0));
+      found.assign(IPP.size(), true);
+
+      for(int imap = 0; imap < nmap; imap++)
       {
 
-         InvalidRequest e("Position object is not in GEOCENTRIC coordinates");
+         IonexValTypeMap::const_iterator itt = maps[imap]->find(IonexData::TEC);
+         const IonexData* tec( itt != maps[imap]->end() ? &itt->second : 0 );
+         itt = maps[imap]->find(IonexData::RMS);
+         const IonexData* rms( itt != maps[imap]->end() ? &itt->second : 0 );
+
+            // the TEC and RMS maps usually share the grid, and so the cells
+         bool sameCell( tec != 0 && rms != 0 && tec->hasSameGrid(*rms) );
 
+         for(size_t i = 0; i < IPP.size(); i++)
+         {
+
+            if ( !found[i] )
+            {
+               continue;
+            }
+
+            try
+            {
+
+               Position pos(IPP[i]);
+               pos.theArray[1] = pos.theArray[1] + rot[imap];
+
+               int index[4];
+               double weight[4];
+
+               if (tec != 0)
+               {
+                  tec->getCell(pos, index, weight);
+                  values[i][0] = values[i][0]
+                                 + f[imap]*tec->getValue(index, weight);
+               }
+
+               if (rms != 0)
+               {
+                  if (!sameCell)
+                  {
+                     rms->getCell(pos, index, weight);
+                  }
+                  values[i][1] = values[i][1]
+                                 + f[imap]*rms->getValue(index, weight);
+               }
+
+            }
+            catch(InvalidRequest& e)
+            {
+               found[i] = false;
+            }
+            catch(FFStreamError& e)
+            {
+               found[i] = false;
+            }
+
+         }  // End of 'for(size_t i = 0; i < IPP.size(); i++)...'
+
+      }  // End of 'for(int imap = 0; imap < nmap; imap++)...'
+
+
+      for(size_t i = 0; i < IPP.size(); i++)
+      {
+
+         if ( !found[i] )
+         {
+            values[i][0] = values[i][1] = 0.0;
+         }
+
+            // ionosphere height in meters
+         values[i][2] = IPP[i].theArray[2];
+
+      }
+
+   }  // End of method 'IonexStore::getIonexValues()'
+
+
+
+      /* Find the maps to be interpolated at a given epoch.
+       *
+       * @param t          Time tag of signal (CommonTime object)
+       * @param strategy   Interpolation strategy, as in getIonexValue().
+       * @param maps       Maps to interpolate.
+       * @param f          Weights of these maps.
+       * @param rot        Rotation (degrees of longitude) to apply to the
+       *                   positions for each map.
+       *
+       * @return           Number of maps to interpolate (1 or 2).
+       */
+   int IonexStore::findMaps( const CommonTime& t,
+                             int strategy,
+                             const IonexValTypeMap* maps[2],
+                             double f[2],
+                             double rot[2] ) const
+      throw(InvalidRequest)
+   {
+
+         // current time check
+      if (t < getInitialTime())
+      {
+         InvalidRequest e("Inadequate data before requested time");
          GPSTK_THROW(e);
+      }
 
+      if (t > getFinalTime() )
+      {
+         InvalidRequest e("Inadequate data after requested time");
+         GPSTK_THROW(e);
       }
 
          //let's define the number of maps to be considered
@@ -323,45 +485,54 @@ namespace gpstk
 
          // let's look for valid Ionex maps
       CommonTime T[2];
-         // iterator
-      IonexMap::const_iterator itm = inxMaps.find(t);
-      try
+      IonexMap::const_iterator itm = inxMaps.lower_bound(t);
+
+      if ( itm == inxMaps.end() ||
+           (itm->first != t && itm == inxMaps.begin()) )
+      {
+         InvalidRequest e("IonexStore::getIonexValue() ... Invalid time!");
+         GPSTK_THROW(e);
+      }
+
+      if ( itm->first == t )                     // exact match of t
       {
 
-         if( itm != inxMaps.end() )              // exact match of t
+            // store current and next epoch (if any)
+         T[0] = itm->first;
+         maps[0] = &itm->second;
+         if ( ++itm == inxMaps.end() )
          {
+            --itm;
+         }
+         T[1] = itm->first;
+         maps[1] = &itm->second;
 
-               // get the current map
-            itm = inxMaps.lower_bound(t);
-               // store current and next epoch
-            T[0] = itm->first;
-            T[1] = (++itm)->first;
+      }
+      else                                      // t is between two maps
+      {
 
-         }
-         else                                   // t is between two maps
-         {
+            // store the next and previous epoch
+         T[1] = itm->first;
+         maps[1] = &itm->second;
+         --itm;
+         T[0] = itm->first;
+         maps[0] = &itm->second;
 
-               // get the next valid map
-            itm = inxMaps.lower_bound(t);
-               // store the next and previous epoch
-            T[1] = itm->first;
-            T[0] = (--itm)->first;
+      }  // end of 'if( itm->first == t ) ... else ... '' 
 
-         }  // end of 'if( itm != inxMaps.end() ) ... else ... '' 
 
+         // factors (As in Eq.(3), pag.2 of the manual)
+      if ( T[1] == T[0] )                       // t is the last map
+      {
+         f[0] = 1.0;
+         f[1] = 0.0;
       }
-      catch (...)
+      else
       {
-         InvalidRequest e("IonexStore::getIonexValue() ... Invalid time!");
-         GPSTK_THROW(e);
+         f[0] = (T[1]-t   ) / (T[1]-T[0]);
+         f[1] = (t   -T[0]) / (T[1]-T[0]);
       }
 
-
-         // factors (As in Eq.(3), pag.2 of the manual)
-      double f[2];
-      f[0] = (T[1]-t   ) / (T[1]-T[0]);
-      f[1] = (t   -T[0]) / (T[1]-T[0]);
-
          // if only one map, then we have to use the neareast
       if( nmap == 1 )
       {
@@ -370,6 +541,7 @@ namespace gpstk
          if( f[1] > f[0] )
          {
             T[0] = T[1];
+            maps[0] = maps[1];
          }
 
             // than the factor is unit
@@ -377,68 +549,22 @@ namespace gpstk
 
       }  // if( nmap == 1 )
 
-         // loop over the number of maps considered
+         // now let's determine if we keep fixed position or 
+         // take into account the rotation around the Sun
       for(int imap = 0; imap < nmap; imap++)
       {
 
-            // now let's determine if we keep fixed position or 
-            // take into account the rotation around the Sun
-         Position pos;
-         if (strategy == 1 || strategy == 2)    // fixed position
-         {
-
-            pos = RX;
-
-         }
-         else                                   // rotate the position
-         {
-
-               // seconds of time to degree (360.0 / 86400.0)
-            double sec2deg( 4.16666666666667e-3 );
-
-               // count the rotation
-            pos = RX;
-            pos.theArray[1] = pos.theArray[1] + ( t - T[imap] ) * sec2deg;
-
-         }  // End of 'if (strategy == 1 || strategy == 2)...'
-
-
-            // iterator to the current map
-         itm = inxMaps.find(T[imap]);
-
-            // map to hold the IONEX types for the current map
-         IonexValTypeMap ivtm = (*itm).second;
-
-            // object to hold the corresponding data to the current map
-         IonexData iod;
-
-            // Compute TEC value
-         if ( ivtm.find(IonexData::TEC) != ivtm.end() )
-         {
-
-            iod = ivtm[IonexData::TEC];
-            tecval[0] = tecval[0] + f[imap]*iod.getValue(pos);
-
-         }
+            // seconds of time to degree (360.0 / 86400.0)
+         const double sec2deg( 4.16666666666667e-3 );
 
-            // Compute RMS value
-         if ( ivtm.find(IonexData::RMS) != ivtm.end() )
-         {
+         rot[imap] = (strategy == 1 || strategy == 2) ?
+                     0.0 : ( t - T[imap] ) * sec2deg;
 
-            iod = ivtm[IonexData::RMS];
-            tecval[1] = tecval[1] + f[imap]*iod.getValue(pos);
-
-         }
-
-      }  // End of 'for(int imap = 0; imap < nmap; imap++)...'
-
-
-         // ionosphere height in meters
-      tecval[2] = RX.theArray[2];
+      }
 
-      return tecval;
+      return nmap;
 
-   }  // End of method 'IonexStore::getIonexValue()'
+   }  // End of method 'IonexStore::findMaps()'
 
 
 
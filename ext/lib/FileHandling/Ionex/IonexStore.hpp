@@ -45,6 +45,7 @@
 #define GPSTK_IONEXSTORE_HPP
 
 #include <map>
+#include <vector>
 
 #include "FileStore.hpp"
 #include "IonexData.hpp"
@@ -148,6 +149,34 @@ namespace gpstk
 
 
 
+         /** Get IONEX TEC, RMS and ionosphere height values of many
+          *  positions (typically the ionospheric pierce points of all the
+          *  stations) at the same epoch.
+          *
+          * The maps bracketing the epoch are looked up only once, and the
+          * grid cell of each position is shared by the TEC and RMS maps. The
+          * values are the ones getIonexValue() returns for each position.
+          *
+          * @param t          Time tag of signal (CommonTime object)
+          * @param IPP        Positions in GEOCENTRIC coordinates.
+          * @param values     TEC, RMS and ionosphere height values, one per
+          *                   position (zero TEC and RMS if not found).
+          * @param found      For each position, false if it is outside
+          *                   the grid or on undefined values.
+          * @param strategy   Interpolation strategy, as in getIonexValue().
+          *
+          * @throw InvalidRequest if there are no maps for this epoch or the
+          *        strategy is not valid.
+          */
+      void getIonexValues( const CommonTime& t,
+                           const std::vector<Position>& IPP,
+                           std::vector<Triple>& values,
+                           std::vector<bool>& found,
+                           int strategy = 3 ) const
+         throw(InvalidRequest);
+
+
+
       /** Get slant total electron content (STEC) in TECU
        *
        * @param elevation     Time tag of signal (CommonTime object)
@@ -362,6 +391,26 @@ namespace gpstk
       IonexMap inxMaps;
 
 
+
+         /** Find the maps to be interpolated at a given epoch.
+          *
+          * @param t          Time tag of signal (CommonTime object)
+          * @param strategy   Interpolation strategy, as in getIonexValue().
+          * @param maps       Maps to interpolate.
+          * @param f          Weights of these maps.
+          * @param rot        Rotation (degrees of longitude) to apply to the
+          *                   positions for each map.
+          *
+          * @return           Number of maps to interpolate (1 or 2).
+          */
+      int findMaps( const CommonTime& t,
+                    int strategy,
+                    const IonexValTypeMap* maps[2],
+                    double f[2],
+                    double rot[2] ) const
+         throw(InvalidRequest);
+
+
          /// The key of this map is the time (first epoch as in IonexHeader)
       typedef std::map<CommonTime, IonexHeader::SatDCBMap> IonexDCBMap;
 
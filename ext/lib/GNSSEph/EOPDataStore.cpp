@@ -54,7 +54,11 @@ namespace gpstk
                                   const EOPDataStore::EOPData& d)
       throw(InvalidRequest)
    {
-      if(!(utc.getTimeSystem()==TimeSystem::UTC)) throw Exception();
+      if(!(utc.getTimeSystem()==TimeSystem::UTC))
+      {
+         InvalidRequest e("EOP data are requested with a UTC epoch");
+         GPSTK_THROW(e);
+      }
 
       std::vector<double> data(5,0.0);
       
@@ -73,7 +77,11 @@ namespace gpstk
    EOPDataStore::EOPData EOPDataStore::getEOPData(const CommonTime& utc) const
          throw(InvalidRequest)
    {
-      if(!(utc.getTimeSystem()==TimeSystem::UTC)) throw Exception();
+      if(!(utc.getTimeSystem()==TimeSystem::UTC))
+      {
+         InvalidRequest e("EOP data are requested with a UTC epoch");
+         GPSTK_THROW(e);
+      }
 	  
       std::vector<double> data = getData(utc);
 
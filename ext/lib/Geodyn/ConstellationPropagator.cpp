@@ -0,0 +1,402 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file ConstellationPropagator.cpp
+ * Propagate the orbits of a constellation of satellites together.
+ */
+
+#include "ConstellationPropagator.hpp"
+#include "ReferenceFrames.hpp"
+#include "StringUtils.hpp"
+
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace gpstk
+{
+
+   namespace
+   {
+         // Work shared by the threads of one integrateTo() call. The
+         // worker threads wait for each step to be posted; then every
+         // thread takes the next satellite that nobody has taken yet,
+         // until none is left.
+      struct StepJob
+      {
+         std::vector<SatOrbitPropagator*>* pProps;
+         double tf;
+         size_t next;
+         bool failed;
+         Exception error;
+#ifdef GPSTK_HAVE_PTHREAD
+         pthread_mutex_t mutex;
+         pthread_cond_t posted;     // a step or the end was posted
+         pthread_cond_t finished;   // a worker finished its step
+         unsigned long step;        // number of steps posted
+         int workers;               // number of worker threads
+         int workersDone;           // workers done with this step
+         bool quit;                 // no more steps
+#endif
+      };
+
+
+         // Take the next satellite, or return false when none is left
+         // or another thread has already failed
+      bool takeSatellite(StepJob& job, size_t& index)
+      {
+#ifdef GPSTK_HAVE_PTHREAD
+         pthread_mutex_lock(&job.mutex);
+#endif
+         bool ok = ( !job.failed && (job.next < job.pProps->size()) );
+         if(ok) index = job.next++;
+#ifdef GPSTK_HAVE_PTHREAD
+         pthread_mutex_unlock(&job.mutex);
+#endif
+         return ok;
+      }
+
+
+         // Keep the first error, it is thrown again once all the
+         // threads have finished
+      void reportError(StepJob& job, const Exception& e)
+      {
+#ifdef GPSTK_HAVE_PTHREAD
+         pthread_mutex_lock(&job.mutex);
+#endif
+         if(!job.failed)
+         {
+            job.failed = true;
+            job.error = e;
+         }
+#ifdef GPSTK_HAVE_PTHREAD
+         pthread_mutex_unlock(&job.mutex);
+#endif
+      }
+
+
+         // Advance satellites to job.tf until none is left
+      void runStepJob(StepJob& job)
+      {
+         size_t index(0);
+         while( takeSatellite(job, index) )
+         {
+            try
+            {
+               (*job.pProps)[index]->integrateTo(job.tf);
+            }
+            catch(Exception& e)
+            {
+               reportError(job, e);
+            }
+            catch(std::exception& e)
+            {
+               reportError(job, Exception(e.what()));
+            }
+            catch(...)
+            {
+               reportError(job, Exception("Unknown error"));
+            }
+         }
+      }
+
+
+#ifdef GPSTK_HAVE_PTHREAD
+         // What a worker thread does from its start to the end of
+         // integrateTo(): take part in every step that is posted
+      void runWorker(StepJob& job)
+      {
+         unsigned long done(0);
+
+         pthread_mutex_lock(&job.mutex);
+         while(true)
+         {
+            while( !job.quit && (job.step == done) )
+            {
+               pthread_cond_wait(&job.posted, &job.mutex);
+            }
+            if(job.quit) break;
+            done = job.step;
+
+            pthread_mutex_unlock(&job.mutex);
+            runStepJob(job);
+            pthread_mutex_lock(&job.mutex);
+
+            if(++job.workersDone == job.workers)
+            {
+               pthread_cond_signal(&job.finished);
+            }
+         }
+         pthread_mutex_unlock(&job.mutex);
+      }
+#endif
+
+   }  // End of anonymous namespace
+
+}  // End of namespace 'gpstk'
+
+
+#ifdef GPSTK_HAVE_PTHREAD
+   // C-style function to be called with pthreads
+extern "C"
+{
+   static void* constellationWorkerThread(void* pJob)
+   {
+      gpstk::runWorker( *static_cast<gpstk::StepJob*>(pJob) );
+      return NULL;
+   }
+}
+#endif
+
+
+namespace gpstk
+{
+
+      // Default constructor
+   ConstellationPropagator::ConstellationPropagator()
+      : stepSize(60.0), numThreads(0), curT(0.0)
+   {}
+
+
+      // Default destructor
+   ConstellationPropagator::~ConstellationPropagator()
+   {
+      for(size_t i = 0; i < propagators.size(); i++)
+      {
+         delete propagators[i];
+      }
+      propagators.clear();
+   }
+
+
+      // Set the common step size of the integrators, in seconds
+   ConstellationPropagator& ConstellationPropagator::setStepSize(double step)
+      throw(InvalidRequest)
+   {
+      if(step <= 0.0)
+      {
+         InvalidRequest e("The step size must be positive.");
+         GPSTK_THROW(e);
+      }
+
+      stepSize = step;
+      for(size_t i = 0; i < propagators.size(); i++)
+      {
+         propagators[i]->setStepSize(stepSize);
+      }
+
+      return (*this);
+
+   }  // End of method 'ConstellationPropagator::setStepSize()'
+
+
+      // Add a satellite to the constellation
+   SatOrbitPropagator& ConstellationPropagator::addSatellite(
+                                                   const SatID&          sat,
+                                                   const Vector<double>& rv0 )
+      throw(InvalidRequest)
+   {
+      if(satIndex.find(sat) != satIndex.end())
+      {
+         InvalidRequest e("Satellite " + StringUtils::asString(sat)
+                          + " is already in the constellation.");
+         GPSTK_THROW(e);
+      }
+
+      if(curT != 0.0)
+      {
+         InvalidRequest e("Satellites must be added before integrating.");
+         GPSTK_THROW(e);
+      }
+
+      if(rv0.size() < 6)
+      {
+         InvalidRequest e("The initial state must have 6 elements.");
+         GPSTK_THROW(e);
+      }
+
+      SatOrbitPropagator* pProp = new SatOrbitPropagator();
+      pProp->setStepSize(stepSize);
+      pProp->setInitState(refEpoch, rv0);
+
+      satIndex[sat] = satellites.size();
+      satellites.push_back(sat);
+      propagators.push_back(pProp);
+
+      return (*pProp);
+
+   }  // End of method 'ConstellationPropagator::addSatellite()'
+
+
+      // Get the propagator of the given satellite
+   SatOrbitPropagator& ConstellationPropagator::getPropagator(const SatID& sat)
+      throw(InvalidRequest)
+   {
+      std::map<SatID, size_t>::const_iterator it = satIndex.find(sat);
+      if(it == satIndex.end())
+      {
+         InvalidRequest e("Satellite " + StringUtils::asString(sat)
+                          + " is not in the constellation.");
+         GPSTK_THROW(e);
+      }
+
+      return (*propagators[it->second]);
+
+   }  // End of method 'ConstellationPropagator::getPropagator()'
+
+
+      // Position and velocity of the given satellite
+   Vector<double> ConstellationPropagator::rvState(const SatID& sat, bool bJ2k)
+      throw(InvalidRequest)
+   {
+      return getPropagator(sat).rvState(bJ2k);
+   }
+
+
+      // Advance all the satellites to the given time
+   void ConstellationPropagator::integrateTo(double tf)
+      throw(Exception)
+   {
+      int nThreads = numThreads;
+#ifdef GPSTK_HAVE_PTHREAD
+      if(nThreads == 0)
+      {
+         long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+         nThreads = (ncpu > 0) ? static_cast<int>(ncpu) : 1;
+      }
+#else
+      nThreads = 1;
+#endif
+      if(static_cast<size_t>(nThreads) > propagators.size())
+      {
+         nThreads = static_cast<int>(propagators.size());
+      }
+
+         // The epoch cache is what the lock-step buys us; restore the
+         // caller's setting afterwards
+      const bool cacheWasOn = ReferenceFrames::getEpochCache();
+      if(!cacheWasOn) ReferenceFrames::setEpochCache(true);
+
+      StepJob job;
+      job.pProps = &propagators;
+      job.tf = curT;
+      job.next = propagators.size();
+      job.failed = false;
+
+#ifdef GPSTK_HAVE_PTHREAD
+      pthread_mutex_init(&job.mutex, NULL);
+      pthread_cond_init(&job.posted, NULL);
+      pthread_cond_init(&job.finished, NULL);
+      job.step = 0;
+      job.workers = 0;
+      job.workersDone = 0;
+      job.quit = false;
+
+         // The workers are started once, and wait for each step. The
+         // calling thread does its share of the work too.
+      std::vector<pthread_t> threads(nThreads > 1 ? nThreads - 1 : 0);
+      for(size_t i = 0; i < threads.size(); i++)
+      {
+         if( pthread_create(&threads[i], NULL,
+                            constellationWorkerThread, &job) != 0 )
+         {
+            break;
+         }
+         ++job.workers;
+      }
+#endif
+
+      while( (curT < tf) && !job.failed )
+      {
+         double t = curT + stepSize;
+         if(t > tf) t = tf;
+
+#ifdef GPSTK_HAVE_PTHREAD
+         pthread_mutex_lock(&job.mutex);
+         job.tf = t;
+         job.next = 0;
+         job.workersDone = 0;
+         ++job.step;
+         pthread_cond_broadcast(&job.posted);
+         pthread_mutex_unlock(&job.mutex);
+#else
+         job.tf = t;
+         job.next = 0;
+#endif
+
+         runStepJob(job);
+
+#ifdef GPSTK_HAVE_PTHREAD
+            // Wait until every worker is done with this step
+         pthread_mutex_lock(&job.mutex);
+         while(job.workersDone < job.workers)
+         {
+            pthread_cond_wait(&job.finished, &job.mutex);
+         }
+         pthread_mutex_unlock(&job.mutex);
+#endif
+
+         if(!job.failed) curT = t;
+      }
+
+#ifdef GPSTK_HAVE_PTHREAD
+      pthread_mutex_lock(&job.mutex);
+      job.quit = true;
+      pthread_cond_broadcast(&job.posted);
+      pthread_mutex_unlock(&job.mutex);
+
+      for(int i = 0; i < job.workers; i++)
+      {
+         pthread_join(threads[i], NULL);
+      }
+
+      pthread_cond_destroy(&job.finished);
+      pthread_cond_destroy(&job.posted);
+      pthread_mutex_destroy(&job.mutex);
+#endif
+
+      if(!cacheWasOn) ReferenceFrames::setEpochCache(false);
+
+      if(job.failed)
+      {
+         GPSTK_THROW(job.error);
+      }
+
+   }  // End of method 'ConstellationPropagator::integrateTo()'
+
+}  // End of namespace 'gpstk'
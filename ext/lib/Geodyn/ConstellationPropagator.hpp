@@ -0,0 +1,204 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file ConstellationPropagator.hpp
+ * Propagate the orbits of a constellation of satellites together.
+ */
+
+#ifndef GPSTK_CONSTELLATION_PROPAGATOR_HPP
+#define GPSTK_CONSTELLATION_PROPAGATOR_HPP
+
+#include <map>
+#include <vector>
+#include "SatID.hpp"
+#include "SatOrbitPropagator.hpp"
+
+namespace gpstk
+{
+      /// @ingroup GeoDynamics 
+      //@{
+
+      /**
+       * Propagate the orbits of a constellation of satellites together.
+       *
+       * Every satellite has its own SatOrbitPropagator (and then its own
+       * force models and integrator), but all of them are advanced in
+       * lock-step with a common step size. The stages of an integration
+       * step then fall on the same epochs for the whole constellation,
+       * and the epoch cache of ReferenceFrames lets them share the Earth
+       * orientation matrices and the Sun and Moon positions, which are
+       * the bulk of the cost of a force evaluation. The satellites of
+       * each step are spread over several threads when the library is
+       * built with pthread support. The threads are started once per
+       * call to integrateTo() and wait for each other at the end of
+       * every step.
+       *
+       * @code
+       * ConstellationPropagator cp;
+       * cp.setRefEpoch(UTCTime(2010,1,1,0,0,0.0));
+       * cp.setStepSize(60.0);
+       *
+       * for(int prn = 1; prn <= 32; prn++)
+       * {
+       *    cp.addSatellite(SatID(prn,SatID::systemGPS), rv0[prn])
+       *      .getSatOrbitPointer()->enableGeopotential(SatOrbit::GM_JGM3,8,8);
+       * }
+       *
+       * cp.integrateTo(86400.0);
+       * Vector<double> rv = cp.rvState(SatID(1,SatID::systemGPS));
+       * @endcode
+       *
+       * The MSISE00 drag model keeps its working data in static members
+       * and must not be used with more than one thread.
+       */
+   class ConstellationPropagator
+   {
+   public:
+
+         /// Default constructor
+      ConstellationPropagator();
+
+         /// Default destructor
+      virtual ~ConstellationPropagator();
+
+
+         /** Set the reference epoch of the satellites added later.
+          *  Times given to integrateTo() are seconds since this epoch.
+          */
+      ConstellationPropagator& setRefEpoch(const UTCTime& utc0)
+      { refEpoch = utc0; return (*this); }
+
+         /// Get the reference epoch
+      UTCTime getRefEpoch() const
+      { return refEpoch; }
+
+
+         /// Set the common step size of the integrators, in seconds
+      ConstellationPropagator& setStepSize(double step)
+         throw(InvalidRequest);
+
+         /// Get the common step size of the integrators, in seconds
+      double getStepSize() const
+      { return stepSize; }
+
+
+         /** Set the number of threads used by integrateTo().
+          *  Zero (the default) uses one thread per processor.
+          */
+      ConstellationPropagator& setNumThreads(int n)
+      { numThreads = (n < 0) ? 0 : n; return (*this); }
+
+         /// Get the number of threads requested
+      int getNumThreads() const
+      { return numThreads; }
+
+
+         /** Add a satellite to the constellation.
+          *
+          * @param sat     satellite to be added
+          * @param rv0     position and velocity at the reference epoch,
+          *                in the J2000 frame
+          * @return        the propagator of the satellite, to configure
+          *                its force models
+          */
+      SatOrbitPropagator& addSatellite(const SatID&          sat,
+                                       const Vector<double>& rv0)
+         throw(InvalidRequest);
+
+         /// Get the propagator of the given satellite
+      SatOrbitPropagator& getPropagator(const SatID& sat)
+         throw(InvalidRequest);
+
+         /// Get the satellites of the constellation
+      std::vector<SatID> getSatellites() const
+      { return satellites; }
+
+         /// Number of satellites in the constellation
+      size_t size() const
+      { return satellites.size(); }
+
+
+         /** Advance all the satellites to the given time.
+          *
+          * @param tf      seconds since the reference epoch
+          */
+      void integrateTo(double tf)
+         throw(Exception);
+
+         /// Current time, in seconds since the reference epoch
+      double getCurTime() const
+      { return curT; }
+
+         /// Position and velocity of the given satellite
+      Vector<double> rvState(const SatID& sat, bool bJ2k = true)
+         throw(InvalidRequest);
+
+
+   private:
+
+         /// Copying would share the propagators
+      ConstellationPropagator(const ConstellationPropagator&);
+      ConstellationPropagator& operator=(const ConstellationPropagator&);
+
+         /// Reference epoch
+      UTCTime refEpoch;
+
+         /// Common step size of the integrators
+      double stepSize;
+
+         /// Requested number of threads
+      int numThreads;
+
+         /// Current time since the reference epoch
+      double curT;
+
+         /// Satellites, in the order they were added
+      std::vector<SatID> satellites;
+
+         /// Propagators, parallel to 'satellites'
+      std::vector<SatOrbitPropagator*> propagators;
+
+         /// Index of each satellite in 'satellites'
+      std::map<SatID, size_t> satIndex;
+
+   }; // End of class 'ConstellationPropagator'
+
+      // @}
+
+}  // End of namespace 'gpstk'
+
+#endif   // GPSTK_CONSTELLATION_PROPAGATOR_HPP
@@ -0,0 +1,283 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file DormandPrince853.hpp
+ * Adaptive Runge-Kutta integrator of order 8 (Dormand-Prince 8(5,3))
+ * with continuous (dense) output of order 7.
+ */
+
+#ifndef GPSTK_DORMAND_PRINCE_853_HPP
+#define GPSTK_DORMAND_PRINCE_853_HPP
+
+#include <vector>
+#include "Integrator.hpp"
+#include "Exception.hpp"
+
+namespace gpstk
+{
+      /// @ingroup GeoDynamics 
+      //@{
+
+      /** This class integrates an ODE system with the explicit Runge-Kutta
+       *  method of order 8 by Dormand and Prince, with automatic step size
+       *  control and a continuous extension of order 7.
+       *
+       *  The step size is selected from a combined 5th and 3rd order error
+       *  estimate, so the integrator takes steps as long as the requested
+       *  tolerances allow. After every accepted step the solution may be
+       *  evaluated at any epoch inside that step with interpolate(), at
+       *  the cost of three extra derivative evaluations per step. This
+       *  way, a whole set of output epochs is obtained from one pass of
+       *  the integrator, without shortening the steps to hit each epoch.
+       *
+       * @code
+       *   DormandPrince853 dop;
+       *   dop.setTolerance(1.0e-12, 1.0e-6);
+       *
+       *   std::vector<double> times;         // e.g. one output each second
+       *   std::vector< Vector<double> > states;
+       *   dop.integrateTo(t0, y0, &eom, times, states);
+       * @endcode
+       *
+       *  The step size of the base class is used as the first trial step;
+       *  when it is not positive, the first step is estimated from the
+       *  derivatives at the initial epoch.
+       *
+       *  References:
+       *
+       *     E. Hairer, S.P. Norsett and G. Wanner, Solving Ordinary
+       *     Differential Equations I. Nonstiff Problems, 2nd edition.
+       *     Springer Series in Computational Mathematics, 1993.
+       *     (Section II.10 and the DOP853 code).
+       */
+   class DormandPrince853 : public Integrator
+   {
+   public:
+
+         /// Default constructor
+      DormandPrince853();
+
+
+         /// Default destructor
+      virtual ~DormandPrince853()
+      { };
+
+
+         /** Integrate from 't' to 'tf' with adaptive steps.
+          * @param t     independent variable (usually the time)
+          * @param y     inputs (usually the state)
+          * @param peom  Object containing the Equations of Motion
+          * @param tf    next time
+          * @return      containing the new state
+          */
+      virtual Vector<double> integrateTo(const double&           t, 
+                                         const Vector<double>&   y, 
+                                         EquationOfMotion*       peom,
+                                         const double&           tf );
+
+
+         /** Integrate from 't' over a set of output epochs in one pass,
+          *  using the continuous extension to compute the state at each
+          *  of them.
+          * @param t       independent variable (usually the time)
+          * @param y       inputs (usually the state)
+          * @param peom    Object containing the Equations of Motion
+          * @param times   output epochs, monotonic in the direction of
+          *                integration
+          * @param states  on return, the state at each output epoch
+          */
+      void integrateTo(const double&                   t,
+                       const Vector<double>&           y,
+                       EquationOfMotion*               peom,
+                       const std::vector<double>&      times,
+                       std::vector< Vector<double> >&  states );
+
+
+         /** Set the initial conditions for step(). This evaluates the
+          *  derivatives at the initial epoch.
+          * @param t     independent variable (usually the time)
+          * @param y     inputs (usually the state)
+          * @param peom  Object containing the Equations of Motion
+          */
+      void initialize(const double&           t,
+                      const Vector<double>&   y,
+                      EquationOfMotion*       peom );
+
+
+         /** Take one accepted step towards 'tf', never going past it.
+          * @param tf    final time of the integration
+          * @return      the time reached at the end of the step
+          */
+      double step(const double& tf);
+
+
+         /** Evaluate the continuous extension of the last accepted step.
+          * @param t     time inside [getPreviousTime(), getTime()]
+          * @return      the interpolated state
+          */
+      Vector<double> interpolate(const double& t);
+
+
+         /// Time at the end of the last accepted step
+      double getTime() const
+      { return tNew; }
+
+
+         /// Time at the beginning of the last accepted step
+      double getPreviousTime() const
+      { return tOld; }
+
+
+         /// State at the end of the last accepted step
+      const Vector<double>& getState() const
+      { return yNew; }
+
+
+         /** Set the tolerances of the local error test. The error of
+          *  component i is weighted by absTol + relTol * |y(i)|.
+          */
+      DormandPrince853& setTolerance(const double& rel, const double& abs)
+      { relTol = rel; absTol = abs; return (*this); }
+
+
+         /// Set maximum stepsize
+      DormandPrince853& setMaxStepSize(const double& step)
+      { maxStepSize = step; return (*this); }
+
+
+         /// Set minimum stepsize
+      DormandPrince853& setMinStepSize(const double& step)
+      { minStepSize = step; return (*this); }
+
+
+         /// Number of evaluations of the equations of motion
+      unsigned long getNumEvaluations() const
+      { return numEvaluations; }
+
+
+         /// Number of accepted steps
+      unsigned long getNumSteps() const
+      { return numSteps; }
+
+
+         /// Number of rejected steps
+      unsigned long getNumRejected() const
+      { return numRejected; }
+
+
+         /// Reset the evaluation and step counters
+      void resetCounters()
+      { numEvaluations = numSteps = numRejected = 0; }
+
+
+   protected:
+
+         /// Compute the stages and the solution at tOld + h into yNew
+      void computeStages(const double& h);
+
+         /// Scaled norm of the error estimate of the current step
+      double errorNorm(const double& h) const;
+
+         /// Estimate the first trial step
+      double initialStep(const double& direction);
+
+         /// Compute the coefficients of the continuous extension
+      void prepareDense();
+
+         /// Evaluate the equations of motion and count it
+      void evaluate(const double& t, const Vector<double>& y, Vector<double>& f);
+
+
+         /// Relative tolerance
+      double relTol;
+
+         /// Absolute tolerance
+      double absTol;
+
+         /// Maximum step-size
+      double maxStepSize;
+
+         /// Minimum step-size
+      double minStepSize;
+
+
+   private:
+
+         /// Equations of motion being integrated
+      EquationOfMotion* pEom;
+
+         /// Times at the beginning and end of the last step
+      double tOld, tNew;
+
+         /// Absolute value of the next trial step
+      double hNext;
+
+         /// States at the beginning and end of the last step
+      Vector<double> yOld, yNew;
+
+         /// Work vector for the stage arguments
+      Vector<double> yStage;
+
+         /// Stage derivatives; k[12] is the derivative at the step end
+      Vector<double> k[16];
+
+         /// Coefficients of the continuous extension
+      Vector<double> cont[7];
+
+         /// Whether cont[] belongs to the last step
+      bool denseReady;
+
+         /// Whether the last trial step was rejected
+      bool lastRejected;
+
+         /// Counters
+      unsigned long numEvaluations, numSteps, numRejected;
+
+         /// Coefficients of the method
+      static const double c[16];
+      static const double a[16][15];
+      static const double bhh[3];
+      static const double er[12];
+      static const double d[4][16];
+
+   }; // End of class 'DormandPrince853'
+
+      // @}
+
+}  // End of namespace 'gpstk'
+
+#endif   // GPSTK_DORMAND_PRINCE_853_HPP
@@ -89,7 +89,7 @@ namespace gpstk
 
          /// Request EOP Data
       static EOPDataStore::EOPData eopData(const double& mjdUTC)
-         throw(InvalidRequest){return gpstk::EOPData( gpstk::MJD(mjdUTC) );}
+         throw(InvalidRequest){return gpstk::EOPData( gpstk::MJD(mjdUTC, TimeSystem::UTC) );}
 
       static EOPDataStore::EOPData eopData(const CommonTime& UTC)
          throw(InvalidRequest){return gpstk::EOPData(UTC);}
@@ -98,7 +98,7 @@ namespace gpstk
          /// @param  Modified Julidate in UTC
          /// @return Pole coordinate x in arcseconds
       static double xPole(const double& mjdUTC)
-         throw (InvalidRequest){return gpstk::PolarMotionX( gpstk::MJD(mjdUTC) );}
+         throw (InvalidRequest){return gpstk::PolarMotionX( gpstk::MJD(mjdUTC, TimeSystem::UTC) );}
 
       static double xPole(const CommonTime& UTC)
          throw (InvalidRequest){return gpstk::PolarMotionX(UTC);}
@@ -107,7 +107,7 @@ namespace gpstk
          /// @param  Modified Julidate in UTC
          /// @return Pole coordinate x in arcseconds
       static double yPole(const double& mjdUTC)
-         throw (InvalidRequest){ return gpstk::PolarMotionY( gpstk::MJD(mjdUTC) );}
+         throw (InvalidRequest){ return gpstk::PolarMotionY( gpstk::MJD(mjdUTC, TimeSystem::UTC) );}
 
       static double yPole(const CommonTime& UTC)
          throw (InvalidRequest){ return gpstk::PolarMotionY(UTC);}
@@ -116,7 +116,7 @@ namespace gpstk
          /// @param  Modified Julidate in UTC
          /// @return UT1-UTC time difference in seconds
       static double UT1mUTC(const double& mjdUTC)
-         throw (InvalidRequest) { return gpstk::UT1mUTC( gpstk::MJD(mjdUTC) ); } 
+         throw (InvalidRequest) { return gpstk::UT1mUTC( gpstk::MJD(mjdUTC, TimeSystem::UTC) ); } 
 
       static double UT1mUTC(const CommonTime& UTC)
          throw (InvalidRequest) { return gpstk::UT1mUTC(UTC); } 
@@ -125,7 +125,7 @@ namespace gpstk
          /// @param  Modified Julidate in UTC
          /// @return dPsi in arcseconds
       static double dPsi(const double& mjdUTC)
-         throw (InvalidRequest){return gpstk::NutationDPsi( gpstk::MJD(mjdUTC) );}
+         throw (InvalidRequest){return gpstk::NutationDPsi( gpstk::MJD(mjdUTC, TimeSystem::UTC) );}
 
       static double dPsi(const CommonTime& UTC)
          throw (InvalidRequest){return gpstk::NutationDPsi(UTC);}
@@ -134,7 +134,7 @@ namespace gpstk
          /// @param  Modified Julidate in UTC
          /// @return dEps in arcseconds
       static double dEps(const double& mjdUTC)
-         throw (InvalidRequest){return gpstk::NutationDEps( gpstk::MJD(mjdUTC) );}
+         throw (InvalidRequest){return gpstk::NutationDEps( gpstk::MJD(mjdUTC, TimeSystem::UTC) );}
 
       static double dEps(const CommonTime& UTC)
          throw (InvalidRequest){return gpstk::NutationDEps(UTC);}
@@ -149,7 +149,7 @@ namespace gpstk
           * @return      number of leaps seconds.
          */
       static int TAImUTC(const double& mjdUTC)
-         throw(InvalidRequest){return gpstk::TAImUTC( gpstk::MJD(mjdUTC) ); }
+         throw(InvalidRequest){return gpstk::TAImUTC( gpstk::MJD(mjdUTC, TimeSystem::UTC) ); }
 
       static int TAImUTC(const CommonTime& UTC)
          throw(InvalidRequest){return gpstk::TAImUTC(UTC); }
@@ -195,7 +195,8 @@ namespace gpstk
       try { return EOPData(UTC).xp; }
       catch(...) 
       { 
-         GPSTK_THROW(Exception("Failed to get EOP data on" + CivilTime(UTC).asString()));
+         InvalidRequest e("Failed to get EOP data on " + CivilTime(UTC).asString());
+         GPSTK_THROW(e);
 
          return 0.0;
       }
@@ -207,7 +208,8 @@ namespace gpstk
       try { return EOPData(UTC).yp; }
       catch(...) 
       {
-         GPSTK_THROW(Exception("Failed to get EOP data on " + CivilTime(UTC).asString()));
+         InvalidRequest e("Failed to get EOP data on " + CivilTime(UTC).asString());
+         GPSTK_THROW(e);
 
          return 0.0;
       }
@@ -219,7 +221,8 @@ namespace gpstk
       try { return EOPData(UTC).UT1mUTC; }
       catch(...) 
       { 
-         GPSTK_THROW(Exception("Failed to get EOP data on " + CivilTime(UTC).asString()));
+         InvalidRequest e("Failed to get EOP data on " + CivilTime(UTC).asString());
+         GPSTK_THROW(e);
 
          return 0.0;
       }
@@ -231,7 +234,8 @@ namespace gpstk
       try { return EOPData(UTC).dPsi; }
       catch(...) 
       {
-         GPSTK_THROW(Exception("Failed to get EOP data on "+CivilTime(UTC).asString()));
+         InvalidRequest e("Failed to get EOP data on " + CivilTime(UTC).asString());
+         GPSTK_THROW(e);
 
          return 0.0;
       }
@@ -243,7 +247,8 @@ namespace gpstk
       try { return EOPData(UTC).dEps; }
       catch(...) 
       {
-         GPSTK_THROW(Exception("Failed to get EOP data on "+CivilTime(UTC).asString()));
+         InvalidRequest e("Failed to get EOP data on " + CivilTime(UTC).asString());
+         GPSTK_THROW(e);
 
          return 0.0;
       }
@@ -252,19 +257,27 @@ namespace gpstk
    // Time System Handling
    //--------------------------------------------------------------------------
    
-   CommonTime ConvertTimeSystem(const CommonTime& time, TimeSystemEnum from, TimeSystemEnum to)
+   namespace
    {
-      if(from==to) return time;
-
-      static std::map<TimeSystemEnum,std::string> mapTSName;
-      if(mapTSName.size()==0)
+         // Names of the time systems, built once and only read afterwards
+         // so that ConvertTimeSystem() may be called from several threads
+      std::map<TimeSystemEnum,std::string> makeTSNameMap()
       {
+         std::map<TimeSystemEnum,std::string> mapTSName;
          mapTSName[TS_UTC] = "UTC";
          mapTSName[TS_UT1] = "UT1";
          mapTSName[TS_GPST]= "GPST";
          mapTSName[TS_TAI] = "TAI";
          mapTSName[TS_TT]  = "TT";
-      }     
+         return mapTSName;
+      }
+
+      const std::map<TimeSystemEnum,std::string> mapTSName = makeTSNameMap();
+   }
+
+   CommonTime ConvertTimeSystem(const CommonTime& time, TimeSystemEnum from, TimeSystemEnum to)
+   {
+      if(from==to) return time;
       
       std::map<TimeSystemEnum,std::string>::const_iterator itf,itt,ite;
       itf = mapTSName.find(from);
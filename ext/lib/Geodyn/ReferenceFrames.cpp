@@ -49,6 +49,10 @@
 #include "IERS.hpp"
 #include "ASConstant.hpp"
 
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 
 namespace gpstk
 {
@@ -78,6 +82,212 @@ namespace gpstk
       // Arcseconds in a full circle 
    const double ReferenceFrames::TURNAS = 1296000.0;
 
+      // Flag if the epoch cache is used
+   bool ReferenceFrames::useEpochCache = false;
+
+      // Tabulated precession-nutation, disabled by default
+   PrecessionNutationCache
+      ReferenceFrames::pnCache(&ReferenceFrames::precessionNutation);
+   bool ReferenceFrames::useRotationCache = false;
+
+
+   namespace
+   {
+         // Identify an epoch (and a pair of planets) in the epoch cache.
+         // Only requests for the very same epoch share an entry.
+      struct EpochKey
+      {
+         EpochKey()
+            : day(0), msod(0), fsod(0.0), entity(0), center(0)
+         {}
+
+         EpochKey(const CommonTime& t, int e = 0, int c = 0)
+            : entity(e), center(c)
+         { t.getInternal(day, msod, fsod, system); }
+
+         bool operator==(const EpochKey& right) const
+         {
+            return ( (day == right.day) && (msod == right.msod) &&
+                     (fsod == right.fsod) && (system == right.system) &&
+                     (entity == right.entity) && (center == right.center) );
+         }
+
+         long day;
+         long msod;
+         double fsod;
+         TimeSystem system;
+         int entity;
+         int center;
+      };
+
+
+         // Earth orientation matrices of an epoch
+      struct RotationEntry
+      {
+         Matrix<double> POM;
+         Matrix<double> Theta;
+         Matrix<double> NP;
+      };
+
+
+         // Ring of the most recently computed epochs. The integrators
+         // only revisit the few epochs of the current step, so a linear
+         // search starting from the newest entry is enough.
+      template <class T>
+      class EpochCache
+      {
+      public:
+
+         EpochCache()
+            : next(0), count(0)
+         {}
+
+         const T* find(const EpochKey& key) const
+         {
+            for(size_t i = 0; i < count; i++)
+            {
+               size_t k = (next + SIZE - 1 - i) % SIZE;
+               if(keys[k] == key) return &values[k];
+            }
+            return NULL;
+         }
+
+         void insert(const EpochKey& key, const T& value)
+         {
+            keys[next] = key;
+            values[next] = value;
+            next = (next + 1) % SIZE;
+            if(count < SIZE) ++count;
+         }
+
+         void clear()
+         { next = 0; count = 0; }
+
+      private:
+
+         static const size_t SIZE = 64;
+
+         EpochKey keys[SIZE];
+         T values[SIZE];
+         size_t next;
+         size_t count;
+      };
+
+
+      EpochCache<RotationEntry> rotationCache;
+      EpochCache< Vector<double> > planetCache;
+
+#ifdef GPSTK_HAVE_PTHREAD
+      pthread_mutex_t cacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+         // Hold the cache mutex for the lifetime of the object
+      class CacheLock
+      {
+      public:
+
+         CacheLock()
+         {
+#ifdef GPSTK_HAVE_PTHREAD
+            pthread_mutex_lock(&cacheMutex);
+#endif
+         }
+
+         ~CacheLock()
+         {
+#ifdef GPSTK_HAVE_PTHREAD
+            pthread_mutex_unlock(&cacheMutex);
+#endif
+         }
+
+      private:
+
+         CacheLock(const CacheLock&);
+         CacheLock& operator=(const CacheLock&);
+      };
+
+   }  // End of anonymous namespace
+
+
+      // Enable or disable the epoch cache
+   void ReferenceFrames::setEpochCache(bool enable)
+   {
+      CacheLock lock;
+
+      useEpochCache = enable;
+      rotationCache.clear();
+      planetCache.clear();
+   }
+
+
+      // Whether the epoch cache is enabled
+   bool ReferenceFrames::getEpochCache()
+   {
+      CacheLock lock;
+
+      return useEpochCache;
+   }
+
+
+      // Enable or disable the precession-nutation cache
+   void ReferenceFrames::setRotationCache(bool enable, double tolerance)
+      throw(InvalidParameter)
+   {
+      pnCache.setTolerance(tolerance);
+
+      CacheLock lock;
+
+      useRotationCache = enable;
+      rotationCache.clear();
+   }
+
+
+      // Whether the precession-nutation cache is enabled
+   bool ReferenceFrames::getRotationCache()
+   {
+      CacheLock lock;
+
+      return useRotationCache;
+   }
+
+
+      // Compute NP (by rows) and the equation of the equinoxes at TT
+   void ReferenceFrames::precessionNutation(const CommonTime& TT,
+                             double values[PrecessionNutationCache::NUM_VALUES])
+   {
+      // IAU 1976 precession matrix       
+      Matrix<double> P = iauPmat76(TT);
+
+      // Nutation correction wrt IAU 1976/1980 (mas->radians)
+      const double DDP80 = 0.0; //-55.0655 * DAS2R/1000.0;
+      const double DDE80 = 0.0; //-6.3580 * DAS2R/1000.0;
+
+      // Nutation angle
+      double DPSI = 0.0;
+      double DEPS = 0.0;         
+      nutationAngles(TT, DPSI, DEPS);
+
+      DPSI += DDP80;
+      DEPS += DDE80;
+
+      // Mean obliquity
+      double EPSA = meanObliquity(TT); 
+
+      // IAU 1980 Nutation matrix
+      Matrix<double> N = iauNmat(EPSA, DPSI , DEPS);
+
+      // NP, by rows
+      Matrix<double> NP = N * P;
+      for(int i=0; i<3; i++)
+         for(int j=0; j<3; j++)
+            values[3*i+j] = NP(i,j);
+
+      // Euqation of the equinoxes, including nutation correction
+      values[9] = iauEqeq94(TT) + DDP80 * std::cos(EPSA);
+
+   }  // End of method 'ReferenceFrames::precessionNutation()'
+
+
 
       /* Compute planet position in J2000
        *  
@@ -132,6 +342,46 @@ namespace gpstk
                                                  SolarSystem::Planet entity,
                                                  SolarSystem::Planet center)
       throw(Exception)
+   {
+      EpochKey key(TT, entity, center);
+
+         // Look the epoch up under the lock, but compute it without,
+         // so that the other threads may use the cache meanwhile
+      bool enabled(false);
+      {
+         CacheLock lock;
+
+         enabled = useEpochCache;
+         const Vector<double>* pCached =
+            enabled ? planetCache.find(key) : NULL;
+         if(pCached)
+         {
+            return *pCached;
+         }
+      }
+
+      Vector<double> rvJ2k = computeJ2kPosVel(TT, entity, center);
+
+      if(enabled)
+      {
+         CacheLock lock;
+
+            // Another thread may have computed it too
+         if(useEpochCache && !planetCache.find(key))
+         {
+            planetCache.insert(key, rvJ2k);
+         }
+      }
+
+      return rvJ2k;
+
+   }  // End of method 'ReferenceFrames::getJ2kPosVel()'
+
+
+      // Compute planet position and velocity, without the cache
+   Vector<double> ReferenceFrames::computeJ2kPosVel(const CommonTime&    TT, 
+                                                    SolarSystem::Planet  entity,
+                                                    SolarSystem::Planet  center)
    {
       Vector<double> rvJ2k(6,0.0);
 
@@ -184,7 +434,7 @@ namespace gpstk
 
       return rvJ2k;
       
-   }  // End of method 'ReferenceFrames::getJ2kPosVel()'
+   }  // End of method 'ReferenceFrames::computeJ2kPosVel()'
 
 
       /* Compute planet position in ECEF
@@ -255,6 +505,56 @@ namespace gpstk
                                          Matrix<double>& Theta, 
                                          Matrix<double>& NP)
       throw(Exception)
+   {
+      EpochKey key(UTC);
+
+         // Look the epoch up under the lock, but compute it without,
+         // so that the other threads may use the cache meanwhile
+      bool enabled(false), interpolate(false);
+      {
+         CacheLock lock;
+
+         enabled = useEpochCache;
+         interpolate = useRotationCache;
+         const RotationEntry* pCached =
+            enabled ? rotationCache.find(key) : NULL;
+         if(pCached)
+         {
+            POM = pCached->POM;
+            Theta = pCached->Theta;
+            NP = pCached->NP;
+            return;
+         }
+      }
+
+      computeJ2kToECEFMatrix(UTC, POM, Theta, NP, interpolate);
+
+      if(enabled)
+      {
+         CacheLock lock;
+
+            // Another thread may have computed it too, and the
+            // precession-nutation cache may have been switched meanwhile
+         if(useEpochCache && useRotationCache == interpolate &&
+            !rotationCache.find(key))
+         {
+            RotationEntry entry;
+            entry.POM = POM;
+            entry.Theta = Theta;
+            entry.NP = NP;
+            rotationCache.insert(key, entry);
+         }
+      }
+
+   }  // End of method 'ReferenceFrames::J2kToECEFMatrix()'
+
+
+      // Compute ECEF = W * S * NP * J2k, without the cache
+   void ReferenceFrames::computeJ2kToECEFMatrix(UTCTime         UTC,
+                                                Matrix<double>& POM,
+                                                Matrix<double>& Theta, 
+                                                Matrix<double>& NP,
+                                                bool            interpolate)
    {
       // Earth orientation data
       double xp = UTC.xPole() * DAS2R;
@@ -264,32 +564,25 @@ namespace gpstk
       CommonTime UT1 = UTC.asUT1();
       
 
-      // IAU 1976 precession matrix       
-      Matrix<double> P = iauPmat76(TT);
-
-      // Nutation correction wrt IAU 1976/1980 (mas->radians)
-      const double DDP80 = 0.0; //-55.0655 * DAS2R/1000.0;
-      const double DDE80 = 0.0; //-6.3580 * DAS2R/1000.0;
-
-      // Nutation angle
-      double DPSI = 0.0;
-      double DEPS = 0.0;         
-      nutationAngles(TT, DPSI, DEPS);
-
-      DPSI += DDP80;
-      DEPS += DDE80;
-
-      // Mean obliquity
-      double EPSA = meanObliquity(TT); 
-      
-      // IAU 1980 Nutation matrix
-      Matrix<double> N = iauNmat(EPSA, DPSI , DEPS);
+      // Precession-nutation matrix and equation of the equinoxes,
+      // interpolated from the daily tables if the cache is enabled
+      double values[PrecessionNutationCache::NUM_VALUES];
+      if(interpolate)
+      {
+         pnCache.interpolate(TT, values);
+      }
+      else
+      {
+         precessionNutation(TT, values);
+      }
 
       // NP
-      NP = N * P;
+      NP.resize(3,3);
+      for(int i=0; i<3; i++)
+         for(int j=0; j<3; j++)
+            NP(i,j) = values[3*i+j];
 
-      // Euqation of the equinoxes, including nutation correction
-      double EE = iauEqeq94(TT) + DDP80 * std::cos(EPSA);
+      double EE = values[9];
 
       // Greenwich apparent sidereal time(IAU 1982/1994)
       double GST = normalizeAngle(iauGmst82(UT1) + EE);
@@ -303,7 +596,7 @@ namespace gpstk
 
       return;
       
-   }  // End of method 'ReferenceFrames::J2kToECEFMatrix()'
+   }  // End of method 'ReferenceFrames::computeJ2kToECEFMatrix()'
 
 
       // return POM * Theta * NP 
@@ -48,6 +48,7 @@
 #include "Matrix.hpp"
 #include "SolarSystem.hpp"
 #include "UTCTime.hpp"
+#include "PrecessionNutationCache.hpp"
 
 namespace gpstk
 {
@@ -74,6 +75,48 @@ namespace gpstk
          return solarPlanets.initializeWithBinaryFile(filename);
       }
 
+
+         /** Enable or disable the epoch cache.
+          *
+          *  When it is enabled, the Earth orientation matrices and the
+          *  planet states computed for an epoch are kept, and later
+          *  requests for that very epoch reuse them. Satellites
+          *  integrated with a common step size request the same
+          *  epochs, so the environment of each integration step is
+          *  computed once for the whole constellation.
+          *
+          *  The cache itself is protected by a mutex, and the flags
+          *  are read under it. A missing epoch is computed outside the
+          *  lock, so two threads may both compute it; only the first
+          *  result is kept, and both are the same. The cache does not
+          *  make the computation thread-safe: that relies on the
+          *  locking of SolarSystem and PrecessionNutationCache.
+          */
+      static void setEpochCache(bool enable);
+
+
+         /// Whether the epoch cache is enabled
+      static bool getEpochCache();
+
+
+         /** Enable or disable the precession-nutation cache.
+          *
+          *  When it is enabled, the precession-nutation matrix and the
+          *  equation of the equinoxes are interpolated from values
+          *  tabulated once per day, instead of summing the nutation series
+          *  at every epoch; see class PrecessionNutationCache. Polar motion
+          *  and sidereal time are still computed exactly.
+          *
+          * @param enable     true to use the cache
+          * @param tolerance  bound on the interpolation error, radians
+          */
+      static void setRotationCache(bool enable, double tolerance = 1.0e-12)
+         throw(InvalidParameter);
+
+
+         /// Whether the precession-nutation cache is enabled
+      static bool getRotationCache();
+
          /** Compute planet position in J2000
           *  
           * @param TT         Time(Modified Julian Date in TT<TAI+32.184>) of interest 
@@ -291,9 +334,36 @@ namespace gpstk
         
    private:
 
+         /// Compute ECEF = POM * Theta * NP * J2k, without the epoch
+         /// cache; NP is interpolated from pnCache if 'interpolate'
+      static void computeJ2kToECEFMatrix(UTCTime         UTC, 
+                                         Matrix<double>& POM,
+                                         Matrix<double>& Theta, 
+                                         Matrix<double>& NP,
+                                         bool            interpolate);
+
+         /// Compute planet position and velocity, without the cache
+      static Vector<double> computeJ2kPosVel(const CommonTime&    TT, 
+                                             SolarSystem::Planet  entity,
+                                             SolarSystem::Planet  center);
+
          /// Objects to handle the JPL Ephemeris
       static SolarSystem solarPlanets;
 
+         /// Flag if the epoch cache is used
+      static bool useEpochCache;
+
+         /// Compute NP (by rows) and the equation of the equinoxes at TT,
+         /// the node function of the precession-nutation cache
+      static void precessionNutation(const CommonTime& TT,
+                            double values[PrecessionNutationCache::NUM_VALUES]);
+
+         /// Tabulated precession-nutation matrix and equation of equinoxes
+      static PrecessionNutationCache pnCache;
+
+         /// Flag if the precession-nutation cache is used
+      static bool useRotationCache;
+
       // Constant Variables
       //-------------------------------------------------
 
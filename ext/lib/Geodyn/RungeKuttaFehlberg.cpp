@@ -214,63 +214,70 @@ namespace gpstk
       Vector<double> ytemp(n,0.0) ;
 
       // ak2
-      ytemp = y + B(1,0) * h * dydx ;
+      ytemp = y + B(1,0) * h * lazy(dydx) ;
       Vector<double> ak2 = peom->getDerivatives(x + A(1) * h, ytemp);
 
 
       // ak3
-      ytemp = y + h * (B(2,0) * dydx + B(2,1) * ak2) ;
+      ytemp = y + h * (B(2,0) * lazy(dydx) + B(2,1) * lazy(ak2)) ;
       Vector<double> ak3 = peom->getDerivatives(x + A(2) * h, ytemp);
       
       // ak4
-      ytemp = y + h * (B(3,0) * dydx + B(3,1) * ak2 + B(3,2) * ak3) ;
+      ytemp = y + h * (B(3,0) * lazy(dydx) + B(3,1) * lazy(ak2) + B(3,2) * lazy(ak3)) ;
       Vector<double> ak4 = peom->getDerivatives(x + A(3) * h, ytemp);
 
       // ak5
-      ytemp = y + h * (B(4,0) * dydx + B(4,1) * ak2 + B(4,2) * ak3 + B(4,3) * ak4) ;
+      ytemp = y + h * (B(4,0) * lazy(dydx) + B(4,1) * lazy(ak2) + B(4,2) * lazy(ak3)
+         + B(4,3) * lazy(ak4)) ;
       Vector<double> ak5 = peom->getDerivatives(x + A(4) * h, ytemp);
       
       // ak6
-      ytemp = y + h * (B(5,0) * dydx + B(5,1) * ak2 + B(5,2) * ak3 + B(5,3) * ak4 
-         + B(5,4) * ak5) ;
+      ytemp = y + h * (B(5,0) * lazy(dydx) + B(5,1) * lazy(ak2) + B(5,2) * lazy(ak3)
+         + B(5,3) * lazy(ak4) + B(5,4) * lazy(ak5)) ;
       Vector<double> ak6 = peom->getDerivatives(x + A(5) * h, ytemp);
       
       // ak7
-      ytemp = y + h * (B(6,0) * dydx + B(6,1) * ak2 + B(6,2) * ak3 + B(6,3) * ak4
-         + B(6,4) * ak5 + B(6,5) * ak6) ;
+      ytemp = y + h * (B(6,0) * lazy(dydx) + B(6,1) * lazy(ak2) + B(6,2) * lazy(ak3)
+         + B(6,3) * lazy(ak4) + B(6,4) * lazy(ak5) + B(6,5) * lazy(ak6)) ;
       Vector<double> ak7 = peom->getDerivatives(x + A(6) * h, ytemp);
       
       // ak8
-      ytemp = y + h * (B(7,0) * dydx + B(7,1) * ak2 + B(7,2) * ak3 + B(7,3) * ak4 
-         + B(7,4) * ak5 + B(7,5) * ak6 + B(7,6) * ak7) ;
+      ytemp = y + h * (B(7,0) * lazy(dydx) + B(7,1) * lazy(ak2) + B(7,2) * lazy(ak3)
+         + B(7,3) * lazy(ak4) + B(7,4) * lazy(ak5) + B(7,5) * lazy(ak6)
+         + B(7,6) * lazy(ak7)) ;
       Vector<double> ak8 = peom->getDerivatives(x + A(7) * h, ytemp);
       
       // ak9
-      ytemp = y + h * (B(8,0) * dydx + B(8,1) * ak2 + B(8,2) * ak3 + B(8,3) * ak4 
-         + B(8,4) * ak5 + B(8,5) * ak6 + B(8,6) * ak7 + B(8,7) * ak8) ;
+      ytemp = y + h * (B(8,0) * lazy(dydx) + B(8,1) * lazy(ak2) + B(8,2) * lazy(ak3)
+         + B(8,3) * lazy(ak4) + B(8,4) * lazy(ak5) + B(8,5) * lazy(ak6)
+         + B(8,6) * lazy(ak7) + B(8,7) * lazy(ak8)) ;
       Vector<double> ak9 = peom->getDerivatives(x + A(8) * h, ytemp);
       
       // ak10
-      ytemp = y + h * (B(9,0) * dydx + B(9,1) * ak2 + B(9,2) * ak3 + B(9,3) * ak4
-         + B(9,4) * ak5 + B(9,5) * ak6 + B(9,6) * ak7 + B(9,7) * ak8 + B(9,8) * ak9) ;
+      ytemp = y + h * (B(9,0) * lazy(dydx) + B(9,1) * lazy(ak2) + B(9,2) * lazy(ak3)
+         + B(9,3) * lazy(ak4) + B(9,4) * lazy(ak5) + B(9,5) * lazy(ak6)
+         + B(9,6) * lazy(ak7) + B(9,7) * lazy(ak8) + B(9,8) * lazy(ak9)) ;
       Vector<double> ak10 = peom->getDerivatives(x + A(9) * h, ytemp);
 
       // ak11
-      ytemp = y + h * (B(10,0) * dydx + B(10,1) * ak2 + B(10,2) * ak3 + B(10,3) * ak4
-         + B(10,4) * ak5 + B(10,5) * ak6 + B(10,6) * ak7 + B(10,7) * ak8 + B(10,8) * ak9 
-         + B(10,9) * ak10) ;
+      ytemp = y + h * (B(10,0) * lazy(dydx) + B(10,1) * lazy(ak2) + B(10,2) * lazy(ak3)
+         + B(10,3) * lazy(ak4) + B(10,4) * lazy(ak5) + B(10,5) * lazy(ak6)
+         + B(10,6) * lazy(ak7) + B(10,7) * lazy(ak8) + B(10,8) * lazy(ak9)
+         + B(10,9) * lazy(ak10)) ;
       Vector<double> ak11 = peom->getDerivatives(x + A(10) * h, ytemp);
       
       // ak12
-      ytemp = y + h * (B(11,0) * dydx + B(11,1) * ak2 + B(11,2) * ak3 + B(11,3) * ak4 
-         + B(11,4) * ak5 + B(11,5) * ak6 + B(11,6) * ak7 + B(11,7) * ak8 + B(11,8) * ak9 
-         + B(11,9) * ak10 + B(11,10) * ak11) ;
+      ytemp = y + h * (B(11,0) * lazy(dydx) + B(11,1) * lazy(ak2) + B(11,2) * lazy(ak3)
+         + B(11,3) * lazy(ak4) + B(11,4) * lazy(ak5) + B(11,5) * lazy(ak6)
+         + B(11,6) * lazy(ak7) + B(11,7) * lazy(ak8) + B(11,8) * lazy(ak9)
+         + B(11,9) * lazy(ak10) + B(11,10) * lazy(ak11)) ;
       Vector<double> ak12 = peom->getDerivatives(x + A(11) * h, ytemp);
       
       // ak13
-      ytemp = y + h * (B(12,0) * dydx + B(12,1) * ak2 + B(12,2) * ak3 + B(12,3) * ak4 
-         + B(12,4) * ak5 + B(12,5) * ak6 + B(12,6) * ak7 + B(12,7) * ak8 + B(12,8) * ak9
-         + B(12,9) * ak10 + B(12,10) * ak11 + B(12,11) * ak12) ;
+      ytemp = y + h * (B(12,0) * lazy(dydx) + B(12,1) * lazy(ak2) + B(12,2) * lazy(ak3)
+         + B(12,3) * lazy(ak4) + B(12,4) * lazy(ak5) + B(12,5) * lazy(ak6)
+         + B(12,6) * lazy(ak7) + B(12,7) * lazy(ak8) + B(12,8) * lazy(ak9)
+         + B(12,9) * lazy(ak10) + B(12,10) * lazy(ak11) + B(12,11) * lazy(ak12)) ;
       Vector<double> ak13 = peom->getDerivatives(x + A(12) * h, ytemp);
       
       yout.resize(n,0.0);
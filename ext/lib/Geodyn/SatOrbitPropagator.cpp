@@ -41,6 +41,7 @@
 */
 
 #include "SatOrbitPropagator.hpp"
+#include "DormandPrince853.hpp"
 
 #include "ASConstant.hpp"
 #include "KeplerOrbit.hpp"
@@ -149,6 +150,42 @@ namespace gpstk
 
       return false;
 
+   }  // End of method 'SatOrbitPropagator::integrateTo()'
+
+
+      // Integrate through a set of increasing output times.
+   void SatOrbitPropagator::integrateTo(const std::vector<double>&      times,
+                                        std::vector< Vector<double> >&  states)
+   {
+      states.resize(times.size());
+      if(times.empty()) return;
+
+      try
+      {
+         DormandPrince853* pDop = dynamic_cast<DormandPrince853*>(pIntegrator);
+         if(pDop)
+         {
+            pDop->integrateTo(curT, curState, pOrbit, times, states);
+
+            curT = times.back();
+            curState = states.back();
+
+            updateMatrix();
+         }
+         else
+         {
+            for(size_t i = 0; i < times.size(); i++)
+            {
+               integrateTo(times[i]);
+               states[i] = curState;
+            }
+         }
+      }
+      catch(Exception& e)
+      {
+         GPSTK_RETHROW(e);
+      }
+
    }  // End of method 'SatOrbitPropagator::integrateTo()'
 
       /*
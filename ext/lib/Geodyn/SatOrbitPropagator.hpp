@@ -45,6 +45,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "Integrator.hpp"
 #include "RungeKuttaFehlberg.hpp"
@@ -148,6 +149,19 @@ namespace gpstk
           */
       virtual bool integrateTo(double tf);
 
+         /** Integrate through a set of increasing output times.
+          *
+          *  With a DormandPrince853 integrator the states at the output
+          *  times are interpolated from its continuous extension, in a
+          *  single pass whose steps do not depend on the output times;
+          *  with other integrators each time is reached in turn.
+          *
+          * @param times   output times, seconds since the reference epoch
+          * @param states  full state (as getCurState()) at each time
+          */
+      void integrateTo(const std::vector<double>&       times,
+                       std::vector< Vector<double> >&   states);
+
 
          /// return the position and velocity , the dimension is 6
       Vector<double> rvState(bool bJ2k = true);
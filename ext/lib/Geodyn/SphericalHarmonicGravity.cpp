@@ -46,102 +46,400 @@
 #include "ReferenceFrames.hpp"
 #include "SpecialFunctions.hpp"
 #include "Epoch.hpp"
+#include "Mat3.hpp"
 
 namespace gpstk
 {
+      // Offset, in elements, of column m of a triangular array stored
+      // by columns, each column m holding rows m..nmax
+   static inline int packedColumn(int m, int nmax)
+   { return m*(nmax+1) - m*(m-1)/2; }
+
+
+      // Complex product (C - iS)*(V + iW): re = C*V + S*W, im = C*W - S*V
+   static inline void csProduct(double C, double S, const double* vw,
+                                double& re, double& im)
+   {
+      re = C*vw[0] + S*vw[1];
+      im = C*vw[1] - S*vw[0];
+   }
+
+
+      // Evaluate column k of the harmonic functions
+      //   V_nk = (R_ref/r)^(n+1) * P_nk(sin(phi)) * cos(k*lambda)
+      //   W_nk = (R_ref/r)^(n+1) * P_nk(sin(phi)) * sin(k*lambda)
+      // for n = k..nv, stored as (V,W) pairs in vw.  For k > 0 the
+      // sectorial term comes from column k-1, for k == 0 (V_00,W_00)
+      // must already be set.
+   static inline void harmonicColumn(int k, int nv,
+                                     double x0, double y0, double z0,
+                                     double rho, const double* recip,
+                                     double* vw)
+   {
+      double* col = vw + 2*packedColumn(k, nv);
+
+      if (k > 0)
+      {
+         const double* prev = vw + 2*packedColumn(k-1, nv);
+         col[0] = (2*k - 1) * ( x0 * prev[0] - y0 * prev[1] );
+         col[1] = (2*k - 1) * ( x0 * prev[1] + y0 * prev[0] );
+      }
+
+      if (k+1 > nv) return;
+
+      col[2] = (2*k + 1) * z0 * col[0];
+      col[3] = (2*k + 1) * z0 * col[1];
+
+      for (int n = k+2; n <= nv; n++)
+      {
+         const int i = 2*(n-k);
+         const double a = (2*n - 1) * z0 * recip[n-k];
+         const double b = (n + k - 1) * rho * recip[n-k];
+         col[i]   = a*col[i-2] - b*col[i-4];
+         col[i+1] = a*col[i-1] - b*col[i-3];
+      }
+   }
+
+
+      // Add the terms of order m (degrees n = m..degree) to the
+      // acceleration acc (x,y,z) and/or the gradient grad
+      // (xx,xy,xz,yy,yz,zz), both in units of GM/R^n.  The columns up
+      // to m+1 (acceleration) or m+2 (gradient) of vw must be known.
+   static inline void harmonicOrder(int m, int degree, int nv,
+                                    const double* cs, const double* vw,
+                                    double* acc, double* grad)
+   {
+      const double* c = cs + 2*packedColumn(m, degree);
+
+         // (V,W)(row, column k) for the first row used, n = m
+      #define GPSTK_VW_AT(row, k) \
+         (vw + 2*(packedColumn((k), nv) + (row) - (k)))
+
+      double re, im, re1, im1, re2, im2;
+
+      if (acc)
+      {
+         double ax(0.0), ay(0.0), az(0.0);
+
+         if (m == 0)
+         {
+            const double* z0 = GPSTK_VW_AT(1, 0);
+            const double* z1 = GPSTK_VW_AT(1, 1);
+            for (int n = 0; n <= degree; n++)
+            {
+               const double C = c[2*n];
+               ax -=       C * z1[2*n];
+               ay -=       C * z1[2*n+1];
+               az -= (n+1)*C * z0[2*n];
+            }
+         }
+         else
+         {
+            const double* zm = GPSTK_VW_AT(m+1, m-1);
+            const double* z0 = GPSTK_VW_AT(m+1, m);
+            const double* zp = GPSTK_VW_AT(m+1, m+1);
+            for (int j = 0; j <= degree-m; j++)
+            {
+               const double C = c[2*j], S = c[2*j+1];
+               const double Fac = 0.5 * (j+1) * (j+2);
+               csProduct(C, S, zp + 2*j, re1, im1);
+               csProduct(C, S, zm + 2*j, re2, im2);
+               csProduct(C, S, z0 + 2*j, re, im);
+               ax += -0.5*re1 + Fac*re2;
+               ay += -0.5*im1 - Fac*im2;
+               az -= (j+1) * re;
+            }
+         }
+
+         acc[0] += ax;
+         acc[1] += ay;
+         acc[2] += az;
+      }
+
+      if (grad)
+      {
+         double xx(0.0), xy(0.0), xz(0.0), yz(0.0), zz(0.0);
+
+         if (m == 0)
+         {
+            const double* g0 = GPSTK_VW_AT(2, 0);
+            const double* g1 = GPSTK_VW_AT(2, 1);
+            const double* g2 = GPSTK_VW_AT(2, 2);
+            for (int n = 0; n <= degree; n++)
+            {
+               const double C = c[2*n];
+               const double Fac = (n+2) * (n+1);
+               zz += Fac * C * g0[2*n];
+               xx += 0.5 * (C * g2[2*n] - Fac * C * g0[2*n]);
+               xy += 0.5 * C * g2[2*n+1];
+               xz += (n+1) * C * g1[2*n];
+               yz += (n+1) * C * g1[2*n+1];
+            }
+         }
+         else
+         {
+            const double* gm = GPSTK_VW_AT(m+2, m-1);
+            const double* g0 = GPSTK_VW_AT(m+2, m);
+            const double* gp = GPSTK_VW_AT(m+2, m+1);
+            const double* gpp = GPSTK_VW_AT(m+2, m+2);
+            for (int j = 0; j <= degree-m; j++)
+            {
+               const double C = c[2*j], S = c[2*j+1];
+               const double f1 = 0.5 * (j+1);
+               const double f2 = (j+3) * (j+2) * f1;
+               csProduct(C, S, g0 + 2*j, re, im);
+               zz += (j+2) * (j+1) * re;
+               csProduct(C, S, gp + 2*j, re1, im1);
+               csProduct(C, S, gm + 2*j, re2, im2);
+               xz += f1*re1 - f2*re2;
+               yz += f1*im1 + f2*im2;
+            }
+
+            if (m == 1)
+            {
+               for (int j = 0; j <= degree-1; j++)
+               {
+                  const int n = j+1;
+                  const double C = c[2*j], S = c[2*j+1];
+                  const double Fac = (n+1) * n;
+                  const double* v1 = g0 + 2*j;
+                  csProduct(C, S, gpp + 2*j, re, im);
+                  xx += 0.25*(re - Fac*(3.0*C*v1[0] + S*v1[1]));
+                  xy += 0.25*(im - Fac*(C*v1[1] + S*v1[0]));
+               }
+            }
+            else
+            {
+               const double* gmm = GPSTK_VW_AT(m+2, m-2);
+               for (int j = 0; j <= degree-m; j++)
+               {
+                  const double C = c[2*j], S = c[2*j+1];
+                  const double F1 = 2.0 * (j+2) * (j+1);
+                  const double F2 = (j+4) * (j+3) * F1 * 0.5;
+                  csProduct(C, S, gpp + 2*j, re1, im1);
+                  csProduct(C, S, g0 + 2*j, re, im);
+                  csProduct(C, S, gmm + 2*j, re2, im2);
+                  xx += 0.25*(re1 - F1*re + F2*re2);
+                  xy += 0.25*(im1 - F2*im2);
+               }
+            }
+         }
+
+         grad[0] += xx;
+         grad[1] += xy;
+         grad[2] += xz;
+         grad[4] += yz;
+         grad[5] += zz;
+      }
+
+      #undef GPSTK_VW_AT
+
+   }
+
+
+      // Auxiliary quantities of the recursions for body fixed position r
+   static inline void harmonicStart(const double r[3], double R_ref,
+                                    double* vw, double& x0, double& y0,
+                                    double& z0, double& rho)
+   {
+      double r_sqr = r[0]*r[0] + r[1]*r[1] + r[2]*r[2];
+      rho = R_ref * R_ref / r_sqr;
+      x0 = R_ref * r[0] / r_sqr;
+      y0 = R_ref * r[1] / r_sqr;
+      z0 = R_ref * r[2] / r_sqr;
+      vw[0] = R_ref / std::sqrt(r_sqr);
+      vw[1] = 0.0;
+   }
+
+
+      // The fused evaluation of V, W, the acceleration and the gradient
+      // for body fixed position r.  With N >= 0 the degree and order are
+      // N and M, known at compile time.
+   template <int N, int M>
+   static void harmonicEvaluate(int degree, int order, const double* cs,
+                                const double* recip, double* vw,
+                                const double r[3], double R_ref,
+                                double acc[3], double grad[6])
+   {
+      if (N >= 0)
+      {
+         degree = N;
+         order = M;
+      }
+      const int nv = degree + 2;
+      const int mv = (order + 2 < nv) ? order + 2 : nv;
+
+      double x0, y0, z0, rho;
+      harmonicStart(r, R_ref, vw, x0, y0, z0, rho);
+
+      for (int k = 0; k <= 2 && k <= mv; k++)
+         harmonicColumn(k, nv, x0, y0, z0, rho, recip, vw);
+
+      for (int i = 0; i < 3; i++) acc[i] = 0.0;
+      for (int i = 0; i < 6; i++) grad[i] = 0.0;
+
+         // Each order needs the columns up to two past it
+      for (int m = 0; m <= order; m++)
+      {
+         if (m+2 > 2 && m+2 <= mv)
+            harmonicColumn(m+2, nv, x0, y0, z0, rho, recip, vw);
+         harmonicOrder(m, degree, nv, cs, vw, acc, grad);
+      }
+
+      grad[3] = -grad[0] - grad[5];   // yy, from Laplace's equation
+   }
+
+
+      // A 3x3 Matrix as a Mat3
+   static inline Mat3<double> toMat3(const Matrix<double>& E)
+   {
+      return Mat3<double>(E(0,0), E(0,1), E(0,2),
+                          E(1,0), E(1,1), E(1,2),
+                          E(2,0), E(2,1), E(2,2));
+   }
+
+
+      // The body fixed gradient grad (xx,xy,xz,yy,yz,zz), scaled and
+      // rotated to ECI with the ECI to ECEF matrix E
+   static Matrix<double> rotateGradient(const double grad[6],
+                                        const Matrix<double>& E,
+                                        double scale)
+   {
+      Mat3<double> e = toMat3(E);
+      Mat3<double> g(grad[0], grad[1], grad[2],
+                     grad[1], grad[3], grad[4],
+                     grad[2], grad[4], grad[5]);
+      Mat3<double> eci = e.transpose() * (g * e) * scale;
+
+      Matrix<double> out(3, 3);
+      for (size_t i = 0; i < 3; i++)
+         for (size_t j = 0; j < 3; j++)
+            out(i,j) = eci(i,j);
+
+      return out;
+   }
+
+
       /* Constructor.
        * @param n Desired degree.
        * @param m Desired order.
        */
    SphericalHarmonicGravity::SphericalHarmonicGravity(int n, int m)
-         : desiredDegree(n),
+         : packedDegree(-1),
+           packedOrder(-1),
+           desiredDegree(n),
            desiredOrder(m),
            correctSolidTide(false),
            correctPoleTide(false),
            correctOceanTide(false)
    {
-      const int size = desiredDegree;
+         //Sn0.resize(gmData.maxDegree, 0.0);
+   }
 
-      V.resize( size + 3, size + 3, 0.0);
-      W.resize( size + 3, size + 3, 0.0);
 
-         //Sn0.resize(gmData.maxDegree, 0.0);
+      // Copy the coefficients into packedCS and size packedVW for the
+      // desired degree and order.
+   void SphericalHarmonicGravity::packCoefficients()
+   {
+      if ( (packedDegree == desiredDegree) && (packedOrder == desiredOrder) )
+         return;
+
+      if ( (desiredDegree < 0) || (desiredOrder < 0) ||
+           (desiredOrder > desiredDegree) ||
+           (desiredDegree >= int(gmData.unnormalizedCS.rows())) )
+      {
+         Exception e("Desired degree and order not in the gravity model");
+         GPSTK_THROW(e);
+      }
+
+      const Matrix<double>& cs = gmData.unnormalizedCS;
+
+         // C_n,m = cs(n,m) and S_n,m = cs(m-1,n)
+      packedCS.resize(2*packedColumn(desiredOrder+1, desiredDegree));
+      for (int m = 0; m <= desiredOrder; m++)
+      {
+         double* c = &packedCS[2*packedColumn(m, desiredDegree)];
+         for (int n = m; n <= desiredDegree; n++)
+         {
+            c[2*(n-m)]   = cs(n, m);
+            c[2*(n-m)+1] = (m == 0) ? 0.0 : cs(m-1, n);
+         }
+      }
+
+         // V and W up to degree desiredDegree+2, followed by the
+         // reciprocals 1/k used by the recursions
+      const int nv = desiredDegree + 2;
+      const int mv = (desiredOrder + 2 < nv) ? desiredOrder + 2 : nv;
+      const int recipStart = 2*packedColumn(mv+1, nv);
+      packedVW.assign(recipStart + nv + 1, 0.0);
+      for (int k = 1; k <= nv; k++)
+         packedVW[recipStart + k] = 1.0 / k;
+
+      packedDegree = desiredDegree;
+      packedOrder = desiredOrder;
+
+   }  // End of method 'SphericalHarmonicGravity::packCoefficients()'
 
-   }
 
       /* Evaluates the two harmonic functions V and W.
        * @param r ECI position vector.
        * @param E ECI to ECEF transformation matrix.
        */
-   void SphericalHarmonicGravity::computeVW(Vector<double> r, Matrix<double> E)
+   void SphericalHarmonicGravity::computeVW(const Vector<double>& r,
+                                            const Matrix<double>& E)
    {   
-         // dimension should be checked here
-         // I'll do it latter...
       if((r.size()!=3) || (E.rows()!=3) || (E.cols()!=3))
       {
          Exception e("Wrong input for computeVW");
          GPSTK_THROW(e);
       }
 
-         // Rotate from ECI to ECEF
-      Vector<double> r_bf = E * r; 
-
-      const double R_ref = gmData.refDistance;
-
-         // Auxiliary quantities
-      double r_sqr =  dot(r_bf, r_bf);
-      double rho   =  R_ref * R_ref / r_sqr;
-
-         // Normalized coordinates
-      double x0 = R_ref * r_bf(0) / r_sqr;          
-      double y0 = R_ref * r_bf(1) / r_sqr;   
-      double z0 = R_ref * r_bf(2) / r_sqr;
+      packCoefficients();
 
+         // Rotate from ECI to ECEF
+      Vec3<double> r_bf = toMat3(E) * Vec3<double>(r(0), r(1), r(2));
 
-         //
-         // Evaluate harmonic functions 
-         //   V_nm = (R_ref/r)^(n+1) * P_nm(sin(phi)) * cos(m*lambda)
-         // and 
-         //   W_nm = (R_ref/r)^(n+1) * P_nm(sin(phi)) * sin(m*lambda)
-         // up to degree and order n_max+1
-         //
+      const int nv = desiredDegree + 2;
+      const int mv = (desiredOrder + 2 < nv) ? desiredOrder + 2 : nv;
+      double* vw = &packedVW[0];
+      const double* recip = vw + 2*packedColumn(mv+1, nv);
 
-         // Calculate zonal terms V(n,0); set W(n,0)=0.0
-      V[0][0] = R_ref / std::sqrt(r_sqr);
-      W[0][0] = 0.0;
+      double x0, y0, z0, rho;
+      harmonicStart(r_bf.data(), gmData.refDistance, vw, x0, y0, z0, rho);
 
-      V[1][0] = z0 * V[0][0];
-      W[1][0] = 0.0;
+      for (int k = 0; k <= mv; k++)
+         harmonicColumn(k, nv, x0, y0, z0, rho, recip, vw);
 
-      for(int n = 2; n <= (desiredDegree+2); n++) 
-      {
-         V[n][0] = ((2*n - 1) * z0 * V[n-1][0] - (n - 1) * rho * V[n-2][0]) /n;
-         W[n][0] = 0.0;
-      }
-
-         // Calculate tesseral and sectorial terms
-      for (int m = 1; m <= (desiredOrder+2); m++) 
-      {
-            // Calculate V(m,m) .. V(n_max+1,m)
+   }  // End of method 'SphericalHarmonicGravity::computeVW()'
 
-         V[m][m] = (2 * m - 1) * ( x0 * V[m-1][m-1] - y0 * W[m-1][m-1] );
-         W[m][m] = (2 * m - 1) * ( x0 * W[m-1][m-1] + y0 * V[m-1][m-1] );
 
-         if (m <= (desiredDegree+1) ) 
-         {
-            V[m+1][m] = (2 * m + 1) * z0 * V[m][m];
-            W[m+1][m] = (2 * m + 1) * z0 * W[m][m];
-         }
+      /* Computes V, W, the body fixed acceleration and the body fixed
+       * gravity gradient in one pass.
+       */
+   void SphericalHarmonicGravity::evaluate(const double r_bf[3],
+                                           double acc[3],
+                                           double grad[6])
+   {
+      packCoefficients();
 
-         for (int n = (m+2); n <= (desiredDegree+2); n++) 
-         {
-            V[n][m] = ((2*n-1)*z0*V[n-1][m] - (n+m-1)*rho*V[n-2][m]) / (n-m);
-            W[n][m] = ((2*n-1)*z0*W[n-1][m] - (n+m-1)*rho*W[n-2][m]) / (n-m);
-         }
+      const int nv = desiredDegree + 2;
+      const int mv = (desiredOrder + 2 < nv) ? desiredOrder + 2 : nv;
+      double* vw = &packedVW[0];
+      const double* recip = vw + 2*packedColumn(mv+1, nv);
+      const double* cs = &packedCS[0];
+      const double R_ref = gmData.refDistance;
 
-      }  // End 'for (int m = 1; m <= (desiredOrder + 2); m++) '
+      if (desiredDegree == 20 && desiredOrder == 20)
+         harmonicEvaluate<20,20>(20, 20, cs, recip, vw, r_bf, R_ref, acc, grad);
+      else if (desiredDegree == 8 && desiredOrder == 8)
+         harmonicEvaluate<8,8>(8, 8, cs, recip, vw, r_bf, R_ref, acc, grad);
+      else if (desiredDegree == 4 && desiredOrder == 4)
+         harmonicEvaluate<4,4>(4, 4, cs, recip, vw, r_bf, R_ref, acc, grad);
+      else
+         harmonicEvaluate<-1,-1>(desiredDegree, desiredOrder, cs, recip, vw,
+                                 r_bf, R_ref, acc, grad);
 
-   }  // End of method 'SphericalHarmonicGravity::computeVW()'
+   }  // End of method 'SphericalHarmonicGravity::evaluate()'
 
 
       /* Computes the acceleration due to gravity in m/s^2.
@@ -149,60 +447,35 @@ namespace gpstk
        * @param E ECI to ECEF transformation matrix.
        * @return ECI acceleration in m/s^2.
        */
-   Vector<double> SphericalHarmonicGravity::gravity(Vector<double> r, Matrix<double> E)
+   Vector<double> SphericalHarmonicGravity::gravity(const Vector<double>& r,
+                                                    const Matrix<double>& E)
    {
-         // dimension should be checked here
-         // I'll do it latter...
       if((r.size()!=3) || (E.rows()!=3) || (E.cols()!=3))
       {
-         Exception e("Wrong input for computeVW");
+         Exception e("Wrong input for gravity");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> cs = gmData.unnormalizedCS;
-
-   
-         // Calculate accelerations ax,ay,az
-      double ax(0.0), ay(0.0), az(0.0);
+      packCoefficients();
 
+         // Calculate accelerations ax,ay,az from V and W
+      const int nv = desiredDegree + 2;
+      double acc[3] = { 0.0, 0.0, 0.0 };
       for (int m = 0; m <= desiredOrder; m++)
-      {
-         for (int n = m; n <= desiredDegree; n++)
-         {
-            if (m==0) 
-            {
-               double C = cs[n][0];               // = C_n,0
-
-               ax -=       C * V[n+1][1];
-               ay -=       C * W[n+1][1];
-               az -= (n+1)*C * V[n+1][0];
-            }
-            else 
-            {
-               double C = cs[n][m];   // = C_n,m
-               double S = cs[m-1][n]; // = S_n,m
-               double Fac = 0.5 * (n-m+1) * (n-m+2);
-               
-               ax += 0.5*(-C*V[n+1][m+1] - S*W[n+1][m+1]) + Fac*(C*V[n+1][m-1] + S*W[n+1][m-1]);
-               ay += 0.5*(-C*W[n+1][m+1] + S*V[n+1][m+1]) + Fac*(-C*W[n+1][m-1] + S*V[n+1][m-1]);
-               az += (n-m+1)*(-C*V[n+1][m] - S*W[n+1][m]);
-            }
-
-         }  // End of 'for (int n = m; n <= (desiredDegree+1) ; n++)'
-
-      }  // End of 'for (int m = 0; m <= (desiredOrder+1); m++)'
+         harmonicOrder(m, desiredDegree, nv, &packedCS[0], &packedVW[0],
+                       acc, 0);
 
          // Body-fixed acceleration
-      Vector<double> a_bf(3,0.0);
-      a_bf(0) = ax;
-      a_bf(1) = ay;
-      a_bf(2) = az;
-
-      a_bf = a_bf * ( gmData.GM / (gmData.refDistance * gmData.refDistance) );
+      Vec3<double> a_bf = Vec3<double>(acc[0], acc[1], acc[2])
+                         * ( gmData.GM / (gmData.refDistance * gmData.refDistance) );
 
          // Inertial acceleration
-      Matrix<double> Etrans = transpose(E);
-      Vector<double> out = Etrans * a_bf;            // this line may be wrong  matrix * vector
+      Vec3<double> a = toMat3(E).transposeTimes(a_bf);
+
+      Vector<double> out(3);
+      out(0) = a[0];
+      out(1) = a[1];
+      out(2) = a[2];
 
       return out;
 
@@ -214,101 +487,27 @@ namespace gpstk
        * @param r ECI position vector.
        * @param E ECI to ECEF transformation matrix.
        */
-   Matrix<double> SphericalHarmonicGravity::gravityGradient(gpstk::Vector<double> r, gpstk::Matrix<double> E)
+   Matrix<double> SphericalHarmonicGravity::gravityGradient(
+                                                const Vector<double>& r,
+                                                const Matrix<double>& E)
    {
-         // dimension should be checked here
-         // I'll do it latter...
       if((r.size()!=3) || (E.rows()!=3) || (E.cols()!=3))
       {
          Exception e("Wrong input for gravityGradient");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> cs = gmData.unnormalizedCS;
-
-   
-      double xx = 0.0;     
-      double xy = 0.0;
-      double xz = 0.0;
-      double yy = 0.0;
-      double yz = 0.0;
-      double zz = 0.0;
-
-      Matrix<double> out(3, 3, 0.0);
+      packCoefficients();
 
-      for (int m = 0; m <= desiredOrder; m++) 
-      {
-         for (int n = m; n <= desiredDegree; n++) 
-         {
-            double Fac = (n-m+2)*(n-m+1);
-            
-            double C = cs[n][m];
-            double S = (m==0) ? 0.0 : cs[m-1][n];   // yan changed
-               //S = (m==0)?Sn0(n):cs[m-1][n];   // yan changed
-
-            zz += Fac*(C*V[n+2][m] + S*W[n+2][m]);
-
-            if (m==0) 
-            {
-               C = cs[n][0];   // = C_n,0
-
-               Fac = (n+2)*(n+1);
-               xx += 0.5 * (C*V[n+2][2] - Fac*C*V[n+2][0]);
-               xy += 0.5 * C * W[n+2][2];
-               
-               Fac = n + 1;
-               xz += Fac * C * V[n+2][1];
-               yz += Fac * C * W[n+2][1];
-            }
-            if (m > 0)
-            {
-               C = cs[n][m];
-               S = cs[m-1][n];
-               
-               double f1 = 0.5*(n-m+1);
-               double f2 = (n-m+3)*(n-m+2)*f1;
-
-               xz += f1*(C*V[n+2][m+1]+S*W[n+2][m+1])-f2*(C*V[n+2][m-1]+S*W[n+2][m-1]);
-               yz += f1*(C*W[n+2][m+1]-S*V[n+2][m+1])+f2*(C*W[n+2][m-1]-S*V[n+2][m-1]);         //* bug in JAT, I fix it
-          
-               if (m == 1)
-               {
-                  Fac = (n+1)*n;
-                  xx += 0.25*(C*V[n+2][3]+S*W[n+2][3]-Fac*(3.0*C*V[n+2][1]+S*W[n+2][1]));
-                  xy += 0.25*(C*W[n+2][3]-S*V[n+2][3]-Fac*(C*W[n+2][1]+S*V[n+2][1]));
-               }
-               if (m > 1) 
-               {
-                  f1 = 2.0*(n-m+2)*(n-m+1);
-                  f2 = (n-m+4)*(n-m+3)*f1*0.5;
-                  xx += 0.25*(C*V[n+2][m+2]+S*W[n+2][m+2]-f1*(C*V[n+2][m]+S*W[n+2][m])+f2*(C*V[n+2][m-2]+S*W[n+2][m-2]));
-
-                  xy += 0.25*(C*W[n+2][m+2]-S*V[n+2][m+2]+f2*(-C*W[n+2][m-2]+S*V[n+2][m-2]));
-               }
-            }
-         }
-         yy = -xx - zz;
-         
-         out(0,0) = xx;
-         out(0,1) = xy;
-         out(0,2) = xz;
-         out(1,0) = xy;
-         out(1,1) = yy;
-         out(1,2) = yz;
-         out(2,0) = xz;
-         out(2,1) = yz;
-         out(2,2) = zz;
-
-      }  // for (int m = 0; m <= desiredOrder; m++) 
+      const int nv = desiredDegree + 2;
+      double grad[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+      for (int m = 0; m <= desiredOrder; m++)
+         harmonicOrder(m, desiredDegree, nv, &packedCS[0], &packedVW[0],
+                       0, grad);
+      grad[3] = -grad[0] - grad[5];
 
       const double R_ref = gmData.refDistance;
-      out = out * (gmData.GM / (R_ref * R_ref * R_ref));
-
-         // Rotate to ECI
-      Matrix<double> Etrans = transpose(E);
-      out = Etrans*(out*E);
-
-      return out;         // the result should be checked
+      return rotateGradient(grad, E, gmData.GM / (R_ref * R_ref * R_ref));
 
    }  // End of 'SphericalHarmonicGravity::gravityGradient()'
 
@@ -346,14 +545,26 @@ namespace gpstk
          // corrcet earth tides
       correctCSTides(utc, correctSolidTide, correctOceanTide, correctPoleTide);
 
-         // Evaluate harmonic functions
-      computeVW(sc.R(), C2T);         // update VM
+         // Evaluate harmonic functions, acceleration and gradient
+      Vector<double> r = sc.R();
+      Mat3<double> e = toMat3(C2T);
+      Vec3<double> r_bf = e * Vec3<double>(r(0), r(1), r(2));
+
+      double acc[3], grad[6];
+      evaluate(r_bf.data(), acc, grad);
+
+      const double R_ref = gmData.refDistance;
 
          // a
-      a = gravity(sc.R(), C2T);
+      Vec3<double> a_eci = e.transposeTimes(
+         Vec3<double>(acc[0], acc[1], acc[2]) * (gmData.GM / (R_ref * R_ref)) );
+      a.resize(3);
+      a(0) = a_eci[0];
+      a(1) = a_eci[1];
+      a(2) = a_eci[2];
       
          // da_dr
-      da_dr = gravityGradient(sc.R(), C2T);
+      da_dr = rotateGradient(grad, C2T, gmData.GM / (R_ref * R_ref * R_ref));
       
          //da_dv
       da_dv.resize(3,3,0.0);
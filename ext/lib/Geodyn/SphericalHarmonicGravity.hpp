@@ -43,6 +43,7 @@
 #ifndef GPSTK_SPHERICAL_HARMONIC_GRAVITY_HPP
 #define GPSTK_SPHERICAL_HARMONIC_GRAVITY_HPP
 
+#include <vector>
 #include "ForceModel.hpp"
 #include "EarthSolidTide.hpp"
 #include "EarthOceanTide.hpp"
@@ -57,6 +58,17 @@ namespace gpstk
 
       /** This class computes the body fixed acceleration due to the harmonic 
        *  gravity field of the central body
+       *
+       *  The coefficients up to the desired degree and order are copied
+       *  once into a packed triangular layout, and the harmonic functions
+       *  V and W are kept in the same layout, column (order) by column,
+       *  with V(n,m) and W(n,m) side by side, so that the recursions and
+       *  the sums run over contiguous memory and operate on (V,W) pairs,
+       *  which the compiler can map onto two-lane SIMD instructions.
+       *  doCompute() evaluates V and W, the acceleration and the gravity
+       *  gradient in a single pass over the orders, and the commonly
+       *  used 4x4, 8x8 and 20x20 fields have versions of that pass with
+       *  the loop bounds fixed at compile time.
        */
    class SphericalHarmonicGravity : public ForceModel
    {
@@ -82,7 +94,7 @@ namespace gpstk
           * @param E ECI to ECEF transformation matrix.
           * @return ECI acceleration in m/s^2.
           */
-      Vector<double> gravity(Vector<double> r, Matrix<double> E);
+      Vector<double> gravity(const Vector<double>& r, const Matrix<double>& E);
 
 
          /** Computes the partial derivative of gravity with respect to position.
@@ -90,7 +102,8 @@ namespace gpstk
           * @param r ECI position vector.
           * @param E ECI to ECEF transformation matrix.
           */
-      Matrix<double> gravityGradient(Vector<double> r, Matrix<double> E);
+      Matrix<double> gravityGradient(const Vector<double>& r,
+                                     const Matrix<double>& E);
       
 
          /** Call the relevant methods to compute the acceleration.
@@ -103,7 +116,7 @@ namespace gpstk
 
 
       SphericalHarmonicGravity& setDesiredDegree(const int& n, const int& m)
-      { desiredDegree = n; desiredOrder = m; return (*this); }
+      { desiredDegree = n; desiredOrder = m; packedDegree = -1; return (*this); }
 
 
       /// Methods to enable earth tide correction
@@ -134,7 +147,22 @@ namespace gpstk
           * @param r ECI position vector.
           * @param E ECI to ECEF transformation matrix.
           */
-      void computeVW(Vector<double> r, Matrix<double> E);
+      void computeVW(const Vector<double>& r, const Matrix<double>& E);
+
+         /** Computes V and W, the body fixed acceleration and the body
+          *  fixed gravity gradient in one pass, in units of GM/R^2 and
+          *  GM/R^3.
+          * @param r_bf  Body fixed position.
+          * @param acc   Acceleration (x, y, z).
+          * @param grad  Gradient (xx, xy, xz, yy, yz, zz).
+          */
+      void evaluate(const double r_bf[3], double acc[3], double grad[6]);
+
+         /** Copies the coefficients up to the desired degree and order
+          *  into packedCS, and sizes packedVW, unless that has already
+          *  been done for the current degree and order.
+          */
+      void packCoefficients();
 
          /// Add tides to coefficients 
       void correctCSTides(UTCTime t,bool solidFlag = false, bool oceanFlag = false, bool poleFlag = false);
@@ -166,9 +194,17 @@ namespace gpstk
 
       } gmData;
 
-         /// V W  (nmax+3)*(nmax+3)
-         /// Harmonic function V and W
-      Matrix<double> V, W;
+         /// Coefficients (C(n,m),S(n,m)) for m <= desiredOrder and
+         /// m <= n <= desiredDegree, by columns m.  S(n,0) is zero.
+      std::vector<double> packedCS;
+
+         /// Harmonic functions (V(n,m),W(n,m)) for m <= desiredOrder+2
+         /// and m <= n <= desiredDegree+2, by columns m.
+      std::vector<double> packedVW;
+
+         /// Degree and order packedCS and packedVW were made for,
+         /// -1 if they have to be made again
+      int packedDegree, packedOrder;
 
          /// Degree and Order of gravity model desired.
       int desiredDegree, desiredOrder;
@@ -0,0 +1,643 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/// @file CSRMatrix.hpp  Compressed (CSR) storage of sparse matrices, for the
+/// products, transpose and SRI operations; build with SparseMatrix.
+
+#ifndef CSR_MATRIX_INCLUDE
+#define CSR_MATRIX_INCLUDE
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>          // for sort, lower_bound
+
+#include "SparseMatrix.hpp"
+#include "SRIMatrix.hpp"
+#include "Matrix.hpp"
+
+namespace gpstk
+{
+   //---------------------------------------------------------------------------
+   /// Class CSRMatrix. This class stores a sparse matrix in compressed sparse row
+   /// (CSR) form: three arrays holding, for each row in turn, the column index and
+   /// the value of every non-zero element, and the position in those arrays where
+   /// each row begins. The CSR form of transpose(A) is the compressed sparse column
+   /// (CSC) form of A, so transpose() is also the conversion between the two.
+   ///
+   /// SparseMatrix (a map of SparseVector rows) is convenient for building a
+   /// matrix an element at a time, but every product and transpose walks trees of
+   /// separately allocated nodes. A CSRMatrix cannot be changed element by element;
+   /// instead build the SparseMatrix (or a list of triplets, as produced by
+   /// SparseMatrix::flatten()) and convert it, then do the arithmetic here. The
+   /// conversions cost about as much as one SparseMatrix product.
+   ///
+   /// Zeros are never stored. Within each row the columns are in ascending order.
+   template <class T> class CSRMatrix
+   {
+   public:
+      /// empty constructor
+      CSRMatrix(void) : nrows(0), ncols(0), rowStart(1,0) { }
+
+      /// constructor with dimensions; all elements are zero
+      CSRMatrix(unsigned int r, unsigned int c) : nrows(r), ncols(c), rowStart(r+1,0)
+         { }
+
+      /// constructor from triplets (row index, column index, value), in any order;
+      /// values given more than once for the same element are added, and zeros
+      /// are dropped.
+      /// @throw Exception if an index is out of range or the lengths differ
+      CSRMatrix(unsigned int r, unsigned int c,
+                const std::vector<unsigned int>& rows,
+                const std::vector<unsigned int>& cols,
+                const std::vector<T>& values) throw(Exception);
+
+      /// constructor from SparseMatrix
+      explicit CSRMatrix(const SparseMatrix<T>& SM);
+
+      /// constructor from Matrix, dropping the zeros
+      explicit CSRMatrix(const Matrix<T>& M);
+
+      /// convert back to SparseMatrix
+      SparseMatrix<T> toSparseMatrix(void) const;
+
+      /// convert to (dense) Matrix
+      Matrix<T> toMatrix(void) const;
+
+      /// get number of rows
+      inline unsigned int rows(void) const { return nrows; }
+
+      /// get number of columns
+      inline unsigned int cols(void) const { return ncols; }
+
+      /// size of matrix = rows()*cols()
+      inline unsigned int size(void) const { return nrows*ncols; }
+
+      /// datasize - number of non-zero data
+      inline unsigned int datasize(void) const { return values.size(); }
+
+      /// density - ratio of number of non-zero element to size()
+      inline double density(void) const
+         { return (double(datasize())/double(size())); }
+
+      /// element (i,j); zero if it is not stored. This is a binary search in row i.
+      T operator()(unsigned int i, unsigned int j) const
+      {
+      #ifdef RANGECHECK
+         if(i >= nrows) GPSTK_THROW(Exception("row index out of range"));
+         if(j >= ncols) GPSTK_THROW(Exception("col index out of range"));
+      #endif
+         std::vector<unsigned int>::const_iterator b(colIndex.begin()+rowStart[i]),
+                                                   e(colIndex.begin()+rowStart[i+1]),
+                                                   it(std::lower_bound(b,e,j));
+         return (it != e && *it == j ? values[it-colIndex.begin()] : T(0));
+      }
+
+      /// return row i as a SparseVector
+      SparseVector<T> rowCopy(const unsigned int i) const;
+
+      /// the storage: row i occupies positions rowPointers()[i] to
+      /// rowPointers()[i+1]-1 of columnIndexes() and data()
+      const std::vector<unsigned int>& rowPointers(void) const { return rowStart; }
+      const std::vector<unsigned int>& columnIndexes(void) const { return colIndex; }
+      const std::vector<T>& data(void) const { return values; }
+
+      /// multiply by a scalar
+      CSRMatrix<T>& operator*=(const T& value)
+      {
+         if(value == T(0)) {
+            colIndex.clear(); values.clear();
+            std::fill(rowStart.begin(), rowStart.end(), 0);
+         }
+         else
+            for(size_t k=0; k<values.size(); k++) values[k] *= value;
+         return *this;
+      }
+
+      /// Dump only non-zero values, with indexes (i,value), as SparseMatrix::dump()
+      std::string dump(const int p=3, bool dosci=false) const
+      {
+         std::ostringstream oss;
+         oss << "dim(" << nrows << "," << ncols << "), size " << size()
+            << ", datasize " << datasize() << " :";
+         oss << (dosci ? std::scientific : std::fixed) << std::setprecision(p);
+         if(values.empty()) { oss << " empty"; return oss.str(); }
+
+         for(unsigned int i=0; i<nrows; i++) {
+            if(rowStart[i] == rowStart[i+1]) continue;
+            oss << "\n row " << i << ": len=" << ncols
+               << ", N=" << rowStart[i+1]-rowStart[i];
+            for(unsigned int k=rowStart[i]; k<rowStart[i+1]; k++)
+               oss << " " << colIndex[k] << "," << values[k];
+         }
+         return oss.str();
+      }
+
+      // the operations below fill the arrays directly
+      template <class U> friend CSRMatrix<U> transpose(const CSRMatrix<U>& A);
+      template <class U> friend CSRMatrix<U> operator*(const CSRMatrix<U>& L,
+                                                       const CSRMatrix<U>& R);
+      template <class U> friend CSRMatrix<U> lowerCholesky(const CSRMatrix<U>& A)
+                                                                    throw(Exception);
+
+   private:
+      /// dimensions of the "real" matrix (not the number of data stored)
+      unsigned int nrows, ncols;
+
+      /// position in colIndex and values of the start of each row; nrows+1 long,
+      /// the last element is the number of data stored
+      std::vector<unsigned int> rowStart;
+
+      /// column index of each stored element
+      std::vector<unsigned int> colIndex;
+
+      /// value of each stored element
+      std::vector<T> values;
+
+   }; // end class CSRMatrix
+
+
+   //---------------------------------------------------------------------------
+   // implementation of CSRMatrix
+   //---------------------------------------------------------------------------
+   // constructor from triplets; a counting sort by row, then a sort within rows
+   template <class T>
+   CSRMatrix<T>::CSRMatrix(unsigned int r, unsigned int c,
+                           const std::vector<unsigned int>& rows,
+                           const std::vector<unsigned int>& cols,
+                           const std::vector<T>& vals) throw(Exception)
+      : nrows(r), ncols(c), rowStart(r+1,0)
+   {
+      if(rows.size() != cols.size() || rows.size() != vals.size()) {
+         std::ostringstream oss;
+         oss << "Invalid input lengths: " << rows.size() << ", " << cols.size()
+            << " and " << vals.size();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      size_t k;
+      for(k=0; k<rows.size(); k++) {
+         if(rows[k] >= nrows || cols[k] >= ncols) {
+            std::ostringstream oss;
+            oss << "Index (" << rows[k] << "," << cols[k]
+               << ") out of range for dimension " << nrows << "x" << ncols;
+            GPSTK_THROW(Exception(oss.str()));
+         }
+         rowStart[rows[k]+1]++;
+      }
+      for(unsigned int i=0; i<nrows; i++) rowStart[i+1] += rowStart[i];
+
+      std::vector< std::pair<unsigned int, T> > sorted(rows.size());
+      std::vector<unsigned int> next(rowStart.begin(), rowStart.end()-1);
+      for(k=0; k<rows.size(); k++)
+         sorted[next[rows[k]]++] = std::pair<unsigned int, T>(cols[k], vals[k]);
+
+      // sort each row, add duplicates and drop zeros
+      colIndex.reserve(sorted.size());
+      values.reserve(sorted.size());
+      unsigned int begin(0);
+      for(unsigned int i=0; i<nrows; i++) {
+         unsigned int end(rowStart[i+1]);
+         std::sort(sorted.begin()+begin, sorted.begin()+end);
+         rowStart[i] = colIndex.size();
+         for(k=begin; k<end; ) {
+            const unsigned int j(sorted[k].first);
+            T sum(0);
+            for( ; k<end && sorted[k].first == j; k++) sum += sorted[k].second;
+            if(sum == T(0)) continue;
+            colIndex.push_back(j);
+            values.push_back(sum);
+         }
+         begin = end;
+      }
+      rowStart[nrows] = colIndex.size();
+   }
+
+   // constructor from SparseMatrix; the rows are already in order
+   template <class T> CSRMatrix<T>::CSRMatrix(const SparseMatrix<T>& SM)
+      : nrows(SM.nrows), ncols(SM.ncols), rowStart(SM.nrows+1,0)
+   {
+      colIndex.reserve(SM.datasize());
+      values.reserve(SM.datasize());
+
+      unsigned int i(0);
+      typename std::map< unsigned int, SparseVector<T> >::const_iterator it;
+      typename std::map< unsigned int, T >::const_iterator jt;
+      for(it = SM.rowsMap.begin(); it != SM.rowsMap.end(); ++it) {
+         for( ; i<=it->first; i++) rowStart[i] = colIndex.size();
+         for(jt = it->second.vecMap.begin(); jt != it->second.vecMap.end(); ++jt) {
+            if(jt->second == T(0)) continue;
+            colIndex.push_back(jt->first);
+            values.push_back(jt->second);
+         }
+      }
+      for( ; i<=nrows; i++) rowStart[i] = colIndex.size();
+   }
+
+   // constructor from Matrix
+   template <class T> CSRMatrix<T>::CSRMatrix(const Matrix<T>& M)
+      : nrows(M.rows()), ncols(M.cols()), rowStart(M.rows()+1,0)
+   {
+      for(unsigned int i=0; i<nrows; i++) {
+         rowStart[i] = colIndex.size();
+         for(unsigned int j=0; j<ncols; j++) {
+            if(M(i,j) == T(0)) continue;
+            colIndex.push_back(j);
+            values.push_back(M(i,j));
+         }
+      }
+      rowStart[nrows] = colIndex.size();
+   }
+
+   // convert to SparseMatrix
+   template <class T> SparseMatrix<T> CSRMatrix<T>::toSparseMatrix(void) const
+   {
+      SparseMatrix<T> SM(nrows,ncols);
+      typename std::map< unsigned int, SparseVector<T> >::iterator it;
+      typename std::map< unsigned int, T >::iterator jt;
+      for(unsigned int i=0; i<nrows; i++) {
+         if(rowStart[i] == rowStart[i+1]) continue;
+         // append with hints, as the indexes are in order
+         it = SM.rowsMap.insert(SM.rowsMap.end(),
+                     std::make_pair(i, SparseVector<T>(ncols)));
+         jt = it->second.vecMap.end();
+         for(unsigned int k=rowStart[i]; k<rowStart[i+1]; k++)
+            jt = it->second.vecMap.insert(jt, std::make_pair(colIndex[k],values[k]));
+      }
+      return SM;
+   }
+
+   // convert to Matrix
+   template <class T> Matrix<T> CSRMatrix<T>::toMatrix(void) const
+   {
+      Matrix<T> M(nrows,ncols,T(0));
+      for(unsigned int i=0; i<nrows; i++)
+         for(unsigned int k=rowStart[i]; k<rowStart[i+1]; k++)
+            M(i,colIndex[k]) = values[k];
+      return M;
+   }
+
+   // return a row as SparseVector
+   template <class T>
+   SparseVector<T> CSRMatrix<T>::rowCopy(const unsigned int i) const
+   {
+      SparseVector<T> SV(ncols);
+      typename std::map< unsigned int, T >::iterator jt(SV.vecMap.end());
+      for(unsigned int k=rowStart[i]; k<rowStart[i+1]; k++)
+         jt = SV.vecMap.insert(jt, std::make_pair(colIndex[k],values[k]));
+      return SV;
+   }
+
+   //---------------------------------------------------------------------------
+   // Transpose, products
+   //---------------------------------------------------------------------------
+   /// transpose; a counting sort on the column indexes, so the rows of the result
+   /// come out in order. This is also the conversion of A from CSR to CSC form.
+   template <class T> CSRMatrix<T> transpose(const CSRMatrix<T>& A)
+   {
+      CSRMatrix<T> toRet(A.ncols, A.nrows);
+      const unsigned int nnz(A.values.size());
+      toRet.colIndex.resize(nnz);
+      toRet.values.resize(nnz);
+
+      unsigned int i,k;
+      for(k=0; k<nnz; k++) toRet.rowStart[A.colIndex[k]+1]++;
+      for(i=0; i<A.ncols; i++) toRet.rowStart[i+1] += toRet.rowStart[i];
+
+      std::vector<unsigned int> next(toRet.rowStart.begin(), toRet.rowStart.end()-1);
+      for(i=0; i<A.nrows; i++) {
+         for(k=A.rowStart[i]; k<A.rowStart[i+1]; k++) {
+            unsigned int p(next[A.colIndex[k]]++);
+            toRet.colIndex[p] = i;
+            toRet.values[p] = A.values[k];
+         }
+      }
+      return toRet;
+   }
+
+   /// CSRMatrix * Vector
+   template <class T> Vector<T> operator*(const CSRMatrix<T>& L, const Vector<T>& V)
+      throw(Exception)
+   {
+      if(L.cols() != V.size()) {
+         std::ostringstream oss;
+         oss << "Incompatible dimensions op*(CSR,V) "
+            << L.rows() << "x" << L.cols() << " * " << V.size();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const std::vector<unsigned int>& rs(L.rowPointers());
+      const std::vector<unsigned int>& ci(L.columnIndexes());
+      const std::vector<T>& va(L.data());
+      Vector<T> toRet(L.rows());
+      for(unsigned int i=0; i<L.rows(); i++) {
+         T sum(0);
+         for(unsigned int k=rs[i]; k<rs[i+1]; k++)
+            sum += va[k] * V(ci[k]);
+         toRet(i) = sum;
+      }
+      return toRet;
+   }
+
+   /// Vector * CSRMatrix, that is transpose(L)*V
+   template <class T> Vector<T> operator*(const Vector<T>& V, const CSRMatrix<T>& R)
+      throw(Exception)
+   {
+      if(V.size() != R.rows()) {
+         std::ostringstream oss;
+         oss << "Incompatible dimensions op*(V,CSR) "
+            << V.size() << " * " << R.rows() << "x" << R.cols();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const std::vector<unsigned int>& rs(R.rowPointers());
+      const std::vector<unsigned int>& ci(R.columnIndexes());
+      const std::vector<T>& va(R.data());
+      Vector<T> toRet(R.cols(),T(0));
+      for(unsigned int i=0; i<R.rows(); i++) {
+         const T v(V(i));
+         if(v == T(0)) continue;
+         for(unsigned int k=rs[i]; k<rs[i+1]; k++)
+            toRet(ci[k]) += v * va[k];
+      }
+      return toRet;
+   }
+
+   /// CSRMatrix * Matrix
+   template <class T> Matrix<T> operator*(const CSRMatrix<T>& L, const Matrix<T>& R)
+      throw(Exception)
+   {
+      if(L.cols() != R.rows()) {
+         std::ostringstream oss;
+         oss << "Incompatible dimensions op*(CSR,M) "
+            << L.rows() << "x" << L.cols() << " * "
+            << R.rows() << "x" << R.cols();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const std::vector<unsigned int>& rs(L.rowPointers());
+      const std::vector<unsigned int>& ci(L.columnIndexes());
+      const std::vector<T>& va(L.data());
+      Matrix<T> toRet(L.rows(),R.cols(),T(0));
+      // columns of the result are contiguous
+      for(unsigned int j=0; j<R.cols(); j++) {
+         T *t(&toRet(0,j));
+         for(unsigned int i=0; i<L.rows(); i++) {
+            T sum(0);
+            for(unsigned int k=rs[i]; k<rs[i+1]; k++)
+               sum += va[k] * R(ci[k],j);
+            t[i] = sum;
+         }
+      }
+      return toRet;
+   }
+
+   /// Matrix * CSRMatrix
+   template <class T> Matrix<T> operator*(const Matrix<T>& L, const CSRMatrix<T>& R)
+      throw(Exception)
+   {
+      if(L.cols() != R.rows()) {
+         std::ostringstream oss;
+         oss << "Incompatible dimensions op*(M,CSR) "
+            << L.rows() << "x" << L.cols() << " * "
+            << R.rows() << "x" << R.cols();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const std::vector<unsigned int>& rs(R.rowPointers());
+      const std::vector<unsigned int>& ci(R.columnIndexes());
+      const std::vector<T>& va(R.data());
+      Matrix<T> toRet(L.rows(),R.cols(),T(0));
+      // column k of L, times row k of R, is added to the result
+      for(unsigned int k=0; k<R.rows(); k++) {
+         for(unsigned int p=rs[k]; p<rs[k+1]; p++) {
+            const T v(va[p]);
+            T *t(&toRet(0,ci[p]));
+            for(unsigned int i=0; i<L.rows(); i++)
+               t[i] += L(i,k) * v;
+         }
+      }
+      return toRet;
+   }
+
+   /// CSRMatrix * CSRMatrix; row by row, accumulating each row of the result in a
+   /// dense work vector (Gustavson's algorithm).
+   template <class T>
+   CSRMatrix<T> operator*(const CSRMatrix<T>& L, const CSRMatrix<T>& R)
+   {
+      if(L.ncols != R.nrows) {
+         std::ostringstream oss;
+         oss << "Incompatible dimensions op*(CSR,CSR) "
+            << L.nrows << "x" << L.ncols << " * " << R.nrows << "x" << R.ncols;
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      CSRMatrix<T> toRet(L.nrows, R.ncols);
+      std::vector<T> work(R.ncols, T(0));
+      std::vector<unsigned int> mark(R.ncols, L.nrows), cols;
+      unsigned int i,j,k,p;
+
+      for(i=0; i<L.nrows; i++) {
+         cols.clear();
+         for(k=L.rowStart[i]; k<L.rowStart[i+1]; k++) {
+            const T v(L.values[k]);
+            const unsigned int r(L.colIndex[k]);
+            for(p=R.rowStart[r]; p<R.rowStart[r+1]; p++) {
+               j = R.colIndex[p];
+               if(mark[j] != i) { mark[j] = i; work[j] = T(0); cols.push_back(j); }
+               work[j] += v * R.values[p];
+            }
+         }
+         std::sort(cols.begin(), cols.end());
+         for(k=0; k<cols.size(); k++) {
+            if(work[cols[k]] == T(0)) continue;
+            toRet.colIndex.push_back(cols[k]);
+            toRet.values.push_back(work[cols[k]]);
+         }
+         toRet.rowStart[i+1] = toRet.colIndex.size();
+      }
+      return toRet;
+   }
+
+   /// transpose(A) * A
+   template <class T> CSRMatrix<T> transposeTimesMatrix(const CSRMatrix<T>& A)
+      throw(Exception)
+   {
+      return (transpose(A) * A);
+   }
+
+   //---------------------------------------------------------------------------
+   // SRI operations: Cholesky, triangular solutions, measurement update
+   //---------------------------------------------------------------------------
+   /// Compute lower triangular square root of a symmetric positive definite matrix
+   /// (Cholesky decomposition). Row i of L is non-zero only from the first non-zero
+   /// element of row i of A to the diagonal (the envelope of A), so a block
+   /// diagonal or banded matrix, such as a measurement covariance, is decomposed
+   /// at the cost of its blocks. Only the lower triangle of A is used.
+   /// @param A CSRMatrix to be decomposed; symmetric and positive definite
+   /// @return CSRMatrix lower triangular square root of input matrix
+   /// @throw if input CSRMatrix is not square
+   /// @throw if input CSRMatrix is not positive definite
+   template <class T>
+   CSRMatrix<T> lowerCholesky(const CSRMatrix<T>& A) throw(Exception)
+   {
+      if(A.nrows != A.ncols || A.nrows == 0) {
+         std::ostringstream oss;
+         oss << "Invalid input dimensions: " << A.nrows << "x" << A.ncols;
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const unsigned int n(A.nrows);
+      CSRMatrix<T> L(n,n);
+      std::vector<T> work(n, T(0));
+      unsigned int i,j,k,p,f;
+
+      for(i=0; i<n; i++) {
+         // row i of A, within the envelope f..i
+         f = (A.rowStart[i] < A.rowStart[i+1] ? A.colIndex[A.rowStart[i]] : i);
+         if(f > i) f = i;
+         for(j=f; j<=i; j++) work[j] = T(0);
+         for(k=A.rowStart[i]; k<A.rowStart[i+1] && A.colIndex[k]<=i; k++)
+            work[A.colIndex[k]] = A.values[k];
+
+         // L(i,j) = (A(i,j) - sum(k<j) L(i,k)*L(j,k)) / L(j,j)
+         for(j=f; j<i; j++) {
+            T sum(work[j]);
+            for(p=L.rowStart[j]; p+1<L.rowStart[j+1]; p++)   // last is diagonal
+               if(L.colIndex[p] >= f) sum -= work[L.colIndex[p]] * L.values[p];
+            work[j] = sum / L.values[L.rowStart[j+1]-1];
+         }
+
+         // the diagonal
+         T d(work[i]);
+         for(j=f; j<i; j++) d -= work[j]*work[j];
+         if(d <= T(0)) {
+            std::ostringstream oss;
+            oss << "Non-positive eigenvalue " << std::scientific << d << " at col "
+               << i << ": lowerCholesky() requires positive-definite input";
+            GPSTK_THROW(Exception(oss.str()));
+         }
+         work[i] = SQRT(d);
+
+         for(j=f; j<=i; j++) {
+            if(work[j] == T(0)) continue;
+            L.colIndex.push_back(j);
+            L.values.push_back(work[j]);
+         }
+         L.rowStart[i+1] = L.colIndex.size();
+      }
+      return L;
+   }
+
+   /// Solve L*X = B, for lower triangular L, in place (B is replaced with X);
+   /// that is B = inverse(L)*B without forming inverse(L). This is how data
+   /// and partials are whitened by the Cholesky factor of their covariance.
+   /// @throw if the dimensions do not match, or L has a zero diagonal element
+   template <class T>
+   void lowerTriangularSolve(const CSRMatrix<T>& L, Matrix<T>& B) throw(Exception)
+   {
+      if(L.rows() != L.cols() || L.rows() != B.rows()) {
+         std::ostringstream oss;
+         oss << "Invalid input dimensions: L is " << L.rows() << "x" << L.cols()
+            << " and B is " << B.rows() << "x" << B.cols();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      const std::vector<unsigned int>& rs(L.rowPointers());
+      const std::vector<unsigned int>& ci(L.columnIndexes());
+      const std::vector<T>& va(L.data());
+      for(unsigned int i=0; i<L.rows(); i++) {
+         if(rs[i] == rs[i+1] || ci[rs[i+1]-1] != i || va[rs[i+1]-1] == T(0)) {
+            std::ostringstream oss;
+            oss << "Singular lower triangular matrix at row " << i;
+            GPSTK_THROW(Exception(oss.str()));
+         }
+      }
+
+      for(unsigned int j=0; j<B.cols(); j++) {
+         T *b(&B(0,j));
+         for(unsigned int i=0; i<L.rows(); i++) {
+            T sum(b[i]);
+            const unsigned int d(rs[i+1]-1);
+            for(unsigned int k=rs[i]; k<d; k++)
+               sum -= va[k] * b[ci[k]];
+            b[i] = sum / va[d];
+         }
+      }
+   }
+
+   /// Square root information measurement update, with partials P and data D
+   /// given as a CSRMatrix and a Vector; see the doc for SrifMU() in
+   /// SRIMatrix.hpp. The Householder transformation fills in the rows of P as it
+   /// goes, so they are gathered into the dense array of the SRIMatrix SrifMU().
+   /// On output D holds the residuals of the first M rows.
+   template <class T>
+   void SrifMU(Matrix<T>& R, Vector<T>& Z, const CSRMatrix<T>& P, Vector<T>& D,
+               const unsigned int M=0) throw(Exception)
+   {
+      if(P.rows() != D.size()) {
+         std::ostringstream oss;
+         oss << "Invalid input dimensions:\n  Partials are "
+            << P.rows() << "x" << P.cols() << ",\n  and Data has length "
+            << D.size();
+         GPSTK_THROW(Exception(oss.str()));
+      }
+
+      try {
+         const unsigned int m(M==0 || M>P.rows() ? P.rows() : M), n(P.cols());
+         const std::vector<unsigned int>& rs(P.rowPointers());
+         const std::vector<unsigned int>& ci(P.columnIndexes());
+         const std::vector<T>& va(P.data());
+
+         Matrix<T> A(m,n+1,T(0));
+         for(unsigned int i=0; i<m; i++) {
+            for(unsigned int k=rs[i]; k<rs[i+1]; k++)
+               A(i,ci[k]) = va[k];
+            A(i,n) = D(i);
+         }
+
+         SrifMU(R,Z,A,m);
+
+         for(unsigned int i=0; i<m; i++)
+            D(i) = A(i,n);
+      }
+      catch(Exception& e) { GPSTK_RETHROW(e); }
+   }
+
+}  // namespace
+
+#endif   // define CSR_MATRIX_INCLUDE
@@ -64,6 +64,11 @@ namespace gpstk
    // epoch for CoordTransTime
    const long GeodeticFrames::JulianEpoch=2451545;
 
+   // precession-nutation cache, not used by default
+   PrecessionNutationCache
+      GeodeticFrames::PNCache(&GeodeticFrames::PrecessionNutation);
+   bool GeodeticFrames::usePNCache=false;
+
    //---------------------------------------------------------------------------------
    //---------------------------------------------------------------------------------
    // functions used internally
@@ -1677,15 +1682,19 @@ namespace gpstk
       throw(InvalidRequest)
    {
       try {
-	      Matrix<double> P,N,W,S;
+	      Matrix<double> PN(3,3),W,S;
 
 	      double T=CoordTransTime(t);
-         P = PrecessionMatrix(T);
 
-	      double eps=Obliquity(T);								// degrees
-         double deps,dpsi;
-         NutationAngles(T,deps,dpsi);
-         N = NutationMatrix(eps,dpsi,deps);
+         // P*N and gast-GMST, exact or interpolated
+         double values[PrecessionNutationCache::NUM_VALUES];
+         if(usePNCache)
+            PNCache.interpolate(t, values);
+         else
+            PrecessionNutation(t, values);
+         for(int i=0; i<3; i++)
+            for(int j=0; j<3; j++)
+               PN(i,j) = values[3*i+j];
 
          // PolarMotion converts xp, yp to radians
 	      W = PolarMotion(xp, yp);
@@ -1695,17 +1704,55 @@ namespace gpstk
          if(reduced)
             UT1mUTCTidalCorrections(T, UT1mUT1R, dlodR, domegaR);
 
-	      double omega = Omega(T);
-	      double g = gast(t, omega, eps, dpsi, reduced ? UT1mUT1R-UT1mUTC : UT1mUTC);
+         // same as gast()
+	      double g = GMST(t, reduced ? UT1mUT1R-UT1mUTC : UT1mUTC) + values[9];
          S = rotation(-g,3);
 
-	      return (P*N*W*S);
+	      return (PN*W*S);
       }
       catch(InvalidRequest& ire) {
          GPSTK_RETHROW(ire);
       }
    }
 
+   //---------------------------------------------------------------------------------
+   // Compute P*N (by rows) and gast-GMST (radians) at the given time.
+   void GeodeticFrames::PrecessionNutation(const CommonTime& t,
+                              double values[PrecessionNutationCache::NUM_VALUES])
+   {
+      double T=CoordTransTime(t);
+      Matrix<double> P = PrecessionMatrix(T);
+
+      double eps=Obliquity(T);                                 // degrees
+      double deps,dpsi;
+      NutationAngles(T,deps,dpsi);
+      Matrix<double> N = NutationMatrix(eps,dpsi,deps);
+
+      Matrix<double> PN = P*N;
+      for(int i=0; i<3; i++)
+         for(int j=0; j<3; j++)
+            values[3*i+j] = PN(i,j);
+
+      // the terms gast() adds to GMST
+      double om = Omega(T) * DEG_TO_RAD;
+      values[9] = (       dpsi * ::cos(eps * DEG_TO_RAD)
+                    + 0.00264  * ::sin(om)
+                    + 0.000063 * ::sin(2.0*om) ) * DEG_TO_RAD / 3600.0;
+   }
+
+   //---------------------------------------------------------------------------------
+   void GeodeticFrames::SetPrecessionNutationCache(bool enable, double tol)
+      throw(InvalidParameter)
+   {
+      try {
+         PNCache.setTolerance(tol);
+         usePNCache = enable;
+      }
+      catch(InvalidParameter& ip) {
+         GPSTK_RETHROW(ip);
+      }
+   }
+
    //---------------------------------------------------------------------------------
    // Given a rotation matrix R (3x3), inverse(R)=transpose(R),
    // find the Euler angles (theta,phi,psi) which produce this rotation,
@@ -56,6 +56,7 @@
 #include "CommonTime.hpp"
 #include "Matrix.hpp"
 #include "YDSTime.hpp"
+#include "PrecessionNutationCache.hpp"
 
 //------------------------------------------------------------------------------------
 namespace gpstk
@@ -375,6 +376,19 @@ namespace gpstk
                                            double deps)
          throw(InvalidRequest);
 
+      //------------------------------------------------------------------------------
+      /// Compute the product of the precession and nutation matrices, by rows, and
+      /// the equation of the equinoxes gast-GMST (radians) at the given time; this
+      /// is the node function of the precession-nutation cache.
+      static void PrecessionNutation(const CommonTime& t,
+                        double values[PrecessionNutationCache::NUM_VALUES]);
+
+      /// Cache of the precession-nutation matrix and equation of the equinoxes
+      static PrecessionNutationCache PNCache;
+
+      /// True when ECEFtoInertial() uses PNCache
+      static bool usePNCache;
+
    public:
 
       //------------------------------------------------------------------------------
@@ -461,6 +475,16 @@ namespace gpstk
                                            bool reduced=false)
          throw(InvalidRequest);
 
+      //------------------------------------------------------------------------------
+      /// Have ECEFtoInertial() interpolate the precession-nutation matrix and the
+      /// equation of the equinoxes from values computed once per day, rather than
+      /// summing the nutation series at every call; see class
+      /// PrecessionNutationCache. The default is not to use the cache.
+      /// @param enable true to use the cache.
+      /// @param tol bound on the interpolation error, in radians.
+      static void SetPrecessionNutationCache(bool enable, double tol=1.0e-12)
+         throw(InvalidParameter);
+
       //------------------------------------------------------------------------------
       /// Given a rotation matrix R (3x3), find the Euler angles (theta,phi,psi) which
       /// produce this rotation, and also determine the magnitude alpha and direction
@@ -0,0 +1,217 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file PrecessionNutationCache.cpp
+ * Implementation of class gpstk::PrecessionNutationCache, a time-indexed
+ * cache of the precession-nutation matrix and the equation of the equinoxes.
+ */
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <cmath>
+// GPSTk
+#include "StringUtils.hpp"
+#include "PrecessionNutationCache.hpp"
+
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+using namespace std;
+
+namespace gpstk
+{
+   //---------------------------------------------------------------------------------
+   // Sum of |amplitude|*frequency^4 over the IAU 1980 nutation series, in
+   // longitude (1.502e-7) and obliquity (0.626e-7), doubled.
+   const double PrecessionNutationCache::NUTATION_D4 = 4.26e-7;
+
+   //---------------------------------------------------------------------------------
+   // Hold the mutex of a cache for the lifetime of the object
+   namespace
+   {
+#ifdef GPSTK_HAVE_PTHREAD
+      class MutexLock
+      {
+      public:
+         MutexLock(pthread_mutex_t& m) : mutex(m)
+            { pthread_mutex_lock(&mutex); }
+         ~MutexLock()
+            { pthread_mutex_unlock(&mutex); }
+      private:
+         pthread_mutex_t& mutex;
+      };
+#endif
+   }
+
+   //---------------------------------------------------------------------------------
+   struct PrecessionNutationCache::Mutex
+   {
+#ifdef GPSTK_HAVE_PTHREAD
+      Mutex()
+         { pthread_mutex_init(&mutex, NULL); }
+      ~Mutex()
+         { pthread_mutex_destroy(&mutex); }
+      pthread_mutex_t mutex;
+#endif
+   };
+
+   //---------------------------------------------------------------------------------
+   PrecessionNutationCache::PrecessionNutationCache(NodeFunction f,
+                                                    double tolerance,
+                                                    int maxDaysIn)
+      throw(InvalidParameter)
+      : nodeFunction(f), tol(0.0), nodesPerDay(0),
+        maxDays(maxDaysIn < 1 ? 1 : maxDaysIn), useCount(0),
+        pMutex(new Mutex)
+   {
+      try {
+         setTolerance(tolerance);
+      }
+      catch(InvalidParameter&) {
+         delete pMutex;
+         throw;
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   PrecessionNutationCache::~PrecessionNutationCache()
+   {
+      delete pMutex;
+   }
+
+   //---------------------------------------------------------------------------------
+   // The grid step h meets the tolerance when h^4 * NUTATION_D4 / 24 <= tol.
+   void PrecessionNutationCache::setTolerance(double tolerance)
+      throw(InvalidParameter)
+   {
+      if(tolerance <= 0.0) {
+         InvalidParameter ip("Tolerance must be positive: "
+                             + StringUtils::asString(tolerance));
+         GPSTK_THROW(ip);
+      }
+
+#ifdef GPSTK_HAVE_PTHREAD
+      MutexLock lock(pMutex->mutex);
+#endif
+      tol = tolerance;
+      double n = ::pow(NUTATION_D4/(24.0*tol), 0.25);
+      nodesPerDay = (n < 4.0 ? 4 : static_cast<int>(::ceil(n)));
+      days.clear();
+   }
+
+   //---------------------------------------------------------------------------------
+   double PrecessionNutationCache::getErrorBound() const
+   {
+      double h = 1.0/nodesPerDay;
+      return h*h*h*h*NUTATION_D4/24.0;
+   }
+
+   //---------------------------------------------------------------------------------
+   void PrecessionNutationCache::clear()
+   {
+#ifdef GPSTK_HAVE_PTHREAD
+      MutexLock lock(pMutex->mutex);
+#endif
+      days.clear();
+   }
+
+   //---------------------------------------------------------------------------------
+   void PrecessionNutationCache::fillDay(long day,
+                                         const CommonTime& t,
+                                         DayTable& table)
+   {
+      table.values.resize((nodesPerDay+1)*NUM_VALUES);
+      CommonTime node(t);
+      for(int k=0; k<=nodesPerDay; k++) {
+         if(k < nodesPerDay)
+            node.set(day, k*86400.0/nodesPerDay, t.getTimeSystem());
+         else
+            node.set(day+1, 0.0, t.getTimeSystem());
+         nodeFunction(node, &table.values[k*NUM_VALUES]);
+      }
+   }
+
+   //---------------------------------------------------------------------------------
+   // Cubic Lagrange interpolation over the four nodes around t, all of them
+   // within the day of t.
+   void PrecessionNutationCache::interpolate(const CommonTime& t,
+                                             double values[NUM_VALUES])
+   {
+      long day, msod;
+      double fsod;
+      t.getInternal(day, msod, fsod);
+
+#ifdef GPSTK_HAVE_PTHREAD
+      MutexLock lock(pMutex->mutex);
+#endif
+
+      std::map<long, DayTable>::iterator it = days.find(day);
+      if(it == days.end()) {
+         if(static_cast<int>(days.size()) >= maxDays) {
+            std::map<long, DayTable>::iterator oldest = days.begin();
+            for(std::map<long, DayTable>::iterator jt = days.begin();
+                jt != days.end(); ++jt)
+               if(jt->second.lastUse < oldest->second.lastUse) oldest = jt;
+            days.erase(oldest);
+         }
+         DayTable table;
+         fillDay(day, t, table);
+         it = days.insert(std::make_pair(day, table)).first;
+      }
+      it->second.lastUse = ++useCount;
+
+         // position in the grid, in units of the step
+      double x = (msod*1.0e-3 + fsod) * nodesPerDay / 86400.0;
+      int k = static_cast<int>(x) - 1;
+      if(k < 0) k = 0;
+      if(k > nodesPerDay-3) k = nodesPerDay-3;
+      double u = x - k;
+
+      double w[4];
+      w[0] = -(u-1.0)*(u-2.0)*(u-3.0)/6.0;
+      w[1] =  u*(u-2.0)*(u-3.0)/2.0;
+      w[2] = -u*(u-1.0)*(u-3.0)/2.0;
+      w[3] =  u*(u-1.0)*(u-2.0)/6.0;
+
+      const double *p = &it->second.values[k*NUM_VALUES];
+      for(int i=0; i<NUM_VALUES; i++)
+         values[i] = w[0]*p[i] + w[1]*p[i+NUM_VALUES]
+                   + w[2]*p[i+2*NUM_VALUES] + w[3]*p[i+3*NUM_VALUES];
+   }
+
+} // end namespace gpstk
@@ -0,0 +1,186 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file PrecessionNutationCache.hpp
+ * Include file defining the PrecessionNutationCache class.
+ * class gpstk::PrecessionNutationCache tabulates the precession-nutation
+ * matrix and the equation of the equinoxes on a grid of epochs, one day
+ * at a time, and interpolates them with a known bound on the error.
+ */
+
+#ifndef CLASS_PRECESSIONNUTATIONCACHE_INCLUDE
+#define CLASS_PRECESSIONNUTATIONCACHE_INCLUDE
+
+//------------------------------------------------------------------------------------
+// system includes
+#include <map>
+#include <vector>
+// GPSTk
+#include "Exception.hpp"
+#include "CommonTime.hpp"
+
+//------------------------------------------------------------------------------------
+namespace gpstk
+{
+   /** Class PrecessionNutationCache keeps the slowly varying part of the
+     * celestial to terrestrial rotation: the precession-nutation matrix and
+     * the equation of the equinoxes. These come from long trigonometric
+     * series (the nutation) and are the expensive part of the rotation,
+     * while the Earth rotation angle and the polar motion are cheap and are
+     * left to the caller.
+     *
+     * The values are computed by a user function at the nodes of a uniform
+     * grid, the first time a day is requested, and are interpolated with a
+     * cubic (4 point Lagrange) polynomial over the nodes of that day only.
+     * The error of the interpolation of a function f is at most
+     *
+     * <pre>
+     *    h^4 * max|f''''| / 24
+     * </pre>
+     *
+     * for grid step h. The fourth derivative of the nutation angles is
+     * bounded by the sum of amplitude * frequency^4 over the terms of the
+     * series; for the IAU 1980 series, which has the same principal terms
+     * as the IERS 1996 one, it is 2.13e-7 rad/day^4. Twice this value, to
+     * cover the smaller terms, the precession and the products of the
+     * lower derivatives, is used to choose the grid from the requested
+     * tolerance. The default tolerance, 1e-12 rad (0.2 microarcseconds, or
+     * 27 microns at the GPS orbit radius), is met with a 2 hour grid.
+     *
+     * The days are kept in a small table, the least recently used one is
+     * replaced when it is full. All the methods may be called from several
+     * threads at once.
+     */
+   class PrecessionNutationCache
+   {
+   public:
+
+      /// Number of values at each node: the 3x3 precession-nutation matrix,
+      /// by rows, and the equation of the equinoxes (radians)
+      static const int NUM_VALUES = 10;
+
+      /// Bound on the fourth derivative of the nutation angles, in rad/day^4,
+      /// including the safety factor
+      static const double NUTATION_D4;
+
+      /// Function that computes the values at an epoch
+      typedef void (*NodeFunction)(const CommonTime& t,
+                                   double values[NUM_VALUES]);
+
+      /// Constructor.
+      /// @param f         function that computes the tabulated values
+      /// @param tolerance bound on the interpolation error, in radians
+      /// @param maxDays   number of days kept in memory
+      PrecessionNutationCache(NodeFunction f,
+                              double tolerance = 1.0e-12,
+                              int maxDays = 4)
+         throw(InvalidParameter);
+
+      /// Destructor
+      ~PrecessionNutationCache();
+
+      /// Interpolate the values at the given epoch. The epochs of a day are
+      /// interpolated from the nodes computed at the epochs of that day, in
+      /// the same time system as t.
+      /// @param t       epoch of interest
+      /// @param values  the interpolated values (output)
+      void interpolate(const CommonTime& t, double values[NUM_VALUES]);
+
+      /// Change the tolerance; this empties the cache.
+      void setTolerance(double tolerance)
+         throw(InvalidParameter);
+
+      /// Get the tolerance, in radians.
+      double getTolerance() const
+         { return tol; }
+
+      /// Get the number of grid intervals per day.
+      int getNodesPerDay() const
+         { return nodesPerDay; }
+
+      /// Get the bound on the interpolation error of the current grid, in
+      /// radians. It is never greater than the tolerance.
+      double getErrorBound() const;
+
+      /// Remove all the days from the cache.
+      void clear();
+
+   private:
+
+      /// The nodes of one day, NUM_VALUES values for each of the
+      /// nodesPerDay+1 nodes (the last one is midnight of the next day)
+      struct DayTable
+      {
+         std::vector<double> values;
+         unsigned long lastUse;
+      };
+
+      /// Compute the nodes of the given day into 'table'
+      void fillDay(long day, const CommonTime& t, DayTable& table);
+
+      /// Not copyable
+      PrecessionNutationCache(const PrecessionNutationCache&);
+      PrecessionNutationCache& operator=(const PrecessionNutationCache&);
+
+      /// Function computing the values at the nodes
+      NodeFunction nodeFunction;
+
+      /// Requested bound on the interpolation error, radians
+      double tol;
+
+      /// Number of grid intervals per day
+      int nodesPerDay;
+
+      /// Number of days kept
+      int maxDays;
+
+      /// Days in the cache, by day number
+      std::map<long, DayTable> days;
+
+      /// Counter used to find the least recently used day
+      unsigned long useCount;
+
+      /// Protects all the members above. It is defined in the .cpp file,
+      /// so that the class is the same with and without POSIX threads.
+      struct Mutex;
+      Mutex *pMutex;
+
+   }; // end class PrecessionNutationCache
+
+} // end namespace gpstk
+
+#endif  // nothing below this...
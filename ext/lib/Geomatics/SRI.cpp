@@ -67,6 +67,7 @@ using namespace StringUtils;
    // used to mark optional input
    const Matrix<double> SRINullMatrix;
    const SparseMatrix<double> SRINullSparseMatrix;
+   const CSRMatrix<double> SRINullCSRMatrix;
 
    //---------------------------------------------------------------------------------
    // constructor given the dimension N.
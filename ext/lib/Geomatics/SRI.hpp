@@ -62,6 +62,7 @@
 #include "Namelist.hpp"
 #include "SRIMatrix.hpp"
 #include "SparseMatrix.hpp"
+#include "CSRMatrix.hpp"
 
 namespace gpstk
 {
@@ -71,6 +72,8 @@ namespace gpstk
 extern const Matrix<double> SRINullMatrix;
 /// constant (empty) SparseMatrix used for default input arguments
 extern const SparseMatrix<double> SRINullSparseMatrix;
+/// constant (empty) CSRMatrix used for default input arguments
+extern const CSRMatrix<double> SRINullCSRMatrix;
 
 //------------------------------------------------------------------------------------
 /// class SRI encapsulates all the information associated with the solution of a set
@@ -349,11 +352,23 @@ public:
       /// for SrifMU().
    void measurementUpdate(SparseMatrix<double>& Partials, Vector<double>& Data)
       throw(Exception)
+   {
+      try {
+         SrifMU(R, Z, CSRMatrix<double>(Partials), Data);
+      }
+      catch(Exception& me) { GPSTK_RETHROW(me); }
+   }
+
+      /// SRIF (Kalman) measurement update, or least squares update, CSRMatrix
+      /// version. Call the SRI measurement update for this SRI and the given input.
+      /// See doc. for SrifMU().
+   void measurementUpdate(const CSRMatrix<double>& Partials, Vector<double>& Data)
+      throw(Exception)
    {
       try {
          SrifMU(R, Z, Partials, Data);
       }
-      catch(MatrixException& me) { GPSTK_RETHROW(me); }
+      catch(Exception& me) { GPSTK_RETHROW(me); }
    }
 
       /// Compute the condition number, or rather the largest and smallest eigenvalues
@@ -45,6 +45,7 @@
 #include "SRIFilter.hpp"
 #include "RobustStats.hpp"
 #include "StringUtils.hpp"
+#include "MatrixKernels.hpp"
 
 //------------------------------------------------------------------------------------
 // TD
@@ -146,20 +147,32 @@ void SRIFilter::measurementUpdate(const Matrix<double>& H, Vector<double>& D,
       GPSTK_THROW(me);
    }
    try {
-         // whiten partials and data
-      Matrix<double> P(H);
-      Matrix<double> CHL(lowerCholesky(CM));
-      if(&CM != &SRINullMatrix) {
-         Matrix<double> L(inverseLT(CHL));
-         P = L * P;
-         D = L * D;
+         // whiten partials and data, solving CHL*[P|D] = [H|D] by forward
+         // substitution, where CHL is the lower Cholesky factor of CM
+      const bool whiten(&CM != &SRINullMatrix);
+      Matrix<double> P(H), CHL;
+      if(whiten) {
+         CHL = lowerCholesky(CM);
+         const unsigned int m(D.size()), n(P.cols());
+         unsigned int i,j,k;
+         for(i=0; i<m; i++) {
+            const double inv(1.0/CHL(i,i));
+            for(k=0; k<i; k++) {
+               const double l(CHL(i,k));
+               if(l == 0.0) continue;
+               for(j=0; j<n; j++) P(i,j) -= l*P(k,j);
+               D(i) -= l*D(k);
+            }
+            for(j=0; j<n; j++) P(i,j) *= inv;
+            D(i) *= inv;
+         }
       }
 
          // update *this with the whitened information
       SrifMU(R, Z, P, D);
 
          // un-whiten residuals
-      if(&CM != &SRINullMatrix) {         // same if above creates CHL
+      if(whiten) {
          D = CHL * D;
       }
    }
@@ -173,9 +186,26 @@ void SRIFilter::measurementUpdate(const Matrix<double>& H, Vector<double>& D,
 void SRIFilter::measurementUpdate(const SparseMatrix<double>& H, Vector<double>& D,
                                   const SparseMatrix<double>& CM)
    throw(MatrixException,VectorException)
+{
+   try {
+      if(&CM == &SRINullSparseMatrix)
+         measurementUpdate(CSRMatrix<double>(H), D);
+      else
+         measurementUpdate(CSRMatrix<double>(H), D, CSRMatrix<double>(CM));
+   }
+   catch(MatrixException& me) { GPSTK_RETHROW(me); }
+   catch(VectorException& ve) { GPSTK_RETHROW(ve); }
+}
+
+//------------------------------------------------------------------------------------
+// SRIF (Kalman) measurement update, or least squares update -- CSRMatrix version
+// Returns unwhitened residuals in D
+void SRIFilter::measurementUpdate(const CSRMatrix<double>& H, Vector<double>& D,
+                                  const CSRMatrix<double>& CM)
+   throw(MatrixException,VectorException)
 {
    if(H.cols() != R.cols() || H.rows() != D.size() ||
-      (&CM != &SRINullSparseMatrix &&
+      (&CM != &SRINullCSRMatrix &&
          (CM.rows() != D.size() || CM.cols() != D.size())) )
    {
       string msg("\nInvalid input dimensions:\n  SRI is ");
@@ -184,7 +214,7 @@ void SRIFilter::measurementUpdate(const SparseMatrix<double>& H, Vector<double>&
           + asString<int>(H.rows()) + "x"
           + asString<int>(H.cols()) + ",\n  Data has length "
           + asString<int>(D.size());
-      if(&CM != &SRINullSparseMatrix) msg += ",\n  and Cov is "
+      if(&CM != &SRINullCSRMatrix) msg += ",\n  and Cov is "
           + asString<int>(CM.rows()) + "x"
           + asString<int>(CM.cols());
 
@@ -192,26 +222,42 @@ void SRIFilter::measurementUpdate(const SparseMatrix<double>& H, Vector<double>&
       GPSTK_THROW(me);
    }
    try {
-      SparseMatrix<double> A(H || D);
-      SparseMatrix<double> CHL;
-         // whiten partials and data
-      if(&CM != &SRINullSparseMatrix) {
+         // the transformation fills in the partials, so A = H || D is dense
+      const unsigned int m(H.rows()), n(H.cols());
+      const vector<unsigned int>& rs(H.rowPointers());
+      const vector<unsigned int>& ci(H.columnIndexes());
+      const vector<double>& va(H.data());
+      Matrix<double> A(m,n+1,0.0);
+      for(unsigned int i=0; i<m; i++) {
+         for(unsigned int k=rs[i]; k<rs[i+1]; k++)
+            A(i,ci[k]) = va[k];
+         A(i,n) = D(i);
+      }
+
+         // whiten partials and data, by forward substitution with the
+         // Cholesky factor, which has the sparsity of CM
+      CSRMatrix<double> CHL;
+      if(&CM != &SRINullCSRMatrix) {
          CHL = lowerCholesky(CM);
-         SparseMatrix<double> L(inverseLT(CHL));
-         A = L * A;
+         lowerTriangularSolve(CHL, A);
       }
 
          // update *this with the whitened information
       SrifMU(R, Z, A);
 
          // copy out D and un-whiten residuals
-      D = Vector<double>(A.colCopy(A.cols()-1));
-      if(&CM != &SRINullSparseMatrix) {      // same if above creates CHL
+      for(unsigned int i=0; i<m; i++)
+         D(i) = A(i,n);
+      if(&CM != &SRINullCSRMatrix) {      // same if above creates CHL
          D = CHL * D;
       }
    }
    catch(MatrixException& me) { GPSTK_RETHROW(me); }
    catch(VectorException& ve) { GPSTK_RETHROW(ve); }
+   catch(Exception& e) {
+      MatrixException me(e.what());
+      GPSTK_THROW(me);
+   }
 }
 
 //------------------------------------------------------------------------------------
@@ -371,20 +417,17 @@ void SRIFilter::Reset(const int N)
 // Ref: Bierman, G.J. "Factorization Methods for Discrete Sequential
 //      Estimation," Academic Press, 1977, pg 121.
 // -------------------------------------------------------------------
-template <class T>
-void SRIFilter::SrifTU(Matrix<T>& R,
-                       Vector<T>& Z,
-                       Matrix<T>& PhiInv,
-                       Matrix<T>& Rw,
-                       Matrix<T>& G,
-                       Vector<T>& Zw,
-                       Matrix<T>& Rwx)
+void SRIFilter::SrifTU(Matrix<double>& R,
+                       Vector<double>& Z,
+                       Matrix<double>& PhiInv,
+                       Matrix<double>& Rw,
+                       Matrix<double>& G,
+                       Vector<double>& Zw,
+                       Matrix<double>& Rwx)
    throw(MatrixException)
 {
-   const T EPS=-T(1.e-200);
    unsigned int n=R.rows(),ns=Rw.rows();
-   unsigned int i,j,k;
-   T sum, beta, delta, dum;
+   unsigned int i,j;
 
    if(PhiInv.rows() < n || PhiInv.cols() < n ||
       G.rows() < n || G.cols() < ns ||
@@ -410,112 +453,50 @@ void SRIFilter::SrifTU(Matrix<T>& R,
 
    try {
       // initialize
-      Rwx = T(0);
+      Rwx = 0.0;
       PhiInv = R * PhiInv;                   // set PhiInv = Rd = R*PhiInv
-      G = -PhiInv * G;
-      // fixed Matrix problem - unary minus should not return an l-value
-      //G = -(PhiInv * G);                     // set G = -Rd*G
-
-      // temp
-      //Matrix <T> A;
-      //A = (Rw || Rwx || Zw) && (G || PhiInv || Z);
-      //cout << "SrifTU - :\n" << fixed << setw(10) << setprecision(5) << A << endl;
-
-      //---------------------------------------------------------------
-      for(j=0; j<ns; j++) {               // loop over first ns columns
-         sum = T(0);
-         for(i=0; i<n; i++)               // rows of -Rd*G
-            sum += G(i,j)*G(i,j);
-         dum = Rw(j,j);
-         sum += dum*dum;
-         sum = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-         delta = dum - sum;
-         Rw(j,j) = sum;
-
-         beta = sum * delta;
-         if(beta > EPS) continue;
-         beta = T(1)/beta;
-
-            // apply jth Householder transformation
-            // to submatrix below and right of (j,j)
-         if(j+1 < ns) {                   // apply to G
-            for(k=j+1; k<ns; k++) {       // columns to right of diagonal
-               sum = delta * Rw(j,k);
-               for(i=0; i<n; i++)         // rows of G
-                  sum += G(i,j)*G(i,k);
-               if(sum == T(0)) continue;
-               sum *= beta;
-               Rw(j,k) += sum*delta;
-               for(i=0; i<n; i++)         // rows of G again
-                  G(i,k) += sum * G(i,j);
-            }
-         }
-
-            // apply jth Householder transformation
-            // to Rwx and PhiInv
-         for(k=0; k<n; k++) {             // columns of Rwx and PhiInv
-            sum = delta * Rwx(j,k);
-            for(i=0; i<n; i++)            // rows of PhiInv and G
-               sum += PhiInv(i,k) * G(i,j);
-            if(sum == T(0)) continue;
-            sum *= beta;
-            Rwx(j,k) += sum*delta;
-            for(i=0; i<n; i++)            // rows of PhiInv and G
-               PhiInv(i,k) += sum * G(i,j);
-         }                                // end loop over columns of Rwx and PhiInv
-
-            // apply jth Householder transformation
-            // to Zw and Z
-         sum = delta * Zw(j);
-         for(i=0; i<n; i++)               // rows of G and elements of Z
-            sum += Z(i) * G(i,j);
-         if(sum == T(0)) continue;
-         sum *= beta;
-         Zw(j) += sum * delta;
-         for(i=0; i<n; i++)               // rows of G and elements of Z
-            Z(i) += sum * G(i,j);
-      }                                   // end loop over first ns columns
-
-      //---------------------------------------------------------------
-      for(j=0; j<n; j++) {                // loop over columns of Rwx and PhiInv
-         sum = T(0);
-         for(i=j+1; i<n; i++)             // rows of PhiInv
-            sum += PhiInv(i,j)*PhiInv(i,j);
-         dum = PhiInv(j,j);
-         sum += dum*dum;
-         sum = (dum > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-         delta = dum - sum;
-         PhiInv(j,j) = sum;
-         beta = sum*delta;
-         if(beta > EPS) continue;
-         beta = T(1)/beta;
-
-            // apply jth Householder transformation to columns of PhiInv on row j
-         for(k=j+1; k<n; k++) {           // columns of PhiInv
-            sum = delta * PhiInv(j,k);
-            for(i=j+1; i<n; i++)
-               sum += PhiInv(i,j)*PhiInv(i,k);
-            if(sum == T(0)) continue;
-            sum *= beta;
-            PhiInv(j,k) += sum*delta;
-            for(i=j+1; i<n; i++)
-               PhiInv(i,k) += sum * PhiInv(i,j);
-         }
-
-            // apply jth Householder transformation to Z
-         sum = delta *Z(j);
-         for(i=j+1; i<n; i++)
-            sum += Z(i) * PhiInv(i,j);
-         if(sum == T(0)) continue;
-         sum *= beta;
-         Z(j) += sum*delta;
-         for(i=j+1; i<n; i++)
-            Z(i) += sum * PhiInv(i,j);
-      }                                   // end loop over cols of Rwx and PhiInv
-
-      // temp
-      //A = (Rw || Rwx || Zw) && (G || PhiInv || Z);
-      //cout << "SrifTU + :\n" << fixed << setw(10) << setprecision(5) << A << endl;
+      G = -PhiInv * G;                       // set G = -Rd*G
+
+         // stack the matrix into one column major array, Householder
+         // transform it in place, and copy it back
+      const unsigned int nr(ns+n);
+      double stackBuf[1024];
+      std::vector<double> heapBuf;
+      double *W(stackBuf);
+      if(nr*(nr+1) > 1024) {
+         heapBuf.resize(nr*(nr+1));
+         W = &heapBuf[0];
+      }
+      for(j=0; j<ns; j++) {
+         double *w = W + j*nr;
+         for(i=0; i<ns; i++) w[i] = Rw(i,j);
+         for(i=0; i<n; i++) w[ns+i] = G(i,j);
+      }
+      for(j=0; j<n; j++) {
+         double *w = W + (ns+j)*nr;
+         for(i=0; i<ns; i++) w[i] = Rwx(i,j);
+         for(i=0; i<n; i++) w[ns+i] = PhiInv(i,j);
+      }
+      double *w = W + nr*nr;
+      for(i=0; i<ns; i++) w[i] = Zw(i);
+      for(i=0; i<n; i++) w[ns+i] = Z(i);
+
+         // Rw is upper triangular; every column is transformed, even if it
+         // is already zero below the diagonal
+      householder(nr, nr+1, nr, ns, W, nr, false);
+
+      for(j=0; j<ns; j++) {
+         const double *w = W + j*nr;
+         for(i=0; i<ns; i++) Rw(i,j) = w[i];
+         for(i=0; i<n; i++) G(i,j) = w[ns+i];
+      }
+      for(j=0; j<n; j++) {
+         const double *w = W + (ns+j)*nr;
+         for(i=0; i<ns; i++) Rwx(i,j) = w[i];
+         for(i=0; i<n; i++) PhiInv(i,j) = w[ns+i];
+      }
+      for(i=0; i<ns; i++) Zw(i) = w[i];
+      for(i=0; i<n; i++) Z(i) = w[ns+i];
 
          // copy transformed R out of PhiInv
       for(j=0; j<n; j++)
@@ -597,14 +578,13 @@ void SRIFilter::SrifTU(Matrix<T>& R,
 //
 // Ref: Bierman, G.J. "Factorization Methods for Discrete Sequential
 //      Estimation," Academic Press, 1977, pg 216.
-template <class T>
-void SRIFilter::SrifSU(Matrix<T>& R,
-                       Vector<T>& Z,
-                       Matrix<T>& Phi,
-                       Matrix<T>& Rw,
-                       Matrix<T>& G,
-                       Vector<T>& Zw,
-                       Matrix<T>& Rwx)
+void SRIFilter::SrifSU(Matrix<double>& R,
+                       Vector<double>& Z,
+                       Matrix<double>& Phi,
+                       Matrix<double>& Rw,
+                       Matrix<double>& G,
+                       Vector<double>& Zw,
+                       Matrix<double>& Rwx)
    throw(MatrixException)
 {
    unsigned int N=R.rows(),Ns=Rw.rows();
@@ -631,147 +611,59 @@ void SRIFilter::SrifSU(Matrix<T>& R,
       GPSTK_THROW(me);
    }
 
-   const T EPS=-T(1.e-200);
-   size_t i, j, k;
-   T sum, beta, delta, diag;
+   size_t i, j;
 
 try {
       // Rw+Rwx*G -> A
-   Matrix<T> A;
+   Matrix<double> A;
    A = Rw + Rwx*G;
    Rwx = Rwx * Phi;
    Phi = R * Phi;
    G = R * G;
 
          //-----------------------------------------
-         // HouseHolder Transformation
-
-         // Loop over first Ns columns
-   for(j=0; j<Ns; j++) {                  // columns of A
-      sum = T(0);
-      for(i=j+1; i<Ns; i++) {             // rows i below diagonal in A
-         sum += A(i,j) * A(i,j);
-      }
-      for(i=0; i<N; i++) {                // all rows i in G
-         sum += G(i,j) * G(i,j);
-      }
-
-      diag = A(j,j);
-      sum += diag*diag;
-      sum = (diag > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-      delta = diag - sum;
-      A(j,j) = sum;
-      beta = sum*delta;
-      if(beta > EPS) continue;
-      beta = T(1)/beta;
-
-            // apply jth HH trans to submatrix below and right of j,j
-      for(k=j+1; k<Ns; k++) {                // cols to right of diag
-         sum = delta * A(j,k);
-         for(i=j+1; i<Ns; i++) {             // rows of A below diagonal
-            sum += A(i,j)*A(i,k);
-         }
-         for(i=0; i<N; i++) {                // all rows of G
-            sum += G(i,j)*G(i,k);
-         }
-         if(sum == T(0)) continue;
-         sum *= beta;
-            //------------------------------------------
-         A(j,k) += sum*delta;
+         // HouseHolder Transformation, in place on one column major array
+   const size_t Nr(Ns+N);
+   double stackBuf[1024];
+   std::vector<double> heapBuf;
+   double *W(stackBuf);
+   if(Nr*(Nr+1) > 1024) {
+      heapBuf.resize(Nr*(Nr+1));
+      W = &heapBuf[0];
+   }
+   for(j=0; j<Ns; j++) {
+      double *w = W + j*Nr;
+      for(i=0; i<Ns; i++) w[i] = A(i,j);
+      for(i=0; i<N; i++) w[Ns+i] = G(i,j);
+   }
+   for(j=0; j<N; j++) {
+      double *w = W + (Ns+j)*Nr;
+      for(i=0; i<Ns; i++) w[i] = Rwx(i,j);
+      for(i=0; i<N; i++) w[Ns+i] = Phi(i,j);
+   }
+   double *w = W + Nr*Nr;
+   for(i=0; i<Ns; i++) w[i] = Zw(i);
+   for(i=0; i<N; i++) w[Ns+i] = Z(i);
 
-         for(i=j+1; i<Ns; i++) {             // rows of A > j (same loops again)
-            A(i,k) += sum * A(i,j);
-         }
-         for(i=0; i<N; i++) {                // all rows of G (again)
-            G(i,k) += sum * G(i,j);
-         }
-      }
+   householder(Nr, Nr+1, Nr, 0, W, Nr, false);
 
-            // apply jth HH trans to Rwx and Phi sub-matrices
-      for(k=0; k<N; k++) {                // all columns of Rwx / Phi
-         sum = delta * Rwx(j,k);
-         for(i=j+1; i<Ns; i++) {          // rows of Rwx below j
-            sum += A(i,j) * Rwx(i,k);
-         }
-         for(i=0; i<N; i++) {             // all rows of Phi
-            sum += G(i,j) * Phi(i,k);
-         }
-         if(sum == T(0)) continue;
-         sum *= beta;
-         Rwx(j,k) += sum*delta;
-         for(i=j+1; i<Ns; i++) {          // rows of Rwx below j (again)
-            Rwx(i,k) += sum * A(i,j);
-         }
-         for(i=0; i<N; i++) {             // all rows of Phi (again)
-            Phi(i,k) += sum * G(i,j);
-         }
-      }
-
-            // apply jth HH trans to Zw and Z
-      sum = delta * Zw(j);
-      for(i=j+1; i<Ns; i++) {             // rows (elements) of Zw below j
-         sum += A(i,j) * Zw(i);
-      }
-      for(i=0; i<N; i++) {                // all rows (elements) of Z
-         sum += Z(i) * G(i,j);
-      }
-      if(sum == T(0)) continue;
-      sum *= beta;
-      Zw(j) += sum*delta;
-      for(i=j+1; i<Ns; i++) {             // rows of Zw below j (again)
-         Zw(i) += sum * A(i,j);
-      }
-      for(i=0; i<N; i++) {                // all rows of Z (again)
-         Z(i) += sum * G(i,j);
-      }
+   for(j=0; j<Ns; j++) {
+      const double *w = W + j*Nr;
+      for(i=0; i<N; i++) G(i,j) = w[Ns+i];
    }
-
-         // Loop over columns past the Ns block: all of Rwx and Phi
    for(j=0; j<N; j++) {
-      sum = T(0);
-      for(i=j+1; i<N; i++) {              // rows of Phi at and below j
-         sum += Phi(i,j) * Phi(i,j);
-      }
-      diag = Phi(j,j);
-      sum += diag*diag;
-      sum = (diag > T(0) ? -T(1) : T(1)) * ::sqrt(sum);
-      delta = diag - sum;
-      Phi(j,j) = sum;
-      beta = sum*delta;
-      if(beta > EPS) continue;
-      beta = T(1)/beta;
-
-               // apply HH trans to Phi sub-block below and right of j,j
-      for(k=j+1; k<N; k++) {                 // columns k > j
-         sum = delta * Phi(j,k);
-         for(i=j+1; i<N; i++) {              // rows below j
-            sum += Phi(i,j) * Phi(i,k);
-         }
-         if(sum == T(0)) continue;
-         sum *= beta;
-         Phi(j,k) += sum*delta;
-         for(i=j+1; i<N; i++) {              // rows below j (again)
-            Phi(i,k) += sum * Phi(i,j);
-         }
-      }
-               // Now apply to the Z column
-      sum = delta * Z(j);
-      for(i=j+1; i<N; i++) {                 // rows of Z below j
-         sum += Z(i) * Phi(i,j);
-      }
-      if(sum == T(0)) continue;
-      sum *= beta;
-      Z(j) += sum*delta;
-      for(i=j+1; i<N; i++) {                 // rows of Z below j (again)
-         Z(i) += sum * Phi(i,j);
-      }
+      const double *w = W + (Ns+j)*Nr;
+      for(i=0; i<Ns; i++) Rwx(i,j) = w[i];
+      for(i=0; i<N; i++) Phi(i,j) = w[Ns+i];
    }
+   for(i=0; i<Ns; i++) Zw(i) = w[i];
+   for(i=0; i<N; i++) Z(i) = w[Ns+i];
       //------------------------------
       // Transformation finished
 
       //-------------------------------------
       // copy transformed R out of Phi into R
-   R = T(0);
+   R = 0.0;
    for(j=0; j<N; j++) {
       for(i=0; i<=j; i++) {
          R(i,j) = Phi(i,j);
@@ -147,6 +147,18 @@ public:
                           const SparseMatrix<double>& CM=SRINullSparseMatrix)
    throw(MatrixException,VectorException);
 
+      /// SRIF (Kalman) simple linear measurement update with optional weight matrix
+      /// CSRMatrix version; the SparseMatrix version converts its input and
+      /// calls this one.
+      /// @param H  Partials matrix, dimension MxN.
+      /// @param D  Data vector, length M; on output D is post-fit residuals.
+      /// @param CM Measurement covariance matrix, dimension MxM.
+      /// @throw if dimension N does not match dimension of SRI, or if other
+      ///        dimensions are inconsistent, or if CM is singular.
+   void measurementUpdate(const CSRMatrix<double>& H, Vector<double>& D,
+                          const CSRMatrix<double>& CM=SRINullCSRMatrix)
+   throw(MatrixException,VectorException);
+
       /// SRIF (Kalman) time update
       /// This routine uses the Householder transformation to propagate the SRIFilter
       /// state and covariance through a time step.
@@ -390,25 +402,23 @@ public:
 
 private:
       /// SRIF time update (non-SRI version); SRIFilter::timeUpdate for doc.
-   template <class T>
-   static void SrifTU(Matrix<T>& R,
-                      Vector<T>& Z,
-                      Matrix<T>& Phi,
-                      Matrix<T>& Rw,
-                      Matrix<T>& G,
-                      Vector<T>& Zw,
-                      Matrix<T>& Rwx)
+   static void SrifTU(Matrix<double>& R,
+                      Vector<double>& Z,
+                      Matrix<double>& Phi,
+                      Matrix<double>& Rw,
+                      Matrix<double>& G,
+                      Vector<double>& Zw,
+                      Matrix<double>& Rwx)
       throw(MatrixException);
 
       /// SRIF smoother update (non-SRI version); SRIFilter::smootherUpdate for doc.
-   template <class T>
-   static void SrifSU(Matrix<T>& R,
-                      Vector<T>& Z,
-                      Matrix<T>& Phi,
-                      Matrix<T>& Rw,
-                      Matrix<T>& G,
-                      Vector<T>& Zw,
-                      Matrix<T>& Rwx)
+   static void SrifSU(Matrix<double>& R,
+                      Vector<double>& Z,
+                      Matrix<double>& Phi,
+                      Matrix<double>& Rw,
+                      Matrix<double>& G,
+                      Vector<double>& Zw,
+                      Matrix<double>& Rwx)
       throw(MatrixException);
 
       /// SRIF smoother update in covariance / state form;
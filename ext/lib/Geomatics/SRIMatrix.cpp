@@ -0,0 +1,105 @@
+/// @file SRIMatrix.cpp
+/// Double precision specializations of the square root information routines
+/// of SRIMatrix.hpp.
+
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+//------------------------------------------------------------------------------------
+#include <vector>
+#include "SRIMatrix.hpp"
+#include "MatrixKernels.hpp"
+
+namespace gpstk
+{
+
+   //---------------------------------------------------------------------------------
+   // [R Z] is stacked over the first M rows of A = H || D in one column major
+   // array, and the Householder transformation is applied to the whole of it;
+   // the first N rows (R) are upper triangular, so that each transformation
+   // touches only its own row of R and Z.
+   template <>
+   void SrifMU(Matrix<double>& R, Vector<double>& Z, Matrix<double>& A,
+               unsigned int M) throw(MatrixException)
+   {
+      if(A.cols() <= 1 || A.cols() != R.cols()+1 || Z.size() < R.rows()) {
+         if(A.cols() > 1 && R.rows() == 0 && Z.size() == 0) {
+            // create R and Z
+            R = Matrix<double>(A.cols()-1,A.cols()-1,0.0);
+            Z = Vector<double>(A.cols()-1,0.0);
+         }
+         else {
+            std::ostringstream oss;
+            oss << "Invalid input dimensions:\n  R has dimension "
+               << R.rows() << "x" << R.cols() << ",\n  Z has length "
+               << Z.size() << ",\n  and A has dimension "
+               << A.rows() << "x" << A.cols();
+            GPSTK_THROW(MatrixException(oss.str()));
+         }
+      }
+
+      const unsigned int n(R.rows()), m(M==0 || M>A.rows() ? A.rows() : M);
+      const unsigned int nr(n+m);
+      unsigned int i,j;
+
+         // small problems (the usual Kalman filter) are done on the stack
+      double stackBuf[1024];
+      std::vector<double> heapBuf;
+      double *W(stackBuf);
+      if(nr*(n+1) > 1024) {
+         heapBuf.resize(nr*(n+1));
+         W = &heapBuf[0];
+      }
+
+      for(j=0; j<=n; j++) {
+         double *w = W + j*nr;
+         for(i=0; i<n; i++) w[i] = (j<n ? R(i,j) : Z(i));
+         for(i=0; i<m; i++) w[n+i] = A(i,j);
+      }
+
+      householder(nr, n+1, n, n, W, nr, true);
+
+      for(j=0; j<=n; j++) {
+         const double *w = W + j*nr;
+         if(j < n)
+            for(i=0; i<=j; i++) R(i,j) = w[i];
+         else
+            for(i=0; i<n; i++) Z(i) = w[i];
+         for(i=0; i<m; i++) A(i,j) = w[n+i];
+      }
+   }  // end SrifMU
+
+} // end namespace gpstk
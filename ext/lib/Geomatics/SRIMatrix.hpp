@@ -179,6 +179,13 @@ namespace gpstk
          }
       }
    }  // end SrifMU
+
+   /// SrifMU for double precision, done in place on contiguous storage by the
+   /// blocked Householder kernel (see householder() in MatrixKernels.hpp);
+   /// the results are the same as those of the template above.
+   template <>
+   void SrifMU(Matrix<double>& R, Vector<double>& Z, Matrix<double>& A,
+               unsigned int M) throw(MatrixException);
     
 
    //---------------------------------------------------------------------------------
@@ -54,11 +54,78 @@
 #include "TimeString.hpp"
 #include "JulianDate.hpp"
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 //------------------------------------------------------------------------------------
 using namespace std;
 using namespace gpstk::StringUtils;
 
 namespace gpstk {
+//------------------------------------------------------------------------------------
+#ifdef GPSTK_HAVE_PTHREAD
+namespace {
+   // Lock the given mutex, if any, for the lifetime of the object
+   class OptionalLock {
+   public:
+      OptionalLock(pthread_mutex_t *m) : mutex(m)
+         { if(mutex) pthread_mutex_lock(mutex); }
+      ~OptionalLock()
+         { if(mutex) pthread_mutex_unlock(mutex); }
+   private:
+      pthread_mutex_t *mutex;
+   };
+}
+#endif
+
+//------------------------------------------------------------------------------------
+struct SolarSystem::Mutex {
+#ifdef GPSTK_HAVE_PTHREAD
+   Mutex()
+      { pthread_mutex_init(&mutex, NULL); }
+   ~Mutex()
+      { pthread_mutex_destroy(&mutex); }
+   pthread_mutex_t mutex;
+#endif
+};
+
+//------------------------------------------------------------------------------------
+SolarSystem::SolarSystem(void) throw()
+   : EphemerisNumber(-1), mapBase(0), mapSize(0), maxRecords(16), useCount(0),
+     pMutex(new Mutex)
+{
+}
+
+//------------------------------------------------------------------------------------
+SolarSystem::~SolarSystem(void) throw()
+{
+   unmapFile();
+   delete pMutex;
+}
+
+//------------------------------------------------------------------------------------
+void SolarSystem::setCacheSize(int n) throw()
+{
+#ifdef GPSTK_HAVE_PTHREAD
+   OptionalLock lock(&pMutex->mutex);
+#endif
+   maxRecords = (n < 1 ? 1 : n);
+   while(int(recordCache.size()) > maxRecords) {
+      map<double, CachedRecord>::iterator it, oldest = recordCache.begin();
+      for(it = recordCache.begin(); it != recordCache.end(); ++it)
+         if(it->second.lastUse < oldest->second.lastUse) oldest = it;
+      recordCache.erase(oldest);
+   }
+}
+
 //------------------------------------------------------------------------------------
 void SolarSystem::readASCIIheader(string filename) throw(Exception)
 {
@@ -603,6 +670,9 @@ try {
       // EphemerisNumber == constants["DENUM"] means object has been initialized
       //                       (binary file), or header read (ASCII file)
       EphemerisNumber = int(constants["DENUM"]);
+
+      // read the records in place, if possible
+      mapFile(filename);
    }
 
    return iret;
@@ -634,14 +704,75 @@ try {
    // trivial; return
    if(target == center) return 0;
 
+#ifdef GPSTK_HAVE_PTHREAD
+   // the record cache is shared; the mapped file is not modified
+   OptionalLock lock(mapBase ? 0 : &pMutex->mutex);
+#endif
+
    // get the right record from the file
-   iret = seekToJD(tt);
+   const double *coeff;
+   iret = seekToJD(tt, coeff);
    if(iret) return iret;
 
+   relativeState(tt, target, center, coeff, PV, kilometers);
+
+   return 0;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(std::exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+int SolarSystem::computeStates(const vector<double>& tt,
+                               SolarSystem::Planet target,
+                               SolarSystem::Planet center,
+                               vector<double>& PV,
+                               bool kilometers) throw(Exception)
+{
+try {
+   PV.assign(6*tt.size(), 0.0);
+
+   // trivial; return
+   if(target == center) return 0;
+
+#ifdef GPSTK_HAVE_PTHREAD
+   OptionalLock lock(mapBase ? 0 : &pMutex->mutex);
+#endif
+
+   const double *coeff = 0;
+   for(size_t i=0; i<tt.size(); i++) {
+      // find a new record only when leaving the current one
+      if(!coeff || tt[i] < coeff[0] || tt[i] > coeff[1]) {
+         int iret = seekToJD(tt[i], coeff);
+         if(iret) return iret;
+      }
+      relativeState(tt[i], target, center, coeff, &PV[6*i], kilometers);
+   }
+
+   return 0;
+}
+catch(Exception& e) { GPSTK_RETHROW(e); }
+catch(std::exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
+catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
+}
+
+//------------------------------------------------------------------------------------
+// private
+void SolarSystem::relativeState(double tt,
+                                SolarSystem::Planet target,
+                                SolarSystem::Planet center,
+                                const double *coeff,
+                                double PV[6],
+                                bool kilometers) throw(Exception)
+{
+try {
+   int i;
+
    // compute Nutations or Librations
    if(target == Nutations || target == Librations) {
-      computeState(tt, target==Nutations ? NUTATIONS : LIBRATIONS, PV);
-      return 0;
+      computeState(tt, target==Nutations ? NUTATIONS : LIBRATIONS, coeff, PV);
+      return;
    }
 
    // define computeID's for target and center
@@ -664,18 +795,19 @@ try {
 
    // special cases of Earth OR Moon, but not both:
    if((target == Earth && center != Moon) || (center == Earth && target != Moon)) {
-      Eratio = 1.0/(1.0 + constants["EMRAT"]);
-      computeState(tt, MOON, PVMOON);
+      Eratio = 1.0/(1.0 + constantValue("EMRAT"));
+      computeState(tt, MOON, coeff, PVMOON);
    }
    if((target == Moon && center != Earth) || (center == Moon && target != Earth)) {
-      Mratio = constants["EMRAT"]/(1.0 + constants["EMRAT"]);
-      computeState(tt, EMBARY, PVEMBARY);
+      double EMRAT = constantValue("EMRAT");
+      Mratio = EMRAT/(1.0 + EMRAT);
+      computeState(tt, EMBARY, coeff, PVEMBARY);
    }
 
    // compute states for target and center
    double PVTARGET[6],PVCENTER[6];
-   computeState(tt, TARGET, PVTARGET);
-   computeState(tt, CENTER, PVCENTER);
+   computeState(tt, TARGET, coeff, PVTARGET);
+   computeState(tt, CENTER, coeff, PVCENTER);
 
    // handle the Earth/Moon special cases
    // convert from E-M barycenter to Earth
@@ -693,11 +825,9 @@ try {
    for(i=0; i<6; i++) PV[i] = PVTARGET[i] - PVCENTER[i];
    
    if(!kilometers) {
-      double AU = constants["AU"];
+      double AU = constantValue("AU");
       for(i=0; i<6; i++) PV[i] /= AU;
    }
-
-   return 0;
 }
 catch(Exception& e) { GPSTK_RETHROW(e); }
 catch(std::exception& e) { Exception E("std except: "+string(e.what())); GPSTK_THROW(E); }
@@ -778,6 +908,12 @@ try {
    double AU,EMRAT;
    string word;
 
+   // forget any previous file
+   unmapFile();
+   fileposMap.clear();
+   if(istrm.is_open()) istrm.close();
+   istrm.clear();
+
    // open the input binary file
    istrm.open(filename.c_str(), ios::in | ios::binary);
    if(!istrm) {
@@ -915,10 +1051,6 @@ try {
       if(save)
          store[data_vector[0]] = data_vector;
 
-      // put the first record in coefficients array
-      if(nrec == 1)
-         coefficients = data_vector;
-
       // build the positions map
       fileposMap[data_vector[0]] = filepos;
 
@@ -984,14 +1116,14 @@ catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 // -3 stream is not open or not good, or EOF was found prematurely
 // -4 EphemerisNumber is not defined
 // For -3,-4 : initializeWithBinaryFile() has not been called, or reading failed.
-int SolarSystem::seekToJD(double JD) throw(Exception)
+int SolarSystem::seekToJD(double JD, const double*& coeff) throw(Exception)
 {
 try {
-   if(!istrm) return -3;
-   if(istrm.eof() || !istrm.good()) return -3;
-   if(EphemerisNumber != int(constants["DENUM"])) return -4;
-
-   if(coefficients[0] <= JD && JD <= coefficients[1]) return 0;
+   if(!mapBase) {
+      if(!istrm) return -3;
+      if(istrm.eof() || !istrm.good()) return -3;
+   }
+   if(EphemerisNumber != int(constantValue("DENUM"))) return -4;
 
    map<double,long>::const_iterator it; // key >= input
    it = fileposMap.lower_bound(JD); // it points to first element with JD <= time
@@ -1002,12 +1134,32 @@ try {
    if(it == fileposMap.end()        // if beyond the found record, go to previous;
          || JD < it->first) it--;   // but beware the "lower_bound found the =" case
 
-   istrm.seekg(it->second,ios_base::beg);         // get the record
-   int iret = readBinaryRecord(coefficients);
-   if(iret == -2) iret = -3;        // this means EOF during data read
-   if(iret) return iret;            // reading failed
+   if(mapBase) {                    // the record is in memory already
+      coeff = reinterpret_cast<const double *>(mapBase + it->second);
+   }
+   else {
+      map<double, CachedRecord>::iterator jt = recordCache.find(it->first);
+      if(jt == recordCache.end()) {
+         // make room for the record
+         if(int(recordCache.size()) >= maxRecords) {
+            map<double, CachedRecord>::iterator kt, oldest = recordCache.begin();
+            for(kt = recordCache.begin(); kt != recordCache.end(); ++kt)
+               if(kt->second.lastUse < oldest->second.lastUse) oldest = kt;
+            recordCache.erase(oldest);
+         }
+
+         istrm.seekg(it->second,ios_base::beg);      // get the record
+         CachedRecord record;
+         int iret = readBinaryRecord(record.coefficients);
+         if(iret == -2) iret = -3;     // this means EOF during data read
+         if(iret) return iret;         // reading failed
+         jt = recordCache.insert(make_pair(it->first, record)).first;
+      }
+      jt->second.lastUse = ++useCount;
+      coeff = &jt->second.coefficients[0];
+   }
 
-   if(JD > coefficients[1])
+   if(JD > coeff[1])
       return -2;                    // failure: JD is after the last record, or
                                     // JD is in a gap between records
    return 0;
@@ -1019,7 +1171,8 @@ catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 
 //------------------------------------------------------------------------------------
 // private
-void SolarSystem::computeState(double tt, SolarSystem::computeID which, double PV[6])
+void SolarSystem::computeState(double tt, SolarSystem::computeID which,
+                               const double *coeff, double PV[6])
    throw(Exception)
 {
 try {
@@ -1030,8 +1183,8 @@ try {
    if(which == NONE) return;
 
    double T,Tbeg,Tspan,Tspan0;
-   Tbeg = coefficients[0];
-   Tspan0 = Tspan = coefficients[1] - coefficients[0];
+   Tbeg = coeff[0];
+   Tspan0 = Tspan = coeff[1] - coeff[0];
    i0 = c_offset[which]-1;                      // index of first coefficient in array
    ncomp = (which == NUTATIONS ? 2 : 3);        // number of components returned
 
@@ -1039,7 +1192,7 @@ try {
    if(c_nsets[which] > 1) {
       Tspan /= double(c_nsets[which]);
       for(j=c_nsets[which]; j>0; j--) {
-         Tbeg = coefficients[0] + double(j-1)*Tspan;
+         Tbeg = coeff[0] + double(j-1)*Tspan;
          if(tt > Tbeg) {                      // == with j==1 is the default
             i0 += (j-1)*ncomp*c_ncoeff[which];
             break;
@@ -1051,27 +1204,35 @@ try {
    T = 2.0*(tt-Tbeg)/Tspan - 1.0;
 
    // interpolate
+   // the Chebyshevs depend only on T, so generate them once for all components;
+   // the usual lengths fit on the stack
    long N=c_ncoeff[which];
-   vector<double> C(N,0.0);     // Chebyshev
-   vector<double> U(N,0.0);     // derivative of Chebyshev
-   for(i=0; i<ncomp; i++) {     // loop over components
+   double Cbuf[32],Ubuf[32];
+   vector<double> Cvec,Uvec;
+   double *C=Cbuf,*U=Ubuf;      // Chebyshev, and derivative of Chebyshev
+   if(N > 32) {
+      Cvec.resize(N); Uvec.resize(N);
+      C = &Cvec[0]; U = &Uvec[0];
+   }
 
-      // seed the Chebyshev recursions
-      C[0] = 1; C[1] = T; //C[2] = 2*T*T-1;
-      U[0] = 0; U[1] = 1; //U[2] = 4*T;
+   // seed the Chebyshev recursions
+   C[0] = 1; C[1] = T; //C[2] = 2*T*T-1;
+   U[0] = 0; U[1] = 1; //U[2] = 4*T;
 
-      // generate the Chebyshevs
-      for(j=2; j<N; j++) {
-         C[j] = 2*T*C[j-1] - C[j-2];
-         U[j] = 2*T*U[j-1] + 2*C[j-1] - U[j-2];
-      }
+   // generate the Chebyshevs
+   for(j=2; j<N; j++) {
+      C[j] = 2*T*C[j-1] - C[j-2];
+      U[j] = 2*T*U[j-1] + 2*C[j-1] - U[j-2];
+   }
+
+   for(i=0; i<ncomp; i++) {     // loop over components
 
       // compute P and V
       // done above PV[i] = PV[i+3] = 0.0;
       for(j=N-1; j>-1; j--)                              // POS
-         PV[i] += coefficients[i0+j+i*N] * C[j];
+         PV[i] += coeff[i0+j+i*N] * C[j];
       for(j=N-1; j>0; j--) // j>0 b/c U[0]=0             // VEL
-         PV[i+ncomp] += coefficients[i0+j+i*N] * U[j];
+         PV[i+ncomp] += coeff[i0+j+i*N] * U[j];
 
       // convert velocity to 'per day'
       PV[i+ncomp] *= 2*double(c_nsets[which])/Tspan0;
@@ -1082,6 +1243,65 @@ catch(std::exception& e) { Exception E("std except: "+string(e.what())); GPSTK_T
 catch(...) { Exception e("Unknown exception"); GPSTK_THROW(e); }
 }
 
+//------------------------------------------------------------------------------------
+// private
+void SolarSystem::mapFile(const string& filename) throw()
+{
+#ifndef _WIN32
+   if(fileposMap.empty()) return;
+
+   int fd = ::open(filename.c_str(), O_RDONLY);
+   if(fd < 0) return;
+
+   struct stat st;
+   if(::fstat(fd, &st) == 0 && st.st_size > 0) {
+      // every record must lie within the file, aligned for double access
+      size_t size = size_t(st.st_size);
+      bool ok = true;
+      map<double,long>::const_iterator it;
+      for(it = fileposMap.begin(); ok && it != fileposMap.end(); ++it)
+         ok = (it->second % sizeof(double) == 0 &&
+               it->second + Ncoeff*sizeof(double) <= size);
+
+      if(ok) {
+         void *addr = ::mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+         if(addr != MAP_FAILED) {
+            mapBase = static_cast<const char *>(addr);
+            mapSize = size;
+         }
+      }
+   }
+   ::close(fd);
+
+   // the stream is not needed any more
+   if(mapBase) {
+      istrm.clear();
+      istrm.close();
+   }
+#endif
+}
+
+//------------------------------------------------------------------------------------
+// private
+void SolarSystem::unmapFile(void) throw()
+{
+#ifndef _WIN32
+   if(mapBase)
+      ::munmap(const_cast<char *>(mapBase), mapSize);
+#endif
+   mapBase = 0;
+   mapSize = 0;
+   recordCache.clear();
+}
+
+//------------------------------------------------------------------------------------
+// private
+double SolarSystem::constantValue(const string& name) const throw()
+{
+   map<string,double>::const_iterator it = constants.find(name);
+   return (it == constants.end() ? 0.0 : it->second);
+}
+
 //------------------------------------------------------------------------------------
 }  // end namespace gpstk
 //------------------------------------------------------------------------------------
@@ -89,6 +89,17 @@ namespace gpstk {
 /// instantiates a SolarSystem object, calls initializeWithBinaryFile(file) once,
 /// passing it the name of the binary file, then calling computeState() any number
 /// of times, passing it the time and Planet of interest.
+///
+/// The binary file is mapped into memory where the platform allows it (POSIX mmap),
+/// and computeState() then reads the coefficients of any record in place, without
+/// copying or seeking. Otherwise the records are read from the file and the most
+/// recently used ones are kept in memory (see setCacheSize()), so that queries that
+/// go back and forth in time do not read the same records again and again. Once
+/// initializeWithBinaryFile() has returned, computeState() and computeStates() may
+/// be called from several threads at once.
+///
+/// A SolarSystem object cannot be copied or assigned, since it owns the open
+/// binary file or its mapping; threads that need the ephemeris share one object.
 class SolarSystem{
 public:
    /// These are indexes used by the caller of computeState().
@@ -114,7 +125,10 @@ public:
 
    /// Constructor. Set EphemerisNumber to -1 to indicate that nothing has been
    /// read yet.
-   SolarSystem(void) throw() : EphemerisNumber(-1) {};
+   SolarSystem(void) throw();
+
+   /// Destructor. Unmap the binary file, if it was mapped.
+   ~SolarSystem(void) throw();
 
    /// Read the header from a JPL ASCII planetary ephemeris file. Note that this
    /// routine clears the 'store' map and defines the 'constants' hash. It also
@@ -231,6 +245,33 @@ public:
                               bool kilometers = true)
    throw(gpstk::Exception);
 
+   /// Compute position and velocity of 'target' relative to 'center' at each of
+   /// the given times; the same as calling computeState() for each time, but each
+   /// record is located only once for a run of times that fall within it.
+   /// @param tt     Times (Julian Date) of interest, in any order.
+   /// @param target Body for which position and velocity are to be computed.
+   /// @param center Body relative to which the results apply (see computeState()).
+   /// @param PV     Output, resized to 6*tt.size(); PV[6*i .. 6*i+5] holds the
+   ///                  result at tt[i], as for computeState().
+   /// @param km     boolean: if true (default), units are km, km/day; else AU, AU/day
+   /// @return 0 success, or the return value of computeState() for the first time
+   ///                  that fails; the results for the following times are zero.
+   int computeStates(const std::vector<double>& tt,
+                     Planet target,
+                     Planet center,
+                     std::vector<double>& PV,
+                     bool kilometers = true)
+   throw(gpstk::Exception);
+
+   /// Set the number of data records kept in memory when the binary file cannot be
+   /// mapped into memory (default 16). Has no effect on a mapped file.
+   /// @param n number of records, at least 1.
+   void setCacheSize(int n) throw();
+
+   /// Return true if the binary file is mapped into memory.
+   bool isMapped(void) const throw()
+   { return (mapBase != 0); }
+
    /// Return the value of 1 AU (Astronomical Unit) in km. If the file header has not
    /// been read, return -1.0.
    /// @return the value of 1 AU in km;
@@ -272,6 +313,33 @@ public:
       throw(gpstk::Exception);
 
 private:
+   /// Not copyable: the object owns the mapping of the file
+   SolarSystem(const SolarSystem&);
+   SolarSystem& operator=(const SolarSystem&);
+
+   /// Map the binary file, already read by readBinaryHeader() and readBinaryData(),
+   /// into memory. Leave mapBase null if the file cannot be mapped, or if the
+   /// records are not aligned for double access.
+   /// @param filename  name of binary file.
+   void mapFile(const std::string& filename) throw();
+
+   /// Undo mapFile() and empty the record cache.
+   void unmapFile(void) throw();
+
+   /// Return the value of a constant from the header; const, so that it is safe
+   /// to call from several threads. Return zero if it is not found.
+   double constantValue(const std::string& name) const throw();
+
+   /// Compute position and velocity of target relative to center at time tt,
+   /// using the record 'coeff', which must include tt. See computeState().
+   void relativeState(double tt,
+                      Planet target,
+                      Planet center,
+                      const double *coeff,
+                      double PV[6],
+                      bool kilometers)
+      throw(gpstk::Exception);
+
    /// Helper routine for binary writing.
    /// @throw if there is any stream error.
    void writeBinary(std::ofstream& strm, const char *ptr, size_t size)
@@ -326,19 +394,23 @@ private:
    };
 
    /// Search the data records of the file opened by initializeWithBinaryFile() and
-   /// read the one whose time limits include the given time. May be called only
-   /// after initializeWithBinaryFile().
+   /// find the one whose time limits include the given time, either in the mapped
+   /// file or in the record cache, which is filled from the file as needed. May be
+   /// called only after initializeWithBinaryFile(). Unless the file is mapped, the
+   /// caller must hold the mutex, and the pointer is valid only until the next
+   /// call.
    /// @param JD the time (Julian Date) of interest
+   /// @param coeff pointer to the record (Ncoeff doubles) that includes JD (output)
    /// @return 0 success, or
    ///        -1 given time is before the first record in the file,
    ///        -2 given time is after the last record, or in a gap between records,
    ///        -3 input stream is not open or not valid, or EOF was found prematurely,
    ///        -4 ephemeris (binary file) is not initialized
    /// -3 or -4 => initializeWithBinaryFile() has not been called, or reading failed.
-   int seekToJD(double JD) throw(gpstk::Exception);
+   int seekToJD(double JD, const double*& coeff) throw(gpstk::Exception);
 
-   /// Compute position and velocity of given body at given time, using the current
-   /// coefficient array. NB caller MUST call seekToJD(time) BEFORE calling this.
+   /// Compute position and velocity of given body at given time, using the given
+   /// record. NB caller MUST get the record from seekToJD(time).
    /// On successful return, PV[0-2] contains the three position components, in km,
    /// and PV[3-5] the velocity components in km/day (for regular bodies), relative
    /// to the solar system barycenter, except for the moon, which is relative to
@@ -347,8 +419,9 @@ private:
    /// are the three euler angles.
    /// @param  tt     Time (Julian Date) of interest.
    /// @param  which  computeID of the body of interest.
+   /// @param  coeff  record (Ncoeff doubles) that includes tt.
    /// @param  PV     double(6) array containing the output position and velocity.
-   void computeState(double tt, computeID which, double PV[6])
+   void computeState(double tt, computeID which, const double *coeff, double PV[6])
       throw(gpstk::Exception);
 
    // member data ---------------------------------------------------------
@@ -413,9 +486,27 @@ private:
    /// used by seekToJD() to read records in random order.
    std::map<double, long> fileposMap;
 
-   /// One complete data record (Ncoeff doubles) consisting of times and coefficients.
-   /// seekToJD() stores the current record here, and computeState() makes use of it.
-   std::vector<double> coefficients;
+   /// Start of the memory mapping of the binary file, or null if not mapped.
+   const char *mapBase;
+   size_t mapSize;       ///< length of the mapping in bytes
+
+   /// One complete data record (Ncoeff doubles) consisting of times and
+   /// coefficients, read from the file, and when it was last used.
+   struct CachedRecord {
+      std::vector<double> coefficients;
+      unsigned long lastUse;
+   };
+
+   /// Records read from the file, by start time; used when the file is not mapped.
+   std::map<double, CachedRecord> recordCache;
+   int maxRecords;          ///< maximum size of recordCache
+   unsigned long useCount;  ///< counter used to find the least recently used record
+
+   /// Protects istrm and recordCache when the file is not mapped. It is defined
+   /// in SolarSystem.cpp, so that the class is the same with and without POSIX
+   /// threads.
+   struct Mutex;
+   Mutex *pMutex;
 
 }; // end class SolarSystem
 
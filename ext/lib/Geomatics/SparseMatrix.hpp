@@ -79,6 +79,7 @@ namespace gpstk
 {
    // forward declarations
    template <class T> class SparseMatrix;
+   template <class T> class CSRMatrix;
 
    //---------------------------------------------------------------------------
    /// Proxy class for elements of the SparseMatrix (SM).
@@ -315,6 +316,8 @@ namespace gpstk
       // lots of friends
       /// Proxy needs access to rowsMap
       friend class SMatProxy<T>;
+      /// CSRMatrix converts from and to the rowsMap
+      friend class CSRMatrix<T>;
       // min max
       friend T min<T>(const SparseMatrix<T>& SM);
       friend T max<T>(const SparseMatrix<T>& SM);
@@ -2029,103 +2032,15 @@ namespace gpstk
          GPSTK_THROW(Exception(oss.str()));
       }
    
-      const T EPS=T(1.e-20);
+      // The transformation fills in the columns of A as it goes, so it is
+      // applied to a dense copy, by the SrifMU() of SRIMatrix.hpp.
       const unsigned int m(M==0 || M>A.rows() ? A.rows() : M), n(R.rows());
-      const unsigned int np1(n+1);  // if np1 = n, state vector Z is not updated
-      unsigned int i,j,k;
-      T dum, delta, beta;
-      typename std::map< unsigned int, SparseVector<T> >::iterator jt,kt,it;
-      typename std::map< unsigned int, T >::iterator vt;
-
-      SparseMatrix<T> AT(transpose(A));         // work with the transpose
-   
-      for(j=0; j<n; j++) {          // loop over columns
-         jt = AT.rowsMap.find(j);   // is column j empty?
-         if(jt == AT.rowsMap.end()) //   no, so A is already zero below the diagonal
-            continue;
-
-         // pull out column j of A; it is entirely below the diagonal
-         SparseVector<T> Vj(jt->second);
-         T sum(dot(Vj,Vj));
-         //T sum(0);
-         //for(i=0; i<m; i++)
-         //   sum += A(i,j)*A(i,j); // sum of squares of elements in column below diag
-         if(sum < EPS) continue;    // sum is positive
-   
-         dum = R(j,j);
-         sum += dum * dum;          // add diagonal element
-         sum = (dum > T(0) ? -T(1) : T(1)) * SQRT(sum);
-         delta = dum - sum;
-         R(j,j) = sum;
-   
-         //if(j+1 > np1) break;       // this in case np1 is ever set to n ....
-   
-         beta = sum*delta;          // beta by construction must be negative
-         if(beta > -EPS) continue;
-         beta = T(1)/beta;
-
-         kt = jt;
-         for(k=j+1; k<np1; k++) {   // columns to right of diagonal (j,j)
-            SparseVector<T> Vk(m);     // will be column k of A
-
-            if(kt->first == k-1) ++kt; // kt now points to next column -- is it k?
-            if(kt->first != k) {       // no col k - should create a column in A...
-               AT.rowsMap[k] = Vk;
-               kt = AT.rowsMap.find(k);
-            }
-            else
-               Vk = kt->second;        // now Vk is column k of A, perhaps empty
-
-            sum = delta * (k==n ? Z(j) : R(j,k));
-            sum += dot(Vk,Vj);
-       //     for(i=0; i<m; i++)
-       //        sum += A(i,j) * A(i,k);
-            if(sum == T(0)) continue;
-   
-            sum *= beta;
-            if(k==n) Z(j) += sum*delta;
-            else   R(j,k) += sum*delta;
-   
-            vt = kt->second.vecMap.begin();
-            for(i=0; i<m; i++) {       // loop over rows in column k
-       //      A(i,k) += sum * A(i,j);
-               if(vt != kt->second.vecMap.end() && vt->first == i) {
-                  vt->second += sum * Vj.vecMap[i];
-                  ++vt;
-               }
-               else
-                  kt->second.vecMap[i] = sum * Vj.vecMap[i];
-            }
-         }
-      }
-
-      // must put last row of AT (last column of A) back into A - these are residuals
-      jt = AT.rowsMap.find(AT.rows()-1);
-      // should never happen
-      if(jt == AT.rowsMap.end()) GPSTK_THROW(Exception("Failure on last column"));
-
-      // put this row, jt->second, into the last column of A
-      j = A.cols()-1;
-      i = 0;
-      it = A.rowsMap.begin();
-      vt = jt->second.vecMap.begin();
-      while(it != A.rowsMap.end() && vt != jt->second.vecMap.end()) {
-         if(it->first > vt->first) {         // A has no row at index vt->first
-            SparseVector<T> SV(A.cols());
-            SV.vecMap[j] = vt->second;
-            A.rowsMap[vt->first] = SV;
-            ++vt;
-         }
-         else if(vt->first > it->first) {    // resids are missing at this row
-            ++it;
-         }
-         else {                              // match - equal indexes
-            A.rowsMap[vt->first].vecMap[j] = vt->second;
-            ++it;
-            ++vt;
-         }
-      }
+      Matrix<T> Adense(A);
+      SrifMU(R, Z, Adense, m);
 
+      // put the last column of A back - these are residuals
+      for(unsigned int i=0; i<m; i++)
+         A(i,n) = Adense(i,n);
    }  // end SrifMU
 
    //---------------------------------------------------------------------------
@@ -2147,4 +2062,8 @@ namespace gpstk
 
 }  // namespace
 
+// The sparse SrifMU() calls the dense one of SRIMatrix.hpp. SRIMatrix.hpp
+// includes this file, so it is included here, after all of the above.
+#include "SRIMatrix.hpp"
+
 #endif   // define SPARSE_MATRIX_INCLUDE
@@ -61,6 +61,7 @@ namespace gpstk
    /// forward declarations
    template <class T> class SparseVector;
    template <class T> class SparseMatrix;
+   template <class T> class CSRMatrix;
 
    //---------------------------------------------------------------------------
    /// Proxy class for elements of the SparseVector (SV). This allows disparate
@@ -207,6 +208,7 @@ namespace gpstk
       /// Proxy needs access to vecMap
       friend class SVecProxy<T>;
       friend class SparseMatrix<T>;
+      friend class CSRMatrix<T>;
 
       /// lots of friends
       // output stream operator
@@ -45,8 +45,10 @@
 #include <vector>
 #include <cmath>
 #include <ostream>
+#include <limits>
 
 #include "Exception.hpp"
+#include "FrequencyStability.hpp"
 
 namespace gpstk
 {
@@ -55,13 +57,25 @@ namespace gpstk
 
    
    /// Compute the overlapping Allan variance of the phase data provided.
+   ///
+   /// The sums are done by FrequencyStability. This changed the results of
+   /// earlier versions of this class in two ways:
+   /// - the last phase measurement is used; it used to be ignored, so that the
+   ///   deviation at each tau is now the one earlier versions gave with one
+   ///   more measurement appended to the data.
+   /// - the variance at each tau is divided by the number of terms that do not
+   ///   use a missing (zero) measurement at that tau. It used to be divided by
+   ///   a count that also took out the missing terms of all the smaller taus,
+   ///   and numGaps used to be that total; it is now the number of missing
+   ///   measurements.
+   /// With two measurements there is no deviation, as before.
    class AllanDeviation
    {
    public:
       AllanDeviation(std::vector<double>& phase, double tau0) throw(Exception)
          : N(phase.size()-1), numGaps(0)
       {
-         if(N < 1 )
+         if(N < 1)
          {
             Exception e("Need more than 2 point to compute a meaningful allan variance.");
             GPSTK_THROW(e);
@@ -71,28 +85,29 @@ namespace gpstk
          // The Overlapping Allan Deviation is calculated as follows
          //  Sigma^2(Tau) = 1 / (2*(N-2*m)*Tau^2) * Sum(X[i+2*m]-2*X[i+m]+X[i], i=1, i=N-2*m)
          //  Where Tau is the averaging time, N is the total number of points, and Tau = m*Tau0
-         //  Where Tau0 is the basic measurement interval	
-         double sum, sigma;
-         for(int m = 1; m <= (N-1)/2; m++)
+         //  Where Tau0 is the basic measurement interval
+         //  The sums of all the averaging factors are done by FrequencyStability.
+         if(N < 2)
+            return;
+
+         // The phase measurements equal to zero (other than the first and
+         // last ones) are taken as missing
+         std::vector<double> x(phase);
+         for(int i = 1; i < N; i++)
+         {
+            if(x[i] == 0)
+               x[i] = std::numeric_limits<double>::quiet_NaN();
+         }
+
+         FrequencyStability stab(x, tau0);
+         numGaps = stab.getNumGaps();
+
+         std::vector<FrequencyStability::Point> curve =
+            stab.compute(FrequencyStability::Allan, FrequencyStability::AllTau);
+         for(size_t i = 0; i < curve.size(); i++)
          {
-            double tau = m*tau0;
-            sigma = 0;
-            
-            for(int i = 0; i < (N-2*m); i++)
-            {
-               sum = 0;
-               if((phase[i+2*m]==0 ||  phase[i+m]==0 || phase[i]==0) 
-                  && i!=0 && i!=(N-2*m-1))
-                  numGaps++;
-               else
-                  sum = phase[i+2*m] - 2*phase[i+m] + phase[i];
-               sigma += sum * sum;
-            }
-		
-            sigma = sigma / (2.0*((double)N-(double)numGaps-0-2.0*(double)m)*tau*tau);
-            sigma = sqrt(sigma);
-            deviation.push_back(sigma);
-            time.push_back(tau);
+            deviation.push_back(curve[i].deviation);
+            time.push_back(curve[i].tau);
          }
       }
 
@@ -108,7 +123,7 @@ namespace gpstk
       int numGaps;
    };
 
-   std::ostream& operator<<(std::ostream& s, const AllanDeviation& a)
+   inline std::ostream& operator<<(std::ostream& s, const AllanDeviation& a)
    {
       a.dump(s);
       return s;
@@ -0,0 +1,487 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file FrequencyStability.cpp
+ * Computes the Allan, modified Allan, time, Hadamard and total deviations
+ * of a series of clock phase measurements.
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "FrequencyStability.hpp"
+#include "SpecialFuncs.hpp"
+#include "StringUtils.hpp"
+
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace gpstk
+{
+
+   namespace
+   {
+         // Averaging factors shared by the threads of compute(). Each
+         // thread takes the next one that nobody has taken yet.
+      struct TauJob
+      {
+         const FrequencyStability* pStab;
+         FrequencyStability::Statistic stat;
+         const std::vector<long>* pFactors;
+         std::vector<FrequencyStability::Point>* pPoints;
+         size_t next;
+#ifdef GPSTK_HAVE_PTHREAD
+         pthread_mutex_t mutex;
+#endif
+      };
+
+
+      void runTauJob(TauJob& job)
+      {
+         while(true)
+         {
+#ifdef GPSTK_HAVE_PTHREAD
+            pthread_mutex_lock(&job.mutex);
+#endif
+            size_t index = job.next++;
+#ifdef GPSTK_HAVE_PTHREAD
+            pthread_mutex_unlock(&job.mutex);
+#endif
+            if(index >= job.pFactors->size()) break;
+
+               // The factors have been checked, nothing may throw here
+            (*job.pPoints)[index] =
+               job.pStab->compute(job.stat, (*job.pFactors)[index]);
+         }
+      }
+
+   }  // End of anonymous namespace
+
+}  // End of namespace 'gpstk'
+
+
+#ifdef GPSTK_HAVE_PTHREAD
+   // C-style function to be called with pthreads
+extern "C"
+{
+   static void* frequencyStabilityThread(void* pJob)
+   {
+      gpstk::runTauJob( *static_cast<gpstk::TauJob*>(pJob) );
+      return NULL;
+   }
+}
+#endif
+
+
+namespace gpstk
+{
+
+      // Common constructor
+   FrequencyStability::FrequencyStability( const std::vector<double>& phase,
+                                           double t0 )
+      throw(InvalidParameter)
+      : N(phase.size()), tau0(t0), numGaps(0), confidence(0.683),
+        numThreads(0)
+   {
+      if(N < 3)
+      {
+         InvalidParameter e("Need at least 3 measurements, got "
+                            + StringUtils::asString(N));
+         GPSTK_THROW(e);
+      }
+
+      if(!(tau0 > 0.0))
+      {
+         InvalidParameter e("The time between measurements must be positive");
+         GPSTK_THROW(e);
+      }
+
+         // First and last measurements, which give the linear trend
+      long first(0), last(N-1);
+      while( (first < N) && (phase[first] != phase[first]) ) first++;
+      while( (last > first) && (phase[last] != phase[last]) ) last--;
+      if(last <= first)
+      {
+         InvalidParameter e("Need at least 2 measurements that are not NaN");
+         GPSTK_THROW(e);
+      }
+      double slope( (phase[last] - phase[first]) / (last - first) );
+
+      x.resize(N);
+      sum.resize(N+1);
+      sum[0] = 0.0;
+      for(long i = 0; i < N; i++)
+      {
+         x[i] = phase[i] - phase[first] - slope*(i - first);
+         if(x[i] == x[i])
+         {
+            sum[i+1] = sum[i] + x[i];
+         }
+         else
+         {
+            sum[i+1] = sum[i];
+            numGaps++;
+         }
+      }
+
+      if(numGaps > 0)
+      {
+         gaps.resize(N+1);
+         gaps[0] = 0;
+         for(long i = 0; i < N; i++)
+         {
+            gaps[i+1] = gaps[i] + (x[i] != x[i]);
+         }
+      }
+
+   }  // End of constructor 'FrequencyStability::FrequencyStability()'
+
+
+      // Returns the largest averaging factor of 'stat'
+   long FrequencyStability::maxAveragingFactor(Statistic stat) const
+   {
+      switch(stat)
+      {
+         case Allan:
+         case NonOverlappingAllan:
+            return (N-1)/2;
+         case ModifiedAllan:
+         case Time:
+            return N/3;
+         case Hadamard:
+            return (N-1)/3;
+         case Total:
+            return N-1;
+      }
+      return 0;
+
+   }  // End of method 'FrequencyStability::maxAveragingFactor()'
+
+
+      // Returns the averaging factors of 'stat' with the given spacing
+   std::vector<long> FrequencyStability::averagingFactors( Statistic stat,
+                                                 TauSpacing spacing ) const
+   {
+      std::vector<long> factors;
+      long maxm( maxAveragingFactor(stat) );
+
+      if(spacing == AllTau)
+      {
+         for(long m = 1; m <= maxm; m++)
+         {
+            factors.push_back(m);
+         }
+      }
+      else if(spacing == OctaveTau)
+      {
+         for(long m = 1; m <= maxm; m *= 2)
+         {
+            factors.push_back(m);
+         }
+      }
+      else
+      {
+         static const long steps[3] = { 1, 2, 5 };
+         for(long decade = 1; decade <= maxm; decade *= 10)
+         {
+            for(int i = 0; i < 3 && steps[i]*decade <= maxm; i++)
+            {
+               factors.push_back(steps[i]*decade);
+            }
+         }
+      }
+
+      return factors;
+
+   }  // End of method 'FrequencyStability::averagingFactors()'
+
+
+      // Computes 'stat' at the averaging factor 'm'
+   FrequencyStability::Point FrequencyStability::compute( Statistic stat,
+                                                          long m ) const
+      throw(InvalidRequest)
+   {
+      if( (m < 1) || (m > maxAveragingFactor(stat)) )
+      {
+         InvalidRequest e("Averaging factor " + StringUtils::asString(m)
+                          + " out of range");
+         GPSTK_THROW(e);
+      }
+
+      double total(0.0);
+      long count(0);
+      sumSquares(stat, m, total, count);
+
+      Point p;
+      p.m = m;
+      p.tau = m*tau0;
+      p.numTerms = count;
+
+      if(count == 0)
+      {
+         p.deviation = p.lower = p.upper =
+            std::numeric_limits<double>::quiet_NaN();
+         p.edf = 0.0;
+         return p;
+      }
+
+      double mt( m*tau0 ), var(0.0);
+      switch(stat)
+      {
+         case Allan:
+         case NonOverlappingAllan:
+         case Total:
+            var = total / (2.0*mt*mt*count);
+            break;
+         case ModifiedAllan:
+            var = total / (2.0*mt*mt*m*m*count);
+            break;
+         case Time:
+            var = total / (6.0*m*m*count);
+            break;
+         case Hadamard:
+            var = total / (6.0*mt*mt*count);
+            break;
+      }
+      p.deviation = std::sqrt(var);
+
+         // Only the non-overlapping terms are counted as independent
+      p.edf = (stat == NonOverlappingAllan) ? count : double(count)/m;
+      if(p.edf < 1.0) p.edf = 1.0;
+      confidenceInterval(p.deviation, p.edf, confidence, p.lower, p.upper);
+
+      return p;
+
+   }  // End of method 'FrequencyStability::compute()'
+
+
+      // Computes 'stat' at the given averaging factors, in parallel
+   std::vector<FrequencyStability::Point> FrequencyStability::compute(
+                                         Statistic stat,
+                                         const std::vector<long>& factors ) const
+      throw(InvalidRequest)
+   {
+      long maxm( maxAveragingFactor(stat) );
+      for(size_t i = 0; i < factors.size(); i++)
+      {
+         if( (factors[i] < 1) || (factors[i] > maxm) )
+         {
+            InvalidRequest e("Averaging factor "
+                             + StringUtils::asString(factors[i])
+                             + " out of range");
+            GPSTK_THROW(e);
+         }
+      }
+
+      std::vector<Point> points(factors.size());
+
+      TauJob job;
+      job.pStab = this;
+      job.stat = stat;
+      job.pFactors = &factors;
+      job.pPoints = &points;
+      job.next = 0;
+
+#ifdef GPSTK_HAVE_PTHREAD
+      int nThreads = numThreads;
+      if(nThreads == 0)
+      {
+         long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+         nThreads = (ncpu > 0) ? static_cast<int>(ncpu) : 1;
+      }
+      if(static_cast<size_t>(nThreads) > factors.size())
+      {
+         nThreads = static_cast<int>(factors.size());
+      }
+
+      pthread_mutex_init(&job.mutex, NULL);
+
+         // The calling thread does its share of the work too
+      std::vector<pthread_t> threads(nThreads > 1 ? nThreads - 1 : 0);
+      size_t started(0);
+      for(size_t i = 0; i < threads.size(); i++)
+      {
+         if( pthread_create(&threads[i], NULL,
+                            frequencyStabilityThread, &job) != 0 )
+         {
+            break;
+         }
+         ++started;
+      }
+#endif
+
+      runTauJob(job);
+
+#ifdef GPSTK_HAVE_PTHREAD
+      for(size_t i = 0; i < started; i++)
+      {
+         pthread_join(threads[i], NULL);
+      }
+
+      pthread_mutex_destroy(&job.mutex);
+#endif
+
+      return points;
+
+   }  // End of method 'FrequencyStability::compute()'
+
+
+      // Sets the probability of the confidence intervals
+   FrequencyStability& FrequencyStability::setConfidence(double prob)
+      throw(InvalidParameter)
+   {
+      if( !(prob > 0.0 && prob < 1.0) )
+      {
+         InvalidParameter e("The confidence must be between 0 and 1");
+         GPSTK_THROW(e);
+      }
+      confidence = prob;
+      return (*this);
+
+   }  // End of method 'FrequencyStability::setConfidence()'
+
+
+      // Computes the confidence interval of a deviation
+   void FrequencyStability::confidenceInterval( double dev, double edf,
+                                                double prob,
+                                                double& lower, double& upper )
+   {
+      double alpha( 0.5*(1.0 - prob) ), chiLow, chiHigh;
+
+      if(edf <= 1000.0)
+      {
+         int n( static_cast<int>(edf + 0.5) );
+         if(n < 1) n = 1;
+         edf = n;
+         chiLow = invChisqCDF(alpha, n);
+         chiHigh = invChisqCDF(1.0 - alpha, n);
+      }
+      else
+      {
+            // Wilson-Hilferty, good to better than 1e-4 here
+         double h( 2.0/(9.0*edf) ), z( invNormalCDF(1.0 - alpha, 0.0, 1.0) );
+         chiLow = edf*std::pow(1.0 - h - z*std::sqrt(h), 3);
+         chiHigh = edf*std::pow(1.0 - h + z*std::sqrt(h), 3);
+      }
+
+      lower = dev*std::sqrt(edf/chiHigh);
+      upper = dev*std::sqrt(edf/chiLow);
+
+   }  // End of method 'FrequencyStability::confidenceInterval()'
+
+
+      // Phase extended at both ends by reflection
+   double FrequencyStability::extended(long k) const
+   {
+      long i( k - (N-2) );
+      if(i < 0) return (2.0*x[0] - x[-i]);
+      if(i > N-1) return (2.0*x[N-1] - x[2*(N-1) - i]);
+      return x[i];
+
+   }  // End of method 'FrequencyStability::extended()'
+
+
+      // Sum of the squared terms and number of terms of 'stat' at 'm'
+   void FrequencyStability::sumSquares( Statistic stat, long m,
+                                        double& total, long& count ) const
+   {
+      double t;
+      total = 0.0;
+      count = 0;
+
+      switch(stat)
+      {
+         case Allan:
+         case NonOverlappingAllan:
+         {
+            long step( (stat == Allan) ? 1 : m );
+            for(long i = 0; i < N-2*m; i += step)
+            {
+               t = x[i+2*m] - 2.0*x[i+m] + x[i];
+               if(t == t)
+               {
+                  total += t*t;
+                  count++;
+               }
+            }
+            break;
+         }
+
+         case ModifiedAllan:
+         case Time:
+               // The m second differences starting at j add up to a
+               // third difference of the running sums
+            for(long j = 0; j <= N-3*m; j++)
+            {
+               if(hasGap(j, j+3*m)) continue;
+               t = static_cast<double>( (sum[j+3*m] - sum[j])
+                                        - 3.0L*(sum[j+2*m] - sum[j+m]) );
+               total += t*t;
+               count++;
+            }
+            break;
+
+         case Hadamard:
+            for(long i = 0; i < N-3*m; i++)
+            {
+               t = x[i+3*m] - 3.0*x[i+2*m] + 3.0*x[i+m] - x[i];
+               if(t == t)
+               {
+                  total += t*t;
+                  count++;
+               }
+            }
+            break;
+
+         case Total:
+            for(long k = N-1; k < 2*N-3; k++)
+            {
+               t = extended(k-m) - 2.0*extended(k) + extended(k+m);
+               if(t == t)
+               {
+                  total += t*t;
+                  count++;
+               }
+            }
+            break;
+      }
+
+   }  // End of method 'FrequencyStability::sumSquares()'
+
+}  // End of namespace gpstk
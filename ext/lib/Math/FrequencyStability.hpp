@@ -0,0 +1,297 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file FrequencyStability.hpp
+ * Computes the Allan, modified Allan, time, Hadamard and total deviations
+ * of a series of clock phase measurements.
+ */
+
+#ifndef GPSTK_FREQUENCYSTABILITY_HPP
+#define GPSTK_FREQUENCYSTABILITY_HPP
+
+#include <vector>
+
+#include "Exception.hpp"
+
+namespace gpstk
+{
+      /// @ingroup math
+      //@{
+
+      /** This class computes the frequency stability statistics of a
+       *  series of clock phase (time error) measurements, taken every
+       *  'tau0' seconds, at the averaging times tau = m*tau0 chosen by the
+       *  caller.
+       *
+       * The phase is stored once, without its linear trend (which none of
+       * the statistics see), together with its running sums. Each
+       * averaging factor then takes a single pass over the data, whatever
+       * the statistic: the inner sums of the modified Allan and time
+       * deviations come from differences of the running sums. With the
+       * averaging factors spaced by octaves or decades, the whole curve
+       * takes O(N log N) operations. The averaging factors are shared out
+       * between several threads.
+       *
+       * Missing measurements are given as NaN. The terms that use one of
+       * them are left out, and the statistic is normalized by the number
+       * of terms actually used.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   FrequencyStability stab(phase, 1.0);
+       *
+       *   std::vector<FrequencyStability::Point> adev =
+       *      stab.compute(FrequencyStability::Allan,
+       *                   FrequencyStability::OctaveTau);
+       *
+       *   for(size_t i = 0; i < adev.size(); i++)
+       *   {
+       *      cout << adev[i].tau << " " << adev[i].deviation << " "
+       *           << adev[i].lower << " " << adev[i].upper << endl;
+       *   }
+       * @endcode
+       *
+       * The confidence interval of each point comes from the chi-square
+       * distribution, with a number of degrees of freedom taken as the
+       * number of terms divided by the averaging factor (the number of
+       * terms that do not overlap). This does not depend on the noise
+       * type and is on the safe side for the common ones; see
+       * confidenceInterval() to use another value.
+       */
+   class FrequencyStability
+   {
+   public:
+
+         /// Statistics that may be computed.
+      enum Statistic
+      {
+         Allan,               ///< Overlapping Allan deviation (ADEV)
+         NonOverlappingAllan, ///< Allan deviation, non-overlapping terms
+         ModifiedAllan,       ///< Modified Allan deviation (MDEV)
+         Time,                ///< Time deviation (TDEV)
+         Hadamard,            ///< Overlapping Hadamard deviation (HDEV)
+         Total                ///< Total Allan deviation (TOTDEV)
+      };
+
+
+         /// Choice of averaging factors.
+      enum TauSpacing
+      {
+         AllTau,              ///< Every averaging factor
+         OctaveTau,           ///< 1, 2, 4, 8, ...
+         DecadeTau            ///< 1, 2, 5, 10, 20, 50, ...
+      };
+
+
+         /// One point of a stability curve.
+      struct Point
+      {
+         long m;              ///< Averaging factor
+         double tau;          ///< Averaging time, m*tau0
+         double deviation;    ///< Value of the statistic
+         double lower;        ///< Lower end of the confidence interval
+         double upper;        ///< Upper end of the confidence interval
+         double edf;          ///< Equivalent degrees of freedom
+         long numTerms;       ///< Number of terms in the sum
+      };
+
+
+         /** Common constructor.
+          *
+          * @param phase    Clock phase measurements, in seconds. Missing
+          *                 ones are NaN.
+          * @param tau0     Time between measurements, in seconds.
+          */
+      FrequencyStability(const std::vector<double>& phase, double tau0)
+         throw(InvalidParameter);
+
+
+         /// Returns the number of measurements.
+      long size(void) const
+      { return N; };
+
+
+         /// Returns the number of missing measurements.
+      long getNumGaps(void) const
+      { return numGaps; };
+
+
+         /// Returns the time between measurements.
+      double getTau0(void) const
+      { return tau0; };
+
+
+         /// Returns the largest averaging factor of 'stat'.
+      long maxAveragingFactor(Statistic stat) const;
+
+
+         /// Returns the averaging factors of 'stat' with the given spacing.
+      std::vector<long> averagingFactors(Statistic stat,
+                                         TauSpacing spacing) const;
+
+
+         /** Computes 'stat' at the averaging factor 'm'.
+          *
+          * @param stat     Statistic to compute.
+          * @param m        Averaging factor, from 1 to
+          *                 maxAveragingFactor(stat).
+          */
+      Point compute(Statistic stat, long m) const
+         throw(InvalidRequest);
+
+
+         /** Computes 'stat' at the given averaging factors, in parallel.
+          *
+          * @param stat     Statistic to compute.
+          * @param factors  Averaging factors.
+          */
+      std::vector<Point> compute(Statistic stat,
+                                 const std::vector<long>& factors) const
+         throw(InvalidRequest);
+
+
+         /** Computes 'stat' at the averaging factors with the given
+          *  spacing, in parallel.
+          *
+          * @param stat     Statistic to compute.
+          * @param spacing  Choice of averaging factors.
+          */
+      std::vector<Point> compute(Statistic stat,
+                                 TauSpacing spacing = OctaveTau) const
+         throw(InvalidRequest)
+      { return compute(stat, averagingFactors(stat, spacing)); };
+
+
+         /// Returns the probability of the confidence intervals.
+      double getConfidence(void) const
+      { return confidence; };
+
+
+         /** Sets the probability of the confidence intervals, by default
+          *  0.683 (one sigma).
+          *
+          * @param prob     Probability, between 0 and 1.
+          */
+      FrequencyStability& setConfidence(double prob)
+         throw(InvalidParameter);
+
+
+         /// Returns the number of threads used by compute().
+      int getNumThreads(void) const
+      { return numThreads; };
+
+
+         /** Sets the number of threads used by compute(). Zero (the
+          *  default) means one per processor.
+          *
+          * @param n        Number of threads.
+          */
+      FrequencyStability& setNumThreads(int n)
+      { numThreads = (n < 0 ? 0 : n); return (*this); };
+
+
+         /** Computes the confidence interval of a deviation.
+          *
+          * @param dev      Deviation.
+          * @param edf      Equivalent degrees of freedom.
+          * @param prob     Probability of the interval.
+          * @param lower    Lower end of the interval.
+          * @param upper    Upper end of the interval.
+          */
+      static void confidenceInterval(double dev, double edf, double prob,
+                                     double& lower, double& upper);
+
+
+   private:
+
+         /// Number of measurements.
+      long N;
+
+
+         /// Time between measurements.
+      double tau0;
+
+
+         /// Phase without its linear trend (missing ones are NaN).
+      std::vector<double> x;
+
+
+         /// Running sums of 'x', sum[k] = x[0] + ... + x[k-1], with the
+         /// missing measurements taken as zero.
+      std::vector<long double> sum;
+
+
+         /// Number of missing measurements before each one, or empty if
+         /// there are none.
+      std::vector<long> gaps;
+
+
+         /// Number of missing measurements.
+      long numGaps;
+
+
+         /// Probability of the confidence intervals.
+      double confidence;
+
+
+         /// Number of threads, zero meaning one per processor.
+      int numThreads;
+
+
+         /// Returns true if there are missing measurements in [b, e).
+      bool hasGap(long b, long e) const
+      { return (numGaps > 0) && (gaps[e] != gaps[b]); };
+
+
+         /// Phase extended at both ends by reflection, for the total
+         /// deviation: index k is the measurement k-(N-2).
+      double extended(long k) const;
+
+
+         /// Sum of the squared terms and number of terms of 'stat' at 'm'.
+      void sumSquares(Statistic stat, long m,
+                      double& total, long& count) const;
+
+
+   }; // End of class 'FrequencyStability'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_FREQUENCYSTABILITY_HPP
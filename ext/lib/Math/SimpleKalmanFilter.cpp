@@ -190,6 +190,51 @@ namespace gpstk
 
 
 
+      // Compute the a posteriori estimate of the system state, as well as
+      // the a posteriori estimate error covariance matrix. This version
+      // takes the matrix of measurements weights.
+      //
+      // @param phiMatrix         State transition matrix.
+      // @param processNoiseCovariance    Process noise covariance matrix.
+      // @param measurements      Measurements vector.
+      // @param measurementsMatrix    Measurements matrix. Called geometry
+      //                              matrix in GNSS.
+      // @param measurementsWeights   Matrix of measurements weights.
+      //
+      // @return
+      //  0 if OK
+      //  -1 if problems arose
+      //
+   int SimpleKalmanFilter::ComputeWeighted( const Matrix<double>& phiMatrix,
+                                 const Matrix<double>& processNoiseCovariance,
+                                    const Vector<double>& measurements,
+                                    const Matrix<double>& measurementsMatrix,
+                                    const Matrix<double>& measurementsWeights )
+      throw(InvalidSolver)
+   {
+
+      try
+      {
+         Predict( phiMatrix,
+                  xhat,
+                  processNoiseCovariance );
+
+         CorrectWeighted( measurements,
+                          measurementsMatrix,
+                          measurementsWeights );
+      }
+      catch(InvalidSolver e)
+      {
+         GPSTK_THROW(e);
+         return -1;
+      }
+
+      return 0;
+
+   }  // End of method 'SimpleKalmanFilter::ComputeWeighted()'
+
+
+
       // Compute the a posteriori estimate of the system state, as well as
       // the a posteriori estimate error variance. Version for
       // one-dimensional systems.
@@ -556,13 +601,12 @@ matrix and a priori state estimation vector do not match.");
 
          // After checking sizes, let's do the real correction work
       Matrix<double> invR;
-      Matrix<double> invPMinus;
-      Matrix<double> measMatrixT( transpose(measurementsMatrix) );
 
       try
       {
 
-         invR = inverseChol(measurementsNoiseCovariance);
+         infoDecomp(measurementsNoiseCovariance);
+         infoDecomp.inverse(invR);
 
       }
       catch(...)
@@ -572,57 +616,177 @@ matrix and a priori state estimation vector do not match.");
          return -1;
       }
 
-      try
-      {
+      return CorrectWeighted(measurements, measurementsMatrix, invR);
+
+   }  // End of method 'SimpleKalmanFilter::Correct()'
+
+
+
+      // Corrects (or "measurement updates") the a posteriori estimate of
+      // the system state vector, as well as the a posteriori estimate error
+      // covariance matrix, using the information form of the filter and the
+      // matrix of measurements weights.
+      //
+      // @param measurements      Measurements vector.
+      // @param measurementsMatrix    Measurements matrix. Called geometry
+      //                              matrix in GNSS.
+      // @param measurementsWeights   Matrix of measurements weights.
+      //
+      // @return
+      //  0 if OK
+      //  -1 if problems arose
+      //
+   int SimpleKalmanFilter::CorrectWeighted( const Vector<double>& measurements,
+                                    const Matrix<double>& measurementsMatrix,
+                                    const Matrix<double>& measurementsWeights )
+      throw(InvalidSolver)
+   {
+         // Let's check sizes before start
+      size_t measRow(measurements.size());
+      size_t stateRow(xhatminus.size());
 
-         invPMinus = inverseChol(Pminus);
+      size_t mMRow(measurementsMatrix.rows());
+      size_t mMCol(measurementsMatrix.cols());
 
+      if ( ( measurementsWeights.cols() != measurementsWeights.rows() ) ||
+           ( Pminus.cols() != Pminus.rows() )      )
+      {
+         InvalidSolver e("Correct(): Either Pminus or measurements weights \
+matrices are not square.");
+         GPSTK_THROW(e);
       }
-      catch(...)
+
+      if ( ( mMRow != measRow ) ||
+           ( measurementsWeights.rows() != measRow ) )
       {
-         InvalidSolver e("Correct(): Unable to compute invPMinus matrix.");
+         InvalidSolver e("Correct(): Sizes of measurements matrix, \
+measurements weights matrix and measurements vector do not match.");
          GPSTK_THROW(e);
-         return -1;
       }
 
-      try
+      if ( ( Pminus.cols() != stateRow ) ||
+           ( mMCol != stateRow ) )
       {
+         InvalidSolver e("Correct(): Sizes of a priori error covariance \
+matrix, measurements matrix and a priori state estimation vector do not \
+match.");
+         GPSTK_THROW(e);
+      }
+
+      size_t i, j, k;
+      double sum;
 
-         Matrix<double> invTemp( measMatrixT*invR*measurementsMatrix +
-                                 invPMinus );
+      try
+      {
 
-            // Compute the a posteriori error covariance matrix
-         P = inverseChol( invTemp );
+            // The a priori information matrix, inverse(Pminus), goes to P
+         infoDecomp(Pminus);
+         infoDecomp.inverse(P);
 
       }
       catch(...)
       {
-         InvalidSolver e("Correct(): Unable to compute P matrix.");
+         InvalidSolver e("Correct(): Unable to compute invPMinus matrix.");
          GPSTK_THROW(e);
          return -1;
       }
 
+         // ... and the a priori information vector, inverse(Pminus)*xhatminus,
+         // goes to xhat
+      xhat = xhatminus;
+      infoDecomp.backSub(xhat);
+
+         // Product of weights and measurements matrices, W*H. Weights
+         // matrices are very often diagonal, so let's check that first
+      bool diagonal(true);
+      for (k = 0; k < measRow && diagonal; k++)
+      {
+         for (i = 0; i < measRow; i++)
+         {
+            if ( i != k && measurementsWeights(i,k) != 0.0 )
+            {
+               diagonal = false;
+               break;
+            }
+         }
+      }
+
+      weightedMatrix.resize(measRow, stateRow);
+      for (j = 0; j < stateRow; j++)
+      {
+         if (diagonal)
+         {
+            for (i = 0; i < measRow; i++)
+            {
+               weightedMatrix(i,j) = measurementsWeights(i,i)
+                                     * measurementsMatrix(i,j);
+            }
+            continue;
+         }
+
+         for (i = 0; i < measRow; i++)
+         {
+            weightedMatrix(i,j) = 0.0;
+         }
+
+         for (k = 0; k < measRow; k++)
+         {
+            double h( measurementsMatrix(k,j) );
+            if (h == 0.0) continue;
+            for (i = 0; i < measRow; i++)
+            {
+               weightedMatrix(i,j) += measurementsWeights(i,k) * h;
+            }
+         }
+      }
+
+         // Add HT*W*H to the lower triangle of the information matrix,
+         // and HT*W*z to the information vector
+      for (j = 0; j < stateRow; j++)
+      {
+         sum = 0.0;
+         for (k = 0; k < measRow; k++)
+         {
+            sum += weightedMatrix(k,j) * measurements(k);
+         }
+         xhat(j) += sum;
+
+         for (i = j; i < stateRow; i++)
+         {
+            sum = 0.0;
+            for (k = 0; k < measRow; k++)
+            {
+               sum += measurementsMatrix(k,i) * weightedMatrix(k,j);
+            }
+            P(i,j) += sum;
+         }
+      }
+
       try
       {
 
-            // Compute the a posteriori state estimation
-         xhat = P * ( (measMatrixT * invR * measurements) + 
-                      (invPMinus * xhatminus) );
+         infoDecomp(P);
 
       }
-      catch(Exception e)
+      catch(...)
       {
-         InvalidSolver eis("Correct(): Unable to compute xhat.");
-         GPSTK_THROW(eis);
+         InvalidSolver e("Correct(): Unable to compute P matrix.");
+         GPSTK_THROW(e);
          return -1;
       }
 
+         // Compute the a posteriori state estimation...
+      infoDecomp.backSub(xhat);
+
+         // ... and the a posteriori error covariance matrix
+      infoDecomp.inverse(P);
+
       xhatminus = xhat;
       Pminus = P;
 
       return 0;
 
-   }  // End of method 'SimpleKalmanFilter::Correct()'
+   }  // End of method 'SimpleKalmanFilter::CorrectWeighted()'
 
 
 
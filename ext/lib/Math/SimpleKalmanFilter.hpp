@@ -237,6 +237,31 @@ namespace gpstk
          throw(InvalidSolver);
 
 
+         /** Compute the a posteriori estimate of the system state, as well
+          *  as the a posteriori estimate error covariance matrix. This
+          *  version takes the matrix of measurements weights (the inverse
+          *  of the measurements noise covariance matrix), as used by the
+          *  GNSS solvers, so that it doesn't need to be inverted twice.
+          *
+          * @param phiMatrix         State transition matrix.
+          * @param processNoiseCovariance    Process noise covariance matrix.
+          * @param measurements      Measurements vector.
+          * @param measurementsMatrix    Measurements matrix. Called geometry
+          *                              matrix in GNSS.
+          * @param measurementsWeights   Matrix of measurements weights.
+          *
+          * @return
+          *  0 if OK
+          *  -1 if problems arose
+          */
+      virtual int ComputeWeighted( const Matrix<double>& phiMatrix,
+                                 const Matrix<double>& processNoiseCovariance,
+                                   const Vector<double>& measurements,
+                                   const Matrix<double>& measurementsMatrix,
+                                   const Matrix<double>& measurementsWeights )
+         throw(InvalidSolver);
+
+
          /** Compute the a posteriori estimate of the system state, as well
           *  as the a posteriori estimate error variance. Version for
           *  one-dimensional systems.
@@ -518,6 +543,38 @@ namespace gpstk
          throw(InvalidSolver);
 
 
+         /** Corrects (or "measurement updates") the a posteriori estimate
+          *  of the system state vector, as well as the a posteriori estimate
+          *  error covariance matrix, using the information form of the
+          *  filter and the matrix of measurements weights. The a posteriori
+          *  state is found by Cholesky decomposition and back substitution
+          *  of the information matrix, which is then inverted only once to
+          *  get the a posteriori error covariance.
+          *
+          * @param measurements      Measurements vector.
+          * @param measurementsMatrix    Measurements matrix. Called geometry
+          *                              matrix in GNSS.
+          * @param measurementsWeights   Matrix of measurements weights.
+          *
+          * @return
+          *  0 if OK
+          *  -1 if problems arose
+          */
+      virtual int CorrectWeighted( const Vector<double>& measurements,
+                                   const Matrix<double>& measurementsMatrix,
+                                   const Matrix<double>& measurementsWeights )
+         throw(InvalidSolver);
+
+
+         /// Cholesky decomposition used by the corrections; kept here to
+         /// reuse its storage from one epoch to the next.
+      LLTDecomp<double> infoDecomp;
+
+
+         /// Storage for the product of weights and measurements matrices.
+      Matrix<double> weightedMatrix;
+
+
    }; // End of class 'SimpleKalmanFilter'
 
       //@}
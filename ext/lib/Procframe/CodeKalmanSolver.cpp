@@ -263,31 +263,16 @@ of qMatrix");
          GPSTK_THROW(e);
       }
 
-         // After checking sizes, let's invert the matrix of weights in order
-         // to get the measurements noise covariance matrix, which is what we
-         // use in the "SimpleKalmanFilter" class
-      Matrix<double> measNoiseMatrix;
-
-      try
-      {
-         measNoiseMatrix = inverseChol(weightMatrix);
-      }
-      catch(...)
-      {
-         InvalidSolver e("Correct(): Unable to compute measurements noise \
-covariance matrix.");
-
-         GPSTK_THROW(e);
-      }
-
       try
       {
-            // Call the Kalman filter object.
-         kFilter.Compute( phiMatrix,
-                          qMatrix,
-                          prefitResiduals,
-                          designMatrix,
-                          measNoiseMatrix );
+            // Call the Kalman filter object. The matrix of weights is
+            // passed as is, so it doesn't need to be inverted to get the
+            // measurements noise covariance matrix.
+         kFilter.ComputeWeighted( phiMatrix,
+                                  qMatrix,
+                                  prefitResiduals,
+                                  designMatrix,
+                                  weightMatrix );
       }
       catch(InvalidSolver& e)
       {
@@ -77,13 +77,16 @@ namespace gpstk
          Position rxPos(nominalPos[0],nominalPos[1],nominalPos[2],
             Position::Cartesian);
 
+            // Satellites with elevation and azimuth, whose ionospheric
+            // delays are computed all at once
+         std::vector<satTypeValueMap::iterator> sats;
+         std::vector<double> elevation, azimuth;
+
             // Loop through all the satellites
          satTypeValueMap::iterator stv;
          for(stv = gData.begin(); stv != gData.end(); ++stv) 
          {
 
-            Position svPos(0.0, 0.0, 0.0, Position::Cartesian);
-            
                // If elevation or azimuth is missing, then remove satellite
             if( stv->second.find(TypeID::elevation) == stv->second.end() ||
                stv->second.find(TypeID::azimuth)   == stv->second.end() )
@@ -94,47 +97,69 @@ namespace gpstk
                continue;
 
             }
-            
-            const double elevation = (*stv).second[TypeID::elevation];
-            const double azimuth = (*stv).second[TypeID::azimuth]; 
 
-            double ionL1 = 0.0;
-            
-            if(ionoType == Ionex)
-            {
-               try
-               {
-                  //const string mapType = "SLM";
-                  //const double ionoHeight = 450000.0;
+            sats.push_back(stv);
+            elevation.push_back((*stv).second[TypeID::elevation]);
+            azimuth.push_back((*stv).second[TypeID::azimuth]);
 
-                  const string mapType = "MSLM";
-                  const double ionoHeight = 506700.0;
+         }  // End of loop 'for(stv = gData.begin()...'
 
-                  Position IPP = rxPos.getIonosphericPiercePoint(elevation,
-                     azimuth,
-                     ionoHeight);
+         std::vector<double> ionL1(sats.size(), 0.0);
+         std::vector<bool> found(sats.size(), true);
 
-                  Position pos(IPP);
-                  pos.transformTo(Position::Geocentric);
+         if(ionoType == Ionex && !sats.empty())
+         {
+            //const string mapType = "SLM";
+            //const double ionoHeight = 450000.0;
 
-                  Triple val = gridStore.getIonexValue( time, pos );
+            const string mapType = "MSLM";
+            const double ionoHeight = 506700.0;
 
-                  double tecval = val[0];
+            std::vector<Position> IPP(sats.size());
+            for(size_t i = 0; i < sats.size(); i++)
+            {
+               IPP[i] = rxPos.getIonosphericPiercePoint(elevation[i],
+                                                        azimuth[i],
+                                                        ionoHeight);
+               IPP[i].transformTo(Position::Geocentric);
+            }
 
-                  (void)gridStore.iono_mapping_function(elevation, mapType);
-                  ionL1 = gridStore.getIonoL1(elevation, tecval, mapType);
-               }
-               catch(InvalidRequest& e)
+            std::vector<Triple> val;
+            try
+            {
+               gridStore.getIonexValues(time, IPP, val, found);
+            }
+            catch(InvalidRequest& e)
+            {
+               found.assign(sats.size(), false);
+            }
+
+            for(size_t i = 0; i < sats.size(); i++)
+            {
+               if(found[i])
                {
-                  satRejectedSet.insert(stv->first);
-                  continue;
+                  ionL1[i] = gridStore.getIonoL1(elevation[i], val[i][0],
+                                                 mapType);
                }
             }
-            else if(ionoType == Klobuchar)
+         }
+         else if(ionoType == Klobuchar && !sats.empty())
+         {
+            klbStore.getCorrections(time, rxPos, elevation, azimuth, ionL1);
+         }
+
+         for(size_t i = 0; i < sats.size(); i++)
+         {
+
+            stv = sats[i];
+
+            if(!found[i])
             {
-               ionL1 = klbStore.getCorrection(time,rxPos,elevation,azimuth);
+               satRejectedSet.insert(stv->first);
+               continue;
             }
-            else if(ionoType == DualFreq)
+
+            if(ionoType == DualFreq)
             {
                const double gamma = (L1_FREQ_GPS/L2_FREQ_GPS) * (L1_FREQ_GPS/L2_FREQ_GPS);
 
@@ -159,21 +184,21 @@ namespace gpstk
                
                if( P1!=0 && P2!=0 )
                {
-                  ionL1 = (P1-P2)/(1.0-gamma);
+                  ionL1[i] = (P1-P2)/(1.0-gamma);
                }
             }
 
-            double ionL2 = ionL1 * (L1_FREQ_GPS/L2_FREQ_GPS) * (L1_FREQ_GPS/L2_FREQ_GPS);
-            double ionL5 = ionL1 * (L1_FREQ_GPS/L5_FREQ_GPS) * (L1_FREQ_GPS/L5_FREQ_GPS);
+            double ionL2 = ionL1[i] * (L1_FREQ_GPS/L2_FREQ_GPS) * (L1_FREQ_GPS/L2_FREQ_GPS);
+            double ionL5 = ionL1[i] * (L1_FREQ_GPS/L5_FREQ_GPS) * (L1_FREQ_GPS/L5_FREQ_GPS);
             
                // TODO: more frequency later
 
                // Now we have to add the new values to the data structure
-            (*stv).second[TypeID::ionoL1] = ionL1;
+            (*stv).second[TypeID::ionoL1] = ionL1[i];
             (*stv).second[TypeID::ionoL2] = ionL2;
             (*stv).second[TypeID::ionoL5] = ionL5;
 
-         }  // End of loop 'for(stv = gData.begin()...'
+         }  // End of loop 'for(size_t i = 0; i < sats.size(); i++)'
 
             // Remove satellites with missing data
          gData.removeSatID(satRejectedSet);
@@ -0,0 +1,570 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file EpochLog.cpp
+ * Class to store a sequence of gnssRinex epochs as packed binary records,
+ * in memory or in a memory-mapped temporary file.
+ */
+
+#include "EpochLog.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+namespace gpstk
+{
+
+   namespace
+   {
+         // Default size beyond which the log is moved to a temporary file
+      const size_t defaultSpillSize = 256*1024*1024;
+
+         // Smallest allocation, and smallest growth of the log
+      const size_t minimumAllocation = 64*1024;
+
+         // Accessed bytes of the temporary file that may stay resident
+      const size_t residentSize = 16*1024*1024;
+   }
+
+
+      // Returns a string identifying this object.
+   std::string EpochLog::getClassName() const
+   { return "EpochLog"; }
+
+
+      // Default constructor.
+   EpochLog::EpochLog()
+      : data(0), used(0), allocated(0), fileDescriptor(-1),
+        spillSize(defaultSpillSize), first(0), touchedBegin(0), touchedEnd(0)
+   {}
+
+
+      // Copy constructor.
+   EpochLog::EpochLog(const EpochLog& right)
+      : data(0), used(0), allocated(0), fileDescriptor(-1),
+        spillSize(right.spillSize), spillDirectory(right.spillDirectory),
+        first(0), touchedBegin(0), touchedEnd(0)
+   {
+      (*this) = right;
+   }
+
+
+      // Assignment operator.
+   EpochLog& EpochLog::operator=(const EpochLog& right)
+   {
+
+      if (this == &right)
+      {
+         return (*this);
+      }
+
+      clear();
+
+      spillSize = right.spillSize;
+      spillDirectory = right.spillDirectory;
+
+      if (right.used > 0)
+      {
+         reserve(right.used);
+         std::memcpy(data, right.data, right.used);
+         used = right.used;
+         touch(0, used);
+      }
+
+      offsets = right.offsets;
+      first = right.first;
+      strings = right.strings;
+      stringIndex = right.stringIndex;
+
+      return (*this);
+
+   }  // End of method 'EpochLog::operator=()'
+
+
+      // Destructor.
+   EpochLog::~EpochLog()
+   {
+      release();
+   }
+
+
+      /* Appends an epoch at the end of the log.
+       *
+       * @param gData    Data object holding the epoch to be stored.
+       */
+   void EpochLog::push_back(const gnssRinex& gData)
+   {
+
+      unsigned numValues( gData.body.numElements() );
+      size_t bytes( sizeof(EpochHeader) + numValues*sizeof(ValueRecord) );
+
+      reserve(bytes);
+
+      write(used, gData, numValues);
+      offsets.push_back(used);
+      used += bytes;
+
+      touch(used-bytes, used);
+
+   }  // End of method 'EpochLog::push_back()'
+
+
+
+      /* Reads the epoch at position 'index' (starting at zero from the
+       * oldest epoch not removed by pop_front()).
+       *
+       * @param index    Position of the epoch in the log.
+       * @param gData    Data object that will hold the stored epoch.
+       */
+   void EpochLog::get(size_t index, gnssRinex& gData)
+      throw(InvalidRequest)
+   {
+
+      if (index >= size())
+      {
+         InvalidRequest e( getClassName() + ": no epoch at this index" );
+         GPSTK_THROW(e);
+      }
+
+      size_t offset( offsets[first+index] );
+      const EpochHeader& head(
+                     *reinterpret_cast<const EpochHeader*>(data + offset) );
+      const ValueRecord *rec(
+                     reinterpret_cast<const ValueRecord*>(data + offset
+                                                      + sizeof(EpochHeader)) );
+
+      gData.header.source.type =
+                        static_cast<SourceID::SourceType>(head.sourceType);
+      gData.header.source.sourceName = strings[head.sourceName];
+      gData.header.epoch.set( head.day, head.sod, head.fsod,
+             TimeSystem(static_cast<TimeSystem::Systems>(head.timeSystem)) );
+      gData.header.antennaType = strings[head.antennaType];
+      gData.header.antennaPosition = Triple( head.antennaPosition[0],
+                                             head.antennaPosition[1],
+                                             head.antennaPosition[2] );
+      gData.header.epochFlag = static_cast<short>(head.epochFlag);
+
+         // Records are sorted by satellite and type, so every insertion
+         // goes at the end of its map
+      gData.body.clear();
+      satTypeValueMap::iterator it( gData.body.end() );
+      for (unsigned i = 0; i < head.numValues; i++)
+      {
+
+         SatID sat( rec[i].id,
+                    static_cast<SatID::SatelliteSystem>(rec[i].system) );
+
+         if ( it == gData.body.end() || !((*it).first == sat) )
+         {
+            it = gData.body.insert( gData.body.end(),
+                                    std::make_pair(sat, typeValueMap()) );
+         }
+
+         (*it).second.insert( (*it).second.end(),
+               std::make_pair( TypeID(static_cast<TypeID::ValueType>(
+                                                         rec[i].type)),
+                               rec[i].value ) );
+
+      }
+
+      touch(offset, offset + sizeof(EpochHeader)
+                                    + head.capacity*sizeof(ValueRecord));
+
+   }  // End of method 'EpochLog::get()'
+
+
+
+      /* Replaces the epoch at position 'index' with 'gData'.
+       *
+       * @param index    Position of the epoch in the log.
+       * @param gData    Data object holding the new epoch.
+       */
+   void EpochLog::update(size_t index, const gnssRinex& gData)
+      throw(InvalidRequest)
+   {
+
+      if (index >= size())
+      {
+         InvalidRequest e( getClassName() + ": no epoch at this index" );
+         GPSTK_THROW(e);
+      }
+
+      unsigned numValues( gData.body.numElements() );
+      size_t offset( offsets[first+index] );
+      unsigned capacity(
+               reinterpret_cast<const EpochHeader*>(data + offset)->capacity );
+
+         // If it still fits, rewrite it in place
+      if (numValues <= capacity)
+      {
+         write(offset, gData, capacity);
+         touch(offset, offset + sizeof(EpochHeader)
+                                          + capacity*sizeof(ValueRecord));
+         return;
+      }
+
+         // Otherwise, move it to the end of the log
+      size_t bytes( sizeof(EpochHeader) + numValues*sizeof(ValueRecord) );
+
+      reserve(bytes);
+
+      write(used, gData, numValues);
+      offsets[first+index] = used;
+      used += bytes;
+
+      touch(used-bytes, used);
+
+   }  // End of method 'EpochLog::update()'
+
+
+
+      /* Removes the oldest epoch of the log. Its storage is only given
+       * back by clear(), or when the log becomes empty.
+       */
+   void EpochLog::pop_front(void)
+      throw(InvalidRequest)
+   {
+
+      if (empty())
+      {
+         InvalidRequest e( getClassName() + ": the log is empty" );
+         GPSTK_THROW(e);
+      }
+
+      ++first;
+
+      if (empty())
+      {
+         clear();
+      }
+
+   }  // End of method 'EpochLog::pop_front()'
+
+
+
+      // Removes all epochs, giving back memory and temporary file.
+   void EpochLog::clear(void)
+   {
+
+      release();
+
+      offsets.clear();
+      first = 0;
+      strings.clear();
+      stringIndex.clear();
+
+   }  // End of method 'EpochLog::clear()'
+
+
+
+      // Returns the index of 's' in 'strings', adding it if needed.
+   int EpochLog::stringID(const std::string& s)
+   {
+
+      std::map<std::string, int>::const_iterator it( stringIndex.find(s) );
+      if (it != stringIndex.end())
+      {
+         return (*it).second;
+      }
+
+      int id( static_cast<int>(strings.size()) );
+      strings.push_back(s);
+      stringIndex[s] = id;
+
+      return id;
+
+   }  // End of method 'EpochLog::stringID()'
+
+
+
+      // Makes room for 'bytes' more bytes at the end of 'data'.
+   void EpochLog::reserve(size_t bytes)
+   {
+
+      size_t needed( used + bytes );
+      if (needed <= allocated)
+      {
+         return;
+      }
+
+      size_t newSize( 2*allocated );
+      if (newSize < needed) newSize = needed;
+      if (newSize < minimumAllocation) newSize = minimumAllocation;
+
+         // Once past the spill size, move the log to a temporary file
+      if ( !isSpilled() && spillSize > 0 && needed > spillSize &&
+           spill(newSize) )
+      {
+         return;
+      }
+
+#ifndef _WIN32
+      if (isSpilled())
+      {
+            // Grow the file and map it again. If that fails, the old
+            // mapping is still valid.
+         if (::ftruncate(fileDescriptor, newSize) != 0)
+         {
+            throw std::bad_alloc();
+         }
+
+         void *addr( ::mmap( 0, newSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                             fileDescriptor, 0 ) );
+         if (addr == MAP_FAILED)
+         {
+            throw std::bad_alloc();
+         }
+
+         ::munmap(data, allocated);
+         data = static_cast<char*>(addr);
+         allocated = newSize;
+         touchedBegin = touchedEnd = 0;
+
+         return;
+      }
+#endif
+
+      char *newData( static_cast<char*>(std::realloc(data, newSize)) );
+      if (newData == 0)
+      {
+         throw std::bad_alloc();
+      }
+
+      data = newData;
+      allocated = newSize;
+
+   }  // End of method 'EpochLog::reserve()'
+
+
+
+      // Moves 'data' to a temporary file of 'bytes' bytes. Returns false
+      // (and leaves the log in memory) if that is not possible.
+   bool EpochLog::spill(size_t bytes)
+   {
+
+#ifndef _WIN32
+      std::string dir( spillDirectory );
+      if (dir.empty())
+      {
+         const char *tmp( std::getenv("TMPDIR") );
+         dir = (tmp != 0 && tmp[0] != '\0') ? tmp : "/tmp";
+      }
+
+      std::string pattern( dir + "/gpstkEpochLogXXXXXX" );
+      std::vector<char> name( pattern.begin(), pattern.end() );
+      name.push_back('\0');
+
+      int fd( ::mkstemp(&name[0]) );
+      if (fd < 0)
+      {
+         return false;
+      }
+
+         // The file goes away as soon as it is closed
+      ::unlink(&name[0]);
+
+      if (::ftruncate(fd, bytes) != 0)
+      {
+         ::close(fd);
+         return false;
+      }
+
+      void *addr( ::mmap( 0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                          fd, 0 ) );
+      if (addr == MAP_FAILED)
+      {
+         ::close(fd);
+         return false;
+      }
+
+      std::memcpy(addr, data, used);
+      std::free(data);
+
+      data = static_cast<char*>(addr);
+      allocated = bytes;
+      fileDescriptor = fd;
+
+         // Everything copied so far may leave memory
+      touchedBegin = 0;
+      touchedEnd = used;
+      dropResident();
+
+      return true;
+#else
+      return false;
+#endif
+
+   }  // End of method 'EpochLog::spill()'
+
+
+
+      // Writes 'gData' at 'offset', with room for 'capacity' values.
+   void EpochLog::write( size_t offset,
+                         const gnssRinex& gData,
+                         unsigned capacity )
+   {
+
+      EpochHeader& head( *reinterpret_cast<EpochHeader*>(data + offset) );
+      ValueRecord *rec( reinterpret_cast<ValueRecord*>(data + offset
+                                                      + sizeof(EpochHeader)) );
+
+      TimeSystem ts;
+      gData.header.epoch.get(head.day, head.sod, head.fsod, ts);
+      head.timeSystem = static_cast<int>(ts.getTimeSystem());
+      head.sourceType = static_cast<int>(gData.header.source.type);
+      head.sourceName = stringID(gData.header.source.sourceName);
+      head.antennaType = stringID(gData.header.antennaType);
+      head.antennaPosition[0] = gData.header.antennaPosition[0];
+      head.antennaPosition[1] = gData.header.antennaPosition[1];
+      head.antennaPosition[2] = gData.header.antennaPosition[2];
+      head.epochFlag = gData.header.epochFlag;
+      head.capacity = capacity;
+      head.reserved = 0;
+
+      unsigned n(0);
+      for( satTypeValueMap::const_iterator it = gData.body.begin();
+           it != gData.body.end();
+           ++it )
+      {
+         for( typeValueMap::const_iterator itObs = (*it).second.begin();
+              itObs != (*it).second.end();
+              ++itObs )
+         {
+            rec[n].value = (*itObs).second;
+            rec[n].type = static_cast<int>((*itObs).first.type);
+            rec[n].id = static_cast<short>((*it).first.id);
+            rec[n].system = static_cast<short>((*it).first.system);
+            ++n;
+         }
+      }
+
+      head.numValues = n;
+
+   }  // End of method 'EpochLog::write()'
+
+
+
+      // Notes that the bytes in [begin, end) have been accessed, and
+      // releases the resident pages of the temporary file once the
+      // accessed range gets large.
+   void EpochLog::touch(size_t begin, size_t end)
+   {
+
+      if (!isSpilled())
+      {
+         return;
+      }
+
+      if (touchedBegin == touchedEnd)
+      {
+         touchedBegin = begin;
+         touchedEnd = end;
+      }
+      else
+      {
+         if (begin < touchedBegin) touchedBegin = begin;
+         if (end > touchedEnd) touchedEnd = end;
+      }
+
+      if (touchedEnd - touchedBegin < residentSize)
+      {
+         return;
+      }
+
+      dropResident();
+
+   }  // End of method 'EpochLog::touch()'
+
+
+
+      // Releases the resident pages of the accessed range of the
+      // temporary file.
+   void EpochLog::dropResident(void)
+   {
+
+#if !defined(_WIN32) && defined(MADV_DONTNEED)
+      if (isSpilled() && touchedEnd > touchedBegin)
+      {
+            // The contents stay in the file (and its page cache); they are
+            // read back when accessed again
+         size_t page( static_cast<size_t>(::sysconf(_SC_PAGESIZE)) );
+         size_t from( touchedBegin - touchedBegin % page );
+         size_t to( touchedEnd + page - 1 );
+         to -= to % page;
+         if (to > allocated) to = allocated;
+
+         ::madvise(data + from, to - from, MADV_DONTNEED);
+      }
+#endif
+
+      touchedBegin = touchedEnd = 0;
+
+   }  // End of method 'EpochLog::dropResident()'
+
+
+
+      // Gives back the storage.
+   void EpochLog::release(void)
+   {
+
+#ifndef _WIN32
+      if (isSpilled())
+      {
+         ::munmap(data, allocated);
+         ::close(fileDescriptor);
+         fileDescriptor = -1;
+         data = 0;
+      }
+#endif
+
+      std::free(data);
+
+      data = 0;
+      used = 0;
+      allocated = 0;
+      touchedBegin = touchedEnd = 0;
+
+   }  // End of method 'EpochLog::release()'
+
+
+}  // End of namespace gpstk
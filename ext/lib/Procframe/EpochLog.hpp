@@ -0,0 +1,322 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file EpochLog.hpp
+ * Class to store a sequence of gnssRinex epochs as packed binary records,
+ * in memory or in a memory-mapped temporary file.
+ */
+
+#ifndef GPSTK_EPOCHLOG_HPP
+#define GPSTK_EPOCHLOG_HPP
+
+#include "DataStructures.hpp"
+#include <vector>
+#include <map>
+#include <string>
+
+
+namespace gpstk
+{
+
+      /// @ingroup DataStructures
+      //@{
+
+
+      /** This class stores a sequence of gnssRinex epochs as packed binary
+       *  records, so that they may be read back, modified and written again
+       *  in any order. Solvers that go over the same data several times,
+       *  such as SolverPPPFB, use it instead of a list of gnssRinex objects.
+       *
+       * Each epoch is kept as a fixed-size header followed by one 16-byte
+       * record per (SatID, TypeID, value) triple, about a fourth of the
+       * memory taken by the equivalent std::map nodes. The strings of the
+       * headers (source name and antenna type) are stored only once.
+       *
+       * When the log grows beyond the spill size (256 MB by default, see
+       * setSpillSize()) it is moved to an unlinked temporary file that is
+       * mapped into memory, and the pages that have been read or written
+       * are released to the operating system as the epochs are streamed.
+       * Where the platform does not allow it, the log stays in memory.
+       *
+       * A typical way to use this class follows:
+       *
+       * @code
+       *   EpochLog log;
+       *
+       *   while(rin >> gRin)
+       *   {
+       *      gRin >> basic >> solver;
+       *      log.push_back(gRin);
+       *   }
+       *
+       *      // Go backwards over the stored data, updating it
+       *   for(size_t i = log.size(); i > 0; --i)
+       *   {
+       *      log.get(i-1, gRin);
+       *      gRin >> solver;
+       *      log.update(i-1, gRin);
+       *   }
+       * @endcode
+       *
+       * An epoch that grows when updated (it has more values than when it
+       * was stored) is moved to the end of the log; otherwise it is
+       * rewritten in place.
+       */
+   class EpochLog
+   {
+   public:
+
+         /// Default constructor.
+      EpochLog();
+
+
+         /// Copy constructor. The copy is kept in memory until it grows
+         /// beyond its own spill size.
+      EpochLog(const EpochLog& right);
+
+
+         /// Assignment operator.
+      EpochLog& operator=(const EpochLog& right);
+
+
+         /// Destructor. Removes the temporary file, if any.
+      virtual ~EpochLog();
+
+
+         /// Returns the number of epochs in the log.
+      size_t size(void) const
+      { return (offsets.size() - first); };
+
+
+         /// Returns true if there are no epochs in the log.
+      bool empty(void) const
+      { return (first == offsets.size()); };
+
+
+         /** Appends an epoch at the end of the log.
+          *
+          * @param gData    Data object holding the epoch to be stored.
+          */
+      virtual void push_back(const gnssRinex& gData);
+
+
+         /** Reads the epoch at position 'index' (starting at zero from the
+          *  oldest epoch not removed by pop_front()).
+          *
+          * @param index    Position of the epoch in the log.
+          * @param gData    Data object that will hold the stored epoch.
+          */
+      virtual void get(size_t index, gnssRinex& gData)
+         throw(InvalidRequest);
+
+
+         /** Replaces the epoch at position 'index' with 'gData'.
+          *
+          * @param index    Position of the epoch in the log.
+          * @param gData    Data object holding the new epoch.
+          */
+      virtual void update(size_t index, const gnssRinex& gData)
+         throw(InvalidRequest);
+
+
+         /** Removes the oldest epoch of the log. Its storage is only given
+          *  back by clear(), or when the log becomes empty.
+          */
+      virtual void pop_front(void)
+         throw(InvalidRequest);
+
+
+         /// Removes all epochs, giving back memory and temporary file.
+      virtual void clear(void);
+
+
+         /// Returns the number of bytes taken by the stored epochs.
+      size_t numBytes(void) const
+      { return used; };
+
+
+         /// Returns true if the log has been moved to a temporary file.
+      bool isSpilled(void) const
+      { return (fileDescriptor >= 0); };
+
+
+         /// Returns the size (in bytes) beyond which the log is moved to a
+         /// temporary file.
+      size_t getSpillSize(void) const
+      { return spillSize; };
+
+
+         /** Sets the size (in bytes) beyond which the log is moved to a
+          *  temporary file. Zero means that the log is always kept in memory.
+          *  Takes effect when the log next grows.
+          *
+          * @param bytes    Spill size, in bytes.
+          */
+      EpochLog& setSpillSize(size_t bytes)
+      { spillSize = bytes; return (*this); };
+
+
+         /// Returns the directory where the temporary file is created.
+      std::string getSpillDirectory(void) const
+      { return spillDirectory; };
+
+
+         /** Sets the directory where the temporary file is created. By
+          *  default, it is the one given by the TMPDIR environment variable,
+          *  or "/tmp".
+          *
+          * @param dir      Directory for the temporary file.
+          */
+      EpochLog& setSpillDirectory(const std::string& dir)
+      { spillDirectory = dir; return (*this); };
+
+
+         /// Returns a string identifying this object.
+      virtual std::string getClassName(void) const;
+
+
+   private:
+
+
+         /// Fixed part of each stored epoch.
+      struct EpochHeader
+      {
+         long day;
+         long sod;
+         double fsod;
+         double antennaPosition[3];
+         int timeSystem;
+         int sourceType;
+         int sourceName;      ///< Index in 'strings'
+         int antennaType;     ///< Index in 'strings'
+         int epochFlag;
+         unsigned numValues;  ///< Number of ValueRecord's used
+         unsigned capacity;   ///< Number of ValueRecord's reserved
+         unsigned reserved;
+      };
+
+
+         /// One (SatID, TypeID, value) triple.
+      struct ValueRecord
+      {
+         double value;
+         int type;
+         short id;
+         short system;
+      };
+
+
+         /// Storage, either allocated memory or a mapped temporary file.
+      char *data;
+
+
+         /// Number of bytes of 'data' in use.
+      size_t used;
+
+
+         /// Number of bytes allocated (or mapped) in 'data'.
+      size_t allocated;
+
+
+         /// Descriptor of the temporary file, or -1 while in memory.
+      int fileDescriptor;
+
+
+         /// Size beyond which the log is moved to a temporary file.
+      size_t spillSize;
+
+
+         /// Directory where the temporary file is created.
+      std::string spillDirectory;
+
+
+         /// Offset in 'data' of each epoch.
+      std::vector<size_t> offsets;
+
+
+         /// Index in 'offsets' of the oldest epoch not yet removed.
+      size_t first;
+
+
+         /// Strings found in the headers, and their indexes.
+      std::vector<std::string> strings;
+      std::map<std::string, int> stringIndex;
+
+
+         /// Range of bytes of the temporary file that may be resident.
+      size_t touchedBegin, touchedEnd;
+
+
+         /// Returns the index of 's' in 'strings', adding it if needed.
+      int stringID(const std::string& s);
+
+
+         /// Makes room for 'bytes' more bytes at the end of 'data'.
+      void reserve(size_t bytes);
+
+
+         /// Moves 'data' to a temporary file of 'bytes' bytes. Returns false
+         /// (and leaves the log in memory) if that is not possible.
+      bool spill(size_t bytes);
+
+
+         /// Writes 'gData' at 'offset', with room for 'capacity' values.
+      void write(size_t offset, const gnssRinex& gData, unsigned capacity);
+
+
+         /// Notes that the bytes in [begin, end) have been accessed, and
+         /// releases the resident pages of the temporary file once the
+         /// accessed range gets large.
+      void touch(size_t begin, size_t end);
+
+
+         /// Releases the resident pages of the accessed range of the
+         /// temporary file.
+      void dropResident(void);
+
+
+         /// Gives back the storage.
+      void release(void);
+
+
+   }; // End of class 'EpochLog'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_EPOCHLOG_HPP
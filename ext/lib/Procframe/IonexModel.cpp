@@ -115,8 +115,45 @@ namespace gpstk
       try
       {
 
-            // Loop through all the satellites
+            // Pierce points of the satellites with elevation and azimuth, in
+            // the order of gData, whose TEC values are looked up at once
+         std::vector<Position> IPPs;
+         std::vector<Triple> values;
+         std::vector<bool> found;
+
          satTypeValueMap::iterator stv;
+         if(pDefaultMaps!=NULL)
+         {
+
+            for(stv = gData.begin(); stv != gData.end(); ++stv)
+            {
+
+               if( stv->second.find(TypeID::elevation) != stv->second.end() &&
+                   stv->second.find(TypeID::azimuth)   != stv->second.end() )
+               {
+
+                  Position IPP = rxPos.getIonosphericPiercePoint(
+                                                stv->second(TypeID::elevation),
+                                                stv->second(TypeID::azimuth),
+                                                ionoHeight );
+                  IPP.transformTo(Position::Geocentric);
+                  IPPs.push_back(IPP);
+
+               }
+
+            }
+
+            if( !IPPs.empty() )
+            {
+               pDefaultMaps->getIonexValues( time, IPPs, values, found );
+            }
+
+         }  // End of 'if(pDefaultMaps!=NULL)'
+
+            // Index of the current satellite within IPPs
+         size_t ipp(0);
+
+            // Loop through all the satellites
          for(stv = gData.begin(); stv != gData.end(); ++stv)
          {
 
@@ -144,29 +181,26 @@ namespace gpstk
             else
             {
 
-                  // Scalars to hold satellite elevation, azimuth, ionospheric
+                  // Scalars to hold satellite elevation, ionospheric
                   // map and ionospheric slant delays
                double elevation( stv->second(TypeID::elevation) );
-               double azimuth(   stv->second(TypeID::azimuth)   );
                double ionoMap(0.0);
                double ionexL1(0.0), ionexL2(0.0), ionexL5(0.0);   // GPS
                double ionexL6(0.0), ionexL7(0.0), ionexL8(0.0);   // Galileo
 
-                  //	calculate the position of the ionospheric pierce-point
-                  // corresponding to the receiver-satellite ray
-               Position IPP = rxPos.getIonosphericPiercePoint( elevation,
-                                                               azimuth,
-                                                               ionoHeight);
-
                   // TODO
                   // Checking the collinearity of rxPos, IPP and SV
 
 
-                  // Let's get TEC, RMS and ionosphere height for IPP
-                  // at current epoch
-               Position pos(IPP);
-               pos.transformTo(Position::Geocentric);
-               Triple val = pDefaultMaps->getIonexValue( time, pos );
+                  // TEC, RMS and ionosphere height at the ionospheric
+                  // pierce-point of the receiver-satellite ray
+               if( !found[ipp] )
+               {
+                  InvalidRequest e( "No IONEX value at the pierce point of "
+                                    + StringUtils::asString(stv->first) );
+                  GPSTK_THROW(e);
+               }
+               Triple val( values[ipp++] );
 
                   // just to make it handy for useage
                double tecval = val[0];
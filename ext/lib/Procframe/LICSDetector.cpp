@@ -312,35 +312,38 @@ namespace gpstk
       double tempLLI2(0.0);
 
 
+         // Look up the data of this satellite only once
+      filterData& data( LIData[sat] );
+
          // Get the difference between current epoch and former epoch,
          // in seconds
-      currentDeltaT = ( epoch - LIData[sat].formerEpoch );
+      currentDeltaT = ( epoch - data.formerEpoch );
 
          // Store current epoch as former epoch
-      LIData[sat].formerEpoch = epoch;
+      data.formerEpoch = epoch;
 
          // Current value of LI difference
-      currentBias = li - LIData[sat].formerLI;
+      currentBias = li - data.formerLI;
 
          // Increment window size
-      ++LIData[sat].windowSize;
+      ++data.windowSize;
 
          // Check if receiver already declared cycle slip or too much time
          // has elapsed
-         // Note: If tvMap(lliType1) or tvMap(lliType2) don't exist, then 0
-         // will be returned and those tests will pass
-      if ( (tvMap(lliType1)==1.0) ||
-           (tvMap(lliType1)==3.0) ||
-           (tvMap(lliType1)==5.0) ||
-           (tvMap(lliType1)==7.0) )
+         // Note: The LLI indexes are the ones found by Process(), that are
+         // zero if they are missing or ignored
+      if ( (lli1==1.0) ||
+           (lli1==3.0) ||
+           (lli1==5.0) ||
+           (lli1==7.0) )
       {
          tempLLI1 = 1.0;
       }
 
-      if ( (tvMap(lliType2)==1.0) ||
-           (tvMap(lliType2)==3.0) ||
-           (tvMap(lliType2)==5.0) ||
-           (tvMap(lliType2)==7.0) )
+      if ( (lli2==1.0) ||
+           (lli2==3.0) ||
+           (lli2==5.0) ||
+           (lli2==7.0) )
       {
          tempLLI2 = 1.0;
       }
@@ -353,24 +356,24 @@ namespace gpstk
       {
 
             // We reset the filter with this
-         LIData[sat].windowSize = 0;
+         data.windowSize = 0;
 
          reportCS = true;
       }
 
-      if (LIData[sat].windowSize > 1)
+      if (data.windowSize > 1)
       {
          deltaLimit = minThreshold + std::abs(LIDrift*currentDeltaT);
 
             // Compute a linear interpolation and compute
             // LI_predicted - LI_current
-         delta = std::abs( currentBias - (LIData[sat].formerBias *
-                           currentDeltaT / LIData[sat].formerDeltaT) );
+         delta = std::abs( currentBias - (data.formerBias *
+                           currentDeltaT / data.formerDeltaT) );
 
          if (delta > deltaLimit)
          {
                // We reset the filter with this
-            LIData[sat].windowSize = 0;
+            data.windowSize = 0;
 
             reportCS = true;
          }
@@ -378,9 +381,9 @@ namespace gpstk
       }
 
          // Let's prepare for the next time
-      LIData[sat].formerLI = li;
-      LIData[sat].formerBias = currentBias;
-      LIData[sat].formerDeltaT = currentDeltaT;
+      data.formerLI = li;
+      data.formerBias = currentBias;
+      data.formerDeltaT = currentDeltaT;
 
       if (reportCS)
       {
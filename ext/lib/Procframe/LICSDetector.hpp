@@ -44,6 +44,7 @@
 #define GPSTK_LICSDETECTOR_HPP
 
 #include "ProcessingClass.hpp"
+#include "WindowStats.hpp"
 
 
 
@@ -292,8 +293,8 @@ namespace gpstk
       };
 
 
-         /// Map holding the information regarding every satellite
-      std::map<SatID, filterData> LIData;
+         /// Table holding the information regarding every satellite
+      SatTable<filterData> LIData;
 
 
          /** Method that implements the LI cycle slip detection algorithm
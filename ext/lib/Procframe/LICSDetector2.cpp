@@ -338,14 +338,18 @@ namespace gpstk
       double tempLLI2(0.0);
 
 
+         // Look up the data of this satellite only once
+      filterData& data( LIData[sat] );
+      WindowStats& window( data.window );
+
          // Get current buffer size
-      size_t s( LIData[sat].LIEpoch.size() );
+      size_t s( window.size() );
 
          // Get the difference between current epoch and LAST epoch,
          // in seconds, but first test if we have epoch data inside LIData
       if(s > 0)
       {
-         currentDeltaT = ( epoch - LIData[sat].LIEpoch.back() );
+         currentDeltaT = ( epoch - data.firstEpoch ) - window.back().t;
       }
       else
       {
@@ -356,20 +360,20 @@ namespace gpstk
 
          // Check if receiver already declared cycle slip or too much time
          // has elapsed
-         // Note: If tvMap(lliType1) or tvMap(lliType2) don't exist, then 0
-         // will be returned and those tests will pass
-      if ( (tvMap(lliType1)==1.0) ||
-           (tvMap(lliType1)==3.0) ||
-           (tvMap(lliType1)==5.0) ||
-           (tvMap(lliType1)==7.0) )
+         // Note: The LLI indexes are the ones found by Process(), that are
+         // zero if they are missing or ignored
+      if ( (lli1==1.0) ||
+           (lli1==3.0) ||
+           (lli1==5.0) ||
+           (lli1==7.0) )
       {
          tempLLI1 = 1.0;
       }
 
-      if ( (tvMap(lliType2)==1.0) ||
-           (tvMap(lliType2)==3.0) ||
-           (tvMap(lliType2)==5.0) ||
-           (tvMap(lliType2)==7.0) )
+      if ( (lli2==1.0) ||
+           (lli2==3.0) ||
+           (lli2==5.0) ||
+           (lli2==7.0) )
       {
          tempLLI2 = 1.0;
       }
@@ -382,11 +386,10 @@ namespace gpstk
       {
 
             // We reset buffer with the following lines
-         LIData[sat].LIEpoch.clear();
-         LIData[sat].LIBuffer.clear();
+         window.clear();
 
             // current buffer size should be updated
-         s = LIData[sat].LIEpoch.size();
+         s = 0;
 
             // Report cycle slip
          reportCS = true;
@@ -395,106 +398,51 @@ namespace gpstk
          // Check if we have enough data to start processing.
       if (s >= (size_t)minBufferSize)
       {
-            // Declare a Vector for LI measurements
-         Vector<double> y(s, 0.0);
-
-            // Declare a Matrix for epoch information
-         Matrix<double> M(s, 3, 0.0);
-
-            // We store here the OLDEST (or FIRST) epoch in buffer for future
-            // reference. This is important because adjustment will be made
-            // with respect to that first epoch
-         CommonTime firstEpoch(LIData[sat].LIEpoch.front());
-
-            // Feed 'y' with data
-         for(size_t i=0; i<s; i++)
+            // Find a 2nd order fitting curve using a least mean squares
+            // (LMS) adjustment. The sums it needs are kept up to date by
+            // 'window' as the data come and go, so this takes the same time
+            // whatever the size of the buffer.
+         WindowFit fit;
+         if( !window.fit(2, fit) )
          {
-               // The newest goes first in 'y' vector
-            y(i) = LIData[sat].LIBuffer[s-1-i];
-         }
-
-            // Feed 'M' with data
-         for(size_t i=0; i<s; i++)
-         {
-               // Compute epoch difference with respect to FIRST epoch
-            double dT( LIData[sat].LIEpoch[s-1-i] - firstEpoch );
-
-            M(i,0) = 1.0;
-            M(i,1) = dT;
-            M(i,2) = dT*dT;
-         }
-
-            // Now, proceed to find a 2nd order fiting curve using a least
-            // mean squares (LMS) adjustment
-         Matrix<double> MT(transpose(M));
-         Matrix<double> covMatrix( MT * M );
-
-         // Let's try to invert MT*M   matrix
-         try
-         {
-            covMatrix = inverseChol( covMatrix );
-         }
-         catch(...)
-         {
-               // If covMatrix can't be inverted we have a serious problem
+               // If the adjustment can't be done we have a serious problem
                // with data, so reset buffer and declare cycle slip
-            LIData[sat].LIEpoch.clear();
-            LIData[sat].LIBuffer.clear();
+            window.clear();
 
             reportCS = true;
          }
-
-
-            // Now, compute the Vector holding the results of adjustment to
-            // second order curve
-         Vector<double> a(covMatrix * MT * y);
-
-            // The next step is to compute the maximum deviation from
-            // adjustment, in order to assess if our adjustment is too noisy
-         double maxDeltaLI(0.0);
-
-         for(size_t i=0; i<s; i++)
+         else
          {
-               // Compute epoch difference with respect to FIRST epoch
-            double dT( LIData[sat].LIEpoch[s-1-i] - firstEpoch );
-
-               // Compute adjusted LI value
-            double LIa( a(0) + a(1)*dT + a(2)*dT*dT );
+               // The next step is to compute the maximum deviation from
+               // adjustment, in order to assess if our adjustment is too
+               // noisy
+            double maxDeltaLI( window.maxResidual(fit) );
 
-               // Find maximum deviation in current data buffer
-            double deltaLI( std::abs(LIa - LIData[sat].LIBuffer[s-1-i]) );
-            if( deltaLI > maxDeltaLI )
-            {
-                maxDeltaLI = deltaLI;
-            }
-         }
+               // Compute current adjusted LI value
+            double currentLIa( fit( epoch - data.firstEpoch ) );
 
-            // Compute epoch difference with respect to FIRST epoch
-         double deltaT( epoch - firstEpoch );
-
-            // Compute current adjusted LI value
-         double currentLIa( a(0) + a(1)*deltaT + a(2)*deltaT*deltaT );
-
-            // Difference between current and adjusted LI values
-         double currentBias( std::abs( currentLIa - li ) );
-
-            // We will continue processing only if we trust our current
-            // adjustment, i.e: it is NOT too noisy
-         if( (2.0*maxDeltaLI) < currentBias )
-         {
-               // Compute limit to declare cycle slip
-            double deltaLimit( satThreshold /
-                               ( 1.0 + ( 1.0 /
-                                         std::exp(currentDeltaT/timeConst) )));
+               // Difference between current and adjusted LI values
+            double currentBias( std::abs( currentLIa - li ) );
 
-               // Check if current LI deviation is above deltaLimit threshold
-            if( currentBias > deltaLimit )
+               // We will continue processing only if we trust our current
+               // adjustment, i.e: it is NOT too noisy
+            if( (2.0*maxDeltaLI) < currentBias )
             {
-                  // Reset buffer and declare cycle slip
-               LIData[sat].LIEpoch.clear();
-               LIData[sat].LIBuffer.clear();
+                  // Compute limit to declare cycle slip
+               double deltaLimit( satThreshold /
+                                  ( 1.0 + ( 1.0 /
+                                        std::exp(currentDeltaT/timeConst) )));
+
+                  // Check if current LI deviation is above deltaLimit
+                  // threshold
+               if( currentBias > deltaLimit )
+               {
+                     // Reset buffer and declare cycle slip
+                  window.clear();
+
+                  reportCS = true;
 
-               reportCS = true;
+               }
 
             }
 
@@ -509,24 +457,21 @@ namespace gpstk
 
          // Let's prepare for the next epoch
 
-         // Store current epoch at the end of deque
-      LIData[sat].LIEpoch.push_back(epoch);
-
-         // Store current value of LI at the end of deque
-      LIData[sat].LIBuffer.push_back(li);
-
-         // Update current buffer size
-      s = LIData[sat].LIEpoch.size();
-
-         // Check if we have exceeded maximum window size
-      if(s > size_t(maxBufferSize))
+         // A new arc starts: epochs are counted from its first one, and a
+         // new maximum buffer size takes effect
+      if( window.empty() )
       {
-            // Get rid of oldest data, which is at the beginning of deque
-         LIData[sat].LIEpoch.pop_front();
-         LIData[sat].LIBuffer.pop_front();
+         data.firstEpoch = epoch;
 
+         if( window.capacity() != size_t(maxBufferSize) )
+         {
+            window.setCapacity(maxBufferSize);
+         }
       }
 
+         // Store current epoch and value of LI at the end of the buffer. If
+         // we have exceeded maximum window size, the oldest data are dropped
+      window.push( epoch - data.firstEpoch, li );
 
       if (reportCS)
       {
@@ -44,8 +44,8 @@
 #ifndef GPSTK_LICSDETECTOR2_HPP
 #define GPSTK_LICSDETECTOR2_HPP
 
-#include <deque>
 #include "ProcessingClass.hpp"
+#include "WindowStats.hpp"
 
 
 
@@ -249,6 +249,9 @@ namespace gpstk
           *
           * \warning You must not set a value under minBufferSize, which
           * usually is 5.
+          *
+          * \note The new size is used for each satellite from the start of
+          * its next arc.
           */
       virtual LICSDetector2& setMaxBufferSize(const int& maxBufSize);
 
@@ -333,16 +336,17 @@ namespace gpstk
       struct filterData
       {
             // Default constructor initializing the data in the structure
-         filterData()
+         filterData() : firstEpoch(CommonTime::BEGINNING_OF_TIME)
          {};
 
-         std::deque<CommonTime> LIEpoch; ///< Epochs of previous LI observables.
-         std::deque<double> LIBuffer;  ///< Values of previous LI observables.
+         CommonTime firstEpoch;  ///< First epoch of the current arc.
+         WindowStats window;     ///< Previous LI observables, against the
+                                 ///< seconds since 'firstEpoch'.
       };
 
 
-         /// Map holding the information regarding every satellite
-      std::map<SatID, filterData> LIData;
+         /// Table holding the information regarding every satellite
+      SatTable<filterData> LIData;
 
 
          /** Method that implements the LI cycle slip detection algorithm
@@ -298,35 +298,38 @@ namespace gpstk
       double tempLLI2(0.0);
 
 
+         // Look up the data of this satellite only once
+      filterData& data( MWData[sat] );
+
          // Get the difference between current epoch and former epoch,
          // in seconds
-      currentDeltaT = ( epoch - MWData[sat].formerEpoch );
+      currentDeltaT = ( epoch - data.formerEpoch );
 
          // Store current epoch as former epoch
-      MWData[sat].formerEpoch = epoch;
+      data.formerEpoch = epoch;
 
          // Difference between current value of MW and average value
-      currentBias = std::abs(mw - MWData[sat].meanMW);
+      currentBias = std::abs(mw - data.meanMW);
 
          // Increment window size
-      ++MWData[sat].windowSize;
+      ++data.windowSize;
 
          // Check if receiver already declared cycle slip or if too much time
          // has elapsed
-         // Note: If tvMap(lliType1) or tvMap(lliType2) don't exist, then 0
-         // will be used and those tests will pass
-      if ( (tvMap(lliType1)==1.0) ||
-           (tvMap(lliType1)==3.0) ||
-           (tvMap(lliType1)==5.0) ||
-           (tvMap(lliType1)==7.0) )
+         // Note: The LLI indexes are the ones found by Process(), that are
+         // zero if they are missing or ignored
+      if ( (lli1==1.0) ||
+           (lli1==3.0) ||
+           (lli1==5.0) ||
+           (lli1==7.0) )
       {
          tempLLI1 = 1.0;
       }
 
-      if ( (tvMap(lliType2)==1.0) ||
-           (tvMap(lliType2)==3.0) ||
-           (tvMap(lliType2)==5.0) ||
-           (tvMap(lliType2)==7.0) )
+      if ( (lli2==1.0) ||
+           (lli2==3.0) ||
+           (lli2==5.0) ||
+           (lli2==7.0) )
       {
          tempLLI2 = 1.0;
       }
@@ -339,13 +342,13 @@ namespace gpstk
       {
 
             // We reset the filter with this
-         MWData[sat].windowSize = 1;
+         data.windowSize = 1;
 
          reportCS = true;                // Report cycle slip
       }
 
 
-      if (MWData[sat].windowSize > 1)
+      if (data.windowSize > 1)
       {
 
             // Test for current bias bigger than lambda limit and for
@@ -354,7 +357,7 @@ namespace gpstk
          {
 
                // We reset the filter with this
-            MWData[sat].windowSize = 1;
+            data.windowSize = 1;
 
             reportCS = true;                // Report cycle slip
 
@@ -363,15 +366,15 @@ namespace gpstk
 
          // Let's prepare for the next time
          // If a cycle-slip happened or just starting up
-      if (MWData[sat].windowSize < 2)
+      if (data.windowSize < 2)
       {
-         MWData[sat].meanMW = mw;
+         data.meanMW = mw;
       }
       else
       {
             // Compute average
-         MWData[sat].meanMW += (mw - MWData[sat].meanMW) /
-                               (static_cast<double>(MWData[sat].windowSize));
+         data.meanMW += (mw - data.meanMW) /
+                        (static_cast<double>(data.windowSize));
       }
 
       if (reportCS)
@@ -45,6 +45,7 @@
 #define GPSTK_MWCSDETECTOR_HPP
 
 #include "ProcessingClass.hpp"
+#include "WindowStats.hpp"
 #include <list>
 
 
@@ -295,8 +296,8 @@ namespace gpstk
       };
 
 
-         /// Map holding the information regarding every satellite
-      std::map<SatID, filterData> MWData;
+         /// Table holding the information regarding every satellite
+      SatTable<filterData> MWData;
 
 
          /** Method that implements the Melbourne-Wubbena cycle slip
@@ -279,26 +279,31 @@ namespace gpstk
       double deltaBias(0.0);     // Difference between biases
       double tempLLI(0.0);
 
+         // Look up the data of this satellite only once
+      filterData& data( OneFreqData[sat] );
+
          // Get the difference between current epoch and former epoch,
          // in seconds
-      deltaT = ( epoch - OneFreqData[sat].previousEpoch );
+      deltaT = ( epoch - data.previousEpoch );
 
          // Store current epoch as former epoch
-      OneFreqData[sat].previousEpoch = epoch;
+      data.previousEpoch = epoch;
 
       bias = code - phase;       // Current value of code-phase bias
 
          // Increment window size
-      ++OneFreqData[sat].windowSize;
+      ++data.windowSize;
 
          // Check if receiver already declared cycle slip or too much time
          // has elapsed
-         // Note: If tvMap(lliType) doesn't exist, then 0 will be returned
-         // and that test will pass
-      if ( (tvMap(lliType)==1.0) ||
-           (tvMap(lliType)==3.0) ||
-           (tvMap(lliType)==5.0) ||
-           (tvMap(lliType)==7.0) )
+         // Note: If lliType doesn't exist, then 0 will be used and that
+         // test will pass
+      typeValueMap::const_iterator itLLI( tvMap.find(lliType) );
+      double lli( (itLLI != tvMap.end()) ? (*itLLI).second : 0.0 );
+      if ( (lli==1.0) ||
+           (lli==3.0) ||
+           (lli==5.0) ||
+           (lli==7.0) )
       {
          tempLLI = 1.0;
       }
@@ -308,86 +313,93 @@ namespace gpstk
            (tempLLI==1.0)        ||
            (deltaT > deltaTMax) )
       {
-         OneFreqData[sat].windowSize = 1;
+         data.windowSize = 1;
       }
 
-      if (OneFreqData[sat].windowSize > 1)
+      if (data.windowSize > 1)
       {
 
-         deltaBias = (bias - OneFreqData[sat].meanBias);
+         deltaBias = (bias - data.meanBias);
 
             // Square difference between biases
          dif2 = deltaBias*deltaBias;
 
             // Compute threshold^2
-         thr2 = OneFreqData[sat].variance * maxNumSigmas * maxNumSigmas;
+         thr2 = data.variance * maxNumSigmas * maxNumSigmas;
 
             // If difference in biases is bigger or equal to threshold,
             // then declare cycle slip
          if (dif2 >= thr2)
          {
-            OneFreqData[sat].windowSize = 1;
+            data.windowSize = 1;
          }
          else
          {
                // Update mean bias
-            OneFreqData[sat].meanBias = OneFreqData[sat].meanBias +
-                  deltaBias/(static_cast<double>(OneFreqData[sat].windowSize));
+            data.meanBias = data.meanBias +
+                  deltaBias/(static_cast<double>(data.windowSize));
 
                // Update variance of bias
-            OneFreqData[sat].variance = OneFreqData[sat].variance +
-                           ( (dif2-OneFreqData[sat].variance) ) /
-                           (static_cast<double>(OneFreqData[sat].windowSize));
+            data.variance = data.variance +
+                           ( (dif2-data.variance) ) /
+                           (static_cast<double>(data.windowSize));
 
-               // Update buffers storing values at the end of deques
-            OneFreqData[sat].biasBuffer.push_back(bias);
-            OneFreqData[sat].dif2Buffer.push_back(dif2);
+               // Update buffers storing values at their ends
+            data.biasBuffer.push(data.windowSize, bias);
+            data.dif2Buffer.push(data.windowSize, dif2);
 
                // Check limit of window size
-            if (OneFreqData[sat].windowSize > maxWindowSize)
+            if (data.windowSize > data.maxSize)
             {
 
                   // Correct window size
-               OneFreqData[sat].windowSize = maxWindowSize;
+               data.windowSize = data.maxSize;
 
                   // Correct values of meanBias and variance, because they
-                  // were computed with (maxWindowSize + 1)
+                  // were computed with (maxSize + 1)
 
-                  // First, let's do a cast of 'maxWindowSize'
-               double N((static_cast<double>(maxWindowSize)));
+                  // First, let's do a cast of 'maxSize'
+               double N((static_cast<double>(data.maxSize)));
 
                   // We need to remove the first element
-               OneFreqData[sat].meanBias = ( (N + 1.0)/N ) *
-                  ( OneFreqData[sat].meanBias
-                  - ( OneFreqData[sat].biasBuffer.front()/(N + 1.0) ) );
+               data.meanBias = ( (N + 1.0)/N ) *
+                  ( data.meanBias
+                  - ( data.biasBuffer.front().y/(N + 1.0) ) );
 
-               OneFreqData[sat].variance = ( (N + 1.0)/N ) *
-                  ( OneFreqData[sat].variance
-                  - ( OneFreqData[sat].dif2Buffer.front()/(N + 1.0) ) );
+               data.variance = ( (N + 1.0)/N ) *
+                  ( data.variance
+                  - ( data.dif2Buffer.front().y/(N + 1.0) ) );
 
                   // Finally, remove first elements from buffers (oldest data)
-               OneFreqData[sat].biasBuffer.pop_front();
-               OneFreqData[sat].dif2Buffer.pop_front();
+               data.biasBuffer.pop_front();
+               data.dif2Buffer.pop_front();
 
             }
 
          }
       }
 
-      if (OneFreqData[sat].windowSize <= 1)   // If a cycle-slip happened
+      if (data.windowSize <= 1)   // If a cycle-slip happened
       {
 
-            // If a cycle slip happened, we must clear buffers
-         OneFreqData[sat].biasBuffer.clear();
-         OneFreqData[sat].dif2Buffer.clear();
+            // If a cycle slip happened, we must clear buffers. This is also
+            // when a new value of 'maxWindowSize' takes effect.
+         if (data.maxSize != maxWindowSize)
+         {
+            data.maxSize = maxWindowSize;
+            data.biasBuffer.setCapacity(data.maxSize + 1);
+            data.dif2Buffer.setCapacity(data.maxSize + 1);
+         }
+         data.biasBuffer.clear();
+         data.dif2Buffer.clear();
 
             // Set mean bias to current code-phase bias
-         OneFreqData[sat].meanBias = bias;
-         OneFreqData[sat].biasBuffer.push_back(bias);
+         data.meanBias = bias;
+         data.biasBuffer.push(1.0, bias);
 
             // Set mean variance to default variance
-         OneFreqData[sat].variance = defaultBiasSigma * defaultBiasSigma;
-         OneFreqData[sat].dif2Buffer.push_back(0.0);
+         data.variance = defaultBiasSigma * defaultBiasSigma;
+         data.dif2Buffer.push(1.0, 0.0);
 
             // Report cycle slip
          reportCS = true;
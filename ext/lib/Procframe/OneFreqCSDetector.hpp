@@ -44,8 +44,8 @@
 #ifndef GPSTK_ONEFREQCSDETECTOR_HPP
 #define GPSTK_ONEFREQCSDETECTOR_HPP
 
-#include <deque>
 #include "ProcessingClass.hpp"
+#include "WindowStats.hpp"
 
 
 
@@ -245,6 +245,9 @@ namespace gpstk
          /** Method to set the maximum size of filter window, in samples.
           *
           * @param maxSize       Maximum size of filter window, in samples.
+          *
+          * \note The new size is used for each satellite from the start of
+          * its next arc.
           */
       virtual OneFreqCSDetector& setMaxWindowSize(const int& maxSize);
 
@@ -354,21 +357,25 @@ namespace gpstk
       {
             // Default constructor initializing the data in the structure
          filterData() : previousEpoch(CommonTime::BEGINNING_OF_TIME),
-                        windowSize(0), meanBias(0.0), variance(0.0)
+                        windowSize(0), maxSize(0), meanBias(0.0),
+                        variance(0.0)
          {};
 
          CommonTime previousEpoch;  ///< The previous epoch time stamp.
          int windowSize;         ///< The filter window size.
+         int maxSize;            ///< Maximum window size in this arc.
          double meanBias;        ///< Accumulated mean bias
          double variance;        ///< Accumulated variance of bias.
 
-         std::deque<double> biasBuffer;   ///< Values previous biases.
-         std::deque<double> dif2Buffer;   ///< Values of previous differences^2.
+            /// Values of previous biases, against the window size.
+         WindowStats biasBuffer;
+            /// Values of previous differences^2, against the window size.
+         WindowStats dif2Buffer;
       };
 
 
-         /// Map holding the information regarding every satellite
-      std::map<SatID, filterData> OneFreqData;
+         /// Table holding the information regarding every satellite
+      SatTable<filterData> OneFreqData;
 
 
          /** Returns a satTypeValueMap object, adding the new data generated
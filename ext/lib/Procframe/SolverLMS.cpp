@@ -60,6 +60,7 @@ namespace gpstk
        * code equation.
        */
    SolverLMS::SolverLMS()
+      : computeCovariance(true)
    {
 
          // First, let's define a set with the typical unknowns
@@ -95,8 +96,6 @@ namespace gpstk
          // By default, results are invalid
       valid = false;
 
-      int gCol = static_cast<int>(designMatrix.cols());
-
       int gRow = static_cast<int>(designMatrix.rows());
       int pRow = static_cast<int>(prefitResiduals.size());
       if (!(gRow==pRow))
@@ -106,17 +105,35 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> AT = transpose(designMatrix);
-      covMatrix.resize(gCol, gCol);
-      solution.resize(gCol);
+         // Build AT*A and AT*b in place, without forming
+         // transpose(designMatrix)
+      syrk(covMatrix, designMatrix, 1.0, 0.0, true);
+      gemv(solution, designMatrix, prefitResiduals, 1.0, 0.0, true);
+
+      solveNormalEquations(prefitResiduals, designMatrix);
+
+      return 0;
+
+   }  // End of method 'SolverLMS::Compute()'
+
+
 
-         // Temporary storage for covMatrix. It will be inverted later
-      covMatrix = AT * designMatrix;
+      // Solve the normal equations whose matrix is stored in the lower
+      // triangle of 'covMatrix' and whose independent vector is stored
+      // in 'solution'.
+      //
+      // @param prefitResiduals   Vector of prefit residuals
+      // @param designMatrix      Design matrix for equation system
+      //
+   void SolverLMS::solveNormalEquations( const Vector<double>& prefitResiduals,
+                                         const Matrix<double>& designMatrix )
+      throw(InvalidSolver)
+   {
 
-      // Let's try to invert AT*A   matrix
+         // Let's try to decompose the normal matrix
       try
       {
-         covMatrix = inverseChol( covMatrix );
+         normalDecomp( covMatrix );
       }
       catch(...)
       {
@@ -125,7 +142,13 @@ of designMatrix");
       }
 
          // Now, compute the Vector holding the solution...
-      solution = covMatrix * AT * prefitResiduals;
+      normalDecomp.backSub( solution );
+
+         // ... only if required, its covariance matrix...
+      if (computeCovariance)
+      {
+         normalDecomp.inverse( covMatrix );
+      }
 
          // ... and the postfit residuals Vector
       postfitResiduals = prefitResiduals - designMatrix * solution;
@@ -133,9 +156,7 @@ of designMatrix");
          // If everything is fine so far, then the results should be valid
       valid = true;
 
-      return 0;
-
-   }  // End of method 'SolverLMS::Compute()'
+   }  // End of method 'SolverLMS::solveNormalEquations()'
 
 
 
@@ -248,6 +269,12 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
+      if (!computeCovariance)
+      {
+         InvalidRequest e("Covariance matrix is not being computed.");
+         GPSTK_THROW(e);
+      }
+
 
          // Define counter
       int counter(0);
@@ -141,7 +141,7 @@ namespace gpstk
           * @param eqDef     gnssEquationDefinition to be used
           */
       SolverLMS(const gnssEquationDefinition& eqDef)
-         : defaultEqDef(eqDef)
+         : defaultEqDef(eqDef), computeCovariance(true)
       { };
 
 
@@ -222,6 +222,23 @@ namespace gpstk
       { return defaultEqDef; };
 
 
+         /** Method to set whether the covariance matrix of the solution
+          *  ('covMatrix') is computed. The solution itself is found by
+          *  Cholesky decomposition and back substitution, and the inverse
+          *  of the normal matrix is only formed when this is 'true'
+          *  (the default).
+          *
+          * @param compute   Whether 'covMatrix' will be computed.
+          */
+      virtual SolverLMS& setComputeCovariance(bool compute)
+      { computeCovariance = compute; return (*this); };
+
+
+         /// Method to get whether the covariance matrix is computed.
+      virtual bool getComputeCovariance() const
+      { return computeCovariance; };
+
+
          /// Returns a string identifying this object.
       virtual std::string getClassName(void) const;
 
@@ -239,6 +256,28 @@ namespace gpstk
       gnssEquationDefinition defaultEqDef;
 
 
+         /** Solve the normal equations whose matrix is stored in the lower
+          *  triangle of 'covMatrix' and whose independent vector is stored
+          *  in 'solution', leaving there the solution and, if required, its
+          *  covariance matrix. Postfit residuals are also computed.
+          *
+          * @param prefitResiduals   Vector of prefit residuals
+          * @param designMatrix      Design matrix for the equation system
+          */
+      void solveNormalEquations( const Vector<double>& prefitResiduals,
+                                 const Matrix<double>& designMatrix )
+         throw(InvalidSolver);
+
+
+         /// Whether 'covMatrix' is computed.
+      bool computeCovariance;
+
+
+         /// Cholesky decomposition of the normal matrix, kept to reuse
+         /// its storage from one epoch to the next.
+      LLTDecomp<double> normalDecomp;
+
+
    }; // End of class 'SolverLMS'
 
       //@}
@@ -92,6 +92,11 @@ namespace gpstk
       keepTypeSet.insert(TypeID::CSL1);
       keepTypeSet.insert(TypeID::satArc);
 
+         // Postfit residuals are overwritten by every pass, but keeping
+         // them from the start reserves their room in 'ObsData'
+      keepTypeSet.insert(TypeID::postfitC);
+      keepTypeSet.insert(TypeID::postfitL);
+
 
    }  // End of 'SolverPPPFB::SolverPPPFB()'
 
@@ -208,14 +213,17 @@ namespace gpstk
       try
       {
 
-         std::list<gnssRinex>::iterator pos;
-         std::list<gnssRinex>::reverse_iterator rpos;
+            // Epochs are read from 'ObsData', processed and written back
+         gnssRinex gRin;
+         size_t numEpochs( ObsData.size() );
 
             // Backwards iteration. We must do this at least once
-         for (rpos = ObsData.rbegin(); rpos != ObsData.rend(); ++rpos)
+         for (size_t k = numEpochs; k > 0; --k)
          {
 
-            SolverPPP::Process( (*rpos) );
+            ObsData.get(k-1, gRin);
+            SolverPPP::Process(gRin);
+            ObsData.update(k-1, gRin);
 
          }
 
@@ -224,15 +232,19 @@ namespace gpstk
          {
 
                // Forwards iteration
-            for (pos = ObsData.begin(); pos != ObsData.end(); ++pos)
+            for (size_t k = 0; k < numEpochs; ++k)
             {
-               SolverPPP::Process( (*pos) );
+               ObsData.get(k, gRin);
+               SolverPPP::Process(gRin);
+               ObsData.update(k, gRin);
             }
 
                // Backwards iteration.
-            for (rpos = ObsData.rbegin(); rpos != ObsData.rend(); ++rpos)
+            for (size_t k = numEpochs; k > 0; --k)
             {
-               SolverPPP::Process( (*rpos) );
+               ObsData.get(k-1, gRin);
+               SolverPPP::Process(gRin);
+               ObsData.update(k-1, gRin);
             }
 
          }  // End of 'for (int i=0; i<(cycles-1), i++)'
@@ -279,14 +291,17 @@ namespace gpstk
       try
       {
 
-         std::list<gnssRinex>::iterator pos;
-         std::list<gnssRinex>::reverse_iterator rpos;
+            // Epochs are read from 'ObsData', processed and written back
+         gnssRinex gRin;
+         size_t numEpochs( ObsData.size() );
 
             // Backwards iteration. We must do this at least once
-         for (rpos = ObsData.rbegin(); rpos != ObsData.rend(); ++rpos)
+         for (size_t k = numEpochs; k > 0; --k)
          {
 
-            SolverPPP::Process( (*rpos) );
+            ObsData.get(k-1, gRin);
+            SolverPPP::Process(gRin);
+            ObsData.update(k-1, gRin);
 
          }
 
@@ -325,23 +340,31 @@ namespace gpstk
 
 
                // Forwards iteration
-            for (pos = ObsData.begin(); pos != ObsData.end(); ++pos)
+            for (size_t k = 0; k < numEpochs; ++k)
             {
+               ObsData.get(k, gRin);
+
                   // Let's check limits
-               checkLimits( (*pos), codeLimit, phaseLimit );
+               checkLimits( gRin, codeLimit, phaseLimit );
 
                   // Process data
-               SolverPPP::Process( (*pos) );
+               SolverPPP::Process(gRin);
+
+               ObsData.update(k, gRin);
             }
 
                // Backwards iteration.
-            for (rpos = ObsData.rbegin(); rpos != ObsData.rend(); ++rpos)
+            for (size_t k = numEpochs; k > 0; --k)
             {
+               ObsData.get(k-1, gRin);
+
                   // Let's check limits
-               checkLimits( (*rpos), codeLimit, phaseLimit );
+               checkLimits( gRin, codeLimit, phaseLimit );
 
                   // Process data
-               SolverPPP::Process( (*rpos) );
+               SolverPPP::Process(gRin);
+
+               ObsData.update(k-1, gRin);
             }
 
          }  // End of 'for (int i=0; i<(cycles-1), i++)'
@@ -428,7 +451,8 @@ namespace gpstk
 
                // Get the first data epoch in 'ObsData' and process it. The
                // result will be stored in 'gData'
-            gData = SolverPPP::Process( ObsData.front() );
+            ObsData.get(0, gData);
+            SolverPPP::Process(gData);
 
                // Remove the first data epoch in 'ObsData', freeing some
                // memory and preparing for next epoch
@@ -549,6 +573,11 @@ namespace gpstk
       keepTypeSet.insert(TypeID::CSL1);
       keepTypeSet.insert(TypeID::satArc);
 
+         // Postfit residuals are overwritten by every pass, but keeping
+         // them from the start reserves their room in 'ObsData'
+      keepTypeSet.insert(TypeID::postfitC);
+      keepTypeSet.insert(TypeID::postfitL);
+
 
          // Return this object
       return (*this);
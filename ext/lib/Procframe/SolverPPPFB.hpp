@@ -44,6 +44,7 @@
 #define GPSTK_SOLVERPPPFB_HPP
 
 #include "SolverPPP.hpp"
+#include "EpochLog.hpp"
 #include <list>
 #include <set>
 
@@ -87,6 +88,11 @@ namespace gpstk
        *        done in forwards mode. During this phase you will get your
        *        final results.
        *
+       * The stored data are only the types the filter needs, packed in an
+       * "EpochLog.hpp" object. When they grow beyond the spill size (see
+       * setSpillSize()), they are moved to a memory-mapped temporary file,
+       * so that multi-day sessions do not need to fit in memory.
+       *
        * Take due note that the "SolverPPPFB.hpp" class is designed to be used
        * ONLY with GNSS data structure objects from "DataStructures" class.
        *
@@ -438,6 +444,32 @@ namespace gpstk
       { return rejectedMeasurements; };
 
 
+         /// Returns the size (in bytes) beyond which the stored epochs are
+         /// moved to a memory-mapped temporary file.
+      virtual size_t getSpillSize(void) const
+      { return ObsData.getSpillSize(); };
+
+
+         /** Sets the size (in bytes) beyond which the stored epochs are
+          *  moved to a memory-mapped temporary file (256 MB by default).
+          *  Zero keeps them in memory.
+          *
+          * @param bytes   Spill size, in bytes.
+          */
+      virtual SolverPPPFB& setSpillSize( size_t bytes )
+      { ObsData.setSpillSize(bytes); return (*this); };
+
+
+         /** Sets the directory where the temporary file of stored epochs is
+          *  created. By default, it is given by the TMPDIR environment
+          *  variable, or "/tmp".
+          *
+          * @param dir     Directory for the temporary file.
+          */
+      virtual SolverPPPFB& setSpillDirectory( const std::string& dir )
+      { ObsData.setSpillDirectory(dir); return (*this); };
+
+
          /** Sets if a NEU system will be used.
           *
           * @param useNEU  Boolean value indicating if a NEU system will
@@ -462,8 +494,8 @@ namespace gpstk
       bool firstIteration;
 
 
-         /// List holding the information regarding every observation.
-      std::list<gnssRinex> ObsData;
+         /// Log holding the information regarding every observation.
+      EpochLog ObsData;
 
 
          /// Set storing the TypeID's that we want to keep.
@@ -121,17 +121,46 @@ of weightVector");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> wMatrix(wSize,wSize,0.0);  // Declare a weight matrix
+      int gCol = static_cast<int>(designMatrix.cols());
 
-         // Fill the weight matrix diagonal with the content of 
-         // the weight vector
-      for (int i=0; i<wSize; i++)
+      int gRow = static_cast<int>(designMatrix.rows());
+      if (!(gRow==pSize))
       {
-         wMatrix(i,i) = weightVector(i);
+         InvalidSolver e("prefitResiduals size does not match dimension \
+of designMatrix");
+         GPSTK_THROW(e);
+      }
+
+      covMatrix.resize(gCol, gCol);
+      solution.resize(gCol);
+
+         // The weight matrix is diagonal, so the lower triangle of AT*W*A
+         // and the vector AT*W*b are built directly from the weight vector
+      for (int j=0; j<gCol; j++)
+      {
+         double sum(0.0);
+         for (int k=0; k<gRow; k++)
+         {
+            sum += designMatrix(k,j) * weightVector(k) * prefitResiduals(k);
+         }
+         solution(j) = sum;
+
+         for (int i=j; i<gCol; i++)
+         {
+            sum = 0.0;
+            for (int k=0; k<gRow; k++)
+            {
+               sum += designMatrix(k,i) * weightVector(k) * designMatrix(k,j);
+            }
+            covMatrix(i,j) = sum;
+         }
       }
 
-         // Call the more general SolverWMS::Compute() method
-      return SolverWMS::Compute(prefitResiduals, designMatrix, wMatrix);
+      solveNormalEquations(prefitResiduals, designMatrix);
+
+      computeCovNoWeight(designMatrix);
+
+      return 0;
 
    }  // End of method 'SolverWMS::Compute()'
 
@@ -182,49 +211,91 @@ of designMatrix");
          GPSTK_THROW(e);
       }
 
-      Matrix<double> AT = transpose(designMatrix);
       covMatrix.resize(gCol, gCol);
-      covMatrixNoWeight.resize(gCol, gCol);
       solution.resize(gCol);
 
-         // Temporary storage for covMatrix. It will be inverted later
-      covMatrix = AT * weightMatrix * designMatrix;
+         // W*A, so that AT*W*A and AT*W*b need no further temporaries
+      Matrix<double> WA( weightMatrix * designMatrix );
 
-         // Let's try to invert AT*W*A  matrix
-      try { 
-         covMatrix = inverseChol( covMatrix );
+         // Lower triangle of AT*W*A, and AT*W*b
+      for (int j=0; j<gCol; j++)
+      {
+         double sum(0.0);
+         for (int k=0; k<gRow; k++)
+         {
+            sum += WA(k,j) * prefitResiduals(k);
+         }
+         solution(j) = sum;
+
+         for (int i=j; i<gCol; i++)
+         {
+            sum = 0.0;
+            for (int k=0; k<gRow; k++)
+            {
+               sum += designMatrix(k,i) * WA(k,j);
+            }
+            covMatrix(i,j) = sum;
+         }
       }
-      catch(...)
+
+      solveNormalEquations(prefitResiduals, designMatrix);
+
+      computeCovNoWeight(designMatrix);
+
+      return 0;
+
+   }  // End of method 'SolverWMS::Compute()'
+
+
+
+      // Compute 'covMatrixNoWeight', inverse(AT*A), if covariance
+      // output is required.
+      //
+      // @param designMatrix      Design matrix for equation system
+      //
+   void SolverWMS::computeCovNoWeight(const Matrix<double>& designMatrix)
+      throw(InvalidSolver)
+   {
+
+      if (!computeCovariance)
       {
-         InvalidSolver e("Unable to invert matrix covMatrix");
-         GPSTK_THROW(e);
+         return;
       }
 
-         // Temporary storage for covMatrixNoWeight. It will be inverted later
-      covMatrixNoWeight = AT * designMatrix;
+      int gCol = static_cast<int>(designMatrix.cols());
+      int gRow = static_cast<int>(designMatrix.rows());
+
+      covMatrixNoWeight.resize(gCol, gCol);
+
+         // Lower triangle of AT*A
+      for (int j=0; j<gCol; j++)
+      {
+         for (int i=j; i<gCol; i++)
+         {
+            double sum(0.0);
+            for (int k=0; k<gRow; k++)
+            {
+               sum += designMatrix(k,i) * designMatrix(k,j);
+            }
+            covMatrixNoWeight(i,j) = sum;
+         }
+      }
 
          // Let's try to invert AT*A  matrix
-      try { 
-         covMatrixNoWeight = inverseChol( covMatrixNoWeight );
+      try
+      {
+         normalDecomp( covMatrixNoWeight );
       }
       catch(...)
       {
+         valid = false;
          InvalidSolver e("Unable to invert matrix covMatrixNoWeight");
          GPSTK_THROW(e);
       }
 
-         // Now, compute the Vector holding the solution...
-      solution = covMatrix * AT * weightMatrix * prefitResiduals;
-
-         // ... and the postfit residuals Vector
-      postfitResiduals = prefitResiduals - designMatrix * solution;
-
-         // If everything is fine so far, then the results should be valid
-      valid = true;
+      normalDecomp.inverse( covMatrixNoWeight );
 
-      return 0;
-
-   }  // End of method 'SolverWMS::Compute()'
+   }  // End of method 'SolverWMS::computeCovNoWeight()'
 
 
 
@@ -215,6 +215,18 @@ namespace gpstk
       virtual ~SolverWMS() {};
 
 
+   protected:
+
+
+         /** Compute 'covMatrixNoWeight' from the design matrix, if
+          *  covariance output is required.
+          *
+          * @param designMatrix      Design matrix for the equation system
+          */
+      void computeCovNoWeight(const Matrix<double>& designMatrix)
+         throw(InvalidSolver);
+
+
    }; // End of class 'SolverWMS'
 
       //@}
@@ -0,0 +1,340 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file WindowStats.cpp
+ * Sliding window statistics (running mean and variance, least squares
+ * polynomial fit) kept in fixed-size ring buffers, and a table of data
+ * indexed by satellite, for the cycle slip detectors.
+ */
+
+#include "WindowStats.hpp"
+#include <cmath>
+
+
+namespace gpstk
+{
+
+
+      // Common constructor.
+   WindowStats::WindowStats(size_t n)
+      : buffer(n)
+   {
+      clear();
+   }
+
+
+      // Sets the capacity of the window, and clears it.
+   WindowStats& WindowStats::setCapacity(size_t n)
+   {
+      buffer.resize(n);
+      clear();
+
+      return (*this);
+   }
+
+
+      // Removes all the samples.
+   void WindowStats::clear(void)
+   {
+      first = count = 0;
+      t0 = y0 = 0.0;
+      rebase();
+   }
+
+
+      // Adds (sign 1) or removes (sign -1) a sample from the sums.
+   void WindowStats::accumulate(const Sample& s, double sign)
+   {
+      double dt(s.t - t0), dy(s.y - y0), p(sign);
+
+      for (int k = 0; k < 5; k++)
+      {
+         st[k] += p;
+         if (k < 3)
+         {
+            sty[k] += p*dy;
+         }
+         p *= dt;
+      }
+      syy += sign*dy*dy;
+   }
+
+
+      // Recomputes the sums about the oldest sample.
+   void WindowStats::rebase(void)
+   {
+      syy = 0.0;
+      for (int k = 0; k < 5; k++)
+      {
+         st[k] = 0.0;
+      }
+      sty[0] = sty[1] = sty[2] = 0.0;
+      updates = 0;
+
+      if (count == 0)
+      {
+         return;
+      }
+
+      t0 = front().t;
+      y0 = front().y;
+      for (size_t i = 0; i < count; i++)
+      {
+         accumulate((*this)[i], 1.0);
+      }
+   }
+
+
+      // Adds a sample at the end of the window.
+   void WindowStats::push(double t, double y)
+   {
+      if (buffer.empty())
+      {
+         return;
+      }
+
+      if (count == buffer.size())
+      {
+         pop_front();
+      }
+
+      Sample s;
+      s.t = t;
+      s.y = y;
+
+      if (count == 0)
+      {
+         t0 = t;
+         y0 = y;
+      }
+
+      size_t j(first + count);
+      buffer[ j < buffer.size() ? j : j - buffer.size() ] = s;
+      ++count;
+      accumulate(s, 1.0);
+
+         // Every 'capacity' samples, the sums are computed again about the
+         // oldest sample, so that the rounding errors do not pile up and
+         // the powers of (t - t0) stay small.
+      if (++updates >= buffer.size())
+      {
+         rebase();
+      }
+   }
+
+
+      // Removes the oldest sample.
+   void WindowStats::pop_front(void)
+   {
+      if (count == 0)
+      {
+         return;
+      }
+
+      accumulate(buffer[first], -1.0);
+      if (++first == buffer.size())
+      {
+         first = 0;
+      }
+      if (--count == 0)
+      {
+         clear();
+      }
+   }
+
+
+      // Returns the mean of y over the window.
+   double WindowStats::mean(void) const
+   {
+      if (count == 0)
+      {
+         return 0.0;
+      }
+
+      return (y0 + sty[0]/double(count));
+   }
+
+
+      // Returns the variance of y over the window.
+   double WindowStats::variance(void) const
+   {
+      if (count == 0)
+      {
+         return 0.0;
+      }
+
+      double m(sty[0]/double(count));
+      double v(syy/double(count) - m*m);
+
+      return (v > 0.0 ? v : 0.0);
+   }
+
+
+      // Least squares fit of a polynomial y(t) to the samples, solving the
+      // normal equations (at most 3x3) by Cholesky decomposition. They are
+      // scaled to a unit diagonal first, so that a pivot may be compared
+      // with one to tell a singular system.
+   bool WindowStats::fit(unsigned degree, WindowFit& f) const
+   {
+      if (degree > 2 || count < degree + 1)
+      {
+         return false;
+      }
+
+      const int n(degree + 1);
+      double N[3][3], b[3], s[3];
+
+      for (int i = 0; i < n; i++)
+      {
+         s[i] = 1.0/std::sqrt(st[2*i]);
+      }
+      for (int i = 0; i < n; i++)
+      {
+         b[i] = sty[i]*s[i];
+         for (int j = 0; j < n; j++)
+         {
+            N[i][j] = st[i+j]*s[i]*s[j];
+         }
+      }
+
+         // N = L*L^T, L stored in the lower triangle of N
+      for (int j = 0; j < n; j++)
+      {
+         double d(N[j][j]);
+         for (int k = 0; k < j; k++)
+         {
+            d -= N[j][k]*N[j][k];
+         }
+         if (!(d > 1.0e-12))
+         {
+            return false;
+         }
+         N[j][j] = std::sqrt(d);
+         for (int i = j+1; i < n; i++)
+         {
+            double x(N[i][j]);
+            for (int k = 0; k < j; k++)
+            {
+               x -= N[i][k]*N[j][k];
+            }
+            N[i][j] = x/N[j][j];
+         }
+      }
+
+         // L*z = b, then L^T*x = z
+      for (int i = 0; i < n; i++)
+      {
+         for (int k = 0; k < i; k++)
+         {
+            b[i] -= N[i][k]*b[k];
+         }
+         b[i] /= N[i][i];
+      }
+      for (int i = n-1; i >= 0; i--)
+      {
+         for (int k = i+1; k < n; k++)
+         {
+            b[i] -= N[k][i]*b[k];
+         }
+         b[i] /= N[i][i];
+      }
+
+      f.t0 = t0;
+      f.degree = degree;
+      f.a[0] = f.a[1] = f.a[2] = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+         f.a[i] = b[i]*s[i];
+      }
+      f.a[0] += y0;
+
+      return true;
+   }
+
+
+      // Returns the largest absolute difference between the samples and
+      // the polynomial 'f'.
+   double WindowStats::maxResidual(const WindowFit& f) const
+   {
+      double maxRes(0.0);
+      for (size_t i = 0; i < count; i++)
+      {
+         const Sample& s((*this)[i]);
+         double r(std::fabs(s.y - f(s.t)));
+         if (r > maxRes)
+         {
+            maxRes = r;
+         }
+      }
+
+      return maxRes;
+   }
+
+
+
+      // Default constructor.
+   SatOrdinal::SatOrdinal()
+      : table((SatID::systemUnknown + 1)*256, 0), numSats(0)
+   {}
+
+
+      // Returns the ordinal of 'sat', giving it a new one if needed.
+   size_t SatOrdinal::operator()(const SatID& sat)
+   {
+      if (sat.id >= 0 && sat.id < 256 &&
+          sat.system >= 0 && sat.system <= SatID::systemUnknown)
+      {
+         size_t& entry( table[sat.system*256 + sat.id] );
+         if (entry == 0)
+         {
+            entry = ++numSats;
+         }
+         return (entry - 1);
+      }
+
+      std::map<SatID, size_t>::const_iterator it(others.find(sat));
+      if (it != others.end())
+      {
+         return it->second;
+      }
+
+      others[sat] = numSats;
+      return (numSats++);
+   }
+
+
+}  // End of namespace gpstk
@@ -0,0 +1,315 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//=============================================================================
+
+/**
+ * @file WindowStats.hpp
+ * Sliding window statistics (running mean and variance, least squares
+ * polynomial fit) kept in fixed-size ring buffers, and a table of data
+ * indexed by satellite, for the cycle slip detectors.
+ */
+
+#ifndef GPSTK_WINDOWSTATS_HPP
+#define GPSTK_WINDOWSTATS_HPP
+
+#include "SatID.hpp"
+#include <vector>
+#include <map>
+
+
+namespace gpstk
+{
+
+      /// @ingroup GPSsolutions
+      //@{
+
+
+      /// Polynomial fitted by WindowStats::fit(), in powers of (t - t0).
+   struct WindowFit
+   {
+         /// Default constructor: the zero polynomial.
+      WindowFit() : t0(0.0), degree(0)
+      { a[0] = a[1] = a[2] = 0.0; };
+
+
+         /// Returns the value of the polynomial at 't'.
+      double operator()(double t) const
+      {
+         double dt(t - t0), value(a[degree]);
+         for (int i = int(degree)-1; i >= 0; --i)
+         {
+            value = value*dt + a[i];
+         }
+         return value;
+      };
+
+
+      double t0;        ///< Origin of the polynomial.
+      unsigned degree;  ///< Degree, 0 to 2.
+      double a[3];      ///< Coefficients, constant term first.
+   };
+
+
+      /** This class keeps the last samples (t, y) of a series in a ring
+       *  buffer of fixed capacity, together with the sums needed for the
+       *  mean and variance of y and for the least squares fit of a
+       *  polynomial y(t) of degree up to 2. Adding a sample (and dropping
+       *  the oldest one) updates the sums in constant time, so the
+       *  statistics do not have to be computed again over the window at
+       *  each epoch.
+       *
+       * The sums are taken about the oldest sample in the window. Every
+       * 'capacity' samples they are recomputed from the buffer, which
+       * moves that origin and throws away the rounding errors of the
+       * updates.
+       *
+       * @code
+       *   WindowStats window(12);
+       *   WindowFit fit;
+       *
+       *   if( window.size() >= 5 && window.fit(2, fit) )
+       *   {
+       *      double predicted( fit(t) );
+       *      double noise( window.maxResidual(fit) );
+       *      ...
+       *   }
+       *   window.push(t, y);
+       * @endcode
+       */
+   class WindowStats
+   {
+   public:
+
+         /// One sample of the series.
+      struct Sample
+      {
+         double t;
+         double y;
+      };
+
+
+         /** Common constructor.
+          *
+          * @param n    Capacity of the window, in samples.
+          */
+      WindowStats(size_t n = 0);
+
+
+         /// Sets the capacity of the window, and clears it.
+      WindowStats& setCapacity(size_t n);
+
+
+         /// Returns the capacity of the window.
+      size_t capacity(void) const
+      { return buffer.size(); };
+
+
+         /// Returns the number of samples in the window.
+      size_t size(void) const
+      { return count; };
+
+
+         /// Returns true if there are no samples in the window.
+      bool empty(void) const
+      { return (count == 0); };
+
+
+         /// Removes all the samples.
+      void clear(void);
+
+
+         /// Adds a sample at the end of the window, dropping the oldest
+         /// one if the window is full.
+      void push(double t, double y);
+
+
+         /// Removes the oldest sample.
+      void pop_front(void);
+
+
+         /// Returns the oldest sample.
+      const Sample& front(void) const
+      { return buffer[first]; };
+
+
+         /// Returns the newest sample.
+      const Sample& back(void) const
+      { return (*this)[count-1]; };
+
+
+         /// Returns sample 'i', counting from zero at the oldest one.
+      const Sample& operator[](size_t i) const
+      {
+         size_t j(first + i);
+         return buffer[ j < buffer.size() ? j : j - buffer.size() ];
+      };
+
+
+         /// Returns the mean of y over the window.
+      double mean(void) const;
+
+
+         /// Returns the variance of y over the window (the mean of the
+         /// squared deviations from the mean).
+      double variance(void) const;
+
+
+         /** Least squares fit of a polynomial y(t) to the samples.
+          *
+          * @param degree   Degree of the polynomial, 0 to 2.
+          * @param f        Fitted polynomial.
+          *
+          * @return false if there are not enough samples, or if they do
+          *         not determine the polynomial.
+          */
+      bool fit(unsigned degree, WindowFit& f) const;
+
+
+         /// Returns the largest absolute difference between the samples
+         /// and the polynomial 'f'.
+      double maxResidual(const WindowFit& f) const;
+
+
+   private:
+
+
+         /// Ring buffer of samples.
+      std::vector<Sample> buffer;
+
+
+         /// Position of the oldest sample, and number of samples.
+      size_t first, count;
+
+
+         /// Origins of the sums.
+      double t0, y0;
+
+
+         /// Sums of (t-t0)^k, k = 0..4, of (t-t0)^k*(y-y0), k = 0..2,
+         /// and of (y-y0)^2.
+      double st[5], sty[3], syy;
+
+
+         /// Samples added since the sums were last recomputed.
+      size_t updates;
+
+
+         /// Adds (sign 1) or removes (sign -1) a sample from the sums.
+      void accumulate(const Sample& s, double sign);
+
+
+         /// Recomputes the sums about the oldest sample.
+      void rebase(void);
+
+
+   }; // End of class 'WindowStats'
+
+
+
+      /** This class maps each SatID to a small ordinal number, given in the
+       *  order the satellites are first seen. The usual identifiers (0 to
+       *  255 in each system) are looked up in a table, the others in a map.
+       */
+   class SatOrdinal
+   {
+   public:
+
+         /// Default constructor.
+      SatOrdinal();
+
+
+         /// Returns the ordinal of 'sat', giving it a new one if needed.
+      size_t operator()(const SatID& sat);
+
+
+         /// Returns the number of satellites seen.
+      size_t size(void) const
+      { return numSats; };
+
+
+   private:
+
+         /// Ordinal + 1 of (system, id), or 0 if not yet seen.
+      std::vector<size_t> table;
+
+         /// Ordinals of the satellites outside the table.
+      std::map<SatID, size_t> others;
+
+         /// Number of satellites seen.
+      size_t numSats;
+
+   }; // End of class 'SatOrdinal'
+
+
+
+      /** This class holds one T per satellite, in a vector indexed by the
+       *  satellite ordinal. It is used as a std::map<SatID, T>, but finding
+       *  the data of a satellite is a table look up.
+       */
+   template <class T>
+   class SatTable
+   {
+   public:
+
+         /// Returns the data of 'sat', default constructed the first time.
+         /// The reference is valid until a new satellite is added.
+      T& operator[](const SatID& sat)
+      {
+         size_t i( ordinal(sat) );
+         if (i >= data.size())
+         {
+            data.resize(i+1);
+         }
+         return data[i];
+      };
+
+
+         /// Returns the number of satellites in the table.
+      size_t size(void) const
+      { return data.size(); };
+
+
+   private:
+
+      SatOrdinal ordinal;
+      std::vector<T> data;
+
+   }; // End of class 'SatTable'
+
+      //@}
+
+}  // End of namespace gpstk
+
+#endif   // GPSTK_WINDOWSTATS_HPP
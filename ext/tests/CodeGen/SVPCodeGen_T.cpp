@@ -0,0 +1,248 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/CodeGen/SVPCodeGen. The six seconds
+*  of P-code of all 37 PRNs are generated together, in several
+*  threads, and compared word by word with the ones given by a loop
+*  over X1Sequence::operator[] and X2Sequence::operator[], at the
+*  beginning of the week, in the middle of the week and at the end of
+*  the week. The Z-counts generated per second by the loop, by
+*  SVPCodeGen and by the threads are printed.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <ctime>
+
+#include "SVPCodeGen.hpp"
+#include "GPSWeekZcount.hpp"
+#include "SystemTime.hpp"
+#include "StringUtils.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+class SVPCodeGen_T
+{
+public:
+   SVPCodeGen_T()
+   {
+      X1Sequence::allocateMemory();
+      X2Sequence::allocateMemory();
+   }
+
+   ~SVPCodeGen_T()
+   {
+      X1Sequence::deAllocateMemory();
+      X2Sequence::deAllocateMemory();
+   }
+
+      /** Six seconds of code of 'prn' starting at 'zcount', one word at
+       *  a time, as SVPCodeGen used to do it.
+       */
+   void referenceSixSeconds(int prn, long week, long zcount, CodeBuffer& pcb)
+   {
+      X1Sequence X1Seq;
+      X2Sequence X2Seq;
+      CommonTime t(GPSWeekZcount(week, zcount));
+
+      int dayAdvance = (prn - 1) / 37;
+      int EffPRNID = prn - dayAdvance * 37;
+      long X1count = GPSWeekZcount(t + dayAdvance*86400.0).zcount;
+      long X2count;
+      if (X1count==0 && prn <= 37) X2count = -prn;
+      else
+      {
+         X2count = MAX_X2_TEST - (X1count * X2A_EPOCH_DELAY + EffPRNID);
+         if (X2count<0) X2count += MAX_X2_TEST;
+      }
+      X2Seq.setEOWX2Epoch(X1count==403200-4);
+
+      for (long i=0;i<NUM_6SEC_WORDS;++i)
+      {
+         pcb[i] = X1Seq[i] ^ X2Seq[X2count];
+         X2count += MAX_BIT;
+         if (X2count>=MAX_X2_TEST) X2count -= MAX_X2_TEST;
+      }
+   }
+
+   unsigned constellationTest();
+   unsigned speedTest();
+};
+
+
+unsigned SVPCodeGen_T::constellationTest()
+{
+   TUDEF("SVPCodeGen", "getCurrentSixSeconds");
+
+   const int numPRN(37);
+   const long week(1233);
+   const long zcounts[] = { 0, 4, 201600, 403200-8, 403200-4 };
+
+   vector<SVPCodeGen*> gens;
+   vector<CodeBuffer*> pcbs;
+   for (int prn = 1; prn <= numPRN; prn++)
+   {
+      gens.push_back(new SVPCodeGen(prn, GPSWeekZcount(week, 0)));
+      pcbs.push_back(new CodeBuffer(prn));
+   }
+   CodeBuffer ref(0);
+
+   for (size_t z = 0; z < sizeof(zcounts)/sizeof(zcounts[0]); z++)
+   {
+      for (int i = 0; i < numPRN; i++)
+      {
+         gens[i]->setCurrentZCount(GPSZcount(week, zcounts[z]));
+      }
+      SVPCodeGen::getCurrentSixSeconds(gens, pcbs, 3);
+
+      int differences(0);
+      for (int i = 0; i < numPRN; i++)
+      {
+         referenceSixSeconds(i+1, week, zcounts[z], ref);
+         for (long w = 0; w < NUM_6SEC_WORDS; w++)
+         {
+            differences += ((*pcbs[i])[w] != ref[w]);
+         }
+      }
+      testFramework.assert(differences == 0,
+                           "code differs at Z-count "
+                           + StringUtils::asString(zcounts[z]), __LINE__);
+   }
+
+      // The PRNs beyond 37 are the ones of the following days
+   SVPCodeGen gen(40, GPSWeekZcount(week, 1000));
+   gen.getCurrentSixSeconds(*pcbs[0]);
+   referenceSixSeconds(40, week, 1000, ref);
+   int differences(0);
+   for (long w = 0; w < NUM_6SEC_WORDS; w++)
+   {
+      differences += ((*pcbs[0])[w] != ref[w]);
+   }
+   TUASSERTE(int, 0, differences);
+
+   CodeBuffer* last(pcbs.back());
+   pcbs.pop_back();
+   try
+   {
+      SVPCodeGen::getCurrentSixSeconds(gens, pcbs);
+      TUFAIL("Generated code without a buffer for every satellite");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("getCurrentSixSeconds");
+   }
+   pcbs.push_back(last);
+
+   for (int i = 0; i < numPRN; i++)
+   {
+      delete gens[i];
+      delete pcbs[i];
+   }
+
+   TURETURN();
+}
+
+
+unsigned SVPCodeGen_T::speedTest()
+{
+   TUDEF("SVPCodeGen", "speed");
+
+   const int numPRN(37);
+   const long week(1233), zcount(100000);
+
+   vector<SVPCodeGen*> gens;
+   vector<CodeBuffer*> pcbs;
+   for (int prn = 1; prn <= numPRN; prn++)
+   {
+      gens.push_back(new SVPCodeGen(prn, GPSWeekZcount(week, zcount)));
+      pcbs.push_back(new CodeBuffer(prn));
+   }
+
+      // Each buffer holds four Z-counts
+   clock_t ticks = clock();
+   for (int i = 0; i < numPRN; i++)
+   {
+      referenceSixSeconds(i+1, week, zcount, *pcbs[i]);
+   }
+   double loopRate = 4.0*numPRN / (double(clock()-ticks)/CLOCKS_PER_SEC);
+
+   ticks = clock();
+   for (int i = 0; i < numPRN; i++)
+   {
+      gens[i]->getCurrentSixSeconds(*pcbs[i]);
+   }
+   double genRate = 4.0*numPRN / (double(clock()-ticks)/CLOCKS_PER_SEC);
+
+   CommonTime start(SystemTime().convertToCommonTime());
+   SVPCodeGen::getCurrentSixSeconds(gens, pcbs);
+   double seconds = SystemTime().convertToCommonTime() - start;
+   double threadRate = 4.0*numPRN / seconds;
+
+   cout << fixed << setprecision(0)
+        << "Z-counts per second, word loop: " << loopRate
+        << ", SVPCodeGen: " << genRate
+        << ", all threads: " << threadRate << endl;
+
+   TUASSERT(genRate > 0.0);
+
+   for (int i = 0; i < numPRN; i++)
+   {
+      delete gens[i];
+      delete pcbs[i];
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SVPCodeGen_T testClass;
+
+   errorTotal += testClass.constellationTest();
+   errorTotal += testClass.speedTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,246 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/Geodyn/ConstellationPropagator.
+*  The satellites of a small constellation are propagated together
+*  (with one and with several threads) and one by one with their own
+*  SatOrbitPropagator, and the states are compared. The Earth
+*  orientation parameters are read from a synthetic IERS file written
+*  by the test itself.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+#include <cmath>
+
+#include "ConstellationPropagator.hpp"
+#include "ReferenceFrames.hpp"
+#include "IERS.hpp"
+#include "SystemTime.hpp"
+
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+class ConstellationPropagator_T
+{
+public:
+   ConstellationPropagator_T()
+      : utc0(2010,1,10,0,0,0.0), numSats(8), degree(8), tf(3600.0)
+   {}
+
+      /// Write a finals file with slowly varying pole and UT1-UTC
+   void writeEOPFile(const string& fileName)
+   {
+      ofstream out(fileName.c_str());
+      for (int mjd = 55180; mjd < 55230; mjd++)
+      {
+         string line(80, ' ');
+         char buf[32];
+         sprintf(buf, "%8.2f", double(mjd));
+         line.replace(7, 8, buf);
+         sprintf(buf, "%9.6f", 0.05 + 0.001*(mjd-55180));
+         line.replace(18, 9, buf);
+         sprintf(buf, "%9.6f", 0.3 - 0.002*(mjd-55180));
+         line.replace(37, 9, buf);
+         sprintf(buf, "%10.7f", 0.1 - 0.0005*(mjd-55180));
+         line.replace(58, 10, buf);
+         out << line << endl;
+      }
+   }
+
+      /// Initial J2000 state of satellite k, on circular GPS-like orbits
+   Vector<double> initialState(int k)
+   {
+      const double a = 26560.0e3;
+      const double v = std::sqrt(3.986004418e14/a);
+      const double pi = 4.0*std::atan(1.0);
+      double raan = (k%6)*pi/3.0;
+      double u = (k/6)*pi/2.0 + 0.1*k;
+      double inc = 55.0*pi/180.0;
+
+      double cu(std::cos(u)), su(std::sin(u));
+      double co(std::cos(raan)), so(std::sin(raan));
+      double ci(std::cos(inc)), si(std::sin(inc));
+
+      Vector<double> rv(6);
+      rv(0) = a*(co*cu - so*su*ci);
+      rv(1) = a*(so*cu + co*su*ci);
+      rv(2) = a*su*si;
+      rv(3) = v*(-co*su - so*cu*ci);
+      rv(4) = v*(-so*su + co*cu*ci);
+      rv(5) = v*cu*si;
+      return rv;
+   }
+
+   unsigned propagateTest();
+   unsigned requestTest();
+
+   UTCTime utc0;
+   int numSats, degree;
+   double tf;
+};
+
+
+unsigned ConstellationPropagator_T::propagateTest()
+{
+   TUDEF("ConstellationPropagator", "integrateTo");
+
+   string eopFile = getPathTestTemp() + getFileSep()
+      + "ConstellationPropagator_T_finals.txt";
+   writeEOPFile(eopFile);
+   IERS::loadIERSFile(eopFile);
+
+      // Reference: every satellite on its own, without the epoch cache
+   vector< Vector<double> > expected;
+   CommonTime start(SystemTime().convertToCommonTime());
+   for (int k = 0; k < numSats; k++)
+   {
+      SatOrbitPropagator prop;
+      prop.setStepSize(60.0);
+      prop.setInitState(utc0, initialState(k));
+      prop.getSatOrbitPointer()->enableGeopotential(SatOrbit::GM_JGM3,
+                                                    degree, degree);
+      prop.integrateTo(tf);
+      expected.push_back(prop.rvState());
+   }
+   double singleTime = SystemTime().convertToCommonTime() - start;
+
+   for (int nThreads = 1; nThreads <= 4; nThreads *= 4)
+   {
+      ConstellationPropagator cp;
+      cp.setRefEpoch(utc0).setStepSize(60.0).setNumThreads(nThreads);
+      for (int k = 0; k < numSats; k++)
+      {
+         cp.addSatellite(SatID(k+1, SatID::systemGPS), initialState(k))
+            .getSatOrbitPointer()->enableGeopotential(SatOrbit::GM_JGM3,
+                                                      degree, degree);
+      }
+
+      start = SystemTime().convertToCommonTime();
+      cp.integrateTo(tf/2.0);
+      cp.integrateTo(tf);
+      double groupTime = SystemTime().convertToCommonTime() - start;
+
+      TUASSERTFE(tf, cp.getCurTime());
+      TUASSERT(!ReferenceFrames::getEpochCache());
+
+         // Sharing the environment must not change the result at all
+      double maxDiff(0.0);
+      for (int k = 0; k < numSats; k++)
+      {
+         Vector<double> rv = cp.rvState(SatID(k+1, SatID::systemGPS));
+         for (int i = 0; i < 6; i++)
+         {
+            maxDiff = std::max(maxDiff, std::fabs(rv(i) - expected[k](i)));
+         }
+      }
+      TUASSERTFE(0.0, maxDiff);
+
+      cout << setw(2) << nThreads << " thread(s): "
+           << fixed << setprecision(3) << groupTime << " s together, "
+           << singleTime << " s one by one" << endl;
+   }
+
+   TURETURN();
+}
+
+
+unsigned ConstellationPropagator_T::requestTest()
+{
+   TUDEF("ConstellationPropagator", "addSatellite");
+
+   ConstellationPropagator cp;
+   cp.setRefEpoch(utc0);
+   SatID sat(1, SatID::systemGPS);
+   cp.addSatellite(sat, initialState(0));
+   TUASSERTE(size_t, 1, cp.size());
+
+   try
+   {
+      cp.addSatellite(sat, initialState(0));
+      TUFAIL("A satellite was added twice");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("addSatellite");
+   }
+
+   TUCSM("getPropagator");
+   try
+   {
+      cp.getPropagator(SatID(2, SatID::systemGPS));
+      TUFAIL("Found a satellite that was never added");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("getPropagator");
+   }
+
+   TUCSM("setStepSize");
+   try
+   {
+      cp.setStepSize(0.0);
+      TUFAIL("Accepted a null step size");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("setStepSize");
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   ConstellationPropagator_T testClass;
+
+   errorTotal += testClass.propagateTest();
+   errorTotal += testClass.requestTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
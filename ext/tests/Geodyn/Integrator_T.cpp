@@ -0,0 +1,362 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for the integrators in gpstk/ext/lib/Geodyn. A
+*  Keplerian orbit is integrated with RungeKuttaFehlberg (fixed step)
+*  and with DormandPrince853 (adaptive step, dense output) and compared
+*  with the analytical solution; the number of evaluations of the
+*  equations of motion needed by each one is reported.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include <ctime>
+
+#include "Vector.hpp"
+#include "EquationOfMotion.hpp"
+#include "RungeKuttaFehlberg.hpp"
+#include "DormandPrince853.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   // Earth gravitational constant, m^3/s^2
+static const double GM = 3.986004418e14;
+
+
+   /// Two-body equations of motion, counting the evaluations
+class KeplerEOM : public EquationOfMotion
+{
+public:
+   KeplerEOM() : evaluations(0)
+   {}
+
+   virtual Vector<double> getDerivatives(const double&          t,
+                                         const Vector<double>&  y)
+   {
+      evaluations++;
+
+      const double r2 = y(0)*y(0) + y(1)*y(1) + y(2)*y(2);
+      const double k = -GM / (r2*std::sqrt(r2));
+
+      Vector<double> dy(6);
+      dy(0) = y(3);
+      dy(1) = y(4);
+      dy(2) = y(5);
+      dy(3) = k*y(0);
+      dy(4) = k*y(1);
+      dy(5) = k*y(2);
+
+      return dy;
+   }
+
+   unsigned long evaluations;
+};
+
+
+class Integrator_T
+{
+public:
+   Integrator_T()
+         : a(26560.e3), e(0.1), inc(0.96), y0(6)
+   {
+      n = std::sqrt(GM/(a*a*a));
+      y0 = keplerState(0.0);
+   }
+
+      /// Analytical state at time t after perigee
+   Vector<double> keplerState(double t) const
+   {
+      double M = n*t, E = M;
+      for (int i = 0; i < 30; i++)
+      {
+         E = E - (E - e*std::sin(E) - M)/(1.0 - e*std::cos(E));
+      }
+      const double b = a*std::sqrt(1.0 - e*e);
+      const double x = a*(std::cos(E) - e), y = b*std::sin(E);
+      const double Edot = n/(1.0 - e*std::cos(E));
+      const double vx = -a*std::sin(E)*Edot, vy = b*std::cos(E)*Edot;
+      const double ci = std::cos(inc), si = std::sin(inc);
+
+      Vector<double> s(6);
+      s(0) = x; s(1) = y*ci; s(2) = y*si;
+      s(3) = vx; s(4) = vy*ci; s(5) = vy*si;
+      return s;
+   }
+
+      /// Largest position error over the given epochs
+   double maxPosError(const vector<double>& times,
+                      const vector< Vector<double> >& states) const
+   {
+      double maxErr(0.0);
+      for (size_t i = 0; i < times.size(); i++)
+      {
+         Vector<double> s = keplerState(times[i]);
+         double err(0.0);
+         for (int j = 0; j < 3; j++)
+         {
+            err += (s(j) - states[i](j))*(s(j) - states[i](j));
+         }
+         maxErr = std::max(maxErr, std::sqrt(err));
+      }
+      return maxErr;
+   }
+
+   unsigned finalStateTest();
+   unsigned denseOutputTest();
+   unsigned stepTest();
+
+   double a, e, inc, n;
+   Vector<double> y0;
+};
+
+
+   // Report evaluations and time per output point
+void report(const string& label, unsigned long evaluations, clock_t ticks,
+            size_t points, double maxErr)
+{
+   cout << setw(34) << left << label << right
+        << fixed << setprecision(2)
+        << setw(10) << double(evaluations)/points << " evals/point"
+        << setw(10) << 1.e6*double(ticks)/CLOCKS_PER_SEC/points
+        << " us/point"
+        << scientific << setprecision(2)
+        << setw(12) << maxErr << " m" << endl;
+}
+
+
+unsigned Integrator_T::finalStateTest()
+{
+   TUDEF("DormandPrince853", "integrateTo");
+
+   const double tf = 86400.0;
+   vector<double> times(1, tf);
+   vector< Vector<double> > states(1);
+
+   KeplerEOM eom;
+   RungeKuttaFehlberg rkf;
+   rkf.setStepSize(600.0);
+   double t(0.0);
+   states[0] = y0;
+   clock_t ticks = clock();
+   while (t < tf)
+   {
+      states[0] = rkf.integrateTo(t, states[0], &eom, t + 600.0);
+      t += 600.0;
+   }
+   ticks = clock() - ticks;
+   double rkfErr = maxPosError(times, states);
+   report("RungeKuttaFehlberg, 600 s", eom.evaluations, ticks, 1, rkfErr);
+
+   KeplerEOM eom2;
+   DormandPrince853 dop;
+   dop.setTolerance(1.e-13, 1.e-7);
+   ticks = clock();
+   states[0] = dop.integrateTo(0.0, y0, &eom2, tf);
+   ticks = clock() - ticks;
+   double dopErr = maxPosError(times, states);
+   report("DormandPrince853", eom2.evaluations, ticks, 1, dopErr);
+
+   TUASSERTE(unsigned long, eom2.evaluations, dop.getNumEvaluations());
+   TUASSERT(dopErr < 1.e-3);
+      // more accurate than RKF78 at about the same cost
+   TUASSERT(dopErr < rkfErr);
+   TUASSERT(eom2.evaluations < 2*eom.evaluations);
+
+      // the error follows the tolerance
+   KeplerEOM eom3;
+   dop.setTolerance(1.e-9, 1.e-3);
+   states[0] = dop.integrateTo(0.0, y0, &eom3, tf);
+   double looseErr = maxPosError(times, states);
+   TUASSERT(looseErr > dopErr);
+   TUASSERT(looseErr < 10.0);
+   TUASSERT(eom3.evaluations < eom2.evaluations);
+
+      // backwards integration brings back the initial state
+   dop.setTolerance(1.e-13, 1.e-7);
+   Vector<double> yf = dop.integrateTo(0.0, y0, &eom3, tf);
+   Vector<double> yb = dop.integrateTo(tf, yf, &eom3, 0.0);
+   TUASSERTFEPS(y0, yb, 1.e-3);
+
+   TURETURN();
+}
+
+
+unsigned Integrator_T::denseOutputTest()
+{
+   TUDEF("DormandPrince853", "integrateTo(times)");
+
+      // positions every second for half a day
+   const size_t numPoints = 43200;
+   vector<double> times(numPoints);
+   for (size_t i = 0; i < numPoints; i++)
+   {
+      times[i] = double(i + 1);
+   }
+   vector< Vector<double> > states;
+
+      // RKF78 has to step over each output epoch
+   KeplerEOM eom;
+   RungeKuttaFehlberg rkf;
+   states.resize(numPoints);
+   Vector<double> y(y0);
+   double t(0.0);
+   clock_t ticks = clock();
+   for (size_t i = 0; i < numPoints; i++)
+   {
+      y = rkf.integrateTo(t, y, &eom, times[i]);
+      t = times[i];
+      states[i] = y;
+   }
+   ticks = clock() - ticks;
+   double rkfErr = maxPosError(times, states);
+   report("RungeKuttaFehlberg, 1 s", eom.evaluations, ticks, numPoints,
+          rkfErr);
+
+      // DOP853 interpolates every epoch from one pass
+   KeplerEOM eom2;
+   DormandPrince853 dop;
+   dop.setTolerance(1.e-13, 1.e-7);
+   ticks = clock();
+   dop.integrateTo(0.0, y0, &eom2, times, states);
+   ticks = clock() - ticks;
+   double dopErr = maxPosError(times, states);
+   report("DormandPrince853, dense output", eom2.evaluations, ticks,
+          numPoints, dopErr);
+
+   TUASSERTE(size_t, numPoints, states.size());
+   TUASSERT(dopErr < 1.e-3);
+      // about two orders of magnitude fewer force model evaluations
+   TUASSERT(100*eom2.evaluations < eom.evaluations);
+
+      // the last output epoch is not interpolated
+   Vector<double> yf = dop.integrateTo(0.0, y0, &eom2, times.back());
+   TUASSERTFE(yf, states.back());
+
+      // backwards, and including the initial epoch
+   vector<double> back(3);
+   back[0] = times.back();
+   back[1] = 0.5*times.back() + 0.25;
+   back[2] = 0.0;
+   dop.integrateTo(times.back(), yf, &eom2, back, states);
+   TUASSERTFE(yf, states[0]);
+   TUASSERT(maxPosError(back, states) < 1.e-3);
+
+      // output epochs must follow the integration direction
+   try
+   {
+      back[1] = -10.0;
+      dop.integrateTo(times.back(), yf, &eom2, back, states);
+      TUFAIL("non monotonic output epochs should throw");
+   }
+   catch (Exception& ex)
+   {
+      TUPASS("non monotonic output epochs");
+   }
+
+   TURETURN();
+}
+
+
+unsigned Integrator_T::stepTest()
+{
+   TUDEF("DormandPrince853", "step");
+
+   KeplerEOM eom;
+   DormandPrince853 dop;
+   dop.setTolerance(1.e-12, 1.e-6).setMaxStepSize(300.0);
+   dop.initialize(0.0, y0, &eom);
+
+   const double tf = 3.0*3600.0;
+   double prev(0.0), maxStep(0.0), endErr(0.0), midErr(0.0);
+   bool timesOk(true);
+   while (dop.getTime() < tf)
+   {
+      double t = dop.step(tf);
+      timesOk = timesOk && (prev == dop.getPreviousTime()) && (t <= tf);
+      maxStep = std::max(maxStep, t - prev);
+
+         // the continuous extension matches both ends of the step, and
+         // the analytical solution in the middle
+      endErr = std::max(endErr, norm(dop.getState() - dop.interpolate(t)));
+      Vector<double> mid = dop.interpolate(0.5*(prev + t));
+      Vector<double> ref = keplerState(0.5*(prev + t));
+      midErr = std::max(midErr, norm(ref - mid));
+      prev = t;
+   }
+   TUASSERT(timesOk);
+   TUASSERT(maxStep < 300.0 + 1.e-9);
+   TUASSERT(endErr < 1.e-6);
+   TUASSERT(midErr < 1.e-3);
+   TUASSERTFE(tf, dop.getTime());
+   TUASSERTE(unsigned long, 0, dop.getNumRejected());
+
+      // a step can't go under the minimum step size
+   dop.setTolerance(1.e-30, 1.e-30).setMinStepSize(1.0);
+   dop.initialize(0.0, y0, &eom);
+   try
+   {
+      dop.step(tf);
+      TUFAIL("step size underflow should throw");
+   }
+   catch (Exception& ex)
+   {
+      TUPASS("step size underflow");
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Integrator_T testClass;
+
+   errorTotal += testClass.finalStateTest();
+   errorTotal += testClass.denseOutputTest();
+   errorTotal += testClass.stepTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,261 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/Geomatics/PrecessionNutationCache.
+*  The rotations of ReferenceFrames and GeodeticFrames are computed
+*  at many epochs over two days with and without the cache, and the
+*  differences are checked against the error bound of the cache.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+#include <cmath>
+#include <ctime>
+
+#include "PrecessionNutationCache.hpp"
+#include "ReferenceFrames.hpp"
+#include "GeodeticFrames.hpp"
+#include "IERS.hpp"
+
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+class PrecessionNutationCache_T
+{
+public:
+   PrecessionNutationCache_T()
+      : numEpochs(997), span(2*86400.0)
+   {}
+
+      /// Write a finals file with slowly varying pole and UT1-UTC
+   void writeEOPFile(const string& fileName)
+   {
+      ofstream out(fileName.c_str());
+      for (int mjd = 55180; mjd < 55230; mjd++)
+      {
+         string line(80, ' ');
+         char buf[32];
+         sprintf(buf, "%8.2f", double(mjd));
+         line.replace(7, 8, buf);
+         sprintf(buf, "%9.6f", 0.05 + 0.001*(mjd-55180));
+         line.replace(18, 9, buf);
+         sprintf(buf, "%9.6f", 0.3 - 0.002*(mjd-55180));
+         line.replace(37, 9, buf);
+         sprintf(buf, "%10.7f", 0.1 - 0.0005*(mjd-55180));
+         line.replace(58, 10, buf);
+         out << line << endl;
+      }
+   }
+
+      /// Largest absolute difference between the elements of A and B
+   static double maxDiff(const Matrix<double>& A, const Matrix<double>& B)
+   {
+      double d(0.0);
+      for (size_t i = 0; i < A.rows(); i++)
+         for (size_t j = 0; j < A.cols(); j++)
+            d = std::max(d, std::fabs(A(i,j) - B(i,j)));
+      return d;
+   }
+
+   unsigned gridTest();
+   unsigned referenceFramesTest();
+   unsigned geodeticFramesTest();
+
+   int numEpochs;
+   double span;
+};
+
+
+unsigned PrecessionNutationCache_T::gridTest()
+{
+   TUDEF("PrecessionNutationCache", "setTolerance");
+
+   ReferenceFrames::setRotationCache(false);
+
+   try
+   {
+      ReferenceFrames::setRotationCache(true, 0.0);
+      TUFAIL("Accepted a null tolerance");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("setTolerance");
+   }
+   TUASSERT(!ReferenceFrames::getRotationCache());
+
+   try
+   {
+      GeodeticFrames::SetPrecessionNutationCache(true, -1.0e-12);
+      TUFAIL("Accepted a negative tolerance");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("setTolerance");
+   }
+
+   TUCSM("getErrorBound");
+   double tols[3] = { 1.0e-9, 1.0e-12, 1.0e-14 };
+   for (int i = 0; i < 3; i++)
+   {
+      PrecessionNutationCache cache(0, tols[i]);
+      TUASSERT(cache.getErrorBound() <= tols[i]);
+      TUASSERT(cache.getNodesPerDay() >= 4);
+   }
+
+   PrecessionNutationCache cache(0);
+   TUASSERTE(int, 12, cache.getNodesPerDay());
+
+   TURETURN();
+}
+
+
+unsigned PrecessionNutationCache_T::referenceFramesTest()
+{
+   TUDEF("ReferenceFrames", "setRotationCache");
+
+   string eopFile = getPathTestTemp() + getFileSep()
+      + "PrecessionNutationCache_T_finals.txt";
+   writeEOPFile(eopFile);
+   IERS::loadIERSFile(eopFile);
+
+   UTCTime utc0(2010,1,10,0,0,0.0);
+   double tols[2] = { 1.0e-12, 1.0e-9 };
+   for (int k = 0; k < 2; k++)
+   {
+      vector< Matrix<double> > exact;
+      ReferenceFrames::setRotationCache(false);
+      clock_t ticks = clock();
+      for (int i = 0; i < numEpochs; i++)
+      {
+         UTCTime utc(utc0);
+         utc += i*span/(numEpochs-1);
+         exact.push_back(ReferenceFrames::J2kToECEFMatrix(utc));
+      }
+      double exactTime = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      ReferenceFrames::setRotationCache(true, tols[k]);
+      TUASSERT(ReferenceFrames::getRotationCache());
+      double d(0.0);
+      ticks = clock();
+      for (int i = 0; i < numEpochs; i++)
+      {
+         UTCTime utc(utc0);
+         utc += i*span/(numEpochs-1);
+         d = std::max(d, maxDiff(exact[i],
+                                 ReferenceFrames::J2kToECEFMatrix(utc)));
+      }
+      double cacheTime = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+         // Each element of the rotation is within the bound
+      TUASSERT(d <= 2.0*tols[k]);
+
+      cout << "ReferenceFrames, tolerance " << scientific << setprecision(0)
+           << tols[k] << ": max difference " << setprecision(2) << d
+           << ", " << fixed << setprecision(3) << cacheTime << " s cached, "
+           << exactTime << " s exact" << endl;
+   }
+   ReferenceFrames::setRotationCache(false);
+
+   TURETURN();
+}
+
+
+unsigned PrecessionNutationCache_T::geodeticFramesTest()
+{
+   TUDEF("GeodeticFrames", "SetPrecessionNutationCache");
+
+   CommonTime t0 = CivilTime(2010,1,10,0,0,0.0,TimeSystem::UTC);
+   double xp(0.05), yp(0.3), UT1mUTC(0.1);
+   double tols[2] = { 1.0e-12, 1.0e-9 };
+   for (int k = 0; k < 2; k++)
+   {
+      vector< Matrix<double> > exact;
+      GeodeticFrames::SetPrecessionNutationCache(false);
+      clock_t ticks = clock();
+      for (int i = 0; i < numEpochs; i++)
+      {
+         CommonTime t(t0);
+         t += i*span/(numEpochs-1);
+         exact.push_back(GeodeticFrames::ECEFtoInertial(t, xp, yp, UT1mUTC));
+      }
+      double exactTime = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      GeodeticFrames::SetPrecessionNutationCache(true, tols[k]);
+      double d(0.0);
+      ticks = clock();
+      for (int i = 0; i < numEpochs; i++)
+      {
+         CommonTime t(t0);
+         t += i*span/(numEpochs-1);
+         d = std::max(d, maxDiff(exact[i],
+                         GeodeticFrames::ECEFtoInertial(t, xp, yp, UT1mUTC)));
+      }
+      double cacheTime = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      TUASSERT(d <= 2.0*tols[k]);
+
+      cout << "GeodeticFrames, tolerance " << scientific << setprecision(0)
+           << tols[k] << ": max difference " << setprecision(2) << d
+           << ", " << fixed << setprecision(3) << cacheTime << " s cached, "
+           << exactTime << " s exact" << endl;
+   }
+   GeodeticFrames::SetPrecessionNutationCache(false);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   PrecessionNutationCache_T testClass;
+
+   errorTotal += testClass.gridTest();
+   errorTotal += testClass.referenceFramesTest();
+   errorTotal += testClass.geodeticFramesTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,207 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/Geodyn/SatOrbitPropagator.
+*  A GPS-like orbit with the JGM3 geopotential and the state
+*  transition matrix is propagated in one run and in two halves, and
+*  the results are compared. The heap allocations (counted by
+*  replacing the global operator new) and the time per integration
+*  step are printed. The Earth orientation parameters are read from a
+*  synthetic IERS file written by the test itself.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <new>
+
+#include "SatOrbitPropagator.hpp"
+#include "IERS.hpp"
+#include "SystemTime.hpp"
+
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+static unsigned long allocCount = 0;
+
+void* operator new(size_t size)
+{
+   ++allocCount;
+   void *p = malloc(size ? size : 1);
+   if (!p) throw std::bad_alloc();
+   return p;
+}
+
+void* operator new[](size_t size)
+{
+   ++allocCount;
+   void *p = malloc(size ? size : 1);
+   if (!p) throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) throw()
+{ free(p); }
+
+void operator delete[](void* p) throw()
+{ free(p); }
+
+
+class SatOrbitPropagator_T
+{
+public:
+   SatOrbitPropagator_T()
+      : utc0(2010,1,10,0,0,0.0), degree(8), step(60.0), tf(6.0*3600.0)
+   {}
+
+      /// Write a finals file with slowly varying pole and UT1-UTC
+   void writeEOPFile(const string& fileName)
+   {
+      ofstream out(fileName.c_str());
+      for (int mjd = 55180; mjd < 55230; mjd++)
+      {
+         string line(80, ' ');
+         char buf[32];
+         sprintf(buf, "%8.2f", double(mjd));
+         line.replace(7, 8, buf);
+         sprintf(buf, "%9.6f", 0.05 + 0.001*(mjd-55180));
+         line.replace(18, 9, buf);
+         sprintf(buf, "%9.6f", 0.3 - 0.002*(mjd-55180));
+         line.replace(37, 9, buf);
+         sprintf(buf, "%10.7f", 0.1 - 0.0005*(mjd-55180));
+         line.replace(58, 10, buf);
+         out << line << endl;
+      }
+   }
+
+      /// Initial J2000 state, on an inclined circular orbit
+   Vector<double> initialState()
+   {
+      const double a = 26560.0e3;
+      const double v = std::sqrt(3.986004418e14/a);
+      const double inc = 55.0*4.0*std::atan(1.0)/180.0;
+
+      Vector<double> rv(6, 0.0);
+      rv(0) = a;
+      rv(4) = v*std::cos(inc);
+      rv(5) = v*std::sin(inc);
+      return rv;
+   }
+
+   unsigned propagateTest();
+
+   UTCTime utc0;
+   int degree;
+   double step, tf;
+};
+
+
+unsigned SatOrbitPropagator_T::propagateTest()
+{
+   TUDEF("SatOrbitPropagator", "integrateTo");
+
+   string eopFile = getPathTestTemp() + getFileSep()
+      + "SatOrbitPropagator_T_finals.txt";
+   writeEOPFile(eopFile);
+   IERS::loadIERSFile(eopFile);
+
+   SatOrbitPropagator whole, halves;
+   whole.setStepSize(step);
+   whole.setInitState(utc0, initialState());
+   whole.getSatOrbitPointer()->enableGeopotential(SatOrbit::GM_JGM3,
+                                                  degree, degree);
+   halves.setStepSize(step);
+   halves.setInitState(utc0, initialState());
+   halves.getSatOrbitPointer()->enableGeopotential(SatOrbit::GM_JGM3,
+                                                   degree, degree);
+
+   unsigned long before = allocCount;
+   CommonTime start(SystemTime().convertToCommonTime());
+   whole.integrateTo(tf);
+   double elapsed = SystemTime().convertToCommonTime() - start;
+   unsigned long allocs = allocCount - before;
+
+   halves.integrateTo(tf/2.0);
+   halves.integrateTo(tf);
+
+      // The same steps are taken either way
+   Vector<double> y1(whole.getCurState()), y2(halves.getCurState());
+   TUASSERTE(size_t, 42, y1.size());
+   double maxDiff(0.0);
+   for (size_t i = 0; i < y1.size(); i++)
+   {
+      maxDiff = std::max(maxDiff, std::fabs(y1(i) - y2(i)));
+   }
+   TUASSERTFE(0.0, maxDiff);
+
+      // Still on the orbit, and the transition matrix is not the identity
+   Vector<double> rv(whole.rvState());
+   double r = std::sqrt(rv(0)*rv(0) + rv(1)*rv(1) + rv(2)*rv(2));
+   testFramework.assert(std::fabs(r - 26560.0e3) < 50.0e3,
+                        "Radius drifted", __LINE__);
+   Matrix<double> phi(whole.transitionMatrix());
+   testFramework.assert(std::fabs(phi(0,3)) > 1.0,
+                        "Transition matrix not propagated", __LINE__);
+
+   double steps = tf/step;
+   cout << "JGM3 " << degree << "x" << degree << " with STM, "
+        << steps << " steps of " << step << " s: "
+        << fixed << setprecision(1) << allocs/steps << " allocations, "
+        << 1.0e6*elapsed/steps << " us per step" << endl;
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SatOrbitPropagator_T testClass;
+
+   errorTotal += testClass.propagateTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
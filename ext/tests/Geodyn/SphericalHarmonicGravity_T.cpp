@@ -0,0 +1,318 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Regression test for SphericalHarmonicGravity in gpstk/ext/lib/Geodyn.
+*  The acceleration and the gravity gradient of the JGM3 and EGM96
+*  models, at several degrees and orders and positions from low orbit
+*  to GPS altitude, are compared with the values computed by the
+*  implementation that evaluated V and W in full matrices, before the
+*  coefficients were packed. Both gravity()/gravityGradient() and the
+*  single pass used by doCompute(), with its fixed size versions for
+*  4x4, 8x8 and 20x20, are checked.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <cmath>
+
+#include "JGM3GravityModel.hpp"
+#include "EGM96GravityModel.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   // ECI positions (m), from low orbit over the equator to GPS altitude,
+   // and over the pole
+static const double positions[4][3] = {
+   {  4792800.0,  4792800.0,        0.0 },
+   { -2346000.0,  5120000.0,  4170000.0 },
+   { 15600000.0, -7540000.0, 20100000.0 },
+   {   120000.0,   -80000.0,  6950000.0 } };
+
+   // Models (0 JGM3, 1 EGM96), degrees and orders
+struct GravityCase
+{
+   int model, degree, order;
+};
+
+static const GravityCase cases[8] = {
+   { 0,  4,  4 }, { 0,  8,  8 }, { 0, 12,  6 }, { 0, 12, 12 },
+   { 0, 20, 20 }, { 0, 70, 70 }, { 1, 20, 20 }, { 1, 70, 70 } };
+
+   // For each case and position: the ECI acceleration (m/s^2), and the
+   // gravity gradient xx, xy, xz, yy, yz, zz (1/s^2), as computed by the
+   // old implementation with the rotation of rotation()
+static const double expected[8*4][9] = {
+   { -6.1438615281217563, -6.1438427107513505, 7.2448670927575563e-05,
+     6.4279339341230004e-07, 1.9246957352586486e-06, -3.9616591958789356e-11,
+     6.4275726642236017e-07, -4.9711630655511735e-11, -1.2855506598346604e-06 },
+   { 2.7145445161262312, -5.924279729984133, -4.8379369524797458,
+     -7.6886028143854144e-07, -8.471169690486568e-07, -6.9301565215806111e-07,
+     6.9172065569902606e-07, 1.5124742041995569e-06, 7.7139625739515301e-08 },
+   { -0.3326763916814322, 0.16079393463549943, -0.42872114342720752,
+     7.7649430320252063e-10, -1.0682613567923643e-08, 2.8486345949806772e-08,
+     -1.616212520175715e-08, -1.3768443022358945e-08, 1.538563089855463e-08 },
+   { -0.14158700381651643, 0.094459402722174471, -8.2244308355241067,
+     -1.1791076700822475e-06, -6.7383717772591731e-10, 6.0858789758975129e-08,
+     -1.1796908862056597e-06, -4.0614074173752192e-08, 2.3587985562879065e-06 },
+   { -6.143821587769863, -6.1438882336378775, 2.2368110184457194e-05,
+     6.4272687458358821e-07, 1.9246880214487327e-06, -7.4032467832403855e-12,
+     6.4281986970984949e-07, -1.220414686977537e-11, -1.2855467442934376e-06 },
+   { 2.7146160781187434, -5.9242897460051189, -4.8380205223032098,
+     -7.6885617925118288e-07, -8.4715522511325308e-07, -6.9309517644088505e-07,
+     6.9167555202034692e-07, 1.5125397600070951e-06, 7.7180627230836243e-08 },
+   { -0.33267638972168057, 0.16079393777390383, -0.42872114318303228,
+     7.7649356336057686e-10, -1.0682614081716845e-08, 2.848634562879177e-08,
+     -1.6162124424407138e-08, -1.3768443426107559e-08, 1.5385630861046556e-08 },
+   { -0.14158220910960104, 0.094485257777279869, -8.2244381882248057,
+     -1.1790959515472899e-06, -6.3555015134345949e-10, 6.0853065542093774e-08,
+     -1.1797131799783472e-06, -4.0651155678121936e-08, 2.3588091315256368e-06 },
+   { -6.1438040476992679, -6.1439109773981935, 2.6318984410251991e-05,
+     6.4267898980685057e-07, 1.9246887037227217e-06, -1.1467564475735174e-11,
+     6.4286227849571553e-07, -2.6123532649140538e-11, -1.2855412683025663e-06 },
+   { 2.7145992413805811, -5.9242821555694229, -4.8380415961695116,
+     -7.6887418758612321e-07, -8.4713451715516295e-07, -6.9308346210510665e-07,
+     6.9164832941655064e-07, 1.5125566830356654e-06, 7.7225858169572602e-08 },
+   { -0.33267638971888114, 0.16079393777472728, -0.42872114318168758,
+     7.7649356273583061e-10, -1.0682614081649842e-08, 2.8486345627720423e-08,
+     -1.616212442374275e-08, -1.3768443426244734e-08, 1.5385630861006917e-08 },
+   { -0.14155188140184594, 0.094484326719393871, -8.2244563972640048,
+     -1.1790995911952542e-06, -6.3495748680221636e-10, 6.0802228388872625e-08,
+     -1.179742273218153e-06, -4.0645544095071149e-08, 2.3588418644134076e-06 },
+   { -6.1438212978012423, -6.1439114813279243, 3.887427974886865e-05,
+     6.4269090569657464e-07, 1.9247057768368954e-06, -1.7750745745432188e-11,
+     6.4285657207731117e-07, -4.5055947121140359e-11, -1.2855474777738859e-06 },
+   { 2.7145804897790335, -5.924286073997223, -4.8380353439260864,
+     -7.6888460090643971e-07, -8.4711244922612567e-07, -6.9306036804108883e-07,
+     6.9166654523103148e-07, 1.5125581426677147e-06, 7.7218055675408175e-08 },
+   { -0.33267638971953156, 0.16079393777398318, -0.42872114318008842,
+     7.7649356298244758e-10, -1.0682614081445386e-08, 2.8486345627953664e-08,
+     -1.6162124423267836e-08, -1.3768443425852655e-08, 1.5385630860285381e-08 },
+   { -0.14155188140183289, 0.094484326719391595, -8.2244563972640048,
+     -1.1790995911948266e-06, -6.3495748719735082e-10, 6.0802228388838373e-08,
+     -1.1797422732185824e-06, -4.0645544095063175e-08, 2.3588418644134093e-06 },
+   { -6.1438483627792051, -6.1438918319100129, 4.8526173621125089e-05,
+     6.4278319049121317e-07, 1.9247001170678773e-06, -4.0984222426379828e-11,
+     6.4278372998334772e-07, -5.4256613477052642e-11, -1.2855669204745611e-06 },
+   { 2.714581940352796, -5.9242855434837072, -4.838052645525214,
+     -7.6888412934849665e-07, -8.4710082426442805e-07, -6.9307583981990376e-07,
+     6.9164848717916504e-07, 1.5125866535391741e-06, 7.7235642169331577e-08 },
+   { -0.33267638971952668, 0.16079393777397305, -0.42872114318008903,
+     7.7649356297988953e-10, -1.0682614081445326e-08, 2.8486345627952189e-08,
+     -1.6162124423269473e-08, -1.3768443425845791e-08, 1.5385630860289579e-08 },
+   { -0.14156266268802939, 0.094485684454400365, -8.2244651793188623,
+     -1.1791086893612785e-06, -6.3503706527594494e-10, 6.0825687390611753e-08,
+     -1.1797576799008803e-06, -4.0647989699152861e-08, 2.3588663692621587e-06 },
+   { -6.1438508926144193, -6.143899943327324, 3.3220602274262726e-05,
+     6.4279238071061883e-07, 1.9247267252478832e-06, -1.4533268059845845e-11,
+     6.4281038988839865e-07, 2.9299737543643922e-11, -1.285602770599018e-06 },
+   { 2.714576780813577, -5.9243036528773922, -4.8380560722850836,
+     -7.6891355773891513e-07, -8.4710408135571984e-07, -6.9306156332986194e-07,
+     6.9171131111614975e-07, 1.5126381727034459e-06, 7.7202246622765633e-08 },
+   { -0.33267638971952668, 0.16079393777397305, -0.42872114318008903,
+     7.7649356297988953e-10, -1.0682614081445326e-08, 2.8486345627952189e-08,
+     -1.6162124423269473e-08, -1.3768443425845791e-08, 1.5385630860289579e-08 },
+   { -0.14156306286811177, 0.094484126989461237, -8.2244616361567662,
+     -1.179108051206713e-06, -6.4177032076801179e-10, 6.0826074725003407e-08,
+     -1.1797451679801757e-06, -4.0636439226297152e-08, 2.3588532191868883e-06 },
+   { -6.1438494288914596, -6.1438926511766638, 4.9978999451310451e-05,
+     6.4278525166906728e-07, 1.9247016468700111e-06, -4.5097982378115803e-11,
+     6.4278515313186825e-07, -5.6442652150953606e-11, -1.2855704048009357e-06 },
+   { 2.7145822082744426, -5.92428579218336, -4.8380530581177696,
+     -7.6888359761013823e-07, -8.4710110166094879e-07, -6.9307635354714015e-07,
+     6.9164786739337319e-07, 1.5125878091410234e-06, 7.723573021676537e-08 },
+   { -0.33267638970541208, 0.16079393775081979, -0.4287211431740795,
+     7.7649356202999533e-10, -1.0682614079797306e-08, 2.8486345625515278e-08,
+     -1.6162124423947943e-08, -1.3768443422096499e-08, 1.5385630861917947e-08 },
+   { -0.14156333448801198, 0.094486027484688456, -8.2244656311066446,
+     -1.1791095643017456e-06, -6.3485241921528111e-10, 6.0827707369626388e-08,
+     -1.1797582500407341e-06, -4.0648727052861405e-08, 2.3588678143424795e-06 },
+   { -6.1438507471704646, -6.1438996755547839, 3.3984854480082643e-05,
+     6.4279110240891799e-07, 1.92472556907361e-06, -1.5956569468506716e-11,
+     6.4280978911220989e-07, 2.9382063020714116e-11, -1.2856008915211281e-06 },
+   { 2.7145761132983699, -5.9243039235063844, -4.8380577081972254,
+     -7.6891813435815569e-07, -8.4709922440010676e-07, -6.930617597517201e-07,
+     6.9171152208193271e-07, 1.5126436883255929e-06, 7.7206612276223221e-08 },
+   { -0.33267638970541208, 0.16079393775081979, -0.4287211431740795,
+     7.7649356202999533e-10, -1.0682614079797306e-08, 2.8486345625515278e-08,
+     -1.6162124423947943e-08, -1.3768443422096499e-08, 1.5385630861917947e-08 },
+   { -0.14156279573719641, 0.094485568514956347, -8.2244587534238374,
+     -1.1791028444960221e-06, -6.4386658964411245e-10, 6.0822872612292285e-08,
+     -1.1797363042104619e-06, -4.064223545435378e-08, 2.3588391487064838e-06 }
+};
+
+
+   /// Gives access to the evaluation of V and W
+template <class Model>
+class GravityProbe : public Model
+{
+public:
+   GravityProbe(int n, int m) : Model(n, m) {}
+
+      /// gravity() and gravityGradient(), after computeVW()
+   void compute(const Vector<double>& r, const Matrix<double>& E,
+                Vector<double>& a, Matrix<double>& da_dr)
+   {
+      this->computeVW(r, E);
+      a = this->gravity(r, E);
+      da_dr = this->gravityGradient(r, E);
+   }
+
+      /// The single pass of doCompute(), rotated to ECI
+   void evaluate(const Vector<double>& r, const Matrix<double>& E,
+                 Vector<double>& a, Matrix<double>& da_dr)
+   {
+      Vector<double> r_bf(E*r);
+      double acc[3], grad[6];
+      Model::evaluate(&r_bf[0], acc, grad);
+
+      const double R = this->gmData.refDistance;
+      Vector<double> a_bf(3);
+      for (int i = 0; i < 3; i++)
+         a_bf(i) = acc[i]*this->gmData.GM/(R*R);
+
+      Matrix<double> g(3, 3);
+      g(0,0) = grad[0]; g(0,1) = grad[1]; g(0,2) = grad[2];
+      g(1,0) = grad[1]; g(1,1) = grad[3]; g(1,2) = grad[4];
+      g(2,0) = grad[2]; g(2,1) = grad[4]; g(2,2) = grad[5];
+
+      a = transpose(E)*a_bf;
+      da_dr = transpose(E)*g*E*(this->gmData.GM/(R*R*R));
+   }
+};
+
+
+class SphericalHarmonicGravity_T
+{
+public:
+      /// A fixed ECI to ECEF rotation, about z then about x
+   Matrix<double> rotation()
+   {
+      const double z(0.73), x(1.2e-3);
+      Matrix<double> Rz(3, 3, 0.0), Rx(3, 3, 0.0);
+      Rz(0,0) = std::cos(z);  Rz(0,1) = std::sin(z);
+      Rz(1,0) = -std::sin(z); Rz(1,1) = std::cos(z);
+      Rz(2,2) = 1.0;
+      Rx(0,0) = 1.0;
+      Rx(1,1) = std::cos(x);  Rx(1,2) = std::sin(x);
+      Rx(2,1) = -std::sin(x); Rx(2,2) = std::cos(x);
+      return Rx*Rz;
+   }
+
+      /** Largest difference from the expected acceleration and gradient,
+       *  relative to the largest expected component of each.
+       */
+   double difference(const double ref[9], const Vector<double>& a,
+                     const Matrix<double>& da_dr)
+   {
+      static const int row[6] = { 0, 0, 0, 1, 1, 2 };
+      static const int col[6] = { 0, 1, 2, 1, 2, 2 };
+      double amax(0.0), gmax(0.0), adiff(0.0), gdiff(0.0);
+      for (int i = 0; i < 3; i++)
+      {
+         amax = std::max(amax, std::abs(ref[i]));
+         adiff = std::max(adiff, std::abs(a(i) - ref[i]));
+      }
+      for (int k = 0; k < 6; k++)
+      {
+         gmax = std::max(gmax, std::abs(ref[3+k]));
+         gdiff = std::max(gdiff, std::abs(da_dr(row[k],col[k]) - ref[3+k]));
+         gdiff = std::max(gdiff, std::abs(da_dr(col[k],row[k]) - ref[3+k]));
+      }
+      return std::max(adiff/amax, gdiff/gmax);
+   }
+
+   template <class Model>
+   double worstCase(const GravityCase& c, const double ref[4][9], bool pass)
+   {
+      GravityProbe<Model> model(c.degree, c.order);
+      Matrix<double> E(rotation());
+      double worst(0.0);
+      for (int p = 0; p < 4; p++)
+      {
+         Vector<double> r(3), a;
+         Matrix<double> da_dr;
+         for (int i = 0; i < 3; i++)
+            r(i) = positions[p][i];
+         if (pass)
+            model.evaluate(r, E, a, da_dr);
+         else
+            model.compute(r, E, a, da_dr);
+         worst = std::max(worst, difference(ref[p], a, da_dr));
+      }
+      return worst;
+   }
+
+   unsigned compareTest(bool pass);
+};
+
+
+unsigned SphericalHarmonicGravity_T::compareTest(bool pass)
+{
+   TUDEF("SphericalHarmonicGravity", pass ? "doCompute" : "gravity");
+
+   for (int c = 0; c < 8; c++)
+   {
+      const double (*ref)[9] = &expected[4*c];
+      double worst = (cases[c].model == 0)
+         ? worstCase<JGM3GravityModel>(cases[c], ref, pass)
+         : worstCase<EGM96GravityModel>(cases[c], ref, pass);
+      ostringstream oss;
+      oss << (cases[c].model == 0 ? "JGM3 " : "EGM96 ") << cases[c].degree
+          << "x" << cases[c].order << " differs by " << worst;
+      testFramework.assert(worst < 1.0e-12, oss.str(), __LINE__);
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SphericalHarmonicGravity_T testClass;
+
+   errorTotal += testClass.compareTest(false);
+   errorTotal += testClass.compareTest(true);
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,459 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/Geomatics/CSRMatrix. Conversions,
+*  products, transpose, Cholesky and the SRIF measurement update are
+*  checked against SparseMatrix and Matrix, and a timing table of
+*  SparseMatrix against CSRMatrix is printed, at the sizes of the
+*  double difference estimation of relposition (DDBase).
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "CSRMatrix.hpp"
+#include "SRIFilter.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   // Random number in [-1,1].
+double random1(void)
+{ return 2.0*rand()/RAND_MAX - 1.0; }
+
+   // Largest absolute difference between two matrices.
+double maxDiff(const Matrix<double>& A, const Matrix<double>& B)
+{
+   double d(0.0);
+   for (size_t i = 0; i < A.rows(); i++)
+      for (size_t j = 0; j < A.cols(); j++)
+         d = std::max(d, std::fabs(A(i,j) - B(i,j)));
+   return d;
+}
+
+double maxDiff(const Vector<double>& A, const Vector<double>& B)
+{
+   double d(0.0);
+   for (size_t i = 0; i < A.size(); i++)
+      d = std::max(d, std::fabs(A(i) - B(i)));
+   return d;
+}
+
+   // Random SparseMatrix with about 'perRow' non-zero elements in each row.
+SparseMatrix<double> randomSparse(unsigned rows, unsigned cols, unsigned perRow)
+{
+   SparseMatrix<double> SM(rows, cols);
+   for (unsigned i = 0; i < rows; i++)
+      for (unsigned k = 0; k < perRow; k++)
+         SM(i, rand() % cols) = random1();
+   return SM;
+}
+
+   // Partials of one epoch of double differences, as in relposition: every
+   // row has the position of one site, the zenith delays of both sites and
+   // one phase bias. There are 'numSites' sites, the first one fixed, and
+   // the data are the DDs of 'numSats' satellites on each baseline.
+SparseMatrix<double> ddPartials(unsigned numSites, unsigned numSats,
+                                unsigned& numStates)
+{
+   unsigned numBase(numSites-1), numDD(numBase*(numSats-1));
+   unsigned firstTrop(3*numBase), firstBias(firstTrop + numSites);
+   numStates = firstBias + 2*numDD;      // biases of arcs past and future
+
+   SparseMatrix<double> P(numDD, numStates);
+   for (unsigned b = 0, m = 0; b < numBase; b++)
+      for (unsigned s = 0; s < numSats-1; s++, m++)
+      {
+         for (unsigned k = 0; k < 3; k++)
+            P(m, 3*b+k) = random1();
+         P(m, firstTrop) = 1.0 + random1();
+         P(m, firstTrop+b+1) = -1.0 - random1();
+         P(m, firstBias + m + (rand()%2)*numDD) = 0.19;
+      }
+   return P;
+}
+
+   // Covariance of the DDs: on each baseline the DDs share the reference
+   // satellite, so the covariance is block diagonal, with full blocks.
+SparseMatrix<double> ddCovariance(unsigned numSites, unsigned numSats)
+{
+   unsigned nb(numSats-1), numDD((numSites-1)*nb);
+   SparseMatrix<double> CM(numDD, numDD);
+   for (unsigned b = 0; b < numSites-1; b++)
+      for (unsigned i = 0; i < nb; i++)
+         for (unsigned j = 0; j < nb; j++)
+            CM(b*nb+i, b*nb+j) = (i == j ? 4.0 : 2.0) * 1.e-4;
+   return CM;
+}
+
+
+class CSRMatrix_T
+{
+public:
+   CSRMatrix_T() : eps(1.e-12)
+   { srand(5381); }
+
+   unsigned conversionTest();
+   unsigned productTest();
+   unsigned choleskyTest();
+   unsigned measurementTest();
+   void timing();
+
+   double eps;
+};
+
+
+unsigned CSRMatrix_T::conversionTest()
+{
+   TUDEF("CSRMatrix", "CSRMatrix");
+
+   SparseMatrix<double> SM(randomSparse(23, 17, 4));
+   SM.resize(26, 17);                    // trailing empty rows
+   CSRMatrix<double> C(SM);
+   Matrix<double> M(SM);
+
+   TUASSERTE(unsigned, 26, C.rows());
+   TUASSERTE(unsigned, 17, C.cols());
+   TUASSERTE(unsigned, SM.datasize(), C.datasize());
+   TUASSERTFE(0.0, maxDiff(M, C.toMatrix()));
+   TUASSERTFE(0.0, maxDiff(M, Matrix<double>(C.toSparseMatrix())));
+   TUASSERTFE(0.0, maxDiff(M, CSRMatrix<double>(M).toMatrix()));
+
+   int differences(0);
+   for (unsigned i = 0; i < M.rows(); i++)
+      for (unsigned j = 0; j < M.cols(); j++)
+         differences += (C(i,j) != M(i,j));
+   TUASSERTE(int, 0, differences);
+
+      // triplets: duplicates are added, and zeros dropped
+   vector<unsigned int> rows, cols;
+   vector<double> values;
+   SM.flatten(rows, cols, values);
+   rows.push_back(3); cols.push_back(5); values.push_back(1.5);
+   rows.push_back(3); cols.push_back(5); values.push_back(-1.5);
+   rows.push_back(20); cols.push_back(16); values.push_back(2.0);
+   rows.push_back(0); cols.push_back(16); values.push_back(0.0);
+   reverse(rows.begin(), rows.end());
+   reverse(cols.begin(), cols.end());
+   reverse(values.begin(), values.end());
+   CSRMatrix<double> T(26, 17, rows, cols, values);
+   M(20,16) += 2.0;
+   TUASSERTFE(0.0, maxDiff(M, T.toMatrix()));
+   TUASSERTE(unsigned, SM.datasize() + (SM.isFilled(20,16) ? 0 : 1),
+             T.datasize());
+   TUASSERTFE(0.0, T(0,16) - M(0,16));
+
+   try
+   {
+      rows.push_back(26); cols.push_back(0); values.push_back(1.0);
+      CSRMatrix<double> bad(26, 17, rows, cols, values);
+      TUFAIL("Index out of range was accepted");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("CSRMatrix");
+   }
+
+   TURETURN();
+}
+
+
+unsigned CSRMatrix_T::productTest()
+{
+   TUDEF("CSRMatrix", "operator*");
+
+   SparseMatrix<double> SA(randomSparse(31, 19, 5)), SB(randomSparse(19, 27, 3));
+   CSRMatrix<double> A(SA), B(SB);
+   Matrix<double> MA(SA), MB(SB), D(19, 7);
+   Vector<double> V(19), W(31);
+   for (unsigned i = 0; i < 19; i++)
+   {
+      V(i) = random1();
+      for (unsigned j = 0; j < 7; j++)
+         D(i,j) = random1();
+   }
+   for (unsigned i = 0; i < 31; i++)
+      W(i) = random1();
+
+   TUASSERTFE(0.0, maxDiff(transpose(MA), transpose(A).toMatrix()));
+   TUASSERTFE(0.0, maxDiff(MA, transpose(transpose(A)).toMatrix()));
+   TUASSERTFEPS(0.0, maxDiff(MA*MB, (A*B).toMatrix()), eps);
+   TUASSERTFEPS(0.0, maxDiff(MA*D, A*D), eps);
+   TUASSERTFEPS(0.0, maxDiff(transpose(D)*MB, transpose(D)*B), eps);
+   TUASSERTFEPS(0.0, maxDiff(MA*V, A*V), eps);
+   TUASSERTFEPS(0.0, maxDiff(transpose(MA)*W, W*A), eps);
+   TUASSERTFEPS(0.0, maxDiff(transpose(MA)*MA,
+                             transposeTimesMatrix(A).toMatrix()), eps);
+   TUASSERTFEPS(0.0, maxDiff(Matrix<double>(SA*SB), (A*B).toMatrix()), eps);
+
+   A *= 2.0;
+   TUASSERTFEPS(0.0, maxDiff(2.0*MA, A.toMatrix()), eps);
+
+   try
+   {
+      CSRMatrix<double> bad(A*A);
+      TUFAIL("Product of incompatible matrices was accepted");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("operator*");
+   }
+
+   TURETURN();
+}
+
+
+unsigned CSRMatrix_T::choleskyTest()
+{
+   TUDEF("CSRMatrix", "lowerCholesky");
+
+      // a banded matrix, and a block diagonal one
+   const unsigned n(40);
+   SparseMatrix<double> band(n, n);
+   for (unsigned i = 0; i < n; i++)
+   {
+      band(i,i) = 4.0;
+      if (i > 0) { band(i,i-1) = 1.0; band(i-1,i) = 1.0; }
+      if (i > 3) { band(i,i-4) = 0.5; band(i-4,i) = 0.5; }
+   }
+   SparseMatrix<double> block(ddCovariance(4, 9));
+
+   SparseMatrix<double> tests[2] = { band, block };
+   for (int t = 0; t < 2; t++)
+   {
+      Matrix<double> M(tests[t]);
+      CSRMatrix<double> L(lowerCholesky(CSRMatrix<double>(tests[t])));
+      Matrix<double> ML(L.toMatrix());
+      TUASSERTFEPS(0.0, maxDiff(lowerCholesky(M), ML), eps);
+      TUASSERTFEPS(0.0, maxDiff(M, ML*transpose(ML)), eps);
+
+         // L stays within the envelope
+      TUASSERTE(unsigned, SparseMatrix<double>(lowerCholesky(M)).datasize(),
+                L.datasize());
+
+      Matrix<double> B(M.rows(), 3);
+      for (unsigned i = 0; i < B.rows(); i++)
+         for (unsigned j = 0; j < 3; j++)
+            B(i,j) = random1();
+      Matrix<double> X(B);
+      lowerTriangularSolve(L, X);
+      TUASSERTFEPS(0.0, maxDiff(ML*X, B), eps);
+   }
+
+   try
+   {
+      SparseMatrix<double> notPD(band);
+      notPD(7,7) = -1.0;
+      CSRMatrix<double> L(lowerCholesky(CSRMatrix<double>(notPD)));
+      TUFAIL("lowerCholesky of a matrix that is not positive definite");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("lowerCholesky");
+   }
+
+   TURETURN();
+}
+
+
+unsigned CSRMatrix_T::measurementTest()
+{
+   TUDEF("SRIFilter", "measurementUpdate");
+
+   unsigned n;
+   SparseMatrix<double> P(ddPartials(3, 9, n)), CM(ddCovariance(3, 9));
+   const unsigned m(P.rows());
+
+      // a priori information, so that the problem is not singular
+   Matrix<double> R0(n, n, 0.0);
+   Vector<double> Z0(n, 0.0), D(m);
+   for (unsigned i = 0; i < n; i++)
+   {
+      R0(i,i) = 10.0;
+      Z0(i) = random1();
+   }
+   for (unsigned i = 0; i < m; i++)
+      D(i) = random1();
+   Namelist NL(n);
+
+   SRIFilter dense(R0, Z0, NL), sparse(dense), csr(dense), csrNoCov(dense),
+             denseNoCov(dense);
+   Vector<double> Dd(D), Ds(D), Dc(D), Dn(D), Ddn(D);
+   dense.measurementUpdate(Matrix<double>(P), Dd, Matrix<double>(CM));
+   sparse.measurementUpdate(P, Ds, CM);
+   csr.measurementUpdate(CSRMatrix<double>(P), Dc, CSRMatrix<double>(CM));
+   csrNoCov.measurementUpdate(CSRMatrix<double>(P), Dn);
+   denseNoCov.measurementUpdate(Matrix<double>(P), Ddn);
+
+   TUASSERTFEPS(0.0, maxDiff(dense.getR(), sparse.getR()), 1.e-9);
+   TUASSERTFEPS(0.0, maxDiff(dense.getZ(), sparse.getZ()), 1.e-9);
+   TUASSERTFEPS(0.0, maxDiff(Dd, Ds), 1.e-9);
+   TUASSERTFEPS(0.0, maxDiff(dense.getR(), csr.getR()), 1.e-9);
+   TUASSERTFEPS(0.0, maxDiff(Dd, Dc), 1.e-9);
+   TUASSERTFEPS(0.0, maxDiff(denseNoCov.getR(), csrNoCov.getR()), 1.e-9);
+   TUASSERTFEPS(0.0, maxDiff(Ddn, Dn), 1.e-9);
+
+      // the SRI version
+   SRI sri(R0, Z0, NL);
+   SparseMatrix<double> Pw(P);
+   Matrix<double> Px(P);
+   Vector<double> Dw(D), Dx(D);
+   sri.measurementUpdate(Pw, Dw);
+   SRI sri2(R0, Z0, NL);
+   sri2.measurementUpdate(Px, Dx);
+   TUASSERTFEPS(0.0, maxDiff(sri.getR(), sri2.getR()), 1.e-9);
+   TUASSERTFEPS(0.0, maxDiff(Dw, Dx), 1.e-9);
+
+   try
+   {
+      Vector<double> Dbad(m+1);
+      csr.measurementUpdate(CSRMatrix<double>(P), Dbad);
+      TUFAIL("Inconsistent dimensions were accepted");
+   }
+   catch (MatrixException& e)
+   {
+      TUPASS("measurementUpdate");
+   }
+
+   TURETURN();
+}
+
+
+   // Time the operations at the sizes of relposition: one baseline of 9
+   // satellites, three sites of 10, and a network of six sites of 12.
+void CSRMatrix_T::timing()
+{
+   unsigned cases[][2] = { {2,9}, {3,10}, {6,12} };
+
+   cout << "  N    M  operation        SparseMatrix(us)  CSRMatrix(us)" << endl;
+   for (unsigned c = 0; c < 3; c++)
+   {
+      unsigned n;
+      SparseMatrix<double> P(ddPartials(cases[c][0], cases[c][1], n)),
+                           CM(ddCovariance(cases[c][0], cases[c][1]));
+      const unsigned m(P.rows());
+      CSRMatrix<double> Pc(P), CMc(CM);
+      Vector<double> D(m, 0.01);
+      Matrix<double> R0(n, n, 0.0);
+      for (unsigned i = 0; i < n; i++)
+         R0(i,i) = 10.0;
+      Vector<double> Z0(n, 0.0);
+      Namelist NL(n);
+      int reps(int(2.e6/(n*n*(m+1))) + 1);
+      double ts[4], tc[4];
+
+      clock_t ticks = clock();
+      for (int r = 0; r < reps; r++)
+         SparseMatrix<double> T(transpose(P));
+      ts[0] = double(clock()-ticks)/CLOCKS_PER_SEC;
+      ticks = clock();
+      for (int r = 0; r < reps; r++)
+         CSRMatrix<double> T(transpose(Pc));
+      tc[0] = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      ticks = clock();
+      for (int r = 0; r < reps; r++)
+         SparseMatrix<double> T(transpose(P) * P);
+      ts[1] = double(clock()-ticks)/CLOCKS_PER_SEC;
+      ticks = clock();
+      for (int r = 0; r < reps; r++)
+         CSRMatrix<double> T(transposeTimesMatrix(Pc));
+      tc[1] = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      ticks = clock();
+      for (int r = 0; r < reps; r++)
+         SparseMatrix<double> L(lowerCholesky(CM));
+      ts[2] = double(clock()-ticks)/CLOCKS_PER_SEC;
+      ticks = clock();
+      for (int r = 0; r < reps; r++)
+         CSRMatrix<double> L(lowerCholesky(CMc));
+      tc[2] = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+         // the measurement update as SparseMatrix did it: whiten with the
+         // inverse of the Cholesky factor, then update
+      ticks = clock();
+      for (int r = 0; r < reps; r++)
+      {
+         Matrix<double> R(R0);
+         Vector<double> Z(Z0);
+         SparseMatrix<double> A(P || D);
+         SparseMatrix<double> CHL(lowerCholesky(CM));
+         A = inverseLT(CHL) * A;
+         SrifMU(R, Z, A, 0);
+      }
+      ts[3] = double(clock()-ticks)/CLOCKS_PER_SEC;
+      ticks = clock();
+      for (int r = 0; r < reps; r++)
+      {
+         SRIFilter srif(R0, Z0, NL);
+         Vector<double> Res(D);
+         srif.measurementUpdate(Pc, Res, CMc);
+      }
+      tc[3] = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      const char *names[4] = { "transpose", "transpose(P)*P", "lowerCholesky(CM)",
+                               "measurementUpdate" };
+      for (int k = 0; k < 4; k++)
+         cout << setw(3) << n << " " << setw(4) << m << "  " << left
+              << setw(18) << names[k] << right << fixed << setprecision(2)
+              << setw(14) << 1.e6*ts[k]/reps << setw(15) << 1.e6*tc[k]/reps
+              << endl;
+   }
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   CSRMatrix_T testClass;
+
+   errorTotal += testClass.conversionTest();
+   errorTotal += testClass.productTest();
+   errorTotal += testClass.choleskyTest();
+   errorTotal += testClass.measurementTest();
+   testClass.timing();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,400 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for the measurement, time and smoother updates of
+*  gpstk/ext/lib/Geomatics/SRIFilter, and for the SrifMU() of
+*  SRIMatrix.hpp. The double precision SrifMU() is compared with the
+*  element by element Householder loops it replaces, and the updates
+*  with the covariance (Kalman) forms of the same steps.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+
+#include "SRIFilter.hpp"
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+   // Fill a matrix with random numbers in [-1,1].
+void randomFill(Matrix<double>& M)
+{
+   for (size_t j = 0; j < M.cols(); j++)
+      for (size_t i = 0; i < M.rows(); i++)
+         M(i,j) = 2.0*rand()/RAND_MAX - 1.0;
+}
+
+   // Random upper triangular matrix with a dominant diagonal.
+Matrix<double> randomUT(size_t n)
+{
+   Matrix<double> R(n, n, 0.0);
+   for (size_t i = 0; i < n; i++)
+   {
+      for (size_t j = i; j < n; j++)
+         R(i,j) = 2.0*rand()/RAND_MAX - 1.0;
+      R(i,i) += 3.0;
+   }
+   return R;
+}
+
+   // Largest absolute difference between two matrices.
+double maxDiff(const Matrix<double>& A, const Matrix<double>& B)
+{
+   double d(0.0);
+   for (size_t i = 0; i < A.rows(); i++)
+      for (size_t j = 0; j < A.cols(); j++)
+         d = std::max(d, std::fabs(A(i,j) - B(i,j)));
+   return d;
+}
+
+double maxDiff(const Vector<double>& A, const Vector<double>& B)
+{
+   double d(0.0);
+   for (size_t i = 0; i < A.size(); i++)
+      d = std::max(d, std::fabs(A(i) - B(i)));
+   return d;
+}
+
+   // The element by element Householder transformation of Bierman, as
+   // SrifMU() was written before it used the blocked kernel.
+void referenceMU(Matrix<double>& R, Vector<double>& Z, Matrix<double>& A,
+                 unsigned int M)
+{
+   const double EPS(-1.e-200);
+   unsigned int m(M), n(R.rows());
+   if (m == 0 || m > A.rows()) m = A.rows();
+   unsigned int np1(n+1);
+
+   for (unsigned int j = 0; j < n; j++)
+   {
+      double sum(0.0), dum, delta, beta;
+      for (unsigned int i = 0; i < m; i++)
+         sum += A(i,j)*A(i,j);
+      if (sum <= 0.0) continue;
+      dum = R(j,j);
+      sum += dum*dum;
+      sum = (dum > 0.0 ? -1.0 : 1.0) * ::sqrt(sum);
+      delta = dum - sum;
+      R(j,j) = sum;
+      beta = sum*delta;
+      if (beta > EPS) continue;
+      beta = 1.0/beta;
+      for (unsigned int k = j+1; k < np1; k++)
+      {
+         sum = delta * (k == n ? Z(j) : R(j,k));
+         for (unsigned int i = 0; i < m; i++)
+            sum += A(i,j)*A(i,k);
+         if (sum == 0.0) continue;
+         sum *= beta;
+         if (k == n) Z(j) += sum*delta;
+         else        R(j,k) += sum*delta;
+         for (unsigned int i = 0; i < m; i++)
+            A(i,k) += sum*A(i,j);
+      }
+   }
+}
+
+
+class SRIFilter_T
+{
+public:
+   SRIFilter_T() : eps(1.e-9)
+   { srand(1977); }
+
+   unsigned srifMUTest();
+   unsigned measurementTest();
+   unsigned timeTest();
+   unsigned smootherTest();
+   void timing();
+
+   double eps;
+};
+
+
+unsigned SRIFilter_T::srifMUTest()
+{
+   TUDEF("SRIMatrix", "SrifMU");
+
+      // state size, number of rows of A, and number of those rows used;
+      // covers the unblocked path and several panels of the kernel
+   unsigned sizes[][3] = { {1,1,0}, {3,5,0}, {7,4,3}, {12,60,0},
+                           {30,150,0}, {45,20,17}, {70,9,0} };
+   unsigned numSizes = sizeof(sizes)/sizeof(sizes[0]);
+
+   for (unsigned s = 0; s < numSizes; s++)
+   {
+      unsigned n(sizes[s][0]), rows(sizes[s][1]), M(sizes[s][2]);
+      Matrix<double> R(randomUT(n)), A(rows, n+1);
+      Vector<double> Z(n);
+      randomFill(A);
+      for (unsigned i = 0; i < n; i++)
+         Z(i) = 2.0*rand()/RAND_MAX - 1.0;
+         // a column of zeros in A is skipped by the transformation
+      if (n > 2)
+         for (unsigned i = 0; i < rows; i++)
+            A(i,2) = 0.0;
+
+      Matrix<double> R1(R), A1(A), R2(R), A2(A);
+      Vector<double> Z1(Z), Z2(Z);
+      referenceMU(R1, Z1, A1, M);
+      SrifMU(R2, Z2, A2, M);
+
+      ostringstream oss;
+      oss << "SrifMU differs from the reference for n=" << n
+          << " rows=" << rows << " M=" << M;
+      TUASSERTE(double, 0.0, maxDiff(R1, R2));
+      TUASSERTE(double, 0.0, maxDiff(Z1, Z2));
+      testFramework.assert(maxDiff(A1, A2) == 0.0, oss.str(), __LINE__);
+   }
+
+   TURETURN();
+}
+
+
+unsigned SRIFilter_T::measurementTest()
+{
+   TUDEF("SRIFilter", "measurementUpdate");
+
+   const unsigned n(8), m(40);
+   Matrix<double> H(m, n);
+   Vector<double> truth(n), D(m);
+   randomFill(H);
+   for (unsigned j = 0; j < n; j++)
+      truth(j) = 10.0*j - 35.0;
+   D = H*truth;
+   for (unsigned i = 0; i < m; i++)
+      D(i) += 0.01*(2.0*rand()/RAND_MAX - 1.0);
+
+      // without a measurement covariance, the least squares solution
+   try
+   {
+      SRIFilter srif(n);
+      Vector<double> Res(D), X;
+      Matrix<double> P;
+      srif.measurementUpdate(H, Res);
+      srif.getStateAndCovariance(X, P);
+
+      Matrix<double> Pls(inverse(transpose(H)*H));
+      Vector<double> Xls(Pls*(transpose(H)*D));
+      TUASSERTFEPS(0.0, maxDiff(X, Xls), eps);
+      TUASSERTFEPS(0.0, maxDiff(P, Pls), eps);
+         // D is replaced with the post-fit residuals
+      TUASSERTFEPS(0.0, maxDiff(Res, D - H*Xls), eps);
+   }
+   catch (Exception& e)
+   {
+      TUFAIL("measurementUpdate without covariance threw: " + e.what());
+   }
+
+      // with a (non-diagonal) measurement covariance, weighted least squares
+   Matrix<double> L(m, m, 0.0);
+   for (unsigned i = 0; i < m; i++)
+   {
+      L(i,i) = 1.0 + 0.5*i/m;
+      if (i > 0) L(i,i-1) = 0.3;
+   }
+   Matrix<double> CM(L*transpose(L));
+
+   SRIFilter srif(n);
+   Vector<double> Res(D), X;
+   Matrix<double> P;
+   srif.measurementUpdate(H, Res, CM);
+   srif.getStateAndCovariance(X, P);
+
+   Matrix<double> W(inverse(CM));
+   Matrix<double> Pls(inverse(transpose(H)*W*H));
+   Vector<double> Xls(Pls*(transpose(H)*(W*D)));
+   TUASSERTFEPS(0.0, maxDiff(X, Xls), eps);
+   TUASSERTFEPS(0.0, maxDiff(P, Pls), eps);
+   TUASSERTFEPS(0.0, maxDiff(Res, D - H*Xls), eps);
+
+   TURETURN();
+}
+
+
+unsigned SRIFilter_T::timeTest()
+{
+   TUDEF("SRIFilter", "timeUpdate");
+
+   const unsigned n(12), ns(5);
+   Matrix<double> R(randomUT(n)), Phi(n, n), G(n, ns), Rw(randomUT(ns));
+   Vector<double> Z(n), zw(ns, 0.0);
+   randomFill(Phi);
+   for (unsigned i = 0; i < n; i++)
+   {
+      Phi(i,i) += 4.0;
+      Z(i) = 2.0*rand()/RAND_MAX - 1.0;
+   }
+   randomFill(G);
+
+   Namelist NL(n);
+   SRIFilter srif(R, Z, NL);
+   Vector<double> X;
+   Matrix<double> P;
+   srif.getStateAndCovariance(X, P);
+
+      // the covariance form: X = Phi*X, P = Phi*P*Phi^T + G*Q*G^T,
+      // with inverse(Q) = Rw^T*Rw
+   Matrix<double> Q(inverse(transpose(Rw)*Rw));
+   Vector<double> Xk(Phi*X);
+   Matrix<double> Pk(Phi*P*transpose(Phi) + G*Q*transpose(G));
+
+   Matrix<double> PhiInv(inverse(Phi)), Rwx(ns, n);
+   srif.timeUpdate(PhiInv, Rw, G, zw, Rwx);
+   srif.getStateAndCovariance(X, P);
+
+   TUASSERTFEPS(0.0, maxDiff(X, Xk), eps);
+   TUASSERTFEPS(0.0, maxDiff(P, Pk), eps);
+   TUASSERTE(unsigned, ns, Rwx.rows());
+   TUASSERTE(unsigned, n, Rwx.cols());
+
+   TURETURN();
+}
+
+
+unsigned SRIFilter_T::smootherTest()
+{
+   TUDEF("SRIFilter", "smootherUpdate");
+
+   const unsigned n(10), ns(4);
+   Matrix<double> R(randomUT(n)), Phi(n, n), G(n, ns), Rw(randomUT(ns));
+   Vector<double> Z(n), zw(ns);
+   randomFill(Phi);
+   for (unsigned i = 0; i < n; i++)
+   {
+      Phi(i,i) += 4.0;
+      Z(i) = 2.0*rand()/RAND_MAX - 1.0;
+   }
+   for (unsigned i = 0; i < ns; i++)
+      zw(i) = 0.1*(2.0*rand()/RAND_MAX - 1.0);
+   randomFill(G);
+
+      // a forward time update, saving what the smoother needs
+   Namelist NL(n);
+   SRIFilter srif(R, Z, NL);
+   Matrix<double> PhiInv(inverse(Phi)), Rwx(ns, n), Gsave(G);
+   srif.timeUpdate(PhiInv, Rw, G, zw, Rwx);
+
+      // the Dyer-McReynolds form, starting from the same state
+   Vector<double> Xdm;
+   Matrix<double> Pdm;
+   srif.getStateAndCovariance(Xdm, Pdm);
+   {
+      Matrix<double> Phinv(inverse(Phi)), Rw1(Rw), G1(Gsave), Rwx1(Rwx);
+      Vector<double> zw1(zw);
+      SRIFilter::DMsmootherUpdate(Pdm, Xdm, Phinv, Rw1, G1, zw1, Rwx1);
+   }
+
+      // and the SRI form
+   Matrix<double> Phi1(Phi), G2(Gsave);
+   srif.smootherUpdate(Phi1, Rw, G2, zw, Rwx);
+   Vector<double> X;
+   Matrix<double> P;
+   srif.getStateAndCovariance(X, P);
+
+   TUASSERTFEPS(0.0, maxDiff(X, Xdm), eps);
+   TUASSERTFEPS(0.0, maxDiff(P, Pdm), eps);
+
+   TURETURN();
+}
+
+
+   // Time the SRIF updates at a few sizes typical of positioning filters.
+void SRIFilter_T::timing()
+{
+   unsigned sizes[][2] = { {12,8}, {40,30}, {100,60} };
+   cout << "   n    m   MU(us)   TU(us)" << endl;
+   for (unsigned s = 0; s < 3; s++)
+   {
+      unsigned n(sizes[s][0]), m(sizes[s][1]);
+      int reps(int(2.e7/(n*n*(n+m))) + 1);
+      Matrix<double> H(m, n), R(randomUT(n)), Phi(n, n, 0.0), G(n, n),
+                     Rw(randomUT(n));
+      Vector<double> D(m), Z(n, 0.0), zw(n, 0.0);
+      randomFill(H);
+      randomFill(G);
+      for (unsigned i = 0; i < n; i++)
+         Phi(i,i) = 1.0;
+      for (unsigned i = 0; i < m; i++)
+         D(i) = 2.0*rand()/RAND_MAX - 1.0;
+      Namelist NL(n);
+      SRIFilter srif(R, Z, NL);
+
+      clock_t ticks = clock();
+      for (int r = 0; r < reps; r++)
+      {
+         Vector<double> Res(D);
+         srif.measurementUpdate(H, Res);
+      }
+      double mu = 1.e6*double(clock()-ticks)/CLOCKS_PER_SEC/reps;
+
+      ticks = clock();
+      for (int r = 0; r < reps; r++)
+      {
+         Matrix<double> PhiInv(Phi), Rw1(Rw), G1(G), Rwx(n, n);
+         Vector<double> zw1(zw);
+         srif.timeUpdate(PhiInv, Rw1, G1, zw1, Rwx);
+      }
+      double tu = 1.e6*double(clock()-ticks)/CLOCKS_PER_SEC/reps;
+
+      cout << setw(4) << n << " " << setw(4) << m << fixed << setprecision(1)
+           << " " << setw(8) << mu << " " << setw(8) << tu << endl;
+   }
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SRIFilter_T testClass;
+
+   errorTotal += testClass.srifMUTest();
+   errorTotal += testClass.measurementTest();
+   errorTotal += testClass.timeTest();
+   errorTotal += testClass.smootherTest();
+   testClass.timing();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
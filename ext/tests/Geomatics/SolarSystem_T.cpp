@@ -0,0 +1,246 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/Geomatics/SolarSystem.
+*  The DE405 binary file in examples/ is read with the memory-mapped
+*  reader; states are checked against reference values, computed
+*  in forward, backward and random order, in batches and from
+*  several threads, and must agree exactly.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+#include "SolarSystem.hpp"
+
+#include "build_config.h"
+#include "TestUtil.hpp"
+
+#ifdef GPSTK_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+using namespace std;
+using namespace gpstk;
+
+
+   // Work for one thread: compute the Moon at each time
+struct StateJob
+{
+   SolarSystem *eph;
+   const vector<double> *times;
+   vector<double> PV;
+   int iret;
+};
+
+extern "C" void *solarSystemThread(void *arg)
+{
+   StateJob *job = static_cast<StateJob *>(arg);
+   job->PV.resize(6*job->times->size());
+   job->iret = 0;
+   for (size_t i = 0; i < job->times->size(); i++)
+   {
+      int iret = job->eph->computeState((*job->times)[i], SolarSystem::Moon,
+                                        SolarSystem::Earth, &job->PV[6*i]);
+      if (iret) job->iret = iret;
+   }
+   return 0;
+}
+
+
+class SolarSystem_T
+{
+public:
+   SolarSystem_T()
+      : ephFile(getPathSrc() + getFileSep() + "examples" + getFileSep()
+                + "DE405.EPH")
+   {
+         // times spread over the file, in random order
+      srand(405);
+      for (int i = 0; i < 2000; i++)
+         times.push_back(2451540.0 + 7300.0*rand()/RAND_MAX);
+   }
+
+   unsigned stateTest();
+   unsigned batchTest();
+   unsigned threadTest();
+
+   string ephFile;
+   vector<double> times;
+};
+
+
+unsigned SolarSystem_T::stateTest()
+{
+   TUDEF("SolarSystem", "computeState");
+
+   SolarSystem eph;
+   TUASSERTE(int, 0, eph.initializeWithBinaryFile(ephFile));
+   TUASSERTE(int, 405, eph.JPLNumber());
+#ifndef _WIN32
+   TUASSERT(eph.isMapped());
+#endif
+
+      // geocentric Moon and Sun at J2000, km and km/day
+   double moon[6] = { -291608.388457, -266716.829237, -76102.4813232,
+                      55601.1106797, -57549.9768969, -26034.5410509 };
+   double sun[6] = { 26499034.2289, -132757417.665, -57556717.4479,
+                     2574224.06818, 433559.73258, 187954.018152 };
+   double PV[6];
+   TUASSERTE(int, 0, eph.computeState(2451545.0, SolarSystem::Moon,
+                                      SolarSystem::Earth, PV));
+   for (int i = 0; i < 6; i++)
+      TUASSERTFEPS(moon[i], PV[i], 1.0e-5);
+   TUASSERTE(int, 0, eph.computeState(2451545.0, SolarSystem::Sun,
+                                      SolarSystem::Earth, PV));
+   for (int i = 0; i < 6; i++)
+      TUASSERTFEPS(sun[i], PV[i], 1.0e-3);
+
+      // out of range
+   TUASSERTE(int, -1, eph.computeState(2451000.0, SolarSystem::Sun,
+                                       SolarSystem::Earth, PV));
+   TUASSERTE(int, -2, eph.computeState(2459000.0, SolarSystem::Sun,
+                                       SolarSystem::Earth, PV));
+
+      // the order of the requests does not matter
+   vector<double> forward(6*times.size());
+   for (size_t i = 0; i < times.size(); i++)
+      eph.computeState(times[i], SolarSystem::Moon, SolarSystem::Earth,
+                       &forward[6*i]);
+   double maxDiff(0.0);
+   for (size_t i = times.size(); i-- > 0; )
+   {
+      eph.computeState(times[i], SolarSystem::Moon, SolarSystem::Earth, PV);
+      for (int k = 0; k < 6; k++)
+         maxDiff = std::max(maxDiff, std::fabs(PV[k] - forward[6*i+k]));
+   }
+   TUASSERTFE(0.0, maxDiff);
+
+   TURETURN();
+}
+
+
+unsigned SolarSystem_T::batchTest()
+{
+   TUDEF("SolarSystem", "computeStates");
+
+   SolarSystem eph;
+   eph.initializeWithBinaryFile(ephFile);
+
+   vector<double> PVs;
+   TUASSERTE(int, 0, eph.computeStates(times, SolarSystem::Sun,
+                                       SolarSystem::Earth, PVs, false));
+   TUASSERTE(size_t, 6*times.size(), PVs.size());
+
+   double PV[6], maxDiff(0.0);
+   for (size_t i = 0; i < times.size(); i++)
+   {
+      eph.computeState(times[i], SolarSystem::Sun, SolarSystem::Earth, PV,
+                       false);
+      for (int k = 0; k < 6; k++)
+         maxDiff = std::max(maxDiff, std::fabs(PV[k] - PVs[6*i+k]));
+   }
+   TUASSERTFE(0.0, maxDiff);
+
+      // a time out of range stops the batch
+   vector<double> bad(times.begin(), times.begin()+10);
+   bad[5] = 2459000.0;
+   TUASSERTE(int, -2, eph.computeStates(bad, SolarSystem::Sun,
+                                        SolarSystem::Earth, PVs));
+
+   TURETURN();
+}
+
+
+unsigned SolarSystem_T::threadTest()
+{
+   TUDEF("SolarSystem", "computeState");
+
+#ifdef GPSTK_HAVE_PTHREAD
+   SolarSystem eph;
+   eph.initializeWithBinaryFile(ephFile);
+
+   vector<double> expected(6*times.size());
+   for (size_t i = 0; i < times.size(); i++)
+      eph.computeState(times[i], SolarSystem::Moon, SolarSystem::Earth,
+                       &expected[6*i]);
+
+   const int numThreads = 4;
+   StateJob jobs[numThreads];
+   pthread_t threads[numThreads];
+   for (int t = 0; t < numThreads; t++)
+   {
+      jobs[t].eph = &eph;
+      jobs[t].times = &times;
+      pthread_create(&threads[t], NULL, solarSystemThread, &jobs[t]);
+   }
+   for (int t = 0; t < numThreads; t++)
+      pthread_join(threads[t], NULL);
+
+   double maxDiff(0.0);
+   for (int t = 0; t < numThreads; t++)
+   {
+      TUASSERTE(int, 0, jobs[t].iret);
+      for (size_t i = 0; i < expected.size(); i++)
+         maxDiff = std::max(maxDiff, std::fabs(jobs[t].PV[i] - expected[i]));
+   }
+   TUASSERTFE(0.0, maxDiff);
+#else
+   TUPASS("no threads");
+#endif
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   SolarSystem_T testClass;
+
+   errorTotal += testClass.stateTest();
+   errorTotal += testClass.batchTest();
+   errorTotal += testClass.threadTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,190 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/FileHandling/Ionex/IonexStore.
+*  A store of synthetic global TEC and RMS maps is built in memory, and
+*  the values of many pierce points at one epoch are looked up together
+*  and one by one, with every interpolation strategy.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <ctime>
+
+#include "IonexStore.hpp"
+#include "CivilTime.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+class IonexStore_T
+{
+public:
+   IonexStore_T()
+   {
+      for (int hour = 0; hour <= 6; hour += 2)
+      {
+         store.addMap(makeMap(hour, IonexData::TEC));
+         store.addMap(makeMap(hour, IonexData::RMS));
+      }
+
+         // pierce points all around the Earth, plus one beyond the grid
+      const double radius(6371000.0 + 450000.0);
+      for (int i = 0; i < 2000; i++)
+      {
+         double lat(-85.0 + std::fmod(i*7.31, 170.0));
+         double lon(std::fmod(i*13.77, 360.0));
+         IPP.push_back(Position(lat, lon, radius, Position::Geocentric));
+      }
+      IPP.push_back(Position(89.0, 10.0, radius, Position::Geocentric));
+   }
+
+      /// Global map of 2.5x5 degrees at 450 km, as in IGS products
+   IonexData makeMap(int hour, const IonexData::IonexValType& type)
+   {
+      IonexData map;
+      map.mapID = hour/2 + 1;
+      map.time = CivilTime(2012, 3, 1, hour, 0, 0.0).convertToCommonTime();
+      map.type = type;
+      map.exponent = -1;
+      map.lat[0] = 87.5;   map.lat[1] = -87.5; map.lat[2] = -2.5;
+      map.lon[0] = -180.0; map.lon[1] = 180.0; map.lon[2] = 5.0;
+      map.hgt[0] = 450.0;  map.hgt[1] = 450.0; map.hgt[2] = 0.0;
+      map.dim[0] = 71;     map.dim[1] = 73;    map.dim[2] = 1;
+      map.data.resize(71*73);
+      double scale(type.type == "TEC" ? 1.0 : 0.1);
+      for (int ilat = 0; ilat < 71; ilat++)
+      {
+         for (int ilon = 0; ilon < 73; ilon++)
+         {
+            double lat(87.5 - 2.5*ilat), lon(-180.0 + 5.0*ilon);
+            map.data[ilon + 73*ilat] = scale * ( 20.0 + hour
+               + 15.0*std::cos(lat*DEG_TO_RAD)*std::cos((lon-15.0*hour)*DEG_TO_RAD) );
+         }
+      }
+      map.valid = true;
+      return map;
+   }
+
+   unsigned batchTest();
+
+   IonexStore store;
+   vector<Position> IPP;
+};
+
+
+unsigned IonexStore_T::batchTest()
+{
+   TUDEF("IonexStore", "getIonexValues");
+
+   CommonTime t(CivilTime(2012, 3, 1, 3, 10, 0.0).convertToCommonTime());
+
+   for (int strategy = 1; strategy <= 4; strategy++)
+   {
+      vector<Triple> values;
+      vector<bool> found;
+
+      clock_t ticks = clock();
+      store.getIonexValues(t, IPP, values, found, strategy);
+      double batch = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      TUASSERTE(size_t, IPP.size(), values.size());
+      TUASSERTE(size_t, IPP.size(), found.size());
+
+      int differences(0), missing(0);
+      ticks = clock();
+      for (size_t i = 0; i < IPP.size(); i++)
+      {
+         try
+         {
+            Triple val(store.getIonexValue(t, IPP[i], strategy));
+            differences += ( !found[i] || val[0] != values[i][0] ||
+                             val[1] != values[i][1] || val[2] != values[i][2] );
+         }
+         catch (InvalidRequest& e)
+         {
+            missing++;
+            differences += found[i];
+         }
+      }
+      double single = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      TUASSERTE(int, 0, differences);
+      TUASSERTE(int, 1, missing);
+
+      cout << "strategy " << strategy << ": " << fixed << setprecision(3)
+           << 1.0e6*single/IPP.size() << " us one by one, "
+           << 1.0e6*batch/IPP.size() << " us in batch" << endl;
+   }
+
+      // the last map is an exact match with no next map
+   vector<Triple> values;
+   vector<bool> found;
+   CommonTime last(CivilTime(2012, 3, 1, 6, 0, 0.0).convertToCommonTime());
+   store.getIonexValues(last, IPP, values, found, 3);
+   TUASSERTFE(store.getIonexValue(last, IPP[0], 3)[0], values[0][0]);
+
+   try
+   {
+      store.getIonexValues(last + 60.0, IPP, values, found);
+      TUFAIL("Found values after the last map");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("getIonexValues");
+   }
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   IonexStore_T testClass;
+
+   errorTotal += testClass.batchTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,498 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/Math/FrequencyStability. The
+*  deviations of a synthetic white frequency noise clock, with an
+*  offset, a frequency offset and some missing measurements, are
+*  compared with the sums of their definitions computed term by term,
+*  and with the level of the noise. A day of 1 Hz phase is timed.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <ctime>
+#include <limits>
+
+#include "FrequencyStability.hpp"
+#include "AllanDeviation.hpp"
+#include "StringUtils.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+typedef FrequencyStability FS;
+
+
+class FrequencyStability_T
+{
+public:
+   FrequencyStability_T() : seed(12345) {}
+
+      /// Standard normal deviates, from a fixed seed
+   double gauss()
+   {
+      double s(0.0);
+      for (int k = 0; k < 12; k++)
+      {
+         seed = seed*6364136223846793005ULL + 1442695040888963407ULL;
+         s += (seed >> 11) * (1.0/9007199254740992.0);
+      }
+      return (s - 6.0);
+   }
+
+      /** Phase of a clock with white frequency noise of deviation
+       *  'sigma' per sample, plus an offset and a frequency offset.
+       */
+   vector<double> makePhase(long n, double sigma)
+   {
+      vector<double> x(n);
+      x[0] = 3.0e-3;
+      for (long i = 1; i < n; i++)
+      {
+         x[i] = x[i-1] + 2.0e-9 + sigma*gauss();
+      }
+      return x;
+   }
+
+      /// The definitions, term by term
+   double direct(const vector<double>& x, FS::Statistic stat, long m,
+                 double tau0)
+   {
+      long N(x.size());
+      double total(0.0), tau(m*tau0);
+      long count(0);
+
+      if (stat == FS::Allan || stat == FS::NonOverlappingAllan)
+      {
+         long step( (stat == FS::Allan) ? 1 : m );
+         for (long i = 0; i+2*m < N; i += step)
+         {
+            double t(x[i+2*m] - 2.0*x[i+m] + x[i]);
+            if (t == t) { total += t*t; count++; }
+         }
+         return std::sqrt(total/(2.0*tau*tau*count));
+      }
+      if (stat == FS::ModifiedAllan || stat == FS::Time)
+      {
+         for (long j = 0; j+3*m <= N; j++)
+         {
+            double s(0.0);
+            for (long i = j; i < j+m; i++)
+            {
+               s += x[i+2*m] - 2.0*x[i+m] + x[i];
+            }
+            if (s == s) { total += s*s; count++; }
+         }
+         double mdev( std::sqrt(total/(2.0*tau*tau*m*m*count)) );
+         return (stat == FS::Time) ? tau*mdev/std::sqrt(3.0) : mdev;
+      }
+      if (stat == FS::Hadamard)
+      {
+         for (long i = 0; i+3*m < N; i++)
+         {
+            double t(x[i+3*m] - 3.0*x[i+2*m] + 3.0*x[i+m] - x[i]);
+            if (t == t) { total += t*t; count++; }
+         }
+         return std::sqrt(total/(6.0*tau*tau*count));
+      }
+
+         // Total, on the phase reflected about both ends
+      vector<double> ext(3*N-4);
+      for (long i = 0; i < N; i++)
+      {
+         ext[N-2+i] = x[i];
+      }
+      for (long k = 1; k <= N-2; k++)
+      {
+         ext[N-2-k] = 2.0*x[0] - x[k];
+         ext[2*N-3+k] = 2.0*x[N-1] - x[N-1-k];
+      }
+      for (long i = 1; i <= N-2; i++)
+      {
+         double t(ext[N-2+i-m] - 2.0*ext[N-2+i] + ext[N-2+i+m]);
+         if (t == t) { total += t*t; count++; }
+      }
+      return std::sqrt(total/(2.0*tau*tau*count));
+   }
+
+      /** The overlapping Allan deviation as computed by AllanDeviation
+       *  before it used FrequencyStability, with the number of gaps it
+       *  counted.
+       */
+   vector<double> oldAllanDeviation(const vector<double>& phase, double tau0,
+                                    int& numGaps)
+   {
+      vector<double> deviation;
+      int N(phase.size()-1);
+      numGaps = 0;
+      for (int m = 1; m <= (N-1)/2; m++)
+      {
+         double tau(m*tau0), sigma(0.0);
+         for (int i = 0; i < (N-2*m); i++)
+         {
+            double sum(0.0);
+            if ((phase[i+2*m] == 0 || phase[i+m] == 0 || phase[i] == 0)
+                && i != 0 && i != (N-2*m-1))
+               numGaps++;
+            else
+               sum = phase[i+2*m] - 2*phase[i+m] + phase[i];
+            sigma += sum*sum;
+         }
+         sigma = sigma/(2.0*(double(N) - double(numGaps) - 2.0*m)*tau*tau);
+         deviation.push_back(std::sqrt(sigma));
+      }
+      return deviation;
+   }
+
+   unsigned directTest();
+   unsigned gapTest();
+   unsigned allanTest();
+   unsigned noiseTest();
+   unsigned errorTest();
+   unsigned speedTest();
+
+   unsigned long long seed;
+};
+
+
+unsigned FrequencyStability_T::directTest()
+{
+   TUDEF("FrequencyStability", "compute");
+
+   vector<double> x( makePhase(3000, 1.0e-11) );
+   FS stab(x, 30.0);
+   stab.setNumThreads(3);
+
+   const FS::Statistic stats[] = { FS::Allan, FS::NonOverlappingAllan,
+                                   FS::ModifiedAllan, FS::Time,
+                                   FS::Hadamard, FS::Total };
+   for (int s = 0; s < 6; s++)
+   {
+      vector<long> factors( stab.averagingFactors(stats[s], FS::OctaveTau) );
+      factors.push_back(3);
+      factors.push_back(stab.maxAveragingFactor(stats[s]));
+
+      vector<FS::Point> curve( stab.compute(stats[s], factors) );
+      TUASSERTE(size_t, factors.size(), curve.size());
+
+      double worst(0.0);
+      for (size_t i = 0; i < curve.size(); i++)
+      {
+         double ref( direct(x, stats[s], factors[i], 30.0) );
+         worst = std::max(worst, std::abs(curve[i].deviation/ref - 1.0));
+      }
+      testFramework.assert(worst < 1.0e-8, "statistic "
+                           + StringUtils::asString(s) + " differs from its "
+                           "definition by " + StringUtils::asString(worst),
+                           __LINE__);
+   }
+
+      // One thread gives the same numbers
+   vector<FS::Point> a( stab.compute(FS::ModifiedAllan, FS::DecadeTau) );
+   stab.setNumThreads(1);
+   vector<FS::Point> b( stab.compute(FS::ModifiedAllan, FS::DecadeTau) );
+   int differences(0);
+   for (size_t i = 0; i < a.size(); i++)
+   {
+      differences += (a[i].deviation != b[i].deviation);
+   }
+   TUASSERTE(int, 0, differences);
+   TUASSERTE(long, 1000, a.back().m);
+
+   TURETURN();
+}
+
+
+unsigned FrequencyStability_T::gapTest()
+{
+   TUDEF("FrequencyStability", "gaps");
+
+   vector<double> x( makePhase(2000, 1.0e-11) );
+   for (long i = 100; i < 2000; i += 337)
+   {
+      x[i] = std::numeric_limits<double>::quiet_NaN();
+   }
+   FS stab(x, 1.0);
+   TUASSERTE(long, 6, stab.getNumGaps());
+
+   const FS::Statistic stats[] = { FS::Allan, FS::ModifiedAllan,
+                                   FS::Hadamard, FS::Total };
+   for (int s = 0; s < 4; s++)
+   {
+      vector<FS::Point> curve( stab.compute(stats[s], FS::OctaveTau) );
+      double worst(0.0);
+      for (size_t i = 0; i < curve.size(); i++)
+      {
+         double ref( direct(x, stats[s], curve[i].m, 1.0) );
+         worst = std::max(worst, std::abs(curve[i].deviation/ref - 1.0));
+      }
+      testFramework.assert(worst < 1.0e-8, "statistic "
+                           + StringUtils::asString(s) + " differs from its "
+                           "definition by " + StringUtils::asString(worst),
+                           __LINE__);
+   }
+
+      // AllanDeviation takes zeros as missing measurements
+   vector<double> y( makePhase(500, 1.0e-11) );
+   y[200] = 0.0;
+   AllanDeviation ad(y, 1.0);
+   y[200] = std::numeric_limits<double>::quiet_NaN();
+   TUASSERTE(int, 1, ad.numGaps);
+   TUASSERTE(size_t, 249, ad.deviation.size());
+   TUASSERTFE(direct(y, FS::Allan, 7, 1.0), ad.deviation[6]);
+
+   TURETURN();
+}
+
+
+unsigned FrequencyStability_T::allanTest()
+{
+   TUDEF("AllanDeviation", "AllanDeviation");
+
+      // Without gaps, the old results with one more measurement appended,
+      // since the last one was left out
+   vector<double> x( makePhase(500, 1.0e-11) ), x1(x);
+   x1.push_back(x.back() + 1.0e-9);
+   int oldGaps;
+   vector<double> dev( oldAllanDeviation(x1, 2.0, oldGaps) );
+   AllanDeviation ad(x, 2.0);
+   TUASSERTE(size_t, dev.size(), ad.deviation.size());
+   double worst(0.0);
+   for (size_t i = 0; i < dev.size(); i++)
+   {
+      worst = std::max(worst, std::abs(ad.deviation[i]/dev[i] - 1.0));
+   }
+   TUASSERT(worst < 1.0e-10);
+   TUASSERTE(int, 0, ad.numGaps);
+   TUASSERTFE(2.0*249, ad.time.back());
+
+      // With a gap, the old count of missing terms included those of the
+      // smaller taus: at tau = m*tau0, it was divided by N-2m-G instead of
+      // N-2m-g, where g and G are the missing terms at m and up to m. (The
+      // first and last terms were never counted as missing, but summed.)
+   const long gap(200), n(x.size());
+   x[gap] = x1[gap] = 0.0;
+   dev = oldAllanDeviation(x1, 2.0, oldGaps);
+   AllanDeviation adg(x, 2.0);
+   TUASSERTE(int, 1, adg.numGaps);
+   TUASSERTE(size_t, dev.size(), adg.deviation.size());
+   worst = 0.0;
+   long G(0), compared(0);
+   for (long m = 1; m <= long(dev.size()); m++)
+   {
+      long g(0);
+      bool edge(false);
+      for (long i = 0; i < n-2*m; i++)
+      {
+         if (i != gap && i+m != gap && i+2*m != gap)
+            continue;
+         g++;
+         if (i == 0 || i == n-2*m-1)
+            edge = true;
+         else
+            G++;
+      }
+      if (edge)
+         continue;
+      double oldVar( dev[m-1]*dev[m-1]*(n - 2.0*m - G) ),
+             newVar( adg.deviation[m-1]*adg.deviation[m-1]*(n - 2.0*m - g) );
+      worst = std::max(worst, std::abs(newVar/oldVar - 1.0));
+      compared++;
+   }
+   TUASSERTE(int, G, oldGaps);
+   TUASSERT(compared > 240);
+   TUASSERT(worst < 1.0e-10);
+
+      // Two measurements give no deviation, more than that are needed
+   vector<double> two(2, 1.0e-9);
+   AllanDeviation ad2(two, 1.0);
+   TUASSERTE(size_t, 0, ad2.deviation.size());
+   try
+   {
+      vector<double> one(1, 1.0e-9);
+      AllanDeviation ad1(one, 1.0);
+      TUFAIL("Accepted 1 measurement");
+   }
+   catch (Exception& e)
+   {
+      TUPASS("AllanDeviation");
+   }
+
+   TURETURN();
+}
+
+
+unsigned FrequencyStability_T::noiseTest()
+{
+   TUDEF("FrequencyStability", "confidenceInterval");
+
+      // White frequency noise: ADEV = sigma/sqrt(m), MDEV a bit lower,
+      // and the intervals hold the true value most of the time
+   const double sigma(1.0e-11);
+   vector<double> x( makePhase(20000, sigma) );
+   FS stab(x, 1.0);
+
+   vector<FS::Point> adev( stab.compute(FS::Allan, FS::OctaveTau) );
+   int inside(0);
+   for (size_t i = 0; i < adev.size(); i++)
+   {
+      double expected( sigma/std::sqrt(double(adev[i].m)) );
+      TUASSERT(adev[i].lower < adev[i].deviation);
+      TUASSERT(adev[i].upper > adev[i].deviation);
+      inside += (adev[i].lower < expected && expected < adev[i].upper);
+   }
+   TUASSERT(inside >= int(adev.size())*2/3);
+   TUASSERTFEPS(sigma, adev[0].deviation, 0.02*sigma);
+
+      // MDEV = ADEV/sqrt(2) for white frequency noise at large m
+   FS::Point mdev( stab.compute(FS::ModifiedAllan, 64) );
+   TUASSERTFEPS(adev[6].deviation/std::sqrt(2.0), mdev.deviation,
+                0.15*mdev.deviation);
+
+      // Wider intervals with a higher confidence, and a known case:
+      // 10 degrees of freedom at 90%
+   double lo, hi, lo90, hi90;
+   FS::confidenceInterval(1.0, 10.0, 0.683, lo, hi);
+   FS::confidenceInterval(1.0, 10.0, 0.90, lo90, hi90);
+   TUASSERT(lo90 < lo && hi < hi90);
+   TUASSERTFEPS(std::sqrt(10.0/18.307), lo90, 1.0e-3);
+   TUASSERTFEPS(std::sqrt(10.0/3.940), hi90, 1.0e-3);
+
+      // Both ways of getting the quantiles meet at 1000
+   FS::confidenceInterval(1.0, 1000.0, 0.683, lo, hi);
+   FS::confidenceInterval(1.0, 1001.0, 0.683, lo90, hi90);
+   TUASSERTFEPS(lo, lo90, 1.0e-3);
+   TUASSERTFEPS(hi, hi90, 1.0e-3);
+
+   TURETURN();
+}
+
+
+unsigned FrequencyStability_T::errorTest()
+{
+   TUDEF("FrequencyStability", "FrequencyStability");
+
+   try
+   {
+      FS stab(vector<double>(2, 1.0), 1.0);
+      TUFAIL("Accepted 2 measurements");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("FrequencyStability");
+   }
+
+   FS stab(makePhase(100, 1.0e-11), 1.0);
+   TUASSERTE(long, 49, stab.maxAveragingFactor(FS::Allan));
+   TUASSERTE(long, 33, stab.maxAveragingFactor(FS::ModifiedAllan));
+   TUASSERTE(long, 33, stab.maxAveragingFactor(FS::Hadamard));
+   TUASSERTE(long, 99, stab.maxAveragingFactor(FS::Total));
+
+   try
+   {
+      stab.compute(FS::Hadamard, 34);
+      TUFAIL("Computed HDEV beyond the largest averaging factor");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("compute");
+   }
+
+   try
+   {
+      stab.setConfidence(1.0);
+      TUFAIL("Accepted a confidence of 1");
+   }
+   catch (InvalidParameter& e)
+   {
+      TUPASS("setConfidence");
+   }
+
+   TURETURN();
+}
+
+
+unsigned FrequencyStability_T::speedTest()
+{
+   TUDEF("FrequencyStability", "speed");
+
+   FS stab(makePhase(86400, 1.0e-11), 1.0);
+
+   clock_t ticks = clock();
+   vector<FS::Point> mdev( stab.compute(FS::ModifiedAllan, FS::OctaveTau) );
+   vector<FS::Point> adev( stab.compute(FS::Allan, FS::OctaveTau) );
+   vector<FS::Point> hdev( stab.compute(FS::Hadamard, FS::OctaveTau) );
+   double octave = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+      // Every tau of a day of 10 s phase
+   FS stab10(makePhase(8640, 1.0e-11), 10.0);
+   ticks = clock();
+   vector<FS::Point> all( stab10.compute(FS::ModifiedAllan, FS::AllTau) );
+   double every = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+   cout << fixed << setprecision(3)
+        << "one day of 1 Hz phase, MDEV+ADEV+HDEV by octaves: " << octave
+        << " s; one day of 10 s phase, MDEV at all " << all.size()
+        << " tau: " << every << " s" << endl;
+
+   TUASSERTE(size_t, 15, mdev.size());
+   TUASSERTE(size_t, 2880, all.size());
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   FrequencyStability_T testClass;
+
+   errorTotal += testClass.directTest();
+   errorTotal += testClass.gapTest();
+   errorTotal += testClass.allanTest();
+   errorTotal += testClass.noiseTest();
+   errorTotal += testClass.errorTest();
+   errorTotal += testClass.speedTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
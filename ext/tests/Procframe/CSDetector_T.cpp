@@ -0,0 +1,347 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for the cycle slip detectors of gpstk/ext/lib/Procframe
+*  (LICSDetector, LICSDetector2, MWCSDetector and OneFreqCSDetector),
+*  and for the sliding window statistics of WindowStats that they use.
+*  An hour of synthetic 1 Hz multi-GNSS data, with cycle slips, data
+*  gaps and rising and setting satellites, is given to each detector;
+*  every slip must be found, and the CPU time per epoch is printed.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <ctime>
+#include <vector>
+
+#include "LICSDetector.hpp"
+#include "LICSDetector2.hpp"
+#include "MWCSDetector.hpp"
+#include "OneFreqCSDetector.hpp"
+#include "WindowStats.hpp"
+#include "CivilTime.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+class CSDetector_T
+{
+public:
+   CSDetector_T();
+
+      /// Approximately normal noise, with unit sigma.
+   double noise()
+   {
+      double sum(0.0);
+      for (int i = 0; i < 12; i++)
+      {
+         seed = seed*6364136223846793005ULL + 1442695040888963407ULL;
+         sum += double(seed >> 11) / 9007199254740992.0;
+      }
+      return sum - 6.0;
+   }
+
+      /// Epoch 'k' of the data, with the slips accumulated so far.
+   gnssRinex makeEpoch(int k);
+
+      /// Run 'detector' over all the epochs, counting the slips found, the
+      /// slips missed and the false alarms. Returns microseconds per epoch.
+   template <class Detector>
+   double run(Detector& detector, int& found, int& missed, int& falseAlarms);
+
+   unsigned windowTest();
+   unsigned detectorTest();
+
+   CommonTime t0;
+   unsigned long long seed;
+   int numEpochs;
+
+      /// The satellites, and when they are above the horizon.
+   vector<SatID> sats;
+   vector<int> rise, set;
+
+      /// Slips: epoch, index in 'sats', and the LI, MW and code-phase jumps.
+   struct Slip { int epoch; size_t sat; };
+   vector<Slip> slips;
+
+      /// Epochs of all satellites for which a cycle slip is expected: the
+      /// slips, the first epoch of each pass, and the first after a gap.
+   vector< vector<bool> > expected;
+
+      /// Ambiguities (in the combination units), updated at each slip.
+   vector< vector<double> > jumps;
+};
+
+
+CSDetector_T::CSDetector_T()
+   : t0(CivilTime(2015, 6, 1, 0, 0, 0.0, TimeSystem::GPS).convertToCommonTime()),
+     seed(1234567), numEpochs(3600)
+{
+      // GPS, Galileo, GLONASS and BeiDou satellites in view
+   SatID::SatelliteSystem systems[4] = { SatID::systemGPS,
+                                         SatID::systemGalileo,
+                                         SatID::systemGlonass,
+                                         SatID::systemBeiDou };
+   int counts[4] = { 12, 10, 9, 11 };
+   for (int s = 0; s < 4; s++)
+      for (int i = 0; i < counts[s]; i++)
+      {
+         sats.push_back(SatID(3*i + s + 1, systems[s]));
+            // a few satellites rise or set during the hour
+         rise.push_back(i == 2 ? 900*(s+1) : 0);
+         set.push_back(i == 5 ? 3000 - 500*s : numEpochs);
+      }
+
+   expected.assign(sats.size(), vector<bool>(numEpochs, false));
+   for (size_t j = 0; j < sats.size(); j++)
+      expected[j][rise[j]] = true;
+
+      // a slip every 50 s, on a different satellite each time, and a gap
+      // of two minutes on one satellite
+   for (int k = 300; k < numEpochs; k += 50)
+   {
+      size_t j((k/50) * 7 % sats.size());
+      if (k <= rise[j] + 20 || k >= set[j]) continue;
+      Slip slip = { k, j };
+      slips.push_back(slip);
+      expected[j][k] = true;
+   }
+   expected[20][2000+120] = true;
+}
+
+
+gnssRinex CSDetector_T::makeEpoch(int k)
+{
+   gnssRinex gRin;
+   gRin.header.source = SourceID(SourceID::GPS, "TEST");
+   gRin.header.epoch = t0 + double(k);
+   gRin.header.epochFlag = 0;
+
+   for (size_t j = 0; j < sats.size(); j++)
+   {
+      if (k < rise[j] || k >= set[j]) continue;
+      if (j == 20 && k >= 2000 && k < 2000+120) continue;
+
+         // number of slips of this satellite so far
+      int n(0);
+      for (size_t s = 0; s < slips.size(); s++)
+         if (slips[s].sat == j && slips[s].epoch <= k) n++;
+
+      double t(k/3600.0), phase(0.7*j);
+      double iono(2.0 + 1.5*std::sin(t + phase) + 0.3*t*t);
+
+      typeValueMap tvm;
+      tvm[TypeID::LI] = iono + 0.15*n + 0.002*noise();
+      tvm[TypeID::MWubbena] = 0.862*(17 + 12*n) + 0.3*noise();
+      double rho(2.2e7 + 5.0e5*std::sin(t + phase));
+      tvm[TypeID::C1] = rho + iono + 0.3*noise();
+      tvm[TypeID::L1] = rho - iono - 0.19*(31 + 53*n) + 0.002*noise();
+      tvm[TypeID::LLI1] = 0.0;
+      tvm[TypeID::LLI2] = 0.0;
+      gRin.body[sats[j]] = tvm;
+   }
+
+   return gRin;
+}
+
+
+template <class Detector>
+double CSDetector_T::run(Detector& detector, int& found, int& missed,
+                         int& falseAlarms)
+{
+   found = missed = falseAlarms = 0;
+   vector<gnssRinex> epochs(numEpochs);
+   seed = 1234567;
+   for (int k = 0; k < numEpochs; k++)
+      epochs[k] = makeEpoch(k);
+
+   clock_t ticks = clock();
+   for (int k = 0; k < numEpochs; k++)
+      detector.Process(epochs[k]);
+   double seconds = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+   for (int k = 0; k < numEpochs; k++)
+   {
+      for (size_t j = 0; j < sats.size(); j++)
+      {
+         satTypeValueMap::const_iterator it(epochs[k].body.find(sats[j]));
+         if (it == epochs[k].body.end()) continue;
+         bool flag(it->second.find(TypeID::CSL1)->second > 0.0);
+            // the detectors need a few epochs after each slip to restart
+         bool settling(false);
+         for (int i = 1; i <= 12 && k-i >= 0; i++)
+            settling = settling || expected[j][k-i];
+         if (expected[j][k])
+            flag ? found++ : missed++;
+         else if (flag && !settling && k > 12)
+            falseAlarms++;
+      }
+   }
+
+   return 1.e6*seconds/numEpochs;
+}
+
+
+unsigned CSDetector_T::windowTest()
+{
+   TUDEF("WindowStats", "fit");
+
+   WindowStats w(8);
+   TUASSERTE(size_t, 0, w.size());
+
+      // running mean and variance over the last 8 samples
+   for (int i = 0; i < 20; i++)
+      w.push(1000.0 + i, 1.0e6 + (i%3));
+   TUASSERTE(size_t, 8, w.size());
+   double sum(0.0), sum2(0.0);
+   for (int i = 12; i < 20; i++)
+   {
+      sum += (i%3);
+      sum2 += (i%3)*(i%3);
+   }
+   TUASSERTFEPS(1.0e6 + sum/8.0, w.mean(), 1.e-8);
+   TUASSERTFEPS(sum2/8.0 - (sum/8.0)*(sum/8.0), w.variance(), 1.e-8);
+   TUASSERTFE(1012.0, w.front().t);
+   TUASSERTFE(1019.0, w.back().t);
+
+      // a quadratic is fitted exactly, after many samples have gone by
+   w.clear();
+   w.setCapacity(12);
+   for (int i = 0; i < 5000; i++)
+   {
+      double t(0.5*i);
+      w.push(t, 3.0 - 0.02*t + 1.0e-4*t*t);
+   }
+   WindowFit f;
+   TUASSERT(w.fit(2, f));
+   TUASSERTFEPS(3.0 - 0.02*2600.0 + 1.0e-4*2600.0*2600.0, f(2600.0), 1.e-7);
+   TUASSERTFEPS(0.0, w.maxResidual(f), 1.e-7);
+
+      // a line through the same data leaves residuals
+   TUASSERT(w.fit(1, f));
+   TUASSERT(w.maxResidual(f) > 1.e-4);
+
+      // two samples cannot give a quadratic
+   w.clear();
+   w.push(0.0, 1.0);
+   w.push(1.0, 2.0);
+   TUASSERT(!w.fit(2, f));
+   TUASSERT(w.fit(1, f));
+   TUASSERTFEPS(3.0, f(2.0), 1.e-12);
+
+   TUCSM("SatTable");
+   SatTable<int> table;
+   table[SatID(5, SatID::systemGPS)] = 5;
+   table[SatID(5, SatID::systemGalileo)] = 7;
+   table[SatID(300, SatID::systemGeosync)] = 9;
+   TUASSERTE(int, 5, table[SatID(5, SatID::systemGPS)]);
+   TUASSERTE(int, 7, table[SatID(5, SatID::systemGalileo)]);
+   TUASSERTE(int, 9, table[SatID(300, SatID::systemGeosync)]);
+   TUASSERTE(int, 0, table[SatID(6, SatID::systemGPS)]);
+   TUASSERTE(size_t, 4, table.size());
+
+   TURETURN();
+}
+
+
+unsigned CSDetector_T::detectorTest()
+{
+   TUDEF("CSDetector", "Process");
+
+   int found, missed, falseAlarms;
+   size_t numSlips(0);
+   for (size_t j = 0; j < sats.size(); j++)
+      for (int k = 0; k < numEpochs; k++)
+         numSlips += expected[j][k];
+
+   cout << sats.size() << " satellites, " << numEpochs << " epochs at 1 Hz, "
+        << numSlips << " expected slips" << endl
+        << "detector            us/epoch   found  missed  false" << endl;
+
+   LICSDetector li;
+   double us = run(li, found, missed, falseAlarms);
+   cout << "LICSDetector      " << fixed << setprecision(1) << setw(10) << us
+        << setw(8) << found << setw(8) << missed << setw(7) << falseAlarms
+        << endl;
+   TUASSERTE(int, 0, missed);
+   TUASSERTE(int, 0, falseAlarms);
+
+   LICSDetector2 li2;
+   us = run(li2, found, missed, falseAlarms);
+   cout << "LICSDetector2     " << fixed << setprecision(1) << setw(10) << us
+        << setw(8) << found << setw(8) << missed << setw(7) << falseAlarms
+        << endl;
+   TUASSERTE(int, 0, missed);
+   TUASSERTE(int, 0, falseAlarms);
+
+   MWCSDetector mw;
+   us = run(mw, found, missed, falseAlarms);
+   cout << "MWCSDetector      " << fixed << setprecision(1) << setw(10) << us
+        << setw(8) << found << setw(8) << missed << setw(7) << falseAlarms
+        << endl;
+   TUASSERTE(int, 0, missed);
+   TUASSERTE(int, 0, falseAlarms);
+
+   OneFreqCSDetector one;
+   us = run(one, found, missed, falseAlarms);
+   cout << "OneFreqCSDetector " << fixed << setprecision(1) << setw(10) << us
+        << setw(8) << found << setw(8) << missed << setw(7) << falseAlarms
+        << endl;
+   TUASSERTE(int, 0, missed);
+   TUASSERTE(int, 0, falseAlarms);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   CSDetector_T testClass;
+
+   errorTotal += testClass.windowTest();
+   errorTotal += testClass.detectorTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
@@ -0,0 +1,328 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S.
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software.
+//
+//Pursuant to DoD Directive 523024
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for gpstk/ext/lib/Procframe/EpochLog, and for its use
+*  by SolverPPPFB. Synthetic PPP epochs are stored, read back, updated
+*  and spilled to a temporary file, and a forwards-backwards solution
+*  computed from a spilled log is compared with one kept in memory.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <ctime>
+
+#include "EpochLog.hpp"
+#include "SolverPPPFB.hpp"
+#include "CivilTime.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+
+class EpochLog_T
+{
+public:
+   EpochLog_T()
+      : t0(CivilTime(2012, 3, 1, 0, 0, 0.0, TimeSystem::GPS).convertToCommonTime())
+   {}
+
+      /** Synthetic PPP epoch 'k' of a 30 s session: every satellite rises
+       *  and sets on its own schedule, with its geometry, mapping function
+       *  and prefit residuals.
+       */
+   gnssRinex makeEpoch(int k)
+   {
+      gnssRinex gRin;
+      gRin.header.source = SourceID(SourceID::GPS, "TEST");
+      gRin.header.epoch = t0 + 30.0*k;
+      gRin.header.antennaType = "AOAD/M_T        NONE";
+      gRin.header.antennaPosition = Triple(4789028.4, 176610.0, 4195017.0);
+      gRin.header.epochFlag = 0;
+
+      for (int prn = 1; prn <= 32; prn++)
+      {
+            // each satellite is above the horizon for 6 of 12 hours
+         double phase( std::fmod(k/1440.0 + prn*0.37, 1.0) );
+         if (phase > 0.5)
+            continue;
+
+         double elev( std::sin(phase*2.0*PI) );
+         double az( prn*0.7 + k*1.0e-4 );
+         double c( std::sqrt(1.0 - elev*elev) );
+
+         typeValueMap tvm;
+         tvm[TypeID::dx] = -c*std::cos(az);
+         tvm[TypeID::dy] = -c*std::sin(az);
+         tvm[TypeID::dz] = -elev;
+         tvm[TypeID::cdt] = 1.0;
+         tvm[TypeID::wetMap] = 1.0/(elev + 0.05);
+         tvm[TypeID::prefitC] = 0.3*std::sin(0.11*k + prn) + 0.02*prn;
+         tvm[TypeID::prefitL] = 0.003*std::cos(0.13*k + prn) + 0.02*prn
+                                + 0.19*prn;
+         tvm[TypeID::weight] = 1.0;
+         tvm[TypeID::CSL1] = 0.0;
+         tvm[TypeID::satArc] = 1.0 + std::floor(k/2880.0 + prn*0.37);
+         gRin.body[SatID(prn, SatID::systemGPS)] = tvm;
+      }
+
+      return gRin;
+   }
+
+   bool sameEpoch(const gnssRinex& a, const gnssRinex& b)
+   {
+      return ( a.header.source == b.header.source &&
+               a.header.epoch == b.header.epoch &&
+               a.header.antennaType == b.header.antennaType &&
+               a.header.antennaPosition == b.header.antennaPosition &&
+               a.header.epochFlag == b.header.epochFlag &&
+               a.body == b.body );
+   }
+
+   unsigned storeTest();
+   unsigned updateTest();
+   unsigned spillTest();
+   unsigned solverTest();
+
+   CommonTime t0;
+};
+
+
+unsigned EpochLog_T::storeTest()
+{
+   TUDEF("EpochLog", "get");
+
+   EpochLog log;
+   TUASSERT(log.empty());
+
+   const int numEpochs(500);
+   for (int k = 0; k < numEpochs; k++)
+   {
+      log.push_back(makeEpoch(k));
+   }
+   TUASSERTE(size_t, numEpochs, log.size());
+   TUASSERT(!log.isSpilled());
+
+   int differences(0);
+   gnssRinex gRin;
+   for (int k = numEpochs-1; k >= 0; k--)
+   {
+      log.get(k, gRin);
+      differences += !sameEpoch(gRin, makeEpoch(k));
+   }
+   TUASSERTE(int, 0, differences);
+
+   try
+   {
+      log.get(numEpochs, gRin);
+      TUFAIL("Read an epoch beyond the end of the log");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("get");
+   }
+
+   TURETURN();
+}
+
+
+unsigned EpochLog_T::updateTest()
+{
+   TUDEF("EpochLog", "update");
+
+   EpochLog log;
+   for (int k = 0; k < 20; k++)
+   {
+      log.push_back(makeEpoch(k));
+   }
+   size_t bytes(log.numBytes());
+
+      // fewer satellites are rewritten in place
+   gnssRinex gRin(makeEpoch(5)), back;
+   gRin.body.erase(gRin.body.begin());
+   log.update(5, gRin);
+   log.get(5, back);
+   TUASSERT(sameEpoch(gRin, back));
+   TUASSERTE(size_t, bytes, log.numBytes());
+
+      // more types are moved to the end
+   gRin = makeEpoch(7);
+   gRin.body.insertTypeIDVector(TypeID::postfitC,
+                                Vector<double>(gRin.numSats(), 0.5));
+   log.update(7, gRin);
+   log.get(7, back);
+   TUASSERT(sameEpoch(gRin, back));
+   TUASSERT(log.numBytes() > bytes);
+
+   log.get(8, back);
+   TUASSERT(sameEpoch(makeEpoch(8), back));
+
+   log.pop_front();
+   log.pop_front();
+   TUASSERTE(size_t, 18, log.size());
+   log.get(5, back);
+   TUASSERT(sameEpoch(gRin, back));
+
+   while (!log.empty())
+   {
+      log.pop_front();
+   }
+   TUASSERTE(size_t, 0, log.numBytes());
+
+   try
+   {
+      log.pop_front();
+      TUFAIL("Removed an epoch from an empty log");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("pop_front");
+   }
+
+   TURETURN();
+}
+
+
+unsigned EpochLog_T::spillTest()
+{
+   TUDEF("EpochLog", "setSpillSize");
+
+   EpochLog log;
+   log.setSpillSize(100000);
+
+   const int numEpochs(2880);
+   for (int k = 0; k < numEpochs; k++)
+   {
+      log.push_back(makeEpoch(k));
+   }
+   TUASSERT(log.isSpilled());
+
+   gnssRinex gRin;
+   int differences(0);
+   for (int k = numEpochs-1; k >= 0; k--)
+   {
+      log.get(k, gRin);
+      gRin.header.epochFlag = 1;
+      log.update(k, gRin);
+   }
+   for (int k = 0; k < numEpochs; k++)
+   {
+      gnssRinex expected(makeEpoch(k));
+      expected.header.epochFlag = 1;
+      log.get(k, gRin);
+      differences += !sameEpoch(gRin, expected);
+   }
+   TUASSERTE(int, 0, differences);
+
+      // a copy keeps all the epochs
+   EpochLog copy(log);
+   TUASSERTE(size_t, log.size(), copy.size());
+   log.clear();
+   TUASSERT(!log.isSpilled());
+   copy.get(numEpochs/2, gRin);
+   TUASSERTE(CommonTime, t0 + 30.0*(numEpochs/2), gRin.header.epoch);
+
+   TURETURN();
+}
+
+
+unsigned EpochLog_T::solverTest()
+{
+   TUDEF("SolverPPPFB", "ReProcess");
+
+   SolverPPPFB memory, spilled;
+   spilled.setSpillSize(100000);
+   memory.setSpillSize(0);
+   memory.addCodeLimit(0.5);
+   spilled.addCodeLimit(0.5);
+
+   const int numEpochs(2880);
+
+   clock_t ticks = clock();
+   for (int k = 0; k < numEpochs; k++)
+   {
+      gnssRinex g1(makeEpoch(k)), g2(g1);
+      memory.Process(g1);
+      spilled.Process(g2);
+   }
+   memory.ReProcess();
+   spilled.ReProcess();
+
+   int differences(0), epochs(0);
+   gnssRinex g1, g2;
+   while (memory.LastProcess(g1))
+   {
+      differences += !( spilled.LastProcess(g2) &&
+                        g1.body == g2.body &&
+                        memory.getSolution(TypeID::dx) ==
+                                          spilled.getSolution(TypeID::dx) );
+      epochs++;
+   }
+   double seconds = double(clock()-ticks)/CLOCKS_PER_SEC;
+
+   TUASSERT(!spilled.LastProcess(g2));
+   TUASSERTE(int, numEpochs, epochs);
+   TUASSERTE(int, 0, differences);
+   TUASSERTE(int, memory.getProcessedMeasurements(),
+                  spilled.getProcessedMeasurements());
+   TUASSERTE(int, memory.getRejectedMeasurements(),
+                  spilled.getRejectedMeasurements());
+
+   cout << "one day of 30 s epochs, twice: " << fixed << setprecision(2)
+        << seconds << " s" << endl;
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   EpochLog_T testClass;
+
+   errorTotal += testClass.storeTest();
+   errorTotal += testClass.updateTest();
+   errorTotal += testClass.spillTest();
+   errorTotal += testClass.solverTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}
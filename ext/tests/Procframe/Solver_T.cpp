@@ -0,0 +1,369 @@
+//============================================================================
+//
+//  This file is part of GPSTk, the GPS Toolkit.
+//
+//  The GPSTk is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU Lesser General Public License as published
+//  by the Free Software Foundation; either version 3.0 of the License, or
+//  any later version.
+//
+//  The GPSTk is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU Lesser General Public License for more details.
+//
+//  You should have received a copy of the GNU Lesser General Public
+//  License along with GPSTk; if not, write to the Free Software Foundation,
+//  Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110, USA
+//  
+//  Copyright 2004, The University of Texas at Austin
+//
+//============================================================================
+//============================================================================
+//
+//This software developed by Applied Research Laboratories at the University of
+//Texas at Austin, under contract to an agency or agencies within the U.S. 
+//Department of Defense. The U.S. Government retains all rights to use,
+//duplicate, distribute, disclose, or release this software. 
+//
+//Pursuant to DoD Directive 523024 
+//
+// DISTRIBUTION STATEMENT A: This software has been approved for public 
+//                           release, distribution is unlimited.
+//
+//============================================================================
+
+/*********************************************************************
+*
+*  Test program for the normal equations and Kalman filter solvers in
+*  gpstk/ext/lib/Procframe (SolverLMS, SolverWMS) and
+*  gpstk/ext/lib/Math (SimpleKalmanFilter). Besides checking the
+*  solutions against the explicit inverse formulas, it reports the time
+*  and the number of memory allocations needed per epoch.
+*
+*********************************************************************/
+
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+
+#include "Matrix.hpp"
+#include "SolverLMS.hpp"
+#include "SolverWMS.hpp"
+#include "SimpleKalmanFilter.hpp"
+
+#include "TestUtil.hpp"
+
+using namespace std;
+using namespace gpstk;
+
+   // Count every allocation made through global operator new, so that the
+   // allocations per epoch of each solver can be reported.
+static unsigned long allocCount = 0;
+
+void* operator new(size_t size)
+{
+   ++allocCount;
+   void *p = malloc(size ? size : 1);
+   if (!p) throw std::bad_alloc();
+   return p;
+}
+
+void* operator new[](size_t size)
+{
+   ++allocCount;
+   void *p = malloc(size ? size : 1);
+   if (!p) throw std::bad_alloc();
+   return p;
+}
+
+void operator delete(void* p) throw()
+{ free(p); }
+
+void operator delete[](void* p) throw()
+{ free(p); }
+
+
+class Solver_T
+{
+public:
+   Solver_T() : numEpochs(2000), numObs(12), numUnknowns(5)
+   { srand(31415); }
+
+      /// Fill A, b and W with a new, well conditioned, random epoch.
+   void newEpoch(Matrix<double>& A, Vector<double>& b, Vector<double>& w)
+   {
+      A.resize(numObs, numUnknowns);
+      b.resize(numObs);
+      w.resize(numObs);
+      for (size_t i = 0; i < numObs; i++)
+      {
+         for (size_t j = 0; j < numUnknowns-1; j++)
+         {
+            A(i,j) = 2.0*rand()/RAND_MAX - 1.0;
+         }
+         A(i,numUnknowns-1) = 1.0;
+         b(i) = 10.0*rand()/RAND_MAX - 5.0;
+         w(i) = 0.5 + rand()/double(RAND_MAX);
+      }
+   }
+
+   unsigned lmsTest();
+   unsigned wmsTest();
+   unsigned kalmanTest();
+
+   size_t numEpochs, numObs, numUnknowns;
+};
+
+
+   // Report time and allocations per epoch
+void report(const string& label, clock_t ticks, unsigned long allocs,
+            size_t epochs)
+{
+   cout << setw(40) << left << label << right
+        << fixed << setprecision(3)
+        << setw(10) << 1.e6*double(ticks)/CLOCKS_PER_SEC/epochs << " us/epoch"
+        << setw(8) << setprecision(1) << double(allocs)/epochs
+        << " allocs/epoch" << endl;
+}
+
+
+unsigned Solver_T::lmsTest()
+{
+   TUDEF("SolverLMS", "Compute");
+
+   Matrix<double> A;
+   Vector<double> b, w;
+   SolverLMS solver;
+
+      // correctness against the explicit inverse formula
+   for (size_t e = 0; e < 10; e++)
+   {
+      newEpoch(A, b, w);
+      Matrix<double> AT(transpose(A));
+      Matrix<double> cov(inverseChol(AT*A));
+      Vector<double> x(cov*AT*b);
+      solver.Compute(b, A);
+      TUASSERTFEPS(x, solver.solution, 1.e-12);
+      TUASSERTFEPS(cov, solver.covMatrix, 1.e-12);
+      TUASSERTFEPS(b - A*x, solver.postfitResiduals, 1.e-12);
+   }
+
+      // timing: explicit inverse, as it used to be done
+   unsigned long allocs;
+   clock_t ticks;
+   newEpoch(A, b, w);
+   allocs = allocCount;
+   ticks = clock();
+   for (size_t e = 0; e < numEpochs; e++)
+   {
+      Matrix<double> AT(transpose(A));
+      Matrix<double> cov(AT*A);
+      cov = inverseChol(cov);
+      Vector<double> x(cov*AT*b);
+      Vector<double> post(b - A*x);
+   }
+   report("LMS, explicit inverse", clock()-ticks, allocCount-allocs,
+          numEpochs);
+
+   allocs = allocCount;
+   ticks = clock();
+   for (size_t e = 0; e < numEpochs; e++)
+   {
+      solver.Compute(b, A);
+   }
+   report("SolverLMS, with covariance", clock()-ticks, allocCount-allocs,
+          numEpochs);
+
+   solver.setComputeCovariance(false);
+   allocs = allocCount;
+   ticks = clock();
+   for (size_t e = 0; e < numEpochs; e++)
+   {
+      solver.Compute(b, A);
+   }
+   report("SolverLMS, without covariance", clock()-ticks, allocCount-allocs,
+          numEpochs);
+
+   try
+   {
+      solver.getVariance(TypeID::dx);
+      TUFAIL("getVariance() should throw when covariance isn't computed");
+   }
+   catch (InvalidRequest& e)
+   {
+      TUPASS("getVariance()");
+   }
+
+   TURETURN();
+}
+
+
+unsigned Solver_T::wmsTest()
+{
+   TUDEF("SolverWMS", "Compute");
+
+   Matrix<double> A;
+   Vector<double> b, w;
+   SolverWMS solver;
+
+   for (size_t e = 0; e < 10; e++)
+   {
+      newEpoch(A, b, w);
+      Matrix<double> W(numObs, numObs, 0.0);
+      for (size_t i = 0; i < numObs; i++)
+      {
+         W(i,i) = w(i);
+      }
+      Matrix<double> AT(transpose(A));
+      Matrix<double> cov(inverseChol(AT*W*A));
+      Matrix<double> covNoW(inverseChol(AT*A));
+      Vector<double> x(cov*AT*W*b);
+
+         // diagonal weights, given as a vector
+      solver.Compute(b, A, w);
+      TUASSERTFEPS(x, solver.solution, 1.e-12);
+      TUASSERTFEPS(cov, solver.covMatrix, 1.e-12);
+      TUASSERTFEPS(covNoW, solver.covMatrixNoWeight, 1.e-12);
+
+         // full weights matrix
+      W(0,1) = W(1,0) = 0.1;
+      cov = inverseChol(AT*W*A);
+      x = cov*AT*W*b;
+      solver.Compute(b, A, W);
+      TUASSERTFEPS(x, solver.solution, 1.e-12);
+      TUASSERTFEPS(cov, solver.covMatrix, 1.e-12);
+   }
+
+   unsigned long allocs;
+   clock_t ticks;
+   newEpoch(A, b, w);
+   Matrix<double> W(numObs, numObs, 0.0);
+   for (size_t i = 0; i < numObs; i++)
+   {
+      W(i,i) = w(i);
+   }
+   allocs = allocCount;
+   ticks = clock();
+   for (size_t e = 0; e < numEpochs; e++)
+   {
+      Matrix<double> AT(transpose(A));
+      Matrix<double> cov(AT*W*A);
+      cov = inverseChol(cov);
+      Matrix<double> covNoW(AT*A);
+      covNoW = inverseChol(covNoW);
+      Vector<double> x(cov*AT*W*b);
+      Vector<double> post(b - A*x);
+   }
+   report("WMS, explicit inverse", clock()-ticks, allocCount-allocs,
+          numEpochs);
+
+   allocs = allocCount;
+   ticks = clock();
+   for (size_t e = 0; e < numEpochs; e++)
+   {
+      solver.Compute(b, A, w);
+   }
+   report("SolverWMS, with covariance", clock()-ticks, allocCount-allocs,
+          numEpochs);
+
+   solver.setComputeCovariance(false);
+   allocs = allocCount;
+   ticks = clock();
+   for (size_t e = 0; e < numEpochs; e++)
+   {
+      solver.Compute(b, A, w);
+   }
+   report("SolverWMS, without covariance", clock()-ticks, allocCount-allocs,
+          numEpochs);
+
+   TURETURN();
+}
+
+
+unsigned Solver_T::kalmanTest()
+{
+   TUDEF("SimpleKalmanFilter", "ComputeWeighted");
+
+   Matrix<double> A;
+   Vector<double> b, w;
+   Matrix<double> phi(numUnknowns, numUnknowns, 0.0),
+                  Q(numUnknowns, numUnknowns, 0.0),
+                  W(numObs, numObs, 0.0), R(numObs, numObs, 0.0);
+   for (size_t i = 0; i < numUnknowns; i++)
+   {
+      phi(i,i) = 1.0;
+      Q(i,i) = 1.0;
+   }
+   Vector<double> x0(numUnknowns, 0.0);
+   Matrix<double> P0(Q*100.0);
+
+   SimpleKalmanFilter kR(x0, P0), kW(x0, P0);
+   for (size_t e = 0; e < 10; e++)
+   {
+      newEpoch(A, b, w);
+      for (size_t i = 0; i < numObs; i++)
+      {
+         W(i,i) = w(i);
+         R(i,i) = 1.0/w(i);
+      }
+      kR.Compute(phi, Q, b, A, R);
+      kW.ComputeWeighted(phi, Q, b, A, W);
+      TUASSERTFEPS(kR.xhat, kW.xhat, 1.e-12);
+      TUASSERTFEPS(kR.P, kW.P, 1.e-12);
+   }
+
+      // compare the last epoch against the textbook information filter
+   Matrix<double> Pm(phi*kW.P*transpose(phi) + Q);
+   Vector<double> xm(phi*kW.xhat);
+   Matrix<double> AT(transpose(A));
+   Matrix<double> Pref(inverseChol(AT*W*A + inverseChol(Pm)));
+   Vector<double> xref(Pref*(AT*W*b + inverseChol(Pm)*xm));
+   kW.ComputeWeighted(phi, Q, b, A, W);
+   TUASSERTFEPS(xref, kW.xhat, 1.e-12);
+   TUASSERTFEPS(Pref, kW.P, 1.e-12);
+
+   unsigned long allocs;
+   clock_t ticks;
+   allocs = allocCount;
+   ticks = clock();
+   for (size_t e = 0; e < numEpochs; e++)
+   {
+         // as CodeKalmanSolver and SolverPPP used to do
+      Matrix<double> measNoise(inverseChol(W));
+      Matrix<double> invR(inverseChol(measNoise));
+      Matrix<double> invPm(inverseChol(Pm));
+      Matrix<double> P(inverseChol(AT*invR*A + invPm));
+      Vector<double> x(P*((AT*invR*b) + (invPm*xm)));
+   }
+   report("Kalman, explicit inverses", clock()-ticks, allocCount-allocs,
+          numEpochs);
+
+   allocs = allocCount;
+   ticks = clock();
+   for (size_t e = 0; e < numEpochs; e++)
+   {
+      kW.ComputeWeighted(phi, Q, b, A, W);
+   }
+   report("SimpleKalmanFilter::ComputeWeighted", clock()-ticks,
+          allocCount-allocs, numEpochs);
+
+   TURETURN();
+}
+
+
+int main()
+{
+   unsigned errorTotal = 0;
+   Solver_T testClass;
+
+   errorTotal += testClass.lmsTest();
+   errorTotal += testClass.wmsTest();
+   errorTotal += testClass.kalmanTest();
+
+   cout << "Total Failures for " << __FILE__ << ": " << errorTotal << endl;
+
+   return errorTotal;
+}